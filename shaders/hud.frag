@@ -4,17 +4,19 @@ in vec4 vColor;
 in vec2 vTexCoord;
 out vec4 FragColor;
 
-uniform bool uUseTexture;
+// Variante HUD_TEXTURED (texto/atlas): la otra no declara ni muestrea el sampler
+#ifdef HUD_TEXTURED
 uniform sampler2D uTexture;
+#endif
 
 void main() {
     vec4 color = vColor;
-    if (uUseTexture) {
-        float coverage = texture(uTexture, vTexCoord).r;
-        // Aplicar suavizado de bordes para texto más nítido
-        // Usar smoothstep para anti-aliasing en los bordes
-        float smoothedCoverage = smoothstep(0.0, 1.0, coverage);
-        color = vec4(color.rgb, color.a * smoothedCoverage);
-    }
+#ifdef HUD_TEXTURED
+    float coverage = texture(uTexture, vTexCoord).r;
+    // Aplicar suavizado de bordes para texto más nítido
+    // Usar smoothstep para anti-aliasing en los bordes
+    float smoothedCoverage = smoothstep(0.0, 1.0, coverage);
+    color = vec4(color.rgb, color.a * smoothedCoverage);
+#endif
     FragColor = color;
 }
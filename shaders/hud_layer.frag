@@ -0,0 +1,12 @@
+#version 330 core
+
+// La capa tiene el mismo tamaño que el framebuffer: se lee texel a texel,
+// sin filtrado. El color ya viene premultiplicado por alfa.
+
+uniform sampler2D uLayer;
+
+out vec4 FragColor;
+
+void main() {
+    FragColor = texelFetch(uLayer, ivec2(gl_FragCoord.xy), 0);
+}
@@ -0,0 +1,9 @@
+#version 330 core
+
+// Capa del HUD en caché: un quad a pantalla completa sin VBO.
+// Las esquinas salen de gl_VertexID (triangle strip).
+
+void main() {
+    vec2 corner = vec2(float(gl_VertexID & 1), float(gl_VertexID >> 1));
+    gl_Position = vec4(corner * 2.0 - 1.0, 0.0, 1.0);
+}
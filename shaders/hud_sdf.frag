@@ -0,0 +1,328 @@
+#version 330 core
+
+// HUD analítico: cada instrumento se dibuja evaluando distancias con signo
+// (SDF) en píxeles. Replica la geometría de los instrumentos de Renderer2D;
+// los textos siguen dibujándose por el camino de Renderer2D.
+
+struct Instrument {
+    vec4 rect;
+    vec4 color;
+    vec4 accent;
+    vec4 p0;
+    vec4 p1;
+    vec4 p2;
+    vec4 p3;
+    ivec4 kind;
+};
+
+layout (std140) uniform HudSdfBlock {
+    vec4 uScreen;
+    Instrument uInstruments[32];
+};
+
+flat in int vInstance;
+in vec2 vPixel;
+out vec4 FragColor;
+
+// Deben coincidir con hud::SdfShape
+const int KIND_TAPE = 1;
+const int KIND_VERTICAL_SPEED = 2;
+const int KIND_COMPASS = 3;
+const int KIND_BANK_ANGLE = 4;
+const int KIND_PITCH_LADDER = 5;
+
+// ============================================================================
+// Primitivas de distancia (en píxeles)
+// ============================================================================
+
+float sdSegment(vec2 p, vec2 a, vec2 b) {
+    vec2 pa = p - a;
+    vec2 ba = b - a;
+    float h = clamp(dot(pa, ba) / max(dot(ba, ba), 1e-6), 0.0, 1.0);
+    return length(pa - ba * h);
+}
+
+float sdBox(vec2 p, vec2 center, vec2 halfSize) {
+    vec2 d = abs(p - center) - halfSize;
+    return length(max(d, 0.0)) + min(max(d.x, d.y), 0.0);
+}
+
+float sdTriangle(vec2 p, vec2 a, vec2 b, vec2 c) {
+    vec2 e0 = b - a, e1 = c - b, e2 = a - c;
+    vec2 v0 = p - a, v1 = p - b, v2 = p - c;
+    vec2 pq0 = v0 - e0 * clamp(dot(v0, e0) / dot(e0, e0), 0.0, 1.0);
+    vec2 pq1 = v1 - e1 * clamp(dot(v1, e1) / dot(e1, e1), 0.0, 1.0);
+    vec2 pq2 = v2 - e2 * clamp(dot(v2, e2) / dot(e2, e2), 0.0, 1.0);
+    float s = sign(e0.x * e2.y - e0.y * e2.x);
+    vec2 d = min(min(vec2(dot(pq0, pq0), s * (v0.x * e0.y - v0.y * e0.x)),
+                     vec2(dot(pq1, pq1), s * (v1.x * e1.y - v1.y * e1.x))),
+                     vec2(dot(pq2, pq2), s * (v2.x * e2.y - v2.y * e2.x)));
+    return -sqrt(d.x) * sign(d.y);
+}
+
+float triangleOutline(vec2 p, vec2 a, vec2 b, vec2 c) {
+    return min(min(sdSegment(p, a, b), sdSegment(p, b, c)), sdSegment(p, c, a));
+}
+
+// Cobertura con 1 px de antialiasing
+float stroke(float d, float thickness) {
+    return clamp(thickness * 0.5 + 0.5 - d, 0.0, 1.0);
+}
+
+float fill(float d) {
+    return clamp(0.5 - d, 0.0, 1.0);
+}
+
+// Composición "over" en alpha premultiplicado, en el mismo orden que Renderer2D
+void layer(inout vec4 acc, vec4 color, float coverage) {
+    float a = color.a * coverage;
+    acc.rgb = color.rgb * a + acc.rgb * (1.0 - a);
+    acc.a = a + acc.a * (1.0 - a);
+}
+
+// ============================================================================
+// Tape (SpeedIndicator / Altimeter)
+// ============================================================================
+
+vec4 shadeTape(Instrument s, vec2 p) {
+    vec4 acc = vec4(0.0);
+    float value = s.p0.x;
+    float stepValue = s.p0.y;
+    float pixelsPerStep = s.p0.z;
+    float centerY = s.p1.x;
+    float boxHeight = s.p2.z;
+
+    // Marca más cercana a esta fila de píxeles
+    float baseValue = floor(value / stepValue) * stepValue;
+    float scroll = (value - baseValue) / stepValue * pixelsPerStep;
+    float i = floor((centerY + scroll - p.y) / pixelsPerStep + 0.5);
+    float markY = centerY + scroll - i * pixelsPerStep;
+    float markValue = baseValue + i * stepValue;
+
+    bool visible = abs(i) <= s.p1.w && markValue >= s.p0.w && abs(markY - centerY) >= boxHeight * 0.5;
+    if (visible) {
+        float tick = sdBox(p, vec2(s.p1.y + s.p1.z * 0.5, markY), vec2(s.p1.z * 0.5, 0.5));
+        layer(acc, s.color, fill(tick));
+    }
+
+    // Caja de lectura (solo borde)
+    float box = abs(sdBox(p, vec2(s.p2.x + s.p2.y * 0.5, centerY), vec2(s.p2.y, boxHeight) * 0.5));
+    layer(acc, s.color, stroke(box, 1.0));
+
+    // Chevron apuntando a la derecha
+    vec2 top = vec2(s.p3.x, centerY - s.p3.z * 0.5);
+    vec2 bottom = vec2(s.p3.x, centerY + s.p3.z * 0.5);
+    vec2 tip = vec2(s.p3.x + s.p3.y, centerY);
+    layer(acc, s.color, stroke(triangleOutline(p, top, tip, bottom), 2.0));
+    return acc;
+}
+
+// ============================================================================
+// VSI
+// ============================================================================
+
+vec4 shadeVerticalSpeed(Instrument s, vec2 p) {
+    vec4 acc = vec4(0.0);
+    float maxVsi = s.p0.y;
+    float lineX = s.p1.x;
+    float centerY = s.p1.y;
+    float pixelsPerUnit = s.p1.z / maxVsi;
+    float tickLength = s.p2.x;
+    float majorTickLength = s.p2.y;
+
+    // Espina de la escala
+    layer(acc, s.color, stroke(sdSegment(p, vec2(lineX, centerY - s.p1.w), vec2(lineX, centerY + s.p1.w)), 1.0));
+
+    // Marca más cercana
+    float rowValue = (centerY - p.y) / pixelsPerUnit;
+    float markValue = clamp(floor(rowValue / s.p0.z + 0.5) * s.p0.z, -maxVsi, maxVsi);
+    float markY = centerY - markValue * pixelsPerUnit;
+    bool isMajor = mod(abs(markValue), s.p0.w) < 0.1;
+    float markLength = isMajor ? majorTickLength : tickLength;
+    layer(acc, s.color, stroke(sdSegment(p, vec2(lineX - markLength, markY), vec2(lineX, markY)), isMajor ? 1.25 : 0.8));
+
+    // Línea de referencia en 0
+    layer(acc, s.color, stroke(sdSegment(p, vec2(lineX - (majorTickLength + 12.0), centerY), vec2(lineX + 6.0, centerY)), 3.0));
+
+    // Triángulo indicador (relleno + contorno)
+    float indicatorY = centerY - s.p0.x * pixelsPerUnit;
+    vec2 a = vec2(lineX + 2.0, indicatorY - s.p2.w * 0.5);
+    vec2 b = vec2(lineX + 2.0, indicatorY + s.p2.w * 0.5);
+    vec2 c = vec2(lineX + 2.0 + s.p2.z, indicatorY);
+    float triangle = sdTriangle(p, a, b, c);
+    layer(acc, s.color, max(fill(triangle), stroke(abs(triangle), 1.2)));
+
+    // Caja de lectura: fondo semitransparente + borde
+    float box = sdBox(p, vec2(s.p3.x + s.p3.y * 0.5, centerY), vec2(s.p3.y, s.p3.z) * 0.5);
+    layer(acc, s.accent, fill(box));
+    layer(acc, s.color, stroke(abs(box), 1.0));
+    return acc;
+}
+
+// ============================================================================
+// HSI (WaypointIndicator)
+// ============================================================================
+
+vec4 shadeCompass(Instrument s, vec2 p) {
+    vec4 acc = vec4(0.0);
+    vec3 rgb = s.color.rgb;
+    vec2 center = s.p0.xy;
+    float radius = s.p1.x;
+    vec2 d = p - center;
+
+    // Anillos exterior e interior
+    layer(acc, vec4(rgb, 0.5), stroke(abs(length(d) - radius), 1.0));
+    layer(acc, vec4(rgb, 0.2), stroke(abs(length(d) - radius * 0.92), 1.0));
+
+    // Marca más cercana: 72 marcas cada 5°, 0° arriba y sentido horario
+    float angle = degrees(atan(d.y, d.x)) + 90.0;
+    float index = mod(floor(angle / 5.0 + 0.5), 72.0);
+    bool isMajor = mod(index, 2.0) < 0.5;
+    float tickRad = radians(-90.0 + index * 5.0);
+    vec2 tickDir = vec2(cos(tickRad), sin(tickRad));
+    float inner = radius - (isMajor ? s.p1.y : s.p1.z);
+    layer(acc, vec4(rgb, isMajor ? 0.8 : 0.4),
+          stroke(sdSegment(p, center + tickDir * inner, center + tickDir * radius), isMajor ? 2.0 : 1.0));
+
+    // Flecha magenta hacia el waypoint
+    float pointerRad = radians(-90.0 + s.p0.z);
+    vec2 pointerDir = vec2(cos(pointerRad), sin(pointerRad));
+    float pointerLength = radius * 0.8;
+    vec2 tip = center + pointerDir * pointerLength;
+    float leftAng = pointerRad + radians(135.0);
+    float rightAng = pointerRad - radians(135.0);
+    vec2 left = tip + vec2(cos(leftAng), sin(leftAng)) * 15.0;
+    vec2 right = tip + vec2(cos(rightAng), sin(rightAng)) * 15.0;
+    float arrow = min(sdSegment(p, center, tip), triangleOutline(p, tip, left, right));
+    layer(acc, s.color, stroke(arrow, 4.0));
+
+    // Trazos discontinuos sobre el asta (segmentos pares de 10)
+    float segmentLength = pointerLength / 10.0;
+    float along = dot(d, pointerDir) / segmentLength;
+    float dashIndex = floor(along / 2.0) * 2.0;
+    if (dashIndex >= 0.0 && dashIndex <= 8.0) {
+        float dash = sdSegment(p, center + pointerDir * (dashIndex + 0.2) * segmentLength,
+                               center + pointerDir * (dashIndex + 1.0) * segmentLength);
+        layer(acc, vec4(rgb, 0.5), stroke(dash, 2.0));
+    }
+
+    // Indicador vertical de diferencia de altitud
+    float indicatorX = s.p2.x;
+    float indicatorHeight = s.p2.y;
+    float altitudeDiff = s.p0.w;
+    layer(acc, vec4(rgb, 0.4), stroke(sdSegment(p, vec2(indicatorX, center.y - indicatorHeight * 0.5),
+                                                vec2(indicatorX, center.y + indicatorHeight * 0.5)), 2.0));
+    layer(acc, vec4(rgb, 0.6), stroke(sdSegment(p, vec2(indicatorX - 5.0, center.y), vec2(indicatorX + 5.0, center.y)), 2.0));
+
+    float arrowY = center.y - clamp(altitudeDiff, -s.p2.z, s.p2.z) / s.p2.z * (indicatorHeight * 0.4);
+    if (abs(altitudeDiff) <= 50.0) {
+        layer(acc, s.accent, fill(length(p - vec2(indicatorX, arrowY)) - 5.0));
+    } else {
+        float direction = altitudeDiff > 0.0 ? -1.0 : 1.0;
+        vec2 bugTip = vec2(indicatorX, arrowY + direction * 8.0);
+        vec2 bugLeft = vec2(indicatorX - 5.6, arrowY);
+        vec2 bugRight = vec2(indicatorX + 5.6, arrowY);
+        layer(acc, s.accent, stroke(triangleOutline(p, bugTip, bugLeft, bugRight), 3.0));
+    }
+    return acc;
+}
+
+// ============================================================================
+// Bank angle
+// ============================================================================
+
+vec4 shadeBankAngle(Instrument s, vec2 p) {
+    vec4 acc = vec4(0.0);
+    float roll = s.p0.x;
+    float degreesPerLine = s.p0.y;
+    int centerIndex = int(floor(roll / degreesPerLine + 0.5));
+
+    // 5 marcas móviles sobre la línea inclinada
+    for (int i = centerIndex - 2; i <= centerIndex + 2; ++i) {
+        float t = 0.5 + (float(i) * degreesPerLine - roll) / degreesPerLine * s.p0.z;
+        if (t < 0.0 || t > 1.0)
+            continue;
+        vec2 mark = mix(s.p1.xy, s.p1.zw, t);
+        float height = (abs(i) % 3 == 0) ? s.p2.x : s.p2.y;
+        layer(acc, s.color, stroke(sdSegment(p, mark - vec2(0.0, height * 0.5), mark + vec2(0.0, height * 0.5)), 1.5));
+    }
+
+    // Aguja fija (contorno)
+    float size = s.p3.z;
+    vec2 tip = vec2(s.p3.x, s.p3.y + size);
+    vec2 baseLeft = vec2(s.p3.x - size * 0.6, s.p3.y - size * 0.3);
+    vec2 baseRight = vec2(s.p3.x + size * 0.6, s.p3.y - size * 0.3);
+    layer(acc, s.accent, stroke(triangleOutline(p, tip, baseLeft, baseRight), 1.0));
+    return acc;
+}
+
+// ============================================================================
+// Pitch ladder
+// ============================================================================
+
+vec4 shadePitchLadder(Instrument s, vec2 p) {
+    vec4 acc = vec4(0.0);
+    float pitch = s.p0.x;
+    vec2 center = s.p0.zw;
+    float circleRadius = s.p1.x;
+    float pitchStep = s.p3.x;
+
+    // Mira fija: círculo + líneas laterales
+    layer(acc, s.color, stroke(abs(length(p - center) - circleRadius), 1.0));
+    float lateral = min(sdSegment(p, center - vec2(circleRadius, 0.0), center - vec2(circleRadius + s.p1.y, 0.0)),
+                        sdSegment(p, center + vec2(circleRadius, 0.0), center + vec2(circleRadius + s.p1.y, 0.0)));
+    layer(acc, s.color, stroke(lateral, 2.0));
+
+    // Deshacer el giro de alabeo (en CPU se rota con -roll)
+    float rollRad = radians(-s.p0.y);
+    float c = cos(rollRad);
+    float sn = sin(rollRad);
+    vec2 d = p - center;
+    vec2 q = center + vec2(d.x * c + d.y * sn, -d.x * sn + d.y * c);
+
+    // Línea más cercana en el marco sin girar
+    float pixelsPerDegree = s.p2.z;
+    float lineIndex = floor((pitch + (center.y - q.y) / pixelsPerDegree) / pitchStep + 0.5);
+    float lineAngle = lineIndex * pitchStep;
+    float lineY = center.y - (lineAngle - pitch) * pixelsPerDegree;
+    bool nearCurrent = abs(lineIndex - floor(pitch / pitchStep + 0.5)) <= 2.0;
+
+    if (nearCurrent && abs(lineAngle) <= s.p3.y && abs(lineY - center.y) <= s.p2.w) {
+        bool isZero = abs(lineAngle) < 0.001;
+        float halfWidth = isZero ? s.p2.y : s.p2.x;
+        float gap = s.p1.z;
+        float line = min(sdSegment(q, vec2(center.x - halfWidth, lineY), vec2(center.x - gap, lineY)),
+                         sdSegment(q, vec2(center.x + gap, lineY), vec2(center.x + halfWidth, lineY)));
+        if (!isZero) {
+            float markerY = lineY + (lineAngle > 0.0 ? s.p1.w : -s.p1.w);
+            line = min(line, sdSegment(q, vec2(center.x - halfWidth, lineY), vec2(center.x - halfWidth, markerY)));
+            line = min(line, sdSegment(q, vec2(center.x + halfWidth, lineY), vec2(center.x + halfWidth, markerY)));
+        }
+        layer(acc, s.color, stroke(line, 2.0));
+    }
+    return acc;
+}
+
+void main() {
+    Instrument s = uInstruments[vInstance];
+    vec4 acc;
+
+    if (s.kind.x == KIND_TAPE)
+        acc = shadeTape(s, vPixel);
+    else if (s.kind.x == KIND_VERTICAL_SPEED)
+        acc = shadeVerticalSpeed(s, vPixel);
+    else if (s.kind.x == KIND_COMPASS)
+        acc = shadeCompass(s, vPixel);
+    else if (s.kind.x == KIND_BANK_ANGLE)
+        acc = shadeBankAngle(s, vPixel);
+    else if (s.kind.x == KIND_PITCH_LADDER)
+        acc = shadePitchLadder(s, vPixel);
+    else
+        discard;
+
+    if (acc.a <= 0.0)
+        discard;
+
+    // De premultiplicado a alpha directo (blending estándar del HUD)
+    FragColor = vec4(acc.rgb / acc.a, acc.a);
+}
@@ -0,0 +1,38 @@
+#version 330 core
+
+// HUD analítico: un quad por instrumento, sin VBO.
+// Las esquinas salen de gl_VertexID (triangle strip) y los parámetros del
+// bloque uniforme indexado por gl_InstanceID.
+
+struct Instrument {
+    vec4 rect;   // x, y, ancho, alto del quad (píxeles, origen arriba-izquierda)
+    vec4 color;
+    vec4 accent;
+    vec4 p0;
+    vec4 p1;
+    vec4 p2;
+    vec4 p3;
+    ivec4 kind;
+};
+
+// Debe coincidir con hud::SdfHudRenderer::kMaxInstrumentsPerBatch
+layout (std140) uniform HudSdfBlock {
+    vec4 uScreen; // x = ancho, y = alto (píxeles)
+    Instrument uInstruments[32];
+};
+
+flat out int vInstance;
+out vec2 vPixel;
+
+void main() {
+    vec2 corner = vec2(float(gl_VertexID & 1), float(gl_VertexID >> 1));
+    vec4 rect = uInstruments[gl_InstanceID].rect;
+    vec2 pixel = rect.xy + corner * rect.zw;
+
+    vPixel = pixel;
+    vInstance = gl_InstanceID;
+
+    // Misma proyección ortográfica que Renderer2D (Y hacia abajo)
+    vec2 ndc = vec2(pixel.x / uScreen.x * 2.0 - 1.0, 1.0 - pixel.y / uScreen.y * 2.0);
+    gl_Position = vec4(ndc, 0.0, 1.0);
+}
@@ -4,12 +4,23 @@ out vec4 FragColor;
 in vec3 FragPos;
 in vec3 Normal;
 in vec2 TexCoords;
+#ifdef HAS_NORMAL_MAP
+in mat3 TBN;
+#endif
 
-// Material parameters
+// Material maps: each exists only in the variants built with its define (see gfx::ShaderVariants)
+#ifdef HAS_DIFFUSE_MAP
 uniform sampler2D texture_diffuse1;
-
-// Flags to check if textures are available
-uniform bool hasTextureDiffuse;
+#endif
+#ifdef HAS_NORMAL_MAP
+uniform sampler2D texture_normal1;
+#endif
+#ifdef HAS_METALLIC_MAP
+uniform sampler2D texture_metallic1;
+#endif
+#ifdef HAS_ROUGHNESS_MAP
+uniform sampler2D texture_roughness1;
+#endif
 
 // Light properties
 uniform vec3 lightPos;
@@ -18,26 +29,51 @@ uniform vec3 viewPos;
 
 void main() {
     // Get material color
-    vec3 objectColor = hasTextureDiffuse ? texture(texture_diffuse1, TexCoords).rgb : vec3(0.7, 0.7, 0.7);
-    
+#ifdef HAS_DIFFUSE_MAP
+    vec3 objectColor = texture(texture_diffuse1, TexCoords).rgb;
+#else
+    vec3 objectColor = vec3(0.7, 0.7, 0.7);
+#endif
+
     // Normalize the normal (interpolation can denormalize it)
+#ifdef HAS_NORMAL_MAP
+    vec3 N = normalize(TBN * (texture(texture_normal1, TexCoords).rgb * 2.0 - 1.0));
+#else
     vec3 N = normalize(Normal);
+#endif
     vec3 L = normalize(lightPos - FragPos);
     vec3 V = normalize(viewPos - FragPos);
     vec3 R = reflect(-L, N);
-    
+
+    // Specular response; without maps, the plain Phong values
+    float specularStrength = 0.5;
+    float shininess = 32.0;
+    vec3 specularColor = lightColor;
+    float diffuseWeight = 1.0;
+#ifdef HAS_ROUGHNESS_MAP
+    // glTF metallic-roughness layout: roughness in green
+    float roughness = texture(texture_roughness1, TexCoords).g;
+    specularStrength = mix(0.9, 0.1, roughness);
+    shininess = mix(128.0, 8.0, roughness);
+#endif
+#ifdef HAS_METALLIC_MAP
+    // ... and metalness in blue: metals tint the highlight and lose the diffuse term
+    float metallic = texture(texture_metallic1, TexCoords).b;
+    specularColor = mix(lightColor, lightColor * objectColor, metallic);
+    diffuseWeight = 1.0 - metallic;
+#endif
+
     // Ambient
     float ambientStrength = 0.4;
     vec3 ambient = ambientStrength * objectColor;
     
     // Diffuse (Lambertian)
     float diff = max(dot(N, L), 0.0);
-    vec3 diffuse = diff * lightColor * objectColor;
+    vec3 diffuse = diffuseWeight * diff * lightColor * objectColor;
     
     // Specular (Phong)
-    float specularStrength = 0.5;
-    float spec = pow(max(dot(R, V), 0.0), 32.0);
-    vec3 specular = specularStrength * spec * lightColor;
+    float spec = pow(max(dot(R, V), 0.0), shininess);
+    vec3 specular = specularStrength * spec * specularColor;
     
     // Combine
     vec3 result = ambient + diffuse + specular;
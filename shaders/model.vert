@@ -8,6 +8,9 @@ layout (location = 4) in vec3 aBitangent;
 out vec3 FragPos;
 out vec3 Normal;
 out vec2 TexCoords;
+#ifdef HAS_NORMAL_MAP
+out mat3 TBN;
+#endif
 
 uniform mat4 model;
 uniform mat4 view;
@@ -21,6 +24,9 @@ void main()
     // Transform normal to world space
     mat3 normalMatrix = transpose(inverse(mat3(model)));
     Normal = normalize(normalMatrix * aNormal);
+#ifdef HAS_NORMAL_MAP
+    TBN = mat3(normalize(normalMatrix * aTangent), normalize(normalMatrix * aBitangent), Normal);
+#endif
 
     gl_Position = projection * view * vec4(FragPos, 1.0);
 }
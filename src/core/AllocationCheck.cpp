@@ -0,0 +1,173 @@
+#include "core/AllocationCheck.h"
+#include "core/AllocationTracker.h"
+#include "core/InputSystem.h"
+#include "hud/core/FlightHUD.h"
+#include "mission/MissionDefinition.h"
+#include "mission/MissionRuntime.h"
+#include "systems/FlightSimulationController.h"
+#include "systems/WaypointSystem.h"
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+
+extern "C"
+{
+#include <GLFW/glfw3.h>
+}
+
+namespace core
+{
+    namespace
+    {
+        /// WP1 sits on the straight-ahead path (about 150 m/s down -Z from the origin), reached
+        /// around frame 360: the capture and the recorder leg it closes fall inside the measured
+        /// frames. The rest are far enough that the mission never completes.
+        mission::MissionDefinition buildMission()
+        {
+            mission::MissionDefinition mission;
+            mission.id = "allocation_check";
+            mission.name = "Allocation check";
+            mission.waypoints.emplace_back(glm::vec3(0.0f, 1502.0f, -900.0f), "WP1");
+            for (int i = 1; i < 8; ++i)
+            {
+                mission.waypoints.emplace_back(glm::vec3(20000.0f + 2000.0f * i, 1500.0f, -30000.0f),
+                                               "WP" + std::to_string(i + 1));
+            }
+
+            mission::ZoneDef zone;
+            zone.id = "far";
+            zone.center = glm::vec3(25000.0f, 0.0f, -30000.0f);
+            zone.radius = 1500.0f;
+            mission.zones.push_back(zone);
+
+            mission::TriggerDef reach;
+            reach.id = "reach";
+            reach.condition = "in(far) && altitude > 1000";
+            reach.action = mission::TriggerAction::Objective;
+            mission.triggers.push_back(reach);
+
+            mission::TriggerDef envelope;
+            envelope.id = "envelope";
+            envelope.condition = "airspeed > 900 || gForce > 9 || -pitch > 80";
+            envelope.hold = 1.0f;
+            envelope.action = mission::TriggerAction::Penalty;
+            mission.triggers.push_back(envelope);
+            return mission;
+        }
+    } // namespace
+
+    int runAllocationCheck(const AllocationCheckOptions &options)
+    {
+        if (!AllocationTracker::enabled())
+        {
+            std::cout << "✗ Built without allocation hooks: rebuild with `make TRACK_ALLOCATIONS=1 BUILD_DIR=build-alloc`"
+                      << std::endl;
+            return 1;
+        }
+        if (options.frames <= 0 || options.frameHz <= 0.0f)
+        {
+            std::cout << "✗ No frames to check" << std::endl;
+            return 1;
+        }
+
+        // Same objects FlightState uses, minus everything that needs a GL context
+        InputSystem input;
+        systems::FlightSimulationController controller;
+        controller.initialize();
+        mission::MissionRuntime runtime;
+        systems::WaypointSystem waypoints;
+        const mission::MissionDefinition mission = buildMission();
+        runtime.startMission(mission);
+        runtime.confirmReadyToFly();
+        controller.resetForMission();
+        waypoints.loadFromMission(mission);
+        hud::FlightHUD hud;
+        hud.initHeadless(1280, 720);
+
+        // One key goes down and the previous one up every frame, across all flight controls
+        static const int KEYS[] = {GLFW_KEY_UP, GLFW_KEY_W, GLFW_KEY_A, GLFW_KEY_Q,
+                                   GLFW_KEY_S, GLFW_KEY_D, GLFW_KEY_E, GLFW_KEY_DOWN};
+        constexpr int KEY_COUNT = static_cast<int>(sizeof(KEYS) / sizeof(KEYS[0]));
+
+        const float dt = 1.0f / options.frameHz;
+        const int total = options.warmupFrames + options.frames;
+        AllocationCounters measured;
+        uint64_t peak = 0;
+        int allocatingFrames = 0;
+        int firstAllocatingFrame = -1;
+        int capturedBeforeMeasuring = 0;
+        size_t vertices = 0;
+        for (int frame = 0; frame < total; ++frame)
+        {
+            // Without glfwInit the callbacks stamp 0, so the presses land at the start of each window
+            input.onKey(KEYS[frame % KEY_COUNT], GLFW_PRESS, 0);
+            input.onKey(KEYS[(frame + KEY_COUNT - 1) % KEY_COUNT], GLFW_RELEASE, 0);
+
+            const AllocationCounters start = AllocationTracker::snapshot();
+            input.beginFrame(frame * static_cast<double>(dt), (frame + 1) * static_cast<double>(dt));
+            controller.handleControls(input);
+            if (runtime.shouldRunPhysics())
+            {
+                controller.step(dt);
+            }
+            runtime.updateProgress(controller.getFlightData(), dt);
+            runtime.updateMetrics(controller.getFlightData(), dt);
+            waypoints.update(controller.planePosition(), controller.getFlightData(), runtime);
+            hud.update(controller.getFlightData());
+            hud.recordDrawLists();
+            const AllocationCounters used = AllocationTracker::snapshot() - start;
+
+            if (frame < options.warmupFrames)
+            {
+                capturedBeforeMeasuring = runtime.getMetrics().waypointsCaptured;
+                continue;
+            }
+            measured.allocations += used.allocations;
+            measured.deallocations += used.deallocations;
+            measured.bytes += used.bytes;
+            peak = std::max(peak, used.allocations);
+            if (used.allocations > 0)
+            {
+                allocatingFrames++;
+                if (firstAllocatingFrame < 0)
+                {
+                    firstAllocatingFrame = frame;
+                }
+            }
+            if (frame == total - 1)
+            {
+                for (const gfx::DrawList2D &list : hud.drawLists())
+                {
+                    vertices += list.vertices().size();
+                }
+            }
+        }
+
+        std::cout << "Flight frame allocations: " << options.frames << " frames after " << options.warmupFrames
+                  << " of warm-up, " << vertices << " HUD vertices per frame" << std::endl;
+        std::cout << "  allocations   " << measured.allocations << " (" << measured.bytes << " bytes, "
+                  << measured.deallocations << " frees)" << std::endl;
+        std::cout << "  frames        " << allocatingFrames << " allocating, peak " << peak << " in one frame";
+        if (firstAllocatingFrame >= 0)
+        {
+            std::cout << ", first at frame " << firstAllocatingFrame;
+        }
+        std::cout << std::endl;
+        const int captured = runtime.getMetrics().waypointsCaptured - capturedBeforeMeasuring;
+        std::cout << "  waypoints     " << captured << " captured while measuring" << std::endl;
+
+        const bool ok = measured.allocations == 0 && vertices > 0 && captured > 0;
+        if (vertices == 0)
+        {
+            std::cout << "  ✗ the HUD recorded nothing" << std::endl;
+        }
+        if (captured == 0)
+        {
+            std::cout << "  ✗ no waypoint captured after the warm-up: the capture path went unchecked" << std::endl;
+        }
+        std::cout << (ok ? "✓ Flight frame allocation-free" : "✗ Flight frame allocates in steady state") << std::endl;
+        return ok ? 0 : 1;
+    }
+
+} // namespace core
@@ -0,0 +1,35 @@
+/**
+ * @file AllocationCheck.h
+ * @brief Headless zero-allocation regression check of the flight frame (`--check-allocations` mode).
+ */
+
+#pragma once
+
+namespace core
+{
+
+    /**
+     * @brief Parameters of the allocation check.
+     */
+    struct AllocationCheckOptions
+    {
+        int frames = 600;       ///< Frames measured after the warm-up.
+        int warmupFrames = 120; ///< Same warm-up the interactive audit allows a state.
+        float frameHz = 60.0f;  ///< Fixed step of the emulated main loop.
+    };
+
+    /**
+     * @brief Drives the GL-free part of a flight frame and counts heap allocations.
+     * @return 0 if no frame after the warm-up allocated and a waypoint was captured
+     *         among them; 1 otherwise, or when the binary was built without
+     *         `TRACK_ALLOCATIONS=1` (nothing to count).
+     *
+     * Headless: `FlightSim --check-allocations [frames]`. Each frame feeds
+     * scripted key presses through InputSystem, then runs what FlightState
+     * does on the CPU: FlightSimulationController::handleControls/step, the
+     * mission runtime (triggers, recorder, metrics), WaypointSystem::update
+     * and the HUD instruments recorded into their DrawList2D.
+     */
+    int runAllocationCheck(const AllocationCheckOptions &options);
+
+} // namespace core
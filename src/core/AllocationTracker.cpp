@@ -0,0 +1,106 @@
+#include "core/AllocationTracker.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+    std::atomic<uint64_t> gAllocations{0};
+    std::atomic<uint64_t> gDeallocations{0};
+    std::atomic<uint64_t> gBytes{0};
+}
+
+namespace core
+{
+
+    AllocationCounters AllocationTracker::snapshot()
+    {
+        AllocationCounters counters;
+        counters.allocations = gAllocations.load(std::memory_order_relaxed);
+        counters.deallocations = gDeallocations.load(std::memory_order_relaxed);
+        counters.bytes = gBytes.load(std::memory_order_relaxed);
+        return counters;
+    }
+
+} // namespace core
+
+#ifdef FLIGHTSIM_TRACK_ALLOCATIONS
+
+// ============================================================================
+// Global operator new/delete replacements (tracking builds only)
+// ============================================================================
+
+namespace
+{
+    void *trackedAlloc(std::size_t size)
+    {
+        gAllocations.fetch_add(1, std::memory_order_relaxed);
+        gBytes.fetch_add(size, std::memory_order_relaxed);
+        return std::malloc(size == 0 ? 1 : size);
+    }
+
+    void *trackedAlignedAlloc(std::size_t size, std::align_val_t alignment)
+    {
+        gAllocations.fetch_add(1, std::memory_order_relaxed);
+        gBytes.fetch_add(size, std::memory_order_relaxed);
+
+        // aligned_alloc requires the size to be a multiple of the alignment.
+        const std::size_t align = static_cast<std::size_t>(alignment);
+        const std::size_t rounded = ((size == 0 ? 1 : size) + align - 1) / align * align;
+        return std::aligned_alloc(align, rounded);
+    }
+
+    void trackedFree(void *ptr)
+    {
+        if (ptr)
+        {
+            gDeallocations.fetch_add(1, std::memory_order_relaxed);
+            std::free(ptr);
+        }
+    }
+}
+
+void *operator new(std::size_t size)
+{
+    if (void *ptr = trackedAlloc(size))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t size)
+{
+    if (void *ptr = trackedAlloc(size))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept { return trackedAlloc(size); }
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept { return trackedAlloc(size); }
+
+void *operator new(std::size_t size, std::align_val_t alignment)
+{
+    if (void *ptr = trackedAlignedAlloc(size, alignment))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t size, std::align_val_t alignment)
+{
+    if (void *ptr = trackedAlignedAlloc(size, alignment))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *ptr) noexcept { trackedFree(ptr); }
+void operator delete[](void *ptr) noexcept { trackedFree(ptr); }
+void operator delete(void *ptr, std::size_t) noexcept { trackedFree(ptr); }
+void operator delete[](void *ptr, std::size_t) noexcept { trackedFree(ptr); }
+void operator delete(void *ptr, const std::nothrow_t &) noexcept { trackedFree(ptr); }
+void operator delete[](void *ptr, const std::nothrow_t &) noexcept { trackedFree(ptr); }
+void operator delete(void *ptr, std::align_val_t) noexcept { trackedFree(ptr); }
+void operator delete[](void *ptr, std::align_val_t) noexcept { trackedFree(ptr); }
+void operator delete(void *ptr, std::size_t, std::align_val_t) noexcept { trackedFree(ptr); }
+void operator delete[](void *ptr, std::size_t, std::align_val_t) noexcept { trackedFree(ptr); }
+
+#endif // FLIGHTSIM_TRACK_ALLOCATIONS
@@ -0,0 +1,56 @@
+/**
+ * @file AllocationTracker.h
+ * @brief Global heap allocation counters for frame-level allocation audits.
+ *
+ * When the project is compiled with `FLIGHTSIM_TRACK_ALLOCATIONS` defined
+ * (`make TRACK_ALLOCATIONS=1`), AllocationTracker.cpp replaces the global
+ * `operator new`/`operator delete` family with versions that bump atomic
+ * counters before forwarding to malloc/free. In regular builds the replacement
+ * is compiled out and every query returns zero.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+namespace core
+{
+
+    /**
+     * @brief Monotonic counters since program start.
+     *
+     * Take two snapshots and subtract them to measure a region (e.g. one frame).
+     */
+    struct AllocationCounters
+    {
+        uint64_t allocations = 0;   ///< Calls to any operator new.
+        uint64_t deallocations = 0; ///< Calls to any operator delete with a non-null pointer.
+        uint64_t bytes = 0;         ///< Total bytes requested through operator new.
+
+        AllocationCounters operator-(const AllocationCounters &rhs) const
+        {
+            return {allocations - rhs.allocations, deallocations - rhs.deallocations, bytes - rhs.bytes};
+        }
+    };
+
+    /**
+     * @brief Read-only access to the global allocation counters.
+     */
+    class AllocationTracker
+    {
+    public:
+        /// True when the operator new/delete hooks are compiled in.
+        static constexpr bool enabled()
+        {
+#ifdef FLIGHTSIM_TRACK_ALLOCATIONS
+            return true;
+#else
+            return false;
+#endif
+        }
+
+        /// Current counter values (relaxed reads; exact on the calling thread).
+        static AllocationCounters snapshot();
+    };
+
+} // namespace core
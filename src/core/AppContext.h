@@ -11,8 +11,16 @@ extern "C"
 #include <GLFW/glfw3.h>
 }
 
+#include "core/FrameStats.h"
 #include "mission/AppState.h"
 
+namespace core
+{
+    class FrameArena;
+    class InputSystem;
+    class JobPool;
+}
+
 namespace mission
 {
     class MissionController;
@@ -37,7 +45,7 @@ namespace gfx
     class TerrainPlane;
     class SkyboxRenderer;
     class TextureCube;
-    class Shader;
+    class ShaderVariants;
 }
 
 class Model;
@@ -57,17 +65,22 @@ namespace core
         // --- Core Application State ---
         GLFWwindow *window = nullptr;                         ///< Pointer to the main GLFW window.
         mission::AppState appState = mission::AppState::Menu; ///< Current state of the application (e.g., Menu, Flight, Planning).
-        float deltaTime = 0.0f;                               ///< Time elapsed since the last frame (in seconds).
+        float deltaTime = 0.0f;                               ///< Frame time for the simulation (in seconds): clamped and smoothed by FramePacer.
+        float rawDeltaTime = 0.0f;                            ///< Unsmoothed time elapsed since the last frame (in seconds).
         float lastFrame = 0.0f;                               ///< Timestamp of the last frame (in seconds).
         int screenWidth = 1280;                               ///< Current width of the window/screen.
         int screenHeight = 720;                               ///< Current height of the window/screen.
+        FrameStats frameStats{};                              ///< Statistics of the last completed frame.
+        FrameArena *frameArena = nullptr;                     ///< Scratch memory reset at the top of every frame.
+        JobPool *jobPool = nullptr;                           ///< Worker threads for data-parallel loops and task graphs.
+        InputSystem *input = nullptr;                         ///< Keys, buttons and actions of the current frame.
 
         // --- Graphics Resources ---
         gfx::TerrainConfig *terrainConfig = nullptr; ///< Configuration for the flat terrain plane.
         gfx::TerrainPlane *terrain = nullptr;        ///< Pointer to the terrain renderer.
         gfx::SkyboxRenderer *skybox = nullptr;       ///< Pointer to the skybox renderer.
         gfx::TextureCube *cubemap = nullptr;         ///< Pointer to the skybox cubemap texture.
-        gfx::Shader *modelShader = nullptr;          ///< Shader used for rendering models (e.g., aircraft).
+        gfx::ShaderVariants *modelShaders = nullptr; ///< Model shader, one variant per material feature set.
         Model *aircraftModel = nullptr;              ///< Pointer to the 3D model of the aircraft.
 
         // --- Simulation Systems ---
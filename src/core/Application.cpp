@@ -1,6 +1,12 @@
 #include "core/Application.h"
+#include "core/FrameProfiler.h"
 
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
 #include <iostream>
+#include <memory>
+#include <sstream>
 #include <stdexcept>
 
 extern "C"
@@ -13,6 +19,8 @@ extern "C"
 #include "gfx/skybox/SkyboxRenderer.h"
 #include "gfx/terrain/TerrainPlane.h"
 #include "gfx/core/Shader.h"
+#include "gfx/core/ShaderVariants.h"
+#include "gfx/core/GLDebug.h"
 #include "gfx/geometry/Model.h"
 #include "mission/MissionController.h"
 #include "systems/FlightSimulationController.h"
@@ -29,6 +37,32 @@ namespace
     constexpr int kInitialWidth = 1280;
     constexpr int kInitialHeight = 720;
     const char *kMissionPath = "assets/missions/missions.json";
+    const char *kSkyboxAtlas = "assets/textures/skybox/Cubemap_Sky_22-512x512.png";
+
+    // F4 profiler capture: frames recorded and the Chrome trace they are written to.
+    constexpr uint32_t kTraceFrames = 300;
+    const char *kTracePath = "frame_trace.json";
+
+    // Frames a state may spend filling caches before allocations count as regressions.
+    constexpr uint64_t kAllocationWarmupFrames = 120;
+
+    const char *kShaderDirectory = "shaders";
+
+    // Stick/throttle mapping; missing file = built-in defaults.
+    const char *kJoystickConfig = "assets/joystick.json";
+
+    bool readTextFile(const std::string &path, std::string &out)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open())
+        {
+            return false;
+        }
+        std::stringstream buffer;
+        buffer << file.rdbuf();
+        out = buffer.str();
+        return true;
+    }
 }
 
 namespace core
@@ -39,12 +73,16 @@ namespace core
           uiManager_(std::make_unique<ui::UIManager>()),
           flightController_(std::make_unique<systems::FlightSimulationController>()),
           cameraRig_(std::make_unique<systems::CameraRig>()),
-          waypointSystem_(std::make_unique<systems::WaypointSystem>())
+          waypointSystem_(std::make_unique<systems::WaypointSystem>()),
+          missionPath_(kMissionPath)
     {
         // Initialize the shared context with default values
         context_.appState = mission::AppState::Menu;
         context_.screenWidth = kInitialWidth;
         context_.screenHeight = kInitialHeight;
+        context_.frameArena = &frameArena_;
+        context_.jobPool = &jobPool_;
+        context_.input = &input_;
     }
 
     Application::~Application()
@@ -92,10 +130,21 @@ namespace core
         {
             return false;
         }
+        logShaderStartup();
 
         // 5. Initialize application states
         initStates();
-        context_.lastFrame = static_cast<float>(glfwGetTime());
+
+        // 6. Pick up edits to missions and shaders while running
+        initHotReload();
+
+        // 7. Record or replay the input stream
+        if (!initInput())
+        {
+            return false;
+        }
+        frameTime_ = glfwGetTime();
+        context_.lastFrame = static_cast<float>(frameTime_);
         return true;
     }
 
@@ -105,6 +154,9 @@ namespace core
         glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
         glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
         glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+#ifdef FLIGHTSIM_GL_DEBUG
+        glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, GLFW_TRUE);
+#endif
 
         // Create the window
         window_ = glfwCreateWindow(kInitialWidth, kInitialHeight, kWindowTitle, nullptr, nullptr);
@@ -116,7 +168,8 @@ namespace core
 
         // Set context and callbacks
         glfwMakeContextCurrent(window_);
-        glfwSwapInterval(1); // Enable V-Sync
+        framePacer_.configure(pacingConfig_);
+        framePacer_.applySwapInterval();
         glfwSetWindowUserPointer(window_, this);
         glfwSetFramebufferSizeCallback(window_, [](GLFWwindow *window, int width, int height)
                                        {
@@ -124,6 +177,24 @@ namespace core
             app->onWindowResized(width, height);
         } });
 
+        // Keys, buttons and the cursor go through the input queue (timestamped at poll time)
+        glfwSetKeyCallback(window_, [](GLFWwindow *window, int key, int, int action, int mods)
+                           {
+        if (auto* app = reinterpret_cast<Application*>(glfwGetWindowUserPointer(window))) {
+            app->input_.onKey(key, action, mods);
+        } });
+        glfwSetMouseButtonCallback(window_, [](GLFWwindow *window, int button, int action, int mods)
+                                   {
+        if (auto* app = reinterpret_cast<Application*>(glfwGetWindowUserPointer(window))) {
+            app->input_.onMouseButton(button, action, mods);
+        } });
+        glfwSetCursorPosCallback(window_, [](GLFWwindow *window, double x, double y)
+                                 {
+        if (auto* app = reinterpret_cast<Application*>(glfwGetWindowUserPointer(window))) {
+            app->input_.onCursor(x, y);
+        } });
+        input_.attach(window_);
+
         context_.window = window_;
 
         // Get actual framebuffer size
@@ -155,14 +226,40 @@ namespace core
         std::cout << "Renderer: " << glGetString(GL_RENDERER) << std::endl;
         std::cout << "OpenGL version: " << glGetString(GL_VERSION) << std::endl;
 
+#ifdef FLIGHTSIM_GL_DEBUG
+        gfx::installDebugOutput();
+#endif
+        // Before any resource is created, so the binding shadow starts from a fresh context
+        if (gfx::GLStats::enabled())
+        {
+            gfx::GLStats::install();
+        }
+
         glViewport(0, 0, context_.screenWidth, context_.screenHeight);
         return true;
     }
 
     bool Application::initResources()
     {
+        // The skybox atlas decodes on a worker while the rest loads; the GL
+        // upload is a main-thread continuation collected below.
+        cubemap_ = std::make_unique<gfx::TextureCube>();
+        auto skyFaces = std::make_shared<util::CubeFaces>();
+        auto decodeSky = [skyFaces]()
+        {
+            gfx::TextureCube::decodeAtlas(kSkyboxAtlas, *skyFaces, false);
+        };
+        auto uploadSky = [this, skyFaces]()
+        {
+            if (skyFaces->face[0].pixels.empty() || !cubemap_->upload(*skyFaces))
+            {
+                throw std::runtime_error("Failed to load cubemap atlas");
+            }
+        };
+        TaskHandle skyUpload = jobPool_.then(jobPool_.submit(decodeSky), uploadSky, TaskAffinity::MainThread);
+
         // Load mission data
-        if (!missionController_->loadMissions(kMissionPath))
+        if (!missionController_->loadMissions(missionPath_))
         {
             return false;
         }
@@ -173,6 +270,8 @@ namespace core
             std::cerr << "Failed to initialize UI Manager" << std::endl;
             return false;
         }
+        uiManager_->setFrameArena(&frameArena_);
+        uiManager_->setJobPool(&jobPool_);
 
         // Initialize simulation systems
         flightController_->initialize();
@@ -189,14 +288,6 @@ namespace core
 
         try
         {
-            // Load skybox
-            cubemap_ = std::make_unique<gfx::TextureCube>();
-            if (!cubemap_->loadFromAtlas("assets/textures/skybox/Cubemap_Sky_22-512x512.png", false))
-            {
-                std::cerr << "Failed to load cubemap atlas" << std::endl;
-                return false;
-            }
-
             skybox_ = std::make_unique<gfx::SkyboxRenderer>();
             skybox_->init();
             skybox_->setCubemap(cubemap_.get());
@@ -211,8 +302,17 @@ namespace core
             }
 
             // Load aircraft model
-            modelShader_ = std::make_unique<gfx::Shader>("shaders/model.vert", "shaders/model.frag");
+            modelShaders_ = std::make_unique<gfx::ShaderVariants>("shaders/model.vert", "shaders/model.frag",
+                                                                  Model::shaderFeatures());
             aircraftModel_ = std::make_unique<Model>("assets/models/f16.glb");
+            // Variants build on first use; the aircraft's are wanted now, not on the first flight frame
+            for (uint32_t features : aircraftModel_->materialVariants())
+            {
+                modelShaders_->variant(features);
+            }
+
+            // Skybox: the decode has had the loads above to finish
+            jobPool_.wait(skyUpload);
         }
         catch (const std::exception &ex)
         {
@@ -230,12 +330,23 @@ namespace core
         context_.terrain = terrain_.get();
         context_.skybox = skybox_.get();
         context_.cubemap = cubemap_.get();
-        context_.modelShader = modelShader_.get();
+        context_.modelShaders = modelShaders_.get();
         context_.aircraftModel = aircraftModel_.get();
 
         return true;
     }
 
+    void Application::logShaderStartup() const
+    {
+        // Cold: everything compiled from source; warm: everything restored from shader_cache/
+        const gfx::ShaderBuildStats shaders = gfx::Shader::buildStats();
+        const char *cache = shaders.fromBinary == 0 ? "cold" : (shaders.compiled == 0 ? "warm" : "partial");
+        std::cout << std::fixed << std::setprecision(1) << "[Shader] Startup: " << shaders.programs
+                  << " programs in " << shaders.ms << " ms, " << cache << " cache (" << shaders.fromBinary
+                  << " from binary, " << shaders.compiled << " compiled, " << shaders.shared << " shared)"
+                  << std::defaultfloat << std::endl;
+    }
+
     void Application::initStates()
     {
         // Register available states
@@ -252,12 +363,132 @@ namespace core
         }
     }
 
+    void Application::initHotReload()
+    {
+        // Missions: the whole catalog is parsed off-thread into a fresh registry
+        auto prepareMissions = [this](const std::string &path) -> FileWatcher::Apply
+        {
+            auto registry = std::make_shared<mission::MissionRegistry>();
+            if (!registry->loadFromFile(path))
+            {
+                return {}; // error already reported with its line/column
+            }
+            // After the swap `registry` holds the old catalog, freed with this callback off-thread
+            return [this, registry]()
+            {
+                missionController_->replaceRegistry(*registry);
+                uiManager_->refreshMenu();
+                return true;
+            };
+        };
+
+        // Shaders: the file is read off-thread; compiling needs the GL context,
+        // so it happens on the main thread (the old program stays if it fails)
+        auto prepareShader = [](const std::string &path) -> FileWatcher::Apply
+        {
+            auto source = std::make_shared<std::string>();
+            if (!readTextFile(path, *source))
+            {
+                return {};
+            }
+            return [path, source]()
+            {
+                return gfx::Shader::reloadSource(path, *source);
+            };
+        };
+
+        fileWatcher_.watch(missionPath_, prepareMissions);
+        fileWatcher_.watch(kShaderDirectory, prepareShader);
+        if (fileWatcher_.start())
+        {
+            std::cout << "Hot reload: watching " << missionPath_ << " and " << kShaderDirectory << "/" << std::endl;
+        }
+    }
+
+    bool Application::initInput()
+    {
+        input_.setLatencyTest(latencyTest_);
+        if (latencyTest_)
+        {
+            std::cout << "Latency test: every key press flashes the bottom-left corner and logs key -> present time"
+                      << std::endl;
+        }
+        if (!inputRecordPath_.empty())
+        {
+            input_.startRecording(inputRecordPath_);
+        }
+        if (!inputReplayPath_.empty() && !input_.startReplay(inputReplayPath_))
+        {
+            return false;
+        }
+
+        // Joystick: a script from the command line stands in for the device
+        JoystickConfig joystickConfig;
+        const std::string configPath = joystickConfigPath_.empty() ? kJoystickConfig : joystickConfigPath_;
+        if (!joystickConfig.load(configPath) && !joystickConfigPath_.empty())
+        {
+            std::cerr << "Cannot read joystick configuration " << configPath << std::endl;
+        }
+        std::unique_ptr<JoystickDevice> device;
+        if (!virtualJoystickPath_.empty())
+        {
+            device = VirtualJoystickDevice::fromFile(virtualJoystickPath_);
+            if (!device)
+            {
+                return false;
+            }
+        }
+        else if (joystickConfig.enabled)
+        {
+            device = std::make_unique<LinuxJoystickDevice>(joystickConfig.device);
+        }
+        if (device)
+        {
+            joystick_.start(std::move(device), joystickConfig, glfwGetTime);
+            input_.setJoystick(&joystick_);
+        }
+        return true;
+    }
+
     void Application::mainLoop()
     {
         while (window_ && !glfwWindowShouldClose(window_))
         {
+            // Capped mode holds the frame here, before anything is polled, so the wait never ages the input
+            {
+                ProfileScope profile("FramePacer::wait");
+                framePacer_.waitForNextFrame();
+            }
+
+            // Folds last frame's markers into the profiler statistics (no-op while disabled).
+            FrameProfiler::newFrame();
+            ProfileScope frameProfile("Frame");
+
+            // Everything handed out by the arena last frame is released here.
+            frameArena_.reset();
+
+            // Edited missions/shaders are swapped in here, between frames.
+            {
+                ProfileScope profile("FileWatcher::dispatch");
+                fileWatcher_.dispatch();
+            }
+
+            // GL work queued by tasks (uploads of data decoded on the workers).
+            {
+                ProfileScope profile("JobPool::runMainThreadTasks");
+                jobPool_.runMainThreadTasks();
+            }
+
+            // Polled as late as possible, right before the frame consumes the events
+            {
+                ProfileScope profile("glfwPollEvents");
+                glfwPollEvents();
+            }
+
+            frameAllocStart_ = AllocationTracker::snapshot();
             updateTiming();
             handleResize();
+            handleDebugKeys();
 
             // Clear buffers
             glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
@@ -271,19 +502,164 @@ namespace core
                 activeState_->render(context_);
             }
 
+            uiManager_->renderProfiler(context_.frameStats);
+            updateFrameStats();
+
             // Check for state transitions
             transitionIfNeeded();
 
-            glfwSwapBuffers(window_);
-            glfwPollEvents();
+            if (input_.latencyProbe())
+            {
+                drawLatencyFlash();
+            }
+
+            framePacer_.endWork();
+
+            // Also before the swap (which may block until vblank): events that
+            // arrive while rendering get their own timestamp inside the next frame
+            {
+                ProfileScope profile("glfwPollEvents");
+                glfwPollEvents();
+            }
+            {
+                ProfileScope profile("glfwSwapBuffers");
+                glfwSwapBuffers(window_);
+            }
+
+            if (input_.latencyProbe())
+            {
+                glFinish();
+                input_.probePresented(glfwGetTime());
+            }
+        }
+    }
+
+    void Application::drawLatencyFlash() const
+    {
+        // Scissored clear: independent of whatever the state left bound
+        const int size = std::max(32, context_.screenHeight / 12);
+        glEnable(GL_SCISSOR_TEST);
+        glScissor(0, 0, size, size);
+        glClearColor(1.0f, 1.0f, 1.0f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT);
+        glDisable(GL_SCISSOR_TEST);
+    }
+
+    void Application::handleDebugKeys()
+    {
+        // F3: phase timing table; F4: Chrome trace of the next frames
+        if (input_.pressed(InputAction::ToggleProfiler))
+        {
+            uiManager_->toggleProfiler();
+        }
+        if (input_.pressed(InputAction::CaptureTrace) && !FrameProfiler::capturing())
+        {
+            FrameProfiler::startCapture(kTraceFrames, kTracePath);
+        }
+
+        // Markers only cost something while someone looks at them
+        const bool wanted = uiManager_->isProfilerVisible() || FrameProfiler::capturing();
+        if (wanted != FrameProfiler::enabled())
+        {
+            FrameProfiler::setEnabled(wanted);
+        }
+    }
+
+    void Application::updateFrameStats()
+    {
+        FrameStats &stats = context_.frameStats;
+        stats.frameIndex++;
+        framesInState_++;
+
+        stats.frameMs = framePacer_.lastFrameMs();
+        stats.smoothedFrameMs = context_.deltaTime * 1000.0f;
+        stats.limiterWaitMs = framePacer_.lastWaitMs();
+        stats.frameSpikes = framePacer_.spikes();
+        stats.clampedFrames = framePacer_.clampedFrames();
+
+        stats.arenaBytesUsed = frameArena_.used();
+        stats.arenaHighWater = frameArena_.highWaterMark();
+        stats.arenaCapacity = frameArena_.capacity();
+        stats.arenaOverflows = frameArena_.overflowCount();
+        stats.arenaOverflowBytes = frameArena_.overflowBytes();
+        stats.arenaTotalOverflows = frameArena_.totalOverflows();
+
+        const FileWatcher::Stats &reload = fileWatcher_.stats();
+        stats.hotReloadApplyMs = reload.frameApplyMs;
+        stats.hotReloads = reload.reloads;
+        stats.hotReloadsRejected = reload.rejected;
+        stats.hotReloadLatencyMs = reload.lastLatencyMs;
+
+        const gfx::RenderStateCounters renderState = gfx::RenderState::counters();
+        const gfx::RenderStateCounters stateFrame = renderState - lastStateCounters_;
+        lastStateCounters_ = renderState;
+        stats.stateRequests = stateFrame.requests;
+        stats.stateSkipped = stateFrame.skipped;
+
+        if (gfx::GLStats::enabled())
+        {
+            const gfx::GLCallCounters gl = gfx::GLStats::snapshot();
+            const gfx::GLCallCounters frame = gl - lastGlCounters_;
+            lastGlCounters_ = gl;
+            stats.glDrawCalls = frame.drawCalls;
+            stats.glVertices = frame.vertices;
+            stats.glBufferBytes = frame.bufferBytes;
+            stats.glTextureBinds = frame.textureBinds;
+            stats.glProgramBinds = frame.programBinds;
+            stats.glVaoBinds = frame.vaoBinds;
+            stats.glRedundantBinds = frame.redundantBinds;
+            stats.glUniformUploads = frame.uniformUploads;
+        }
+        if (frameArena_.overflowCount() > 0 && context_.lastFrame - lastArenaReportTime_ >= 1.0f)
+        {
+            lastArenaReportTime_ = context_.lastFrame;
+            std::cerr << "[FrameArena] Capacity exceeded: " << frameArena_.overflowCount() << " heap fallbacks ("
+                      << frameArena_.overflowBytes() << " bytes) over " << frameArena_.capacity() << " bytes" << std::endl;
+        }
+
+        if (!AllocationTracker::enabled())
+        {
+            return;
+        }
+
+        // Only the state's handleInput/update/render is measured; swap and event
+        // polling belong to the driver and are excluded on purpose.
+        const AllocationCounters frame = AllocationTracker::snapshot() - frameAllocStart_;
+        stats.allocations = frame.allocations;
+        stats.deallocations = frame.deallocations;
+        stats.allocatedBytes = frame.bytes;
+
+        if (framesInState_ <= kAllocationWarmupFrames || frame.allocations == 0)
+        {
+            return;
+        }
+
+        stats.allocatingFrames++;
+        if (frame.allocations > stats.peakFrameAllocations)
+        {
+            stats.peakFrameAllocations = frame.allocations;
+        }
+
+        if (context_.lastFrame - lastAllocReportTime_ >= 1.0f)
+        {
+            lastAllocReportTime_ = context_.lastFrame;
+            std::cerr << "[AllocTracker] Frame " << stats.frameIndex << ": " << frame.allocations
+                      << " allocations (" << frame.bytes << " bytes) in steady state" << std::endl;
         }
     }
 
     void Application::updateTiming()
     {
-        float currentFrame = static_cast<float>(glfwGetTime());
-        context_.deltaTime = currentFrame - context_.lastFrame;
-        context_.lastFrame = currentFrame;
+        // Events polled since the previous frame started happened inside [frameTime_, now]
+        const double currentFrame = glfwGetTime();
+        input_.beginFrame(frameTime_, currentFrame);
+        frameTime_ = currentFrame;
+        framePacer_.beginFrame();
+
+        // Smoothed from the input system's value (the recorded one while replaying), so replays stay deterministic
+        context_.rawDeltaTime = input_.frameDeltaTime();
+        context_.deltaTime = framePacer_.smooth(context_.rawDeltaTime);
+        context_.lastFrame = static_cast<float>(currentFrame);
     }
 
     void Application::handleResize()
@@ -314,6 +690,7 @@ namespace core
         }
         context_.screenWidth = width;
         context_.screenHeight = height;
+        framesInState_ = 0;
         if (gladInitialized_)
         {
             glViewport(0, 0, width, height);
@@ -357,6 +734,7 @@ namespace core
         activeStateId_ = desired;
         activeState_ = it->second.get();
         activeState_->onEnter(context_);
+        framesInState_ = 0;
     }
 
     void Application::shutdown()
@@ -366,6 +744,18 @@ namespace core
             return;
         }
         shuttingDown_ = true;
+        fileWatcher_.stop();
+        joystick_.stop();
+        input_.stop();
+        framePacer_.logSession();
+
+        // Outstanding tasks may still upload to GL: finish them while the context lives.
+        jobPool_.waitIdle();
+        FrameProfiler::setEnabled(false);
+        if (gladInitialized_)
+        {
+            FrameProfiler::releaseGpu();
+        }
 
         // Exit the current state
         if (activeState_)
@@ -377,7 +767,7 @@ namespace core
 
         // Release resources
         aircraftModel_.reset();
-        modelShader_.reset();
+        modelShaders_.reset();
         terrain_.reset();
         skybox_.reset();
         cubemap_.reset();
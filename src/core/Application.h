@@ -6,9 +6,18 @@
 #pragma once
 
 #include <memory>
+#include <string>
 #include <unordered_map>
 
+#include "core/AllocationTracker.h"
 #include "core/AppContext.h"
+#include "core/FileWatcher.h"
+#include "core/FrameArena.h"
+#include "core/FramePacer.h"
+#include "core/InputSystem.h"
+#include "core/JobPool.h"
+#include "gfx/core/GLStats.h"
+#include "gfx/core/RenderState.h"
 
 // ============================================================================
 // Forward Declarations
@@ -24,7 +33,7 @@ namespace gfx
     class TerrainPlane;   ///< Flat textured terrain renderer.
     class TextureCube;    ///< Cubemap texture wrapper for skybox rendering.
     class SkyboxRenderer; ///< Renderer for the environment skybox using cubemaps.
-    class Shader;         ///< OpenGL shader program wrapper for vertex/fragment shaders.
+    class ShaderVariants; ///< Shader permutations selected by feature bitmask.
 }
 
 class Model; ///< 3D model loader and renderer (e.g., aircraft mesh).
@@ -108,6 +117,37 @@ namespace core
          */
         int run();
 
+        /**
+         * @brief Overrides the mission catalog loaded at start-up (default `assets/missions/missions.json`).
+         *
+         * A sibling `.pack` is still preferred when it is up to date.
+         */
+        void setMissionPath(const std::string &path) { missionPath_ = path; }
+
+        /// Records every frame's input to `path` (`.fsinput`) from start-up.
+        void setInputRecording(const std::string &path) { inputRecordPath_ = path; }
+
+        /// Replays a `.fsinput` recording instead of the keyboard and mouse.
+        void setInputReplay(const std::string &path) { inputReplayPath_ = path; }
+
+        /**
+         * @brief Latency test mode: each key press flashes a corner of the next frame.
+         *
+         * The flash frame is followed by glFinish() and the time from the key
+         * callback to that point is logged. A photodiode or high-speed camera on
+         * the corner adds what the OS, USB and display contribute.
+         */
+        void setLatencyTest(bool enabled) { latencyTest_ = enabled; }
+
+        /// Stick/throttle mapping to load instead of `assets/joystick.json`.
+        void setJoystickConfig(const std::string &path) { joystickConfigPath_ = path; }
+
+        /// Feeds the flight controls from a keyframe script (VirtualJoystickDevice) instead of a device.
+        void setVirtualJoystick(const std::string &path) { virtualJoystickPath_ = path; }
+
+        /// Presentation mode, frame cap, deltaTime smoothing and frame-time logging (`--present`, `--frame-log`).
+        void setFramePacing(const FramePacingConfig &config) { pacingConfig_ = config; }
+
     private:
         /**
          * @brief Initializes all application subsystems.
@@ -137,11 +177,24 @@ namespace core
          */
         bool initResources();
 
+        /**
+         * @brief Logs shader startup time and whether the program binary cache was cold or warm.
+         */
+        void logShaderStartup() const;
+
         /**
          * @brief Initializes the application states (Menu, Flight, Planning).
          */
         void initStates();
 
+        /**
+         * @brief Watches the mission catalog and `shaders/` for edits.
+         *
+         * Missions are parsed and shader files read on the watcher thread; the
+         * new versions are swapped in by mainLoop() before the next frame.
+         */
+        void initHotReload();
+
         /**
          * @brief The main application loop.
          *
@@ -150,10 +203,38 @@ namespace core
         void mainLoop();
 
         /**
-         * @brief Updates the frame timing variables (deltaTime).
+         * @brief Updates the frame timing variables (deltaTime) and hands the polled input to the frame.
          */
         void updateTiming();
 
+        /**
+         * @brief Starts the input recording or replay requested on the command line, and the joystick sampler.
+         *
+         * @return false if the replay file or the joystick script cannot be used.
+         */
+        bool initInput();
+
+        /**
+         * @brief Latency test: paints the bottom-left corner white on the frame that consumed a key press.
+         */
+        void drawLatencyFlash() const;
+
+        /**
+         * @brief Publishes the statistics of the frame that just ended in `context_.frameStats`.
+         *
+         * Includes frame arena usage. In allocation-tracking builds it also reports
+         * steady-state frames that touched the heap after the warm-up period of the
+         * active state.
+         */
+        void updateFrameStats();
+
+        /**
+         * @brief F3 toggles the profiler table, F4 records a Chrome trace.
+         *
+         * The profiler is enabled only while the table is visible or a capture runs.
+         */
+        void handleDebugKeys();
+
         /**
          * @brief Checks if the window has been resized and updates the context if necessary.
          */
@@ -191,7 +272,7 @@ namespace core
         std::unique_ptr<gfx::TerrainPlane> terrain_;        ///< Flat terrain renderer.
         std::unique_ptr<gfx::TextureCube> cubemap_;         ///< Cubemap texture for skybox environment mapping.
         std::unique_ptr<gfx::SkyboxRenderer> skybox_;       ///< Skybox renderer for atmospheric background.
-        std::unique_ptr<gfx::Shader> modelShader_;          ///< Shader program for rendering 3D models with lighting.
+        std::unique_ptr<gfx::ShaderVariants> modelShaders_; ///< Lit model shader, one variant per material feature set.
         std::unique_ptr<Model> aircraftModel_;              ///< 3D model of the aircraft mesh.
 
         // --- System Managers ---
@@ -201,6 +282,39 @@ namespace core
         std::unique_ptr<systems::CameraRig> cameraRig_;                         ///< Manages camera positioning and view modes.
         std::unique_ptr<systems::WaypointSystem> waypointSystem_;               ///< Handles waypoint management and navigation rendering.
 
+        std::string missionPath_; ///< Mission catalog loaded by initResources().
+
+        // --- Input ---
+        JoystickSampler joystick_;        ///< Stick/throttle sampling thread; declared first so it outlives input_.
+        InputSystem input_;               ///< Event queue and action map fed by the window callbacks.
+        std::string inputRecordPath_;     ///< `--record-input` target, empty when not recording.
+        std::string inputReplayPath_;     ///< `--replay-input` source, empty when not replaying.
+        std::string joystickConfigPath_;  ///< `--joystick-config`, empty for the default.
+        std::string virtualJoystickPath_; ///< `--virtual-joystick` script, empty to use the device.
+        bool latencyTest_ = false;        ///< `--latency-test`.
+        double frameTime_ = 0.0;          ///< glfwGetTime() at the start of the current frame.
+
+        // --- Frame Pacing ---
+        FramePacingConfig pacingConfig_; ///< Requested on the command line; applied in initWindow().
+        FramePacer framePacer_;          ///< Swap interval, frame cap, smoothed deltaTime and frame-time histograms.
+
+        // --- Per-Frame Scratch Memory ---
+        FrameArena frameArena_; ///< Bump allocator for transient per-frame data, reset at the top of mainLoop.
+
+        // --- Worker Threads ---
+        JobPool jobPool_; ///< Shared workers (HUD recording, asset decode, ...); drained and joined on destruction.
+
+        // --- Hot Reload ---
+        FileWatcher fileWatcher_; ///< inotify thread for missions and shaders; stopped in shutdown().
+
+        // --- Frame Statistics ---
+        AllocationCounters frameAllocStart_{}; ///< Allocation counters sampled at the top of the frame.
+        gfx::GLCallCounters lastGlCounters_{}; ///< GL call counters at the end of the previous frame.
+        gfx::RenderStateCounters lastStateCounters_{}; ///< State cache counters at the end of the previous frame.
+        uint64_t framesInState_ = 0;           ///< Frames since the last state transition (warm-up gate).
+        float lastAllocReportTime_ = -1.0f;    ///< Rate limit for steady-state allocation reports.
+        float lastArenaReportTime_ = -1.0f;    ///< Rate limit for arena overflow reports.
+
         // --- Initialization Flags ---
         bool glfwInitialized_ = false; ///< Flag indicating if GLFW has been initialized.
         bool gladInitialized_ = false; ///< Flag indicating if GLAD has been initialized.
@@ -0,0 +1,137 @@
+/**
+ * @file FileWatcher.h
+ * @brief Background inotify watcher used to hot-reload data and shaders.
+ *
+ * A change goes through three steps:
+ * 1. The watcher thread collects inotify events and waits until the file has
+ *    been quiet for the debounce interval (editors write in several steps).
+ * 2. Still on the watcher thread, the entry's `Prepare` callback loads the new
+ *    version (read, parse, validate) without touching live objects.
+ * 3. `dispatch()`, called by the main loop between frames, runs the returned
+ *    `Apply` callback, which swaps the new version in.
+ * If preparing or applying fails, the previous version stays in use. Applied
+ * callbacks are destroyed on the watcher thread, so an `Apply` that swaps the
+ * old version into its captures also frees it off the main thread.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace core
+{
+
+    /**
+     * @brief Debounced file watcher with off-thread preparation.
+     *
+     * Watches are registered before `start()`. Directories are watched rather
+     * than files, so editors that save via rename (write to a temp file, then
+     * move it over the original) are still seen. Linux only (inotify); on
+     * other platforms `start()` returns false and nothing is reloaded.
+     */
+    class FileWatcher
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        /// Swaps a prepared version in; runs on the main thread. Returns false if rejected.
+        using Apply = std::function<bool()>;
+
+        /// Loads the changed file on the watcher thread. An empty Apply keeps the current version.
+        using Prepare = std::function<Apply(const std::string &path)>;
+
+        /// Reload counters, read by the main thread after dispatch().
+        struct Stats
+        {
+            uint64_t reloads = 0;       ///< Changes applied since start-up.
+            uint64_t rejected = 0;      ///< Changes that failed to prepare or apply.
+            float lastLatencyMs = 0.0f; ///< Last change: first event → applied (includes the debounce).
+            float lastPrepareMs = 0.0f; ///< Last change: time spent on the watcher thread.
+            float lastApplyMs = 0.0f;   ///< Last change: time spent on the main thread.
+            float frameApplyMs = 0.0f;  ///< Main-thread time spent in the last dispatch().
+        };
+
+        explicit FileWatcher(std::chrono::milliseconds debounce = std::chrono::milliseconds(150));
+        ~FileWatcher();
+
+        FileWatcher(const FileWatcher &) = delete;
+        FileWatcher &operator=(const FileWatcher &) = delete;
+
+        /**
+         * @brief Registers a file, or a directory (every file in it), to watch.
+         * @return false if the watcher is already running.
+         */
+        bool watch(const std::string &path, Prepare prepare);
+
+        /// Starts the watcher thread. Returns false if inotify is unavailable.
+        bool start();
+
+        /// Stops and joins the watcher thread; pending changes are dropped.
+        void stop();
+
+        bool isRunning() const { return thread_.joinable(); }
+
+        /**
+         * @brief Applies every change prepared since the last call (main thread).
+         * @return Number of changes applied successfully.
+         */
+        std::size_t dispatch();
+
+        const Stats &stats() const { return stats_; }
+
+    private:
+        struct Entry
+        {
+            std::string directory; ///< Directory handed to inotify.
+            std::string file;      ///< File name inside it, empty for "any file".
+            Prepare prepare;
+            int watchId = -1;
+        };
+
+        /// A change waiting for its debounce interval to expire (watcher thread only).
+        struct Pending
+        {
+            std::size_t entry;
+            Clock::time_point firstEvent;
+            Clock::time_point lastEvent;
+        };
+
+        /// A change prepared on the watcher thread, waiting for dispatch().
+        struct Ready
+        {
+            std::string path;
+            Apply apply;
+            Clock::time_point firstEvent;
+            float prepareMs;
+        };
+
+        void run();
+        void readEvents();
+        void preparePending(Clock::time_point now);
+        void wake();
+
+        std::chrono::milliseconds debounce_;
+        std::vector<Entry> entries_;
+        std::unordered_map<std::string, Pending> pending_;
+
+        std::mutex readyMutex_;
+        std::vector<Ready> ready_;    ///< Guarded by readyMutex_.
+        std::vector<Apply> retired_;  ///< Applied callbacks to destroy on the watcher thread (readyMutex_).
+        std::vector<Ready> applying_; ///< Main-thread scratch, swapped with ready_.
+
+        int inotifyFd_ = -1;
+        int wakeFd_ = -1; ///< eventfd that interrupts poll() (retired callbacks, stop()).
+        std::atomic<bool> stopping_{false};
+        std::thread thread_;
+        Stats stats_;
+    };
+
+} // namespace core
@@ -0,0 +1,93 @@
+#include "core/FrameArena.h"
+
+#include <algorithm>
+#include <cstdarg>
+#include <cstdio>
+#include <new>
+
+namespace core
+{
+
+    FrameArena::FrameArena(std::size_t capacity)
+        : buffer_(new unsigned char[capacity]),
+          capacity_(capacity)
+    {
+    }
+
+    FrameArena::~FrameArena()
+    {
+        reset();
+    }
+
+    void *FrameArena::allocate(std::size_t bytes, std::size_t alignment)
+    {
+        if (bytes == 0)
+        {
+            bytes = 1;
+        }
+
+        // Align the offset relative to the real address, not to the block start.
+        const std::uintptr_t base = reinterpret_cast<std::uintptr_t>(buffer_.get());
+        const std::uintptr_t current = base + offset_;
+        const std::uintptr_t aligned = (current + alignment - 1) & ~static_cast<std::uintptr_t>(alignment - 1);
+        const std::size_t newOffset = static_cast<std::size_t>(aligned - base) + bytes;
+
+        if (newOffset <= capacity_)
+        {
+            offset_ = newOffset;
+            highWater_ = std::max(highWater_, offset_);
+            return reinterpret_cast<void *>(aligned);
+        }
+
+        // Block exhausted: serve from the heap and chain the block so reset() frees it.
+        // The header is padded to the requested alignment so the payload stays aligned.
+        const std::size_t blockAlign = std::max(alignof(OverflowBlock), alignment);
+        const std::size_t header = (sizeof(OverflowBlock) + blockAlign - 1) & ~(blockAlign - 1);
+        unsigned char *raw = static_cast<unsigned char *>(::operator new(header + bytes, std::align_val_t{blockAlign}));
+
+        auto *block = reinterpret_cast<OverflowBlock *>(raw);
+        block->next = overflowHead_;
+        block->alignment = blockAlign;
+        overflowHead_ = block;
+
+        overflowCount_++;
+        overflowBytes_ += bytes;
+        totalOverflows_++;
+        return raw + header;
+    }
+
+    void FrameArena::reset()
+    {
+        while (overflowHead_)
+        {
+            OverflowBlock *block = overflowHead_;
+            overflowHead_ = block->next;
+            ::operator delete(block, std::align_val_t{block->alignment});
+        }
+
+        offset_ = 0;
+        overflowCount_ = 0;
+        overflowBytes_ = 0;
+    }
+
+    FrameString formatFrameString(FrameArena *arena, const char *fmt, ...)
+    {
+        FrameString result{FrameAllocator<char>(arena)};
+
+        va_list args;
+        va_start(args, fmt);
+        va_list argsCopy;
+        va_copy(argsCopy, args);
+        const int length = std::vsnprintf(nullptr, 0, fmt, args);
+        va_end(args);
+
+        if (length > 0)
+        {
+            result.resize(static_cast<std::size_t>(length));
+            std::vsnprintf(result.data(), result.size() + 1, fmt, argsCopy);
+        }
+        va_end(argsCopy);
+        return result;
+    }
+
+} // namespace core
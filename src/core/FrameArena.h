@@ -0,0 +1,147 @@
+/**
+ * @file FrameArena.h
+ * @brief Per-frame linear (bump) allocator and allocator-aware container aliases.
+ *
+ * Transient CPU data that only lives for one frame (label strings, polyline
+ * points, split text lines) is carved out of a single pre-reserved block and
+ * released all at once when `core::Application` resets the arena at the top of
+ * the main loop. Nothing allocated here may be kept across frames.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace core
+{
+
+    /**
+     * @brief Bump allocator over a fixed block, reset once per frame.
+     *
+     * Allocation is a pointer increment. When the block is exhausted the request
+     * falls back to the global heap; those blocks are chained and freed on the
+     * next `reset()`, and counted so the capacity can be tuned from the stats.
+     */
+    class FrameArena
+    {
+    public:
+        static constexpr std::size_t kDefaultCapacity = 256 * 1024; ///< 256 KiB per frame.
+
+        explicit FrameArena(std::size_t capacity = kDefaultCapacity);
+        ~FrameArena();
+
+        FrameArena(const FrameArena &) = delete;
+        FrameArena &operator=(const FrameArena &) = delete;
+
+        /**
+         * @brief Returns `bytes` of storage aligned to `alignment` (power of two).
+         *
+         * Never returns nullptr: overflows are served from the heap.
+         */
+        void *allocate(std::size_t bytes, std::size_t alignment = alignof(std::max_align_t));
+
+        /// Releases every allocation of the frame and frees overflow blocks.
+        void reset();
+
+        std::size_t capacity() const { return capacity_; }
+        std::size_t used() const { return offset_; }                ///< Bytes used in the block this frame.
+        std::size_t highWaterMark() const { return highWater_; }    ///< Largest `used()` seen since start-up.
+        uint64_t overflowCount() const { return overflowCount_; }   ///< Heap fallbacks this frame.
+        uint64_t overflowBytes() const { return overflowBytes_; }   ///< Bytes served by heap fallbacks this frame.
+        uint64_t totalOverflows() const { return totalOverflows_; } ///< Heap fallbacks since start-up.
+
+    private:
+        /// Header placed at the start of each heap fallback allocation.
+        struct OverflowBlock
+        {
+            OverflowBlock *next;
+            std::size_t alignment;
+        };
+
+        std::unique_ptr<unsigned char[]> buffer_;
+        std::size_t capacity_ = 0;
+        std::size_t offset_ = 0;
+        std::size_t highWater_ = 0;
+
+        OverflowBlock *overflowHead_ = nullptr;
+        uint64_t overflowCount_ = 0;
+        uint64_t overflowBytes_ = 0;
+        uint64_t totalOverflows_ = 0;
+    };
+
+    /**
+     * @brief Standard allocator adaptor that draws from a FrameArena.
+     *
+     * `deallocate` is a no-op: memory is reclaimed when the arena resets. A
+     * default-constructed allocator (no arena) forwards to the global heap so
+     * components keep working before an arena has been attached.
+     */
+    template <typename T>
+    class FrameAllocator
+    {
+    public:
+        using value_type = T;
+
+        FrameAllocator() noexcept = default;
+        explicit FrameAllocator(FrameArena *arena) noexcept : arena_(arena) {}
+
+        template <typename U>
+        FrameAllocator(const FrameAllocator<U> &other) noexcept : arena_(other.arena()) {}
+
+        T *allocate(std::size_t n)
+        {
+            if (arena_)
+            {
+                return static_cast<T *>(arena_->allocate(n * sizeof(T), alignof(T)));
+            }
+            return static_cast<T *>(::operator new(n * sizeof(T)));
+        }
+
+        void deallocate(T *ptr, std::size_t) noexcept
+        {
+            if (!arena_)
+            {
+                ::operator delete(ptr);
+            }
+        }
+
+        FrameArena *arena() const noexcept { return arena_; }
+
+        template <typename U>
+        bool operator==(const FrameAllocator<U> &other) const noexcept { return arena_ == other.arena(); }
+        template <typename U>
+        bool operator!=(const FrameAllocator<U> &other) const noexcept { return arena_ != other.arena(); }
+
+    private:
+        FrameArena *arena_ = nullptr;
+    };
+
+    // ========================================================================
+    // Container aliases for frame-scoped data
+    // ========================================================================
+
+    template <typename T>
+    using FrameVector = std::vector<T, FrameAllocator<T>>;
+
+    using FrameString = std::basic_string<char, std::char_traits<char>, FrameAllocator<char>>;
+
+    /// Empty vector bound to `arena` with `reserveCount` elements pre-reserved.
+    template <typename T>
+    FrameVector<T> makeFrameVector(FrameArena *arena, std::size_t reserveCount = 0)
+    {
+        FrameVector<T> vec{FrameAllocator<T>(arena)};
+        if (reserveCount > 0)
+        {
+            vec.reserve(reserveCount);
+        }
+        return vec;
+    }
+
+    /// printf-style formatting into a string whose storage lives in `arena`.
+    FrameString formatFrameString(FrameArena *arena, const char *fmt, ...);
+
+} // namespace core
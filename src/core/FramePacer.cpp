@@ -0,0 +1,364 @@
+/**
+ * @file FramePacer.cpp
+ * @brief Implementation of the frame pacer, limiter and frame-time histograms.
+ */
+
+#include "core/FramePacer.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+
+extern "C"
+{
+#include <GLFW/glfw3.h>
+}
+
+namespace core
+{
+
+    namespace
+    {
+        constexpr auto MIN_SLACK = std::chrono::microseconds(100);
+        constexpr auto MAX_SLACK = std::chrono::milliseconds(4);
+        constexpr float SPIKE_FACTOR = 2.0f; ///< A frame this many times the average counts as a spike.
+
+        float millisecondsBetween(FrameLimiter::Clock::time_point start, FrameLimiter::Clock::time_point end)
+        {
+            return std::chrono::duration<float, std::milli>(end - start).count();
+        }
+    } // namespace
+
+    const char *presentModeName(PresentMode mode)
+    {
+        switch (mode)
+        {
+        case PresentMode::VSync:
+            return "vsync";
+        case PresentMode::Adaptive:
+            return "adaptive";
+        case PresentMode::Uncapped:
+            return "uncapped";
+        case PresentMode::Capped:
+            return "capped";
+        }
+        return "?";
+    }
+
+    bool FramePacingConfig::parseMode(const std::string &text)
+    {
+        if (text == "vsync")
+            mode = PresentMode::VSync;
+        else if (text == "adaptive")
+            mode = PresentMode::Adaptive;
+        else if (text == "uncapped")
+            mode = PresentMode::Uncapped;
+        else if (text.rfind("capped-", 0) == 0)
+        {
+            char *end = nullptr;
+            const float fps = std::strtof(text.c_str() + 7, &end);
+            if (end == text.c_str() + 7 || *end != '\0' || !(fps >= 1.0f && fps <= 2000.0f))
+            {
+                return false;
+            }
+            mode = PresentMode::Capped;
+            capFps = fps;
+        }
+        else
+        {
+            return false;
+        }
+        return true;
+    }
+
+    // ---------------------------------------------------------------------
+    //  Histogram
+    // ---------------------------------------------------------------------
+
+    void FrameTimeHistogram::add(float ms)
+    {
+        const int bin = ms < 0.0f ? 0 : std::min(BINS, static_cast<int>(ms / BIN_MS));
+        bins_[bin]++;
+        count_++;
+        totalMs_ += ms;
+        maxMs_ = std::max(maxMs_, ms);
+    }
+
+    void FrameTimeHistogram::clear()
+    {
+        *this = FrameTimeHistogram{};
+    }
+
+    float FrameTimeHistogram::percentileMs(float fraction) const
+    {
+        if (count_ == 0)
+        {
+            return 0.0f;
+        }
+        const uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(fraction * static_cast<float>(count_) + 0.5f));
+        uint64_t seen = 0;
+        for (int bin = 0; bin < BINS; ++bin)
+        {
+            seen += bins_[bin];
+            if (seen >= rank)
+            {
+                return std::min(maxMs_, (bin + 1) * BIN_MS);
+            }
+        }
+        return maxMs_;
+    }
+
+    void FrameTimeHistogram::print(const char *label, int rows) const
+    {
+        if (count_ == 0)
+        {
+            return;
+        }
+        int first = 0;
+        int last = BINS;
+        while (first < BINS && bins_[first] == 0)
+            first++;
+        while (last > first && bins_[last] == 0)
+            last--;
+
+        // Adjacent bins are merged so the table stays short
+        const int group = std::max(1, (last - first + rows) / std::max(rows, 1));
+        uint64_t peak = 0;
+        for (int start = first; start <= last; start += group)
+        {
+            uint64_t sum = 0;
+            for (int bin = start; bin < std::min(start + group, last + 1); ++bin)
+                sum += bins_[bin];
+            peak = std::max(peak, sum);
+        }
+
+        std::cout << "[FramePacer] " << label << " histogram (" << count_ << " frames):" << std::endl;
+        char line[160];
+        for (int start = first; start <= last; start += group)
+        {
+            const int end = std::min(start + group, last + 1);
+            uint64_t sum = 0;
+            for (int bin = start; bin < end; ++bin)
+                sum += bins_[bin];
+            const int bar = static_cast<int>((sum * 40 + peak - 1) / std::max<uint64_t>(peak, 1));
+            if (start >= BINS)
+            {
+                std::snprintf(line, sizeof(line), "  >= %6.2f ms       %-40.*s %llu", BINS * BIN_MS, bar,
+                              "########################################", static_cast<unsigned long long>(sum));
+            }
+            else
+            {
+                std::snprintf(line, sizeof(line), "  %6.2f-%6.2f ms  %-40.*s %llu", start * BIN_MS,
+                              std::min(end, BINS) * BIN_MS, bar, "########################################",
+                              static_cast<unsigned long long>(sum));
+            }
+            std::cout << line << std::endl;
+        }
+    }
+
+    // ---------------------------------------------------------------------
+    //  Limiter
+    // ---------------------------------------------------------------------
+
+    float FrameLimiter::waitUntil(Clock::time_point target)
+    {
+        const Clock::time_point start = Clock::now();
+        Clock::time_point now = start;
+        while (target - now > slack_)
+        {
+            const Clock::duration request = (target - now) - slack_;
+            std::this_thread::sleep_for(request);
+            const Clock::time_point woke = Clock::now();
+
+            // Keep the slack above what the timer overshoots; let it shrink back slowly
+            const Clock::duration overshoot = woke - (now + request);
+            slack_ = std::clamp(std::max(overshoot + overshoot / 2, slack_ - slack_ / 64), Clock::duration(MIN_SLACK),
+                                Clock::duration(MAX_SLACK));
+            now = woke;
+        }
+        while (now < target)
+        {
+            std::this_thread::yield();
+            now = Clock::now();
+        }
+        return millisecondsBetween(start, now);
+    }
+
+    // ---------------------------------------------------------------------
+    //  Pacer
+    // ---------------------------------------------------------------------
+
+    void FramePacer::configure(const FramePacingConfig &config)
+    {
+        config_ = config;
+        config_.smoothingFrames = std::clamp(config_.smoothingFrames, 1, MAX_SMOOTHING);
+        config_.maxDeltaTime = std::max(config_.maxDeltaTime, 0.001f);
+        if (config_.mode == PresentMode::Capped && config_.capFps < 1.0f)
+        {
+            config_.mode = PresentMode::Uncapped;
+        }
+        historyCount_ = 0;
+        historyNext_ = 0;
+        started_ = false;
+    }
+
+    void FramePacer::applySwapInterval()
+    {
+        if (config_.mode == PresentMode::Adaptive && !glfwExtensionSupported("GLX_EXT_swap_control_tear") &&
+            !glfwExtensionSupported("WGL_EXT_swap_control_tear"))
+        {
+            std::cout << "[FramePacer] No swap-tear support in this driver; adaptive falls back to vsync" << std::endl;
+            config_.mode = PresentMode::VSync;
+        }
+
+        int interval = 1;
+        switch (config_.mode)
+        {
+        case PresentMode::VSync:
+            interval = 1;
+            break;
+        case PresentMode::Adaptive:
+            interval = -1;
+            break;
+        case PresentMode::Uncapped:
+        case PresentMode::Capped:
+            interval = 0;
+            break;
+        }
+        glfwSwapInterval(interval);
+
+        std::cout << "[FramePacer] Present mode " << presentModeName(config_.mode);
+        if (config_.mode == PresentMode::Capped)
+        {
+            std::cout << " at " << config_.capFps << " fps";
+        }
+        std::cout << " (swap interval " << interval << "), deltaTime averaged over " << config_.smoothingFrames
+                  << " frames, clamped at " << config_.maxDeltaTime * 1000.0f << " ms" << std::endl;
+    }
+
+    float FramePacer::waitForNextFrame()
+    {
+        lastWaitMs_ = 0.0f;
+        if (config_.mode != PresentMode::Capped)
+        {
+            return 0.0f;
+        }
+
+        const auto period =
+            std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / config_.capFps));
+        const Clock::time_point now = Clock::now();
+        if (nextSlot_ == Clock::time_point{} || now - nextSlot_ > period)
+        {
+            // First frame, or more than a frame late: restart the schedule instead of racing to catch up
+            nextSlot_ = now + period;
+            return 0.0f;
+        }
+        lastWaitMs_ = limiter_.waitUntil(nextSlot_);
+        nextSlot_ += period;
+        return lastWaitMs_;
+    }
+
+    void FramePacer::beginFrame()
+    {
+        const Clock::time_point now = Clock::now();
+        if (!started_)
+        {
+            started_ = true;
+            frameStart_ = now;
+            windowStart_ = now;
+            return;
+        }
+
+        lastFrameMs_ = millisecondsBetween(frameStart_, now);
+        frameStart_ = now;
+        windowFrames_.add(lastFrameMs_);
+        sessionFrames_.add(lastFrameMs_);
+
+        const double seconds = std::chrono::duration<double>(now - windowStart_).count();
+        if (config_.logInterval > 0.0f && seconds >= config_.logInterval)
+        {
+            logSummary(seconds);
+            windowFrames_.clear();
+            windowWork_.clear();
+            windowSpikes_ = 0;
+            windowStart_ = now;
+        }
+    }
+
+    void FramePacer::endWork()
+    {
+        if (started_)
+        {
+            const float ms = millisecondsBetween(frameStart_, Clock::now());
+            windowWork_.add(ms);
+            sessionWork_.add(ms);
+        }
+    }
+
+    float FramePacer::smooth(float rawDelta)
+    {
+        float delta = std::max(rawDelta, 0.0f);
+        if (delta > config_.maxDeltaTime)
+        {
+            clamped_++;
+            delta = config_.maxDeltaTime;
+        }
+        if (historyCount_ > 0 && delta > SPIKE_FACTOR * smoothed_)
+        {
+            spikes_++;
+            windowSpikes_++;
+        }
+
+        // Moving average: each frame's time is handed out over the next N frames, none of it lost
+        if (historyCount_ == 0)
+        {
+            std::fill(history_, history_ + config_.smoothingFrames, delta);
+            historyCount_ = config_.smoothingFrames;
+        }
+        history_[historyNext_] = delta;
+        historyNext_ = (historyNext_ + 1) % config_.smoothingFrames;
+
+        float sum = 0.0f;
+        for (int i = 0; i < config_.smoothingFrames; ++i)
+        {
+            sum += history_[i];
+        }
+        smoothed_ = sum / static_cast<float>(config_.smoothingFrames);
+        return smoothed_;
+    }
+
+    void FramePacer::logSummary(double seconds)
+    {
+        std::cout << std::fixed << std::setprecision(2) << "[FramePacer] " << presentModeName(config_.mode) << ": "
+                  << windowFrames_.count() << " frames in " << seconds << " s ("
+                  << windowFrames_.count() / std::max(seconds, 1e-6) << " fps) | frame avg " << windowFrames_.meanMs()
+                  << " p50 " << windowFrames_.percentileMs(0.5f) << " p95 " << windowFrames_.percentileMs(0.95f)
+                  << " p99 " << windowFrames_.percentileMs(0.99f) << " max " << windowFrames_.maxMs()
+                  << " ms | work p50 " << windowWork_.percentileMs(0.5f) << " p99 " << windowWork_.percentileMs(0.99f)
+                  << " ms | " << windowSpikes_ << " spikes";
+        if (config_.mode == PresentMode::Capped)
+        {
+            std::cout << " | limiter slack " << limiter_.slackMs() << " ms";
+        }
+        std::cout << std::defaultfloat << std::endl;
+    }
+
+    void FramePacer::logSession() const
+    {
+        if (sessionFrames_.count() == 0)
+        {
+            return;
+        }
+        std::cout << std::fixed << std::setprecision(2) << "[FramePacer] Session (" << presentModeName(config_.mode)
+                  << "): frame avg " << sessionFrames_.meanMs() << " p50 " << sessionFrames_.percentileMs(0.5f)
+                  << " p99 " << sessionFrames_.percentileMs(0.99f) << " max " << sessionFrames_.maxMs() << " ms, "
+                  << spikes_ << " spikes, " << clamped_ << " clamped to " << config_.maxDeltaTime * 1000.0f << " ms"
+                  << std::defaultfloat << std::endl;
+        sessionFrames_.print("Frame interval");
+        sessionWork_.print("CPU work (frame start to swap)");
+    }
+
+} // namespace core
@@ -0,0 +1,176 @@
+/**
+ * @file FramePacer.h
+ * @brief Presentation modes, frame limiter, delta-time smoothing and frame-time histograms.
+ *
+ * The main loop used to hard-code vsync and hand the raw frame interval to
+ * the states. FramePacer picks the swap interval for the selected mode,
+ * holds capped frames to their slot (sleep, then spin for the last stretch
+ * the OS timer cannot hit), smooths the delta time the simulation sees and
+ * clamps hitches, and logs where the frame time goes.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace core
+{
+
+    enum class PresentMode : uint8_t
+    {
+        VSync,    ///< Swap interval 1: one frame per refresh (default).
+        Adaptive, ///< Swap interval -1: vsync, but a late frame tears instead of waiting a whole refresh.
+        Uncapped, ///< Swap interval 0, no limiter (benchmarks, software-rendered CI).
+        Capped    ///< Swap interval 0, limiter at `capFps`.
+    };
+
+    const char *presentModeName(PresentMode mode);
+
+    /**
+     * @brief Pacing options (command line `--present`, `--frame-log`).
+     */
+    struct FramePacingConfig
+    {
+        PresentMode mode = PresentMode::VSync;
+        float capFps = 0.0f;        ///< Capped: target frame rate.
+        int smoothingFrames = 8;    ///< Frames averaged into deltaTime (1 = raw).
+        float maxDeltaTime = 0.25f; ///< Longer frames are clamped; the rest of the hitch is dropped.
+        float logInterval = 10.0f;  ///< Seconds between summary lines (0: only the session histogram at exit).
+
+        /**
+         * @brief Parses "vsync", "adaptive", "uncapped" or "capped-N".
+         * @return false (config untouched) for anything else.
+         */
+        bool parseMode(const std::string &text);
+    };
+
+    /**
+     * @brief Frame times in fixed 0.25 ms bins up to 100 ms, plus an overflow bin.
+     */
+    class FrameTimeHistogram
+    {
+    public:
+        static constexpr float BIN_MS = 0.25f;
+        static constexpr int BINS = 400;
+
+        void add(float ms);
+        void clear();
+
+        uint64_t count() const { return count_; }
+        float meanMs() const { return count_ ? static_cast<float>(totalMs_ / count_) : 0.0f; }
+        float maxMs() const { return maxMs_; }
+        /// Upper edge of the bin holding the `fraction` quantile (exact for values past the last bin: the max).
+        float percentileMs(float fraction) const;
+
+        /// One text bar per group of bins, at most `rows` rows, empty ends trimmed.
+        void print(const char *label, int rows = 24) const;
+
+    private:
+        uint32_t bins_[BINS + 1] = {};
+        uint64_t count_ = 0;
+        double totalMs_ = 0.0;
+        float maxMs_ = 0.0f;
+    };
+
+    /**
+     * @brief Sleep-then-spin wait with a self-tuning spin margin.
+     *
+     * A plain sleep overshoots by the timer slack (tens of µs on Linux, up to
+     * a few ms elsewhere), which is a large part of a 4 ms frame at 240 Hz.
+     * The limiter sleeps until `slack` before the target, then spins. Each
+     * sleep's overshoot raises the slack; it decays slowly otherwise.
+     */
+    class FrameLimiter
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        /// Returns once `target` has passed; the result is the time spent waiting, in ms.
+        float waitUntil(Clock::time_point target);
+
+        float slackMs() const { return std::chrono::duration<float, std::milli>(slack_).count(); }
+
+    private:
+        Clock::duration slack_ = std::chrono::milliseconds(1);
+    };
+
+    /**
+     * @brief Owned by Application; every method runs on the main thread.
+     *
+     * Per frame: waitForNextFrame() at the top of the loop (before input is
+     * polled, so a capped frame still renders fresh input), beginFrame() and
+     * smooth() when timing is updated, endWork() right before the swap.
+     */
+    class FramePacer
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        void configure(const FramePacingConfig &config);
+        const FramePacingConfig &config() const { return config_; }
+        /// Mode actually in use (Adaptive falls back to VSync without swap-tear support).
+        PresentMode mode() const { return config_.mode; }
+
+        /// Sets the swap interval of the current GL context for the mode.
+        void applySwapInterval();
+
+        /// Capped mode: waits for the next frame slot. Returns ms waited (0 in the other modes).
+        float waitForNextFrame();
+
+        /// Frame start: records the interval since the previous one and logs the summary when due.
+        void beginFrame();
+        /// CPU work done (before swap): records the time since beginFrame().
+        void endWork();
+
+        /**
+         * @brief Smoothed delta time for the states.
+         *
+         * `rawDelta` comes from the input system (the recorded value while
+         * replaying), so replays smooth the same way. Frames longer than
+         * `maxDeltaTime` are clamped; the rest is averaged over the last
+         * `smoothingFrames`, which keeps the total simulated time equal to the
+         * clamped wall time but spreads a hitch over several frames.
+         */
+        float smooth(float rawDelta);
+
+        float lastFrameMs() const { return lastFrameMs_; }
+        float lastWaitMs() const { return lastWaitMs_; }
+        uint64_t clampedFrames() const { return clamped_; }
+        /// Frames over twice the smoothed average since start-up.
+        uint64_t spikes() const { return spikes_; }
+
+        /// Prints the whole-session histograms (at shutdown).
+        void logSession() const;
+
+    private:
+        static constexpr int MAX_SMOOTHING = 32;
+
+        void logSummary(double seconds);
+
+        FramePacingConfig config_;
+        FrameLimiter limiter_;
+        Clock::time_point nextSlot_{};
+        Clock::time_point frameStart_{};
+        Clock::time_point windowStart_{};
+        bool started_ = false;
+
+        float history_[MAX_SMOOTHING] = {};
+        int historyCount_ = 0;
+        int historyNext_ = 0;
+        float smoothed_ = 0.0f;
+
+        float lastFrameMs_ = 0.0f;
+        float lastWaitMs_ = 0.0f;
+        uint64_t clamped_ = 0;
+        uint64_t spikes_ = 0;
+        uint64_t windowSpikes_ = 0;
+
+        FrameTimeHistogram windowFrames_; ///< Since the last summary line.
+        FrameTimeHistogram windowWork_;
+        FrameTimeHistogram sessionFrames_;
+        FrameTimeHistogram sessionWork_;
+    };
+
+} // namespace core
@@ -0,0 +1,513 @@
+#include "core/FrameProfiler.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+
+extern "C"
+{
+#include <glad/glad.h>
+}
+
+namespace core
+{
+
+    std::atomic<bool> FrameProfiler::enabled_{false};
+
+    namespace
+    {
+        constexpr uint32_t kGpuTid = 0xFFFF;        ///< Pseudo thread of GPU events in the trace.
+        constexpr uint64_t kStatsIntervalFrames = 15; ///< The overlay would be unreadable if it changed every frame.
+        constexpr std::size_t kNoMarker = ~std::size_t(0);
+
+        /// Single-producer (its thread) / single-consumer (newFrame) event ring.
+        struct ThreadRing
+        {
+            std::array<ProfileEvent, FrameProfiler::kRingCapacity> events;
+            std::atomic<uint64_t> head{0}; ///< Next slot to write (producer).
+            std::atomic<uint64_t> tail{0}; ///< Next slot to read (consumer).
+            std::atomic<uint64_t> dropped{0};
+            uint32_t tid = 0;
+        };
+
+        struct Phase
+        {
+            const char *name = nullptr;
+            bool gpu = false;
+            uint32_t depth = 0;
+            std::array<float, FrameProfiler::kWindowFrames> history{};
+            std::size_t count = 0; ///< Valid entries in history.
+            std::size_t next = 0;  ///< Slot the next frame overwrites.
+            double frameMs = 0.0;  ///< Sum for the frame being folded.
+            bool touched = false;
+            float lastMs = 0.0f;
+        };
+
+        struct CapturedEvent
+        {
+            ProfileEvent event;
+            uint32_t tid = 0;
+        };
+
+        struct GpuMarker
+        {
+            const char *name = nullptr;
+            GLuint begin = 0;
+            GLuint end = 0;
+            uint32_t depth = 0;
+        };
+
+        /// Queries of one frame, read kGpuLatency frames later.
+        struct GpuFrame
+        {
+            std::vector<GLuint> queries; ///< Pool, grown during warm-up and reused.
+            std::size_t used = 0;
+            std::vector<GpuMarker> markers;
+            GLuint lastIssued = 0;
+            uint64_t frame = 0;
+            int64_t cpuMinusGpuNs = 0; ///< Maps GPU timestamps onto the CPU clock.
+            bool pending = false;
+        };
+
+        // Producer side
+        std::mutex registryMutex; ///< Only taken when a thread records its first event, and by newFrame.
+        std::vector<std::unique_ptr<ThreadRing>> rings;
+        thread_local ThreadRing *localRing = nullptr;
+        thread_local uint32_t localDepth = 0;
+
+        // Consumer side (GL thread)
+        uint64_t frameIndex = 0; ///< Frame started by the last newFrame.
+        uint32_t mainTid = 0;
+        std::vector<Phase> phases;
+        std::vector<ProfilePhaseStats> stats;
+        std::array<float, FrameProfiler::kWindowFrames> scratch{};
+
+        bool captureActive = false;
+        uint64_t captureStart = 0;
+        uint64_t captureEnd = 0;
+        std::string capturePath;
+        std::vector<CapturedEvent> captured;
+
+        std::array<GpuFrame, FrameProfiler::kGpuLatency> gpuFrames;
+        GpuFrame *gpuCurrent = nullptr;
+        std::vector<std::size_t> gpuStack;
+        uint64_t gpuDroppedFrames = 0;
+
+        ThreadRing &threadRing()
+        {
+            if (!localRing)
+            {
+                auto ring = std::make_unique<ThreadRing>();
+                std::lock_guard<std::mutex> lock(registryMutex);
+                ring->tid = static_cast<uint32_t>(rings.size());
+                localRing = ring.get();
+                rings.push_back(std::move(ring));
+            }
+            return *localRing;
+        }
+
+        Phase &phaseFor(const char *name, bool gpu, uint32_t depth)
+        {
+            for (Phase &phase : phases)
+            {
+                if (phase.gpu == gpu && (phase.name == name || std::strcmp(phase.name, name) == 0))
+                {
+                    phase.depth = std::min(phase.depth, depth);
+                    return phase;
+                }
+            }
+            phases.emplace_back();
+            Phase &phase = phases.back();
+            phase.name = name;
+            phase.gpu = gpu;
+            phase.depth = depth;
+            return phase;
+        }
+
+        void fold(const ProfileEvent &event, bool gpu)
+        {
+            Phase &phase = phaseFor(event.name, gpu, event.depth);
+            phase.frameMs += static_cast<double>(event.endNs - event.startNs) * 1e-6;
+            phase.touched = true;
+        }
+
+        /// Pushes the per-frame sums of one kind (CPU or GPU) into the windows.
+        void commit(bool gpu)
+        {
+            for (Phase &phase : phases)
+            {
+                if (phase.gpu != gpu || !phase.touched)
+                {
+                    continue;
+                }
+                phase.lastMs = static_cast<float>(phase.frameMs);
+                phase.history[phase.next] = phase.lastMs;
+                phase.next = (phase.next + 1) % FrameProfiler::kWindowFrames;
+                phase.count = std::min(phase.count + 1, FrameProfiler::kWindowFrames);
+                phase.frameMs = 0.0;
+                phase.touched = false;
+            }
+        }
+
+        void capture(const ProfileEvent &event, uint32_t tid, uint64_t frame)
+        {
+            if (captureActive && frame >= captureStart && frame < captureEnd)
+            {
+                captured.push_back({event, tid});
+            }
+        }
+
+        void refreshStats()
+        {
+            stats.clear();
+            for (int pass = 0; pass < 2; ++pass)
+            {
+                for (const Phase &phase : phases)
+                {
+                    if (phase.gpu != (pass == 1) || phase.count == 0)
+                    {
+                        continue;
+                    }
+                    ProfilePhaseStats entry;
+                    entry.name = phase.name;
+                    entry.gpu = phase.gpu;
+                    entry.depth = phase.depth;
+                    entry.lastMs = phase.lastMs;
+                    entry.frames = static_cast<uint32_t>(phase.count);
+
+                    std::copy(phase.history.begin(), phase.history.begin() + phase.count, scratch.begin());
+                    const auto end = scratch.begin() + phase.count;
+                    double sum = 0.0;
+                    for (auto it = scratch.begin(); it != end; ++it)
+                    {
+                        sum += *it;
+                    }
+                    entry.avgMs = static_cast<float>(sum / static_cast<double>(phase.count));
+                    entry.minMs = *std::min_element(scratch.begin(), end);
+                    const std::size_t rank = static_cast<std::size_t>(std::ceil(0.99 * phase.count)) - 1;
+                    std::nth_element(scratch.begin(), scratch.begin() + rank, end);
+                    entry.p99Ms = scratch[rank];
+                    stats.push_back(entry);
+                }
+            }
+        }
+
+        void resolveGpuFrame(GpuFrame &slot)
+        {
+            slot.pending = false;
+            if (slot.markers.empty())
+            {
+                return;
+            }
+
+            // Timestamps complete in order: the last one issued being ready means all are.
+            GLint available = 0;
+            glGetQueryObjectiv(slot.lastIssued, GL_QUERY_RESULT_AVAILABLE, &available);
+            if (!available)
+            {
+                gpuDroppedFrames++;
+                return;
+            }
+
+            for (const GpuMarker &marker : slot.markers)
+            {
+                GLuint64 begin = 0;
+                GLuint64 end = 0;
+                glGetQueryObjectui64v(marker.begin, GL_QUERY_RESULT, &begin);
+                glGetQueryObjectui64v(marker.end, GL_QUERY_RESULT, &end);
+
+                ProfileEvent event;
+                event.name = marker.name;
+                event.startNs = static_cast<uint64_t>(static_cast<int64_t>(begin) + slot.cpuMinusGpuNs);
+                event.endNs = event.startNs + (end > begin ? end - begin : 0);
+                event.depth = marker.depth;
+                fold(event, true);
+                capture(event, kGpuTid, slot.frame);
+            }
+            commit(true);
+        }
+
+        void jsonString(std::ostream &out, const char *text)
+        {
+            out << '"';
+            for (const char *c = text; *c; ++c)
+            {
+                if (*c == '"' || *c == '\\')
+                {
+                    out << '\\';
+                }
+                out << *c;
+            }
+            out << '"';
+        }
+    } // namespace
+
+    void FrameProfiler::setEnabled(bool enabled)
+    {
+        if (enabled && !FrameProfiler::enabled())
+        {
+            phases.clear();
+            stats.clear();
+        }
+        enabled_.store(enabled, std::memory_order_relaxed);
+    }
+
+    uint64_t FrameProfiler::nowNs()
+    {
+        static const std::chrono::steady_clock::time_point origin = std::chrono::steady_clock::now();
+        return static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - origin).count());
+    }
+
+    uint32_t &FrameProfiler::threadDepth()
+    {
+        return localDepth;
+    }
+
+    void FrameProfiler::record(const char *name, uint64_t startNs, uint64_t endNs, uint32_t depth)
+    {
+        ThreadRing &ring = threadRing();
+        const uint64_t head = ring.head.load(std::memory_order_relaxed);
+        if (head - ring.tail.load(std::memory_order_acquire) >= kRingCapacity)
+        {
+            ring.dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        ProfileEvent &event = ring.events[head % kRingCapacity];
+        event.name = name;
+        event.startNs = startNs;
+        event.endNs = endNs;
+        event.depth = depth;
+        ring.head.store(head + 1, std::memory_order_release);
+    }
+
+    void FrameProfiler::newFrame()
+    {
+        const uint64_t finished = frameIndex++;
+        mainTid = threadRing().tid;
+
+        // CPU events: everything closed since the last call belongs to the frame that just ended.
+        {
+            std::lock_guard<std::mutex> lock(registryMutex);
+            for (const std::unique_ptr<ThreadRing> &ring : rings)
+            {
+                const uint64_t tail = ring->tail.load(std::memory_order_relaxed);
+                const uint64_t head = ring->head.load(std::memory_order_acquire);
+                for (uint64_t i = tail; i < head; ++i)
+                {
+                    const ProfileEvent &event = ring->events[i % kRingCapacity];
+                    fold(event, false);
+                    capture(event, ring->tid, finished);
+                }
+                ring->tail.store(head, std::memory_order_release);
+            }
+        }
+        commit(false);
+
+        // GPU events of the frame that used this slot kGpuLatency frames ago.
+        GpuFrame &slot = gpuFrames[frameIndex % kGpuLatency];
+        if (slot.pending)
+        {
+            resolveGpuFrame(slot);
+        }
+        gpuStack.clear();
+        gpuCurrent = nullptr;
+        if (enabled())
+        {
+            slot.used = 0;
+            slot.markers.clear();
+            slot.frame = frameIndex;
+            GLint64 gpuNow = 0;
+            glGetInteger64v(GL_TIMESTAMP, &gpuNow);
+            slot.cpuMinusGpuNs = static_cast<int64_t>(nowNs()) - static_cast<int64_t>(gpuNow);
+            gpuCurrent = &slot;
+        }
+
+        if (frameIndex % kStatsIntervalFrames == 0)
+        {
+            refreshStats();
+        }
+
+        if (captureActive && frameIndex >= captureEnd + kGpuLatency)
+        {
+            writeChromeTrace(capturePath);
+            captureActive = false;
+            captured.clear();
+            captured.shrink_to_fit();
+        }
+    }
+
+    void FrameProfiler::beginGpu(const char *name)
+    {
+        if (!gpuCurrent)
+        {
+            gpuStack.push_back(kNoMarker);
+            return;
+        }
+
+        GpuFrame &slot = *gpuCurrent;
+        if (slot.used + 2 > slot.queries.size())
+        {
+            const std::size_t first = slot.queries.size();
+            slot.queries.resize(first + 32);
+            glGenQueries(32, slot.queries.data() + first);
+        }
+
+        GpuMarker marker;
+        marker.name = name;
+        marker.begin = slot.queries[slot.used++];
+        marker.end = slot.queries[slot.used++];
+        marker.depth = static_cast<uint32_t>(gpuStack.size());
+        glQueryCounter(marker.begin, GL_TIMESTAMP);
+
+        gpuStack.push_back(slot.markers.size());
+        slot.markers.push_back(marker);
+    }
+
+    void FrameProfiler::endGpu()
+    {
+        if (gpuStack.empty())
+        {
+            return;
+        }
+        const std::size_t index = gpuStack.back();
+        gpuStack.pop_back();
+        if (index == kNoMarker || !gpuCurrent)
+        {
+            return;
+        }
+        GpuFrame &slot = *gpuCurrent;
+        glQueryCounter(slot.markers[index].end, GL_TIMESTAMP);
+        slot.lastIssued = slot.markers[index].end;
+        slot.pending = true;
+    }
+
+    void FrameProfiler::releaseGpu()
+    {
+        for (GpuFrame &slot : gpuFrames)
+        {
+            if (!slot.queries.empty())
+            {
+                glDeleteQueries(static_cast<GLsizei>(slot.queries.size()), slot.queries.data());
+            }
+            slot = GpuFrame{};
+        }
+        gpuCurrent = nullptr;
+        gpuStack.clear();
+    }
+
+    void FrameProfiler::startCapture(uint32_t frames, const std::string &path)
+    {
+        if (!enabled())
+        {
+            setEnabled(true);
+        }
+        captured.clear();
+        captured.reserve(static_cast<std::size_t>(frames) * 64);
+        captureStart = frameIndex + 1;
+        captureEnd = captureStart + std::max<uint32_t>(frames, 1);
+        capturePath = path;
+        captureActive = true;
+        std::cout << "[Profiler] Capturing " << frames << " frames to " << path << std::endl;
+    }
+
+    bool FrameProfiler::capturing()
+    {
+        return captureActive;
+    }
+
+    bool FrameProfiler::writeChromeTrace(const std::string &path)
+    {
+        std::ofstream out(path);
+        if (!out)
+        {
+            std::cerr << "[Profiler] Cannot write " << path << std::endl;
+            return false;
+        }
+
+        uint64_t origin = ~uint64_t(0);
+        std::vector<uint32_t> tids;
+        for (const CapturedEvent &entry : captured)
+        {
+            origin = std::min(origin, entry.event.startNs);
+            if (std::find(tids.begin(), tids.end(), entry.tid) == tids.end())
+            {
+                tids.push_back(entry.tid);
+            }
+        }
+        if (captured.empty())
+        {
+            origin = 0;
+        }
+
+        out << std::fixed << std::setprecision(3);
+        out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+        out << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"FlightSim\"}}";
+        for (uint32_t tid : tids)
+        {
+            const char *label = tid == kGpuTid ? "GPU" : (tid == mainTid ? "Main thread" : nullptr);
+            out << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << tid << ",\"args\":{\"name\":\"";
+            if (label)
+            {
+                out << label;
+            }
+            else
+            {
+                out << "Thread " << tid;
+            }
+            out << "\"}}";
+            // Main thread on top, GPU right below it, other threads after
+            const int order = tid == mainTid ? 0 : (tid == kGpuTid ? 1 : 2 + static_cast<int>(tid));
+            out << ",\n{\"name\":\"thread_sort_index\",\"ph\":\"M\",\"pid\":1,\"tid\":" << tid
+                << ",\"args\":{\"sort_index\":" << order << "}}";
+        }
+        for (const CapturedEvent &entry : captured)
+        {
+            const ProfileEvent &event = entry.event;
+            out << ",\n{\"name\":";
+            jsonString(out, event.name);
+            out << ",\"cat\":\"" << (entry.tid == kGpuTid ? "gpu" : "cpu") << "\",\"ph\":\"X\",\"pid\":1,\"tid\":"
+                << entry.tid << ",\"ts\":" << static_cast<double>(event.startNs - origin) * 1e-3
+                << ",\"dur\":" << static_cast<double>(event.endNs - event.startNs) * 1e-3 << "}";
+        }
+        out << "\n]}\n";
+
+        if (!out)
+        {
+            std::cerr << "[Profiler] Error writing " << path << std::endl;
+            return false;
+        }
+        std::cout << "[Profiler] Wrote " << captured.size() << " events (" << tids.size() << " tracks) to " << path
+                  << std::endl;
+        return true;
+    }
+
+    const std::vector<ProfilePhaseStats> &FrameProfiler::phaseStats()
+    {
+        return stats;
+    }
+
+    uint64_t FrameProfiler::droppedGpuFrames()
+    {
+        return gpuDroppedFrames;
+    }
+
+    uint64_t FrameProfiler::droppedEvents()
+    {
+        uint64_t dropped = 0;
+        std::lock_guard<std::mutex> lock(registryMutex);
+        for (const std::unique_ptr<ThreadRing> &ring : rings)
+        {
+            dropped += ring->dropped.load(std::memory_order_relaxed);
+        }
+        return dropped;
+    }
+
+} // namespace core
@@ -0,0 +1,176 @@
+/**
+ * @file FrameProfiler.h
+ * @brief Scoped CPU/GPU timing markers, rolling per-phase statistics and Chrome trace export.
+ *
+ * Any thread may open a `ProfileScope`; closed scopes are appended to a ring
+ * owned by that thread (single producer, no locks). Once per frame the main
+ * thread drains every ring in `FrameProfiler::newFrame`, folds the events into
+ * per-phase min/avg/p99 over a rolling window and, while a capture runs,
+ * keeps them for a Chrome `trace_event` JSON file (chrome://tracing, Perfetto).
+ *
+ * GPU passes are bracketed with `GL_TIMESTAMP` queries (they nest, unlike
+ * `GL_TIME_ELAPSED`, which the HUD already uses) and read back a few frames
+ * later without stalling.
+ *
+ * Disabled by default; a disabled scope costs one relaxed atomic load.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace core
+{
+
+    /**
+     * @brief One closed scope as written by the thread that ran it.
+     */
+    struct ProfileEvent
+    {
+        const char *name = nullptr; ///< String literal (never copied).
+        uint64_t startNs = 0;       ///< FrameProfiler::nowNs() clock.
+        uint64_t endNs = 0;
+        uint32_t depth = 0; ///< Nesting level on its thread (0 = outermost).
+    };
+
+    /**
+     * @brief Timings of one phase over the rolling window.
+     *
+     * Values are per-frame sums (a phase entered twice in a frame counts
+     * once, with both durations); frames where the phase did not run are
+     * not part of the window.
+     */
+    struct ProfilePhaseStats
+    {
+        const char *name = nullptr;
+        bool gpu = false;   ///< GPU timestamps instead of CPU time.
+        uint32_t depth = 0; ///< Shallowest nesting level seen (for indentation).
+        float lastMs = 0.0f;
+        float minMs = 0.0f;
+        float avgMs = 0.0f;
+        float p99Ms = 0.0f;
+        uint32_t frames = 0; ///< Samples in the window.
+    };
+
+    /// What a ProfileScope times.
+    enum class ProfileTiming
+    {
+        Cpu,   ///< CPU time on the calling thread.
+        CpuGpu ///< Also GPU time of the commands issued inside (GL thread only).
+    };
+
+    /**
+     * @brief Process-wide profiler; every member is static.
+     *
+     * `newFrame`, the GPU markers, captures and `phaseStats` belong to the
+     * thread that owns the GL context. `record` (and therefore ProfileScope)
+     * may be called from any thread.
+     */
+    class FrameProfiler
+    {
+    public:
+        static constexpr std::size_t kRingCapacity = 8192; ///< Events a thread can hold between two drains.
+        static constexpr std::size_t kWindowFrames = 240;  ///< Rolling window of the statistics.
+        static constexpr int kGpuLatency = 4;              ///< Frames GPU queries are given before being read.
+
+        static bool enabled() { return enabled_.load(std::memory_order_relaxed); }
+        /// Turning it on clears the statistics; GPU markers start on the next frame.
+        static void setEnabled(bool enabled);
+
+        /// Monotonic nanoseconds since the first call.
+        static uint64_t nowNs();
+
+        /// Appends a closed scope to the calling thread's ring (dropped and counted when full).
+        static void record(const char *name, uint64_t startNs, uint64_t endNs, uint32_t depth);
+
+        /**
+         * @brief Frame boundary (top of Application::mainLoop).
+         *
+         * Drains the rings, reads GPU queries that are ready, updates the
+         * rolling statistics and, when a capture finished, writes the trace.
+         */
+        static void newFrame();
+
+        static void beginGpu(const char *name);
+        static void endGpu();
+        /// Deletes the query objects (before the GL context is destroyed).
+        static void releaseGpu();
+
+        /**
+         * @brief Records the next `frames` frames and writes them to `path`.
+         *
+         * The file is written kGpuLatency frames after the last one so its GPU
+         * events are included. Enables the profiler if needed.
+         */
+        static void startCapture(uint32_t frames, const std::string &path);
+        static bool capturing();
+
+        /// Writes captured events as Chrome `trace_event` JSON.
+        static bool writeChromeTrace(const std::string &path);
+
+        /// CPU phases first, then GPU, each in first-seen order (refreshed every few frames).
+        static const std::vector<ProfilePhaseStats> &phaseStats();
+        /// Events lost because a ring was full, since start-up.
+        static uint64_t droppedEvents();
+        /// GPU frames whose queries were not ready after kGpuLatency frames (skipped).
+        static uint64_t droppedGpuFrames();
+
+        /// Depth counter of the calling thread, maintained by ProfileScope.
+        static uint32_t &threadDepth();
+
+    private:
+        static std::atomic<bool> enabled_;
+    };
+
+    /**
+     * @brief Times the enclosing block under `name` (a string literal).
+     */
+    class ProfileScope
+    {
+    public:
+        explicit ProfileScope(const char *name, ProfileTiming timing = ProfileTiming::Cpu)
+        {
+            if (!FrameProfiler::enabled())
+            {
+                return;
+            }
+            name_ = name;
+            depth_ = FrameProfiler::threadDepth()++;
+            gpu_ = timing == ProfileTiming::CpuGpu;
+            if (gpu_)
+            {
+                FrameProfiler::beginGpu(name);
+            }
+            startNs_ = FrameProfiler::nowNs();
+        }
+
+        ~ProfileScope()
+        {
+            if (!name_)
+            {
+                return;
+            }
+            const uint64_t endNs = FrameProfiler::nowNs();
+            if (gpu_)
+            {
+                FrameProfiler::endGpu();
+            }
+            FrameProfiler::threadDepth()--;
+            FrameProfiler::record(name_, startNs_, endNs, depth_);
+        }
+
+        ProfileScope(const ProfileScope &) = delete;
+        ProfileScope &operator=(const ProfileScope &) = delete;
+
+    private:
+        const char *name_ = nullptr; ///< null when the profiler was off at construction.
+        uint64_t startNs_ = 0;
+        uint32_t depth_ = 0;
+        bool gpu_ = false;
+    };
+
+} // namespace core
@@ -0,0 +1,87 @@
+/**
+ * @file FrameStats.h
+ * @brief Per-frame runtime statistics published through the AppContext.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+namespace core
+{
+
+    /**
+     * @brief Counters measured over the last completed frame.
+     *
+     * `Application::mainLoop` fills this struct at the end of every frame so
+     * states and overlays can read it from `AppContext::frameStats`.
+     */
+    struct FrameStats
+    {
+        uint64_t frameIndex = 0; ///< Number of frames completed since start-up.
+
+        // --- Frame pacing (core::FramePacer) ---
+        float frameMs = 0.0f;         ///< Wall time between the starts of the last two frames.
+        float smoothedFrameMs = 0.0f; ///< deltaTime handed to the states, in ms.
+        float limiterWaitMs = 0.0f;   ///< Time the frame cap held this frame (0 unless capped).
+        uint64_t frameSpikes = 0;     ///< Frames over twice the smoothed average since start-up.
+        uint64_t clampedFrames = 0;   ///< Frames longer than the deltaTime clamp since start-up.
+
+        // --- Heap activity (only populated when built with FLIGHTSIM_TRACK_ALLOCATIONS) ---
+        uint64_t allocations = 0;          ///< operator new calls during the last frame.
+        uint64_t deallocations = 0;        ///< operator delete calls during the last frame.
+        uint64_t allocatedBytes = 0;       ///< Bytes requested from the heap during the last frame.
+        uint64_t peakFrameAllocations = 0; ///< Highest per-frame allocation count seen after warm-up.
+        uint64_t allocatingFrames = 0;     ///< Frames after warm-up that performed any allocation.
+
+        // --- Frame arena (core::FrameArena) ---
+        uint64_t arenaBytesUsed = 0;      ///< Bytes bump-allocated during the last frame.
+        uint64_t arenaHighWater = 0;      ///< Peak bytes used in any single frame since start-up.
+        uint64_t arenaCapacity = 0;       ///< Size of the pre-reserved arena block.
+        uint64_t arenaOverflows = 0;      ///< Heap fallbacks during the last frame (arena exhausted).
+        uint64_t arenaOverflowBytes = 0;  ///< Bytes served by those heap fallbacks.
+        uint64_t arenaTotalOverflows = 0; ///< Heap fallbacks since start-up.
+
+        // --- Hot reload (core::FileWatcher) ---
+        float hotReloadApplyMs = 0.0f;   ///< Main-thread time spent swapping in reloaded files this frame.
+        float hotReloadLatencyMs = 0.0f; ///< Last reload: file change → applied, including the debounce.
+        uint64_t hotReloads = 0;         ///< Reloads applied since start-up.
+        uint64_t hotReloadsRejected = 0; ///< Edits that failed to parse/compile (previous version kept).
+
+        // --- GL calls (only populated when built with FLIGHTSIM_GL_STATS) ---
+        uint64_t glDrawCalls = 0;      ///< Draw calls issued during the last frame, all passes.
+        uint64_t glVertices = 0;       ///< Vertices/indices submitted by those draws.
+        uint64_t glBufferBytes = 0;    ///< Bytes uploaded with glBufferData/glBufferSubData.
+        uint64_t glTextureBinds = 0;   ///< glBindTexture calls.
+        uint64_t glProgramBinds = 0;   ///< glUseProgram calls.
+        uint64_t glVaoBinds = 0;       ///< glBindVertexArray calls.
+        uint64_t glRedundantBinds = 0; ///< Binds of an object that was already bound.
+        uint64_t glUniformUploads = 0; ///< glUniform* calls.
+
+        // --- Render state cache (gfx::RenderState) ---
+        uint64_t stateRequests = 0; ///< Program/VAO/texture/blend/depth/cull changes requested this frame.
+        uint64_t stateSkipped = 0;  ///< Of those, already in place (no GL call issued).
+
+        // --- HUD cost (written by FlightState on frames where the HUD is drawn) ---
+        bool hudSdfBackend = false;      ///< true when instrument shapes use the analytic (SDF) backend.
+        float hudCpuMs = 0.0f;           ///< CPU time spent in FlightHUD::render().
+        uint64_t hudUploadBytes = 0;     ///< Vertex, index and uniform bytes uploaded by the HUD.
+        uint64_t hudDrawCalls = 0;       ///< Draw calls issued by the HUD.
+        float hudGpuMs = 0.0f;           ///< GPU time of the HUD pass (timer query, a few frames late).
+        float hudRecordMs = 0.0f;        ///< Time spent recording instrument draw lists (0 if the layer was reused).
+        uint32_t hudRecordThreads = 1;   ///< Threads that were allowed to record the HUD.
+        bool hudLayerCached = false;     ///< HUD composited from its offscreen layer.
+        bool hudLayerRebuilt = false;    ///< The offscreen layer was re-rendered this frame.
+        bool hudDirtyCheckHit = false;   ///< Quantized flight data unchanged, layer reused.
+        bool hudSkippedRebuild = false;  ///< Data changed but the rebuild was deferred by the rate cap.
+        uint64_t hudDirtyCheckHits = 0;  ///< Dirty-check hits since start-up.
+        uint64_t hudSkippedRebuilds = 0; ///< Rate-limited rebuilds since start-up.
+
+        // --- Mission menu cost (written by MenuState on frames where the menu is drawn) ---
+        float menuCpuMs = 0.0f;        ///< CPU time spent in MissionMenu::render().
+        uint64_t menuDrawCalls = 0;    ///< Draw calls issued by the menu.
+        uint64_t menuRowsDrawn = 0;    ///< List rows laid out (the visible page only).
+        uint64_t menuRowsTotal = 0;    ///< Missions matching the menu filter.
+    };
+
+} // namespace core
@@ -0,0 +1,439 @@
+/**
+ * @file InputSystem.cpp
+ * @brief Implementation of the input queue, action map and record/replay.
+ */
+
+#include "core/InputSystem.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+
+extern "C"
+{
+#include <GLFW/glfw3.h>
+}
+
+namespace core
+{
+
+    namespace
+    {
+        constexpr char INPUT_MAGIC[8] = {'F', 'S', 'I', 'N', 'P', 'U', 'T', '\0'};
+        constexpr uint32_t MAX_EVENTS_PER_FRAME = 4096; ///< Per kind; sanity limit when reading a replay.
+
+        /// Header of the `.fsinput` file.
+        struct InputFileHeader
+        {
+            char magic[8];    ///< "FSINPUT\0"
+            uint32_t version; ///< InputSystem::VERSION
+            uint32_t reserved;
+        };
+
+        static_assert(sizeof(InputFileHeader) == 16, "InputFileHeader is part of the .fsinput format");
+
+        uint16_t mouseCode(int button)
+        {
+            return static_cast<uint16_t>(InputSystem::MOUSE_BUTTON_CODE + button);
+        }
+    }
+
+    InputSystem::InputSystem()
+    {
+        queue_.reserve(64);
+        frameEvents_.reserve(64);
+        actionEvents_.reserve(64);
+        axisEvents_.reserve(64);
+        loadDefaultBindings();
+    }
+
+    InputSystem::~InputSystem()
+    {
+        stop();
+    }
+
+    void InputSystem::loadDefaultBindings()
+    {
+        // Flight controls
+        bind(InputAction::RollLeft, GLFW_KEY_A);
+        bind(InputAction::RollRight, GLFW_KEY_D);
+        bind(InputAction::PitchUp, GLFW_KEY_W);
+        bind(InputAction::PitchDown, GLFW_KEY_S);
+        bind(InputAction::YawLeft, GLFW_KEY_Q);
+        bind(InputAction::YawRight, GLFW_KEY_E);
+        bind(InputAction::ThrottleUp, GLFW_KEY_UP);
+        bind(InputAction::ThrottleDown, GLFW_KEY_DOWN);
+
+        // Flight commands
+        bind(InputAction::Back, GLFW_KEY_ESCAPE);
+        bind(InputAction::ReturnToMenu, GLFW_KEY_TAB);
+        bind(InputAction::SkipWaypoint, GLFW_KEY_M);
+        bind(InputAction::RestartMission, GLFW_KEY_R);
+        bind(InputAction::ToggleHudBackend, GLFW_KEY_H);
+        bind(InputAction::ToggleHudStress, GLFW_KEY_J);
+        bind(InputAction::SkyBenchmark, GLFW_KEY_K);
+        bind(InputAction::CycleCamera, GLFW_KEY_V);
+        bind(InputAction::ZoomIn, GLFW_KEY_Z);
+        bind(InputAction::ZoomOut, GLFW_KEY_X);
+
+        // Menus, planner and overlays
+        bind(InputAction::Confirm, GLFW_KEY_ENTER);
+        bind(InputAction::Confirm, GLFW_KEY_KP_ENTER);
+        bind(InputAction::MenuSelect, GLFW_KEY_ENTER);
+        bind(InputAction::MenuSelect, GLFW_KEY_SPACE);
+        bind(InputAction::FreeFlight, GLFW_KEY_SPACE);
+        bind(InputAction::MenuUp, GLFW_KEY_UP);
+        bind(InputAction::MenuUp, GLFW_KEY_W);
+        bind(InputAction::MenuDown, GLFW_KEY_DOWN);
+        bind(InputAction::MenuDown, GLFW_KEY_S);
+        bind(InputAction::PageUp, GLFW_KEY_PAGE_UP);
+        bind(InputAction::PageDown, GLFW_KEY_PAGE_DOWN);
+        bind(InputAction::ListHome, GLFW_KEY_HOME);
+        bind(InputAction::ListEnd, GLFW_KEY_END);
+        bind(InputAction::FilterCategory, GLFW_KEY_C);
+        bind(InputAction::FilterDifficulty, GLFW_KEY_D);
+        bind(InputAction::CycleSort, GLFW_KEY_O);
+        bind(InputAction::Benchmark, GLFW_KEY_B);
+        bind(InputAction::PanLeft, GLFW_KEY_A);
+        bind(InputAction::PanLeft, GLFW_KEY_LEFT);
+        bind(InputAction::PanRight, GLFW_KEY_D);
+        bind(InputAction::PanRight, GLFW_KEY_RIGHT);
+        bind(InputAction::PanUp, GLFW_KEY_W);
+        bind(InputAction::PanUp, GLFW_KEY_UP);
+        bind(InputAction::PanDown, GLFW_KEY_S);
+        bind(InputAction::PanDown, GLFW_KEY_DOWN);
+        bind(InputAction::AltitudeUp, GLFW_KEY_R);
+        bind(InputAction::AltitudeDown, GLFW_KEY_F);
+        bind(InputAction::OptimizeRoute, GLFW_KEY_O);
+        bind(InputAction::Shift, GLFW_KEY_LEFT_SHIFT);
+        bind(InputAction::Shift, GLFW_KEY_RIGHT_SHIFT);
+        bind(InputAction::PointerPrimary, mouseCode(GLFW_MOUSE_BUTTON_LEFT));
+        bind(InputAction::PointerSecondary, mouseCode(GLFW_MOUSE_BUTTON_RIGHT));
+
+        // Debug
+        bind(InputAction::ToggleProfiler, GLFW_KEY_F3);
+        bind(InputAction::CaptureTrace, GLFW_KEY_F4);
+    }
+
+    void InputSystem::bind(InputAction action, uint16_t code)
+    {
+        if (code >= CODE_COUNT || action == InputAction::Count)
+        {
+            return;
+        }
+        std::vector<InputAction> &actions = bindings_[code];
+        if (std::find(actions.begin(), actions.end(), action) == actions.end())
+        {
+            actions.push_back(action);
+        }
+    }
+
+    void InputSystem::unbind(InputAction action)
+    {
+        for (std::vector<InputAction> &actions : bindings_)
+        {
+            actions.erase(std::remove(actions.begin(), actions.end(), action), actions.end());
+        }
+        downKeys_[index(action)] = 0;
+    }
+
+    void InputSystem::attach(GLFWwindow *window)
+    {
+        // The cursor callback only fires on movement
+        if (window)
+        {
+            glfwGetCursorPos(window, &cursorX_, &cursorY_);
+        }
+    }
+
+    void InputSystem::onKey(int key, int action, int mods)
+    {
+        if (key >= 0 && key < MOUSE_BUTTON_CODE)
+        {
+            push(static_cast<uint16_t>(key), action, mods);
+        }
+    }
+
+    void InputSystem::onMouseButton(int button, int action, int mods)
+    {
+        if (button >= 0 && button < CODE_COUNT - MOUSE_BUTTON_CODE)
+        {
+            push(mouseCode(button), action, mods);
+        }
+    }
+
+    void InputSystem::onCursor(double x, double y)
+    {
+        if (!isReplaying())
+        {
+            cursorX_ = x;
+            cursorY_ = y;
+        }
+    }
+
+    void InputSystem::push(uint16_t code, int action, int mods)
+    {
+        // Auto-repeat is not a state change; replays own the input while they run
+        if (action == GLFW_REPEAT || isReplaying())
+        {
+            return;
+        }
+        Pending pending;
+        pending.time = glfwGetTime();
+        pending.code = code;
+        pending.down = action == GLFW_PRESS ? 1 : 0;
+        pending.mods = static_cast<uint8_t>(mods);
+        queue_.push_back(pending);
+    }
+
+    void InputSystem::beginFrame(double frameStart, double frameEnd)
+    {
+        frameEvents_.clear();
+        actionEvents_.clear();
+        axisEvents_.clear();
+        axesAtStart_ = axes_;
+        std::memset(pressed_, 0, sizeof(pressed_));
+        std::memset(released_, 0, sizeof(released_));
+        std::memcpy(downAtStart_, downKeys_, sizeof(downKeys_));
+        probePending_ = false;
+
+        const double window = std::max(0.0, frameEnd - frameStart);
+        frameDeltaTime_ = static_cast<float>(window);
+
+        if (joystick_)
+        {
+            drainJoystick(frameStart, frameEnd);
+        }
+
+        if (isReplaying())
+        {
+            queue_.clear();
+            if (!readReplayFrame())
+            {
+                std::cout << "[Input] Replay finished after " << replayFrames_ << " frames; live input resumes"
+                          << std::endl;
+                stop();
+                frameDeltaTime_ = static_cast<float>(window);
+            }
+        }
+        else
+        {
+            for (const Pending &pending : queue_)
+            {
+                InputEvent event;
+                event.offset = static_cast<float>(std::clamp(pending.time - frameStart, 0.0, window));
+                event.code = pending.code;
+                event.down = pending.down;
+                event.mods = pending.mods;
+                frameEvents_.push_back(event);
+
+                if (latencyTest_ && pending.down && !probePending_)
+                {
+                    probePending_ = true;
+                    probeEventTime_ = pending.time;
+                    probeFrameTime_ = frameEnd;
+                }
+            }
+            queue_.clear();
+        }
+
+        for (const InputEvent &event : frameEvents_)
+        {
+            apply(event);
+        }
+        if (!axisEvents_.empty())
+        {
+            axes_ = axisEvents_.back().axes;
+        }
+
+        if (isRecording())
+        {
+            writeFrame();
+        }
+    }
+
+    void InputSystem::drainJoystick(double frameStart, double frameEnd)
+    {
+        const double window = std::max(0.0, frameEnd - frameStart);
+        while (const JoystickSample *sample = joystick_->front())
+        {
+            if (sample->time > frameEnd)
+            {
+                break; // Read after this frame started: it belongs to the next one
+            }
+            // While replaying the stick is drained but ignored, like the keys
+            if (!isReplaying())
+            {
+                AxisEvent event;
+                event.offset = static_cast<float>(std::clamp(sample->time - frameStart, 0.0, window));
+                event.axes = sample->axes;
+                if (axisEvents_.size() < MAX_EVENTS_PER_FRAME)
+                {
+                    axisEvents_.push_back(event);
+                }
+                else
+                {
+                    axisEvents_.back() = event; // After a long stall only the latest position matters
+                }
+            }
+            joystick_->pop();
+        }
+    }
+
+    void InputSystem::apply(const InputEvent &event)
+    {
+        if (event.code >= CODE_COUNT)
+        {
+            return;
+        }
+        const bool down = event.down != 0;
+        if (codeDown_[event.code] == down)
+        {
+            return; // GLFW may repeat a release after a focus change
+        }
+        codeDown_[event.code] = down;
+
+        // An action changes when its first key goes down or its last key comes up
+        for (InputAction action : bindings_[event.code])
+        {
+            const size_t i = index(action);
+            if (down)
+            {
+                if (downKeys_[i]++ == 0)
+                {
+                    pressed_[i] = 1;
+                    actionEvents_.push_back({event.offset, action, true});
+                }
+            }
+            else if (downKeys_[i] > 0 && --downKeys_[i] == 0)
+            {
+                released_[i] = 1;
+                actionEvents_.push_back({event.offset, action, false});
+            }
+        }
+    }
+
+    bool InputSystem::startRecording(const std::string &path)
+    {
+        recording_.close();
+        recording_.open(path, std::ios::binary | std::ios::trunc);
+        InputFileHeader header{};
+        std::memcpy(header.magic, INPUT_MAGIC, sizeof(INPUT_MAGIC));
+        header.version = VERSION;
+        if (!recording_ || !recording_.write(reinterpret_cast<const char *>(&header), sizeof(header)))
+        {
+            std::cerr << "[Input] Cannot write " << path << std::endl;
+            recording_.close();
+            return false;
+        }
+        std::cout << "[Input] Recording to " << path << std::endl;
+        return true;
+    }
+
+    bool InputSystem::startReplay(const std::string &path)
+    {
+        replay_.close();
+        replay_.open(path, std::ios::binary);
+        InputFileHeader header{};
+        if (!replay_ || !replay_.read(reinterpret_cast<char *>(&header), sizeof(header)) ||
+            std::memcmp(header.magic, INPUT_MAGIC, sizeof(INPUT_MAGIC)) != 0 || header.version != VERSION)
+        {
+            std::cerr << "[Input] " << path << " is not a version " << VERSION << " input recording" << std::endl;
+            replay_.close();
+            return false;
+        }
+        replayFrames_ = 0;
+        queue_.clear();
+        std::cout << "[Input] Replaying " << path << " (live keys ignored)" << std::endl;
+        return true;
+    }
+
+    void InputSystem::stop()
+    {
+        if (recording_.is_open())
+        {
+            recording_.close();
+        }
+        if (replay_.is_open())
+        {
+            replay_.close();
+            // Keys the recording left down must not stay stuck for the live devices
+            std::memset(codeDown_, 0, sizeof(codeDown_));
+            std::memset(downKeys_, 0, sizeof(downKeys_));
+            axes_ = JoystickAxes{};
+        }
+    }
+
+    void InputSystem::writeFrame()
+    {
+        FrameRecord record;
+        record.deltaTime = frameDeltaTime_;
+        record.cursorX = static_cast<float>(cursorX_);
+        record.cursorY = static_cast<float>(cursorY_);
+        record.eventCount = static_cast<uint16_t>(std::min<size_t>(frameEvents_.size(), MAX_EVENTS_PER_FRAME));
+        record.axisEventCount = static_cast<uint16_t>(axisEvents_.size());
+        recording_.write(reinterpret_cast<const char *>(&record), sizeof(record));
+        recording_.write(reinterpret_cast<const char *>(frameEvents_.data()),
+                         static_cast<std::streamsize>(record.eventCount * sizeof(InputEvent)));
+        recording_.write(reinterpret_cast<const char *>(axisEvents_.data()),
+                         static_cast<std::streamsize>(record.axisEventCount * sizeof(AxisEvent)));
+        if (!recording_)
+        {
+            std::cerr << "[Input] Recording stopped: write failed" << std::endl;
+            recording_.close();
+        }
+    }
+
+    bool InputSystem::readReplayFrame()
+    {
+        FrameRecord record;
+        if (!replay_.read(reinterpret_cast<char *>(&record), sizeof(record)) ||
+            record.eventCount > MAX_EVENTS_PER_FRAME || record.axisEventCount > MAX_EVENTS_PER_FRAME ||
+            !(record.deltaTime >= 0.0f))
+        {
+            return false;
+        }
+        frameEvents_.resize(record.eventCount);
+        axisEvents_.resize(record.axisEventCount);
+        if ((record.eventCount > 0 &&
+             !replay_.read(reinterpret_cast<char *>(frameEvents_.data()),
+                           static_cast<std::streamsize>(record.eventCount * sizeof(InputEvent)))) ||
+            (record.axisEventCount > 0 &&
+             !replay_.read(reinterpret_cast<char *>(axisEvents_.data()),
+                           static_cast<std::streamsize>(record.axisEventCount * sizeof(AxisEvent)))))
+        {
+            frameEvents_.clear();
+            axisEvents_.clear();
+            return false;
+        }
+        frameDeltaTime_ = record.deltaTime;
+        cursorX_ = record.cursorX;
+        cursorY_ = record.cursorY;
+        replayFrames_++;
+        return true;
+    }
+
+    void InputSystem::probePresented(double time)
+    {
+        if (!probePending_)
+        {
+            return;
+        }
+        probePending_ = false;
+
+        const float ms = static_cast<float>((time - probeEventTime_) * 1000.0);
+        const float queuedMs = static_cast<float>((probeFrameTime_ - probeEventTime_) * 1000.0);
+        latency_.minMs = latency_.probes ? std::min(latency_.minMs, ms) : ms;
+        latency_.maxMs = latency_.probes ? std::max(latency_.maxMs, ms) : ms;
+        latency_.lastMs = ms;
+        latency_.totalMs += ms;
+        latency_.probes++;
+
+        std::cout << std::fixed << std::setprecision(1) << "[Input] Latency probe " << latency_.probes << ": " << ms
+                  << " ms key -> present (" << queuedMs << " ms queued before the frame) | avg "
+                  << latency_.averageMs() << ", min " << latency_.minMs << ", max " << latency_.maxMs << " ms"
+                  << std::defaultfloat << std::endl;
+    }
+
+} // namespace core
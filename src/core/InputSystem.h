@@ -0,0 +1,300 @@
+/**
+ * @file InputSystem.h
+ * @brief Event-driven keyboard/mouse input with action bindings, record/replay and a latency probe.
+ *
+ * GLFW callbacks push timestamped key and button events into a queue.
+ * `beginFrame()` moves the queued events into the current frame and
+ * translates them into actions through the binding table, so states ask
+ * "was SkipWaypoint pressed this frame" instead of polling keys and
+ * keeping their own edge-detection flags. A tap shorter than a frame is
+ * still one press, and a key held across a state change does not fire
+ * again in the next state.
+ *
+ * Each event keeps its offset inside the frame window (previous frame
+ * start → this frame start, `frameDeltaTime()` long). The simulation
+ * advances by the smoothed AppContext::deltaTime instead, so
+ * FlightSimulationController scales the offsets by deltaTime /
+ * frameDeltaTime() and changes the controls between FDM steps at the same
+ * relative point of the frame instead of at frame boundaries. Analog
+ * samples from a JoystickSampler are drained the same way, as AxisEvents.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "core/JoystickInput.h"
+
+struct GLFWwindow;
+
+namespace core
+{
+
+    /**
+     * @brief Everything a state can ask the input system for.
+     *
+     * Several actions may share a key (W pitches in flight, moves the menu
+     * cursor and pans the planner map); each state only asks for its own.
+     */
+    enum class InputAction : uint8_t
+    {
+        // Flight controls (held)
+        RollLeft,
+        RollRight,
+        PitchUp,
+        PitchDown,
+        YawLeft,
+        YawRight,
+        ThrottleUp,
+        ThrottleDown,
+
+        // Flight commands
+        Back, ///< ESC everywhere: quit in flight, leave the menu/planner.
+        ReturnToMenu,
+        SkipWaypoint,
+        RestartMission,
+        ToggleHudBackend,
+        ToggleHudStress,
+        SkyBenchmark,
+        CycleCamera,
+        ZoomIn,
+        ZoomOut,
+
+        // Menus, planner and overlays
+        Confirm,    ///< Start the planned mission, accept the briefing.
+        MenuSelect, ///< Pick the highlighted mission.
+        FreeFlight,
+        MenuUp,
+        MenuDown,
+        PageUp,
+        PageDown,
+        ListHome,
+        ListEnd,
+        FilterCategory,
+        FilterDifficulty,
+        CycleSort,
+        Benchmark,
+        PanLeft,
+        PanRight,
+        PanUp,
+        PanDown,
+        AltitudeUp,
+        AltitudeDown,
+        OptimizeRoute,
+        Shift,
+        PointerPrimary,   ///< Left mouse button.
+        PointerSecondary, ///< Right mouse button.
+
+        // Debug
+        ToggleProfiler,
+        CaptureTrace,
+
+        Count
+    };
+
+    constexpr size_t INPUT_ACTION_COUNT = static_cast<size_t>(InputAction::Count);
+
+    /**
+     * @brief A key or mouse button changing state; the unit of record/replay.
+     */
+    struct InputEvent
+    {
+        float offset;  ///< s since the start of the frame window.
+        uint16_t code; ///< GLFW key code, or InputSystem::MOUSE_BUTTON_CODE + button.
+        uint8_t down;  ///< 1 press, 0 release.
+        uint8_t mods;  ///< GLFW_MOD_* bits.
+    };
+
+    static_assert(sizeof(InputEvent) == 8, "InputEvent is part of the .fsinput format");
+
+    /**
+     * @brief A joystick sample placed inside the frame; recorded like InputEvent.
+     */
+    struct AxisEvent
+    {
+        float offset; ///< s since the start of the frame window.
+        JoystickAxes axes;
+    };
+
+    static_assert(sizeof(AxisEvent) == 20, "AxisEvent is part of the .fsinput format");
+
+    /**
+     * @brief An action going down or up inside the frame (first key down, last key up).
+     */
+    struct ActionEvent
+    {
+        float offset; ///< s since the start of the frame window.
+        InputAction action;
+        bool down;
+    };
+
+    /**
+     * @brief Input-to-present latency measured by the test mode.
+     */
+    struct InputLatencyStats
+    {
+        uint32_t probes = 0;
+        float lastMs = 0.0f;
+        float minMs = 0.0f;
+        float maxMs = 0.0f;
+        double totalMs = 0.0;
+
+        float averageMs() const { return probes ? static_cast<float>(totalMs / probes) : 0.0f; }
+    };
+
+    /**
+     * @brief Input queue and action map owned by Application (main thread only).
+     *
+     * Recording writes every frame's delta time, cursor position and events
+     * to a `.fsinput` file; replaying feeds them back instead of the devices,
+     * with the recorded delta times, so a session (menu, planner and flight)
+     * plays out the same way. Live keys are ignored while replaying.
+     */
+    class InputSystem
+    {
+    public:
+        static constexpr uint16_t MOUSE_BUTTON_CODE = 512; ///< Above GLFW_KEY_LAST.
+        static constexpr uint16_t CODE_COUNT = MOUSE_BUTTON_CODE + 8;
+        static constexpr uint32_t VERSION = 2; ///< 2: frames carry joystick samples.
+
+        InputSystem();
+        ~InputSystem();
+
+        InputSystem(const InputSystem &) = delete;
+        InputSystem &operator=(const InputSystem &) = delete;
+
+        /// Reads the cursor position; the window's callbacks forward to onKey/onMouseButton/onCursor.
+        void attach(GLFWwindow *window);
+
+        // GLFW callbacks (timestamped with glfwGetTime when they run, inside glfwPollEvents)
+        void onKey(int key, int action, int mods);
+        void onMouseButton(int button, int action, int mods);
+        void onCursor(double x, double y);
+
+        /// Drains `sampler`'s ring every frame (nullptr: keyboard and mouse only).
+        void setJoystick(JoystickSampler *sampler) { joystick_ = sampler; }
+
+        /// Adds `code` (GLFW key or MOUSE_BUTTON_CODE + button) to the keys that trigger `action`.
+        void bind(InputAction action, uint16_t code);
+        /// Removes every key bound to `action`.
+        void unbind(InputAction action);
+
+        /**
+         * @brief Starts a frame: takes the queued events (or the next recorded frame).
+         * @param frameStart glfwGetTime() at the start of the previous frame.
+         * @param frameEnd   glfwGetTime() now.
+         */
+        void beginFrame(double frameStart, double frameEnd);
+
+        /// Length of the frame window the event offsets refer to, in s (the recorded value while replaying).
+        float frameDeltaTime() const { return frameDeltaTime_; }
+
+        /// The action went down at least once this frame (taps shorter than a frame included).
+        bool pressed(InputAction action) const { return pressed_[index(action)] > 0; }
+        /// The action went up at least once this frame.
+        bool released(InputAction action) const { return released_[index(action)] > 0; }
+        /// Held at the end of the frame window.
+        bool down(InputAction action) const { return downKeys_[index(action)] > 0; }
+        /// Held at the start of the frame window.
+        bool downAtStart(InputAction action) const { return downAtStart_[index(action)] > 0; }
+
+        /// This frame's action changes, in time order.
+        const std::vector<ActionEvent> &actionEvents() const { return actionEvents_; }
+        /// This frame's raw events, in time order.
+        const std::vector<InputEvent> &events() const { return frameEvents_; }
+
+        /// This frame's joystick samples, in time order (empty while the stick is still).
+        const std::vector<AxisEvent> &axisEvents() const { return axisEvents_; }
+        /// Stick and lever at the end of the frame window.
+        const JoystickAxes &axes() const { return axes_; }
+        /// Stick and lever at the start of the frame window.
+        const JoystickAxes &axesAtStart() const { return axesAtStart_; }
+
+        double cursorX() const { return cursorX_; }
+        double cursorY() const { return cursorY_; }
+
+        // Record / replay
+        bool startRecording(const std::string &path);
+        bool startReplay(const std::string &path);
+        /// Closes the recording (or abandons the replay).
+        void stop();
+        bool isRecording() const { return recording_.is_open(); }
+        bool isReplaying() const { return replay_.is_open(); }
+
+        // Latency test mode
+        void setLatencyTest(bool enabled) { latencyTest_ = enabled; }
+        bool latencyTest() const { return latencyTest_; }
+        /// A key went down this frame in test mode: the frame should flash and be timed.
+        bool latencyProbe() const { return probePending_; }
+        /**
+         * @brief The probe frame has been presented (after swap + glFinish).
+         * @param time glfwGetTime() once the GPU is done with the frame.
+         */
+        void probePresented(double time);
+        const InputLatencyStats &latencyStats() const { return latency_; }
+
+    private:
+        /// An event waiting for beginFrame(), with its absolute timestamp.
+        struct Pending
+        {
+            double time;
+            uint16_t code;
+            uint8_t down;
+            uint8_t mods;
+        };
+
+        /// Per-frame header in the `.fsinput` file, followed by the InputEvents and then the AxisEvents.
+        struct FrameRecord
+        {
+            float deltaTime;
+            float cursorX;
+            float cursorY;
+            uint16_t eventCount;
+            uint16_t axisEventCount;
+        };
+
+        static_assert(sizeof(FrameRecord) == 16, "FrameRecord is part of the .fsinput format");
+
+        static size_t index(InputAction action) { return static_cast<size_t>(action); }
+
+        void push(uint16_t code, int action, int mods);
+        void drainJoystick(double frameStart, double frameEnd);
+        void loadDefaultBindings();
+        bool readReplayFrame();
+        void apply(const InputEvent &event);
+        void writeFrame();
+
+        std::vector<InputAction> bindings_[CODE_COUNT]; ///< Actions triggered by each code.
+        bool codeDown_[CODE_COUNT] = {};
+
+        uint8_t downKeys_[INPUT_ACTION_COUNT] = {};    ///< Bound codes currently down.
+        uint8_t downAtStart_[INPUT_ACTION_COUNT] = {}; ///< downKeys_ when the frame began.
+        uint8_t pressed_[INPUT_ACTION_COUNT] = {};
+        uint8_t released_[INPUT_ACTION_COUNT] = {};
+
+        std::vector<Pending> queue_; ///< Filled by the callbacks between frames.
+        std::vector<InputEvent> frameEvents_;
+        std::vector<ActionEvent> actionEvents_;
+        std::vector<AxisEvent> axisEvents_;
+        JoystickAxes axes_{};
+        JoystickAxes axesAtStart_{};
+        JoystickSampler *joystick_ = nullptr;
+        float frameDeltaTime_ = 0.0f;
+        double cursorX_ = 0.0;
+        double cursorY_ = 0.0;
+
+        std::ofstream recording_;
+        std::ifstream replay_;
+        uint64_t replayFrames_ = 0;
+
+        bool latencyTest_ = false;
+        bool probePending_ = false;
+        double probeEventTime_ = 0.0; ///< Callback time of the key that triggered the probe.
+        double probeFrameTime_ = 0.0; ///< Start of the frame that consumed it.
+        InputLatencyStats latency_;
+    };
+
+} // namespace core
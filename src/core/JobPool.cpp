@@ -0,0 +1,541 @@
+#include "core/JobPool.h"
+
+#include <algorithm>
+
+namespace core
+{
+
+    /**
+     * @brief Bookkeeping of one submitted task.
+     *
+     * Reference counted: one reference for the scheduler (dropped once the task
+     * ran) and one per TaskHandle. `pending` starts at 1 so the task cannot be
+     * scheduled while its dependencies are still being registered.
+     */
+    struct TaskState
+    {
+        std::function<void()> fn;
+        TaskAffinity affinity = TaskAffinity::Any;
+        std::atomic<int> refs{2};
+        std::atomic<int> pending{1};
+        std::atomic<bool> done{false};
+        std::mutex mutex;                       ///< Guards `continuations` against `done` flipping.
+        std::vector<TaskState *> continuations; ///< Tasks waiting on this one.
+        std::exception_ptr error;               ///< Written before `done`, read after it.
+    };
+
+    namespace
+    {
+        void releaseTask(TaskState *task)
+        {
+            if (task->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                delete task;
+            }
+        }
+    }
+
+    TaskHandle::TaskHandle(const TaskHandle &other) : task_(other.task_)
+    {
+        if (task_)
+        {
+            task_->refs.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    TaskHandle::TaskHandle(TaskHandle &&other) noexcept : task_(other.task_)
+    {
+        other.task_ = nullptr;
+    }
+
+    TaskHandle &TaskHandle::operator=(TaskHandle other) noexcept
+    {
+        std::swap(task_, other.task_);
+        return *this;
+    }
+
+    TaskHandle::~TaskHandle()
+    {
+        if (task_)
+        {
+            releaseTask(task_);
+        }
+    }
+
+    bool TaskHandle::done() const
+    {
+        return !task_ || task_->done.load(std::memory_order_acquire);
+    }
+
+    thread_local bool JobPool::insideJob_ = false;
+    thread_local JobPool *JobPool::workerPool_ = nullptr;
+    thread_local unsigned JobPool::workerIndex_ = JobPool::NO_WORKER;
+
+    unsigned JobPool::defaultWorkerCount()
+    {
+        unsigned hardware = std::thread::hardware_concurrency();
+        return hardware > 1 ? hardware - 1 : 0;
+    }
+
+    JobPool::JobPool(unsigned workerCount) : mainThread_(std::this_thread::get_id())
+    {
+        queues_.reserve(workerCount);
+        for (unsigned i = 0; i < workerCount; ++i)
+        {
+            queues_.push_back(std::make_unique<WorkerQueue>());
+        }
+
+        workers_.reserve(workerCount);
+        for (unsigned i = 0; i < workerCount; ++i)
+        {
+            workers_.emplace_back(&JobPool::workerLoop, this, i);
+        }
+    }
+
+    JobPool::~JobPool()
+    {
+        waitIdle();
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        wake_.notify_all();
+        for (std::thread &worker : workers_)
+        {
+            worker.join();
+        }
+    }
+
+    void JobPool::run(std::size_t count, void *context, ItemFn call, unsigned maxThreads)
+    {
+        if (count == 0)
+        {
+            return;
+        }
+
+        // Nothing to share the work with (or already on a worker): run inline.
+        if (workers_.empty() || count == 1 || maxThreads == 1 || insideJob_)
+        {
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                call(context, i);
+            }
+            return;
+        }
+
+        std::lock_guard<std::mutex> submit(submitMutex_);
+
+        unsigned helpers = workerCount();
+        if (maxThreads > 1)
+        {
+            helpers = std::min(helpers, maxThreads - 1);
+        }
+        helpers = static_cast<unsigned>(std::min<std::size_t>(helpers, count - 1));
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            context_ = context;
+            call_ = call;
+            count_ = count;
+            completed_ = 0;
+            error_ = nullptr;
+            nextItem_.store(0, std::memory_order_relaxed);
+            seats_ = helpers;
+            generation_++;
+        }
+        wake_.notify_all();
+
+        std::size_t ranHere = drainItems();
+
+        std::exception_ptr error;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            completed_ += ranHere;
+            finished_.wait(lock, [this]
+                           { return completed_ == count_ && active_ == 0; });
+
+            // Late workers must not join a job whose callable is going out of scope.
+            seats_ = 0;
+            context_ = nullptr;
+            call_ = nullptr;
+            error = error_;
+        }
+
+        if (error)
+        {
+            std::rethrow_exception(error);
+        }
+    }
+
+    std::size_t JobPool::drainItems()
+    {
+        insideJob_ = true;
+        std::size_t ran = 0;
+        for (;;)
+        {
+            std::size_t index = nextItem_.fetch_add(1, std::memory_order_relaxed);
+            if (index >= count_)
+            {
+                break;
+            }
+
+            try
+            {
+                call_(context_, index);
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (!error_)
+                {
+                    error_ = std::current_exception();
+                }
+            }
+            ran++;
+        }
+        insideJob_ = false;
+        return ran;
+    }
+
+    void JobPool::workerLoop(unsigned index)
+    {
+        workerPool_ = this;
+        workerIndex_ = index;
+
+        uint64_t seen = 0;
+        for (;;)
+        {
+            if (TaskState *task = findTask(index))
+            {
+                execute(task);
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(mutex_);
+            if (generation_ != seen && seats_ > 0)
+            {
+                seen = generation_;
+                seats_--;
+                active_++;
+
+                lock.unlock();
+                std::size_t ran = drainItems();
+                lock.lock();
+
+                active_--;
+                completed_ += ran;
+                if (completed_ == count_ && active_ == 0)
+                {
+                    finished_.notify_one();
+                }
+                continue;
+            }
+            if (stopping_)
+            {
+                return;
+            }
+
+            // Counted before the predicate reads queued_: see wakeOne.
+            sleepers_.fetch_add(1);
+            wake_.wait(lock, [&]
+                       { return stopping_ || (generation_ != seen && seats_ > 0) || queued_.load() > 0; });
+            sleepers_.fetch_sub(1);
+        }
+    }
+
+    TaskHandle JobPool::submit(std::function<void()> fn, std::initializer_list<TaskHandle> after,
+                               TaskAffinity affinity)
+    {
+        return submitTask(std::move(fn), after.begin(), after.size(), affinity);
+    }
+
+    TaskHandle JobPool::submit(std::function<void()> fn, const std::vector<TaskHandle> &after,
+                               TaskAffinity affinity)
+    {
+        return submitTask(std::move(fn), after.data(), after.size(), affinity);
+    }
+
+    TaskHandle JobPool::submitTask(std::function<void()> &&fn, const TaskHandle *after, std::size_t afterCount,
+                                   TaskAffinity affinity)
+    {
+        TaskState *task = new TaskState;
+        task->fn = std::move(fn);
+        task->affinity = affinity;
+        submitted_.fetch_add(1, std::memory_order_relaxed);
+        pending_.fetch_add(1);
+
+        for (std::size_t i = 0; i < afterCount; ++i)
+        {
+            TaskState *before = after[i].task_;
+            if (!before)
+            {
+                continue;
+            }
+            std::lock_guard<std::mutex> lock(before->mutex);
+            if (!before->done.load(std::memory_order_relaxed))
+            {
+                task->pending.fetch_add(1, std::memory_order_relaxed);
+                before->continuations.push_back(task);
+            }
+        }
+
+        // Drop the registration guard; schedule now unless a dependency is still running.
+        if (task->pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            schedule(task);
+        }
+        return TaskHandle(task);
+    }
+
+    void JobPool::schedule(TaskState *task)
+    {
+        if (task->affinity == TaskAffinity::MainThread)
+        {
+            std::lock_guard<std::mutex> lock(mainMutex_);
+            mainQueue_.push_back(task);
+            return;
+        }
+
+        // Counted before it is visible, so a pop never takes queued_ below zero.
+        queued_.fetch_add(1);
+        unsigned self = currentWorker();
+        if (self != NO_WORKER)
+        {
+            std::lock_guard<std::mutex> lock(queues_[self]->mutex);
+            queues_[self]->tasks.push_back(task);
+        }
+        else
+        {
+            std::lock_guard<std::mutex> lock(injectMutex_);
+            injected_.push_back(task);
+        }
+        wakeOne();
+    }
+
+    void JobPool::wakeOne()
+    {
+        // A worker raises sleepers_ under mutex_ before its predicate reads
+        // queued_; both are sequentially consistent, so either it sees the new
+        // task or we see it and take mutex_ to order the notify after its wait.
+        if (sleepers_.load() == 0)
+        {
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+        }
+        wake_.notify_one();
+    }
+
+    TaskState *JobPool::findTask(unsigned self)
+    {
+        if (queued_.load(std::memory_order_acquire) == 0)
+        {
+            return nullptr;
+        }
+
+        TaskState *task = nullptr;
+        if (self != NO_WORKER)
+        {
+            WorkerQueue &own = *queues_[self];
+            std::lock_guard<std::mutex> lock(own.mutex);
+            if (!own.tasks.empty())
+            {
+                task = own.tasks.back();
+                own.tasks.pop_back();
+            }
+        }
+
+        if (!task)
+        {
+            std::lock_guard<std::mutex> lock(injectMutex_);
+            if (!injected_.empty())
+            {
+                task = injected_.front();
+                injected_.pop_front();
+            }
+        }
+
+        if (!task)
+        {
+            // Start past our own deque so thieves spread over the victims.
+            const std::size_t count = queues_.size();
+            const std::size_t start = self != NO_WORKER ? self + 1 : 0;
+            for (std::size_t i = 0; i < count && !task; ++i)
+            {
+                const std::size_t victim = (start + i) % count;
+                if (victim == self)
+                {
+                    continue;
+                }
+                stealAttempts_.fetch_add(1, std::memory_order_relaxed);
+                WorkerQueue &queue = *queues_[victim];
+                std::lock_guard<std::mutex> lock(queue.mutex);
+                if (!queue.tasks.empty())
+                {
+                    task = queue.tasks.front();
+                    queue.tasks.pop_front();
+                    steals_.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        }
+
+        if (task)
+        {
+            queued_.fetch_sub(1);
+        }
+        return task;
+    }
+
+    TaskState *JobPool::popMainThreadTask()
+    {
+        std::lock_guard<std::mutex> lock(mainMutex_);
+        if (mainQueue_.empty())
+        {
+            return nullptr;
+        }
+        TaskState *task = mainQueue_.front();
+        mainQueue_.pop_front();
+        return task;
+    }
+
+    void JobPool::execute(TaskState *task)
+    {
+        try
+        {
+            task->fn();
+        }
+        catch (...)
+        {
+            task->error = std::current_exception();
+        }
+        task->fn = nullptr; // Release captures now, not when the last handle goes away.
+
+        executed_.fetch_add(1, std::memory_order_relaxed);
+        if (task->affinity == TaskAffinity::MainThread)
+        {
+            mainThreadExecuted_.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        std::vector<TaskState *> continuations;
+        {
+            std::lock_guard<std::mutex> lock(task->mutex);
+            task->done.store(true, std::memory_order_release);
+            continuations.swap(task->continuations);
+        }
+        for (TaskState *next : continuations)
+        {
+            if (next->pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                schedule(next);
+            }
+        }
+
+        // After the continuations are queued, so waitIdle cannot see zero early.
+        pending_.fetch_sub(1);
+        releaseTask(task);
+    }
+
+    void JobPool::helpOrYield()
+    {
+        if (isMainThread())
+        {
+            if (TaskState *task = popMainThreadTask())
+            {
+                execute(task);
+                return;
+            }
+        }
+        if (TaskState *task = findTask(currentWorker()))
+        {
+            execute(task);
+            return;
+        }
+        std::this_thread::yield();
+    }
+
+    void JobPool::wait(const TaskHandle &task)
+    {
+        if (!task.valid())
+        {
+            return;
+        }
+        while (!task.done())
+        {
+            helpOrYield();
+        }
+        if (task.task_->error)
+        {
+            std::rethrow_exception(task.task_->error);
+        }
+    }
+
+    void JobPool::waitIdle()
+    {
+        while (pending_.load() > 0)
+        {
+            helpOrYield();
+        }
+    }
+
+    std::size_t JobPool::runMainThreadTasks()
+    {
+        if (!isMainThread())
+        {
+            return 0;
+        }
+
+        // Only what is ready now: tasks queued by these tasks wait for the next call.
+        std::size_t budget;
+        {
+            std::lock_guard<std::mutex> lock(mainMutex_);
+            budget = mainQueue_.size();
+        }
+        if (workers_.empty())
+        {
+            budget += queued_.load();
+        }
+
+        std::size_t ran = 0;
+        for (; ran < budget; ++ran)
+        {
+            TaskState *task = popMainThreadTask();
+            if (!task && workers_.empty())
+            {
+                task = findTask(NO_WORKER);
+            }
+            if (!task)
+            {
+                break;
+            }
+            execute(task);
+        }
+        return ran;
+    }
+
+    unsigned JobPool::currentWorker() const
+    {
+        return workerPool_ == this ? workerIndex_ : NO_WORKER;
+    }
+
+    SchedulerStats JobPool::stats() const
+    {
+        SchedulerStats stats;
+        stats.submitted = submitted_.load(std::memory_order_relaxed);
+        stats.executed = executed_.load(std::memory_order_relaxed);
+        stats.mainThreadExecuted = mainThreadExecuted_.load(std::memory_order_relaxed);
+        stats.stealAttempts = stealAttempts_.load(std::memory_order_relaxed);
+        stats.steals = steals_.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+    void JobPool::resetStats()
+    {
+        submitted_.store(0, std::memory_order_relaxed);
+        executed_.store(0, std::memory_order_relaxed);
+        mainThreadExecuted_.store(0, std::memory_order_relaxed);
+        stealAttempts_.store(0, std::memory_order_relaxed);
+        steals_.store(0, std::memory_order_relaxed);
+    }
+
+} // namespace core
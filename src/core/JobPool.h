@@ -0,0 +1,244 @@
+/**
+ * @file JobPool.h
+ * @brief Worker threads for data-parallel loops and task graphs.
+ *
+ * Work that splits into independent items (e.g. one HUD instrument each) is
+ * handed to `parallelFor`, which spreads the indices over the workers and the
+ * calling thread and returns once every item ran.
+ * Work with an order (decode, then upload) is submitted as tasks: each task
+ * may list tasks it runs after, and tasks marked `TaskAffinity::MainThread`
+ * only run on the thread that owns the GL context.
+ * Owned by `core::Application`; systems reach it through `AppContext::jobPool`.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace core
+{
+
+    struct TaskState;
+
+    /// Where a task may run.
+    enum class TaskAffinity
+    {
+        Any,       ///< Any worker, or a thread helping in `wait`.
+        MainThread ///< Only the pool's main thread (GL calls): `runMainThreadTasks` or `wait` there.
+    };
+
+    /**
+     * @brief Shared reference to a submitted task; empty by default.
+     *
+     * Handles keep the task's bookkeeping alive, not the task's work: a task
+     * runs whether or not anyone still holds its handle.
+     */
+    class TaskHandle
+    {
+    public:
+        TaskHandle() = default;
+        TaskHandle(const TaskHandle &other);
+        TaskHandle(TaskHandle &&other) noexcept;
+        TaskHandle &operator=(TaskHandle other) noexcept;
+        ~TaskHandle();
+
+        bool valid() const { return task_ != nullptr; }
+        /// true once the task ran (or threw) and for empty handles; continuations are released by then.
+        bool done() const;
+
+    private:
+        friend class JobPool;
+        explicit TaskHandle(TaskState *task) : task_(task) {} ///< Adopts one reference.
+
+        TaskState *task_ = nullptr;
+    };
+
+    /**
+     * @brief Scheduler counters since construction or `resetStats`.
+     */
+    struct SchedulerStats
+    {
+        uint64_t submitted = 0;
+        uint64_t executed = 0;
+        uint64_t mainThreadExecuted = 0; ///< Part of `executed` run with MainThread affinity.
+        uint64_t stealAttempts = 0;      ///< Probes of another worker's deque.
+        uint64_t steals = 0;             ///< Probes that took a task.
+    };
+
+    /**
+     * @brief Work-stealing pool with a blocking fork/join front end.
+     *
+     * `parallelFor`: items are claimed from a shared atomic counter, so uneven
+     * items balance themselves. Submitting never allocates: the callable is
+     * referenced, not copied. Concurrent `parallelFor` calls from different
+     * threads are serialized; calling it from inside an item runs the nested
+     * loop inline.
+     *
+     * Tasks: every worker owns a deque. A worker pushes the tasks it spawns to
+     * the back and pops from the back (newest first, still warm in cache);
+     * idle workers steal from the front of the others' deques. Tasks submitted
+     * from other threads go through a shared injection queue. Each deque has
+     * its own mutex: contention only happens on a steal.
+     */
+    class JobPool
+    {
+    public:
+        /// One worker per hardware thread, minus the caller that also takes items.
+        static unsigned defaultWorkerCount();
+
+        /// The constructing thread becomes the pool's main thread.
+        explicit JobPool(unsigned workerCount = defaultWorkerCount());
+        /// Finishes every submitted task (running main-thread ones here) before joining.
+        ~JobPool();
+
+        JobPool(const JobPool &) = delete;
+        JobPool &operator=(const JobPool &) = delete;
+
+        /// Background threads (the caller of parallelFor is an extra participant).
+        unsigned workerCount() const { return static_cast<unsigned>(workers_.size()); }
+
+        /**
+         * @brief Calls `fn(i)` for every i in [0, count) and waits for all of them.
+         * @param maxThreads Upper bound on participating threads including the
+         *                   caller (0 = all). 1 runs the loop inline.
+         *
+         * The first exception thrown by an item is rethrown here after the
+         * remaining items finished.
+         */
+        template <typename Fn>
+        void parallelFor(std::size_t count, Fn &&fn, unsigned maxThreads = 0)
+        {
+            using Callable = std::remove_reference_t<Fn>;
+            run(count, const_cast<void *>(static_cast<const void *>(&fn)),
+                [](void *context, std::size_t index)
+                { (*static_cast<Callable *>(context))(index); },
+                maxThreads);
+        }
+
+        /**
+         * @brief Schedules `fn` to run once every task in `after` is done.
+         *
+         * Empty handles in `after` are ignored. An exception thrown by `fn` is
+         * kept in the task and rethrown by `wait`; its continuations still run.
+         */
+        TaskHandle submit(std::function<void()> fn, std::initializer_list<TaskHandle> after = {},
+                          TaskAffinity affinity = TaskAffinity::Any);
+        TaskHandle submit(std::function<void()> fn, const std::vector<TaskHandle> &after,
+                          TaskAffinity affinity = TaskAffinity::Any);
+
+        /// Continuation: `fn` runs after `before`.
+        TaskHandle then(const TaskHandle &before, std::function<void()> fn, TaskAffinity affinity = TaskAffinity::Any)
+        {
+            return submit(std::move(fn), {before}, affinity);
+        }
+
+        /**
+         * @brief Blocks until `task` is done, running other tasks meanwhile.
+         *
+         * On the main thread it also runs main-thread tasks, so waiting on a
+         * GL upload that depends on a worker's decode cannot deadlock. Rethrows
+         * the task's exception.
+         */
+        void wait(const TaskHandle &task);
+
+        /// Blocks until every submitted task is done (same helping rules as `wait`).
+        void waitIdle();
+
+        /**
+         * @brief Runs the main-thread tasks that are ready (call once per frame).
+         * @return How many ran.
+         *
+         * Without workers it also runs the ready `Any` tasks, so a single-core
+         * machine still makes progress between frames.
+         */
+        std::size_t runMainThreadTasks();
+
+        bool isMainThread() const { return std::this_thread::get_id() == mainThread_; }
+
+        SchedulerStats stats() const;
+        void resetStats();
+
+    private:
+        using ItemFn = void (*)(void *context, std::size_t index);
+
+        /// A worker's deque; the owner uses the back, thieves the front.
+        struct WorkerQueue
+        {
+            std::mutex mutex;
+            std::deque<TaskState *> tasks;
+        };
+
+        static constexpr unsigned NO_WORKER = ~0u;
+
+        void run(std::size_t count, void *context, ItemFn call, unsigned maxThreads);
+        void workerLoop(unsigned index);
+        /// Claims and runs items until none are left; returns how many it ran.
+        std::size_t drainItems();
+
+        TaskHandle submitTask(std::function<void()> &&fn, const TaskHandle *after, std::size_t afterCount,
+                              TaskAffinity affinity);
+        /// Queues a task whose dependencies are all done.
+        void schedule(TaskState *task);
+        /// Own deque, then the injection queue, then a steal; nullptr if all are empty.
+        TaskState *findTask(unsigned self);
+        TaskState *popMainThreadTask();
+        void execute(TaskState *task);
+        /// One step of waiting: runs a task if there is one, otherwise yields.
+        void helpOrYield();
+        void wakeOne();
+        unsigned currentWorker() const;
+
+        std::vector<std::thread> workers_;
+        std::thread::id mainThread_;
+        std::mutex submitMutex_; ///< One parallelFor at a time.
+
+        std::mutex mutex_;
+        std::condition_variable wake_;     ///< Signals workers that a job was published or a task queued.
+        std::condition_variable finished_; ///< Signals the caller that the last item completed.
+        uint64_t generation_ = 0;          ///< Bumped for every published job.
+        unsigned seats_ = 0;               ///< Workers still allowed to join the current job.
+        unsigned active_ = 0;              ///< Workers currently inside the job.
+        std::size_t completed_ = 0;        ///< Items finished for the current job.
+        std::exception_ptr error_;
+        bool stopping_ = false;
+
+        // Current job; written under mutex_ before generation_ is bumped.
+        void *context_ = nullptr;
+        ItemFn call_ = nullptr;
+        std::size_t count_ = 0;
+        std::atomic<std::size_t> nextItem_{0};
+
+        // Tasks
+        std::vector<std::unique_ptr<WorkerQueue>> queues_;
+        std::mutex injectMutex_;
+        std::deque<TaskState *> injected_; ///< Submitted from threads that are not workers.
+        std::mutex mainMutex_;
+        std::deque<TaskState *> mainQueue_;   ///< Ready MainThread tasks.
+        std::atomic<std::size_t> queued_{0};  ///< Ready Any tasks in the deques and the injection queue.
+        std::atomic<std::size_t> pending_{0}; ///< Submitted tasks not done yet.
+        std::atomic<unsigned> sleepers_{0};   ///< Workers waiting on wake_ (changed under mutex_).
+
+        std::atomic<uint64_t> submitted_{0};
+        std::atomic<uint64_t> executed_{0};
+        std::atomic<uint64_t> mainThreadExecuted_{0};
+        std::atomic<uint64_t> stealAttempts_{0};
+        std::atomic<uint64_t> steals_{0};
+
+        static thread_local bool insideJob_;       ///< true while this thread runs an item.
+        static thread_local JobPool *workerPool_;  ///< Pool this thread works for (null off-pool).
+        static thread_local unsigned workerIndex_; ///< Index in queues_ when workerPool_ is set.
+    };
+
+} // namespace core
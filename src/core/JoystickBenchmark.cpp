@@ -0,0 +1,298 @@
+#include "core/JoystickBenchmark.h"
+#include "core/InputSystem.h"
+#include "core/JoystickInput.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace core
+{
+    namespace
+    {
+        using Clock = std::chrono::steady_clock;
+
+        const Clock::time_point benchEpoch = Clock::now();
+
+        /// Sampler and frame clock of the harness (glfwGetTime needs a GLFW context).
+        double benchClock()
+        {
+            return std::chrono::duration<double>(Clock::now() - benchEpoch).count();
+        }
+
+        class Checks
+        {
+        public:
+            void expect(bool ok, const std::string &what)
+            {
+                if (!ok)
+                {
+                    std::cout << "  ✗ " << what << std::endl;
+                    failed_++;
+                }
+            }
+            int failed() const { return failed_; }
+
+        private:
+            int failed_ = 0;
+        };
+
+        bool near(float a, float b, float tolerance = 1e-4f)
+        {
+            return std::fabs(a - b) <= tolerance;
+        }
+
+        void checkShaping(Checks &checks)
+        {
+            AxisCurve stick{0, false, 0.1f, 0.0f};
+            checks.expect(stick.shape(0.05f) == 0.0f && stick.shape(-0.1f) == 0.0f, "deadzone does not read 0");
+            checks.expect(stick.shape(0.1001f) < 1e-3f, "response jumps at the deadzone edge");
+            checks.expect(near(stick.shape(0.55f), 0.5f) && near(stick.shape(-0.55f), -0.5f), "deadzone not rescaled");
+            checks.expect(stick.shape(1.0f) == 1.0f && stick.shape(-2.0f) == -1.0f, "full deflection not ±1");
+
+            stick.invert = true;
+            checks.expect(near(stick.shape(-0.55f), 0.5f), "inverted axis");
+
+            AxisCurve cubic{0, false, 0.0f, 1.0f};
+            checks.expect(near(cubic.shape(0.5f), 0.125f) && cubic.shape(1.0f) == 1.0f, "expo 1 is not cubic");
+            bool monotonic = true;
+            float previous = -1.0f;
+            for (int i = 0; i <= 200; ++i)
+            {
+                const float value = AxisCurve{0, false, 0.05f, 0.4f}.shape(-1.0f + i * 0.01f);
+                monotonic = monotonic && value >= previous;
+                previous = value;
+            }
+            checks.expect(monotonic, "shaped response is not monotonic");
+
+            AxisCurve lever{3, true, 0.02f, 0.0f};
+            checks.expect(lever.shapeLever(-1.0f) == 1.0f && lever.shapeLever(1.0f) == 0.0f, "lever ends");
+            checks.expect(near(lever.shapeLever(0.0f), 0.5f) && lever.shapeLever(-0.97f) == 1.0f, "lever travel");
+
+            JoystickConfig config;
+            config.throttle.axis = -1;
+            config.yaw.axis = 9;
+            const float raw[4] = {0.5f, -0.5f, 1.0f, 1.0f};
+            const JoystickAxes axes = config.shape(raw, 4);
+            checks.expect(axes.throttle < 0.0f, "unbound throttle should read negative");
+            checks.expect(axes.yaw == 0.0f, "axis missing on the device should read 0");
+        }
+
+        void checkScript(Checks &checks)
+        {
+            const std::filesystem::path path = std::filesystem::temp_directory_path() / "fsim_joystick_bench.txt";
+            {
+                std::ofstream script(path);
+                script << "# t  x  y\n0.0 -1 0\n\n1.0 1 0.5  # end\n";
+            }
+            std::unique_ptr<VirtualJoystickDevice> device = VirtualJoystickDevice::fromFile(path.string(), false);
+            float axes[JoystickDevice::MAX_AXES] = {};
+            bool ok = device && device->open() && device->read(100.0, axes) && axes[0] == -1.0f;
+            ok = ok && device->read(100.5, axes) && near(axes[0], 0.0f) && near(axes[1], 0.25f);
+            ok = ok && device->read(105.0, axes) && axes[0] == 1.0f && axes[1] == 0.5f;
+            checks.expect(ok, "script keyframes not interpolated/held as written");
+
+            {
+                std::ofstream script(path);
+                script << "0.0 0\nnot a keyframe\n";
+            }
+            std::cout << "  (a parse error for the malformed script is expected below)" << std::endl;
+            checks.expect(VirtualJoystickDevice::fromFile(path.string()) == nullptr, "malformed script accepted");
+            std::error_code error;
+            std::filesystem::remove(path, error);
+        }
+
+        /// What the emulated main loop saw in one frame.
+        struct FrameLog
+        {
+            double start;
+            float deltaTime;
+            std::vector<AxisEvent> events;
+        };
+    } // namespace
+
+    int runJoystickBenchmark(const JoystickBenchmarkOptions &options)
+    {
+        std::cout << std::fixed << std::setprecision(2);
+        Checks checks;
+        std::cout << "Joystick harness: virtual device at " << options.rateHz << " Hz, " << options.frameHz
+                  << " Hz frames, " << options.seconds << " s sweep" << std::endl;
+
+        checkShaping(checks);
+        checkScript(checks);
+
+        // Script: roll sweeps -1 → 1 over the whole run, pitch steps 0 → 1 half-way.
+        const double length = std::max(0.2f, options.seconds);
+        const double stepAt = length * 0.5;
+        auto keyframe = [](double time, float roll, float pitch)
+        {
+            VirtualJoystickDevice::Keyframe key{};
+            key.time = time;
+            key.axes[0] = roll;
+            key.axes[1] = pitch;
+            return key;
+        };
+        auto rollAt = [&](double t)
+        { return static_cast<float>(std::clamp(-1.0 + 2.0 * t / length, -1.0, 1.0)); };
+        const double stepEnd = stepAt + 1e-4;
+        std::vector<VirtualJoystickDevice::Keyframe> script = {
+            keyframe(0.0, -1.0f, 0.0f), keyframe(stepAt, rollAt(stepAt), 0.0f),
+            keyframe(stepEnd, rollAt(stepEnd), 1.0f), keyframe(length, 1.0f, 1.0f)};
+
+        // Identity mapping, so the samples can be compared with the script
+        JoystickConfig config;
+        config.rateHz = options.rateHz;
+        config.roll = AxisCurve{0, false, 0.0f, 0.0f};
+        config.pitch = AxisCurve{1, false, 0.0f, 0.0f};
+        config.yaw.axis = -1;
+        config.throttle.axis = -1;
+
+        const std::filesystem::path recording = std::filesystem::temp_directory_path() / "fsim_joystick_bench.fsinput";
+        InputSystem input;
+        JoystickSampler sampler;
+        input.setJoystick(&sampler);
+        input.startRecording(recording.string());
+
+        // Emulated main loop: one beginFrame per frame, one long frame a quarter of the way in
+        const auto framePeriod = std::chrono::duration<double>(1.0 / std::max(1.0f, options.frameHz));
+        std::vector<FrameLog> frames;
+        double frameStart = benchClock();
+        Clock::time_point nextFrame = Clock::now();
+        sampler.start(std::make_unique<VirtualJoystickDevice>(script, false), config, benchClock);
+        const Clock::time_point started = Clock::now();
+        double sampledSeconds = 0.0;
+        bool stalled = false;
+        while (sampler.isRunning())
+        {
+            nextFrame += std::chrono::duration_cast<Clock::duration>(framePeriod);
+            const double elapsed = std::chrono::duration<double>(Clock::now() - started).count();
+            if (!stalled && elapsed > length * 0.25)
+            {
+                stalled = true;
+                nextFrame += std::chrono::duration_cast<Clock::duration>(
+                    std::chrono::duration<double, std::milli>(options.stallMs));
+            }
+            if (elapsed > length + 0.1)
+            {
+                sampler.stop(); // The last frame still drains what is left
+                sampledSeconds = std::chrono::duration<double>(Clock::now() - started).count();
+            }
+            std::this_thread::sleep_until(nextFrame);
+
+            const double frameEnd = benchClock();
+            input.beginFrame(frameStart, frameEnd);
+            frames.push_back({frameStart, input.frameDeltaTime(), input.axisEvents()});
+            frameStart = frameEnd;
+        }
+        input.stop();
+        const JoystickSamplerStats stats = sampler.stats();
+
+        // Order, placement and values of every sample
+        bool ordered = true;
+        bool placed = true;
+        double maxGap = 0.0;
+        double previousTime = -1.0;
+        double firstTime = -1.0;
+        double stepSeen = -1.0;
+        double stepFrameEnd = -1.0;
+        float maxRollError = 0.0f;
+        float maxPitchError = 0.0f;
+        std::size_t samples = 0;
+        std::size_t busiestFrame = 0;
+        for (const FrameLog &frame : frames)
+        {
+            busiestFrame = std::max(busiestFrame, frame.events.size());
+            float previousOffset = 0.0f;
+            for (const AxisEvent &event : frame.events)
+            {
+                placed = placed && event.offset >= previousOffset && event.offset <= frame.deltaTime;
+                previousOffset = event.offset;
+
+                const double time = frame.start + event.offset;
+                if (firstTime < 0.0)
+                {
+                    firstTime = time;
+                }
+                else
+                {
+                    ordered = ordered && time >= previousTime - 1e-6;
+                    if (time - firstTime < length)
+                    {
+                        maxGap = std::max(maxGap, time - previousTime);
+                    }
+                }
+                previousTime = time;
+                samples++;
+
+                const double t = time - firstTime;
+                maxRollError = std::max(maxRollError, std::fabs(event.axes.roll - rollAt(t)));
+                if (t < stepAt - 1e-4 || t > stepEnd + 1e-4)
+                {
+                    maxPitchError = std::max(maxPitchError, std::fabs(event.axes.pitch - (t < stepAt ? 0.0f : 1.0f)));
+                }
+                if (stepSeen < 0.0 && event.axes.pitch > 0.5f)
+                {
+                    stepSeen = time;
+                    stepFrameEnd = frame.start + frame.deltaTime;
+                }
+            }
+        }
+        checks.expect(samples > 0, "no samples reached the frames");
+        checks.expect(ordered, "samples out of order across frames");
+        checks.expect(placed, "sample offsets outside their frame or out of order");
+        checks.expect(maxRollError < 2e-3f, "roll differs from the script by " + std::to_string(maxRollError));
+        checks.expect(maxPitchError < 1e-3f, "pitch differs from the script by " + std::to_string(maxPitchError));
+        checks.expect(stats.dropped == 0, std::to_string(stats.dropped) + " samples dropped (ring full)");
+        checks.expect(stepSeen >= 0.0, "pitch step never arrived");
+
+        const double achievedHz = sampledSeconds > 0.0 ? static_cast<double>(stats.reads) / sampledSeconds : 0.0;
+        checks.expect(achievedHz > 240.0, "sampler below twice the FDM rate: " + std::to_string(achievedHz) + " Hz");
+
+        // The recording must give back the same samples, frame by frame
+        InputSystem replay;
+        bool replayed = replay.startReplay(recording.string());
+        for (std::size_t i = 0; replayed && i < frames.size(); ++i)
+        {
+            replay.beginFrame(0.0, 0.0);
+            const std::vector<AxisEvent> &events = replay.axisEvents();
+            replayed = replay.isReplaying() && replay.frameDeltaTime() == frames[i].deltaTime &&
+                       events.size() == frames[i].events.size() &&
+                       (events.empty() ||
+                        std::memcmp(events.data(), frames[i].events.data(), events.size() * sizeof(AxisEvent)) == 0);
+        }
+        checks.expect(replayed, ".fsinput replay does not match the recorded samples");
+        replay.stop();
+        std::error_code error;
+        std::filesystem::remove(recording, error);
+
+        const double stepAbsolute = firstTime + stepAt;
+        std::cout << "  Rate            " << std::setw(9) << achievedHz << " Hz achieved (" << stats.reads << " reads, "
+                  << samples << " samples, " << stats.dropped << " dropped)" << std::endl;
+        std::cout << "  Sampler jitter  " << std::setw(9) << stats.maxLateUs << " us worst late tick, "
+                  << maxGap * 1000.0 << " ms largest gap between samples" << std::endl;
+        std::cout << "  Per frame       " << std::setw(9)
+                  << static_cast<double>(samples) / std::max<std::size_t>(frames.size(), 1) << " samples avg, " << busiestFrame << " in the busiest (the " << options.stallMs << " ms stall)"
+                  << std::endl;
+        if (stepSeen >= 0.0)
+        {
+            std::cout << "  Stick step      " << std::setw(9) << (stepSeen - stepAbsolute) * 1000.0
+                      << " ms to a sample (applied at that point of the frame); "
+                      << (stepFrameEnd - stepAbsolute) * 1000.0 << " ms to the next frame, as with one read per frame"
+                      << std::endl;
+        }
+
+        std::cout << (checks.failed() == 0 ? "✓ Joystick OK"
+                                           : "✗ " + std::to_string(checks.failed()) + " joystick checks failed")
+                  << std::endl;
+        return checks.failed() == 0 ? 0 : 1;
+    }
+
+} // namespace core
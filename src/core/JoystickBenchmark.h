@@ -0,0 +1,34 @@
+/**
+ * @file JoystickBenchmark.h
+ * @brief Joystick pipeline harness with a virtual device (`--bench-joystick` mode).
+ */
+
+#pragma once
+
+namespace core
+{
+
+    /**
+     * @brief Parameters of the joystick harness.
+     */
+    struct JoystickBenchmarkOptions
+    {
+        float rateHz = 1000.0f; ///< Sampler rate.
+        float seconds = 2.0f;   ///< Length of the scripted sweep.
+        float frameHz = 60.0f;  ///< Rate of the emulated main loop draining the ring.
+        float stallMs = 50.0f;  ///< One frame is delayed this much to check that nothing is lost.
+    };
+
+    /**
+     * @brief Drives the sampler thread with a scripted VirtualJoystickDevice, without hardware.
+     * @return 0 if every check passed (axis shaping, script parsing, sample
+     *         order and timing inside the frames, stick values against the
+     *         script, no drops across a stall, `.fsinput` replay of the samples).
+     *
+     * Headless: `FlightSim --bench-joystick [rateHz] [seconds]`. Reports the
+     * achieved rate, the sampler's worst lateness and how long a stick step
+     * takes to reach a frame, against one reading per rendered frame.
+     */
+    int runJoystickBenchmark(const JoystickBenchmarkOptions &options);
+
+} // namespace core
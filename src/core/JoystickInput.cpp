@@ -0,0 +1,473 @@
+/**
+ * @file JoystickInput.cpp
+ * @brief Implementation of the joystick devices, axis shaping and sampler thread.
+ */
+
+#include "core/JoystickInput.h"
+#include "util/JsonReader.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#if defined(__linux__)
+#define CORE_HAS_JOYSTICK_API 1
+#include <fcntl.h>
+#include <linux/joystick.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+#else
+#define CORE_HAS_JOYSTICK_API 0
+#endif
+
+namespace core
+{
+
+    namespace
+    {
+        using Clock = std::chrono::steady_clock;
+
+        constexpr float CHANGE_EPSILON = 1e-4f; ///< Smaller changes are not worth a sample.
+        constexpr auto RECONNECT_INTERVAL = std::chrono::seconds(1);
+        constexpr auto IDLE_POLL = std::chrono::milliseconds(100); ///< stop() latency while disconnected.
+
+        float applyExpo(float magnitude, float expo)
+        {
+            const float e = std::clamp(expo, 0.0f, 1.0f);
+            return e * magnitude * magnitude * magnitude + (1.0f - e) * magnitude;
+        }
+
+        bool readCurve(util::JsonReader &json, AxisCurve &curve)
+        {
+            if (!json.beginObject())
+            {
+                return false;
+            }
+            std::string_view key;
+            while (json.nextMember(key))
+            {
+                if (key == "axis")
+                    json.readInt(curve.axis);
+                else if (key == "invert")
+                    json.readBool(curve.invert);
+                else if (key == "deadzone")
+                    json.readFloat(curve.deadzone);
+                else if (key == "expo")
+                    json.readFloat(curve.expo);
+                else
+                    json.skipValue();
+            }
+            return json.ok();
+        }
+
+        bool changed(const JoystickAxes &a, const JoystickAxes &b)
+        {
+            return std::fabs(a.roll - b.roll) > CHANGE_EPSILON || std::fabs(a.pitch - b.pitch) > CHANGE_EPSILON ||
+                   std::fabs(a.yaw - b.yaw) > CHANGE_EPSILON || std::fabs(a.throttle - b.throttle) > CHANGE_EPSILON;
+        }
+    } // namespace
+
+    // ---------------------------------------------------------------------
+    //  Shaping and configuration
+    // ---------------------------------------------------------------------
+
+    float AxisCurve::shape(float raw) const
+    {
+        const float value = std::clamp(invert ? -raw : raw, -1.0f, 1.0f);
+        const float dead = std::clamp(deadzone, 0.0f, 0.95f);
+        const float magnitude = std::fabs(value);
+        if (magnitude <= dead)
+        {
+            return 0.0f;
+        }
+        return std::copysign(applyExpo((magnitude - dead) / (1.0f - dead), expo), value);
+    }
+
+    float AxisCurve::shapeLever(float raw) const
+    {
+        const float value = (std::clamp(invert ? -raw : raw, -1.0f, 1.0f) + 1.0f) * 0.5f;
+        const float dead = std::clamp(deadzone, 0.0f, 0.45f);
+        const float travel = std::clamp((value - dead) / (1.0f - 2.0f * dead), 0.0f, 1.0f);
+        return applyExpo(travel, expo);
+    }
+
+    bool JoystickConfig::load(const std::string &path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file)
+        {
+            return false;
+        }
+        std::stringstream buffer;
+        buffer << file.rdbuf();
+        const std::string text = buffer.str();
+
+        JoystickConfig parsed = *this;
+        util::JsonReader json(text);
+        std::string_view key;
+        if (json.beginObject())
+        {
+            while (json.nextMember(key))
+            {
+                if (key == "enabled")
+                    json.readBool(parsed.enabled);
+                else if (key == "device")
+                    json.readString(parsed.device);
+                else if (key == "rateHz")
+                    json.readFloat(parsed.rateHz);
+                else if (key == "roll")
+                    readCurve(json, parsed.roll);
+                else if (key == "pitch")
+                    readCurve(json, parsed.pitch);
+                else if (key == "yaw")
+                    readCurve(json, parsed.yaw);
+                else if (key == "throttle")
+                    readCurve(json, parsed.throttle);
+                else
+                    json.skipValue();
+            }
+        }
+        if (!json.finish())
+        {
+            size_t line = 0, column = 0;
+            json.errorLocation(line, column);
+            std::cerr << "[Joystick] " << path << ":" << line << ":" << column << ": " << json.error()
+                      << "; using the defaults" << std::endl;
+            return false;
+        }
+        *this = parsed;
+        return true;
+    }
+
+    JoystickAxes JoystickConfig::shape(const float *rawAxes, int axisCount) const
+    {
+        auto raw = [&](const AxisCurve &curve)
+        {
+            return (curve.axis >= 0 && curve.axis < axisCount) ? rawAxes[curve.axis] : 0.0f;
+        };
+
+        JoystickAxes axes;
+        axes.roll = roll.shape(raw(roll));
+        axes.pitch = pitch.shape(raw(pitch));
+        axes.yaw = yaw.shape(raw(yaw));
+        axes.throttle = (throttle.axis >= 0 && throttle.axis < axisCount) ? throttle.shapeLever(raw(throttle)) : -1.0f;
+        return axes;
+    }
+
+    // ---------------------------------------------------------------------
+    //  Devices
+    // ---------------------------------------------------------------------
+
+    LinuxJoystickDevice::LinuxJoystickDevice(std::string path)
+        : path_(std::move(path))
+    {
+    }
+
+    LinuxJoystickDevice::~LinuxJoystickDevice()
+    {
+        close();
+    }
+
+    bool LinuxJoystickDevice::open()
+    {
+#if CORE_HAS_JOYSTICK_API
+        close();
+        fd_ = ::open(path_.c_str(), O_RDONLY | O_NONBLOCK);
+        if (fd_ < 0)
+        {
+            return false;
+        }
+        char name[128] = {};
+        if (ioctl(fd_, JSIOCGNAME(sizeof(name)), name) < 0)
+        {
+            std::snprintf(name, sizeof(name), "unknown");
+        }
+        name_ = name;
+        std::fill(std::begin(axes_), std::end(axes_), 0.0f);
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    bool LinuxJoystickDevice::read(double, float (&axes)[MAX_AXES])
+    {
+#if CORE_HAS_JOYSTICK_API
+        if (fd_ < 0)
+        {
+            return false;
+        }
+        // The driver queues every change (and the initial state, flagged JS_EVENT_INIT)
+        js_event event;
+        ssize_t bytes;
+        while ((bytes = ::read(fd_, &event, sizeof(event))) == static_cast<ssize_t>(sizeof(event)))
+        {
+            if ((event.type & ~JS_EVENT_INIT) == JS_EVENT_AXIS && event.number < MAX_AXES)
+            {
+                axes_[event.number] = std::clamp(event.value / 32767.0f, -1.0f, 1.0f);
+            }
+        }
+        if (bytes < 0 && errno != EAGAIN)
+        {
+            close(); // ENODEV: unplugged
+            return false;
+        }
+        std::copy(std::begin(axes_), std::end(axes_), axes);
+        return true;
+#else
+        (void)axes;
+        return false;
+#endif
+    }
+
+    std::string LinuxJoystickDevice::name() const
+    {
+        return name_.empty() ? path_ : name_ + " (" + path_ + ")";
+    }
+
+    void LinuxJoystickDevice::close()
+    {
+#if CORE_HAS_JOYSTICK_API
+        if (fd_ >= 0)
+        {
+            ::close(fd_);
+            fd_ = -1;
+        }
+#endif
+    }
+
+    VirtualJoystickDevice::VirtualJoystickDevice(std::vector<Keyframe> keyframes, bool loop)
+        : keyframes_(std::move(keyframes)), loop_(loop)
+    {
+        std::stable_sort(keyframes_.begin(), keyframes_.end(),
+                         [](const Keyframe &a, const Keyframe &b)
+                         { return a.time < b.time; });
+    }
+
+    std::unique_ptr<VirtualJoystickDevice> VirtualJoystickDevice::fromFile(const std::string &path, bool loop)
+    {
+        std::ifstream file(path);
+        if (!file)
+        {
+            std::cerr << "[Joystick] Cannot open script " << path << std::endl;
+            return nullptr;
+        }
+
+        std::vector<Keyframe> keyframes;
+        std::string line;
+        int lineNumber = 0;
+        while (std::getline(file, line))
+        {
+            lineNumber++;
+            const std::string::size_type comment = line.find('#');
+            if (comment != std::string::npos)
+            {
+                line.erase(comment);
+            }
+            std::istringstream fields(line);
+            Keyframe keyframe{};
+            if (!(fields >> keyframe.time))
+            {
+                if (line.find_first_not_of(" \t\r") != std::string::npos)
+                {
+                    std::cerr << "[Joystick] " << path << ":" << lineNumber << ": expected a time" << std::endl;
+                    return nullptr;
+                }
+                continue;
+            }
+            for (int axis = 0; axis < MAX_AXES && fields >> keyframe.axes[axis]; ++axis)
+            {
+            }
+            keyframes.push_back(keyframe);
+        }
+        if (keyframes.empty())
+        {
+            std::cerr << "[Joystick] Script " << path << " has no keyframes" << std::endl;
+            return nullptr;
+        }
+        return std::make_unique<VirtualJoystickDevice>(std::move(keyframes), loop);
+    }
+
+    bool VirtualJoystickDevice::open()
+    {
+        startTime_ = -1.0;
+        return !keyframes_.empty();
+    }
+
+    bool VirtualJoystickDevice::read(double time, float (&axes)[MAX_AXES])
+    {
+        if (keyframes_.empty())
+        {
+            return false;
+        }
+        if (startTime_ < 0.0)
+        {
+            startTime_ = time;
+        }
+
+        double t = time - startTime_;
+        const double length = keyframes_.back().time;
+        if (loop_ && length > 0.0)
+        {
+            t = std::fmod(t, length);
+        }
+
+        // First keyframe after t; hold the ends
+        auto next = std::upper_bound(keyframes_.begin(), keyframes_.end(), t,
+                                     [](double value, const Keyframe &keyframe)
+                                     { return value < keyframe.time; });
+        if (next == keyframes_.begin() || next == keyframes_.end())
+        {
+            const Keyframe &held = next == keyframes_.end() ? keyframes_.back() : keyframes_.front();
+            std::copy(std::begin(held.axes), std::end(held.axes), axes);
+            return true;
+        }
+        const Keyframe &a = *(next - 1);
+        const Keyframe &b = *next;
+        const float blend = static_cast<float>((t - a.time) / (b.time - a.time));
+        for (int axis = 0; axis < MAX_AXES; ++axis)
+        {
+            axes[axis] = a.axes[axis] + (b.axes[axis] - a.axes[axis]) * blend;
+        }
+        return true;
+    }
+
+    // ---------------------------------------------------------------------
+    //  Sampler thread
+    // ---------------------------------------------------------------------
+
+    JoystickSampler::~JoystickSampler()
+    {
+        stop();
+    }
+
+    void JoystickSampler::start(std::unique_ptr<JoystickDevice> device, const JoystickConfig &config, ClockFn clock)
+    {
+        stop();
+        if (!device || !clock)
+        {
+            return;
+        }
+        device_ = std::move(device);
+        config_ = config;
+        config_.rateHz = std::clamp(config_.rateHz, 50.0f, 8000.0f);
+        clock_ = clock;
+        havePublished_ = false;
+        stopping_ = false;
+        thread_ = std::thread(&JoystickSampler::run, this);
+    }
+
+    void JoystickSampler::stop()
+    {
+        if (thread_.joinable())
+        {
+            stopping_ = true;
+            thread_.join();
+        }
+        connected_ = false;
+    }
+
+    JoystickSamplerStats JoystickSampler::stats() const
+    {
+        JoystickSamplerStats stats;
+        stats.reads = reads_.load(std::memory_order_relaxed);
+        stats.samples = samples_.load(std::memory_order_relaxed);
+        stats.dropped = dropped_.load(std::memory_order_relaxed);
+        stats.maxLateUs = maxLateUs_.load(std::memory_order_relaxed);
+        stats.connected = connected_.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+    bool JoystickSampler::publish(double time, const JoystickAxes &axes)
+    {
+        if (havePublished_ && !changed(axes, last_))
+        {
+            return true;
+        }
+        if (!ring_.push({time, axes}))
+        {
+            // The caller retries: last_ still holds what the consumer will see
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        last_ = axes;
+        havePublished_ = true;
+        samples_.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    void JoystickSampler::run()
+    {
+        const auto period =
+            std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / config_.rateHz));
+        float raw[JoystickDevice::MAX_AXES] = {};
+        Clock::time_point nextOpen = Clock::now();
+        bool centrePending = false; ///< Disconnected but the centred reading has not reached the ring yet.
+
+        while (!stopping_)
+        {
+            // Disconnected: retry once a second, waking often enough to honour stop()
+            if (!connected_)
+            {
+                // With the ring full the centring sample is retried until it lands, or the stick stays deflected
+                if (centrePending)
+                {
+                    centrePending = !publish(clock_(), JoystickAxes{});
+                }
+                const Clock::time_point now = Clock::now();
+                if (now >= nextOpen)
+                {
+                    nextOpen = now + RECONNECT_INTERVAL;
+                    if (device_->open())
+                    {
+                        connected_ = true;
+                        centrePending = false; // Live readings replace it
+                        std::cout << "[Joystick] Sampling " << device_->name() << " at " << config_.rateHz << " Hz"
+                                  << std::endl;
+                        continue;
+                    }
+                }
+                std::this_thread::sleep_for(IDLE_POLL);
+                continue;
+            }
+
+            Clock::time_point next = Clock::now();
+            while (!stopping_)
+            {
+                const Clock::time_point tick = Clock::now();
+                const float lateUs = std::chrono::duration<float, std::micro>(tick - next).count();
+                if (lateUs > maxLateUs_.load(std::memory_order_relaxed))
+                {
+                    maxLateUs_.store(lateUs, std::memory_order_relaxed);
+                }
+
+                const double time = clock_();
+                if (!device_->read(time, raw))
+                {
+                    // Centre the stick so the controller falls back to the keyboard
+                    connected_ = false;
+                    centrePending = !publish(time, JoystickAxes{});
+                    std::cout << "[Joystick] " << device_->name() << " disconnected" << std::endl;
+                    nextOpen = Clock::now() + RECONNECT_INTERVAL;
+                    break;
+                }
+                reads_.fetch_add(1, std::memory_order_relaxed);
+                publish(time, config_.shape(raw, JoystickDevice::MAX_AXES));
+
+                // Fixed schedule; after a long stall (suspend, debugger) restart it instead of bursting
+                next += period;
+                if (Clock::now() - next > 10 * period)
+                {
+                    next = Clock::now();
+                }
+                std::this_thread::sleep_until(next);
+            }
+        }
+    }
+
+} // namespace core
@@ -0,0 +1,246 @@
+/**
+ * @file JoystickInput.h
+ * @brief Analog stick/throttle sampling on a dedicated thread (HOTAS support).
+ *
+ * The sampler thread reads the device at a fixed rate (1 kHz by default,
+ * well ahead of the 120 Hz FDM), shapes each axis (inversion, deadzone,
+ * curve) and pushes timestamped samples into a lock-free ring. The main
+ * thread drains the ring in `InputSystem::beginFrame`, so the flight
+ * controller gets every sample with its position inside the frame instead
+ * of one reading per rendered frame.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "core/SpscRing.h"
+
+namespace core
+{
+
+    /**
+     * @brief Shaped control positions.
+     *
+     * Signs follow FlightSimulationController's VirtualJoystick: roll +1 is
+     * right, pitch +1 is nose up, yaw +1 is nose left.
+     */
+    struct JoystickAxes
+    {
+        float roll = 0.0f;      ///< [-1,1]
+        float pitch = 0.0f;     ///< [-1,1]
+        float yaw = 0.0f;       ///< [-1,1]
+        float throttle = -1.0f; ///< Lever in [0,1]; negative when there is no throttle axis (or no device).
+    };
+
+    /// One reading of the device, stamped with the sampler clock.
+    struct JoystickSample
+    {
+        double time;
+        JoystickAxes axes;
+    };
+
+    /**
+     * @brief Maps one raw device axis to a control.
+     *
+     * The deadzone is removed and the remaining travel rescaled, so the output
+     * starts at 0 right at the edge of the deadzone and still reaches ±1.
+     * `expo` blends a cubic into the response (0 = linear, 1 = pure cubic):
+     * finer control around the centre, same full deflection.
+     */
+    struct AxisCurve
+    {
+        int axis = -1; ///< Device axis index; -1 leaves the control unbound.
+        bool invert = false;
+        float deadzone = 0.05f; ///< Fraction of travel (around the centre, or at both ends of a lever).
+        float expo = 0.0f;
+
+        /// Stick axis: raw [-1,1] → [-1,1].
+        float shape(float raw) const;
+        /// Throttle lever: raw [-1,1] → [0,1] (the deadzone snaps to idle and full).
+        float shapeLever(float raw) const;
+    };
+
+    /**
+     * @brief Device, sample rate and axis mapping (`assets/joystick.json`).
+     *
+     * The defaults suit a USB stick on Linux: X roll, Y pitch (pushing forward
+     * pitches down), twist yaw and a throttle lever on axis 3 that is full
+     * when pushed forward.
+     */
+    struct JoystickConfig
+    {
+        bool enabled = true;
+        std::string device = "/dev/input/js0";
+        float rateHz = 1000.0f;
+        AxisCurve roll{0, false, 0.05f, 0.3f};
+        AxisCurve pitch{1, false, 0.05f, 0.3f};
+        AxisCurve yaw{2, true, 0.10f, 0.2f};
+        AxisCurve throttle{3, true, 0.02f, 0.0f};
+
+        /**
+         * @brief Reads the configuration from a JSON file; missing keys keep their defaults.
+         * @return false if the file is missing or malformed (the defaults are kept).
+         */
+        bool load(const std::string &path);
+
+        /// Applies the mapping to one raw reading.
+        JoystickAxes shape(const float *rawAxes, int axisCount) const;
+    };
+
+    /**
+     * @brief Source of raw axis positions, read from the sampler thread.
+     */
+    class JoystickDevice
+    {
+    public:
+        static constexpr int MAX_AXES = 16;
+
+        virtual ~JoystickDevice() = default;
+
+        /// Connects (or reconnects after an unplug). Returns false if the device is absent.
+        virtual bool open() = 0;
+        /**
+         * @brief Updates `axes` with the current positions.
+         * @param time Sampler clock, for devices that play back a script.
+         * @return false once the device is gone.
+         */
+        virtual bool read(double time, float (&axes)[MAX_AXES]) = 0;
+        virtual std::string name() const = 0;
+    };
+
+    /**
+     * @brief Linux joystick API device (`/dev/input/jsN`), read without blocking.
+     *
+     * On other platforms open() always fails; only virtual devices are available.
+     */
+    class LinuxJoystickDevice : public JoystickDevice
+    {
+    public:
+        explicit LinuxJoystickDevice(std::string path);
+        ~LinuxJoystickDevice() override;
+
+        bool open() override;
+        bool read(double time, float (&axes)[MAX_AXES]) override;
+        std::string name() const override;
+
+    private:
+        void close();
+
+        std::string path_;
+        std::string name_;
+        int fd_ = -1;
+        float axes_[MAX_AXES] = {};
+    };
+
+    /**
+     * @brief Scripted device: injects axis data without hardware.
+     *
+     * A script is a list of keyframes (time in seconds from the first read,
+     * then one raw value per axis), interpolated linearly and optionally
+     * looped. The text form has one keyframe per line, `#` starting a comment:
+     * @code
+     *   # t    x     y     twist  lever
+     *   0.0    0.0   0.0   0.0    1.0
+     *   2.0    0.6  -0.2   0.0    1.0
+     * @endcode
+     */
+    class VirtualJoystickDevice : public JoystickDevice
+    {
+    public:
+        struct Keyframe
+        {
+            double time;
+            float axes[MAX_AXES];
+        };
+
+        explicit VirtualJoystickDevice(std::vector<Keyframe> keyframes, bool loop = true);
+
+        /// Loads a text script. Returns nullptr (and logs why) if it cannot be read.
+        static std::unique_ptr<VirtualJoystickDevice> fromFile(const std::string &path, bool loop = true);
+
+        bool open() override;
+        bool read(double time, float (&axes)[MAX_AXES]) override;
+        std::string name() const override { return "virtual joystick"; }
+
+    private:
+        std::vector<Keyframe> keyframes_;
+        bool loop_ = true;
+        double startTime_ = -1.0; ///< Sampler time of the first read.
+    };
+
+    /**
+     * @brief Counters published by the sampler thread.
+     */
+    struct JoystickSamplerStats
+    {
+        uint64_t reads = 0;     ///< Device reads (ticks while connected).
+        uint64_t samples = 0;   ///< Samples pushed (only changed readings are pushed).
+        uint64_t dropped = 0;   ///< Samples lost because the ring was full.
+        float maxLateUs = 0.0f; ///< Worst tick start behind its schedule.
+        bool connected = false;
+    };
+
+    /**
+     * @brief Owns the sampler thread and the ring it fills.
+     *
+     * The thread is the ring's only producer and the main thread (through
+     * InputSystem) its only consumer. While the device is absent the thread
+     * only retries open() once a second, so an unplugged stick costs nothing.
+     */
+    class JoystickSampler
+    {
+    public:
+        using ClockFn = double (*)();
+        static constexpr std::size_t RING_CAPACITY = 4096; ///< ~4 s of samples at 1 kHz.
+
+        JoystickSampler() = default;
+        ~JoystickSampler();
+
+        JoystickSampler(const JoystickSampler &) = delete;
+        JoystickSampler &operator=(const JoystickSampler &) = delete;
+
+        /**
+         * @brief Starts sampling `device` with `config`'s mapping and rate.
+         * @param clock Time source of the samples; must match the one the frames use (glfwGetTime).
+         */
+        void start(std::unique_ptr<JoystickDevice> device, const JoystickConfig &config, ClockFn clock);
+        /// Stops and joins the thread; samples still in the ring stay readable.
+        void stop();
+        bool isRunning() const { return thread_.joinable(); }
+
+        /// Consumer side: oldest sample, or nullptr. Valid until pop().
+        const JoystickSample *front() const { return ring_.front(); }
+        void pop() { ring_.pop(); }
+
+        /// Snapshot of the counters (any thread).
+        JoystickSamplerStats stats() const;
+
+    private:
+        void run();
+        /// Pushes `axes` if they changed; false if the ring was full (the consumer still sees the old reading).
+        bool publish(double time, const JoystickAxes &axes);
+
+        std::unique_ptr<JoystickDevice> device_;
+        JoystickConfig config_;
+        ClockFn clock_ = nullptr;
+
+        SpscRing<JoystickSample, RING_CAPACITY> ring_;
+        JoystickAxes last_{};
+        bool havePublished_ = false;
+
+        std::atomic<bool> stopping_{false};
+        std::atomic<uint64_t> reads_{0};
+        std::atomic<uint64_t> samples_{0};
+        std::atomic<uint64_t> dropped_{0};
+        std::atomic<float> maxLateUs_{0.0f};
+        std::atomic<bool> connected_{false};
+        std::thread thread_;
+    };
+
+} // namespace core
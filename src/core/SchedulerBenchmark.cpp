@@ -0,0 +1,266 @@
+#include "core/SchedulerBenchmark.h"
+#include "core/JobPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace core
+{
+    namespace
+    {
+        using Clock = std::chrono::steady_clock;
+
+        double elapsedMs(Clock::time_point start)
+        {
+            return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        }
+
+        /// Runs `fn` `rounds` times and returns the fastest run in ms.
+        template <typename Fn>
+        double bestOf(int rounds, Fn &&fn)
+        {
+            double best = 0.0;
+            for (int i = 0; i < std::max(rounds, 1); ++i)
+            {
+                const Clock::time_point start = Clock::now();
+                fn();
+                const double ms = elapsedMs(start);
+                best = i == 0 ? ms : std::min(best, ms);
+            }
+            return best;
+        }
+
+        /// Binary fork/join tree: every node spawns two children and waits for them.
+        struct ForkTree
+        {
+            JobPool &pool;
+            std::atomic<std::size_t> leaves{0};
+
+            void node(int depth)
+            {
+                if (depth == 0)
+                {
+                    leaves.fetch_add(1, std::memory_order_relaxed);
+                    return;
+                }
+                TaskHandle left = pool.submit([this, depth]()
+                                              { node(depth - 1); });
+                TaskHandle right = pool.submit([this, depth]()
+                                               { node(depth - 1); });
+                pool.wait(left);
+                pool.wait(right);
+            }
+        };
+
+        class Checks
+        {
+        public:
+            void expect(bool ok, const std::string &what)
+            {
+                if (!ok)
+                {
+                    std::cout << "  ✗ " << what << std::endl;
+                    failed_++;
+                }
+            }
+            int failed() const { return failed_; }
+
+        private:
+            int failed_ = 0;
+        };
+
+        double stealRate(const SchedulerStats &stats)
+        {
+            return stats.stealAttempts > 0 ? 100.0 * stats.steals / stats.stealAttempts : 0.0;
+        }
+    } // namespace
+
+    int runSchedulerBenchmark(const SchedulerBenchmarkOptions &options)
+    {
+        std::cout << std::fixed << std::setprecision(2);
+
+        const unsigned workers = options.workers > 0 ? options.workers : std::max(JobPool::defaultWorkerCount(), 3u);
+        JobPool pool(workers);
+        Checks checks;
+        std::cout << "Scheduler benchmark: " << workers << " workers + main thread ("
+                  << std::thread::hardware_concurrency() << " hardware threads)" << std::endl;
+
+        // Spawn cost from the main thread: every task goes through the injection queue.
+        {
+            const std::size_t count = options.tasks;
+            double submitMs = 1e30; // fastest round
+            pool.resetStats();
+            const double totalMs = bestOf(options.rounds, [&]()
+                                          {
+                const Clock::time_point start = Clock::now();
+                for (std::size_t i = 0; i < count; ++i)
+                    pool.submit([]() {});
+                submitMs = std::min(submitMs, elapsedMs(start));
+                pool.waitIdle(); });
+            const SchedulerStats stats = pool.stats();
+            checks.expect(stats.executed == stats.submitted, "injected tasks: " + std::to_string(stats.executed) +
+                                                                 " executed of " + std::to_string(stats.submitted));
+            std::cout << "  Spawn (main)    " << std::setw(9) << submitMs * 1e6 / std::max<std::size_t>(count, 1)
+                      << " ns/submit  " << std::setw(9) << totalMs * 1e6 / std::max<std::size_t>(count, 1)
+                      << " ns/task end to end" << std::endl;
+        }
+
+        // Spawn cost on a worker: children land in its own deque and the others steal them.
+        {
+            const std::size_t count = options.tasks;
+            std::atomic<std::size_t> ran{0};
+            double submitMs = 1e30; // fastest round
+            pool.resetStats();
+            const double totalMs = bestOf(options.rounds, [&]()
+                                          {
+                TaskHandle root = pool.submit([&]()
+                                              {
+                    const Clock::time_point start = Clock::now();
+                    for (std::size_t i = 0; i < count; ++i)
+                        pool.submit([&ran]() { ran.fetch_add(1, std::memory_order_relaxed); });
+                    submitMs = std::min(submitMs, elapsedMs(start)); });
+                // Not pool.wait: the main thread would help and could run the root itself.
+                while (!root.done())
+                    std::this_thread::yield();
+                pool.waitIdle(); });
+            const SchedulerStats stats = pool.stats();
+            checks.expect(ran.load() == count * static_cast<std::size_t>(std::max(options.rounds, 1)),
+                          "worker-spawned tasks: " + std::to_string(ran.load()) + " ran");
+            std::cout << "  Spawn (worker)  " << std::setw(9) << submitMs * 1e6 / std::max<std::size_t>(count, 1)
+                      << " ns/submit  " << std::setw(9) << totalMs * 1e6 / std::max<std::size_t>(count, 1)
+                      << " ns/task end to end, " << stats.steals << " steals (" << stealRate(stats)
+                      << "% of " << stats.stealAttempts << " probes)" << std::endl;
+        }
+
+        // Recursive fork/join: waiting tasks run other tasks instead of blocking.
+        {
+            ForkTree tree{pool};
+            pool.resetStats();
+            const double ms = bestOf(options.rounds, [&]()
+                                     {
+                tree.leaves.store(0);
+                tree.node(options.treeDepth); });
+            const SchedulerStats stats = pool.stats();
+            const std::size_t expected = std::size_t(1) << options.treeDepth;
+            checks.expect(tree.leaves.load() == expected,
+                          "fork tree: " + std::to_string(tree.leaves.load()) + " of " + std::to_string(expected) + " leaves");
+            const double nodes = static_cast<double>(expected * 2 - 1);
+            std::cout << "  Fork tree d=" << std::setw(2) << options.treeDepth << "  " << std::setw(9) << ms << " ms  "
+                      << std::setw(9) << ms * 1e6 / nodes << " ns/node, " << stats.steals << " steals ("
+                      << stealRate(stats) << "% of " << stats.stealAttempts << " probes)" << std::endl;
+        }
+
+        // Dependency chain: each link runs strictly after the previous one.
+        {
+            std::vector<std::size_t> order;
+            order.reserve(options.chain);
+            const double ms = bestOf(options.rounds, [&]()
+                                     {
+                order.clear();
+                TaskHandle previous;
+                for (std::size_t i = 0; i < options.chain; ++i)
+                    previous = pool.submit([&order, i]() { order.push_back(i); }, {previous});
+                pool.wait(previous); });
+            bool inOrder = order.size() == options.chain;
+            for (std::size_t i = 0; inOrder && i < order.size(); ++i)
+                inOrder = order[i] == i;
+            checks.expect(inOrder, "dependency chain out of order");
+            std::cout << "  Chain x" << options.chain << "    " << std::setw(9) << ms << " ms  " << std::setw(9)
+                      << ms * 1e6 / std::max<std::size_t>(options.chain, 1) << " ns/link" << std::endl;
+        }
+
+        // Diamond with a main-thread join (the decode -> upload pattern).
+        {
+            int left = 0;
+            int right = 0;
+            int joined = 0;
+            std::thread::id joinThread;
+            TaskHandle source = pool.submit([&]()
+                                            { left = right = 1; });
+            TaskHandle a = pool.then(source, [&]()
+                                     { left += 10; });
+            TaskHandle b = pool.then(source, [&]()
+                                     { right += 20; });
+            TaskHandle join = pool.submit([&]()
+                                          {
+                joined = left + right;
+                joinThread = std::this_thread::get_id(); }, {a, b}, TaskAffinity::MainThread);
+            pool.wait(join);
+            checks.expect(joined == 32, "diamond join saw " + std::to_string(joined) + " instead of 32");
+            checks.expect(joinThread == std::this_thread::get_id(), "main-thread task ran on another thread");
+        }
+
+        // Main-thread tasks queued from workers wait for runMainThreadTasks.
+        {
+            const std::size_t count = 64;
+            std::atomic<std::size_t> offMain{0};
+            std::vector<TaskHandle> uploads;
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                TaskHandle decode = pool.submit([]() {});
+                uploads.push_back(pool.then(decode, [&]()
+                                            {
+                    if (!pool.isMainThread())
+                        offMain.fetch_add(1); },
+                                            TaskAffinity::MainThread));
+            }
+            std::size_t ran = 0;
+            const Clock::time_point start = Clock::now();
+            while (ran < count && elapsedMs(start) < 5000.0)
+                ran += pool.runMainThreadTasks();
+            checks.expect(ran == count, "runMainThreadTasks ran " + std::to_string(ran) + " of " + std::to_string(count));
+            checks.expect(offMain.load() == 0, "main-thread tasks ran off the main thread");
+            pool.waitIdle();
+        }
+
+        // A failing task rethrows in wait and still releases its continuations.
+        {
+            bool continued = false;
+            TaskHandle failing = pool.submit([]()
+                                             { throw std::runtime_error("expected"); });
+            TaskHandle next = pool.then(failing, [&]()
+                                        { continued = true; });
+            bool rethrown = false;
+            try
+            {
+                pool.wait(failing);
+            }
+            catch (const std::runtime_error &)
+            {
+                rethrown = true;
+            }
+            pool.wait(next);
+            checks.expect(rethrown, "task exception not rethrown by wait");
+            checks.expect(continued, "continuation of a failed task did not run");
+        }
+
+        // parallelFor on the main thread while the workers are busy with tasks.
+        {
+            std::atomic<std::size_t> background{0};
+            for (std::size_t i = 0; i < 1000; ++i)
+                pool.submit([&background]()
+                            { background.fetch_add(1, std::memory_order_relaxed); });
+            std::vector<std::size_t> squares(10000);
+            pool.parallelFor(squares.size(), [&](std::size_t i)
+                             { squares[i] = i * i; });
+            pool.waitIdle();
+            bool ok = background.load() == 1000;
+            for (std::size_t i = 0; ok && i < squares.size(); ++i)
+                ok = squares[i] == i * i;
+            checks.expect(ok, "parallelFor next to tasks lost work");
+        }
+
+        std::cout << (checks.failed() == 0 ? "✓ Scheduler OK"
+                                           : "✗ " + std::to_string(checks.failed()) + " scheduler checks failed")
+                  << std::endl;
+        return checks.failed() == 0 ? 0 : 1;
+    }
+
+} // namespace core
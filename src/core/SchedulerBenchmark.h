@@ -0,0 +1,35 @@
+/**
+ * @file SchedulerBenchmark.h
+ * @brief Task scheduler microbenchmark and self-check (`--bench-scheduler` mode).
+ */
+
+#pragma once
+
+#include <cstddef>
+
+namespace core
+{
+
+    /**
+     * @brief Parameters of the scheduler benchmark.
+     */
+    struct SchedulerBenchmarkOptions
+    {
+        unsigned workers = 0;       ///< 0 = JobPool::defaultWorkerCount(), at least 3 so there is someone to steal from.
+        std::size_t tasks = 200000; ///< Empty tasks for the spawn cost runs.
+        int treeDepth = 16;         ///< Recursive fork/join tree (2^depth leaves).
+        std::size_t chain = 10000;  ///< Length of the dependency chain.
+        int rounds = 3;             ///< Every timed run is repeated; the best one is reported.
+    };
+
+    /**
+     * @brief Measures task spawn cost and steal rate, and checks the ordering guarantees.
+     * @return 0 if every check passed (counts, dependency order, main-thread
+     *         affinity, exception propagation, parallelFor next to tasks).
+     *
+     * Headless: `FlightSim --bench-scheduler [workers] [tasks]`. Built with
+     * `-fsanitize=thread` it doubles as the scheduler's race test.
+     */
+    int runSchedulerBenchmark(const SchedulerBenchmarkOptions &options);
+
+} // namespace core
@@ -0,0 +1,73 @@
+/**
+ * @file SpscRing.h
+ * @brief Fixed-size lock-free ring for one producer thread and one consumer thread.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace core
+{
+
+    /**
+     * @brief Bounded single-producer / single-consumer queue without locks.
+     *
+     * The producer only writes `head_` and the consumer only writes `tail_`;
+     * each publishes with a release store and reads the other's index with an
+     * acquire load, so an element is fully written before it becomes visible.
+     * A full ring rejects the push instead of blocking the producer.
+     */
+    template <typename T, std::size_t Capacity>
+    class SpscRing
+    {
+        static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+    public:
+        /// Producer side. Returns false (element dropped) when the ring is full.
+        bool push(const T &value)
+        {
+            const uint64_t head = head_.load(std::memory_order_relaxed);
+            if (head - tail_.load(std::memory_order_acquire) >= Capacity)
+            {
+                return false;
+            }
+            slots_[head & (Capacity - 1)] = value;
+            head_.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+        /// Consumer side: oldest element, or nullptr when empty. Valid until pop().
+        const T *front() const
+        {
+            const uint64_t tail = tail_.load(std::memory_order_relaxed);
+            if (tail == head_.load(std::memory_order_acquire))
+            {
+                return nullptr;
+            }
+            return &slots_[tail & (Capacity - 1)];
+        }
+
+        /// Consumer side: discards the element returned by front().
+        void pop()
+        {
+            tail_.store(tail_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        }
+
+        /// Approximate when called from a third thread.
+        std::size_t size() const
+        {
+            return static_cast<std::size_t>(head_.load(std::memory_order_acquire) -
+                                            tail_.load(std::memory_order_acquire));
+        }
+
+    private:
+        std::array<T, Capacity> slots_{};
+        alignas(64) std::atomic<uint64_t> head_{0}; ///< Next slot to write (producer).
+        alignas(64) std::atomic<uint64_t> tail_{0}; ///< Next slot to read (consumer).
+    };
+
+} // namespace core
@@ -0,0 +1,117 @@
+#include "flight/autopilot/Autopilot.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace flight
+{
+    namespace
+    {
+        constexpr float kGravity = 9.81f;             // m/s^2
+        constexpr float kKtToMps = 0.514444f;         // 1 kt -> m/s
+        constexpr float kKtToFpm = 101.268591f;       // 1 kt -> ft/min
+        constexpr float kMetersToFeet = 3.2808399f;   // 1 m -> ft
+        constexpr float kRadToDeg = 57.2957795f;
+
+        // Lateral loop
+        constexpr float kBankPerHeading = 2.5f;  // deg of bank per deg of heading error
+        constexpr float kRollGain = 2.0f;        // deg/s of roll rate per deg of bank error
+        constexpr float kAileronRate = 130.0f;   // deg/s of roll rate per unit of aileron
+        constexpr float kSideslipGain = 2.0f;    // rudder per rad of sideslip
+
+        // Vertical loop
+        constexpr float kVerticalSpeedPerFoot = 6.0f; // ft/min per ft of altitude error
+        constexpr float kPitchPerFpm = 0.002f;        // deg of pitch per ft/min of vertical speed error
+        constexpr float kPitchTrimRate = 0.001f;      // deg/s per ft/min of vertical speed error
+        constexpr float kPitchGain = 2.0f;            // deg/s of pitch rate per deg of pitch error
+        constexpr float kElevatorRate = 45.0f;        // deg/s of pitch rate per unit of elevator
+        constexpr float kMaxPitchTrim = 10.0f;        // deg
+
+        // Speed loop
+        constexpr float kThrottlePerKnot = 0.02f;
+        constexpr float kThrottleTrimRate = 0.004f; // 1/s per kt
+
+        // Extension hysteresis: resume the turn once the target clears the circle by this factor
+        constexpr float kExtendExit = 1.5f;
+
+        float wrap180(float degrees)
+        {
+            degrees = std::fmod(degrees + 180.0f, 360.0f);
+            if (degrees < 0.0f)
+                degrees += 360.0f;
+            return degrees - 180.0f;
+        }
+    }
+
+    void Autopilot::reset(float throttle)
+    {
+        throttleTrim_ = std::clamp(throttle, 0.0f, 1.0f);
+        pitchTrim_ = 0.0f;
+        commandedBank_ = 0.0f;
+        commandedPitch_ = 0.0f;
+        extending_ = false;
+    }
+
+    AutopilotCommand Autopilot::update(const FlightData &data, const AutopilotTargets &targets, float dt)
+    {
+        AutopilotCommand command;
+
+        // Heading -> bank -> aileron
+        const float headingError = wrap180(targets.heading - data.heading);
+        commandedBank_ = std::clamp(headingError * kBankPerHeading, -limits_.maxBank, limits_.maxBank);
+        const float rollRate = data.rollRate * kRadToDeg;
+        const float desiredRollRate = (commandedBank_ - data.roll) * kRollGain;
+        command.aileron = std::clamp((desiredRollRate - rollRate) / kAileronRate, -1.0f, 1.0f);
+        command.rudder = std::clamp(-data.sideslip * kSideslipGain, -0.3f, 0.3f);
+
+        // Altitude -> vertical speed -> pitch -> elevator
+        const float commandedVs = std::clamp((targets.altitude - data.altitude) * kVerticalSpeedPerFoot,
+                                             -limits_.maxVerticalSpeed, limits_.maxVerticalSpeed);
+        const float speedFpm = std::max(data.airspeed * kKtToFpm, 1.0f);
+        const float flightPath = std::asin(std::clamp(commandedVs / speedFpm, -1.0f, 1.0f)) * kRadToDeg;
+        const float vsError = commandedVs - data.verticalSpeed;
+        pitchTrim_ = std::clamp(pitchTrim_ + vsError * kPitchTrimRate * dt, -kMaxPitchTrim, kMaxPitchTrim);
+        commandedPitch_ = std::clamp(flightPath + pitchTrim_ + vsError * kPitchPerFpm,
+                                     -limits_.maxPitch, limits_.maxPitch);
+        const float pitchRate = data.pitchRate * kRadToDeg;
+        const float desiredPitchRate = (commandedPitch_ - data.pitch) * kPitchGain;
+        command.elevator = std::clamp(-(desiredPitchRate - pitchRate) / kElevatorRate, -1.0f, 1.0f);
+
+        // Airspeed -> throttle
+        const float speedError = targets.airspeed - data.airspeed;
+        throttleTrim_ = std::clamp(throttleTrim_ + speedError * kThrottleTrimRate * dt, 0.0f, 1.0f);
+        command.throttle = std::clamp(throttleTrim_ + speedError * kThrottlePerKnot, 0.0f, 1.0f);
+
+        return command;
+    }
+
+    AutopilotCommand Autopilot::flyTo(const FlightData &data, const glm::vec3 &target, float airspeed, float dt)
+    {
+        const glm::vec2 toTarget(target.x - data.position.x, target.z - data.position.z);
+        const float bearing = std::atan2(toTarget.x, -toTarget.y) * kRadToDeg;
+        const float headingError = wrap180(bearing - data.heading);
+
+        // Center of the tightest turn toward the target (world XZ; heading 0 = -Z)
+        const float radius = turnRadius(data.airspeed);
+        const float heading = data.heading / kRadToDeg;
+        const glm::vec2 forward(std::sin(heading), -std::cos(heading));
+        const glm::vec2 right(-forward.y, forward.x);
+        const glm::vec2 center = right * (headingError >= 0.0f ? radius : -radius);
+        const float fromCenter = glm::length(toTarget - center);
+        extending_ = fromCenter < radius * (extending_ ? kExtendExit : 1.0f);
+
+        AutopilotTargets targets;
+        targets.heading = extending_ ? data.heading : bearing;
+        targets.altitude = target.y * kMetersToFeet;
+        targets.airspeed = airspeed;
+        return update(data, targets, dt);
+    }
+
+    float Autopilot::turnRadius(float airspeed) const
+    {
+        const float speed = airspeed * kKtToMps;
+        const float bank = std::clamp(limits_.maxBank, 1.0f, 89.0f) / kRadToDeg;
+        return speed * speed / (kGravity * std::tan(bank));
+    }
+
+} // namespace flight
@@ -0,0 +1,103 @@
+/**
+ * @file Autopilot.h
+ * @brief Heading/altitude/speed hold autopilot driving normalized control inputs.
+ */
+
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include "flight/data/FlightData.h"
+
+namespace flight
+{
+    /**
+     * @brief Values the autopilot holds.
+     */
+    struct AutopilotTargets
+    {
+        float heading = 0.0f;  ///< Degrees [0, 360), 0 = North.
+        float altitude = 0.0f; ///< ft
+        float airspeed = 0.0f; ///< kt
+    };
+
+    /**
+     * @brief Envelope the outer loops never command beyond.
+     */
+    struct AutopilotLimits
+    {
+        float maxBank = 45.0f;            ///< Degrees.
+        float maxPitch = 15.0f;           ///< Degrees, both directions.
+        float maxVerticalSpeed = 3000.0f; ///< ft/min, both directions.
+    };
+
+    /**
+     * @brief Normalized inputs for `FdmSimulation::setNormalizedInputs`.
+     *
+     * Same conventions as the keyboard: positive elevator pushes the nose
+     * down, positive aileron rolls right, positive rudder yaws left.
+     */
+    struct AutopilotCommand
+    {
+        float elevator = 0.0f; ///< [-1, 1]
+        float aileron = 0.0f;  ///< [-1, 1]
+        float rudder = 0.0f;   ///< [-1, 1]
+        float throttle = 0.0f; ///< [0, 1]
+    };
+
+    /**
+     * @brief Classic cascade on top of the FDM's normalized inputs.
+     *
+     * - Lateral: heading error -> bank command -> aileron (roll-rate damped).
+     * - Vertical: altitude error -> vertical speed -> pitch command -> elevator
+     *   (pitch-rate damped); the pitch trim integrates the vertical speed error,
+     *   which also absorbs the extra lift needed in a banked turn.
+     * - Speed: airspeed error -> throttle around an integrated trim.
+     *
+     * `flyTo` adds the waypoint guidance on top: it points at the target, and
+     * when the target sits inside the turn circle at the bank limit (it cannot
+     * be reached by turning) it flies straight until it can.
+     */
+    class Autopilot
+    {
+    public:
+        /**
+         * @brief Clears the integrators.
+         * @param throttle Throttle the speed loop starts from (the current one).
+         */
+        void reset(float throttle);
+
+        void setLimits(const AutopilotLimits &limits) { limits_ = limits; }
+        const AutopilotLimits &getLimits() const { return limits_; }
+
+        /**
+         * @brief Runs the hold loops for one frame.
+         */
+        AutopilotCommand update(const FlightData &data, const AutopilotTargets &targets, float dt);
+
+        /**
+         * @brief Steers toward a world-space point at `airspeed` kt (altitude = its Y).
+         */
+        AutopilotCommand flyTo(const FlightData &data, const glm::vec3 &target, float airspeed, float dt);
+
+        /**
+         * @brief Level turn radius at the bank limit, in meters.
+         */
+        float turnRadius(float airspeed) const;
+
+        /// true while `flyTo` holds heading because the target is inside the turn circle.
+        bool isExtending() const { return extending_; }
+
+        float getCommandedBank() const { return commandedBank_; }
+        float getCommandedPitch() const { return commandedPitch_; }
+
+    private:
+        AutopilotLimits limits_;
+        float throttleTrim_ = 0.32f; ///< Speed loop integrator.
+        float pitchTrim_ = 0.0f;     ///< Degrees, vertical speed loop integrator.
+        float commandedBank_ = 0.0f;
+        float commandedPitch_ = 0.0f;
+        bool extending_ = false;
+    };
+
+} // namespace flight
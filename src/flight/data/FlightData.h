@@ -102,6 +102,9 @@ namespace flight
         float gForceLateral = 0.0f; ///< Lateral G-force.
         float loadFactor = 1.0f;    ///< Load factor (n = G / g).
 
+        // --- Motor (Engine) ---
+        float throttle = 0.0f; ///< Normalized throttle applied to the FDM [0, 1].
+
         // --- Sistema de Waypoints (Navigation System) ---
         glm::vec3 targetWaypoint = glm::vec3(0.0f); ///< Target waypoint position in world coordinates.
         bool hasActiveWaypoint = false;             ///< True if a waypoint is currently active.
@@ -38,6 +38,20 @@ namespace flight
 
         controls_ = trimControls_;
         accumulator_ = 0.0f;
+        loadFactor_ = 1.0f;
+
+        syncState();
+    }
+
+    void FdmSimulation::initialize(const glm::vec3 &worldPosition, float headingDegrees)
+    {
+        initialize();
+
+        // World (x = East, y = Up, z = South) -> NED
+        dlfdm::AircraftState state = trimState_;
+        state.intertial_position = glm::vec3(-worldPosition.z, worldPosition.x, -worldPosition.y);
+        state.psi = glm::radians(headingDegrees);
+        solver_->setState(state);
 
         syncState();
     }
@@ -114,6 +128,9 @@ namespace flight
             }
 
             accumulator_ -= fixedTimeStep_;
+
+            // Lift of the last integration stage; the solver's G is the body acceleration
+            loadFactor_ = -solver_->get_aero_fm().body_forces.z / (aircraftParams_.mass * 9.81f);
         }
 
         // Sync internal state with the solver's state
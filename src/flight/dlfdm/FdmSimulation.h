@@ -33,6 +33,14 @@ namespace flight
          */
         void initialize();
 
+        /**
+         * @brief Initializes in the trim state at a given world position and heading.
+         *
+         * @param worldPosition Position in world coordinates (meters, Y up).
+         * @param headingDegrees Heading (0 = North = -Z, 90 = East = +X).
+         */
+        void initialize(const glm::vec3 &worldPosition, float headingDegrees);
+
         struct StateValidation
         {
             bool isStalled = false;
@@ -72,6 +80,8 @@ namespace flight
         glm::vec3 getWorldPosition() const { return worldPosition_; }
         glm::quat getWorldOrientation() const { return worldOrientation_; }
         float getTrueAirspeed() const { return trueAirspeed_; }
+        /// Normal load factor (aerodynamic lift over weight), 1 in level flight.
+        float getLoadFactor() const { return loadFactor_; }
         const flight::FlightData &getFlightData() const { return cachedFlightData_; }
 
     private:
@@ -87,6 +97,7 @@ namespace flight
         glm::vec3 worldPosition_{0.0f};
         glm::quat worldOrientation_{1.0f, 0.0f, 0.0f, 0.0f};
         float trueAirspeed_ = 0.0f;
+        float loadFactor_ = 1.0f;
         flight::FlightData cachedFlightData_;
         StateValidation stateValidation_;
         std::ofstream logFile_;
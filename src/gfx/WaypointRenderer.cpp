@@ -1,4 +1,5 @@
 #include "WaypointRenderer.h"
+#include "core/RenderState.h"
 #include <cmath>
 #include <vector>
 #include <iostream>
@@ -12,7 +13,10 @@ namespace gfx
     WaypointRenderer::~WaypointRenderer()
     {
         if (vao_)
+        {
+            RenderState::forgetVertexArray(vao_);
             glDeleteVertexArrays(1, &vao_);
+        }
         if (vbo_)
             glDeleteBuffers(1, &vbo_);
         if (ebo_)
@@ -88,7 +92,7 @@ namespace gfx
         glGenBuffers(1, &vbo_);
         glGenBuffers(1, &ebo_);
 
-        glBindVertexArray(vao_);
+        RenderState::bindVertexArray(vao_);
 
         glBindBuffer(GL_ARRAY_BUFFER, vbo_);
         glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
@@ -104,7 +108,7 @@ namespace gfx
         glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void *)(3 * sizeof(float)));
         glEnableVertexAttribArray(1);
 
-        glBindVertexArray(0);
+        RenderState::bindVertexArray(0);
     }
 
     ////////////////////////////////////////////////////////////////////////////
@@ -128,9 +132,8 @@ namespace gfx
         shader_.setFloat("waypointAlpha", color.a);
         shader_.setBool("isActive", isActive);
 
-        glBindVertexArray(vao_);
+        RenderState::bindVertexArray(vao_);
         glDrawElements(GL_TRIANGLES, indexCount_, GL_UNSIGNED_INT, 0);
-        glBindVertexArray(0);
     }
 
 } // namespace gfx
@@ -48,6 +48,9 @@ namespace gfx
                           const glm::vec3 &position, const glm::vec4 &color,
                           bool isActive = false);
 
+        /// Program the markers are drawn with (render queue sort key).
+        GLuint program() const { return shader_.id(); }
+
     private:
         GLuint vao_ = 0, vbo_ = 0, ebo_ = 0; ///< Buffers for the cylinder mesh.
         Shader shader_;                      ///< Shader applying simple lighting.
@@ -14,6 +14,8 @@ extern "C"
 #include <GLFW/glfw3.h>
 }
 
+#include "GLDebug.h"
+
 namespace gfx
 {
 
@@ -34,10 +36,23 @@ namespace gfx
      * @brief Queries glGetError and reports which operation caused the failure.
      *
      * Used after critical blocks (buffer creation, texture uploads, etc.)
-     * to detect state errors and abort with a descriptive message.
+     * to detect state errors and abort with a descriptive message. In
+     * `FLIGHTSIM_GL_DEBUG` builds with a debug context it reads the error
+     * reported by the KHR_debug callback instead, without touching GL.
      */
     inline void checkGLError(const char *operation)
     {
+#ifdef FLIGHTSIM_GL_DEBUG
+        if (debugOutputActive())
+        {
+            std::string message;
+            if (takeDebugError(message))
+            {
+                throw std::runtime_error("OpenGL error in " + std::string(operation) + ": " + message);
+            }
+            return;
+        }
+#endif
         GLenum error = glGetError();
         if (error != GL_NO_ERROR)
         {
@@ -0,0 +1,118 @@
+/**
+ * @file GLDebug.cpp
+ * @brief Implementation of the KHR_debug message callback.
+ */
+
+#include "GLDebug.h"
+
+extern "C"
+{
+#include <glad/glad.h>
+}
+
+#include <iostream>
+#include <mutex>
+#include <unordered_set>
+
+namespace gfx
+{
+
+    namespace
+    {
+        constexpr std::size_t kMaxLoggedIds = 256; ///< Distinct warnings logged before going quiet.
+
+        bool active = false;
+
+        // The callback may run on a driver thread if synchronous output is unavailable
+        std::mutex mutex;
+        bool errorPending = false;
+        std::string pendingError;
+        std::unordered_set<GLuint> loggedIds;
+
+        const char *typeName(GLenum type)
+        {
+            switch (type)
+            {
+            case GL_DEBUG_TYPE_ERROR:
+                return "error";
+            case GL_DEBUG_TYPE_DEPRECATED_BEHAVIOR:
+                return "deprecated";
+            case GL_DEBUG_TYPE_UNDEFINED_BEHAVIOR:
+                return "undefined behavior";
+            case GL_DEBUG_TYPE_PORTABILITY:
+                return "portability";
+            case GL_DEBUG_TYPE_PERFORMANCE:
+                return "performance";
+            default:
+                return "other";
+            }
+        }
+
+        void APIENTRY onDebugMessage(GLenum /*source*/, GLenum type, GLuint id, GLenum severity,
+                                     GLsizei length, const GLchar *message, const void * /*userParam*/)
+        {
+            if (severity == GL_DEBUG_SEVERITY_NOTIFICATION)
+            {
+                return;
+            }
+            const std::string text = length >= 0 ? std::string(message, static_cast<std::size_t>(length))
+                                                 : std::string(message);
+
+            std::lock_guard<std::mutex> lock(mutex);
+            if (type == GL_DEBUG_TYPE_ERROR)
+            {
+                // Only the first one: later errors are usually fallout from it
+                if (!errorPending)
+                {
+                    errorPending = true;
+                    pendingError = text;
+                }
+                return;
+            }
+
+            if (loggedIds.size() < kMaxLoggedIds && loggedIds.insert(id).second)
+            {
+                std::cerr << "[GLDebug] " << typeName(type) << " (" << id << "): " << text << std::endl;
+            }
+        }
+    }
+
+    bool installDebugOutput()
+    {
+        GLint flags = 0;
+        glGetIntegerv(GL_CONTEXT_FLAGS, &flags);
+        if (!glDebugMessageCallback || !(flags & GL_CONTEXT_FLAG_DEBUG_BIT))
+        {
+            std::cerr << "[GLDebug] No debug context; falling back to glGetError checks" << std::endl;
+            return false;
+        }
+
+        glEnable(GL_DEBUG_OUTPUT);
+        // Report errors from inside the offending call so checkGLError blames the right block
+        glEnable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
+        glDebugMessageCallback(&onDebugMessage, nullptr);
+        glDebugMessageControl(GL_DONT_CARE, GL_DONT_CARE, GL_DEBUG_SEVERITY_NOTIFICATION, 0, nullptr, GL_FALSE);
+        active = true;
+        std::cout << "[GLDebug] KHR_debug output enabled" << std::endl;
+        return true;
+    }
+
+    bool debugOutputActive()
+    {
+        return active;
+    }
+
+    bool takeDebugError(std::string &message)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!errorPending)
+        {
+            return false;
+        }
+        message.swap(pendingError);
+        pendingError.clear();
+        errorPending = false;
+        return true;
+    }
+
+} // namespace gfx
@@ -0,0 +1,35 @@
+/**
+ * @file GLDebug.h
+ * @brief KHR_debug message callback used instead of glGetError polling.
+ *
+ * Built with `FLIGHTSIM_GL_DEBUG` (`make GL_DEBUG=1`) the window asks for a
+ * debug context and `installDebugOutput()` registers a message callback.
+ * Errors reported by the driver are kept until the next `checkGLError`,
+ * which then throws exactly as the polling version did, but without the
+ * `glGetError` round trip. Performance and portability warnings are logged
+ * once per message id.
+ */
+
+#pragma once
+
+#include <string>
+
+namespace gfx
+{
+
+    /**
+     * @brief Registers the debug callback if the context supports it.
+     * @return false when debug output is unavailable (checkGLError keeps polling).
+     */
+    bool installDebugOutput();
+
+    /// True once the callback is registered.
+    bool debugOutputActive();
+
+    /**
+     * @brief Hands over the first error reported since the last call.
+     * @return false if the driver reported no error.
+     */
+    bool takeDebugError(std::string &message);
+
+} // namespace gfx
@@ -0,0 +1,284 @@
+/**
+ * @file GLStats.cpp
+ * @brief Counting wrappers around the glad function pointers.
+ */
+
+#include "GLStats.h"
+
+extern "C"
+{
+#include <glad/glad.h>
+}
+
+#include <iostream>
+
+namespace gfx
+{
+
+#ifdef FLIGHTSIM_GL_STATS
+
+    namespace
+    {
+        constexpr int kTextureUnits = 32;
+        constexpr int kTextureTargets = 4; ///< 2D, cube map, 2D array, 3D; other targets are counted but not shadowed.
+
+        GLCallCounters counters;
+
+        // Shadow of the bindings, valid from a fresh context (everything 0, unit 0)
+        GLuint boundProgram = 0;
+        GLuint boundVao = 0;
+        GLuint activeUnit = 0;
+        GLuint boundTextures[kTextureUnits][kTextureTargets] = {};
+
+        // Driver entry points the wrappers forward to
+        PFNGLDRAWARRAYSPROC realDrawArrays = nullptr;
+        PFNGLDRAWELEMENTSPROC realDrawElements = nullptr;
+        PFNGLDRAWARRAYSINSTANCEDPROC realDrawArraysInstanced = nullptr;
+        PFNGLDRAWELEMENTSINSTANCEDPROC realDrawElementsInstanced = nullptr;
+        PFNGLBUFFERDATAPROC realBufferData = nullptr;
+        PFNGLBUFFERSUBDATAPROC realBufferSubData = nullptr;
+        PFNGLACTIVETEXTUREPROC realActiveTexture = nullptr;
+        PFNGLBINDTEXTUREPROC realBindTexture = nullptr;
+        PFNGLDELETETEXTURESPROC realDeleteTextures = nullptr;
+        PFNGLUSEPROGRAMPROC realUseProgram = nullptr;
+        PFNGLBINDVERTEXARRAYPROC realBindVertexArray = nullptr;
+        PFNGLDELETEVERTEXARRAYSPROC realDeleteVertexArrays = nullptr;
+        PFNGLUNIFORM1IPROC realUniform1i = nullptr;
+        PFNGLUNIFORM1FPROC realUniform1f = nullptr;
+        PFNGLUNIFORM3FVPROC realUniform3fv = nullptr;
+        PFNGLUNIFORM4FVPROC realUniform4fv = nullptr;
+        PFNGLUNIFORMMATRIX4FVPROC realUniformMatrix4fv = nullptr;
+
+        int textureTargetSlot(GLenum target)
+        {
+            switch (target)
+            {
+            case GL_TEXTURE_2D:
+                return 0;
+            case GL_TEXTURE_CUBE_MAP:
+                return 1;
+            case GL_TEXTURE_2D_ARRAY:
+                return 2;
+            case GL_TEXTURE_3D:
+                return 3;
+            default:
+                return -1;
+            }
+        }
+
+        void countDraw(GLsizei count, GLsizei instances)
+        {
+            counters.drawCalls++;
+            if (count > 0 && instances > 0)
+            {
+                counters.vertices += static_cast<uint64_t>(count) * static_cast<uint64_t>(instances);
+            }
+        }
+
+        void APIENTRY drawArrays(GLenum mode, GLint first, GLsizei count)
+        {
+            countDraw(count, 1);
+            realDrawArrays(mode, first, count);
+        }
+
+        void APIENTRY drawElements(GLenum mode, GLsizei count, GLenum type, const void *indices)
+        {
+            countDraw(count, 1);
+            realDrawElements(mode, count, type, indices);
+        }
+
+        void APIENTRY drawArraysInstanced(GLenum mode, GLint first, GLsizei count, GLsizei instances)
+        {
+            countDraw(count, instances);
+            realDrawArraysInstanced(mode, first, count, instances);
+        }
+
+        void APIENTRY drawElementsInstanced(GLenum mode, GLsizei count, GLenum type, const void *indices,
+                                            GLsizei instances)
+        {
+            countDraw(count, instances);
+            realDrawElementsInstanced(mode, count, type, indices, instances);
+        }
+
+        void APIENTRY bufferData(GLenum target, GLsizeiptr size, const void *data, GLenum usage)
+        {
+            // Orphaning (data == nullptr) allocates but uploads nothing
+            if (data && size > 0)
+            {
+                counters.bufferBytes += static_cast<uint64_t>(size);
+            }
+            realBufferData(target, size, data, usage);
+        }
+
+        void APIENTRY bufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void *data)
+        {
+            if (size > 0)
+            {
+                counters.bufferBytes += static_cast<uint64_t>(size);
+            }
+            realBufferSubData(target, offset, size, data);
+        }
+
+        void APIENTRY activeTexture(GLenum texture)
+        {
+            activeUnit = texture - GL_TEXTURE0;
+            realActiveTexture(texture);
+        }
+
+        void APIENTRY bindTexture(GLenum target, GLuint texture)
+        {
+            counters.textureBinds++;
+            const int slot = textureTargetSlot(target);
+            if (slot >= 0 && activeUnit < static_cast<GLuint>(kTextureUnits))
+            {
+                GLuint &bound = boundTextures[activeUnit][slot];
+                if (bound == texture)
+                {
+                    counters.redundantBinds++;
+                }
+                bound = texture;
+            }
+            realBindTexture(target, texture);
+        }
+
+        void APIENTRY deleteTextures(GLsizei n, const GLuint *textures)
+        {
+            // Deleting a bound texture reverts that binding to 0
+            for (GLsizei i = 0; i < n; ++i)
+            {
+                for (auto &unit : boundTextures)
+                {
+                    for (GLuint &bound : unit)
+                    {
+                        if (bound == textures[i])
+                        {
+                            bound = 0;
+                        }
+                    }
+                }
+            }
+            realDeleteTextures(n, textures);
+        }
+
+        void APIENTRY useProgram(GLuint program)
+        {
+            counters.programBinds++;
+            if (program == boundProgram)
+            {
+                counters.redundantBinds++;
+            }
+            boundProgram = program;
+            realUseProgram(program);
+        }
+
+        void APIENTRY bindVertexArray(GLuint array)
+        {
+            counters.vaoBinds++;
+            if (array == boundVao)
+            {
+                counters.redundantBinds++;
+            }
+            boundVao = array;
+            realBindVertexArray(array);
+        }
+
+        void APIENTRY deleteVertexArrays(GLsizei n, const GLuint *arrays)
+        {
+            for (GLsizei i = 0; i < n; ++i)
+            {
+                if (arrays[i] == boundVao)
+                {
+                    boundVao = 0;
+                }
+            }
+            realDeleteVertexArrays(n, arrays);
+        }
+
+        void APIENTRY uniform1i(GLint location, GLint v0)
+        {
+            counters.uniformUploads++;
+            realUniform1i(location, v0);
+        }
+
+        void APIENTRY uniform1f(GLint location, GLfloat v0)
+        {
+            counters.uniformUploads++;
+            realUniform1f(location, v0);
+        }
+
+        void APIENTRY uniform3fv(GLint location, GLsizei count, const GLfloat *value)
+        {
+            counters.uniformUploads++;
+            realUniform3fv(location, count, value);
+        }
+
+        void APIENTRY uniform4fv(GLint location, GLsizei count, const GLfloat *value)
+        {
+            counters.uniformUploads++;
+            realUniform4fv(location, count, value);
+        }
+
+        void APIENTRY uniformMatrix4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value)
+        {
+            counters.uniformUploads++;
+            realUniformMatrix4fv(location, count, transpose, value);
+        }
+
+        /// Saves the driver pointer and puts the wrapper in its place (left alone if not loaded).
+        template <typename Proc>
+        void wrap(Proc &gladPointer, Proc &real, Proc wrapper)
+        {
+            if (gladPointer)
+            {
+                real = gladPointer;
+                gladPointer = wrapper;
+            }
+        }
+    }
+
+    void GLStats::install()
+    {
+        static bool installed = false;
+        if (installed)
+        {
+            return;
+        }
+        installed = true;
+
+        wrap(glad_glDrawArrays, realDrawArrays, &drawArrays);
+        wrap(glad_glDrawElements, realDrawElements, &drawElements);
+        wrap(glad_glDrawArraysInstanced, realDrawArraysInstanced, &drawArraysInstanced);
+        wrap(glad_glDrawElementsInstanced, realDrawElementsInstanced, &drawElementsInstanced);
+        wrap(glad_glBufferData, realBufferData, &bufferData);
+        wrap(glad_glBufferSubData, realBufferSubData, &bufferSubData);
+        wrap(glad_glActiveTexture, realActiveTexture, &activeTexture);
+        wrap(glad_glBindTexture, realBindTexture, &bindTexture);
+        wrap(glad_glDeleteTextures, realDeleteTextures, &deleteTextures);
+        wrap(glad_glUseProgram, realUseProgram, &useProgram);
+        wrap(glad_glBindVertexArray, realBindVertexArray, &bindVertexArray);
+        wrap(glad_glDeleteVertexArrays, realDeleteVertexArrays, &deleteVertexArrays);
+        wrap(glad_glUniform1i, realUniform1i, &uniform1i);
+        wrap(glad_glUniform1f, realUniform1f, &uniform1f);
+        wrap(glad_glUniform3fv, realUniform3fv, &uniform3fv);
+        wrap(glad_glUniform4fv, realUniform4fv, &uniform4fv);
+        wrap(glad_glUniformMatrix4fv, realUniformMatrix4fv, &uniformMatrix4fv);
+        std::cout << "[GLStats] Counting draws, uploads and binds" << std::endl;
+    }
+
+    GLCallCounters GLStats::snapshot()
+    {
+        return counters;
+    }
+
+#else
+
+    void GLStats::install() {}
+
+    GLCallCounters GLStats::snapshot()
+    {
+        return {};
+    }
+
+#endif
+
+} // namespace gfx
@@ -0,0 +1,88 @@
+/**
+ * @file GLStats.h
+ * @brief Optional GL call interception that counts draws, uploads and binds.
+ *
+ * When the project is compiled with `FLIGHTSIM_GL_STATS` defined
+ * (`make GL_STATS=1`), `GLStats::install()` swaps a handful of glad function
+ * pointers (draws, buffer uploads, texture/program/VAO binds, uniforms) for
+ * wrappers that bump counters and forward to the driver. The wrappers keep a
+ * shadow of the bound objects, so binding what is already bound is counted
+ * as redundant. In regular builds nothing is swapped and every query
+ * returns zero.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+namespace gfx
+{
+
+    /**
+     * @brief Monotonic counters since `GLStats::install()`.
+     *
+     * Take two snapshots and subtract them to measure a region (e.g. one frame).
+     */
+    struct GLCallCounters
+    {
+        uint64_t drawCalls = 0;         ///< glDraw* calls.
+        uint64_t vertices = 0;          ///< Vertices (or indices) submitted, times instances.
+        uint64_t bufferBytes = 0;       ///< Bytes passed to glBufferData/glBufferSubData.
+        uint64_t textureBinds = 0;      ///< glBindTexture calls.
+        uint64_t programBinds = 0;      ///< glUseProgram calls.
+        uint64_t vaoBinds = 0;          ///< glBindVertexArray calls.
+        uint64_t redundantBinds = 0;    ///< Binds of the object that was already bound (any of the three).
+        uint64_t uniformUploads = 0;    ///< glUniform* calls.
+
+        GLCallCounters operator-(const GLCallCounters &rhs) const
+        {
+            return {drawCalls - rhs.drawCalls,
+                    vertices - rhs.vertices,
+                    bufferBytes - rhs.bufferBytes,
+                    textureBinds - rhs.textureBinds,
+                    programBinds - rhs.programBinds,
+                    vaoBinds - rhs.vaoBinds,
+                    redundantBinds - rhs.redundantBinds,
+                    uniformUploads - rhs.uniformUploads};
+        }
+
+        GLCallCounters &operator+=(const GLCallCounters &rhs)
+        {
+            drawCalls += rhs.drawCalls;
+            vertices += rhs.vertices;
+            bufferBytes += rhs.bufferBytes;
+            textureBinds += rhs.textureBinds;
+            programBinds += rhs.programBinds;
+            vaoBinds += rhs.vaoBinds;
+            redundantBinds += rhs.redundantBinds;
+            uniformUploads += rhs.uniformUploads;
+            return *this;
+        }
+    };
+
+    /**
+     * @brief Installs the counting wrappers and reads their counters.
+     *
+     * GL thread only, like the calls it counts.
+     */
+    class GLStats
+    {
+    public:
+        /// True when the interception layer is compiled in.
+        static constexpr bool enabled()
+        {
+#ifdef FLIGHTSIM_GL_STATS
+            return true;
+#else
+            return false;
+#endif
+        }
+
+        /// Wraps the glad pointers; call once, right after gladLoadGLLoader.
+        static void install();
+
+        /// Current counter values.
+        static GLCallCounters snapshot();
+    };
+
+} // namespace gfx
@@ -0,0 +1,239 @@
+/**
+ * @file ProgramBinaryCache.cpp
+ * @brief Implementation of the program binary cache.
+ */
+
+#include "ProgramBinaryCache.h"
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+namespace gfx
+{
+
+    namespace
+    {
+        constexpr char CACHE_MAGIC[8] = {'F', 'S', 'P', 'R', 'O', 'G', '\0', '\0'};
+        constexpr uint32_t CACHE_VERSION = 1;
+
+        /// Fixed header in front of the driver's blob.
+        struct CacheHeader
+        {
+            char magic[8];       ///< "FSPROG\0\0"
+            uint32_t version;    ///< CACHE_VERSION
+            uint32_t format;     ///< binaryFormat returned by glGetProgramBinary.
+            uint64_t driverHash; ///< Hash of vendor/renderer/version (guards against name collisions).
+            uint64_t sourceHash; ///< Hash of both stages.
+            uint32_t length;     ///< Bytes of binary that follow.
+            uint32_t reserved;
+        };
+
+        enum class Support
+        {
+            Unknown,
+            Available,
+            Unavailable
+        };
+
+        std::string cacheDirectory = "shader_cache";
+        Support support = Support::Unknown;
+        uint64_t driverHash = 0;
+        ProgramCacheStats totals;
+
+        const char *glString(GLenum name)
+        {
+            const GLubyte *value = glGetString(name);
+            return value ? reinterpret_cast<const char *>(value) : "";
+        }
+
+        /// Asks the driver once whether it can hand out binaries, and hashes its identity.
+        bool available()
+        {
+            if (support == Support::Unknown)
+            {
+                GLint formats = 0;
+                glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+                support = (formats > 0 && glGetProgramBinary && glProgramBinary) ? Support::Available
+                                                                                  : Support::Unavailable;
+                driverHash = ProgramBinaryCache::hash(glString(GL_VENDOR));
+                driverHash = ProgramBinaryCache::hash(glString(GL_RENDERER), driverHash);
+                driverHash = ProgramBinaryCache::hash(glString(GL_VERSION), driverHash);
+                if (support == Support::Unavailable)
+                {
+                    std::cout << "[ProgramBinaryCache] Driver exposes no program binary formats; cache off"
+                              << std::endl;
+                }
+            }
+            return support == Support::Available;
+        }
+
+        uint64_t sourceHash(const std::string &vsSource, const std::string &fsSource)
+        {
+            // The separator keeps "ab" + "c" and "a" + "bc" apart
+            return ProgramBinaryCache::hash(fsSource, ProgramBinaryCache::hash(vsSource) ^ 0x9e3779b97f4a7c15ull);
+        }
+
+        std::string cachePath(uint64_t sources)
+        {
+            char name[40];
+            std::snprintf(name, sizeof(name), "%016llx%016llx.bin",
+                          static_cast<unsigned long long>(sources), static_cast<unsigned long long>(driverHash));
+            return cacheDirectory + "/" + name;
+        }
+    }
+
+    void ProgramBinaryCache::setDirectory(const std::string &directory)
+    {
+        cacheDirectory = directory;
+    }
+
+    GLuint ProgramBinaryCache::load(const std::string &vsSource, const std::string &fsSource)
+    {
+        if (!available())
+        {
+            return 0;
+        }
+
+        const uint64_t sources = sourceHash(vsSource, fsSource);
+        const std::string path = cachePath(sources);
+        std::ifstream file(path, std::ios::binary);
+        if (!file)
+        {
+            totals.misses++;
+            return 0;
+        }
+
+        CacheHeader header{};
+        std::vector<char> binary;
+        bool valid = file.read(reinterpret_cast<char *>(&header), sizeof(header)) &&
+                     std::memcmp(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) == 0 &&
+                     header.version == CACHE_VERSION && header.driverHash == driverHash &&
+                     header.sourceHash == sources && header.length > 0;
+        if (valid)
+        {
+            // The length comes from disk: it must match what is actually left before anything is allocated
+            std::error_code sizeError;
+            const uintmax_t fileSize = std::filesystem::file_size(path, sizeError);
+            valid = !sizeError && fileSize >= sizeof(header) && header.length == fileSize - sizeof(header);
+        }
+        if (valid)
+        {
+            binary.resize(header.length);
+            valid = static_cast<bool>(file.read(binary.data(), static_cast<std::streamsize>(binary.size())));
+        }
+        file.close();
+
+        GLuint program = 0;
+        if (valid)
+        {
+            program = glCreateProgram();
+            glProgramBinary(program, header.format, binary.data(), static_cast<GLsizei>(binary.size()));
+            GLint linked = GL_FALSE;
+            glGetProgramiv(program, GL_LINK_STATUS, &linked);
+            if (!linked)
+            {
+                glDeleteProgram(program);
+                program = 0;
+            }
+        }
+
+        if (!program)
+        {
+            // Truncated, from another build of the driver, ...: drop it and compile from source
+            std::error_code error;
+            std::filesystem::remove(path, error);
+            totals.rejected++;
+            return 0;
+        }
+        totals.hits++;
+        return program;
+    }
+
+    void ProgramBinaryCache::prepare(GLuint program)
+    {
+        if (available())
+        {
+            glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+        }
+    }
+
+    void ProgramBinaryCache::store(GLuint program, const std::string &vsSource, const std::string &fsSource)
+    {
+        if (!available())
+        {
+            return;
+        }
+
+        GLint length = 0;
+        glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+        if (length <= 0)
+        {
+            return;
+        }
+        std::vector<char> binary(static_cast<size_t>(length));
+        GLenum format = 0;
+        GLsizei written = 0;
+        glGetProgramBinary(program, length, &written, &format, binary.data());
+        if (written <= 0)
+        {
+            return;
+        }
+
+        std::error_code error;
+        std::filesystem::create_directories(cacheDirectory, error);
+        if (error)
+        {
+            return;
+        }
+
+        CacheHeader header{};
+        std::memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+        header.version = CACHE_VERSION;
+        header.format = format;
+        header.driverHash = driverHash;
+        header.sourceHash = sourceHash(vsSource, fsSource);
+        header.length = static_cast<uint32_t>(written);
+
+        // Written aside and renamed, so a crash never leaves a half file under the real name
+        const std::string path = cachePath(header.sourceHash);
+        const std::string partial = path + ".tmp";
+        {
+            std::ofstream file(partial, std::ios::binary | std::ios::trunc);
+            if (!file.write(reinterpret_cast<const char *>(&header), sizeof(header)) ||
+                !file.write(binary.data(), written))
+            {
+                file.close();
+                std::filesystem::remove(partial, error);
+                return;
+            }
+        }
+        std::filesystem::rename(partial, path, error);
+        if (error)
+        {
+            std::filesystem::remove(partial, error);
+            return;
+        }
+        totals.stored++;
+    }
+
+    ProgramCacheStats ProgramBinaryCache::stats()
+    {
+        return totals;
+    }
+
+    uint64_t ProgramBinaryCache::hash(const std::string &text, uint64_t seed)
+    {
+        uint64_t value = seed;
+        for (unsigned char c : text)
+        {
+            value ^= c;
+            value *= 0x100000001b3ull;
+        }
+        return value;
+    }
+
+} // namespace gfx
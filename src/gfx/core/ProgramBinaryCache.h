@@ -0,0 +1,66 @@
+/**
+ * @file ProgramBinaryCache.h
+ * @brief On-disk cache of linked program binaries (glGetProgramBinary/glProgramBinary).
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+extern "C"
+{
+#include <glad/glad.h>
+}
+
+namespace gfx
+{
+
+    /**
+     * @brief Counters since startup.
+     */
+    struct ProgramCacheStats
+    {
+        uint32_t hits = 0;     ///< Programs restored from a cached binary.
+        uint32_t misses = 0;   ///< No usable file for the sources/driver.
+        uint32_t rejected = 0; ///< Files the driver refused (deleted, recompiled from source).
+        uint32_t stored = 0;   ///< Binaries written after a source compile.
+    };
+
+    /**
+     * @brief Saves linked programs under `shader_cache/` and restores them on later runs.
+     *
+     * Files are named after a hash of both stage sources and the driver
+     * string (vendor, renderer, version), so editing a shader or updating the
+     * driver simply misses. The driver may still refuse a binary (format
+     * changes within the same version string); the file is then removed and
+     * the caller compiles from source as if there had been no cache.
+     * Disabled when the driver exposes no binary formats. GL thread only.
+     */
+    class ProgramBinaryCache
+    {
+    public:
+        /// Directory for the cache files (default `shader_cache`).
+        static void setDirectory(const std::string &directory);
+
+        /// Links a program from a cached binary of these sources; 0 if there is none usable.
+        static GLuint load(const std::string &vsSource, const std::string &fsSource);
+
+        /**
+         * @brief Writes the binary of `program`, just linked from these sources.
+         *
+         * The program must have been linked with GL_PROGRAM_BINARY_RETRIEVABLE_HINT
+         * (see `prepare`). Failures only cost the next run a compile.
+         */
+        static void store(GLuint program, const std::string &vsSource, const std::string &fsSource);
+
+        /// Sets the retrievable hint on a program about to be linked (when the cache is usable).
+        static void prepare(GLuint program);
+
+        static ProgramCacheStats stats();
+
+        /// FNV-1a 64 of `text`, chained through `seed`.
+        static uint64_t hash(const std::string &text, uint64_t seed = 0xcbf29ce484222325ull);
+    };
+
+} // namespace gfx
@@ -0,0 +1,247 @@
+/**
+ * @file RenderState.cpp
+ * @brief Implementation of the GL state cache.
+ */
+
+#include "RenderState.h"
+
+namespace gfx
+{
+
+    namespace
+    {
+        constexpr GLuint kUnknown = 0xFFFFFFFFu; ///< Never a valid object name or enum.
+        constexpr int kUnknownFlag = -1;
+        constexpr int kTextureTargets = 2; ///< 2D and cube map; other targets are always forwarded.
+
+        struct CachedState
+        {
+            GLuint program = kUnknown;
+            GLuint vao = kUnknown;
+            GLuint activeUnit = kUnknown;
+            GLuint textures[RenderState::kTextureUnits][kTextureTargets];
+            int blend = kUnknownFlag;
+            GLenum blendFunc[4] = {kUnknown, kUnknown, kUnknown, kUnknown};
+            int depthTest = kUnknownFlag;
+            GLenum depthFunc = kUnknown;
+            int depthMask = kUnknownFlag;
+            int cullFace = kUnknownFlag;
+            int primitiveRestart = kUnknownFlag;
+            GLuint restartIndex = kUnknown;
+
+            CachedState()
+            {
+                for (auto &unit : textures)
+                {
+                    unit[0] = unit[1] = kUnknown;
+                }
+            }
+        };
+
+        CachedState state;
+        RenderStateCounters totals;
+
+        int textureTargetSlot(GLenum target)
+        {
+            switch (target)
+            {
+            case GL_TEXTURE_2D:
+                return 0;
+            case GL_TEXTURE_CUBE_MAP:
+                return 1;
+            default:
+                return -1;
+            }
+        }
+
+        /// Counts the request; true if `cached` already holds `value` (otherwise stores it).
+        template <typename T>
+        bool matches(T &cached, T value)
+        {
+            totals.requests++;
+            if (cached == value)
+            {
+                totals.skipped++;
+                return true;
+            }
+            cached = value;
+            return false;
+        }
+
+        void setCapability(int &cached, GLenum capability, bool enabled)
+        {
+            if (matches(cached, enabled ? 1 : 0))
+            {
+                return;
+            }
+            if (enabled)
+            {
+                glEnable(capability);
+            }
+            else
+            {
+                glDisable(capability);
+            }
+        }
+    }
+
+    void RenderState::useProgram(GLuint program)
+    {
+        if (!matches(state.program, program))
+        {
+            glUseProgram(program);
+        }
+    }
+
+    void RenderState::bindVertexArray(GLuint vao)
+    {
+        if (!matches(state.vao, vao))
+        {
+            glBindVertexArray(vao);
+        }
+    }
+
+    void RenderState::bindTexture(GLuint unit, GLenum target, GLuint texture)
+    {
+        if (!matches(state.activeUnit, unit))
+        {
+            glActiveTexture(GL_TEXTURE0 + unit);
+        }
+
+        const int slot = textureTargetSlot(target);
+        if (slot < 0 || unit >= kTextureUnits)
+        {
+            totals.requests++;
+            glBindTexture(target, texture);
+            return;
+        }
+        if (!matches(state.textures[unit][slot], texture))
+        {
+            glBindTexture(target, texture);
+        }
+    }
+
+    void RenderState::setBlend(bool enabled)
+    {
+        setCapability(state.blend, GL_BLEND, enabled);
+    }
+
+    void RenderState::setBlendFunc(GLenum src, GLenum dst)
+    {
+        setBlendFuncSeparate(src, dst, src, dst);
+    }
+
+    void RenderState::setBlendFuncSeparate(GLenum srcRgb, GLenum dstRgb, GLenum srcAlpha, GLenum dstAlpha)
+    {
+        totals.requests++;
+        GLenum *cached = state.blendFunc;
+        if (cached[0] == srcRgb && cached[1] == dstRgb && cached[2] == srcAlpha && cached[3] == dstAlpha)
+        {
+            totals.skipped++;
+            return;
+        }
+        cached[0] = srcRgb;
+        cached[1] = dstRgb;
+        cached[2] = srcAlpha;
+        cached[3] = dstAlpha;
+        if (srcRgb == srcAlpha && dstRgb == dstAlpha)
+        {
+            glBlendFunc(srcRgb, dstRgb);
+        }
+        else
+        {
+            glBlendFuncSeparate(srcRgb, dstRgb, srcAlpha, dstAlpha);
+        }
+    }
+
+    void RenderState::setDepthTest(bool enabled)
+    {
+        setCapability(state.depthTest, GL_DEPTH_TEST, enabled);
+    }
+
+    void RenderState::setDepthFunc(GLenum func)
+    {
+        if (!matches(state.depthFunc, func))
+        {
+            glDepthFunc(func);
+        }
+    }
+
+    void RenderState::setDepthMask(bool enabled)
+    {
+        if (!matches(state.depthMask, enabled ? 1 : 0))
+        {
+            glDepthMask(enabled ? GL_TRUE : GL_FALSE);
+        }
+    }
+
+    void RenderState::setCullFace(bool enabled)
+    {
+        setCapability(state.cullFace, GL_CULL_FACE, enabled);
+    }
+
+    void RenderState::setPrimitiveRestart(bool enabled)
+    {
+        setCapability(state.primitiveRestart, GL_PRIMITIVE_RESTART, enabled);
+    }
+
+    void RenderState::setPrimitiveRestartIndex(GLuint index)
+    {
+        if (!matches(state.restartIndex, index))
+        {
+            glPrimitiveRestartIndex(index);
+        }
+    }
+
+    bool RenderState::depthTest()
+    {
+        if (state.depthTest == kUnknownFlag)
+        {
+            state.depthTest = glIsEnabled(GL_DEPTH_TEST) ? 1 : 0;
+        }
+        return state.depthTest == 1;
+    }
+
+    void RenderState::forgetProgram(GLuint program)
+    {
+        if (state.program == program)
+        {
+            state.program = kUnknown;
+        }
+    }
+
+    void RenderState::forgetVertexArray(GLuint vao)
+    {
+        // Deleting the bound VAO reverts the binding to 0
+        if (state.vao == vao)
+        {
+            state.vao = 0;
+        }
+    }
+
+    void RenderState::forgetTexture(GLuint texture)
+    {
+        // Same for textures, on every unit it was bound to
+        for (auto &unit : state.textures)
+        {
+            for (GLuint &bound : unit)
+            {
+                if (bound == texture)
+                {
+                    bound = 0;
+                }
+            }
+        }
+    }
+
+    void RenderState::invalidate()
+    {
+        state = CachedState{};
+    }
+
+    RenderStateCounters RenderState::counters()
+    {
+        return totals;
+    }
+
+} // namespace gfx
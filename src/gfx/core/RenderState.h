@@ -0,0 +1,81 @@
+/**
+ * @file RenderState.h
+ * @brief Shadow copy of the GL state the renderers toggle, so redundant changes are skipped.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+extern "C"
+{
+#include <glad/glad.h>
+}
+
+namespace gfx
+{
+
+    /**
+     * @brief Monotonic counters of the state cache.
+     *
+     * Take two snapshots and subtract them to measure a region (e.g. one frame).
+     */
+    struct RenderStateCounters
+    {
+        uint64_t requests = 0; ///< State changes asked of the cache.
+        uint64_t skipped = 0;  ///< Requests that matched the cached state (no GL call issued).
+
+        RenderStateCounters operator-(const RenderStateCounters &rhs) const
+        {
+            return {requests - rhs.requests, skipped - rhs.skipped};
+        }
+    };
+
+    /**
+     * @brief Program, VAO, texture units, blend, depth (test, func, mask), cull and primitive
+     *        restart as last set through this class.
+     *
+     * Every gfx/hud/ui pass sets these through RenderState instead of calling
+     * GL directly; a request matching the cached value is dropped. Passes
+     * still state what they need (blend on, depth off, ...) but no longer
+     * "restore" by unbinding, so consecutive passes with the same needs cost
+     * nothing. Values start unknown and the first request always reaches GL.
+     *
+     * Objects must be forgotten before they are deleted, or a new object
+     * reusing the name would be taken as already bound. GL thread only.
+     */
+    class RenderState
+    {
+    public:
+        static constexpr GLuint kTextureUnits = 16; ///< Units shadowed; higher ones are always forwarded.
+
+        static void useProgram(GLuint program);
+        static void bindVertexArray(GLuint vao);
+        /// Selects `unit` (only if it differs) and binds `texture` to `target` there.
+        static void bindTexture(GLuint unit, GLenum target, GLuint texture);
+
+        static void setBlend(bool enabled);
+        static void setBlendFunc(GLenum src, GLenum dst);
+        static void setBlendFuncSeparate(GLenum srcRgb, GLenum dstRgb, GLenum srcAlpha, GLenum dstAlpha);
+        static void setDepthTest(bool enabled);
+        static void setDepthFunc(GLenum func);
+        static void setDepthMask(bool enabled);
+        static void setCullFace(bool enabled);
+        static void setPrimitiveRestart(bool enabled);
+        static void setPrimitiveRestartIndex(GLuint index);
+
+        /// Cached depth test flag (asks GL once if still unknown).
+        static bool depthTest();
+
+        /// Clear cached bindings of an object about to be deleted.
+        static void forgetProgram(GLuint program);
+        static void forgetVertexArray(GLuint vao);
+        static void forgetTexture(GLuint texture);
+
+        /// Marks everything unknown (after GL calls made behind the cache's back).
+        static void invalidate();
+
+        static RenderStateCounters counters();
+    };
+
+} // namespace gfx
@@ -1,33 +1,319 @@
 #include "Shader.h"
 #include "GLCheck.h"
+#include "ProgramBinaryCache.h"
+
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+#include <unordered_map>
 
 namespace gfx
 {
 
+    namespace
+    {
+        /// A program loaded through loadShared() and how many Shaders hold it.
+        struct SharedProgram
+        {
+            GLuint program = 0;
+            int users = 0;
+        };
+
+        ShaderBuildStats buildTotals;
+
+        std::unordered_map<uint64_t, SharedProgram> &sharedPrograms()
+        {
+            static std::unordered_map<uint64_t, SharedProgram> programs;
+            return programs;
+        }
+
+        /// Paths are part of the key: a hot reload of one file must not touch a copy with another name.
+        uint64_t sharingKey(const std::string &vsPath, const std::string &fsPath, const std::string &defines,
+                            const std::string &vsSource, const std::string &fsSource)
+        {
+            uint64_t key = ProgramBinaryCache::hash(vsPath);
+            key = ProgramBinaryCache::hash(fsPath, key ^ 1);
+            key = ProgramBinaryCache::hash(defines, key ^ 2);
+            key = ProgramBinaryCache::hash(vsSource, key ^ 3);
+            key = ProgramBinaryCache::hash(fsSource, key ^ 4);
+            return key ? key : 1;
+        }
+
+        /// Inserts `defines` right after the `#version` line (which must stay first).
+        std::string withDefines(const std::string &source, const std::string &defines)
+        {
+            if (defines.empty())
+            {
+                return source;
+            }
+            std::string::size_type insertAt = 0;
+            std::string::size_type version = source.find("#version");
+            if (version != std::string::npos)
+            {
+                std::string::size_type lineEnd = source.find('\n', version);
+                insertAt = lineEnd == std::string::npos ? source.size() : lineEnd + 1;
+            }
+            std::string result;
+            result.reserve(source.size() + defines.size() + 1);
+            result.append(source, 0, insertAt);
+            if (insertAt > 0 && source[insertAt - 1] != '\n')
+            {
+                result += '\n';
+            }
+            result += defines;
+            result.append(source, insertAt, std::string::npos);
+            return result;
+        }
+    }
+
     ////////////////////////////////////////////////////////////////////////////
     //  Program Initialization
     ////////////////////////////////////////////////////////////////////////////
 
-    void Shader::load(const char *vsPath, const char *fsPath)
+    Shader::~Shader()
+    {
+        auto &shaders = loadedShaders();
+        shaders.erase(std::remove(shaders.begin(), shaders.end(), this), shaders.end());
+        releaseProgram();
+    }
+
+    Shader::Shader(Shader &&other) noexcept
+    {
+        *this = std::move(other);
+    }
+
+    Shader &Shader::operator=(Shader &&other) noexcept
+    {
+        if (this != &other)
+        {
+            releaseProgram();
+            prog_ = other.prog_;
+            sharedKey_ = other.sharedKey_;
+            other.prog_ = 0;
+            other.sharedKey_ = 0;
+            vsPath_ = std::move(other.vsPath_);
+            fsPath_ = std::move(other.fsPath_);
+            vsSource_ = std::move(other.vsSource_);
+            fsSource_ = std::move(other.fsSource_);
+            defines_ = std::move(other.defines_);
+            uniformBlocks_ = std::move(other.uniformBlocks_);
+
+            // The reload list follows the program, not the object
+            auto &shaders = loadedShaders();
+            shaders.erase(std::remove(shaders.begin(), shaders.end(), this), shaders.end());
+            std::replace(shaders.begin(), shaders.end(), &other, this);
+        }
+        return *this;
+    }
+
+    void Shader::load(const char *vsPath, const char *fsPath, const std::string &defines)
+    {
+        loadProgram(vsPath, fsPath, defines, false);
+    }
+
+    void Shader::loadShared(const char *vsPath, const char *fsPath, const std::string &defines)
     {
+        loadProgram(vsPath, fsPath, defines, true);
+    }
+
+    void Shader::loadProgram(const char *vsPath, const char *fsPath, const std::string &defines, bool shared)
+    {
+        auto start = std::chrono::steady_clock::now();
+
         // 1) Get source code from disk (throws on I/O error).
         std::string vertexCode = readFile(vsPath);
         std::string fragmentCode = readFile(fsPath);
 
-        // 2) Compile each pipeline stage.
-        GLuint vertex = compileShader(vertexCode, GL_VERTEX_SHADER);
-        GLuint fragment = compileShader(fragmentCode, GL_FRAGMENT_SHADER);
+        // 2) Reuse an identical shared program, or build one (cache or compile; throws on error).
+        GLuint program = 0;
+        uint64_t key = 0;
+        if (shared)
+        {
+            key = sharingKey(vsPath, fsPath, defines, vertexCode, fragmentCode);
+            auto it = sharedPrograms().find(key);
+            if (it != sharedPrograms().end())
+            {
+                program = it->second.program;
+                it->second.users++;
+                buildTotals.shared++;
+            }
+        }
+        if (!program)
+        {
+            std::string log;
+            program = buildProgram(vertexCode, fragmentCode, defines, log);
+            if (!program)
+            {
+                throw std::runtime_error(log);
+            }
+            if (shared)
+            {
+                sharedPrograms()[key] = SharedProgram{program, 1};
+            }
+        }
 
-        // 3) Create program, attach stages, and link.
-        prog_ = glCreateProgram();
-        glAttachShader(prog_, vertex);
-        glAttachShader(prog_, fragment);
-        glLinkProgram(prog_);
-        checkCompileErrors(prog_, "PROGRAM");
+        // 3) Keep the program and the sources it was built from.
+        releaseProgram();
+        prog_ = program;
+        sharedKey_ = key;
+        vsPath_ = vsPath;
+        fsPath_ = fsPath;
+        vsSource_ = std::move(vertexCode);
+        fsSource_ = std::move(fragmentCode);
+        defines_ = defines;
 
-        // 4) Store only the final program; independent stages are discarded.
-        glDeleteShader(vertex);
-        glDeleteShader(fragment);
+        auto &shaders = loadedShaders();
+        if (std::find(shaders.begin(), shaders.end(), this) == shaders.end())
+        {
+            shaders.push_back(this);
+        }
+
+        buildTotals.programs++;
+        buildTotals.ms += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    void Shader::releaseProgram()
+    {
+        if (!prog_)
+        {
+            return;
+        }
+        if (sharedKey_)
+        {
+            auto &programs = sharedPrograms();
+            auto it = programs.find(sharedKey_);
+            sharedKey_ = 0;
+            if (it != programs.end() && --it->second.users > 0)
+            {
+                prog_ = 0;
+                return;
+            }
+            if (it != programs.end())
+            {
+                programs.erase(it);
+            }
+        }
+        RenderState::forgetProgram(prog_);
+        glDeleteProgram(prog_);
+        prog_ = 0;
+    }
+
+    ShaderBuildStats Shader::buildStats()
+    {
+        return buildTotals;
+    }
+
+    bool Shader::bindUniformBlock(const char *blockName, GLuint binding)
+    {
+        GLuint blockIndex = glGetUniformBlockIndex(prog_, blockName);
+        if (blockIndex == GL_INVALID_INDEX)
+        {
+            return false;
+        }
+        glUniformBlockBinding(prog_, blockIndex, binding);
+
+        for (auto &block : uniformBlocks_)
+        {
+            if (block.first == blockName)
+            {
+                block.second = binding;
+                return true;
+            }
+        }
+        uniformBlocks_.emplace_back(blockName, binding);
+        return true;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  Hot Reload
+    ////////////////////////////////////////////////////////////////////////////
+
+    bool Shader::reloadSource(const std::string &path, const std::string &source)
+    {
+        bool ok = true;
+        // Shared programs are rebuilt once; their other users take the result (0: rebuild failed)
+        std::vector<std::pair<GLuint, GLuint>> rebuilt;
+        for (Shader *shader : loadedShaders())
+        {
+            bool vertex = shader->vsPath_ == path;
+            bool fragment = shader->fsPath_ == path;
+            if (!vertex && !fragment)
+            {
+                continue;
+            }
+
+            const GLuint previous = shader->prog_;
+            auto done = std::find_if(rebuilt.begin(), rebuilt.end(),
+                                     [previous](const std::pair<GLuint, GLuint> &entry)
+                                     { return entry.first == previous; });
+            GLuint program = done != rebuilt.end() ? done->second : 0;
+            if (done == rebuilt.end())
+            {
+                // Build next to the live program; swap only if it links
+                std::string log;
+                program = buildProgram(vertex ? source : shader->vsSource_,
+                                       fragment ? source : shader->fsSource_, shader->defines_, log);
+                if (shader->sharedKey_)
+                {
+                    rebuilt.emplace_back(previous, program);
+                }
+                if (!program)
+                {
+                    std::cerr << "[Shader] " << shader->vsPath_ << " + " << shader->fsPath_
+                              << " kept its previous program:\n" << log << std::endl;
+                    ok = false;
+                    continue;
+                }
+                RenderState::forgetProgram(previous);
+                glDeleteProgram(previous);
+            }
+            else if (!program)
+            {
+                continue;
+            }
+
+            shader->prog_ = program;
+            if (vertex)
+                shader->vsSource_ = source;
+            if (fragment)
+                shader->fsSource_ = source;
+            if (shader->sharedKey_)
+            {
+                // The table entry follows the sources; the first user moves it, the others find it moved
+                auto &programs = sharedPrograms();
+                const uint64_t key = sharingKey(shader->vsPath_, shader->fsPath_, shader->defines_,
+                                                shader->vsSource_, shader->fsSource_);
+                auto old = programs.find(shader->sharedKey_);
+                if (old != programs.end())
+                {
+                    SharedProgram entry = old->second;
+                    programs.erase(old);
+                    entry.program = program;
+                    programs[key] = entry;
+                }
+                shader->sharedKey_ = key;
+            }
+            shader->applyUniformBlocks();
+        }
+        return ok;
+    }
+
+    void Shader::applyUniformBlocks() const
+    {
+        for (const auto &block : uniformBlocks_)
+        {
+            GLuint blockIndex = glGetUniformBlockIndex(prog_, block.first.c_str());
+            if (blockIndex != GL_INVALID_INDEX)
+            {
+                glUniformBlockBinding(prog_, blockIndex, block.second);
+            }
+        }
+    }
+
+    std::vector<Shader *> &Shader::loadedShaders()
+    {
+        static std::vector<Shader *> shaders;
+        return shaders;
     }
 
     ////////////////////////////////////////////////////////////////////////////
@@ -102,42 +388,75 @@ namespace gfx
         }
     }
 
-    GLuint Shader::compileShader(const std::string &source, GLenum type)
+    GLuint Shader::buildProgram(const std::string &vsSource, const std::string &fsSource,
+                                const std::string &defines, std::string &log)
     {
-        GLuint shader = glCreateShader(type);
-        const char *src = source.c_str();
-        glShaderSource(shader, 1, &src, nullptr);
-        glCompileShader(shader);
+        const std::string vertexCode = withDefines(vsSource, defines);
+        const std::string fragmentCode = withDefines(fsSource, defines);
+        if (GLuint cached = ProgramBinaryCache::load(vertexCode, fragmentCode))
+        {
+            buildTotals.fromBinary++;
+            return cached;
+        }
 
-        std::string typeStr = (type == GL_VERTEX_SHADER) ? "VERTEX" : "FRAGMENT";
-        checkCompileErrors(shader, typeStr);
+        GLuint vertex = compileShader(vertexCode, GL_VERTEX_SHADER, log);
+        if (!vertex)
+        {
+            return 0;
+        }
+        GLuint fragment = compileShader(fragmentCode, GL_FRAGMENT_SHADER, log);
+        if (!fragment)
+        {
+            glDeleteShader(vertex);
+            return 0;
+        }
 
-        return shader;
-    }
+        // Create program, attach stages, and link.
+        GLuint program = glCreateProgram();
+        glAttachShader(program, vertex);
+        glAttachShader(program, fragment);
+        ProgramBinaryCache::prepare(program);
+        glLinkProgram(program);
 
-    void Shader::checkCompileErrors(GLuint shader, const std::string &type)
-    {
-        GLint success;
-        GLchar infoLog[1024];
+        // Store only the final program; independent stages are discarded.
+        glDeleteShader(vertex);
+        glDeleteShader(fragment);
 
-        if (type != "PROGRAM")
+        GLint success;
+        glGetProgramiv(program, GL_LINK_STATUS, &success);
+        if (!success)
         {
-            glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
-            if (!success)
-            {
-                glGetShaderInfoLog(shader, 1024, nullptr, infoLog);
-                throw std::runtime_error("ERROR::SHADER_COMPILATION_ERROR of type: " + type + "\n" + infoLog);
-            }
+            GLchar infoLog[1024];
+            glGetProgramInfoLog(program, 1024, nullptr, infoLog);
+            log = std::string("ERROR::PROGRAM_LINKING_ERROR of type: PROGRAM\n") + infoLog;
+            glDeleteProgram(program);
+            return 0;
         }
-        else
+
+        ProgramBinaryCache::store(program, vertexCode, fragmentCode);
+        buildTotals.compiled++;
+        return program;
+    }
+
+    GLuint Shader::compileShader(const std::string &source, GLenum type, std::string &log)
+    {
+        GLuint shader = glCreateShader(type);
+        const char *src = source.c_str();
+        glShaderSource(shader, 1, &src, nullptr);
+        glCompileShader(shader);
+
+        GLint success;
+        glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+        if (!success)
         {
-            glGetProgramiv(shader, GL_LINK_STATUS, &success);
-            if (!success)
-            {
-                glGetProgramInfoLog(shader, 1024, nullptr, infoLog);
-                throw std::runtime_error("ERROR::PROGRAM_LINKING_ERROR of type: " + type + "\n" + infoLog);
-            }
+            GLchar infoLog[1024];
+            glGetShaderInfoLog(shader, 1024, nullptr, infoLog);
+            std::string typeStr = (type == GL_VERTEX_SHADER) ? "VERTEX" : "FRAGMENT";
+            log = "ERROR::SHADER_COMPILATION_ERROR of type: " + typeStr + "\n" + infoLog;
+            glDeleteShader(shader);
+            return 0;
         }
+        return shader;
     }
 
 } // namespace gfx
@@ -4,7 +4,10 @@
  */
 
 #pragma once
+#include <cstdint>
 #include <string>
+#include <utility>
+#include <vector>
 #include <fstream>
 #include <sstream>
 #include <iostream>
@@ -17,9 +20,23 @@ extern "C"
 #include <glm/glm.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
+#include "RenderState.h"
+
 namespace gfx
 {
 
+    /**
+     * @brief Program loads since startup (see Shader::buildStats()).
+     */
+    struct ShaderBuildStats
+    {
+        uint32_t programs = 0;   ///< Successful load()/loadShared() calls.
+        uint32_t shared = 0;     ///< Of those, reused a program another Shader had loaded.
+        uint32_t fromBinary = 0; ///< Programs restored from the binary cache.
+        uint32_t compiled = 0;   ///< Programs compiled and linked from source (hot reloads included).
+        double ms = 0.0;         ///< Time inside load()/loadShared().
+    };
+
     /**
      * @brief Manages the creation and usage of an OpenGL program composed of
      *        vertex and fragment shaders.
@@ -27,6 +44,14 @@ namespace gfx
      * The wrapper handles loading from files, compilation, error checking,
      * linking, and subsequent destruction of the program. It is designed as a movable
      * resource to allow ownership transfer without duplicating the GL handle.
+     *
+     * Loaded programs keep their stage sources so they can be rebuilt when a
+     * file changes on disk (see reloadSource()). A rebuild links a new program
+     * and only replaces the old one if compilation and linking succeed.
+     *
+     * Linked programs go through ProgramBinaryCache, so a later run restores
+     * them instead of compiling. loadShared() also lets identical loads (same
+     * files, same sources) share one GL program.
      */
     class Shader
     {
@@ -34,38 +59,55 @@ namespace gfx
         Shader() = default;
         /// Convenience: constructs and compiles immediately from the given paths.
         Shader(const char *vsPath, const char *fsPath) { load(vsPath, fsPath); }
-        ~Shader()
-        {
-            if (prog_)
-                glDeleteProgram(prog_);
-        }
+        ~Shader();
 
         /// Non-copyable: the OpenGL program should not be destroyed multiple times.
         Shader(const Shader &) = delete;
         Shader &operator=(const Shader &) = delete;
 
         /// Allows moving the program (transferring the handle) between instances.
-        Shader(Shader &&other) noexcept : prog_(other.prog_) { other.prog_ = 0; }
-        Shader &operator=(Shader &&other) noexcept
-        {
-            if (this != &other)
-            {
-                if (prog_)
-                    glDeleteProgram(prog_);
-                prog_ = other.prog_;
-                other.prog_ = 0;
-            }
-            return *this;
-        }
+        Shader(Shader &&other) noexcept;
+        Shader &operator=(Shader &&other) noexcept;
 
         /**
          * @brief Loads, compiles, and links shaders located at the given paths.
+         * @param defines `#define` lines inserted after the `#version` line of both
+         *        stages (feature flags of a permutation, see ShaderVariants).
          * @throws std::runtime_error if any step fails (I/O, compilation, or link).
          */
-        void load(const char *vsPath, const char *fsPath);
+        void load(const char *vsPath, const char *fsPath, const std::string &defines = std::string());
 
-        /// Makes this program active in the pipeline.
-        void use() const { glUseProgram(prog_); }
+        /**
+         * @brief Like load(), but reuses the program of another Shader loaded from the
+         *        same files with the same sources and defines.
+         *
+         * Uniform values live in the program, so every user of a shared program
+         * must set the uniforms it relies on before drawing (Renderer2D sets all
+         * of them on each flush). Hot reload rebuilds the program once for all.
+         */
+        void loadShared(const char *vsPath, const char *fsPath, const std::string &defines = std::string());
+
+        /**
+         * @brief Binds a uniform block to a binding point; re-applied after a hot reload.
+         * @return false if the program does not declare the block.
+         */
+        bool bindUniformBlock(const char *blockName, GLuint binding);
+
+        /**
+         * @brief Rebuilds every loaded program that uses `path` as one of its stages.
+         * @param path Stage path exactly as passed to load() (e.g. "shaders/hud.frag").
+         * @param source New text of that stage.
+         * @return false if any program failed to rebuild (it keeps its previous version).
+         *
+         * Must run on the thread that owns the GL context.
+         */
+        static bool reloadSource(const std::string &path, const std::string &source);
+
+        /// Counters of every program load so far (startup time, cache hits).
+        static ShaderBuildStats buildStats();
+
+        /// Makes this program active in the pipeline (skipped if it already is).
+        void use() const { RenderState::useProgram(prog_); }
 
         /// Direct exposure of the GL identifier (read-only).
         GLuint id() const { return prog_; }
@@ -79,10 +121,28 @@ namespace gfx
 
     private:
         GLuint prog_ = 0; ///< OpenGL program ID (0 indicates uninitialized).
+        uint64_t sharedKey_ = 0; ///< Entry in the shared program table (0: program owned alone).
+
+        // Kept for hot reload
+        std::string vsPath_, fsPath_;
+        std::string vsSource_, fsSource_; ///< As read from disk (defines are applied when building).
+        std::string defines_;
+        std::vector<std::pair<std::string, GLuint>> uniformBlocks_;
+
+        void loadProgram(const char *vsPath, const char *fsPath, const std::string &defines, bool shared);
+        /// Drops this Shader's program (deleted unless other Shaders still share it).
+        void releaseProgram();
 
         std::string readFile(const char *path);
-        GLuint compileShader(const std::string &source, GLenum type);
-        void checkCompileErrors(GLuint shader, const std::string &type);
+        /// Applies `defines`, then restores both stages from the binary cache or compiles
+        /// and links them (and caches the result); returns 0 and fills `log` on failure.
+        static GLuint buildProgram(const std::string &vsSource, const std::string &fsSource,
+                                   const std::string &defines, std::string &log);
+        static GLuint compileShader(const std::string &source, GLenum type, std::string &log);
+        void applyUniformBlocks() const;
+
+        /// Loaded shaders, for reloadSource() (GL thread only).
+        static std::vector<Shader *> &loadedShaders();
     };
 
 } // namespace gfx
@@ -0,0 +1,62 @@
+/**
+ * @file ShaderVariants.cpp
+ * @brief Implementation of the shader permutation cache.
+ */
+
+#include "ShaderVariants.h"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+namespace gfx
+{
+
+    ShaderVariants::ShaderVariants(std::string vsPath, std::string fsPath, std::vector<std::string> features, bool shared)
+        : vsPath_(std::move(vsPath)), fsPath_(std::move(fsPath)), features_(std::move(features)), shared_(shared)
+    {
+    }
+
+    const ShaderVariant &ShaderVariants::variant(uint32_t features)
+    {
+        auto found = variants_.find(features);
+        if (found != variants_.end())
+        {
+            return *found->second;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        auto variant = std::make_unique<ShaderVariant>();
+        variant->features = features;
+
+        std::string defines;
+        std::string names;
+        for (size_t bit = 0; bit < features_.size() && bit < 32; ++bit)
+        {
+            if (features & (1u << bit))
+            {
+                defines += "#define " + features_[bit] + " 1\n";
+                names += (names.empty() ? "" : "|") + features_[bit];
+            }
+        }
+
+        if (shared_)
+        {
+            variant->shader.loadShared(vsPath_.c_str(), fsPath_.c_str(), defines);
+        }
+        else
+        {
+            variant->shader.load(vsPath_.c_str(), fsPath_.c_str(), defines);
+        }
+
+        const std::string::size_type slash = fsPath_.find_last_of('/');
+        variant->label = fsPath_.substr(slash == std::string::npos ? 0 : slash + 1) + "[" + names + "]";
+
+        std::cout << std::fixed << std::setprecision(1) << "[ShaderVariants] " << variant->label << " ready in "
+                  << std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count()
+                  << " ms" << std::defaultfloat << std::endl;
+
+        return *variants_.emplace(features, std::move(variant)).first->second;
+    }
+
+} // namespace gfx
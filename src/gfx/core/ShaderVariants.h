@@ -0,0 +1,63 @@
+/**
+ * @file ShaderVariants.h
+ * @brief Shader permutations selected by a feature bitmask, compiled on first use.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Shader.h"
+
+namespace gfx
+{
+
+    /**
+     * @brief One compiled permutation.
+     */
+    struct ShaderVariant
+    {
+        Shader shader;
+        uint32_t features = 0; ///< Bitmask this variant was built for.
+        std::string label;     ///< "model.frag[HAS_DIFFUSE_MAP]": profiler scope name.
+    };
+
+    /**
+     * @brief Builds a shader pair once per feature combination.
+     *
+     * Bit `i` of a mask turns on `#define <features[i]>` in both stages, so
+     * the GLSL selects code and samplers with `#ifdef` instead of branching
+     * on uniforms per fragment. Each variant is an ordinary Shader: it goes
+     * through the program binary cache and is rebuilt (with its defines)
+     * when a stage file is hot-reloaded. Variants live as long as this
+     * object and never move, so references and labels stay valid.
+     */
+    class ShaderVariants
+    {
+    public:
+        /// `features` names the define of each bit (at most 32); `shared` loads through Shader::loadShared.
+        ShaderVariants(std::string vsPath, std::string fsPath, std::vector<std::string> features, bool shared = false);
+
+        ShaderVariants(const ShaderVariants &) = delete;
+        ShaderVariants &operator=(const ShaderVariants &) = delete;
+
+        /**
+         * @brief Variant for `features`, compiled (or restored from the cache) the first time.
+         * @throws std::runtime_error if that permutation fails to build.
+         */
+        const ShaderVariant &variant(uint32_t features);
+
+        size_t compiledCount() const { return variants_.size(); }
+
+    private:
+        std::string vsPath_, fsPath_;
+        std::vector<std::string> features_;
+        bool shared_ = false;
+        std::unordered_map<uint32_t, std::unique_ptr<ShaderVariant>> variants_;
+    };
+
+} // namespace gfx
@@ -1,6 +1,7 @@
 #include "Mesh.h"
-#include "../core/Shader.h"
+#include "../core/RenderState.h"
 #include <glad/glad.h>
+#include <cstddef>
 #include <string>
 
 Mesh::Mesh(std::vector<Vertex> vertices, std::vector<unsigned int> indices, std::vector<Texture> textures)
@@ -11,6 +12,37 @@ Mesh::Mesh(std::vector<Vertex> vertices, std::vector<unsigned int> indices, std:
 
     // Now that we have all the required data, set the vertex buffers and its attribute pointers.
     setupMesh();
+    setupMaterial();
+}
+
+void Mesh::setupMaterial()
+{
+    maps.clear();
+    features = 0;
+
+    for (const Texture &texture : textures)
+    {
+        unsigned int unit = 0; // MaterialFeature bit index
+        const std::string &name = texture.type;
+        if (name == "texture_diffuse")
+            unit = 0;
+        else if (name == "texture_normal")
+            unit = 1;
+        else if (name == "texture_metallic")
+            unit = 2;
+        else if (name == "texture_roughness")
+            unit = 3;
+        else
+            continue;
+
+        // Textures that failed to load (id 0) fall back to the variant without that map
+        const uint32_t feature = 1u << unit;
+        if (!texture.id || (features & feature))
+            continue;
+
+        maps.push_back({unit, texture.id});
+        features |= feature;
+    }
 }
 
 void Mesh::setupMesh()
@@ -19,7 +51,7 @@ void Mesh::setupMesh()
     glGenBuffers(1, &VBO);
     glGenBuffers(1, &EBO);
 
-    glBindVertexArray(VAO);
+    gfx::RenderState::bindVertexArray(VAO);
     glBindBuffer(GL_ARRAY_BUFFER, VBO);
     glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex), &vertices[0], GL_STATIC_DRAW);
 
@@ -42,52 +74,18 @@ void Mesh::setupMesh()
     glEnableVertexAttribArray(4);
     glVertexAttribPointer(4, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void *)offsetof(Vertex, Bitangent));
 
-    glBindVertexArray(0);
+    gfx::RenderState::bindVertexArray(0);
 }
 
-void Mesh::Draw(gfx::Shader &shader)
+void Mesh::Draw() const
 {
-    unsigned int diffuseNr = 1;
-    unsigned int specularNr = 1;
-    unsigned int normalNr = 1;
-    unsigned int metallicNr = 1;
-    unsigned int roughnessNr = 1;
-
-    // Track which texture types are present
-    bool hasDiffuse = false;
-
-    for (unsigned int i = 0; i < textures.size(); i++)
+    // Meshes sharing a material find their textures already bound
+    for (const BoundMap &map : maps)
     {
-        glActiveTexture(GL_TEXTURE0 + i);
-        std::string number;
-        std::string name = textures[i].type;
-        if (name == "texture_diffuse")
-        {
-            number = std::to_string(diffuseNr++);
-            hasDiffuse = true;
-        }
-        else if (name == "texture_specular")
-            number = std::to_string(specularNr++);
-        else if (name == "texture_normal")
-            number = std::to_string(normalNr++);
-        else if (name == "texture_metallic")
-            number = std::to_string(metallicNr++);
-        else if (name == "texture_roughness")
-            number = std::to_string(roughnessNr++);
-
-        shader.setInt((name + number).c_str(), i);
-        glBindTexture(GL_TEXTURE_2D, textures[i].id);
+        gfx::RenderState::bindTexture(map.unit, GL_TEXTURE_2D, map.texture);
     }
 
-    // Set texture availability flag
-    shader.setBool("hasTextureDiffuse", hasDiffuse);
-
-    glActiveTexture(GL_TEXTURE0);
-
     // Draw mesh
-    glBindVertexArray(VAO);
+    gfx::RenderState::bindVertexArray(VAO);
     glDrawElements(GL_TRIANGLES, static_cast<unsigned int>(indices.size()), GL_UNSIGNED_INT, 0);
-    glBindVertexArray(0);
-
-    glActiveTexture(GL_TEXTURE0);
-}
\ No newline at end of file
+}
@@ -8,15 +8,11 @@
 #ifndef MESH_H
 #define MESH_H
 
+#include <cstdint>
 #include <glm/glm.hpp>
 #include <string>
 #include <vector>
 
-namespace gfx
-{
-    class Shader;
-}
-
 struct Vertex
 {
     glm::vec3 Position;  ///< Vertex position in 3D space.
@@ -33,6 +29,20 @@ struct Texture
     std::string path; ///< Path to the texture file.
 };
 
+/**
+ * @brief Material maps the model shader can sample; a mesh's mask selects its shader variant.
+ *
+ * Bit `i` is the `#define` at position `i` of Model::shaderFeatures(), and
+ * the map is bound to texture unit `i`.
+ */
+enum MaterialFeature : uint32_t
+{
+    MaterialDiffuseMap = 1u << 0,
+    MaterialNormalMap = 1u << 1,
+    MaterialMetallicMap = 1u << 2,
+    MaterialRoughnessMap = 1u << 3,
+};
+
 /**
  * @class Mesh
  * @brief Represents a renderable 3D mesh.
@@ -58,19 +68,40 @@ public:
     Mesh(std::vector<Vertex> vertices, std::vector<unsigned int> indices, std::vector<Texture> textures);
 
     /**
-     * @brief Renders the mesh using the provided shader.
-     * @param shader Shader program to use for rendering.
+     * @brief Binds the mesh's maps and draws it.
+     *
+     * The shader variant for materialFeatures() must already be in use, with
+     * its samplers pointing at the units of MaterialFeature (see Model::Draw).
      */
-    void Draw(gfx::Shader &shader);
+    void Draw() const;
+
+    /// MaterialFeature bits of the maps this mesh has (loaded successfully).
+    uint32_t materialFeatures() const { return features; }
 
 private:
     // Render data
     unsigned int VBO, EBO;
 
+    /// A map bound for drawing: unit (= feature bit index) and texture.
+    struct BoundMap
+    {
+        unsigned int unit;
+        unsigned int texture;
+    };
+    std::vector<BoundMap> maps; ///< First map of each feature; specular and extra maps are never sampled.
+    uint32_t features = 0;
+
     /**
      * @brief Initializes all the buffer objects/arrays.
      */
     void setupMesh();
+
+    /**
+     * @brief Picks the maps the shader samples and derives the feature mask.
+     *
+     * Done once at construction so that Draw() does no string work per frame.
+     */
+    void setupMaterial();
 };
 
 #endif
\ No newline at end of file
@@ -1,5 +1,8 @@
 #include "Model.h"
-#include "../core/Shader.h"
+#include "../core/ShaderVariants.h"
+#include "../core/RenderState.h"
+#include "../../core/FrameProfiler.h"
+#include <algorithm>
 #include <iostream>
 #include "stb/stb_image.h"
 #include <glad/glad.h>
@@ -9,10 +12,66 @@ Model::Model(std::string const &path, bool gamma) : gammaCorrection(gamma)
     loadModel(path);
 }
 
-void Model::Draw(gfx::Shader &shader)
+void Model::Draw(gfx::ShaderVariants &shaders, const ModelDrawParams &params)
 {
+    // Sampler of each MaterialFeature bit; the map sits on the unit of the same index
+    static const char *const kSamplers[] = {"texture_diffuse1", "texture_normal1", "texture_metallic1",
+                                            "texture_roughness1"};
+
+    core::ProfileScope profile("Model::Draw", core::ProfileTiming::CpuGpu);
+    for (const MaterialGroup &group : materialGroups)
+    {
+        const gfx::ShaderVariant &variant = shaders.variant(group.features);
+        core::ProfileScope variantProfile(variant.label.c_str(), core::ProfileTiming::CpuGpu);
+
+        const gfx::Shader &shader = variant.shader;
+        shader.use();
+        shader.setMat4("projection", params.projection);
+        shader.setMat4("view", params.view);
+        shader.setMat4("model", params.model);
+        shader.setVec3("viewPos", params.viewPos);
+        shader.setVec3("lightPos", params.lightPos);
+        shader.setVec3("lightColor", params.lightColor);
+        for (int bit = 0; bit < 4; ++bit)
+        {
+            if (group.features & (1u << bit))
+                shader.setInt(kSamplers[bit], bit);
+        }
+
+        for (unsigned int mesh : group.meshes)
+            meshes[mesh].Draw();
+    }
+}
+
+std::vector<uint32_t> Model::materialVariants() const
+{
+    std::vector<uint32_t> variants;
+    for (const MaterialGroup &group : materialGroups)
+        variants.push_back(group.features);
+    return variants;
+}
+
+std::vector<std::string> Model::shaderFeatures()
+{
+    // Same order as the MaterialFeature bits
+    return {"HAS_DIFFUSE_MAP", "HAS_NORMAL_MAP", "HAS_METALLIC_MAP", "HAS_ROUGHNESS_MAP"};
+}
+
+void Model::groupByMaterial()
+{
+    materialGroups.clear();
     for (unsigned int i = 0; i < meshes.size(); i++)
-        meshes[i].Draw(shader);
+    {
+        const uint32_t features = meshes[i].materialFeatures();
+        auto group = std::find_if(materialGroups.begin(), materialGroups.end(),
+                                  [features](const MaterialGroup &g) { return g.features == features; });
+        if (group == materialGroups.end())
+        {
+            materialGroups.push_back({features, {}});
+            group = materialGroups.end() - 1;
+        }
+        group->meshes.push_back(i);
+    }
 }
 
 void Model::loadModel(std::string const &path)
@@ -38,8 +97,10 @@ void Model::loadModel(std::string const &path)
     std::cout << "  Textures: " << scene->mNumTextures << std::endl;
 
     processNode(scene->mRootNode, scene);
+    groupByMaterial();
 
-    std::cout << "  Total meshes processed: " << meshes.size() << std::endl;
+    std::cout << "  Total meshes processed: " << meshes.size() << " (" << materialGroups.size()
+              << " material variants)" << std::endl;
 }
 
 void Model::processNode(aiNode *node, const aiScene *scene)
@@ -198,7 +259,7 @@ unsigned int TextureFromFile(const char *path, const std::string &directory, boo
         else if (nrComponents == 4)
             format = GL_RGBA;
 
-        glBindTexture(GL_TEXTURE_2D, textureID);
+        gfx::RenderState::bindTexture(0, GL_TEXTURE_2D, textureID);
         glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
         glGenerateMipmap(GL_TEXTURE_2D);
 
@@ -211,8 +272,11 @@ unsigned int TextureFromFile(const char *path, const std::string &directory, boo
     }
     else
     {
+        // 0 tells Mesh to use the variant without this map instead of sampling an empty texture
         std::cout << "Texture failed to load at path: " << filename << std::endl;
         stbi_image_free(data);
+        glDeleteTextures(1, &textureID);
+        textureID = 0;
     }
 
     return textureID;
@@ -19,9 +19,22 @@
 
 namespace gfx
 {
-    class Shader;
+    class ShaderVariants;
 }
 
+/**
+ * @brief Per-draw uniforms of the model shader, applied to every variant the model uses.
+ */
+struct ModelDrawParams
+{
+    glm::mat4 model{1.0f};
+    glm::mat4 view{1.0f};
+    glm::mat4 projection{1.0f};
+    glm::vec3 viewPos{0.0f};
+    glm::vec3 lightPos{0.0f};
+    glm::vec3 lightColor{1.0f};
+};
+
 /**
  * @class Model
  * @brief Loads and renders 3D models using Assimp.
@@ -40,10 +53,19 @@ public:
     Model(std::string const &path, bool gamma = false);
 
     /**
-     * @brief Draws the model using the provided shader.
-     * @param shader Shader program to use for rendering.
+     * @brief Draws the model, one group of meshes per material variant.
+     *
+     * Meshes are grouped by MaterialFeature mask at load time; each group
+     * uses its variant of `shaders`, gets `params` uploaded once and shows up
+     * in the profiler under the variant's label.
      */
-    void Draw(gfx::Shader &shader);
+    void Draw(gfx::ShaderVariants &shaders, const ModelDrawParams &params);
+
+    /// Feature masks of the model's materials (compile these variants up front).
+    std::vector<uint32_t> materialVariants() const;
+
+    /// `#define` of each MaterialFeature bit, for the model shader's ShaderVariants.
+    static std::vector<std::string> shaderFeatures();
 
 private:
     // Model data
@@ -52,6 +74,14 @@ private:
     std::string directory;                ///< Directory path of the model file.
     bool gammaCorrection;                 ///< Gamma correction flag.
 
+    /// Meshes sharing a MaterialFeature mask, drawn with one variant.
+    struct MaterialGroup
+    {
+        uint32_t features = 0;
+        std::vector<unsigned int> meshes;
+    };
+    std::vector<MaterialGroup> materialGroups; ///< Built once after loading.
+
     /**
      * @brief Loads a model with supported ASSIMP extensions from file and stores the resulting meshes in the meshes vector.
      * @param path File path to the model.
@@ -65,6 +95,9 @@ private:
      */
     void processNode(aiNode *node, const aiScene *scene);
 
+    /// Groups the meshes by material variant (see materialGroups).
+    void groupByMaterial();
+
     /**
      * @brief Processes an Assimp mesh object into a Mesh object.
      * @param mesh Assimp mesh object.
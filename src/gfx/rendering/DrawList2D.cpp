@@ -0,0 +1,202 @@
+#include "DrawList2D.h"
+#include <cmath>
+
+namespace gfx
+{
+
+    void DrawList2D::clear()
+    {
+        vertices_.clear();
+        indices_.clear();
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  Primitive Construction Helpers
+    ////////////////////////////////////////////////////////////////////////////
+
+    void DrawList2D::addQuad(const glm::vec2 &pos, const glm::vec2 &size, const glm::vec4 &color)
+    {
+        ensureCapacity(4, 6);
+        GLuint baseIndex = vertices_.size();
+
+        // Four vertices of the quad
+        vertices_.push_back({{pos.x, pos.y}, color, {0.0f, 0.0f}});
+        vertices_.push_back({{pos.x + size.x, pos.y}, color, {1.0f, 0.0f}});
+        vertices_.push_back({{pos.x + size.x, pos.y + size.y}, color, {1.0f, 1.0f}});
+        vertices_.push_back({{pos.x, pos.y + size.y}, color, {0.0f, 1.0f}});
+
+        // Two triangles
+        indices_.push_back(baseIndex);
+        indices_.push_back(baseIndex + 1);
+        indices_.push_back(baseIndex + 2);
+
+        indices_.push_back(baseIndex);
+        indices_.push_back(baseIndex + 2);
+        indices_.push_back(baseIndex + 3);
+    }
+
+    void DrawList2D::drawLine(const glm::vec2 &start, const glm::vec2 &end, const glm::vec4 &color, float thickness)
+    {
+        ensureCapacity(4, 6);
+        glm::vec2 direction = glm::normalize(end - start);
+        glm::vec2 perpendicular = glm::vec2(-direction.y, direction.x) * (thickness * 0.5f);
+
+        GLuint baseIndex = vertices_.size();
+
+        // Four vertices for the thick line
+        vertices_.push_back({{start.x - perpendicular.x, start.y - perpendicular.y}, color, {0.0f, 0.0f}});
+        vertices_.push_back({{start.x + perpendicular.x, start.y + perpendicular.y}, color, {1.0f, 0.0f}});
+        vertices_.push_back({{end.x + perpendicular.x, end.y + perpendicular.y}, color, {1.0f, 1.0f}});
+        vertices_.push_back({{end.x - perpendicular.x, end.y - perpendicular.y}, color, {0.0f, 1.0f}});
+
+        // Two triangles
+        indices_.push_back(baseIndex);
+        indices_.push_back(baseIndex + 1);
+        indices_.push_back(baseIndex + 2);
+
+        indices_.push_back(baseIndex);
+        indices_.push_back(baseIndex + 2);
+        indices_.push_back(baseIndex + 3);
+    }
+
+    void DrawList2D::drawRect(const glm::vec2 &position, const glm::vec2 &size, const glm::vec4 &color, bool filled)
+    {
+        if (filled)
+        {
+            addQuad(position, size, color);
+        }
+        else
+        {
+            // Draw border
+            float thickness = 1.0f;
+            drawLine(position, {position.x + size.x, position.y}, color, thickness);
+            drawLine({position.x + size.x, position.y}, position + size, color, thickness);
+            drawLine(position + size, {position.x, position.y + size.y}, color, thickness);
+            drawLine({position.x, position.y + size.y}, position, color, thickness);
+        }
+    }
+
+    void DrawList2D::drawCircle(const glm::vec2 &center, float radius, const glm::vec4 &color, int segments, bool filled)
+    {
+        if (filled)
+        {
+            ensureCapacity(static_cast<size_t>(segments) + 2, static_cast<size_t>(segments) * 3);
+            GLuint centerIndex = vertices_.size();
+            vertices_.push_back({center, color, {0.5f, 0.5f}});
+
+            for (int i = 0; i <= segments; ++i)
+            {
+                float angle = 2.0f * M_PI * i / segments;
+                glm::vec2 pos = center + glm::vec2(cos(angle), sin(angle)) * radius;
+                vertices_.push_back({pos, color, {0.5f + 0.5f * cos(angle), 0.5f + 0.5f * sin(angle)}});
+
+                if (i > 0)
+                {
+                    indices_.push_back(centerIndex);
+                    indices_.push_back(centerIndex + i);
+                    indices_.push_back(centerIndex + i + 1);
+                }
+            }
+        }
+        else
+        {
+            // Draw border
+            for (int i = 0; i < segments; ++i)
+            {
+                float angle1 = 2.0f * M_PI * i / segments;
+                float angle2 = 2.0f * M_PI * (i + 1) / segments;
+
+                glm::vec2 pos1 = center + glm::vec2(cos(angle1), sin(angle1)) * radius;
+                glm::vec2 pos2 = center + glm::vec2(cos(angle2), sin(angle2)) * radius;
+
+                drawLine(pos1, pos2, color, 1.0f);
+            }
+        }
+    }
+
+    // Instrument-specific shapes
+    void DrawList2D::drawTick(const glm::vec2 &center, float angle, float innerRadius, float outerRadius, const glm::vec4 &color, float thickness)
+    {
+        glm::vec2 inner = center + glm::vec2(cos(angle), sin(angle)) * innerRadius;
+        glm::vec2 outer = center + glm::vec2(cos(angle), sin(angle)) * outerRadius;
+        drawLine(inner, outer, color, thickness);
+    }
+
+    void DrawList2D::drawScale(const glm::vec2 &center, float radius, float startAngle, float endAngle, int numTicks, const glm::vec4 &color)
+    {
+        float angleRange = endAngle - startAngle;
+        for (int i = 0; i <= numTicks; ++i)
+        {
+            float angle = startAngle + angleRange * i / numTicks;
+            float tickLength = (i % 5 == 0) ? 10.0f : 5.0f; // Longer ticks every 5
+            drawTick(center, angle, radius - tickLength, radius, color, 1.0f);
+        }
+    }
+
+    void DrawList2D::drawPolyline(const std::vector<glm::vec2> &points, const glm::vec4 &color, float thickness, bool closed)
+    {
+        drawPolyline(points.data(), points.size(), color, thickness, closed);
+    }
+
+    void DrawList2D::drawPolyline(const glm::vec2 *points, size_t count, const glm::vec4 &color, float thickness, bool closed)
+    {
+        if (!points || count < 2)
+            return;
+
+        // Draw connected lines
+        for (size_t i = 0; i < count - 1; ++i)
+        {
+            drawLine(points[i], points[i + 1], color, thickness);
+        }
+
+        // If closed, connect last to first
+        if (closed && count > 2)
+        {
+            drawLine(points[count - 1], points[0], color, thickness);
+        }
+    }
+
+    void DrawList2D::drawTriangle(const glm::vec2 &p1, const glm::vec2 &p2, const glm::vec2 &p3, const glm::vec4 &color, bool filled)
+    {
+        if (filled)
+        {
+            ensureCapacity(3, 3);
+            GLuint baseIndex = vertices_.size();
+
+            vertices_.push_back({p1, color, {0.0f, 0.0f}});
+            vertices_.push_back({p2, color, {1.0f, 0.0f}});
+            vertices_.push_back({p3, color, {0.5f, 1.0f}});
+
+            indices_.push_back(baseIndex);
+            indices_.push_back(baseIndex + 1);
+            indices_.push_back(baseIndex + 2);
+        }
+        else
+        {
+            // Draw border as closed polyline
+            const glm::vec2 outline[3] = {p1, p2, p3};
+            drawPolyline(outline, 3, color, 1.0f, true);
+        }
+    }
+
+    void DrawList2D::drawTexturedQuad(const glm::vec2 &topLeft, const glm::vec2 &bottomRight, const glm::vec4 &color,
+                                      const glm::vec2 &uvMin, const glm::vec2 &uvMax)
+    {
+        ensureCapacity(4, 6);
+        GLuint baseIndex = vertices_.size();
+
+        vertices_.push_back({{topLeft.x, topLeft.y}, color, {uvMin.x, uvMin.y}});
+        vertices_.push_back({{bottomRight.x, topLeft.y}, color, {uvMax.x, uvMin.y}});
+        vertices_.push_back({{bottomRight.x, bottomRight.y}, color, {uvMax.x, uvMax.y}});
+        vertices_.push_back({{topLeft.x, bottomRight.y}, color, {uvMin.x, uvMax.y}});
+
+        indices_.push_back(baseIndex);
+        indices_.push_back(baseIndex + 1);
+        indices_.push_back(baseIndex + 2);
+
+        indices_.push_back(baseIndex);
+        indices_.push_back(baseIndex + 2);
+        indices_.push_back(baseIndex + 3);
+    }
+
+} // namespace gfx
@@ -0,0 +1,92 @@
+/**
+ * @file DrawList2D.h
+ * @brief CPU-side recording of 2D primitives into vertex/index lists.
+ */
+
+#pragma once
+#include <cstddef>
+#include <vector>
+#include <glm/glm.hpp>
+
+extern "C"
+{
+#include <glad/glad.h>
+}
+
+namespace gfx
+{
+
+    /// Represents a 2D vertex with position, color, and optional UV coordinate.
+    struct Vertex2D
+    {
+        glm::vec2 position;
+        glm::vec4 color;
+        glm::vec2 texCoord;
+    };
+
+    /**
+     * @brief Records 2D primitives as triangles in pixel coordinates (origin top-left).
+     *
+     * A DrawList2D never touches OpenGL, so independent lists can be filled from
+     * different threads at the same time (one list per thread) and handed to
+     * `Renderer2D::submit` afterwards. Lists keep their capacity across `clear()`
+     * calls, so a list reused every frame stops allocating once warmed up.
+     *
+     * `Renderer2D` derives from this class and overrides `ensureCapacity` to
+     * flush its fixed-size GPU buffer; standalone lists simply grow.
+     */
+    class DrawList2D
+    {
+    public:
+        DrawList2D() = default;
+        virtual ~DrawList2D() = default;
+
+        DrawList2D(const DrawList2D &) = default;
+        DrawList2D &operator=(const DrawList2D &) = default;
+        DrawList2D(DrawList2D &&) = default;
+        DrawList2D &operator=(DrawList2D &&) = default;
+
+        /// Drops recorded primitives, keeping the allocated storage.
+        void clear();
+        bool empty() const { return vertices_.empty(); }
+
+        const std::vector<Vertex2D> &vertices() const { return vertices_; }
+        const std::vector<GLuint> &indices() const { return indices_; } ///< Relative to this list's vertices.
+
+        // Basic primitives
+        /// Thickened 2D segment rendered como quad.
+        void drawLine(const glm::vec2 &start, const glm::vec2 &end, const glm::vec4 &color, float thickness = 1.0f);
+        /// Eje-alineado; `filled=false` dibuja solo el borde.
+        void drawRect(const glm::vec2 &position, const glm::vec2 &size, const glm::vec4 &color, bool filled = true);
+        /// Círculo aproximado por triángulos; relleno u outline.
+        void drawCircle(const glm::vec2 &center, float radius, const glm::vec4 &color, int segments = 32, bool filled = true);
+
+        // Instrument-specific shapes
+        /// Marca radial para escalas circulares (HSI, bank angle).
+        void drawTick(const glm::vec2 &center, float angle, float innerRadius, float outerRadius, const glm::vec4 &color, float thickness = 1.0f);
+        /// Serie de ticks distribuidos entre dos ángulos.
+        void drawScale(const glm::vec2 &center, float radius, float startAngle, float endAngle, int numTicks, const glm::vec4 &color);
+
+        // Additional primitives for attitude HUD instruments
+        /// Polilínea abierta/cerrada con grosor.
+        void drawPolyline(const std::vector<glm::vec2> &points, const glm::vec4 &color, float thickness = 1.0f, bool closed = false);
+        /// Variante sin contenedor: acepta arrays en stack y no reserva memoria.
+        void drawPolyline(const glm::vec2 *points, size_t count, const glm::vec4 &color, float thickness = 1.0f, bool closed = false);
+        /// Triángulo relleno o solo contorno.
+        void drawTriangle(const glm::vec2 &p1, const glm::vec2 &p2, const glm::vec2 &p3, const glm::vec4 &color, bool filled = false);
+        /// Quad texturizado con UV explícitos.
+        void drawTexturedQuad(const glm::vec2 &topLeft, const glm::vec2 &bottomRight, const glm::vec4 &color,
+                              const glm::vec2 &uvMin, const glm::vec2 &uvMax);
+
+    protected:
+        /// Called before each primitive with the vertices/indices it will add.
+        virtual void ensureCapacity(size_t vertexCount, size_t indexCount) {}
+
+        std::vector<Vertex2D> vertices_; ///< CPU buffer of recorded vertices.
+        std::vector<GLuint> indices_;    ///< Indices into vertices_.
+
+    private:
+        void addQuad(const glm::vec2 &pos, const glm::vec2 &size, const glm::vec4 &color);
+    };
+
+} // namespace gfx
@@ -0,0 +1,314 @@
+/**
+ * @file RenderQueue.cpp
+ * @brief Implementation of the sort-key draw queue.
+ */
+
+#include "RenderQueue.h"
+#include "../../core/FrameProfiler.h"
+#include "../core/RenderState.h"
+
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <utility>
+
+namespace gfx
+{
+
+    namespace
+    {
+        constexpr size_t kInitialCapacity = 1024; ///< Packets reserved up front; a frame rarely needs more.
+        constexpr int kDigits = 8;                ///< 8-bit digits of the 64-bit key.
+
+        constexpr RenderPass kSkyLastOrder[RenderQueue::kPassCount] = {
+            RenderPass::Opaque, RenderPass::Sky, RenderPass::Transparent, RenderPass::Overlay};
+        constexpr RenderPass kSkyFirstOrder[RenderQueue::kPassCount] = {
+            RenderPass::Sky, RenderPass::Opaque, RenderPass::Transparent, RenderPass::Overlay};
+
+        // Profiler scope names (must outlive the frame)
+        constexpr const char *kPassNames[RenderQueue::kPassCount] = {
+            "RenderQueue::Opaque", "RenderQueue::Sky", "RenderQueue::Transparent", "RenderQueue::Overlay"};
+
+        uint32_t depthBits(float depth)
+        {
+            // Non-negative floats order like their bit patterns; NaN and negatives go first
+            if (!(depth > 0.0f))
+            {
+                return 0;
+            }
+            uint32_t bits = 0;
+            std::memcpy(&bits, &depth, sizeof(bits));
+            return bits;
+        }
+
+        void applyPassState(RenderPass pass)
+        {
+            switch (pass)
+            {
+            case RenderPass::Opaque:
+                RenderState::setDepthTest(true);
+                RenderState::setDepthFunc(GL_LESS);
+                RenderState::setDepthMask(true);
+                RenderState::setBlend(false);
+                break;
+            case RenderPass::Sky:
+                // The sky sits at z = w (depth 1.0): LEQUAL passes only where the clear value survived
+                RenderState::setDepthTest(true);
+                RenderState::setDepthFunc(GL_LEQUAL);
+                RenderState::setDepthMask(false);
+                RenderState::setBlend(false);
+                break;
+            case RenderPass::Transparent:
+                RenderState::setDepthTest(true);
+                RenderState::setDepthFunc(GL_LESS);
+                RenderState::setDepthMask(false);
+                RenderState::setBlend(true);
+                RenderState::setBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+                break;
+            case RenderPass::Overlay:
+                RenderState::setDepthTest(false);
+                RenderState::setDepthMask(true);
+                break;
+            }
+        }
+    }
+
+    RenderQueue::RenderQueue()
+    {
+        packets_.reserve(kInitialCapacity);
+        scratch_.reserve(kInitialCapacity);
+    }
+
+    uint64_t RenderQueue::makeKey(RenderPass pass, GLuint program, GLuint material, float depth, uint32_t sequence)
+    {
+        const uint64_t passBits = static_cast<uint64_t>(pass) << 62;
+        const uint64_t programBits = program & 0x3FFFu;
+        const uint64_t materialBits = material & 0xFFFFu;
+
+        switch (pass)
+        {
+        case RenderPass::Transparent:
+            return passBits | (static_cast<uint64_t>(~depthBits(depth)) << 30) | (programBits << 16) | materialBits;
+        case RenderPass::Overlay:
+            return passBits | sequence;
+        default:
+            return passBits | (programBits << 48) | (materialBits << 32) | depthBits(depth);
+        }
+    }
+
+    void RenderQueue::begin(const RenderView &view)
+    {
+        packets_.clear();
+        view_ = view;
+        sequence_ = 0;
+        sorted_ = false;
+    }
+
+    void RenderQueue::submit(RenderPass pass, GLuint program, GLuint material, float depth,
+                             DrawFn draw, const void *object, uint32_t index, uint32_t flags)
+    {
+        DrawPacket packet;
+        packet.key = makeKey(pass, program, material, depth, sequence_++);
+        packet.draw = draw;
+        packet.object = object;
+        packet.index = index;
+        packet.flags = flags;
+        packets_.push_back(packet);
+        sorted_ = false;
+    }
+
+    void RenderQueue::sort()
+    {
+        core::ProfileScope profile("RenderQueue::sort");
+        const size_t count = packets_.size();
+
+        if (count > 1)
+        {
+            // One histogram per digit, all filled in a single pass over the keys
+            size_t histograms[kDigits][256] = {};
+            for (const DrawPacket &packet : packets_)
+            {
+                for (int digit = 0; digit < kDigits; ++digit)
+                {
+                    histograms[digit][(packet.key >> (digit * 8)) & 0xFFu]++;
+                }
+            }
+
+            scratch_.resize(count);
+            DrawPacket *src = packets_.data();
+            DrawPacket *dst = scratch_.data();
+            for (int digit = 0; digit < kDigits; ++digit)
+            {
+                const int shift = digit * 8;
+                size_t *histogram = histograms[digit];
+                // Every key shares this byte (pass bits, unused program bits, ...): nothing to reorder
+                if (histogram[(src[0].key >> shift) & 0xFFu] == count)
+                {
+                    continue;
+                }
+
+                size_t offset = 0;
+                for (int bucket = 0; bucket < 256; ++bucket)
+                {
+                    const size_t bucketSize = histogram[bucket];
+                    histogram[bucket] = offset;
+                    offset += bucketSize;
+                }
+                for (size_t i = 0; i < count; ++i)
+                {
+                    dst[histogram[(src[i].key >> shift) & 0xFFu]++] = src[i];
+                }
+                std::swap(src, dst);
+            }
+            if (src != packets_.data())
+            {
+                packets_.swap(scratch_);
+            }
+        }
+
+        // Packets are grouped by pass now; record where each group starts
+        size_t i = 0;
+        for (int pass = 0; pass < kPassCount; ++pass)
+        {
+            passBegin_[pass] = i;
+            while (i < count && static_cast<int>(packets_[i].key >> 62) == pass)
+            {
+                ++i;
+            }
+        }
+        passBegin_[kPassCount] = count;
+        sorted_ = true;
+    }
+
+    const RenderPass *RenderQueue::passOrder() const
+    {
+        return skyFirst_ ? kSkyFirstOrder : kSkyLastOrder;
+    }
+
+    void RenderQueue::executePass(RenderPass pass)
+    {
+        const int slot = static_cast<int>(pass);
+        const size_t first = passBegin_[slot];
+        const size_t last = passBegin_[slot + 1];
+        if (first == last)
+        {
+            return;
+        }
+
+        core::ProfileScope profile(kPassNames[slot], core::ProfileTiming::CpuGpu);
+        applyPassState(pass);
+        for (size_t i = first; i < last; ++i)
+        {
+            const DrawPacket &packet = packets_[i];
+            packet.draw(packet, view_);
+        }
+    }
+
+    void RenderQueue::execute()
+    {
+        core::ProfileScope profile("RenderQueue::execute", core::ProfileTiming::CpuGpu);
+        if (!sorted_)
+        {
+            sort();
+        }
+
+        const RenderPass *order = passOrder();
+        for (int i = 0; i < kPassCount; ++i)
+        {
+            executePass(order[i]);
+        }
+
+        // Defaults the next frame (and its glClear, which honours the depth mask) expects
+        RenderState::setDepthTest(true);
+        RenderState::setDepthFunc(GL_LESS);
+        RenderState::setDepthMask(true);
+        RenderState::setBlend(false);
+    }
+
+    void RenderQueue::benchmarkSkyOrder(int frames)
+    {
+        if (frames <= 0)
+        {
+            return;
+        }
+        if (!sorted_)
+        {
+            sort();
+        }
+
+        const bool wasSkyFirst = skyFirst_;
+        GLuint query = 0;
+        glGenQueries(1, &query);
+
+        auto drawScene = [&](uint64_t &skySamples)
+        {
+            RenderState::setDepthMask(true);
+            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+            const RenderPass *order = passOrder();
+            for (int i = 0; i < kPassCount; ++i)
+            {
+                if (order[i] == RenderPass::Overlay)
+                {
+                    continue;
+                }
+                if (order[i] == RenderPass::Sky)
+                {
+                    glBeginQuery(GL_SAMPLES_PASSED, query);
+                    executePass(order[i]);
+                    glEndQuery(GL_SAMPLES_PASSED);
+                    GLuint64 samples = 0;
+                    glGetQueryObjectui64v(query, GL_QUERY_RESULT, &samples);
+                    skySamples += samples;
+                }
+                else
+                {
+                    executePass(order[i]);
+                }
+            }
+        };
+
+        std::cout << std::fixed << std::setprecision(3)
+                  << "[RenderQueue] 3D passes, " << passBegin_[static_cast<int>(RenderPass::Overlay)]
+                  << " packets:" << std::endl;
+
+        double skyFirstMs = 0.0;
+        for (bool skyFirst : {true, false})
+        {
+            skyFirst_ = skyFirst;
+            uint64_t skySamples = 0;
+            drawScene(skySamples); // warm-up
+            glFinish();
+
+            skySamples = 0;
+            auto start = std::chrono::steady_clock::now();
+            for (int frame = 0; frame < frames; ++frame)
+            {
+                drawScene(skySamples);
+            }
+            glFinish();
+            double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / frames;
+
+            std::cout << "  " << (skyFirst ? "sky first: " : "sky last:  ") << ms << " ms/frame, "
+                      << skySamples / static_cast<uint64_t>(frames) << " sky fragments";
+            if (skyFirst)
+            {
+                skyFirstMs = ms;
+            }
+            else if (skyFirstMs > 0.0)
+            {
+                std::cout << " (" << 100.0 * (skyFirstMs - ms) / skyFirstMs << "% saved)";
+            }
+            std::cout << std::endl;
+        }
+        std::cout << std::defaultfloat;
+
+        glDeleteQueries(1, &query);
+        skyFirst_ = wasSkyFirst;
+
+        // Hand the regular execute() a clean framebuffer
+        RenderState::setDepthMask(true);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    }
+
+} // namespace gfx
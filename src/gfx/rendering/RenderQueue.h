@@ -0,0 +1,121 @@
+/**
+ * @file RenderQueue.h
+ * @brief Sort-key draw queue that orders the 3D scene and overlays by pass, program, material and depth.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+extern "C"
+{
+#include <glad/glad.h>
+}
+
+namespace gfx
+{
+
+    /**
+     * @brief Passes in execution order; each one sets its own depth/blend state.
+     */
+    enum class RenderPass : uint8_t
+    {
+        Opaque = 0,      ///< Depth test/write on, blend off; front to back.
+        Sky = 1,         ///< Depth LEQUAL without writes: only pixels no opaque draw covered.
+        Transparent = 2, ///< Blend on, depth test without writes; back to front.
+        Overlay = 3      ///< Depth off; HUD and 2D panels in submission order.
+    };
+
+    /**
+     * @brief Camera data shared by every packet of the frame.
+     */
+    struct RenderView
+    {
+        glm::mat4 view{1.0f};
+        glm::mat4 projection{1.0f};
+        glm::vec3 eye{0.0f};
+    };
+
+    struct DrawPacket;
+
+    /// Draws one packet. Plain function pointer so building the frame never allocates.
+    using DrawFn = void (*)(const DrawPacket &packet, const RenderView &view);
+
+    /**
+     * @brief One draw submitted to the queue.
+     *
+     * `object` is whatever the submitter needs to draw (usually itself) and
+     * `index`/`flags` a small per-packet payload, e.g. which waypoint.
+     */
+    struct DrawPacket
+    {
+        uint64_t key = 0;
+        DrawFn draw = nullptr;
+        const void *object = nullptr;
+        uint32_t index = 0;
+        uint32_t flags = 0;
+    };
+
+    /**
+     * @brief Collects the frame's draws, radix-sorts them by key and runs them pass by pass.
+     *
+     * Key layout (most significant first):
+     *   - Opaque/Sky: pass(2) | program(14) | material(16) | depth(32), so draws
+     *     sharing a program and texture run together, nearest first.
+     *   - Transparent: pass(2) | inverted depth(32) | program(14) | material(16),
+     *     farthest first as blending requires.
+     *   - Overlay: pass(2) | submission order(32).
+     * Depth is the distance to the eye; its IEEE bits already sort like the float.
+     *
+     * Packets stay valid after `execute()` until the next `begin()`, so the
+     * same frame can be replayed (see `benchmarkSkyOrder`). GL thread only.
+     */
+    class RenderQueue
+    {
+    public:
+        static constexpr int kPassCount = 4;
+
+        RenderQueue();
+
+        /// Drops last frame's packets and stores this frame's camera.
+        void begin(const RenderView &view);
+
+        void submit(RenderPass pass, GLuint program, GLuint material, float depth,
+                    DrawFn draw, const void *object, uint32_t index = 0, uint32_t flags = 0);
+
+        /// Sorts the packets and draws them; leaves depth test/write on, LESS, blend off.
+        void execute();
+
+        /**
+         * @brief Replays the 3D passes `frames` times with the sky first (the old
+         *        order) and last, and logs the time per frame and sky fragments shaded.
+         *
+         * Clears the framebuffer; call before the regular `execute()`.
+         */
+        void benchmarkSkyOrder(int frames = 60);
+
+        static uint64_t makeKey(RenderPass pass, GLuint program, GLuint material, float depth, uint32_t sequence);
+
+        size_t size() const { return packets_.size(); }
+        const RenderView &view() const { return view_; }
+
+    private:
+        std::vector<DrawPacket> packets_;
+        std::vector<DrawPacket> scratch_; ///< Radix sort ping-pong buffer.
+        size_t passBegin_[kPassCount + 1] = {}; ///< Sorted range of each pass.
+        RenderView view_;
+        uint32_t sequence_ = 0;
+        bool sorted_ = false;
+        bool skyFirst_ = false; ///< Old order (sky before opaque), only while benchmarking.
+
+        void sort();
+        /// Passes in the order they run (depends on `skyFirst_`).
+        const RenderPass *passOrder() const;
+        /// Runs every packet of `pass` (packets must be sorted).
+        void executePass(RenderPass pass);
+    };
+
+} // namespace gfx
@@ -4,7 +4,7 @@
  */
 
 #pragma once
-#include <vector>
+#include <cstddef>
 #include <glm/glm.hpp>
 
 extern "C"
@@ -12,31 +12,29 @@ extern "C"
 #include <glad/glad.h>
 }
 
-#include "../core/Shader.h"
+#include "../core/ShaderVariants.h"
+#include "DrawList2D.h"
 
 namespace gfx
 {
 
-    /// Represents a 2D vertex with position, color, and optional UV coordinate.
-    struct Vertex2D
-    {
-        glm::vec2 position;
-        glm::vec4 color;
-        glm::vec2 texCoord;
-    };
-
     /**
      * @brief Simple batch renderer for HUDs and 2D instruments.
      *
      * Accumulates vertices on the CPU and flushes them to a dynamic VBO.
      * Supports thickened lines, rectangles, circles, and specific primitives
      * for instruments (ticks, scales, polylines, indicator triangles).
+     *
+     * Primitives come from `DrawList2D`: drawn directly on the renderer they
+     * are flushed whenever the batch fills up. Lists recorded elsewhere (for
+     * example on worker threads) are drawn with `submit`. All methods of this
+     * class must be called on the thread that owns the GL context.
      */
-    class Renderer2D
+    class Renderer2D : public DrawList2D
     {
     public:
         Renderer2D();
-        ~Renderer2D();
+        ~Renderer2D() override;
 
         // Disallow copy
         Renderer2D(const Renderer2D &) = delete;
@@ -56,51 +54,46 @@ namespace gfx
         void end();
         void flush();
 
+        /**
+         * @brief Draws pre-recorded lists after whatever is already batched.
+         *
+         * The lists are concatenated in array order (indices rebased) and
+         * uploaded with a single flush, growing the GPU buffers if needed.
+         * Null entries are skipped. Uses the current texture.
+         */
+        void submit(const DrawList2D *const *lists, size_t count);
+
         /// Changes the active atlas/texture for batched primitives.
         void setTexture(GLuint textureId);
 
-        // Basic primitives
-        /// Thickened 2D segment rendered como quad.
-        void drawLine(const glm::vec2 &start, const glm::vec2 &end, const glm::vec4 &color, float thickness = 1.0f);
-        /// Eje-alineado; `filled=false` dibuja solo el borde.
-        void drawRect(const glm::vec2 &position, const glm::vec2 &size, const glm::vec4 &color, bool filled = true);
-        /// Círculo aproximado por triángulos; relleno u outline.
-        void drawCircle(const glm::vec2 &center, float radius, const glm::vec4 &color, int segments = 32, bool filled = true);
-
-        // Instrument-specific shapes
-        /// Marca radial para escalas circulares (HSI, bank angle).
-        void drawTick(const glm::vec2 &center, float angle, float innerRadius, float outerRadius, const glm::vec4 &color, float thickness = 1.0f);
-        /// Serie de ticks distribuidos entre dos ángulos.
-        void drawScale(const glm::vec2 &center, float radius, float startAngle, float endAngle, int numTicks, const glm::vec4 &color);
-
-        // Additional primitives for attitude HUD instruments
-        /// Polilínea abierta/cerrada con grosor.
-        void drawPolyline(const std::vector<glm::vec2> &points, const glm::vec4 &color, float thickness = 1.0f, bool closed = false);
-        /// Triángulo relleno o solo contorno.
-        void drawTriangle(const glm::vec2 &p1, const glm::vec2 &p2, const glm::vec2 &p3, const glm::vec4 &color, bool filled = false);
-        /// Quad texturizado con UV explícitos.
-        void drawTexturedQuad(const glm::vec2 &topLeft, const glm::vec2 &bottomRight, const glm::vec4 &color,
-                              const glm::vec2 &uvMin, const glm::vec2 &uvMax);
+        // Statistics since the last begin()
+        size_t uploadedBytes() const { return uploadedBytes_; } ///< Vertex + index bytes sent to the GPU.
+        size_t drawCalls() const { return drawCalls_; }         ///< Flushes that issued a draw.
 
-    private:
-        GLuint vao_, vbo_, ebo_; ///< Buffer objects shared by the entire batch.
-        Shader shader_;          ///< Program that draws colored primitives.
+    protected:
+        void ensureCapacity(size_t vertexCount, size_t indexCount) override;
 
-        std::vector<Vertex2D> vertices_; ///< CPU buffer of batched vertices.
-        std::vector<GLuint> indices_;    ///< CPU indices aligned to the same batch.
+    private:
+        GLuint vao_, vbo_, ebo_;                 ///< Buffer objects shared by the entire batch.
+        ShaderVariants shaders_;                 ///< hud.vert/frag; HUD_TEXTURED samples the current texture.
+        const Shader *solidShader_ = nullptr;    ///< Variant for untextured batches.
+        const Shader *texturedShader_ = nullptr; ///< Variant for text/atlas batches.
 
         glm::mat4 projection_;
         int screenWidth_, screenHeight_;
 
-        static const size_t MAX_VERTICES = 10000;
+        static const size_t MAX_VERTICES = 10000; ///< Immediate-mode batch size before a flush.
         static const size_t MAX_INDICES = 15000;
 
+        size_t vertexCapacity_ = MAX_VERTICES; ///< Current VBO size in vertices (grows for submit()).
+        size_t indexCapacity_ = MAX_INDICES;   ///< Current EBO size in indices.
+
         GLuint currentTexture_ = 0;
 
-        void addVertex(const Vertex2D &vertex);
-        void addQuad(const glm::vec2 &pos, const glm::vec2 &size, const glm::vec4 &color);
+        size_t uploadedBytes_ = 0;
+        size_t drawCalls_ = 0;
+
         void setupBuffers();
-        void ensureCapacity(size_t vertexCount, size_t indexCount);
     };
 
 } // namespace gfx
@@ -11,7 +11,7 @@ namespace gfx
     // Quick example:
     // gfx::TextRenderer::drawString(renderer, "123", {200, 100}, {8, 12}, {1,1,1,1}, 10);
     // Draws "123" centered at (200,100) with 8x12 px characters, horizontal advance 10.
-    void TextRenderer::drawString(Renderer2D &renderer, const std::string &text, const glm::vec2 &position, const glm::vec2 &charSize, const glm::vec4 &color, float spacing)
+    void TextRenderer::drawString(DrawList2D &renderer, std::string_view text, const glm::vec2 &position, const glm::vec2 &charSize, const glm::vec4 &color, float spacing)
     {
         // Center the full string horizontally (midpoint alignment).
         float totalWidth = text.length() * spacing - (spacing - charSize.x);
@@ -36,7 +36,7 @@ namespace gfx
     //  Internal Helper: 7 segments
     ////////////////////////////////////////////////////////////////////////////
 
-    void TextRenderer::drawChar7Segment(Renderer2D &renderer, char character, const glm::vec2 &pos, const glm::vec2 &size, const glm::vec4 &color)
+    void TextRenderer::drawChar7Segment(DrawList2D &renderer, char character, const glm::vec2 &pos, const glm::vec2 &size, const glm::vec4 &color)
     {
         const float w = size.x;
         const float h = size.y;
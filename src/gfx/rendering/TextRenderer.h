@@ -4,7 +4,7 @@
  */
 
 #pragma once
-#include <string>
+#include <string_view>
 #include <glm/glm.hpp>
 #include "Renderer2D.h"
 
@@ -14,7 +14,8 @@ namespace gfx
      * @class TextRenderer
      * @brief Static utility for 7-segment display style text.
      *
-     * Relies on `Renderer2D` to draw rectangular blocks simulating lit segments.
+     * Records rectangular blocks simulating lit segments into a `DrawList2D`
+     * (a `Renderer2D` or a list recorded off the render thread).
      * All logic is stateless: position and size are defined by parameters in each call.
      */
     class TextRenderer
@@ -23,16 +24,17 @@ namespace gfx
         /**
          * @brief Draws a text string on the screen.
          *
-         * @param renderer The 2D renderer to use.
-         * @param text The text string to draw.
+         * @param renderer The draw list to record into.
+         * @param text The text string to draw (accepts literals, std::string and
+         *             util::FixedString buffers without copying).
          * @param position The center position of the text.
          * @param charSize The size (width, height) of each character.
          * @param color The text color.
          * @param spacing The total horizontal spacing for each character (advance).
          */
         static void drawString(
-            Renderer2D &renderer,
-            const std::string &text,
+            DrawList2D &renderer,
+            std::string_view text,
             const glm::vec2 &position,
             const glm::vec2 &charSize,
             const glm::vec4 &color,
@@ -42,14 +44,14 @@ namespace gfx
         /**
          * @brief Draws a single character in 7-segment style.
          *
-         * @param renderer The 2D renderer to use.
+         * @param renderer The draw list to record into.
          * @param character The character to draw.
          * @param pos The top-left position of the character.
          * @param size The size (width, height) of the character.
          * @param color The character color.
          */
         static void drawChar7Segment(
-            Renderer2D &renderer,
+            DrawList2D &renderer,
             char character,
             const glm::vec2 &pos,
             const glm::vec2 &size,
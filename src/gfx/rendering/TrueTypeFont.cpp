@@ -2,6 +2,7 @@
 #include "stb/stb_truetype.h"
 
 #include "TrueTypeFont.h"
+#include "../core/RenderState.h"
 
 #include <fstream>
 #include <iostream>
@@ -28,6 +29,7 @@ namespace gfx
     {
         if (textureId_ != 0)
         {
+            RenderState::forgetTexture(textureId_);
             glDeleteTextures(1, &textureId_);
             textureId_ = 0;
         }
@@ -98,14 +100,13 @@ namespace gfx
         {
             glGenTextures(1, &textureId_);
         }
-        glBindTexture(GL_TEXTURE_2D, textureId_);
+        RenderState::bindTexture(0, GL_TEXTURE_2D, textureId_);
         glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
         glTexImage2D(GL_TEXTURE_2D, 0, GL_RED, atlasWidth_, atlasHeight_, 0, GL_RED, GL_UNSIGNED_BYTE, atlas.data());
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-        glBindTexture(GL_TEXTURE_2D, 0);
 
         stbtt_GetFontVMetrics(fontInfo_.get(), &ascent_, &descent_, &lineGap_);
 
@@ -159,7 +160,7 @@ namespace gfx
         return (baseLineHeight + gap) * lineSpacing;
     }
 
-    glm::vec2 TrueTypeFont::measureText(const std::string &text, float pixelHeight, float lineSpacing) const
+    glm::vec2 TrueTypeFont::measureText(std::string_view text, float pixelHeight, float lineSpacing) const
     {
         if (!isLoaded() || text.empty())
         {
@@ -210,7 +211,7 @@ namespace gfx
         return glm::vec2(maxWidth, totalHeight);
     }
 
-    void TrueTypeFont::drawText(Renderer2D &renderer, const std::string &text, const glm::vec2 &topLeft,
+    void TrueTypeFont::drawText(Renderer2D &renderer, std::string_view text, const glm::vec2 &topLeft,
                                 float pixelHeight, const glm::vec4 &color, float lineSpacing, bool snapToPixel, bool manageTexture) const
     {
         if (!isLoaded() || text.empty())
@@ -291,7 +292,7 @@ namespace gfx
         return static_cast<std::uint32_t>('?');
     }
 
-    bool TrueTypeFont::decodeUtf8(const std::string &text, size_t &index, std::uint32_t &codepoint) const
+    bool TrueTypeFont::decodeUtf8(std::string_view text, size_t &index, std::uint32_t &codepoint) const
     {
         if (index >= text.size())
         {
@@ -6,6 +6,7 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <vector>
 #include <memory>
 #include <glm/glm.hpp>
@@ -43,7 +44,7 @@ namespace gfx
          * @param pixelHeight Text height when rendering.
          * @param lineSpacing Multiplier for line spacing.
          */
-        glm::vec2 measureText(const std::string &text, float pixelHeight, float lineSpacing = 1.0f) const;
+        glm::vec2 measureText(std::string_view text, float pixelHeight, float lineSpacing = 1.0f) const;
 
         /**
          * @brief Renders text starting from the top-left corner.
@@ -56,7 +57,7 @@ namespace gfx
          * @param snapToPixel Adjusts coordinates to pixel centers to avoid blur.
          * @param manageTexture If true, the function automatically binds/unbinds the atlas.
          */
-        void drawText(Renderer2D &renderer, const std::string &text, const glm::vec2 &topLeft,
+        void drawText(Renderer2D &renderer, std::string_view text, const glm::vec2 &topLeft,
                       float pixelHeight, const glm::vec4 &color,
                       float lineSpacing = 1.0f, bool snapToPixel = true, bool manageTexture = true) const;
 
@@ -85,7 +86,7 @@ namespace gfx
         float ascentPixels(float pixelHeight) const;
         float lineAdvance(float pixelHeight, float lineSpacing) const;
         std::uint32_t fallbackCodepoint() const;
-        bool decodeUtf8(const std::string &text, size_t &index, std::uint32_t &codepoint) const;
+        bool decodeUtf8(std::string_view text, size_t &index, std::uint32_t &codepoint) const;
 
         std::vector<unsigned char> fontBuffer_;
         std::unique_ptr<stbtt_fontinfo> fontInfo_;
@@ -1,5 +1,7 @@
 #include "SkyboxRenderer.h"
+#include "../../core/FrameProfiler.h"
 #include "../core/GLCheck.h"
+#include "../core/RenderState.h"
 #include <array>
 #include <glm/gtc/type_ptr.hpp>
 
@@ -102,7 +104,7 @@ namespace gfx
         glGenVertexArrays(1, &vao_);
         glGenBuffers(1, &vbo_);
 
-        glBindVertexArray(vao_);
+        RenderState::bindVertexArray(vao_);
 
         // Subir la lista de posiciones (solo XYZ) al VBO.
         glBindBuffer(GL_ARRAY_BUFFER, vbo_);
@@ -112,7 +114,7 @@ namespace gfx
         glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void *)0);
         glEnableVertexAttribArray(0);
 
-        glBindVertexArray(0);
+        RenderState::bindVertexArray(0);
         glBindBuffer(GL_ARRAY_BUFFER, 0);
 
         checkGLError("Creating skybox geometry");
@@ -122,18 +124,15 @@ namespace gfx
     //  Render loop
     ////////////////////////////////////////////////////////////////////////////
 
-    void SkyboxRenderer::draw(const glm::mat4 &view, const glm::mat4 &proj)
+    void SkyboxRenderer::draw(const glm::mat4 &view, const glm::mat4 &proj) const
     {
+        core::ProfileScope profile("SkyboxRenderer::draw", core::ProfileTiming::CpuGpu);
         if (!cube_)
         {
             std::cerr << "No cubemap texture set for skybox" << std::endl;
             return;
         }
 
-        // El skybox debe dibujarse incluso cuando comparte z=1 con la profundidad, por lo
-        // que relajamos la comparación para permitir valores iguales (LEQUAL).
-        glDepthFunc(GL_LEQUAL);
-
         shader_.use();
 
         // Para evitar que el cubo parezca trasladarse con la cámara, eliminamos la
@@ -149,12 +148,19 @@ namespace gfx
         cube_->bindUnit(0);
 
         // Renderizar el cubo unitario (36 vértices).
-        glBindVertexArray(vao_);
+        RenderState::bindVertexArray(vao_);
         glDrawArrays(GL_TRIANGLES, 0, 36);
-        glBindVertexArray(0);
+    }
+
+    void SkyboxRenderer::submit(RenderQueue &queue) const
+    {
+        // El cubo se proyecta a z = 1 (pos.xyww): la profundidad no ordena nada dentro del pase
+        queue.submit(RenderPass::Sky, shader_.id(), cube_ ? cube_->id() : 0, 0.0f, &SkyboxRenderer::drawPacket, this);
+    }
 
-        // Restablecer la función por defecto para posteriores draw calls.
-        glDepthFunc(GL_LESS);
+    void SkyboxRenderer::drawPacket(const DrawPacket &packet, const RenderView &view)
+    {
+        static_cast<const SkyboxRenderer *>(packet.object)->draw(view.view, view.projection);
     }
 
 } // namespace gfx
@@ -7,6 +7,7 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include "../core/Shader.h"
+#include "../rendering/RenderQueue.h"
 #include "TextureCube.h"
 
 namespace gfx
@@ -50,9 +51,18 @@ namespace gfx
          * @brief Dibuja el skybox con las matrices de vista y proyección provistas.
          *
          * La vista se normaliza eliminando la traslación para evitar movimientos del
-         * skybox al mover la cámara, manteniendo únicamente la rotación.
+         * skybox al mover la cámara, manteniendo únicamente la rotación. Espera el
+         * estado del pase `RenderPass::Sky` (profundidad LEQUAL, sin escritura).
          */
-        void draw(const glm::mat4 &view, const glm::mat4 &proj);
+        void draw(const glm::mat4 &view, const glm::mat4 &proj) const;
+
+        /**
+         * @brief Encola el cielo en el pase `Sky`, que corre después de los opacos.
+         *
+         * Así el fragment shader del cubemap solo se ejecuta en los píxeles que el
+         * terreno y el avión dejaron libres.
+         */
+        void submit(RenderQueue &queue) const;
 
     private:
         GLuint vao_ = 0, vbo_ = 0;    ///< Identificadores de la geometría del cubo en GPU.
@@ -61,6 +71,8 @@ namespace gfx
 
         /// Crea y configura el VAO/VBO del cubo unitario (36 vértices).
         void createCubeGeometry();
+
+        static void drawPacket(const DrawPacket &packet, const RenderView &view);
     };
 
 } // namespace gfx
@@ -12,6 +12,12 @@ namespace gfx
     ////////////////////////////////////////////////////////////////////////////
 
     bool TextureCube::loadFromAtlas(const std::string &path, bool flipY)
+    {
+        util::CubeFaces faces;
+        return decodeAtlas(path, faces, flipY) && loadCubeFaces(faces);
+    }
+
+    bool TextureCube::decodeAtlas(const std::string &path, util::CubeFaces &faces, bool flipY)
     {
         int W = 0, H = 0;
         std::vector<unsigned char> rgba;
@@ -34,8 +40,8 @@ namespace gfx
 
         try
         {
-            util::CubeFaces faces = util::atlasSliceToCube(rgba, W, H, S, L);
-            return loadCubeFaces(faces);
+            faces = util::atlasSliceToCube(rgba, W, H, S, L);
+            return true;
         }
         catch (const std::exception &e)
         {
@@ -88,7 +94,7 @@ namespace gfx
             glGenTextures(1, &id_);
         }
 
-        glBindTexture(GL_TEXTURE_CUBE_MAP, id_);
+        RenderState::bindTexture(0, GL_TEXTURE_CUBE_MAP, id_);
 
         // Configurar parámetros de filtrado / clamp una única vez.
         setupParameters();
@@ -125,7 +131,6 @@ namespace gfx
             checkGLError(("Loading cube face " + std::to_string(i)).c_str());
         }
 
-        glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
         return true;
     }
 
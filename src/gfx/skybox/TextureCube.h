@@ -13,6 +13,7 @@ extern "C"
 }
 
 #include "../../util/ImageAtlas.h"
+#include "../core/RenderState.h"
 
 namespace gfx
 {
@@ -31,7 +32,10 @@ namespace gfx
         ~TextureCube()
         {
             if (id_)
+            {
+                RenderState::forgetTexture(id_);
                 glDeleteTextures(1, &id_);
+            }
         }
 
         /// No es copiable para evitar duplicar handles OpenGL.
@@ -45,7 +49,10 @@ namespace gfx
             if (this != &other)
             {
                 if (id_)
+                {
+                    RenderState::forgetTexture(id_);
                     glDeleteTextures(1, &id_);
+                }
                 id_ = other.id_;
                 other.id_ = 0;
             }
@@ -59,6 +66,17 @@ namespace gfx
          */
         bool loadFromAtlas(const std::string &path, bool flipY = false);
 
+        /**
+         * @brief Decodifica y recorta el atlas sin tocar OpenGL.
+         *
+         * Puede correr en un hilo de `core::JobPool`; el resultado se sube
+         * después con `upload` desde el hilo del contexto GL.
+         */
+        static bool decodeAtlas(const std::string &path, util::CubeFaces &faces, bool flipY = false);
+
+        /// Sube seis caras ya decodificadas (hilo del contexto GL).
+        bool upload(const util::CubeFaces &faces) { return loadCubeFaces(faces); }
+
         /**
          * @brief Carga cada cara desde archivos individuales enumerados en paths.
          * @param paths Array con las 6 rutas en el orden esperado por util::CubeFaces.
@@ -66,15 +84,11 @@ namespace gfx
          */
         bool loadFromFiles(const std::array<std::string, 6> &paths, bool flipY = false);
 
-        /// Hace bind directo del cubemap al target GL_TEXTURE_CUBE_MAP.
-        void bind() const { glBindTexture(GL_TEXTURE_CUBE_MAP, id_); }
+        /// Hace bind del cubemap al target GL_TEXTURE_CUBE_MAP de la unidad 0.
+        void bind() const { RenderState::bindTexture(0, GL_TEXTURE_CUBE_MAP, id_); }
 
         /// Vincula la textura a una unidad concreta antes de dibujar.
-        void bindUnit(GLuint unit) const
-        {
-            glActiveTexture(GL_TEXTURE0 + unit);
-            glBindTexture(GL_TEXTURE_CUBE_MAP, id_);
-        }
+        void bindUnit(GLuint unit) const { RenderState::bindTexture(unit, GL_TEXTURE_CUBE_MAP, id_); }
 
         /// Devuelve el identificador raw por si se requiere desde fuera.
         GLuint id() const { return id_; }
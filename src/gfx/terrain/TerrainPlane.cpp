@@ -1,5 +1,8 @@
 #include "TerrainPlane.h"
+#include "../../core/FrameProfiler.h"
+#include "../core/RenderState.h"
 
+#include <cmath>
 #include <fstream>
 #include <iostream>
 
@@ -23,7 +26,10 @@ namespace gfx
     TerrainBlock::~TerrainBlock()
     {
         if (vao_)
+        {
+            RenderState::forgetVertexArray(vao_);
             glDeleteVertexArrays(1, &vao_);
+        }
         if (vbo_)
             glDeleteBuffers(1, &vbo_);
         if (ebo_)
@@ -64,7 +70,7 @@ namespace gfx
         glGenBuffers(1, &vbo_);
         glGenBuffers(1, &ebo_);
 
-        glBindVertexArray(vao_);
+        RenderState::bindVertexArray(vao_);
 
         glBindBuffer(GL_ARRAY_BUFFER, vbo_);
         glBufferData(GL_ARRAY_BUFFER,
@@ -81,24 +87,24 @@ namespace gfx
         glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(glm::vec3), (void *)0);
         glEnableVertexAttribArray(0);
 
-        glBindVertexArray(0);
+        RenderState::bindVertexArray(0);
     }
 
     void TerrainBlock::bind()
     {
-        glBindVertexArray(vao_);
+        RenderState::bindVertexArray(vao_);
     }
 
     void TerrainBlock::unbind()
     {
-        glBindVertexArray(0);
+        RenderState::bindVertexArray(0);
     }
 
     void TerrainBlock::draw()
     {
+        // Stays bound between the nine tiles; the next pass binds its own VAO
         bind();
         glDrawElements(GL_TRIANGLE_STRIP, indexCount_, GL_UNSIGNED_INT, 0);
-        unbind();
     }
 
     // ============================================================================
@@ -158,7 +164,7 @@ namespace gfx
             }
 
             glGenTextures(1, &terrainTex_);
-            glBindTexture(GL_TEXTURE_2D, terrainTex_);
+            RenderState::bindTexture(0, GL_TEXTURE_2D, terrainTex_);
             glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, 64, 64, 0, GL_RGB, GL_UNSIGNED_BYTE, greenData);
             glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
             glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
@@ -173,8 +179,9 @@ namespace gfx
     void TerrainPlane::draw(const glm::mat4 &view,
                             const glm::mat4 &projection,
                             const glm::vec3 &cameraPos,
-                            const glm::vec3 &backgroundColor)
+                            const glm::vec3 &backgroundColor) const
     {
+        core::ProfileScope profile("TerrainPlane::draw", core::ProfileTiming::CpuGpu);
         if (!initialized_)
         {
             std::cerr << "TerrainPlane::draw() called before init()\n";
@@ -197,8 +204,7 @@ namespace gfx
         glm::vec2 cameraPosXY(cameraPos.x, cameraPos.z);
         glm::vec2 snapped = glm::floor(cameraPosXY / tileSize) * tileSize;
 
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, terrainTex_);
+        RenderState::bindTexture(0, GL_TEXTURE_2D, terrainTex_);
 
         shader_.use();
         shader_.setInt("u_Texture", 0);
@@ -211,9 +217,9 @@ namespace gfx
         shader_.setFloat("u_TileSize", tileSize);
         shader_.setFloat("u_TextureTiling", config_->textureTiling);
 
-        glEnable(GL_CULL_FACE);
-        glEnable(GL_PRIMITIVE_RESTART);
-        glPrimitiveRestartIndex(PRIMITIVE_RESTART);
+        RenderState::setCullFace(true);
+        RenderState::setPrimitiveRestart(true);
+        RenderState::setPrimitiveRestartIndex(PRIMITIVE_RESTART);
 
         if (wireframe)
         {
@@ -236,14 +242,30 @@ namespace gfx
             glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
         }
 
-        glDisable(GL_CULL_FACE);
-        glDisable(GL_PRIMITIVE_RESTART);
+        // Restart index 0xFFFF is a valid vertex for the larger meshes drawn later
+        RenderState::setCullFace(false);
+        RenderState::setPrimitiveRestart(false);
+    }
+
+    void TerrainPlane::submit(RenderQueue &queue, const glm::vec3 &backgroundColor)
+    {
+        backgroundColor_ = backgroundColor;
+        // The nearest point of the plane is straight below the camera
+        float depth = std::abs(queue.view().eye.y);
+        queue.submit(RenderPass::Opaque, shader_.id(), terrainTex_, depth, &TerrainPlane::drawPacket, this);
+    }
+
+    void TerrainPlane::drawPacket(const DrawPacket &packet, const RenderView &view)
+    {
+        const auto *terrain = static_cast<const TerrainPlane *>(packet.object);
+        terrain->draw(view.view, view.projection, view.eye, terrain->backgroundColor_);
     }
 
     void TerrainPlane::cleanup()
     {
         if (terrainTex_)
         {
+            RenderState::forgetTexture(terrainTex_);
             glDeleteTextures(1, &terrainTex_);
         }
 
@@ -274,7 +296,7 @@ namespace gfx
 
         GLuint texture;
         glGenTextures(1, &texture);
-        glBindTexture(GL_TEXTURE_2D, texture);
+        RenderState::bindTexture(0, GL_TEXTURE_2D, texture);
 
         glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
         glGenerateMipmap(GL_TEXTURE_2D);
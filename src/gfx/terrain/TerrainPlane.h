@@ -17,6 +17,7 @@ extern "C"
 }
 
 #include "../core/Shader.h"
+#include "../rendering/RenderQueue.h"
 
 namespace gfx
 {
@@ -75,7 +76,12 @@ namespace gfx
         void draw(const glm::mat4 &view,
                   const glm::mat4 &projection,
                   const glm::vec3 &cameraPos,
-                  const glm::vec3 &backgroundColor = glm::vec3(0.5f, 0.7f, 1.0f));
+                  const glm::vec3 &backgroundColor = glm::vec3(0.5f, 0.7f, 1.0f)) const;
+
+        /**
+         * @brief Encola el terreno en el pase opaco; se dibuja con la cámara de la cola.
+         */
+        void submit(RenderQueue &queue, const glm::vec3 &backgroundColor = glm::vec3(0.5f, 0.7f, 1.0f));
 
         void cleanup();
 
@@ -87,8 +93,10 @@ namespace gfx
         GLuint terrainTex_ = 0;
         std::unique_ptr<TerrainBlock> tile_;
         bool initialized_ = false;
+        glm::vec3 backgroundColor_{0.5f, 0.7f, 1.0f}; ///< Color de niebla del último submit.
 
         GLuint loadTextureFromFile(const std::string &path);
+        static void drawPacket(const DrawPacket &packet, const RenderView &view);
     };
 
 } // namespace gfx
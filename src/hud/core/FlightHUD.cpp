@@ -33,7 +33,15 @@
  */
 
 #include "FlightHUD.h"
+#include "../../core/JobPool.h"
+#include "../../core/FrameProfiler.h"
+#include "../../gfx/core/RenderState.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
 #include <iostream>
+#include <stdexcept>
 
 namespace hud
 {
@@ -87,6 +95,16 @@ namespace hud
         auto pitchLadder = std::make_unique<PitchLadder>();
         pitchLadder_ = pitchLadder.get();
         instruments_.push_back(std::move(pitchLadder));
+
+        // One SDF slot and one draw list per instrument so rendering never reallocates per frame
+        baseInstrumentCount_ = instruments_.size();
+        resizeInstrumentBuffers();
+    }
+
+    FlightHUD::~FlightHUD()
+    {
+        if (gpuQueries_[0])
+            glDeleteQueries(kGpuQueryCount, gpuQueries_);
     }
 
     // ============================================================================
@@ -111,6 +129,32 @@ namespace hud
         // Initialize shared 2D renderer (HUD orthographic projection).
         renderer2D_->init(screenWidth, screenHeight);
 
+        // Analytic backend is optional: if its shaders fail, the geometry path keeps working
+        try
+        {
+            auto sdfRenderer = std::make_unique<SdfHudRenderer>();
+            sdfRenderer->init(screenWidth, screenHeight);
+            sdfRenderer_ = std::move(sdfRenderer);
+        }
+        catch (const std::exception &e)
+        {
+            std::cerr << "[FlightHUD] SDF backend unavailable: " << e.what() << std::endl;
+        }
+
+        // Same for the cached layer: without it the HUD is drawn every frame
+        try
+        {
+            auto layerCache = std::make_unique<HudLayerCache>();
+            layerCache->init(screenWidth, screenHeight);
+            layerCache_ = std::move(layerCache);
+        }
+        catch (const std::exception &e)
+        {
+            std::cerr << "[FlightHUD] HUD layer cache unavailable: " << e.what() << std::endl;
+        }
+
+        glGenQueries(kGpuQueryCount, gpuQueries_);
+
         // Configure layout of all instruments
         setupInstrumentLayout();
 
@@ -124,6 +168,13 @@ namespace hud
         std::cout << "  - PitchLadder: OK" << std::endl;
     }
 
+    void FlightHUD::initHeadless(int screenWidth, int screenHeight)
+    {
+        screenWidth_ = screenWidth;
+        screenHeight_ = screenHeight;
+        setupInstrumentLayout();
+    }
+
     /**
      * @brief Adjusts the HUD when the window size changes.
      */
@@ -132,6 +183,20 @@ namespace hud
         screenWidth_ = width;
         screenHeight_ = height;
         renderer2D_->setScreenSize(width, height);
+        if (sdfRenderer_)
+            sdfRenderer_->setScreenSize(width, height);
+        if (layerCache_)
+        {
+            try
+            {
+                layerCache_->resize(width, height);
+            }
+            catch (const std::exception &e)
+            {
+                std::cerr << "[FlightHUD] HUD layer cache disabled: " << e.what() << std::endl;
+                layerCache_.reset();
+            }
+        }
 
         // Recalculate layout of all instruments
         setupInstrumentLayout();
@@ -156,42 +221,420 @@ namespace hud
     /**
      * @brief Renders all HUD instruments as a 2D overlay.
      *
-     * Uses the polymorphic pattern to render all instruments uniformly
-     * via the Instrument* vector.
-     *
      * Process:
      * 1. Configure OpenGL state (blending, depth test).
-     * 2. Render each enabled instrument in order.
-     * 3. Restore OpenGL state.
+     * 2. With the layer cache: re-render the instruments into the offscreen
+     *    layer only if the quantized data changed and the rate cap allows it,
+     *    then composite the layer with one quad.
+     * 3. Without it: draw the instruments straight to the framebuffer.
+     * 4. Restore OpenGL state and record the frame cost.
      */
     void FlightHUD::render()
     {
+        core::ProfileScope profile("FlightHUD::render", core::ProfileTiming::CpuGpu);
+        auto cpuStart = std::chrono::steady_clock::now();
+        const gfx::GLCallCounters glStart = gfx::GLStats::snapshot();
+        beginGpuTimer();
+
+        stats_.uploadBytes = 0;
+        stats_.drawCalls = 0;
+        stats_.sdfQuads = 0;
+        stats_.recordMs = 0.0f;
+        stats_.layerCached = layerCache_ && cacheSettings_.enabled;
+        stats_.layerRebuilt = false;
+        stats_.dirtyCheckHit = false;
+        stats_.skippedRebuild = false;
+
         // Configure OpenGL state for 2D overlay
-        glEnable(GL_BLEND);
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-        glDisable(GL_DEPTH_TEST); // HUD always visible on top of 3D
+        gfx::RenderState::setBlend(true);
+        gfx::RenderState::setDepthTest(false); // HUD always visible on top of 3D
 
-        // Begin 2D rendering batch
-        renderer2D_->begin();
+        if (stats_.layerCached)
+        {
+            if (layerNeedsRebuild(cpuStart))
+            {
+                layerCache_->beginCapture();
+                // Color blends as usual; alpha accumulates coverage so the layer ends up premultiplied
+                gfx::RenderState::setBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE,
+                                                       GL_ONE_MINUS_SRC_ALPHA);
+                drawInstruments();
+                layerCache_->endCapture();
+            }
+
+            layerCache_->composite();
+            stats_.drawCalls++;
+        }
+        else
+        {
+            gfx::RenderState::setBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+            drawInstruments();
+        }
 
+        // Back to the 3D defaults; the state cache drops whatever is already set
+        gfx::RenderState::setBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        gfx::RenderState::setDepthTest(true);
+        gfx::RenderState::setBlend(false);
+
+        endGpuTimer();
+
+        // ========================================================================
+        // FRAME COST
+        // ========================================================================
+
+        stats_.backend = backend_;
+        stats_.cpuMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - cpuStart).count();
+
+        BackendTotals &totals = totals_[static_cast<int>(backend_)];
+        totals.frames++;
+        totals.cpuMs += stats_.cpuMs;
+        totals.uploadBytes += static_cast<double>(stats_.uploadBytes);
+        totals.drawCalls += static_cast<double>(stats_.drawCalls);
+        totals.gl += gfx::GLStats::snapshot() - glStart;
+    }
+
+    /**
+     * @brief Draws every enabled instrument into the bound framebuffer.
+     *
+     * SDF backend only: the shapes of every capable instrument are drawn first
+     * as one analytic quad each, leaving them only their labels for Renderer2D.
+     */
+    void FlightHUD::drawInstruments()
+    {
         // ========================================================================
-        // RENDER ALL INSTRUMENTS POLYMORPHICALLY
+        // SDF SHAPES (drawn first, labels go on top in the Renderer2D batch)
         // ========================================================================
 
-        for (const auto &instrument : instruments_)
+        size_t sdfCount = 0;
+        if (backend_ == HudBackend::Sdf && sdfRenderer_)
         {
-            if (instrument && instrument->isEnabled())
+            for (const auto &instrument : instruments_)
             {
-                instrument->render(*renderer2D_, currentFlightData_);
+                if (!instrument || !instrument->isEnabled())
+                    continue;
+
+                bool analytic = instrument->buildSdfInstrument(currentFlightData_, sdfBatch_[sdfCount]);
+                instrument->setShapesEnabled(!analytic);
+                if (analytic)
+                    sdfCount++;
             }
+
+            sdfRenderer_->resetStats();
+            sdfRenderer_->draw(sdfBatch_.data(), sdfCount);
         }
 
-        // End batch
+        // ========================================================================
+        // RECORD EVERY INSTRUMENT INTO ITS OWN LIST, THEN DRAW THEM ALL AT ONCE
+        // ========================================================================
+
+        auto recordStart = std::chrono::steady_clock::now();
+        recordInstruments(0);
+        stats_.recordMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - recordStart).count();
+
+        renderer2D_->begin();
+        renderer2D_->submit(submitLists_.data(), submitLists_.size());
         renderer2D_->end();
 
-        // Restore OpenGL state for 3D rendering
-        glEnable(GL_DEPTH_TEST);
-        glDisable(GL_BLEND);
+        stats_.uploadBytes += renderer2D_->uploadedBytes();
+        stats_.drawCalls += renderer2D_->drawCalls();
+        stats_.sdfQuads = sdfCount;
+        if (sdfCount > 0)
+        {
+            stats_.uploadBytes += sdfRenderer_->uploadedBytes();
+            stats_.drawCalls += sdfRenderer_->drawCalls();
+        }
+    }
+
+    // ============================================================================
+    // DRAW LIST RECORDING
+    // ============================================================================
+
+    // Below this many instruments, waking the workers costs more than it saves.
+    static const size_t PARALLEL_RECORDING_THRESHOLD = 12;
+
+    /**
+     * @brief Fills drawLists_ from the enabled instruments.
+     *
+     * Each instrument only writes to its own list, so they can be recorded in
+     * any order on any thread; Renderer2D::submit concatenates them in
+     * instrument order, which keeps the output identical to serial recording.
+     */
+    void FlightHUD::recordInstruments(unsigned maxThreads)
+    {
+        auto record = [this](size_t i)
+        {
+            gfx::DrawList2D &list = drawLists_[i];
+            list.clear();
+
+            const auto &instrument = instruments_[i];
+            if (instrument && instrument->isEnabled())
+            {
+                instrument->render(list, currentFlightData_);
+            }
+        };
+
+        bool parallel = jobPool_ && parallelRecording_ && maxThreads != 1 &&
+                        instruments_.size() >= PARALLEL_RECORDING_THRESHOLD;
+        if (parallel)
+        {
+            jobPool_->parallelFor(instruments_.size(), record, maxThreads);
+            stats_.recordThreads = maxThreads > 0 ? std::min(maxThreads, jobPool_->workerCount() + 1)
+                                                  : jobPool_->workerCount() + 1;
+        }
+        else
+        {
+            for (size_t i = 0; i < instruments_.size(); ++i)
+            {
+                record(i);
+            }
+            stats_.recordThreads = 1;
+        }
+    }
+
+    void FlightHUD::benchmarkRecording(int frames)
+    {
+        if (frames <= 0)
+            return;
+
+        unsigned maxThreads = jobPool_ ? jobPool_->workerCount() + 1 : 1;
+        bool parallelSetting = parallelRecording_;
+        parallelRecording_ = true;
+
+        size_t vertices = 0;
+        double baselineMs = 0.0;
+        std::cout << std::fixed << std::setprecision(3)
+                  << "[FlightHUD] Recording scaling, " << instruments_.size() << " instruments, "
+                  << frames << " frames:" << std::endl;
+
+        // 1, 2, 4, ... and always the full pool last
+        for (unsigned threads = 1;; threads = std::min(threads * 2, maxThreads))
+        {
+            recordInstruments(threads); // warm-up: grows the lists to their steady-state size
+
+            auto start = std::chrono::steady_clock::now();
+            for (int frame = 0; frame < frames; ++frame)
+            {
+                recordInstruments(threads);
+            }
+            double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / frames;
+
+            if (threads == 1)
+            {
+                baselineMs = ms;
+                vertices = 0;
+                for (const auto &list : drawLists_)
+                    vertices += list.vertices().size();
+            }
+            std::cout << "  " << threads << (threads == 1 ? " thread:  " : " threads: ") << ms << " ms/frame ("
+                      << (ms > 0.0 ? baselineMs / ms : 0.0) << "x)" << std::endl;
+
+            if (threads == maxThreads)
+                break;
+        }
+        std::cout << "  " << vertices << " vertices per frame" << std::defaultfloat << std::endl;
+
+        parallelRecording_ = parallelSetting;
+        layerValid_ = false;
+    }
+
+    void FlightHUD::resizeInstrumentBuffers()
+    {
+        sdfBatch_.resize(instruments_.size());
+        drawLists_.resize(instruments_.size());
+
+        submitLists_.clear();
+        for (const auto &list : drawLists_)
+        {
+            submitLists_.push_back(&list);
+        }
+    }
+
+    // ============================================================================
+    // LAYER CACHE
+    // ============================================================================
+
+    // Quantization steps, chosen below one pixel of movement at the default
+    // layout (tapes scroll ~3 px/kt and 0.3 px/ft, the ladder ~3.6 px/deg).
+    static const float ANGLE_STEP_DEG = 0.1f;
+    static const float AIRSPEED_STEP_KT = 0.1f;
+    static const float ALTITUDE_STEP_FT = 1.0f;
+    static const float VERTICAL_SPEED_STEP_FPM = 10.0f;
+    static const float ALTITUDE_DIFF_STEP_M = 1.0f;
+
+    static int32_t quantizeValue(float value, float step)
+    {
+        return static_cast<int32_t>(std::lround(value / step));
+    }
+
+    bool FlightHUD::QuantizedFlightData::operator==(const QuantizedFlightData &other) const
+    {
+        return pitch == other.pitch && roll == other.roll && heading == other.heading &&
+               airspeed == other.airspeed && altitude == other.altitude &&
+               verticalSpeed == other.verticalSpeed && waypointBearing == other.waypointBearing &&
+               waypointAltitudeDiff == other.waypointAltitudeDiff &&
+               hasActiveWaypoint == other.hasActiveWaypoint;
+    }
+
+    FlightHUD::QuantizedFlightData FlightHUD::quantize(const flight::FlightData &data)
+    {
+        QuantizedFlightData q;
+        q.pitch = quantizeValue(data.pitch, ANGLE_STEP_DEG);
+        q.roll = quantizeValue(data.roll, ANGLE_STEP_DEG);
+        q.heading = quantizeValue(data.heading, ANGLE_STEP_DEG);
+        q.airspeed = quantizeValue(data.airspeed, AIRSPEED_STEP_KT);
+        q.altitude = quantizeValue(data.altitude, ALTITUDE_STEP_FT);
+        q.verticalSpeed = quantizeValue(data.verticalSpeed, VERTICAL_SPEED_STEP_FPM);
+        q.hasActiveWaypoint = data.hasActiveWaypoint;
+        if (data.hasActiveWaypoint)
+        {
+            q.waypointBearing = quantizeValue(data.waypointBearing, ANGLE_STEP_DEG);
+            q.waypointAltitudeDiff = quantizeValue(data.targetWaypoint.y - data.position.y, ALTITUDE_DIFF_STEP_M);
+        }
+        return q;
+    }
+
+    bool FlightHUD::layerNeedsRebuild(std::chrono::steady_clock::time_point now)
+    {
+        QuantizedFlightData data = quantize(currentFlightData_);
+
+        if (layerValid_ && data == layerData_)
+        {
+            stats_.dirtyCheckHit = true;
+            stats_.totalDirtyCheckHits++;
+            return false;
+        }
+
+        // Data changed: honour the rate cap unless the layer contents are unusable
+        if (layerValid_ && cacheSettings_.maxRefreshHz > 0.0f)
+        {
+            float elapsed = std::chrono::duration<float>(now - lastLayerBuild_).count();
+            if (elapsed < 1.0f / cacheSettings_.maxRefreshHz)
+            {
+                stats_.skippedRebuild = true;
+                stats_.totalSkippedRebuilds++;
+                return false;
+            }
+        }
+
+        layerData_ = data;
+        layerValid_ = true;
+        lastLayerBuild_ = now;
+        stats_.layerRebuilt = true;
+        stats_.totalLayerRebuilds++;
+        return true;
+    }
+
+    void FlightHUD::setCacheSettings(const HudCacheSettings &settings)
+    {
+        if (settings.enabled && !layerCache_)
+        {
+            std::cerr << "[FlightHUD] HUD layer cache not available, rendering directly" << std::endl;
+        }
+
+        cacheSettings_ = settings;
+        layerValid_ = false;
+    }
+
+    // ============================================================================
+    // RENDERING BACKEND
+    // ============================================================================
+
+    void FlightHUD::setBackend(HudBackend backend)
+    {
+        if (backend == HudBackend::Sdf && !sdfRenderer_)
+        {
+            std::cerr << "[FlightHUD] SDF backend not available, keeping geometry backend" << std::endl;
+            return;
+        }
+        if (backend == backend_)
+            return;
+
+        reportBackendTotals(backend_);
+        backend_ = backend;
+        layerValid_ = false;
+
+        // Geometry backend draws every shape again through Renderer2D
+        if (backend_ == HudBackend::Geometry)
+        {
+            for (const auto &instrument : instruments_)
+            {
+                if (instrument)
+                    instrument->setShapesEnabled(true);
+            }
+        }
+
+        std::cout << "[FlightHUD] Backend: " << (backend_ == HudBackend::Sdf ? "SDF" : "Geometry") << std::endl;
+    }
+
+    void FlightHUD::toggleBackend()
+    {
+        setBackend(backend_ == HudBackend::Geometry ? HudBackend::Sdf : HudBackend::Geometry);
+    }
+
+    void FlightHUD::beginGpuTimer()
+    {
+        if (!gpuQueries_[0])
+            return;
+
+        // The slot about to be reused holds the query issued kGpuQueryCount frames ago
+        int slot = static_cast<int>(gpuQueryFrame_ % kGpuQueryCount);
+        if (gpuQueryFrame_ >= static_cast<uint64_t>(kGpuQueryCount))
+        {
+            GLint available = 0;
+            glGetQueryObjectiv(gpuQueries_[slot], GL_QUERY_RESULT_AVAILABLE, &available);
+            if (available)
+            {
+                GLuint64 elapsedNs = 0;
+                glGetQueryObjectui64v(gpuQueries_[slot], GL_QUERY_RESULT, &elapsedNs);
+                stats_.gpuMs = static_cast<float>(elapsedNs) / 1.0e6f;
+                stats_.gpuTimeValid = true;
+
+                BackendTotals &totals = totals_[static_cast<int>(gpuQueryBackend_[slot])];
+                totals.gpuSamples++;
+                totals.gpuMs += stats_.gpuMs;
+            }
+        }
+
+        gpuQueryBackend_[slot] = backend_;
+        glBeginQuery(GL_TIME_ELAPSED, gpuQueries_[slot]);
+    }
+
+    void FlightHUD::endGpuTimer()
+    {
+        if (!gpuQueries_[0])
+            return;
+
+        glEndQuery(GL_TIME_ELAPSED);
+        gpuQueryFrame_++;
+    }
+
+    void FlightHUD::reportBackendTotals(HudBackend backend)
+    {
+        BackendTotals &totals = totals_[static_cast<int>(backend)];
+        if (totals.frames > 0)
+        {
+            double frames = static_cast<double>(totals.frames);
+            std::cout << std::fixed << std::setprecision(3)
+                      << "[FlightHUD] " << (backend == HudBackend::Sdf ? "SDF" : "Geometry")
+                      << " backend over " << totals.frames << " frames: CPU " << totals.cpuMs / frames << " ms, "
+                      << static_cast<uint64_t>(totals.uploadBytes / frames) << " bytes uploaded, "
+                      << totals.drawCalls / frames << " draw calls";
+            if (totals.gpuSamples > 0)
+            {
+                std::cout << ", GPU " << totals.gpuMs / static_cast<double>(totals.gpuSamples) << " ms";
+            }
+            std::cout << " (per frame)" << std::defaultfloat << std::endl;
+            if (gfx::GLStats::enabled())
+            {
+                const gfx::GLCallCounters &gl = totals.gl;
+                std::cout << std::fixed << std::setprecision(1) << "[FlightHUD]   GL per frame: "
+                          << gl.drawCalls / frames << " draws, " << gl.vertices / frames << " vertices, "
+                          << gl.bufferBytes / frames << " bytes, binds tex " << gl.textureBinds / frames
+                          << " / prog " << gl.programBinds / frames << " / vao " << gl.vaoBinds / frames
+                          << " (" << gl.redundantBinds / frames << " redundant), "
+                          << gl.uniformUploads / frames << " uniforms" << std::defaultfloat << std::endl;
+            }
+        }
+        totals = BackendTotals{};
     }
 
     // ============================================================================
@@ -206,11 +649,57 @@ namespace hud
      * - "classic": Traditional aviation layout (large instruments).
      * - "modern": Compact and efficient layout.
      * - "minimal": Only essential information.
+     * - "stress": Classic plus STRESS_COPIES duplicates of every instrument.
      */
     void FlightHUD::setLayout(const std::string &layoutName)
     {
+        stressLayout_ = layoutName == "stress";
+
         // Reconfigure all instruments according to the selected layout
         setupInstrumentLayout();
+
+        std::cout << "[FlightHUD] Layout: " << layoutName << " (" << instruments_.size() << " instruments)" << std::endl;
+    }
+
+    // Copies of each base instrument in the "stress" layout, on a STRESS_GRID x STRESS_GRID grid.
+    static const int STRESS_GRID = 4;
+    static const int STRESS_COPIES = STRESS_GRID * STRESS_GRID - 1;
+
+    template <typename T>
+    static std::unique_ptr<Instrument> makeStressCopy(const Instrument &source, const glm::vec2 &offset)
+    {
+        auto copy = std::make_unique<T>();
+        copy->setPosition(source.getPosition() + offset);
+        copy->setSize(source.getSize());
+        copy->setColor(source.getColor() * glm::vec4(1.0f, 1.0f, 1.0f, 0.5f));
+        copy->setEnabled(source.isEnabled());
+        return copy;
+    }
+
+    void FlightHUD::rebuildStressInstruments()
+    {
+        instruments_.resize(baseInstrumentCount_);
+
+        if (stressLayout_)
+        {
+            // Spread the copies so they do not all land on the same pixels
+            glm::vec2 cell(screenWidth_ / static_cast<float>(STRESS_GRID * 2),
+                           screenHeight_ / static_cast<float>(STRESS_GRID * 2));
+            for (int copy = 1; copy <= STRESS_COPIES; ++copy)
+            {
+                glm::vec2 offset((copy % STRESS_GRID - STRESS_GRID / 2) * cell.x,
+                                 (copy / STRESS_GRID - STRESS_GRID / 2) * cell.y);
+
+                instruments_.push_back(makeStressCopy<Altimeter>(*altimeter_, offset));
+                instruments_.push_back(makeStressCopy<SpeedIndicator>(*speedIndicator_, offset));
+                instruments_.push_back(makeStressCopy<VerticalSpeedIndicator>(*verticalSpeedIndicator_, offset));
+                instruments_.push_back(makeStressCopy<WaypointIndicator>(*waypointIndicator_, offset));
+                instruments_.push_back(makeStressCopy<BankAngleIndicator>(*bankAngleIndicator_, offset));
+                instruments_.push_back(makeStressCopy<PitchLadder>(*pitchLadder_, offset));
+            }
+        }
+
+        resizeInstrumentBuffers();
     }
 
     /**
@@ -218,6 +707,8 @@ namespace hud
      */
     void FlightHUD::setupInstrumentLayout()
     {
+        layerValid_ = false;
+
         float centerX = screenWidth_ * 0.5f; // For future centered instruments
         float centerY = screenHeight_ * 0.5f;
 
@@ -333,6 +824,11 @@ namespace hud
             bankAngleIndicator_->setColor(hudColor_);
             bankAngleIndicator_->setEnabled(true);
         }
+
+        // ------------------------------------------------------------------------
+        // STRESS COPIES (only with the "stress" layout)
+        // ------------------------------------------------------------------------
+        rebuildStressInstruments();
     }
 
 } // namespace hud
@@ -4,13 +4,20 @@
  */
 
 #pragma once
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
 #include <glm/glm.hpp>
+#include "../../gfx/rendering/DrawList2D.h"
 #include "../../gfx/rendering/Renderer2D.h"
+#include "../../gfx/core/GLStats.h"
 #include "../../flight/data/FlightData.h"
 #include "Instrument.h"
+#include "SdfHudRenderer.h"
+#include "HudLayerCache.h"
 
 // Includes of implemented instruments
 #include "../instruments/flight/Altimeter.h"
@@ -20,8 +27,50 @@
 #include "../instruments/attitude/BankAngleIndicator.h"
 #include "../instruments/attitude/PitchLadder.h"
 
+namespace core
+{
+    class JobPool;
+}
+
 namespace hud
 {
+    /// How instrument shapes are produced; text always goes through Renderer2D.
+    enum class HudBackend
+    {
+        Geometry, ///< CPU-tessellated Renderer2D quads (default).
+        Sdf       ///< One analytic quad per instrument (SdfHudRenderer).
+    };
+
+    /// Cost of the last FlightHUD::render() call, for comparing backends.
+    struct HudRenderStats
+    {
+        HudBackend backend = HudBackend::Geometry;
+        float cpuMs = 0.0f;          ///< Wall time spent inside render() on the CPU.
+        std::size_t uploadBytes = 0; ///< Vertex/index/uniform bytes sent to the GPU.
+        std::size_t drawCalls = 0;   ///< Draw calls issued (Renderer2D flushes + SDF batches).
+        std::size_t sdfQuads = 0;    ///< Instruments drawn analytically.
+        float recordMs = 0.0f;       ///< Time spent recording instrument draw lists (0 if not rebuilt).
+        unsigned recordThreads = 1;  ///< Threads allowed to record this frame.
+        float gpuMs = 0.0f;          ///< GPU time of a recent frame (GL_TIME_ELAPSED, a few frames late).
+        bool gpuTimeValid = false;   ///< false until the first timer query result is available.
+
+        // Cached layer (only meaningful while layerCached is true)
+        bool layerCached = false;          ///< Instruments were composited from the offscreen layer.
+        bool layerRebuilt = false;         ///< The layer was re-rendered this frame.
+        bool dirtyCheckHit = false;        ///< Quantized data matched the layer, nothing to rebuild.
+        bool skippedRebuild = false;       ///< Data changed but the rebuild was deferred by the rate cap.
+        uint64_t totalLayerRebuilds = 0;   ///< Layer rebuilds since start-up.
+        uint64_t totalDirtyCheckHits = 0;  ///< Dirty-check hits since start-up.
+        uint64_t totalSkippedRebuilds = 0;  ///< Rate-limited rebuilds since start-up.
+    };
+
+    /// Controls the offscreen HUD layer.
+    struct HudCacheSettings
+    {
+        bool enabled = true;        ///< false renders the instruments straight to the framebuffer.
+        float maxRefreshHz = 60.0f; ///< Upper bound on layer rebuilds per second (<= 0: no cap).
+    };
+
     /**
      * @class FlightHUD
      * @brief Central coordinator for all HUD instruments.
@@ -34,7 +83,7 @@ namespace hud
     {
     public:
         FlightHUD();
-        ~FlightHUD() = default;
+        ~FlightHUD();
 
         // ========================================================================
         // INITIALIZATION AND CONFIGURATION
@@ -49,8 +98,47 @@ namespace hud
         /// Adjusts matrices and layouts when HUD resolution changes.
         void setScreenSize(int width, int height);
 
-        /// Allows toggling predefined layouts (classic/modern/minimal).
+        /**
+         * @brief Allows toggling predefined layouts (classic/modern/minimal).
+         *
+         * "stress" additionally duplicates every instrument many times to
+         * measure how draw list recording scales; any other name removes the
+         * copies again.
+         */
         void setLayout(const std::string &layoutName);
+        bool isStressLayout() const { return stressLayout_; }
+
+        /**
+         * @brief Shares the application job pool for parallel draw list recording.
+         *
+         * Without a pool (or with parallel recording disabled) instruments are
+         * recorded one after another on the calling thread.
+         */
+        void setJobPool(core::JobPool *jobPool) { jobPool_ = jobPool; }
+        void setParallelRecording(bool enabled) { parallelRecording_ = enabled; }
+        bool parallelRecording() const { return parallelRecording_; }
+
+        /**
+         * @brief Times draw list recording of the current layout with 1..N threads.
+         *
+         * Records `frames` frames per thread count without drawing them and logs
+         * the average time and speed-up. CPU only, so it can run at any time on
+         * the render thread.
+         */
+        void benchmarkRecording(int frames = 200);
+
+        /**
+         * @brief CPU-only set-up for headless checks (`--check-allocations`).
+         *
+         * Lays the instruments out for the given size without creating any GL
+         * object; only update() and recordDrawLists() may be used afterwards.
+         */
+        void initHeadless(int screenWidth, int screenHeight);
+
+        /// Records the draw lists for the current data on the calling thread, without drawing them.
+        void recordDrawLists() { recordInstruments(1); }
+        /// Lists filled by the last recording, one per instrument.
+        const std::vector<gfx::DrawList2D> &drawLists() const { return drawLists_; }
 
         // ========================================================================
         // UPDATE AND RENDERING
@@ -62,12 +150,104 @@ namespace hud
         /// Renders all instruments as a 2D overlay.
         void render();
 
+        // ========================================================================
+        // RENDERING BACKEND
+        // ========================================================================
+
+        /**
+         * @brief Selects how instrument shapes are drawn.
+         *
+         * Switching logs the averaged cost of the backend being left so both
+         * can be compared on the same machine. Requests for the SDF backend are
+         * ignored if its shaders failed to load.
+         */
+        void setBackend(HudBackend backend);
+        HudBackend backend() const { return backend_; }
+        void toggleBackend();
+
+        /// Cost of the last rendered frame.
+        const HudRenderStats &stats() const { return stats_; }
+
+        // ========================================================================
+        // LAYER CACHE
+        // ========================================================================
+
+        /**
+         * @brief Configures the offscreen HUD layer.
+         *
+         * With the cache enabled the instruments are rendered into a texture
+         * only when the quantized flight data changes, and never more often
+         * than `maxRefreshHz`; every frame composites that texture with one
+         * quad. Ignored (direct rendering) if the layer could not be created.
+         */
+        void setCacheSettings(const HudCacheSettings &settings);
+        const HudCacheSettings &cacheSettings() const { return cacheSettings_; }
+
+        /// Forces a layer rebuild on the next render().
+        void invalidateLayer() { layerValid_ = false; }
+
     private:
         // ========================================================================
         // RENDERING SYSTEM
         // ========================================================================
 
         std::unique_ptr<gfx::Renderer2D> renderer2D_; ///< Renderer shared among instruments.
+        std::unique_ptr<SdfHudRenderer> sdfRenderer_; ///< Analytic backend (null if unavailable).
+        HudBackend backend_ = HudBackend::Geometry;
+        std::vector<SdfInstrument> sdfBatch_; ///< One slot per instrument, filled every SDF frame.
+
+        // Draw list recording: one list per instrument, concatenated in instrument order.
+        std::vector<gfx::DrawList2D> drawLists_;
+        std::vector<const gfx::DrawList2D *> submitLists_; ///< Pointers into drawLists_ for Renderer2D::submit.
+        core::JobPool *jobPool_ = nullptr;                 ///< Owned by Application (may be null).
+        bool parallelRecording_ = true;
+
+        // GPU timing: a small ring of GL_TIME_ELAPSED queries read back without stalling.
+        static constexpr int kGpuQueryCount = 3;
+        GLuint gpuQueries_[kGpuQueryCount] = {};
+        HudBackend gpuQueryBackend_[kGpuQueryCount] = {};
+        uint64_t gpuQueryFrame_ = 0;
+
+        /// Running totals since the backend was last selected.
+        struct BackendTotals
+        {
+            uint64_t frames = 0;
+            double cpuMs = 0.0;
+            double uploadBytes = 0.0;
+            double drawCalls = 0.0;
+            uint64_t gpuSamples = 0;
+            double gpuMs = 0.0;
+            gfx::GLCallCounters gl{}; ///< Summed over the frames (FLIGHTSIM_GL_STATS builds).
+        };
+        BackendTotals totals_[2];
+        HudRenderStats stats_;
+
+        /**
+         * @brief FlightData reduced to what the instruments can show.
+         *
+         * Each field is rounded to a step below one pixel of movement (or one
+         * digit of readout) so sensor noise and paused frames compare equal.
+         */
+        struct QuantizedFlightData
+        {
+            int32_t pitch = 0;
+            int32_t roll = 0;
+            int32_t heading = 0;
+            int32_t airspeed = 0;
+            int32_t altitude = 0;
+            int32_t verticalSpeed = 0;
+            int32_t waypointBearing = 0;
+            int32_t waypointAltitudeDiff = 0;
+            bool hasActiveWaypoint = false;
+
+            bool operator==(const QuantizedFlightData &other) const;
+        };
+
+        std::unique_ptr<HudLayerCache> layerCache_; ///< Offscreen layer (null if unavailable).
+        HudCacheSettings cacheSettings_;
+        QuantizedFlightData layerData_;             ///< Data the layer was last rendered with.
+        bool layerValid_ = false;
+        std::chrono::steady_clock::time_point lastLayerBuild_;
 
         // ========================================================================
         // HUD INSTRUMENTS
@@ -76,6 +256,8 @@ namespace hud
         // Polymorphic container of instruments
         // Allows managing all instruments uniformly
         std::vector<std::unique_ptr<Instrument>> instruments_; ///< Polymorphic pool (ownership).
+        std::size_t baseInstrumentCount_ = 0;                   ///< Instruments before any stress copies.
+        bool stressLayout_ = false;
 
         // Quick references to specific instruments (optional)
         // Useful for direct configuration without traversing the vector
@@ -108,6 +290,26 @@ namespace hud
 
         /// Calculates positions/sizes for all current instruments.
         void setupInstrumentLayout();
+
+        /// Draws every enabled instrument with the current backend; fills the upload stats.
+        void drawInstruments();
+
+        /// Records every instrument into its own draw list, on up to `maxThreads` threads (0 = all).
+        void recordInstruments(unsigned maxThreads);
+
+        /// Replaces the stress copies with fresh ones placed around the base layout.
+        void rebuildStressInstruments();
+        /// Keeps drawLists_, submitLists_ and sdfBatch_ sized to instruments_.
+        void resizeInstrumentBuffers();
+
+        /// Decides whether the layer must be re-rendered this frame and records why not.
+        bool layerNeedsRebuild(std::chrono::steady_clock::time_point now);
+        static QuantizedFlightData quantize(const flight::FlightData &data);
+
+        /// Starts this frame's GPU timer after collecting the oldest finished one.
+        void beginGpuTimer();
+        void endGpuTimer();
+        void reportBackendTotals(HudBackend backend);
     };
 
 } // namespace hud
@@ -0,0 +1,124 @@
+#include "HudLayerCache.h"
+#include "../../gfx/core/GLCheck.h"
+#include "../../gfx/core/RenderState.h"
+#include <stdexcept>
+
+namespace hud
+{
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  Lifecycle
+    ////////////////////////////////////////////////////////////////////////////
+
+    HudLayerCache::~HudLayerCache()
+    {
+        destroyTargets();
+        if (vao_)
+        {
+            gfx::RenderState::forgetVertexArray(vao_);
+            glDeleteVertexArrays(1, &vao_);
+        }
+    }
+
+    void HudLayerCache::init(int width, int height)
+    {
+        shader_.load("shaders/hud_layer.vert", "shaders/hud_layer.frag");
+        glGenVertexArrays(1, &vao_);
+
+        width_ = width;
+        height_ = height;
+        createTargets();
+    }
+
+    void HudLayerCache::resize(int width, int height)
+    {
+        // Minimized windows report 0x0; keep the old target until a real size arrives
+        if (width <= 0 || height <= 0 || (width == width_ && height == height_))
+            return;
+
+        width_ = width;
+        height_ = height;
+        destroyTargets();
+        createTargets();
+    }
+
+    void HudLayerCache::createTargets()
+    {
+        glGenTextures(1, &texture_);
+        gfx::RenderState::bindTexture(0, GL_TEXTURE_2D, texture_);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width_, height_, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+        GLint previousFbo = 0;
+        glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previousFbo);
+
+        glGenFramebuffers(1, &fbo_);
+        glBindFramebuffer(GL_FRAMEBUFFER, fbo_);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture_, 0);
+        GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+        glBindFramebuffer(GL_FRAMEBUFFER, previousFbo);
+
+        if (status != GL_FRAMEBUFFER_COMPLETE)
+        {
+            destroyTargets();
+            throw std::runtime_error("HUD layer framebuffer is incomplete");
+        }
+
+        gfx::checkGLError("Creating HUD layer");
+    }
+
+    void HudLayerCache::destroyTargets()
+    {
+        if (fbo_)
+            glDeleteFramebuffers(1, &fbo_);
+        if (texture_)
+        {
+            gfx::RenderState::forgetTexture(texture_);
+            glDeleteTextures(1, &texture_);
+        }
+        fbo_ = 0;
+        texture_ = 0;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  Capture and Composite
+    ////////////////////////////////////////////////////////////////////////////
+
+    void HudLayerCache::beginCapture()
+    {
+        glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previousFbo_);
+        glGetIntegerv(GL_VIEWPORT, previousViewport_);
+
+        glBindFramebuffer(GL_FRAMEBUFFER, fbo_);
+        glViewport(0, 0, width_, height_);
+        glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+        glClear(GL_COLOR_BUFFER_BIT);
+    }
+
+    void HudLayerCache::endCapture()
+    {
+        glBindFramebuffer(GL_FRAMEBUFFER, previousFbo_);
+        glViewport(previousViewport_[0], previousViewport_[1], previousViewport_[2], previousViewport_[3]);
+    }
+
+    void HudLayerCache::composite()
+    {
+        // The layer holds premultiplied color
+        gfx::RenderState::setBlend(true);
+        gfx::RenderState::setBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+        gfx::RenderState::setDepthTest(false);
+
+        shader_.use();
+        shader_.setInt("uLayer", 0);
+        gfx::RenderState::bindTexture(0, GL_TEXTURE_2D, texture_);
+
+        gfx::RenderState::bindVertexArray(vao_);
+        glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+
+        gfx::checkGLError("Compositing HUD layer");
+    }
+
+} // namespace hud
@@ -0,0 +1,63 @@
+/**
+ * @file HudLayerCache.h
+ * @brief Offscreen render target that keeps the last rendered HUD frame.
+ */
+
+#pragma once
+#include "../../gfx/core/Shader.h"
+
+namespace hud
+{
+    /**
+     * @class HudLayerCache
+     * @brief Screen-sized RGBA layer the HUD is rendered into and composited from.
+     *
+     * FlightHUD renders its instruments into this layer only when the displayed
+     * data changes; every other frame the layer is composited over the 3D scene
+     * with a single textured quad. The layer stores premultiplied alpha, so the
+     * capture pass must use `glBlendFuncSeparate(SRC_ALPHA, ONE_MINUS_SRC_ALPHA,
+     * ONE, ONE_MINUS_SRC_ALPHA)`; composite() sets its own blending.
+     */
+    class HudLayerCache
+    {
+    public:
+        HudLayerCache() = default;
+        ~HudLayerCache();
+
+        HudLayerCache(const HudLayerCache &) = delete;
+        HudLayerCache &operator=(const HudLayerCache &) = delete;
+
+        /**
+         * @brief Creates the framebuffer, its color texture and the composite program.
+         * @throws std::runtime_error if the framebuffer is incomplete or the shaders fail.
+         */
+        void init(int width, int height);
+
+        /// Recreates the color target for a new HUD resolution.
+        void resize(int width, int height);
+
+        /// Binds the layer as render target and clears it to transparent.
+        void beginCapture();
+
+        /// Restores the framebuffer and viewport that were bound before beginCapture().
+        void endCapture();
+
+        /// Draws the layer over the current framebuffer with one quad.
+        void composite();
+
+    private:
+        void createTargets();
+        void destroyTargets();
+
+        gfx::Shader shader_;
+        GLuint fbo_ = 0;
+        GLuint texture_ = 0;
+        GLuint vao_ = 0; ///< Empty VAO; quad corners come from gl_VertexID.
+        int width_ = 0;
+        int height_ = 0;
+
+        GLint previousFbo_ = 0;
+        GLint previousViewport_[4] = {0, 0, 0, 0};
+    };
+
+} // namespace hud
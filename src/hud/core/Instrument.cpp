@@ -6,7 +6,8 @@ namespace hud
         : position_(0.0f, 0.0f),
           size_(100.0f, 100.0f),
           color_(0.0f, 1.0f, 0.4f, 0.95f),
-          enabled_(true)
+          enabled_(true),
+          shapesEnabled_(true)
     {
         // Reasonable default values so a newly created instrument
         // can render even before FlightHUD assigns it a layout:
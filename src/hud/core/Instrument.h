@@ -5,8 +5,9 @@
 
 #pragma once
 #include <glm/glm.hpp>
-#include "../../gfx/rendering/Renderer2D.h"
+#include "../../gfx/rendering/DrawList2D.h"
 #include "../../flight/data/FlightData.h"
+#include "SdfInstrument.h"
 
 namespace hud
 {
@@ -18,7 +19,7 @@ namespace hud
      * It provides:
      * - Common properties (position, size, color) expressed in pixels relative to the HUD viewport.
      * - Configuration methods (setters) to integrate with layouts calculated by FlightHUD.
-     * - Rendering interface (pure virtual method) that receives the Renderer2D and updated flight data.
+     * - Rendering interface (pure virtual method) that receives a draw list and updated flight data.
      *
      * Each specific instrument (Altimeter, AttitudeIndicator, etc.)
      * must inherit from this class and implement its own render() method.
@@ -77,6 +78,15 @@ namespace hud
          */
         void setEnabled(bool enabled) { enabled_ = enabled; }
 
+        /**
+         * @brief Enables or disables the geometric part of render().
+         * @param enabled false to emit only text labels.
+         *
+         * Used by the SDF backend: ticks, lines and circles come from the
+         * instrument quad, while labels keep going through Renderer2D.
+         */
+        void setShapesEnabled(bool enabled) { shapesEnabled_ = enabled; }
+
         // ====================================================================
         // ACCESS METHODS (GETTERS)
         // ====================================================================
@@ -85,6 +95,7 @@ namespace hud
         const glm::vec2 &getSize() const { return size_; }
         const glm::vec4 &getColor() const { return color_; }
         bool isEnabled() const { return enabled_; }
+        bool shapesEnabled() const { return shapesEnabled_; }
 
         // ====================================================================
         // RENDERING INTERFACE
@@ -92,13 +103,30 @@ namespace hud
 
         /**
          * @brief Renders the instrument on screen.
-         * @param renderer Shared 2D renderer.
+         * @param renderer Draw list owned by this instrument for the frame.
          * @param flightData Current flight data.
          *
          * This method must be implemented by each specific instrument.
          * It is responsible for drawing all visual elements of the instrument.
+         * FlightHUD may call it on a worker thread, concurrently with other
+         * instruments: it must not issue GL calls or write state shared with
+         * other instruments.
+         */
+        virtual void render(gfx::DrawList2D &renderer, const flight::FlightData &flightData) = 0;
+
+        /**
+         * @brief Describes the instrument shapes for the analytic (SDF) backend.
+         * @param flightData Current flight data.
+         * @param out Parameter block to fill.
+         * @return false if the instrument has no SDF version or nothing to draw
+         *         this frame; it is then rendered entirely through render().
          */
-        virtual void render(gfx::Renderer2D &renderer, const flight::FlightData &flightData) = 0;
+        virtual bool buildSdfInstrument(const flight::FlightData &flightData, SdfInstrument &out) const
+        {
+            (void)flightData;
+            (void)out;
+            return false;
+        }
 
     protected:
         // ====================================================================
@@ -109,6 +137,7 @@ namespace hud
         glm::vec2 size_;     ///< Instrument size (width, height).
         glm::vec4 color_;    ///< Main RGBA color.
         bool enabled_;       ///< Whether the instrument is active/visible.
+        bool shapesEnabled_; ///< false when shapes are drawn by the SDF backend.
     };
 
 } // namespace hud
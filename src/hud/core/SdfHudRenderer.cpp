@@ -0,0 +1,85 @@
+#include "SdfHudRenderer.h"
+#include "../../gfx/core/GLCheck.h"
+#include "../../gfx/core/RenderState.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace hud
+{
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  Lifecycle
+    ////////////////////////////////////////////////////////////////////////////
+
+    SdfHudRenderer::~SdfHudRenderer()
+    {
+        if (ubo_)
+            glDeleteBuffers(1, &ubo_);
+        if (vao_)
+        {
+            gfx::RenderState::forgetVertexArray(vao_);
+            glDeleteVertexArrays(1, &vao_);
+        }
+    }
+
+    void SdfHudRenderer::init(int screenWidth, int screenHeight)
+    {
+        shader_.load("shaders/hud_sdf.vert", "shaders/hud_sdf.frag");
+
+        if (!shader_.bindUniformBlock("HudSdfBlock", kBlockBinding))
+        {
+            throw std::runtime_error("hud_sdf shaders do not declare the HudSdfBlock uniform block");
+        }
+
+        glGenVertexArrays(1, &vao_);
+        glGenBuffers(1, &ubo_);
+        glBindBuffer(GL_UNIFORM_BUFFER, ubo_);
+        glBufferData(GL_UNIFORM_BUFFER, sizeof(UniformBlock), nullptr, GL_DYNAMIC_DRAW);
+        glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+        setScreenSize(screenWidth, screenHeight);
+        gfx::checkGLError("Setting up SDF HUD renderer");
+    }
+
+    void SdfHudRenderer::setScreenSize(int width, int height)
+    {
+        block_.screen = glm::vec4(static_cast<float>(width), static_cast<float>(height), 0.0f, 0.0f);
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  Drawing
+    ////////////////////////////////////////////////////////////////////////////
+
+    void SdfHudRenderer::draw(const SdfInstrument *instruments, std::size_t count)
+    {
+        if (!instruments || count == 0)
+            return;
+
+        shader_.use();
+        gfx::RenderState::bindVertexArray(vao_);
+        glBindBufferBase(GL_UNIFORM_BUFFER, kBlockBinding, ubo_);
+
+        for (std::size_t offset = 0; offset < count; offset += kMaxInstrumentsPerBatch)
+        {
+            std::size_t batch = std::min(kMaxInstrumentsPerBatch, count - offset);
+            std::copy(instruments + offset, instruments + offset + batch, block_.instruments);
+
+            // Only the header and the used part of the array are uploaded.
+            std::size_t bytes = sizeof(glm::vec4) + batch * sizeof(SdfInstrument);
+            glBufferSubData(GL_UNIFORM_BUFFER, 0, bytes, &block_);
+            glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, static_cast<GLsizei>(batch));
+
+            uploadedBytes_ += bytes;
+            drawCalls_++;
+        }
+
+        gfx::checkGLError("Drawing SDF HUD");
+    }
+
+    void SdfHudRenderer::resetStats()
+    {
+        uploadedBytes_ = 0;
+        drawCalls_ = 0;
+    }
+
+} // namespace hud
@@ -0,0 +1,77 @@
+/**
+ * @file SdfHudRenderer.h
+ * @brief Analytic HUD backend: one shader-evaluated quad per instrument.
+ */
+
+#pragma once
+#include <cstddef>
+#include <glm/glm.hpp>
+#include "../../gfx/core/Shader.h"
+#include "SdfInstrument.h"
+
+namespace hud
+{
+    /**
+     * @class SdfHudRenderer
+     * @brief Draws instrument shapes as signed distance fields in `hud_sdf.frag`.
+     *
+     * Instead of tessellating ticks, arcs and lines into Renderer2D quads on the
+     * CPU, each instrument uploads a 128-byte `SdfInstrument` block and is drawn
+     * as one instanced quad with no vertex buffer. The fragment shader evaluates
+     * the distance to every shape of the instrument per pixel. Text labels are
+     * not handled here; they keep going through Renderer2D.
+     */
+    class SdfHudRenderer
+    {
+    public:
+        /// Array size of `uInstruments` in the shaders; larger batches are split.
+        static constexpr std::size_t kMaxInstrumentsPerBatch = 32;
+
+        SdfHudRenderer() = default;
+        ~SdfHudRenderer();
+
+        SdfHudRenderer(const SdfHudRenderer &) = delete;
+        SdfHudRenderer &operator=(const SdfHudRenderer &) = delete;
+
+        /**
+         * @brief Compiles the SDF program and creates the uniform buffer.
+         * @throws std::runtime_error if the shaders fail or the block is missing.
+         */
+        void init(int screenWidth, int screenHeight);
+
+        /// Updates the pixel-to-NDC mapping when the HUD resolution changes.
+        void setScreenSize(int width, int height);
+
+        /**
+         * @brief Draws `count` instruments with one instanced call per batch.
+         *
+         * Expects blending already configured by the caller (FlightHUD).
+         */
+        void draw(const SdfInstrument *instruments, std::size_t count);
+
+        /// Clears the per-frame counters.
+        void resetStats();
+
+        std::size_t uploadedBytes() const { return uploadedBytes_; } ///< Uniform bytes sent since resetStats().
+        std::size_t drawCalls() const { return drawCalls_; }         ///< Instanced draws since resetStats().
+
+    private:
+        /// CPU mirror of `HudSdfBlock` (std140).
+        struct UniformBlock
+        {
+            glm::vec4 screen;
+            SdfInstrument instruments[kMaxInstrumentsPerBatch];
+        };
+
+        static constexpr GLuint kBlockBinding = 0; ///< Uniform buffer binding point.
+
+        gfx::Shader shader_;
+        GLuint vao_ = 0; ///< Empty VAO (core profile needs one bound to draw).
+        GLuint ubo_ = 0;
+        UniformBlock block_{};
+
+        std::size_t uploadedBytes_ = 0;
+        std::size_t drawCalls_ = 0;
+    };
+
+} // namespace hud
@@ -0,0 +1,47 @@
+/**
+ * @file SdfInstrument.h
+ * @brief Per-instrument parameter block consumed by the analytic (SDF) HUD shader.
+ */
+
+#pragma once
+#include <glm/glm.hpp>
+
+namespace hud
+{
+    /**
+     * @brief Shape program selected in `hud_sdf.frag` for one instrument quad.
+     *
+     * Values must match the `KIND_*` constants in the shader.
+     */
+    enum class SdfShape : int
+    {
+        Tape = 1,          ///< Scrolling tape (speed, altitude).
+        VerticalSpeed = 2, ///< Fixed VSI scale with moving triangle.
+        Compass = 3,       ///< HSI rose, waypoint pointer and altitude bug.
+        BankAngle = 4,     ///< Inclined bank scale with fixed needle.
+        PitchLadder = 5    ///< Rotating pitch lines and crosshair.
+    };
+
+    /**
+     * @brief One instrument in the SDF uniform block (std140 layout, 128 bytes).
+     *
+     * Every field is a vec4 so the C++ struct and the GLSL struct share the same
+     * layout without padding rules. `p0..p3` are interpreted per `SdfShape`; each
+     * instrument documents its packing in `buildSdfInstrument`. All positions are
+     * in HUD pixels (origin top-left), like the Renderer2D path.
+     */
+    struct SdfInstrument
+    {
+        glm::vec4 rect;   ///< Quad covered by the instrument: x, y, width, height.
+        glm::vec4 color;  ///< Main instrument color.
+        glm::vec4 accent; ///< Secondary color (needle, altitude bug).
+        glm::vec4 p0;
+        glm::vec4 p1;
+        glm::vec4 p2;
+        glm::vec4 p3;
+        glm::ivec4 kind; ///< x = SdfShape, yzw unused.
+    };
+
+    static_assert(sizeof(SdfInstrument) == 128, "SdfInstrument must match the std140 block layout");
+
+} // namespace hud
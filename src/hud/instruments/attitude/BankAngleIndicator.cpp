@@ -1,9 +1,12 @@
 #include "BankAngleIndicator.h"
+#include "../../../util/FixedString.h"
+#include <algorithm>
 #include <cmath>
-#include <string>
 
 namespace hud
 {
+    // Brighter green used for the fixed needle (both backends)
+    static const glm::vec4 NEEDLE_COLOR = glm::vec4(0.0f, 1.0f, 0.2f, 1.0f);
 
     BankAngleIndicator::BankAngleIndicator() : Instrument()
     {
@@ -11,7 +14,7 @@ namespace hud
         color_ = glm::vec4(0.0f, 1.0f, 0.4f, 0.95f);
     }
 
-    void BankAngleIndicator::render(gfx::Renderer2D &renderer, const flight::FlightData &flightData)
+    void BankAngleIndicator::render(gfx::DrawList2D &renderer, const flight::FlightData &flightData)
     {
         if (!enabled_)
             return;
@@ -38,10 +41,11 @@ namespace hud
                         leftPx.x, leftPx.y, rightPx.x, rightPx.y,
                         rollAngle);
 
-        drawNeedle(renderer, centerX, centerY);
+        if (shapesEnabled_)
+            drawNeedle(renderer, centerX, centerY);
     }
 
-    void BankAngleIndicator::drawBaseLine(gfx::Renderer2D &renderer, float centerX, float centerY)
+    void BankAngleIndicator::drawBaseLine(gfx::DrawList2D &renderer, float centerX, float centerY)
     {
         // Convert line endpoints to pixels
         glm::vec2 leftPx = ndcToPixels(-NDC_LINE_WIDTH * 0.5f,
@@ -52,7 +56,7 @@ namespace hud
         renderer.drawLine(leftPx, rightPx, color_, 1.5f);
     }
 
-    void BankAngleIndicator::drawGraduations(gfx::Renderer2D &renderer, float centerX, float centerY,
+    void BankAngleIndicator::drawGraduations(gfx::DrawList2D &renderer, float centerX, float centerY,
                                              float leftX, float leftY, float rightX, float rightY,
                                              float rollAngle)
     {
@@ -86,7 +90,8 @@ namespace hud
                 // Draw vertical graduation line
                 glm::vec2 markTop(lineX, lineY - markHeightPx * 0.5f);
                 glm::vec2 markBot(lineX, lineY + markHeightPx * 0.5f);
-                renderer.drawLine(markTop, markBot, color_, 1.5f);
+                if (shapesEnabled_)
+                    renderer.drawLine(markTop, markBot, color_, 1.5f);
 
                 // Show text every 20 degrees (multiples of 2 lines of 10 degrees), excluding 0 degrees
                 if (i % 2 == 0 && lineAngle != 0.0f)
@@ -105,7 +110,7 @@ namespace hud
 
                     gfx::TextRenderer::drawString(
                         renderer,
-                        std::to_string(displayValue),
+                        util::LabelString("%d", displayValue),
                         textPos,
                         glm::vec2(DIGIT_WIDTH, DIGIT_HEIGHT),
                         color_,
@@ -119,7 +124,7 @@ namespace hud
         }
     }
 
-    void BankAngleIndicator::drawNeedle(gfx::Renderer2D &renderer, float centerX, float centerY)
+    void BankAngleIndicator::drawNeedle(gfx::DrawList2D &renderer, float centerX, float centerY)
     {
         // Place the needle slightly below the center
         float needleOffsetPx = NDC_NEEDLE_OFFSET * size_.y * 0.5f;
@@ -134,12 +139,46 @@ namespace hud
         glm::vec2 baseRight(centerX + triangleSizePx * 0.6f, needleY - triangleSizePx * 0.3f); // Right base
 
         // Brighter color for the needle
-        glm::vec4 needleColor = glm::vec4(0.0f, 1.0f, 0.2f, 1.0f);
+        glm::vec4 needleColor = NEEDLE_COLOR;
 
         // Draw triangle (outline)
         renderer.drawTriangle(tip, baseLeft, baseRight, needleColor, false);
     }
 
+    bool BankAngleIndicator::buildSdfInstrument(const flight::FlightData &flightData, SdfInstrument &out) const
+    {
+        if (!enabled_)
+            return false;
+
+        glm::vec2 centerPx = ndcToPixels(0.0f, NDC_CENTER_Y);
+        glm::vec2 leftPx = ndcToPixels(-NDC_LINE_WIDTH * 0.5f,
+                                       NDC_CENTER_Y - NDC_LINE_SLOPE * NDC_LINE_WIDTH * 0.5f);
+        glm::vec2 rightPx = ndcToPixels(NDC_LINE_WIDTH * 0.5f,
+                                        NDC_CENTER_Y + NDC_LINE_SLOPE * NDC_LINE_WIDTH * 0.5f);
+        float majorHeightPx = NDC_MARK_HEIGHT_MAJOR * size_.y * 0.5f;
+        float minorHeightPx = NDC_MARK_HEIGHT_MINOR * size_.y * 0.5f;
+        float needleY = centerPx.y - NDC_NEEDLE_OFFSET * size_.y * 0.5f;
+        float triangleSizePx = NDC_TRIANGLE_SIZE * size_.y * 0.5f;
+
+        // Only the band around the inclined line is covered, not the whole screen.
+        float minY = std::min(std::min(leftPx.y, rightPx.y) - majorHeightPx, needleY - triangleSizePx);
+        float maxY = std::max(std::max(leftPx.y, rightPx.y) + majorHeightPx, needleY + triangleSizePx);
+
+        // p0: roll (deg), degrees per line, line spacing / line width (NDC ratio)
+        // p1: left and right end of the inclined line
+        // p2: major and minor mark heights
+        // p3: needle center X/Y and triangle size
+        out.rect = glm::vec4(leftPx.x - 4.0f, minY - 4.0f, (rightPx.x - leftPx.x) + 8.0f, (maxY - minY) + 8.0f);
+        out.color = color_;
+        out.accent = NEEDLE_COLOR;
+        out.p0 = glm::vec4(normalizeRoll(flightData.roll), DEGREES_PER_LINE, NDC_LINE_SPACING / NDC_LINE_WIDTH, 0.0f);
+        out.p1 = glm::vec4(leftPx.x, leftPx.y, rightPx.x, rightPx.y);
+        out.p2 = glm::vec4(majorHeightPx, minorHeightPx, 0.0f, 0.0f);
+        out.p3 = glm::vec4(centerPx.x, needleY, triangleSizePx, 0.0f);
+        out.kind = glm::ivec4(static_cast<int>(SdfShape::BankAngle), 0, 0, 0);
+        return true;
+    }
+
     glm::vec2 BankAngleIndicator::ndcToPixels(float ndcX, float ndcY) const
     {
         // NDC: -1.0 to 1.0, origin at center
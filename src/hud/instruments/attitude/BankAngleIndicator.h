@@ -5,7 +5,7 @@
 
 #pragma once
 #include "../../core/Instrument.h"
-#include "../../../gfx/rendering/Renderer2D.h"
+#include "../../../gfx/rendering/DrawList2D.h"
 #include "../../../gfx/rendering/TextRenderer.h"
 #include "../../../flight/data/FlightData.h"
 #include <glm/glm.hpp>
@@ -33,10 +33,13 @@ namespace hud
 
         /**
          * @brief Renders the bank angle indicator.
-         * @param renderer Shared Renderer2D.
+         * @param renderer Draw list the instrument records into.
          * @param flightData Flight data (uses flightData.roll).
          */
-        void render(gfx::Renderer2D &renderer, const flight::FlightData &flightData) override;
+        void render(gfx::DrawList2D &renderer, const flight::FlightData &flightData) override;
+
+        /// Packs the instrument shapes for the SDF backend (see SdfInstrument).
+        bool buildSdfInstrument(const flight::FlightData &flightData, SdfInstrument &out) const override;
 
     private:
         // ====================================================================
@@ -74,7 +77,7 @@ namespace hud
          * The bar acts as a slightly inclined static horizon.
          * It is left disabled by default for a cleaner HUD.
          */
-        void drawBaseLine(gfx::Renderer2D &renderer, float centerX, float centerY);
+        void drawBaseLine(gfx::DrawList2D &renderer, float centerX, float centerY);
 
         /**
          * @brief Draws the 5 moving graduated marks and their numbers.
@@ -82,7 +85,7 @@ namespace hud
          * Calculates the relative position of each mark with respect to the current roll
          * and limits visibility to two marks per side to reduce noise.
          */
-        void drawGraduations(gfx::Renderer2D &renderer, float centerX, float centerY,
+        void drawGraduations(gfx::DrawList2D &renderer, float centerX, float centerY,
                              float leftX, float leftY, float rightX, float rightY,
                              float rollAngle);
 
@@ -91,7 +94,7 @@ namespace hud
          *
          * Highlights the static reference point with a brighter color.
          */
-        void drawNeedle(gfx::Renderer2D &renderer, float centerX, float centerY);
+        void drawNeedle(gfx::DrawList2D &renderer, float centerX, float centerY);
 
         /**
          * @brief Converts NDC coordinates to pixels within the assigned viewport.
@@ -15,9 +15,10 @@ namespace hud
         color_ = glm::vec4(0.0f, 1.0f, 0.4f, 0.95f);
     }
 
-    void PitchLadder::render(gfx::Renderer2D &renderer, const flight::FlightData &flightData)
+    void PitchLadder::render(gfx::DrawList2D &renderer, const flight::FlightData &flightData)
     {
-        if (!enabled_)
+        // The ladder has no labels: with the SDF backend there is nothing left to draw here
+        if (!enabled_ || !shapesEnabled_)
             return;
 
         // Viewport dimensions
@@ -35,7 +36,7 @@ namespace hud
         drawPitchLines(renderer, centerX, centerY, flightData.pitch, flightData.roll);
     }
 
-    void PitchLadder::drawCrosshair(gfx::Renderer2D &renderer, float centerX, float centerY)
+    void PitchLadder::drawCrosshair(gfx::DrawList2D &renderer, float centerX, float centerY)
     {
         // Convert circle radius to pixels
         float radiusPx = ndcDimensionToPixels(NDC_CIRCLE_RADIUS, size_.y);
@@ -57,7 +58,7 @@ namespace hud
         renderer.drawLine(rightStart, rightEnd, color_, 2.0f);
     }
 
-    void PitchLadder::drawPitchLines(gfx::Renderer2D &renderer, float centerX, float centerY, float pitchAngle, float rollAngle)
+    void PitchLadder::drawPitchLines(gfx::DrawList2D &renderer, float centerX, float centerY, float pitchAngle, float rollAngle)
     {
         // Calculate center line index based on current pitch
         int centerLineIndex = static_cast<int>(std::round(pitchAngle / PITCH_STEP));
@@ -75,7 +76,7 @@ namespace hud
         }
     }
 
-    void PitchLadder::drawSinglePitchLine(gfx::Renderer2D &renderer, float centerX, float centerY,
+    void PitchLadder::drawSinglePitchLine(gfx::DrawList2D &renderer, float centerX, float centerY,
                                           float pitchLineAngle, float currentPitch, float rollAngle)
     {
         // Difference between desired division and current pitch
@@ -155,6 +156,40 @@ namespace hud
         }
     }
 
+    bool PitchLadder::buildSdfInstrument(const flight::FlightData &flightData, SdfInstrument &out) const
+    {
+        if (!enabled_)
+            return false;
+
+        float centerX = position_.x + size_.x * 0.5f;
+        float centerY = position_.y + size_.y * 0.5f;
+        float zeroWidthPx = ndcDimensionToPixels(NDC_LINE_WIDTH_ZERO, size_.x);
+        float visibilityPx = NDC_VISIBILITY_LIMIT * size_.y * 0.5f;
+        float markerPx = ndcDimensionToPixels(NDC_MARKER_SIZE, size_.y);
+
+        // Lines rotate with roll, so the quad is the square around their bounding circle.
+        float radius = std::sqrt(zeroWidthPx * zeroWidthPx +
+                                 (visibilityPx + markerPx) * (visibilityPx + markerPx)) + 4.0f;
+
+        // p0: pitch, roll (deg), ladder center
+        // p1: crosshair radius, lateral line length, center gap, end marker size
+        // p2: normal line half-width, zero line half-width, pixels per degree, visibility limit
+        // p3: pitch step and maximum displayed pitch (deg)
+        out.rect = glm::vec4(centerX - radius, centerY - radius, radius * 2.0f, radius * 2.0f);
+        out.color = color_;
+        out.accent = color_;
+        out.p0 = glm::vec4(flightData.pitch, flightData.roll, centerX, centerY);
+        out.p1 = glm::vec4(ndcDimensionToPixels(NDC_CIRCLE_RADIUS, size_.y),
+                           ndcDimensionToPixels(NDC_LATERAL_LINE_LENGTH, size_.x),
+                           ndcDimensionToPixels(NDC_GAP, size_.x),
+                           markerPx);
+        out.p2 = glm::vec4(ndcDimensionToPixels(NDC_LINE_WIDTH_NORMAL, size_.x), zeroWidthPx,
+                           NDC_PER_DEGREE * size_.y * 0.5f, visibilityPx);
+        out.p3 = glm::vec4(PITCH_STEP, MAX_PITCH_DISPLAY, 0.0f, 0.0f);
+        out.kind = glm::ivec4(static_cast<int>(SdfShape::PitchLadder), 0, 0, 0);
+        return true;
+    }
+
     float PitchLadder::ndcDimensionToPixels(float ndcDim, float axisLength) const
     {
         // Scales an NDC percentage to the equivalent amount in pixels
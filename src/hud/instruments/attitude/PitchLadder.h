@@ -5,7 +5,7 @@
 
 #pragma once
 #include "../../core/Instrument.h"
-#include "../../../gfx/rendering/Renderer2D.h"
+#include "../../../gfx/rendering/DrawList2D.h"
 #include "../../../flight/data/FlightData.h"
 #include <glm/glm.hpp>
 
@@ -32,10 +32,13 @@ namespace hud
 
         /**
          * @brief Renders the pitch ladder.
-         * @param renderer Shared Renderer2D.
+         * @param renderer Draw list the instrument records into.
          * @param flightData Flight data (uses flightData.pitch).
          */
-        void render(gfx::Renderer2D &renderer, const flight::FlightData &flightData) override;
+        void render(gfx::DrawList2D &renderer, const flight::FlightData &flightData) override;
+
+        /// Packs the instrument shapes for the SDF backend (see SdfInstrument).
+        bool buildSdfInstrument(const flight::FlightData &flightData, SdfInstrument &out) const override;
 
     private:
         // ====================================================================
@@ -72,7 +75,7 @@ namespace hud
          *
          * This crosshair serves as an absolute reference; it does not depend on pitch.
          */
-        void drawCrosshair(gfx::Renderer2D &renderer, float centerX, float centerY);
+        void drawCrosshair(gfx::DrawList2D &renderer, float centerX, float centerY);
 
         /**
          * @brief Draws the 5 dynamic pitch lines.
@@ -80,7 +83,7 @@ namespace hud
          * Calculates visible lines around the current pitch and limits
          * output to +/- 2 divisions to avoid cluttering the screen.
          */
-        void drawPitchLines(gfx::Renderer2D &renderer, float centerX, float centerY, float pitchAngle, float rollAngle);
+        void drawPitchLines(gfx::DrawList2D &renderer, float centerX, float centerY, float pitchAngle, float rollAngle);
 
         /**
          * @brief Draws a single pitch line.
@@ -91,7 +94,7 @@ namespace hud
          * Responsible for positioning, clipping with central gap, and placing
          * vertical markers that distinguish between positive/negative pitch.
          */
-        void drawSinglePitchLine(gfx::Renderer2D &renderer, float centerX, float centerY,
+        void drawSinglePitchLine(gfx::DrawList2D &renderer, float centerX, float centerY,
                                  float pitchLineAngle, float currentPitch, float rollAngle);
 
         /**
@@ -1,5 +1,6 @@
 #include "Altimeter.h"
 #include "../../../gfx/rendering/TextRenderer.h"
+#include "../../../util/FixedString.h"
 #include <cmath>
 
 namespace hud
@@ -29,6 +30,10 @@ namespace hud
     static const float CHEVRON_WIDTH = 10.0f;
     static const float CHEVRON_HEIGHT = 12.0f;
 
+    // Culling and SDF quad bounds
+    static const float CULLING_MARGIN = 30.0f;  // Marks kept slightly beyond the tape ends
+    static const float SDF_SIDE_MARGIN = 16.0f; // Extra quad width so the chevron fits
+
     Altimeter::Altimeter() : Instrument()
     {
         // Altimeter-specific configuration
@@ -40,7 +45,7 @@ namespace hud
     //  Main Render Function
     ////////////////////////////////////////////////////////////////////////////
 
-    void Altimeter::render(gfx::Renderer2D &renderer, const flight::FlightData &flightData)
+    void Altimeter::render(gfx::DrawList2D &renderer, const flight::FlightData &flightData)
     {
         if (!enabled_)
             return;
@@ -52,7 +57,7 @@ namespace hud
         drawCurrentAltitudeBox(renderer, altitude);
     }
 
-    void Altimeter::drawBackground(gfx::Renderer2D &renderer)
+    void Altimeter::drawBackground(gfx::DrawList2D &renderer)
     {
         // Altimeter has no background - only draw elements on transparent HUD
     }
@@ -61,7 +66,7 @@ namespace hud
     //  Altitude Tape (Moving Scale)
     ////////////////////////////////////////////////////////////////////////////
 
-    void Altimeter::drawAltitudeTape(gfx::Renderer2D &renderer, float altitude)
+    void Altimeter::drawAltitudeTape(gfx::DrawList2D &renderer, float altitude)
     {
         // Calculate reference positions
         float centerY = position_.y + size_.y * 0.5f; // Vertical center of instrument
@@ -78,7 +83,6 @@ namespace hud
             int markAltitude = (int)baseAltitude + i * (int)ALTITUDE_STEP;
             float markY = centerY + scrollOffset - i * PIXELS_PER_STEP;
 
-            const float CULLING_MARGIN = 30.0f;
             if (markY < position_.y - CULLING_MARGIN || markY > position_.y + size_.y + CULLING_MARGIN)
                 continue;
 
@@ -88,17 +92,20 @@ namespace hud
             if (insideReadoutBox)
                 continue;
 
-            renderer.drawRect(
-                glm::vec2(ticksX - TICK_LENGTH, markY - 0.5f),
-                glm::vec2(TICK_LENGTH, 1.0f),
-                color_,
-                true);
+            if (shapesEnabled_)
+            {
+                renderer.drawRect(
+                    glm::vec2(ticksX - TICK_LENGTH, markY - 0.5f),
+                    glm::vec2(TICK_LENGTH, 1.0f),
+                    color_,
+                    true);
+            }
 
             if (markAltitude >= 0)
             {
                 float numberX = ticksX - TICK_LENGTH - TICK_TO_NUMBER_GAP - 30.0f;
                 glm::vec2 numberPos = glm::vec2(numberX, markY);
-                gfx::TextRenderer::drawString(renderer, std::to_string(markAltitude), numberPos, glm::vec2(8.0f, 12.0f), color_, 10.0f);
+                gfx::TextRenderer::drawString(renderer, util::LabelString("%d", markAltitude), numberPos, glm::vec2(8.0f, 12.0f), color_, 10.0f);
             }
         }
     }
@@ -107,42 +114,71 @@ namespace hud
     //  Digital Readout Box
     ////////////////////////////////////////////////////////////////////////////
 
-    void Altimeter::drawCurrentAltitudeBox(gfx::Renderer2D &renderer, float altitude)
+    void Altimeter::drawCurrentAltitudeBox(gfx::DrawList2D &renderer, float altitude)
     {
         float centerY = position_.y + size_.y * 0.5f;
 
         float boxX = position_.x + (size_.x - READOUT_BOX_WIDTH) * 0.5f;
         float boxY = centerY - READOUT_BOX_HEIGHT * 0.5f;
 
-        renderer.drawRect(
-            glm::vec2(boxX, boxY),
-            glm::vec2(READOUT_BOX_WIDTH, READOUT_BOX_HEIGHT),
-            color_,
-            false);
-
-        float chevronX = boxX - CHEVRON_WIDTH;
-        float chevronTopY = centerY - CHEVRON_HEIGHT * 0.5f;
-        float chevronBotY = centerY + CHEVRON_HEIGHT * 0.5f;
-
-        renderer.drawLine(
-            glm::vec2(chevronX, chevronTopY),
-            glm::vec2(boxX, centerY),
-            color_, 2.0f);
-        renderer.drawLine(
-            glm::vec2(boxX, centerY),
-            glm::vec2(chevronX, chevronBotY),
-            color_, 2.0f);
-        renderer.drawLine(
-            glm::vec2(chevronX, chevronTopY),
-            glm::vec2(chevronX, chevronBotY),
-            color_, 2.0f);
+        if (shapesEnabled_)
+        {
+            renderer.drawRect(
+                glm::vec2(boxX, boxY),
+                glm::vec2(READOUT_BOX_WIDTH, READOUT_BOX_HEIGHT),
+                color_,
+                false);
+
+            float chevronX = boxX - CHEVRON_WIDTH;
+            float chevronTopY = centerY - CHEVRON_HEIGHT * 0.5f;
+            float chevronBotY = centerY + CHEVRON_HEIGHT * 0.5f;
+
+            renderer.drawLine(
+                glm::vec2(chevronX, chevronTopY),
+                glm::vec2(boxX, centerY),
+                color_, 2.0f);
+            renderer.drawLine(
+                glm::vec2(boxX, centerY),
+                glm::vec2(chevronX, chevronBotY),
+                color_, 2.0f);
+            renderer.drawLine(
+                glm::vec2(chevronX, chevronTopY),
+                glm::vec2(chevronX, chevronBotY),
+                color_, 2.0f);
+        }
 
         int displayAltitude = (int)round(altitude);
         if (displayAltitude < 0)
             displayAltitude = 0;
 
         glm::vec2 numberPos = glm::vec2(boxX + READOUT_BOX_WIDTH * 0.5f, centerY);
-        gfx::TextRenderer::drawString(renderer, std::to_string(displayAltitude), numberPos, glm::vec2(8.0f, 12.0f), color_, 10.0f);
+        gfx::TextRenderer::drawString(renderer, util::LabelString("%d", displayAltitude), numberPos, glm::vec2(8.0f, 12.0f), color_, 10.0f);
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  SDF Backend
+    ////////////////////////////////////////////////////////////////////////////
+
+    bool Altimeter::buildSdfInstrument(const flight::FlightData &flightData, SdfInstrument &out) const
+    {
+        if (!enabled_)
+            return false;
+
+        float centerY = position_.y + size_.y * 0.5f;
+        float ticksX = position_.x + size_.x - 15.0f;
+        float boxX = position_.x + (size_.x - READOUT_BOX_WIDTH) * 0.5f;
+
+        // Same packing as SpeedIndicator; ticks grow to the left and every mark is drawn.
+        out.rect = glm::vec4(position_.x - SDF_SIDE_MARGIN, position_.y - CULLING_MARGIN,
+                             size_.x + 2.0f * SDF_SIDE_MARGIN, size_.y + 2.0f * CULLING_MARGIN);
+        out.color = color_;
+        out.accent = color_;
+        out.p0 = glm::vec4(flightData.altitude, ALTITUDE_STEP, PIXELS_PER_STEP, -1.0e9f);
+        out.p1 = glm::vec4(centerY, ticksX - TICK_LENGTH, TICK_LENGTH, static_cast<float>(VISIBLE_MARKS));
+        out.p2 = glm::vec4(boxX, READOUT_BOX_WIDTH, READOUT_BOX_HEIGHT, 0.0f);
+        out.p3 = glm::vec4(boxX - CHEVRON_WIDTH, CHEVRON_WIDTH, CHEVRON_HEIGHT, 0.0f);
+        out.kind = glm::ivec4(static_cast<int>(SdfShape::Tape), 0, 0, 0);
+        return true;
     }
 
 } // namespace hud
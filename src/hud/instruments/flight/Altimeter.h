@@ -24,16 +24,19 @@ namespace hud
 
         /**
          * @brief Renders the altimeter with current flight data.
-         * @param renderer Shared 2D renderer.
+         * @param renderer Draw list the instrument records into.
          * @param flightData Flight data (especially altitude).
          */
-        void render(gfx::Renderer2D &renderer, const flight::FlightData &flightData) override;
+        void render(gfx::DrawList2D &renderer, const flight::FlightData &flightData) override;
+
+        /// Packs the instrument shapes for the SDF backend (see SdfInstrument).
+        bool buildSdfInstrument(const flight::FlightData &flightData, SdfInstrument &out) const override;
 
     private:
         // Altimeter-specific methods
-        void drawBackground(gfx::Renderer2D &renderer);
-        void drawAltitudeTape(gfx::Renderer2D &renderer, float altitude);
-        void drawCurrentAltitudeBox(gfx::Renderer2D &renderer, float altitude);
+        void drawBackground(gfx::DrawList2D &renderer);
+        void drawAltitudeTape(gfx::DrawList2D &renderer, float altitude);
+        void drawCurrentAltitudeBox(gfx::DrawList2D &renderer, float altitude);
     };
 
 } // namespace hud
@@ -1,5 +1,6 @@
 #include "SpeedIndicator.h"
 #include "../../../gfx/rendering/TextRenderer.h"
+#include "../../../util/FixedString.h"
 #include <cmath>
 
 namespace hud
@@ -20,6 +21,10 @@ namespace hud
     static const float CHEVRON_WIDTH = 10.0f;
     static const float CHEVRON_HEIGHT = 12.0f;
 
+    // Culling and SDF quad bounds
+    static const float CULLING_MARGIN = 30.0f;  // Marks kept slightly beyond the tape ends
+    static const float SDF_SIDE_MARGIN = 16.0f; // Extra quad width so the chevron fits
+
     SpeedIndicator::SpeedIndicator() : Instrument()
     {
         // Speed indicator specific configuration
@@ -31,7 +36,7 @@ namespace hud
     //  Main Render
     ////////////////////////////////////////////////////////////////////////////
 
-    void SpeedIndicator::render(gfx::Renderer2D &renderer, const flight::FlightData &flightData)
+    void SpeedIndicator::render(gfx::DrawList2D &renderer, const flight::FlightData &flightData)
     {
         // Only render if enabled
         if (!enabled_)
@@ -47,7 +52,7 @@ namespace hud
     //  Speed Tape (Moving Scale)
     ////////////////////////////////////////////////////////////////////////////
 
-    void SpeedIndicator::drawSpeedTape(gfx::Renderer2D &renderer, float airspeed)
+    void SpeedIndicator::drawSpeedTape(gfx::DrawList2D &renderer, float airspeed)
     {
         // Calculate instrument vertical center (inherited from Instrument)
         float centerY = position_.y + size_.y * 0.5f;
@@ -70,7 +75,6 @@ namespace hud
             float markY = centerY + scrollOffset - i * PIXELS_PER_STEP;
 
             // Cull marks outside visible area
-            const float CULLING_MARGIN = 30.0f;
             if (markY < position_.y - CULLING_MARGIN || markY > position_.y + size_.y + CULLING_MARGIN)
                 continue;
 
@@ -81,11 +85,14 @@ namespace hud
                 continue;
 
             // Draw tick
-            renderer.drawRect(
-                glm::vec2(ticksX, markY - 0.5f),
-                glm::vec2(TICK_LENGTH, 1.0f),
-                color_,
-                true);
+            if (shapesEnabled_)
+            {
+                renderer.drawRect(
+                    glm::vec2(ticksX, markY - 0.5f),
+                    glm::vec2(TICK_LENGTH, 1.0f),
+                    color_,
+                    true);
+            }
 
             // Draw number (only every 20 knots to avoid clutter)
             if (markSpeed % 20 == 0)
@@ -101,7 +108,7 @@ namespace hud
     //  Digital Readout Box
     ////////////////////////////////////////////////////////////////////////////
 
-    void SpeedIndicator::drawCurrentSpeedBox(gfx::Renderer2D &renderer, float airspeed)
+    void SpeedIndicator::drawCurrentSpeedBox(gfx::DrawList2D &renderer, float airspeed)
     {
         float centerY = position_.y + size_.y * 0.5f;
 
@@ -109,31 +116,34 @@ namespace hud
         float boxX = position_.x + (size_.x - READOUT_BOX_WIDTH) * 0.5f;
         float boxY = centerY - READOUT_BOX_HEIGHT * 0.5f;
 
-        // Draw box frame
-        renderer.drawRect(
-            glm::vec2(boxX, boxY),
-            glm::vec2(READOUT_BOX_WIDTH, READOUT_BOX_HEIGHT),
-            color_,
-            false // Border only
-        );
-
-        // Draw chevron to the right of the box
-        float chevronX = boxX + READOUT_BOX_WIDTH;
-        float chevronTopY = centerY - CHEVRON_HEIGHT * 0.5f;
-        float chevronBotY = centerY + CHEVRON_HEIGHT * 0.5f;
-
-        renderer.drawLine(
-            glm::vec2(chevronX, chevronTopY),
-            glm::vec2(chevronX + CHEVRON_WIDTH, centerY),
-            color_, 2.0f);
-        renderer.drawLine(
-            glm::vec2(chevronX + CHEVRON_WIDTH, centerY),
-            glm::vec2(chevronX, chevronBotY),
-            color_, 2.0f);
-        renderer.drawLine(
-            glm::vec2(chevronX, chevronTopY),
-            glm::vec2(chevronX, chevronBotY),
-            color_, 2.0f);
+        if (shapesEnabled_)
+        {
+            // Draw box frame
+            renderer.drawRect(
+                glm::vec2(boxX, boxY),
+                glm::vec2(READOUT_BOX_WIDTH, READOUT_BOX_HEIGHT),
+                color_,
+                false // Border only
+            );
+
+            // Draw chevron to the right of the box
+            float chevronX = boxX + READOUT_BOX_WIDTH;
+            float chevronTopY = centerY - CHEVRON_HEIGHT * 0.5f;
+            float chevronBotY = centerY + CHEVRON_HEIGHT * 0.5f;
+
+            renderer.drawLine(
+                glm::vec2(chevronX, chevronTopY),
+                glm::vec2(chevronX + CHEVRON_WIDTH, centerY),
+                color_, 2.0f);
+            renderer.drawLine(
+                glm::vec2(chevronX + CHEVRON_WIDTH, centerY),
+                glm::vec2(chevronX, chevronBotY),
+                color_, 2.0f);
+            renderer.drawLine(
+                glm::vec2(chevronX, chevronTopY),
+                glm::vec2(chevronX, chevronBotY),
+                color_, 2.0f);
+        }
 
         // Show current speed rounded
         int displaySpeed = (int)round(airspeed);
@@ -145,18 +155,43 @@ namespace hud
         drawSpeedNumber(renderer, displaySpeed, numberPos);
     }
 
+    ////////////////////////////////////////////////////////////////////////////
+    //  SDF Backend
+    ////////////////////////////////////////////////////////////////////////////
+
+    bool SpeedIndicator::buildSdfInstrument(const flight::FlightData &flightData, SdfInstrument &out) const
+    {
+        if (!enabled_)
+            return false;
+
+        float centerY = position_.y + size_.y * 0.5f;
+        float boxX = position_.x + (size_.x - READOUT_BOX_WIDTH) * 0.5f;
+
+        // The quad includes the culling margin, so the shader needs no extra clipping.
+        out.rect = glm::vec4(position_.x - SDF_SIDE_MARGIN, position_.y - CULLING_MARGIN,
+                             size_.x + 2.0f * SDF_SIDE_MARGIN, size_.y + 2.0f * CULLING_MARGIN);
+        out.color = color_;
+        out.accent = color_;
+        out.p0 = glm::vec4(flightData.airspeed, SPEED_STEP, PIXELS_PER_STEP, 0.0f); // No negative marks
+        out.p1 = glm::vec4(centerY, position_.x + 15.0f, TICK_LENGTH, static_cast<float>(VISIBLE_MARKS));
+        out.p2 = glm::vec4(boxX, READOUT_BOX_WIDTH, READOUT_BOX_HEIGHT, 0.0f);
+        out.p3 = glm::vec4(boxX + READOUT_BOX_WIDTH, CHEVRON_WIDTH, CHEVRON_HEIGHT, 0.0f);
+        out.kind = glm::ivec4(static_cast<int>(SdfShape::Tape), 0, 0, 0);
+        return true;
+    }
+
     ////////////////////////////////////////////////////////////////////////////
     //  Number Rendering (Helper)
     ////////////////////////////////////////////////////////////////////////////
 
-    void SpeedIndicator::drawSpeedNumber(gfx::Renderer2D &renderer, int speed, const glm::vec2 &position)
+    void SpeedIndicator::drawSpeedNumber(gfx::DrawList2D &renderer, int speed, const glm::vec2 &position)
     {
         static const glm::vec2 DIGIT_SIZE = glm::vec2(8.0f, 12.0f);
         static const float DIGIT_SPACING = 10.0f;
 
         gfx::TextRenderer::drawString(
             renderer,
-            std::to_string(speed),
+            util::LabelString("%d", speed),
             position,
             DIGIT_SIZE,
             color_,
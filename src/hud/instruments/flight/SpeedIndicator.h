@@ -23,15 +23,18 @@ namespace hud
 
         /**
          * @brief Renders the speed indicator.
-         * @param renderer Shared 2D renderer.
+         * @param renderer Draw list the instrument records into.
          * @param flightData Flight data (especially airspeed).
          */
-        void render(gfx::Renderer2D &renderer, const flight::FlightData &flightData) override;
+        void render(gfx::DrawList2D &renderer, const flight::FlightData &flightData) override;
+
+        /// Packs the instrument shapes for the SDF backend (see SdfInstrument).
+        bool buildSdfInstrument(const flight::FlightData &flightData, SdfInstrument &out) const override;
 
     private:
-        void drawSpeedTape(gfx::Renderer2D &renderer, float airspeed);
-        void drawCurrentSpeedBox(gfx::Renderer2D &renderer, float airspeed);
-        void drawSpeedNumber(gfx::Renderer2D &renderer, int speed, const glm::vec2 &position);
+        void drawSpeedTape(gfx::DrawList2D &renderer, float airspeed);
+        void drawCurrentSpeedBox(gfx::DrawList2D &renderer, float airspeed);
+        void drawSpeedNumber(gfx::DrawList2D &renderer, int speed, const glm::vec2 &position);
     };
 
 } // namespace hud
@@ -1,5 +1,6 @@
 #include "VerticalSpeedIndicator.h"
 #include "../../../gfx/rendering/TextRenderer.h"
+#include "../../../util/FixedString.h"
 #include <cmath>
 #include <algorithm>
 
@@ -34,7 +35,7 @@ namespace hud
     // MAIN RENDER FUNCTION
     // ============================================================================
 
-    void VerticalSpeedIndicator::render(gfx::Renderer2D &renderer, const flight::FlightData &flightData)
+    void VerticalSpeedIndicator::render(gfx::DrawList2D &renderer, const flight::FlightData &flightData)
     {
         if (!enabled_)
             return;
@@ -46,7 +47,8 @@ namespace hud
         float clampedVS = std::clamp(verticalSpeed, MIN_VSI, MAX_VSI);
 
         drawScale(renderer);
-        drawIndicator(renderer, clampedVS);
+        if (shapesEnabled_)
+            drawIndicator(renderer, clampedVS);
         drawDigitalReadout(renderer, verticalSpeed); // Show real value (not clamped)
     }
 
@@ -54,17 +56,20 @@ namespace hud
     // FIXED SCALE RENDERING
     // ============================================================================
 
-    void VerticalSpeedIndicator::drawScale(gfx::Renderer2D &renderer)
+    void VerticalSpeedIndicator::drawScale(gfx::DrawList2D &renderer)
     {
         float centerX = position_.x + size_.x * 0.5f;
         float centerY = position_.y + size_.y * 0.5f;
 
         // Scale vertical line (backbone)
         float lineX = centerX + 5.0f; // Offset to right of center
-        renderer.drawLine(
-            glm::vec2(lineX, position_.y),
-            glm::vec2(lineX, position_.y + size_.y),
-            color_, 1.0f);
+        if (shapesEnabled_)
+        {
+            renderer.drawLine(
+                glm::vec2(lineX, position_.y),
+                glm::vec2(lineX, position_.y + size_.y),
+                color_, 1.0f);
+        }
 
         // Draw scale marks
         int numMarks = static_cast<int>((MAX_VSI - MIN_VSI) / MARK_INTERVAL) + 1;
@@ -83,10 +88,13 @@ namespace hud
             float tickLen = isMajorMark ? MAJOR_TICK_LENGTH : TICK_LENGTH;
 
             // Draw horizontal tick
-            renderer.drawLine(
-                glm::vec2(lineX - tickLen, markY),
-                glm::vec2(lineX, markY),
-                color_, isMajorMark ? 1.25f : 0.8f);
+            if (shapesEnabled_)
+            {
+                renderer.drawLine(
+                    glm::vec2(lineX - tickLen, markY),
+                    glm::vec2(lineX, markY),
+                    color_, isMajorMark ? 1.25f : 0.8f);
+            }
 
             // Draw numbers only on major marks
             if (isMajorMark)
@@ -95,15 +103,15 @@ namespace hud
                 // Example: 4000 ft/min -> "+40"
                 int displayValue = static_cast<int>(vsi / DISPLAY_SCALE);
 
-                std::string label;
+                util::LabelString label;
                 if (displayValue == 0)
                 {
-                    label = "0";
+                    label.format("0");
                 }
                 else
                 {
                     // Add explicit sign
-                    label = (displayValue > 0 ? "+" : "") + std::to_string(displayValue);
+                    label.format("%+d", displayValue);
                 }
 
                 // Text position (left of ticks)
@@ -115,17 +123,20 @@ namespace hud
         }
 
         // Reference line at 0 (thicker and longer)
-        renderer.drawLine(
-            glm::vec2(lineX - (MAJOR_TICK_LENGTH + 12.0f), centerY),
-            glm::vec2(lineX + 6.0f, centerY),
-            color_, 3.0f);
+        if (shapesEnabled_)
+        {
+            renderer.drawLine(
+                glm::vec2(lineX - (MAJOR_TICK_LENGTH + 12.0f), centerY),
+                glm::vec2(lineX + 6.0f, centerY),
+                color_, 3.0f);
+        }
     }
 
     // ============================================================================
     // MOVING TRIANGULAR INDICATOR
     // ============================================================================
 
-    void VerticalSpeedIndicator::drawIndicator(gfx::Renderer2D &renderer, float verticalSpeed)
+    void VerticalSpeedIndicator::drawIndicator(gfx::DrawList2D &renderer, float verticalSpeed)
     {
         float centerX = position_.x + size_.x * 0.5f;
         float centerY = position_.y + size_.y * 0.5f;
@@ -158,7 +169,7 @@ namespace hud
     // DIGITAL READOUT (MILITARY STANDARD FORMAT)
     // ============================================================================
 
-    void VerticalSpeedIndicator::drawDigitalReadout(gfx::Renderer2D &renderer, float verticalSpeed)
+    void VerticalSpeedIndicator::drawDigitalReadout(gfx::DrawList2D &renderer, float verticalSpeed)
     {
         float centerX = position_.x + size_.x * 0.5f;
         float centerY = position_.y + size_.y * 0.5f;
@@ -168,18 +179,21 @@ namespace hud
         float boxX = lineX - 6.0f - READOUT_BOX_WIDTH; // Minimum separation from scale
         float boxY = centerY - READOUT_BOX_HEIGHT * 0.5f;
 
-        // Semi-transparent background for readability
-        glm::vec4 boxBgColor = glm::vec4(0.0f, 0.0f, 0.0f, 0.7f);
-        renderer.drawRect(
-            glm::vec2(boxX, boxY),
-            glm::vec2(READOUT_BOX_WIDTH, READOUT_BOX_HEIGHT),
-            boxBgColor, true);
-
-        // Box outline
-        renderer.drawRect(
-            glm::vec2(boxX, boxY),
-            glm::vec2(READOUT_BOX_WIDTH, READOUT_BOX_HEIGHT),
-            color_, false);
+        if (shapesEnabled_)
+        {
+            // Semi-transparent background for readability
+            glm::vec4 boxBgColor = glm::vec4(0.0f, 0.0f, 0.0f, 0.7f);
+            renderer.drawRect(
+                glm::vec2(boxX, boxY),
+                glm::vec2(READOUT_BOX_WIDTH, READOUT_BOX_HEIGHT),
+                boxBgColor, true);
+
+            // Box outline
+            renderer.drawRect(
+                glm::vec2(boxX, boxY),
+                glm::vec2(READOUT_BOX_WIDTH, READOUT_BOX_HEIGHT),
+                color_, false);
+        }
 
         // MILITARY STANDARD FORMAT: ft/min / 100
         // Example: 4000 ft/min -> "+40"
@@ -187,15 +201,15 @@ namespace hud
         // Example: +500 ft/min -> "+5"
         int displayValue = static_cast<int>(std::round(verticalSpeed / DISPLAY_SCALE));
 
-        std::string vsiText;
+        util::LabelString vsiText;
         if (displayValue == 0)
         {
-            vsiText = "0";
+            vsiText.format("0");
         }
         else
         {
             // Explicit sign + absolute value (no decimals, compact integer format)
-            vsiText = (displayValue > 0 ? "+" : "") + std::to_string(displayValue);
+            vsiText.format("%+d", displayValue);
         }
 
         // Draw centered number in box (consistent with other instruments)
@@ -204,4 +218,34 @@ namespace hud
                                       glm::vec2(6.0f, 10.0f), color_, 8.0f);
     }
 
+    // ============================================================================
+    // SDF BACKEND
+    // ============================================================================
+
+    bool VerticalSpeedIndicator::buildSdfInstrument(const flight::FlightData &flightData, SdfInstrument &out) const
+    {
+        if (!enabled_)
+            return false;
+
+        float centerX = position_.x + size_.x * 0.5f;
+        float centerY = position_.y + size_.y * 0.5f;
+        float lineX = centerX + 5.0f; // Must match drawScale
+        float boxX = lineX - 6.0f - READOUT_BOX_WIDTH;
+
+        // p0: clamped VS, scale limit, mark interval, major interval (ft/min)
+        // p1: scale X, center Y, half scale height, half backbone length
+        // p2: tick length, major tick length, indicator width, indicator height
+        // p3: readout box X, width, height
+        out.rect = glm::vec4(boxX - 2.0f, position_.y - 8.0f,
+                             (lineX + INDICATOR_WIDTH + 6.0f) - (boxX - 2.0f), size_.y + 16.0f);
+        out.color = color_;
+        out.accent = glm::vec4(0.0f, 0.0f, 0.0f, 0.7f); // Readout background
+        out.p0 = glm::vec4(std::clamp(flightData.verticalSpeed, MIN_VSI, MAX_VSI), MAX_VSI, MARK_INTERVAL, 2000.0f);
+        out.p1 = glm::vec4(lineX, centerY, SCALE_HEIGHT * 0.5f, size_.y * 0.5f);
+        out.p2 = glm::vec4(TICK_LENGTH, MAJOR_TICK_LENGTH, INDICATOR_WIDTH, INDICATOR_HEIGHT);
+        out.p3 = glm::vec4(boxX, READOUT_BOX_WIDTH, READOUT_BOX_HEIGHT, 0.0f);
+        out.kind = glm::ivec4(static_cast<int>(SdfShape::VerticalSpeed), 0, 0, 0);
+        return true;
+    }
+
 } // namespace hud
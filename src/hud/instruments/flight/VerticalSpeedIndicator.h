@@ -41,16 +41,19 @@ namespace hud
 
         /**
          * @brief Renders the VSI with current flight data.
-         * @param renderer Shared 2D renderer.
+         * @param renderer Draw list the instrument records into.
          * @param flightData Flight data (especially verticalSpeed in ft/min).
          */
-        void render(gfx::Renderer2D &renderer, const flight::FlightData &flightData) override;
+        void render(gfx::DrawList2D &renderer, const flight::FlightData &flightData) override;
+
+        /// Packs the instrument shapes for the SDF backend (see SdfInstrument).
+        bool buildSdfInstrument(const flight::FlightData &flightData, SdfInstrument &out) const override;
 
     private:
         // Render methods
-        void drawScale(gfx::Renderer2D &renderer);
-        void drawIndicator(gfx::Renderer2D &renderer, float verticalSpeed);
-        void drawDigitalReadout(gfx::Renderer2D &renderer, float verticalSpeed);
+        void drawScale(gfx::DrawList2D &renderer);
+        void drawIndicator(gfx::DrawList2D &renderer, float verticalSpeed);
+        void drawDigitalReadout(gfx::DrawList2D &renderer, float verticalSpeed);
 
         // Scale configuration (values in ft/min)
         static constexpr float MAX_VSI = 6000.0f;       // ft/min (shows as 60)
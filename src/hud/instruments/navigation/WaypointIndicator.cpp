@@ -17,10 +17,9 @@
 
 #include "WaypointIndicator.h"
 #include "../../../gfx/rendering/TextRenderer.h"
+#include "../../../util/FixedString.h"
 #include <glm/glm.hpp>
 #include <cmath>
-#include <iomanip>
-#include <sstream>
 
 namespace hud
 {
@@ -52,6 +51,16 @@ namespace hud
             return angle;
         }
 
+        /// Altitude bug color: on-level uses the instrument color, climb amber, descend blue.
+        glm::vec4 altitudeBugColor(float altitudeDifference, const glm::vec4 &baseColor)
+        {
+            if (std::abs(altitudeDifference) < 50.0f)
+                return baseColor;
+            if (altitudeDifference > 0.0f)
+                return glm::vec4(1.0f, 0.9f, 0.1f, 1.0f);
+            return glm::vec4(0.3f, 0.7f, 1.0f, 1.0f);
+        }
+
         glm::vec2 compassCenter(const glm::vec2 &panelPos)
         {
             float centerX = panelPos.x + kPanelMarginLeft + kVerticalIndicatorOffset + kRoseRadius;
@@ -59,7 +68,7 @@ namespace hud
             return glm::vec2(centerX, centerY);
         }
 
-        void drawCompassTicks(gfx::Renderer2D &renderer, const glm::vec2 &center, const glm::vec4 &color)
+        void drawCompassTicks(gfx::DrawList2D &renderer, const glm::vec2 &center, const glm::vec4 &color, bool drawShapes)
         {
             for (int i = 0; i < 72; ++i)
             {
@@ -72,21 +81,21 @@ namespace hud
                 glm::vec2 startPos = center + glm::vec2(std::cos(angleRad), std::sin(angleRad)) * innerRadius;
                 glm::vec2 endPos = center + glm::vec2(std::cos(angleRad), std::sin(angleRad)) * kRoseRadius;
                 glm::vec4 tickColor = glm::vec4(color.r, color.g, color.b, isMajor ? 0.8f : 0.4f);
-                renderer.drawLine(startPos, endPos, tickColor, isMajor ? 2.0f : 1.0f);
+                if (drawShapes)
+                    renderer.drawLine(startPos, endPos, tickColor, isMajor ? 2.0f : 1.0f);
 
                 if (isNumeric)
                 {
                     int labelDeg = (i * 5) % 360;
-                    std::ostringstream ss;
-                    ss << std::setfill('0') << std::setw(3) << labelDeg;
+                    util::LabelString label("%03d", labelDeg);
                     float textRadius = kRoseRadius + 12.0f;
                     glm::vec2 textPos = center + glm::vec2(std::cos(angleRad), std::sin(angleRad)) * textRadius - glm::vec2(8.0f, 4.0f);
-                    gfx::TextRenderer::drawString(renderer, ss.str(), textPos, glm::vec2(5.0f, 8.0f), glm::vec4(color.r, color.g, color.b, 0.8f), 6.0f);
+                    gfx::TextRenderer::drawString(renderer, label, textPos, glm::vec2(5.0f, 8.0f), glm::vec4(color.r, color.g, color.b, 0.8f), 6.0f);
                 }
             }
         }
 
-        void drawCompassCardinals(gfx::Renderer2D &renderer, const glm::vec2 &center, const glm::vec4 &color)
+        void drawCompassCardinals(gfx::DrawList2D &renderer, const glm::vec2 &center, const glm::vec4 &color)
         {
             static const char *cardinals[4] = {"N", "E", "S", "W"};
             for (int i = 0; i < 4; ++i)
@@ -99,7 +108,7 @@ namespace hud
             }
         }
 
-        void drawWaypointPointer(gfx::Renderer2D &renderer, const glm::vec2 &center, float relativeAngle, const glm::vec4 &color)
+        void drawWaypointPointer(gfx::DrawList2D &renderer, const glm::vec2 &center, float relativeAngle, const glm::vec4 &color)
         {
             float pointerRad = glm::radians(-90.0f + relativeAngle);
             float pointerLength = kRoseRadius * 0.8f;
@@ -145,7 +154,7 @@ namespace hud
     //  Main Render
     ////////////////////////////////////////////////////////////////////////////
 
-    void WaypointIndicator::render(gfx::Renderer2D &renderer, const flight::FlightData &flightData)
+    void WaypointIndicator::render(gfx::DrawList2D &renderer, const flight::FlightData &flightData)
     {
         if (!enabled_)
             return;
@@ -177,22 +186,26 @@ namespace hud
     //  Compass Rose + Magenta Arrow
     ////////////////////////////////////////////////////////////////////////////
 
-    void WaypointIndicator::drawCompassRose(gfx::Renderer2D &renderer, const NavSnapshot &nav)
+    void WaypointIndicator::drawCompassRose(gfx::DrawList2D &renderer, const NavSnapshot &nav)
     {
         glm::vec2 center = compassCenter(position_);
-        renderer.drawCircle(center, kRoseRadius, glm::vec4(color_.r, color_.g, color_.b, 0.5f), 64, false);
-        renderer.drawCircle(center, kRoseRadius * 0.92f, glm::vec4(color_.r, color_.g, color_.b, 0.2f), 64, false);
+        if (shapesEnabled_)
+        {
+            renderer.drawCircle(center, kRoseRadius, glm::vec4(color_.r, color_.g, color_.b, 0.5f), 64, false);
+            renderer.drawCircle(center, kRoseRadius * 0.92f, glm::vec4(color_.r, color_.g, color_.b, 0.2f), 64, false);
+        }
 
-        drawCompassTicks(renderer, center, color_);
+        drawCompassTicks(renderer, center, color_, shapesEnabled_);
         drawCompassCardinals(renderer, center, color_);
-        drawWaypointPointer(renderer, center, nav.relativeAngle, color_);
+        if (shapesEnabled_)
+            drawWaypointPointer(renderer, center, nav.relativeAngle, color_);
     }
 
     ////////////////////////////////////////////////////////////////////////////
     //  Vertical Relative Altitude Indicator
     ////////////////////////////////////////////////////////////////////////////
 
-    void WaypointIndicator::drawVerticalIndicator(gfx::Renderer2D &renderer, const NavSnapshot &nav)
+    void WaypointIndicator::drawVerticalIndicator(gfx::DrawList2D &renderer, const NavSnapshot &nav)
     {
         glm::vec2 center = compassCenter(position_);
         float indicatorX = center.x - kRoseRadius - kVerticalIndicatorOffset;
@@ -200,57 +213,87 @@ namespace hud
 
         glm::vec2 lineTop = glm::vec2(indicatorX, indicatorY - kVerticalIndicatorHeight * 0.5f);
         glm::vec2 lineBottom = glm::vec2(indicatorX, indicatorY + kVerticalIndicatorHeight * 0.5f);
-        renderer.drawLine(lineTop, lineBottom, glm::vec4(color_.r, color_.g, color_.b, 0.4f), 2.0f);
-
         float markSize = 5.0f;
-        renderer.drawLine(glm::vec2(indicatorX - markSize, indicatorY), glm::vec2(indicatorX + markSize, indicatorY), glm::vec4(color_.r, color_.g, color_.b, 0.6f), 2.0f);
+        if (shapesEnabled_)
+        {
+            renderer.drawLine(lineTop, lineBottom, glm::vec4(color_.r, color_.g, color_.b, 0.4f), 2.0f);
+            renderer.drawLine(glm::vec2(indicatorX - markSize, indicatorY), glm::vec2(indicatorX + markSize, indicatorY), glm::vec4(color_.r, color_.g, color_.b, 0.6f), 2.0f);
+        }
 
         float clampedDiff = glm::clamp(nav.altitudeDifference, -kMaxAltitudeDiff, kMaxAltitudeDiff);
         float normalizedPos = clampedDiff / kMaxAltitudeDiff;
         float arrowY = indicatorY - normalizedPos * (kVerticalIndicatorHeight * 0.4f);
 
-        glm::vec4 arrowColor;
-        if (std::abs(nav.altitudeDifference) < 50.0f)
-            arrowColor = color_;
-        else if (nav.altitudeDifference > 0.0f)
-            arrowColor = glm::vec4(1.0f, 0.9f, 0.1f, 1.0f);
-        else
-            arrowColor = glm::vec4(0.3f, 0.7f, 1.0f, 1.0f);
+        glm::vec4 arrowColor = altitudeBugColor(nav.altitudeDifference, color_);
 
         float arrowSize = 8.0f;
         if (nav.altitudeDifference > 50.0f)
         {
-            glm::vec2 tip = glm::vec2(indicatorX, arrowY - arrowSize);
-            glm::vec2 left = glm::vec2(indicatorX - arrowSize * 0.7f, arrowY);
-            glm::vec2 right = glm::vec2(indicatorX + arrowSize * 0.7f, arrowY);
-            renderer.drawLine(tip, left, arrowColor, 3.0f);
-            renderer.drawLine(tip, right, arrowColor, 3.0f);
-            renderer.drawLine(left, right, arrowColor, 3.0f);
+            if (shapesEnabled_)
+            {
+                glm::vec2 tip = glm::vec2(indicatorX, arrowY - arrowSize);
+                glm::vec2 left = glm::vec2(indicatorX - arrowSize * 0.7f, arrowY);
+                glm::vec2 right = glm::vec2(indicatorX + arrowSize * 0.7f, arrowY);
+                renderer.drawLine(tip, left, arrowColor, 3.0f);
+                renderer.drawLine(tip, right, arrowColor, 3.0f);
+                renderer.drawLine(left, right, arrowColor, 3.0f);
+            }
             gfx::TextRenderer::drawString(renderer, "UP", glm::vec2(indicatorX - 10.0f, arrowY + arrowSize + 2.0f), glm::vec2(5.0f, 7.0f), arrowColor, 6.0f);
         }
         else if (nav.altitudeDifference < -50.0f)
         {
-            glm::vec2 tip = glm::vec2(indicatorX, arrowY + arrowSize);
-            glm::vec2 left = glm::vec2(indicatorX - arrowSize * 0.7f, arrowY);
-            glm::vec2 right = glm::vec2(indicatorX + arrowSize * 0.7f, arrowY);
-            renderer.drawLine(tip, left, arrowColor, 3.0f);
-            renderer.drawLine(tip, right, arrowColor, 3.0f);
-            renderer.drawLine(left, right, arrowColor, 3.0f);
+            if (shapesEnabled_)
+            {
+                glm::vec2 tip = glm::vec2(indicatorX, arrowY + arrowSize);
+                glm::vec2 left = glm::vec2(indicatorX - arrowSize * 0.7f, arrowY);
+                glm::vec2 right = glm::vec2(indicatorX + arrowSize * 0.7f, arrowY);
+                renderer.drawLine(tip, left, arrowColor, 3.0f);
+                renderer.drawLine(tip, right, arrowColor, 3.0f);
+                renderer.drawLine(left, right, arrowColor, 3.0f);
+            }
             gfx::TextRenderer::drawString(renderer, "DN", glm::vec2(indicatorX - 8.0f, arrowY - arrowSize - 10.0f), glm::vec2(5.0f, 7.0f), arrowColor, 6.0f);
         }
         else
         {
-            renderer.drawCircle(glm::vec2(indicatorX, arrowY), 5.0f, arrowColor, 16, true);
+            if (shapesEnabled_)
+                renderer.drawCircle(glm::vec2(indicatorX, arrowY), 5.0f, arrowColor, 16, true);
             gfx::TextRenderer::drawString(renderer, "LVL", glm::vec2(indicatorX - 10.0f, arrowY + 8.0f), glm::vec2(5.0f, 7.0f), arrowColor, 6.0f);
         }
 
-        std::ostringstream ss;
+        util::LabelString altLabel;
         if (std::abs(nav.altitudeDifference) >= 1000.0f)
-            ss << std::fixed << std::setprecision(1) << (nav.altitudeDifference / 1000.0f) << "km";
+            altLabel.format("%.1fkm", nav.altitudeDifference / 1000.0f);
         else
-            ss << static_cast<int>(std::round(nav.altitudeDifference)) << "m";
+            altLabel.format("%dm", static_cast<int>(std::round(nav.altitudeDifference)));
+
+        gfx::TextRenderer::drawString(renderer, altLabel, glm::vec2(indicatorX - 15.0f, lineBottom.y + 5.0f), glm::vec2(5.0f, 7.0f), glm::vec4(color_.r, color_.g, color_.b, 0.8f), 6.0f);
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  SDF Backend
+    ////////////////////////////////////////////////////////////////////////////
+
+    bool WaypointIndicator::buildSdfInstrument(const flight::FlightData &flightData, SdfInstrument &out) const
+    {
+        if (!enabled_ || !flightData.hasActiveWaypoint)
+            return false;
+
+        NavSnapshot nav = buildNavSnapshot(flightData);
+        glm::vec2 center = compassCenter(position_);
 
-        gfx::TextRenderer::drawString(renderer, ss.str(), glm::vec2(indicatorX - 15.0f, lineBottom.y + 5.0f), glm::vec2(5.0f, 7.0f), glm::vec4(color_.r, color_.g, color_.b, 0.8f), 6.0f);
+        // p0: rose center, relative bearing (deg), altitude difference (m)
+        // p1: rose radius, major tick, minor tick
+        // p2: vertical indicator X, height, max displayed difference
+        // Pointer and tick colors are derived from `color` with the same alphas as render().
+        out.rect = glm::vec4(position_.x - 8.0f, position_.y - 8.0f, kPanelWidth + 16.0f, kPanelHeight + 16.0f);
+        out.color = color_;
+        out.accent = altitudeBugColor(nav.altitudeDifference, color_);
+        out.p0 = glm::vec4(center.x, center.y, nav.relativeAngle, nav.altitudeDifference);
+        out.p1 = glm::vec4(kRoseRadius, kMajorTickLength, kMinorTickLength, 0.0f);
+        out.p2 = glm::vec4(center.x - kRoseRadius - kVerticalIndicatorOffset, kVerticalIndicatorHeight, kMaxAltitudeDiff, 0.0f);
+        out.p3 = glm::vec4(0.0f);
+        out.kind = glm::ivec4(static_cast<int>(SdfShape::Compass), 0, 0, 0);
+        return true;
     }
 
 } // namespace hud
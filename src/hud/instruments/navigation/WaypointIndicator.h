@@ -32,10 +32,13 @@ namespace hud
 
         /**
          * @brief Renders the HSI indicator with current flight data.
-         * @param renderer Shared 2D renderer.
+         * @param renderer Draw list the instrument records into.
          * @param flightData Flight data (includes position, heading, active waypoint).
          */
-        void render(gfx::Renderer2D &renderer, const flight::FlightData &flightData) override;
+        void render(gfx::DrawList2D &renderer, const flight::FlightData &flightData) override;
+
+        /// Packs the instrument shapes for the SDF backend (see SdfInstrument).
+        bool buildSdfInstrument(const flight::FlightData &flightData, SdfInstrument &out) const override;
 
     private:
         /**
@@ -61,9 +64,9 @@ namespace hud
 
         // Component render methods
         /// Draws the compass rose, marks, and magenta arrow.
-        void drawCompassRose(gfx::Renderer2D &renderer, const NavSnapshot &nav);
+        void drawCompassRose(gfx::DrawList2D &renderer, const NavSnapshot &nav);
         /// Renders the altitude difference indicator (UP/DN/LVL).
-        void drawVerticalIndicator(gfx::Renderer2D &renderer, const NavSnapshot &nav);
+        void drawVerticalIndicator(gfx::DrawList2D &renderer, const NavSnapshot &nav);
     };
 
 } // namespace hud
@@ -1,9 +1,188 @@
+#include "core/AllocationCheck.h"
 #include "core/Application.h"
+#include "core/JobPool.h"
+#include "core/JoystickBenchmark.h"
+#include "core/SchedulerBenchmark.h"
 #include "crash/CrashHandler.h"
+#include "mission/MissionParserBenchmark.h"
+#include "mission/MissionRegistry.h"
+#include "mission/MissionValidator.h"
+#include "mission/RecorderBenchmark.h"
+#include "mission/TriggerBenchmark.h"
+#include "mission/WaypointBenchmark.h"
 
-int main()
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+int main(int argc, char **argv)
 {
 	crash::installCrashHandler();
+
+	// Headless mode: `--bench-missions [missions] [waypoints]`
+	if (argc > 1 && std::strcmp(argv[1], "--bench-missions") == 0)
+	{
+		mission::ParserBenchmarkOptions options;
+		if (argc > 2)
+			options.missions = std::max<size_t>(1, std::strtoul(argv[2], nullptr, 10));
+		if (argc > 3)
+			options.waypoints = std::strtoul(argv[3], nullptr, 10);
+		return mission::runMissionParserBenchmark(options);
+	}
+
+	// Headless mode: `--bench-waypoints [count...]` (default 100, 10k and 1M)
+	if (argc > 1 && std::strcmp(argv[1], "--bench-waypoints") == 0)
+	{
+		mission::WaypointBenchmarkOptions options;
+		if (argc > 2)
+		{
+			options.sizes.clear();
+			for (int i = 2; i < argc; ++i)
+				options.sizes.push_back(std::strtoul(argv[i], nullptr, 10));
+		}
+		return mission::runWaypointBenchmark(options);
+	}
+
+	// Headless mode: `--bench-routes [count...]` (default 100 to 5000)
+	if (argc > 1 && std::strcmp(argv[1], "--bench-routes") == 0)
+	{
+		mission::RouteBenchmarkOptions options;
+		if (argc > 2)
+		{
+			options.sizes.clear();
+			for (int i = 2; i < argc; ++i)
+				options.sizes.push_back(std::strtoul(argv[i], nullptr, 10));
+		}
+		core::JobPool jobPool;
+		return mission::runRouteBenchmark(options, &jobPool);
+	}
+
+	// Headless mode: `--bench-triggers [triggers] [frames]` (default 10k triggers, 6000 frames)
+	if (argc > 1 && std::strcmp(argv[1], "--bench-triggers") == 0)
+	{
+		mission::TriggerBenchmarkOptions options;
+		if (argc > 2)
+			options.triggers = std::strtoul(argv[2], nullptr, 10);
+		if (argc > 3)
+			options.frames = std::atoi(argv[3]);
+		return mission::runTriggerBenchmark(options);
+	}
+
+	// Headless mode: `--bench-recorder [hours]` (default 1 h at 60 Hz)
+	if (argc > 1 && std::strcmp(argv[1], "--bench-recorder") == 0)
+	{
+		mission::RecorderBenchmarkOptions options;
+		if (argc > 2)
+			options.hours = static_cast<float>(std::atof(argv[2]));
+		return mission::runRecorderBenchmark(options);
+	}
+
+	// Headless mode: `--bench-scheduler [workers] [tasks]` (task spawn cost, steal rate, ordering checks)
+	if (argc > 1 && std::strcmp(argv[1], "--bench-scheduler") == 0)
+	{
+		core::SchedulerBenchmarkOptions options;
+		if (argc > 2)
+			options.workers = static_cast<unsigned>(std::strtoul(argv[2], nullptr, 10));
+		if (argc > 3)
+			options.tasks = std::max<size_t>(1, std::strtoul(argv[3], nullptr, 10));
+		return core::runSchedulerBenchmark(options);
+	}
+
+	// Headless mode: `--bench-joystick [rateHz] [seconds]` (virtual device through the sampler thread)
+	if (argc > 1 && std::strcmp(argv[1], "--bench-joystick") == 0)
+	{
+		core::JoystickBenchmarkOptions options;
+		if (argc > 2)
+			options.rateHz = static_cast<float>(std::atof(argv[2]));
+		if (argc > 3)
+			options.seconds = static_cast<float>(std::atof(argv[3]));
+		return core::runJoystickBenchmark(options);
+	}
+
+	// Headless check: `--check-allocations [frames]` (needs `make TRACK_ALLOCATIONS=1`; fails if a flight frame allocates)
+	if (argc > 1 && std::strcmp(argv[1], "--check-allocations") == 0)
+	{
+		core::AllocationCheckOptions options;
+		if (argc > 2)
+			options.frames = std::atoi(argv[2]);
+		return core::runAllocationCheck(options);
+	}
+
+	// Headless mode: `--validate-missions [catalog] [max bank]` flies every mission with the autopilot
+	if (argc > 1 && std::strcmp(argv[1], "--validate-missions") == 0)
+	{
+		mission::MissionValidationOptions options;
+		if (argc > 3)
+			options.maxBank = static_cast<float>(std::atof(argv[3]));
+		core::JobPool jobPool;
+		return mission::runMissionValidation(argc > 2 ? argv[2] : "assets/missions/missions.json", options, &jobPool);
+	}
+
+	// Offline tool: `--compile-missions <missions.json> <missions.pack>`
+	if (argc > 1 && std::strcmp(argv[1], "--compile-missions") == 0)
+	{
+		if (argc < 4)
+		{
+			std::cerr << "Usage: " << argv[0] << " --compile-missions <missions.json> <missions.pack>" << std::endl;
+			return EXIT_FAILURE;
+		}
+		return mission::MissionRegistry::compilePack(argv[2], argv[3]) ? EXIT_SUCCESS : EXIT_FAILURE;
+	}
+
+	// Synthetic catalog for large-menu testing: `--generate-missions <out.json> [missions] [waypoints]`
+	if (argc > 1 && std::strcmp(argv[1], "--generate-missions") == 0)
+	{
+		if (argc < 3)
+		{
+			std::cerr << "Usage: " << argv[0] << " --generate-missions <out.json> [missions] [waypoints]" << std::endl;
+			return EXIT_FAILURE;
+		}
+		size_t missions = argc > 3 ? std::max<size_t>(1, std::strtoul(argv[3], nullptr, 10)) : 10000;
+		size_t waypoints = argc > 4 ? std::strtoul(argv[4], nullptr, 10) : missions * 10;
+		std::ofstream out(argv[2], std::ios::binary);
+		out << mission::generateMissionDocument(missions, waypoints, mission::ParserBenchmarkOptions{}.seed);
+		return out ? EXIT_SUCCESS : EXIT_FAILURE;
+	}
+
 	core::Application app;
+
+	// Interactive options, in any order:
+	//   --missions <missions.json>   alternative catalog
+	//   --record-input <file>        record keys/mouse and frame times (.fsinput)
+	//   --replay-input <file>        replay a recording instead of the devices
+	//   --latency-test               flash + log key -> present latency on every key press
+	//   --joystick-config <file>     stick/throttle mapping (default assets/joystick.json)
+	//   --virtual-joystick <script>  fly from a keyframe script instead of a device
+	//   --present <mode>             vsync (default), adaptive, uncapped or capped-<fps>
+	//   --frame-log <seconds>        interval of the frame-time summary lines (0: only at exit)
+	core::FramePacingConfig pacing;
+	for (int i = 1; i < argc; ++i)
+	{
+		if (std::strcmp(argv[i], "--missions") == 0 && i + 1 < argc)
+			app.setMissionPath(argv[++i]);
+		else if (std::strcmp(argv[i], "--record-input") == 0 && i + 1 < argc)
+			app.setInputRecording(argv[++i]);
+		else if (std::strcmp(argv[i], "--replay-input") == 0 && i + 1 < argc)
+			app.setInputReplay(argv[++i]);
+		else if (std::strcmp(argv[i], "--latency-test") == 0)
+			app.setLatencyTest(true);
+		else if (std::strcmp(argv[i], "--joystick-config") == 0 && i + 1 < argc)
+			app.setJoystickConfig(argv[++i]);
+		else if (std::strcmp(argv[i], "--virtual-joystick") == 0 && i + 1 < argc)
+			app.setVirtualJoystick(argv[++i]);
+		else if (std::strcmp(argv[i], "--present") == 0 && i + 1 < argc)
+		{
+			if (!pacing.parseMode(argv[++i]))
+				std::cerr << "Unknown present mode " << argv[i] << " (vsync, adaptive, uncapped, capped-<fps>)"
+						  << std::endl;
+		}
+		else if (std::strcmp(argv[i], "--frame-log") == 0 && i + 1 < argc)
+			pacing.logInterval = std::max(0.0f, static_cast<float>(std::atof(argv[++i])));
+		else
+			std::cerr << "Ignoring unknown option " << argv[i] << std::endl;
+	}
+	app.setFramePacing(pacing);
 	return app.run();
 }
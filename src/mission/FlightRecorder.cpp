@@ -0,0 +1,387 @@
+/**
+ * @file FlightRecorder.cpp
+ * @brief Implementación del grabador de vuelo (agregados y traza delta + varint)
+ */
+
+#include "FlightRecorder.h"
+#include "../flight/data/FlightData.h"
+#include "util/MappedFile.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+namespace mission
+{
+
+    namespace
+    {
+        const char RECORDING_MAGIC[8] = {'F', 'S', 'M', 'R', 'E', 'C', '\0', '\0'};
+
+        /// Cuantización de cada canal: valor entero = round(valor · scale)
+        struct ChannelSpec
+        {
+            float scale;
+            uint8_t order; ///< 1: delta; 2: delta del delta (canales que varían suave)
+            int64_t wrap;  ///< Período en unidades cuantizadas (0 = sin vuelta)
+        };
+
+        constexpr ChannelSpec CHANNEL_SPECS[FLIGHT_CHANNEL_COUNT] = {
+            {1000.0f, 2, 0},  // Time: ms
+            {10.0f, 2, 0},    // PositionX: 0.1 m
+            {10.0f, 2, 0},    // PositionY
+            {10.0f, 2, 0},    // PositionZ
+            {1.0f, 2, 0},     // Altitude: 1 ft
+            {10.0f, 1, 0},    // Airspeed: 0.1 kt
+            {0.1f, 1, 0},     // VerticalSpeed: 10 ft/min
+            {10.0f, 1, 3600}, // Heading: 0.1°, 359.9 → 0.0 es un delta chico
+            {10.0f, 1, 0},    // Pitch: 0.1°
+            {10.0f, 1, 0},    // Roll: 0.1°
+            {100.0f, 1, 0},   // GForce: 0.01 G
+            {1000.0f, 1, 0},  // Throttle: 0.001
+        };
+
+        void writeVarint(std::vector<uint8_t> &out, int64_t value)
+        {
+            // Zigzag: valores chicos de cualquier signo ocupan pocos bytes
+            uint64_t v = (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+            while (v >= 0x80)
+            {
+                out.push_back(static_cast<uint8_t>(v | 0x80));
+                v >>= 7;
+            }
+            out.push_back(static_cast<uint8_t>(v));
+        }
+
+        bool readVarint(const uint8_t *&it, const uint8_t *end, int64_t &value)
+        {
+            uint64_t v = 0;
+            for (int shift = 0; shift < 64 && it < end; shift += 7)
+            {
+                uint8_t byte = *it++;
+                v |= static_cast<uint64_t>(byte & 0x7F) << shift;
+                if ((byte & 0x80) == 0)
+                {
+                    value = static_cast<int64_t>(v >> 1) ^ -static_cast<int64_t>(v & 1);
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        /// Suma módulo 2^64: un stream dañado no puede desbordar (UB) los acumuladores
+        int64_t wrappingAdd(int64_t a, int64_t b)
+        {
+            return static_cast<int64_t>(static_cast<uint64_t>(a) + static_cast<uint64_t>(b));
+        }
+
+        int64_t wrapDelta(int64_t delta, int64_t period)
+        {
+            if (period == 0)
+            {
+                return delta;
+            }
+            delta %= period;
+            if (delta > period / 2)
+            {
+                delta -= period;
+            }
+            else if (delta <= -period / 2)
+            {
+                delta += period;
+            }
+            return delta;
+        }
+
+        void addSample(ChannelStats &stats, bool first, float value, float dt)
+        {
+            if (first)
+            {
+                stats.min = stats.max = value;
+            }
+            else
+            {
+                stats.min = std::min(stats.min, value);
+                stats.max = std::max(stats.max, value);
+            }
+            stats.weightedSum += static_cast<double>(value) * dt;
+            stats.weight += dt;
+        }
+
+        /// Decodifica `sampleCount` muestras del stream
+        bool decodeStream(const uint8_t *data, size_t size, size_t sampleCount, FlightTrace &out)
+        {
+            out.sampleCount = 0;
+            out.values.assign(sampleCount * FLIGHT_CHANNEL_COUNT, 0.0f);
+            int64_t previous[FLIGHT_CHANNEL_COUNT] = {};
+            int64_t previousDelta[FLIGHT_CHANNEL_COUNT] = {};
+            const uint8_t *it = data;
+            const uint8_t *end = data + size;
+            for (size_t s = 0; s < sampleCount; ++s)
+            {
+                for (size_t c = 0; c < FLIGHT_CHANNEL_COUNT; ++c)
+                {
+                    const ChannelSpec &spec = CHANNEL_SPECS[c];
+                    int64_t residual = 0;
+                    if (!readVarint(it, end, residual))
+                    {
+                        out.values.resize(s * FLIGHT_CHANNEL_COUNT);
+                        return false;
+                    }
+                    int64_t delta = spec.order == 2 ? wrappingAdd(previousDelta[c], residual) : residual;
+                    previousDelta[c] = delta;
+                    int64_t value = wrappingAdd(previous[c], delta);
+                    if (spec.wrap != 0)
+                    {
+                        value = ((value % spec.wrap) + spec.wrap) % spec.wrap;
+                    }
+                    previous[c] = value;
+                    out.values[s * FLIGHT_CHANNEL_COUNT + c] = static_cast<float>(value) / spec.scale;
+                }
+                out.sampleCount = s + 1;
+            }
+            return true;
+        }
+    } // namespace
+
+    void FlightRecorder::start(float samplePeriod, size_t expectedLegs)
+    {
+        recording_ = true;
+        samplePeriod_ = std::max(samplePeriod, 0.001f);
+        nextSample_ = 0.0;
+        elapsed_ = 0.0;
+        distance_ = 0.0f;
+        fuel_ = 0.0f;
+        hasPosition_ = false;
+        for (ChannelStats &stats : channels_)
+        {
+            stats = ChannelStats();
+        }
+        leg_ = LegStats();
+        legSpeed_ = ChannelStats();
+        legOpen_ = false;
+        legs_.clear();
+        legs_.reserve(expectedLegs);
+        stream_.clear();
+        // Reserva para ~1 h de traza a 2 bytes por canal, con tope de 1 MiB. Un vuelo más largo,
+        // un período más corto o residuos más anchos la superan: ese frame realoca (crecimiento
+        // geométrico, así que pasa pocas veces por vuelo)
+        stream_.reserve(std::min<size_t>(static_cast<size_t>(3600.0f / samplePeriod_) * FLIGHT_CHANNEL_COUNT * 2,
+                                         size_t(1) << 20));
+        std::fill(std::begin(previous_), std::end(previous_), 0);
+        std::fill(std::begin(previousDelta_), std::end(previousDelta_), 0);
+        sampleCount_ = 0;
+    }
+
+    void FlightRecorder::record(const flight::FlightData &data, float dt)
+    {
+        if (!recording_)
+        {
+            return;
+        }
+
+        const float values[FLIGHT_CHANNEL_COUNT] = {
+            static_cast<float>(elapsed_),
+            data.position.x,
+            data.position.y,
+            data.position.z,
+            data.altitude,
+            data.airspeed,
+            data.verticalSpeed,
+            data.heading,
+            data.pitch,
+            data.roll,
+            data.gForce,
+            data.throttle,
+        };
+
+        // Agregados (todos los frames)
+        const bool first = !hasPosition_;
+        for (size_t c = 0; c < FLIGHT_CHANNEL_COUNT; ++c)
+        {
+            addSample(channels_[c], first, values[c], dt);
+        }
+
+        float step = 0.0f;
+        if (hasPosition_)
+        {
+            const float dx = data.position.x - lastPosition_[0];
+            const float dy = data.position.y - lastPosition_[1];
+            const float dz = data.position.z - lastPosition_[2];
+            step = std::sqrt(dx * dx + dy * dy + dz * dz);
+        }
+        lastPosition_[0] = data.position.x;
+        lastPosition_[1] = data.position.y;
+        lastPosition_[2] = data.position.z;
+        hasPosition_ = true;
+        distance_ += step;
+        fuel_ += data.throttle * dt;
+
+        // Tramo en curso
+        const bool legStart = !legOpen_;
+        if (legStart)
+        {
+            legOpen_ = true;
+            leg_.startTime = static_cast<float>(elapsed_);
+            leg_.minGForce = leg_.maxGForce = data.gForce;
+            leg_.maxAltitude = data.altitude;
+        }
+        leg_.duration += dt;
+        leg_.distance += step;
+        leg_.fuel += data.throttle * dt;
+        leg_.minGForce = std::min(leg_.minGForce, data.gForce);
+        leg_.maxGForce = std::max(leg_.maxGForce, data.gForce);
+        leg_.maxAltitude = std::max(leg_.maxAltitude, data.altitude);
+        addSample(legSpeed_, legStart, data.airspeed, dt);
+
+        // Traza muestreada
+        if (elapsed_ >= nextSample_)
+        {
+            sample(values);
+            nextSample_ += samplePeriod_;
+            if (nextSample_ <= elapsed_)
+            {
+                // Tras un frame muy largo no se recuperan muestras atrasadas
+                nextSample_ = elapsed_ + samplePeriod_;
+            }
+        }
+        elapsed_ += dt;
+    }
+
+    void FlightRecorder::sample(const float values[FLIGHT_CHANNEL_COUNT])
+    {
+        for (size_t c = 0; c < FLIGHT_CHANNEL_COUNT; ++c)
+        {
+            const ChannelSpec &spec = CHANNEL_SPECS[c];
+            const int64_t quantized = std::llround(static_cast<double>(values[c]) * spec.scale);
+            const int64_t delta = wrapDelta(quantized - previous_[c], spec.wrap);
+            const int64_t residual = spec.order == 2 ? delta - previousDelta_[c] : delta;
+            previousDelta_[c] = delta;
+            previous_[c] = spec.wrap != 0 ? ((quantized % spec.wrap) + spec.wrap) % spec.wrap : quantized;
+            writeVarint(stream_, residual);
+        }
+        sampleCount_++;
+    }
+
+    void FlightRecorder::endLeg(int waypoint)
+    {
+        if (!recording_)
+        {
+            return;
+        }
+        leg_.waypoint = waypoint;
+        leg_.averageSpeed = legSpeed_.mean();
+        legs_.push_back(leg_);
+        leg_ = LegStats();
+        legSpeed_ = ChannelStats();
+        legOpen_ = false;
+    }
+
+    void FlightRecorder::finish()
+    {
+        if (!recording_)
+        {
+            return;
+        }
+        if (legOpen_ && leg_.duration > 0.0f)
+        {
+            endLeg(-1);
+        }
+        recording_ = false;
+    }
+
+    bool FlightRecorder::save(const std::string &path) const
+    {
+        RecordingHeader header{};
+        std::memcpy(header.magic, RECORDING_MAGIC, sizeof(RECORDING_MAGIC));
+        header.version = VERSION;
+        header.channelCount = static_cast<uint32_t>(FLIGHT_CHANNEL_COUNT);
+        header.samplePeriod = samplePeriod_;
+        header.sampleCount = static_cast<uint32_t>(sampleCount_);
+        header.legCount = static_cast<uint32_t>(legs_.size());
+        header.streamBytes = static_cast<uint32_t>(stream_.size());
+
+        std::error_code error;
+        std::filesystem::path target(path);
+        if (target.has_parent_path())
+        {
+            std::filesystem::create_directories(target.parent_path(), error);
+        }
+
+        std::string tempPath = path + ".tmp";
+        {
+            std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+            if (!out.is_open())
+            {
+                std::cerr << "[FlightRecorder] No se pudo crear " << path << std::endl;
+                return false;
+            }
+            out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+            out.write(reinterpret_cast<const char *>(legs_.data()),
+                      static_cast<std::streamsize>(legs_.size() * sizeof(LegStats)));
+            out.write(reinterpret_cast<const char *>(stream_.data()), static_cast<std::streamsize>(stream_.size()));
+            if (!out)
+            {
+                std::cerr << "[FlightRecorder] Escritura incompleta: " << path << std::endl;
+                out.close();
+                std::filesystem::remove(tempPath, error);
+                return false;
+            }
+        }
+        std::filesystem::rename(tempPath, path, error);
+        if (error)
+        {
+            std::cerr << "[FlightRecorder] No se pudo reemplazar " << path << ": " << error.message() << std::endl;
+            std::filesystem::remove(tempPath, error);
+            return false;
+        }
+        return true;
+    }
+
+    void FlightRecorder::decode(FlightTrace &out) const
+    {
+        out.samplePeriod = samplePeriod_;
+        out.legs = legs_;
+        decodeStream(stream_.data(), stream_.size(), sampleCount_, out);
+    }
+
+    bool FlightRecorder::load(const std::string &path, FlightTrace &out)
+    {
+        util::MappedFile file;
+        if (!file.open(path))
+        {
+            return false;
+        }
+        std::string_view data = file.view();
+        RecordingHeader header;
+        if (data.size() < sizeof(header))
+        {
+            return false;
+        }
+        std::memcpy(&header, data.data(), sizeof(header));
+        const uint64_t legBytes = uint64_t(header.legCount) * sizeof(LegStats);
+        if (std::memcmp(header.magic, RECORDING_MAGIC, sizeof(RECORDING_MAGIC)) != 0 ||
+            header.version != VERSION || header.channelCount != FLIGHT_CHANNEL_COUNT ||
+            sizeof(header) + legBytes + header.streamBytes > data.size())
+        {
+            return false;
+        }
+        // Cada muestra ocupa al menos un byte por canal: un `sampleCount` dañado no reserva gigas
+        if (uint64_t(header.sampleCount) * FLIGHT_CHANNEL_COUNT > header.streamBytes)
+        {
+            return false;
+        }
+
+        out.samplePeriod = header.samplePeriod;
+        out.legs.resize(header.legCount);
+        if (legBytes > 0)
+        {
+            std::memcpy(out.legs.data(), data.data() + sizeof(header), legBytes);
+        }
+        const uint8_t *stream = reinterpret_cast<const uint8_t *>(data.data() + sizeof(header) + legBytes);
+        return decodeStream(stream, header.streamBytes, header.sampleCount, out);
+    }
+
+} // namespace mission
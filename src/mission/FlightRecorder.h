@@ -0,0 +1,194 @@
+/**
+ * @file FlightRecorder.h
+ * @brief Grabación de la serie temporal de un vuelo para el debriefing
+ *
+ * Dos niveles:
+ * - Agregados por frame en O(1): mínimo, máximo y media ponderada por
+ *   tiempo de cada canal, y estadísticas por tramo (entre capturas).
+ * - Traza muestreada (1 Hz por defecto) codificada en memoria como deltas
+ *   cuantizados en varint con zigzag; los canales que varían suavemente
+ *   (tiempo, posición, altitud) guardan la diferencia de segundo orden.
+ *
+ * Archivo `.fsrec`: `RecordingHeader`, `LegStats[legCount]` y el stream de
+ * muestras. Little-endian, como `missions.pack`.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace flight
+{
+    struct FlightData;
+}
+
+namespace mission
+{
+
+    /**
+     * @brief Canales de la traza, en el orden en que se codifican
+     */
+    enum class FlightChannel : uint8_t
+    {
+        Time,          ///< s desde el inicio de la grabación
+        PositionX,     ///< m
+        PositionY,     ///< m
+        PositionZ,     ///< m
+        Altitude,      ///< ft
+        Airspeed,      ///< kt
+        VerticalSpeed, ///< ft/min
+        Heading,       ///< grados
+        Pitch,         ///< grados
+        Roll,          ///< grados
+        GForce,        ///< G
+        Throttle,      ///< [0, 1]
+        Count
+    };
+
+    constexpr size_t FLIGHT_CHANNEL_COUNT = static_cast<size_t>(FlightChannel::Count);
+
+    /**
+     * @brief Agregado en streaming de un canal (media ponderada por dt)
+     */
+    struct ChannelStats
+    {
+        float min = 0.0f;
+        float max = 0.0f;
+        double weightedSum = 0.0;
+        double weight = 0.0;
+
+        float mean() const { return weight > 0.0 ? static_cast<float>(weightedSum / weight) : 0.0f; }
+    };
+
+    /**
+     * @brief Estadísticas de un tramo (desde la captura anterior o el inicio)
+     *
+     * Registro de tamaño fijo: se escribe tal cual en el archivo.
+     */
+    struct LegStats
+    {
+        int32_t waypoint = -1;     ///< Capturado al cerrar el tramo (-1: tramo final sin captura)
+        float startTime = 0.0f;    ///< s
+        float duration = 0.0f;     ///< s
+        float distance = 0.0f;     ///< m recorridos (no la distancia en línea recta)
+        float fuel = 0.0f;         ///< Aproximación: integral de la potencia (throttle · s)
+        float minGForce = 0.0f;
+        float maxGForce = 0.0f;
+        float averageSpeed = 0.0f; ///< kt
+        float maxAltitude = 0.0f;  ///< ft
+    };
+
+    /// Cabecera del archivo `.fsrec`
+    struct RecordingHeader
+    {
+        char magic[8];         ///< "FSMREC\0\0"
+        uint32_t version;      ///< FlightRecorder::VERSION
+        uint32_t channelCount; ///< FLIGHT_CHANNEL_COUNT al grabar
+        float samplePeriod;    ///< s
+        uint32_t sampleCount;
+        uint32_t legCount;
+        uint32_t streamBytes;
+    };
+
+    static_assert(sizeof(RecordingHeader) == 32, "RecordingHeader forma parte del formato en disco");
+    static_assert(sizeof(LegStats) == 36, "LegStats forma parte del formato en disco");
+
+    /**
+     * @brief Traza decodificada
+     */
+    struct FlightTrace
+    {
+        float samplePeriod = 1.0f;
+        size_t sampleCount = 0;
+        std::vector<float> values; ///< sampleCount × FLIGHT_CHANNEL_COUNT, por muestra
+        std::vector<LegStats> legs;
+
+        float value(size_t sample, FlightChannel channel) const
+        {
+            return values[sample * FLIGHT_CHANNEL_COUNT + static_cast<size_t>(channel)];
+        }
+    };
+
+    /**
+     * @brief Grabador de vuelo de una misión
+     *
+     * `record` se llama una vez por frame; el costo es constante salvo el
+     * frame que toma una muestra (unos pocos bytes más en el stream).
+     */
+    class FlightRecorder
+    {
+    public:
+        static constexpr uint32_t VERSION = 1;
+
+        /**
+         * @brief Descarta lo grabado y empieza de nuevo
+         * @param samplePeriod s entre muestras de la traza
+         * @param expectedLegs Tramos reservados de entrada (waypoints + 1): cerrar uno no pide memoria en el frame
+         */
+        void start(float samplePeriod = 1.0f, size_t expectedLegs = 0);
+
+        void record(const flight::FlightData &data, float dt);
+
+        /**
+         * @brief Cierra el tramo en curso (se capturó `waypoint`) y abre el siguiente
+         */
+        void endLeg(int waypoint);
+
+        /**
+         * @brief Cierra el último tramo si tuvo tiempo de vuelo; `record` queda sin efecto
+         */
+        void finish();
+
+        bool isRecording() const { return recording_; }
+        float elapsed() const { return static_cast<float>(elapsed_); }
+        float distance() const { return distance_; }
+        float fuel() const { return fuel_; }
+        const ChannelStats &channel(FlightChannel channel) const { return channels_[static_cast<size_t>(channel)]; }
+        const std::vector<LegStats> &legs() const { return legs_; }
+        size_t sampleCount() const { return sampleCount_; }
+        size_t encodedBytes() const { return stream_.size(); }
+
+        /**
+         * @brief Escribir el archivo `.fsrec` (temporal + rename)
+         */
+        bool save(const std::string &path) const;
+
+        /**
+         * @brief Decodificar lo grabado hasta ahora (verificación y herramientas)
+         */
+        void decode(FlightTrace &out) const;
+
+        /**
+         * @brief Leer y decodificar un archivo `.fsrec`
+         */
+        static bool load(const std::string &path, FlightTrace &out);
+
+    private:
+        void sample(const float values[FLIGHT_CHANNEL_COUNT]);
+
+        bool recording_ = false;
+        float samplePeriod_ = 1.0f;
+        double nextSample_ = 0.0; ///< En double: una hora de dt en float deriva segundos
+        double elapsed_ = 0.0;
+        float distance_ = 0.0f;
+        float fuel_ = 0.0f;
+        bool hasPosition_ = false;
+        float lastPosition_[3] = {};
+
+        ChannelStats channels_[FLIGHT_CHANNEL_COUNT];
+        LegStats leg_;
+        ChannelStats legSpeed_;
+        bool legOpen_ = false;
+        std::vector<LegStats> legs_;
+
+        // Codificación
+        std::vector<uint8_t> stream_;
+        int64_t previous_[FLIGHT_CHANNEL_COUNT] = {};
+        int64_t previousDelta_[FLIGHT_CHANNEL_COUNT] = {};
+        size_t sampleCount_ = 0;
+    };
+
+} // namespace mission
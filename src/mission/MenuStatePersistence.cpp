@@ -4,9 +4,11 @@
  */
 
 #include "MenuStatePersistence.h"
+#include "util/JsonReader.h"
+#include "util/MappedFile.h"
 #include <fstream>
-#include <sstream>
 #include <iostream>
+#include <utility>
 
 namespace mission
 {
@@ -22,7 +24,7 @@ namespace mission
 
         // Escribir JSON simple
         file << "{\n";
-        file << "  \"lastMissionId\": \"" << state.lastMissionId << "\",\n";
+        file << "  \"lastMissionId\": " << util::quoteJsonString(state.lastMissionId) << ",\n";
         file << "  \"lastMissionIndex\": " << state.lastMissionIndex << "\n";
         file << "}\n";
 
@@ -35,64 +37,37 @@ namespace mission
     {
         MenuState state;
 
-        std::ifstream file(filepath);
-        if (!file.is_open())
+        util::MappedFile file;
+        if (!file.open(filepath))
         {
             // No es un error crítico, simplemente no hay estado previo
             std::cout << "Info: No se encontró estado previo del menú" << std::endl;
             return state;
         }
 
-        std::stringstream buffer;
-        buffer << file.rdbuf();
-        std::string content = buffer.str();
-        file.close();
-
-        // Parser JSON simple: buscamos campos específicos en lugar de usar una librería completa
-        size_t idPos = content.find("\"lastMissionId\"");
-        if (idPos != std::string::npos)
+        util::JsonReader json(file.view());
+        MenuState loaded;
+        if (json.beginObject())
         {
-            size_t colonPos = content.find(':', idPos);
-            size_t valueStart = content.find('"', colonPos);
-            size_t valueEnd = content.find('"', valueStart + 1);
-            if (valueStart != std::string::npos && valueEnd != std::string::npos)
+            std::string_view key;
+            while (json.nextMember(key))
             {
-                state.lastMissionId = content.substr(valueStart + 1, valueEnd - valueStart - 1);
+                if (key == "lastMissionId" && json.peekType() == util::JsonType::String)
+                    json.readString(loaded.lastMissionId);
+                else if (key == "lastMissionIndex" && json.peekType() == util::JsonType::Number)
+                    json.readInt(loaded.lastMissionIndex);
+                else
+                    json.skipValue();
             }
         }
 
-        size_t indexPos = content.find("\"lastMissionIndex\"");
-        if (indexPos != std::string::npos)
+        if (!json.finish())
         {
-            size_t colonPos = content.find(':', indexPos);
-            size_t valueStart = colonPos + 1;
-
-            // Saltar espacios
-            while (valueStart < content.length() &&
-                   (content[valueStart] == ' ' || content[valueStart] == '\n' || content[valueStart] == '\t'))
-                valueStart++;
-
-            size_t valueEnd = valueStart;
-            while (valueEnd < content.length() &&
-                   content[valueEnd] != ',' && content[valueEnd] != '}' && content[valueEnd] != '\n')
-                valueEnd++;
-
-            std::string valueStr = content.substr(valueStart, valueEnd - valueStart);
-
-            // Remover espacios finales antes de convertir a entero
-            while (!valueStr.empty() &&
-                   (valueStr.back() == ' ' || valueStr.back() == '\n' || valueStr.back() == '\t'))
-                valueStr.pop_back();
-
-            try
-            {
-                state.lastMissionIndex = std::stoi(valueStr);
-            }
-            catch (...)
-            {
-                state.lastMissionIndex = 0;
-            }
+            // Archivo corrupto: se ignora completo en lugar de usar valores a medias
+            std::cerr << "Warning: Estado del menú inválido en " << filepath << ": " << json.error() << std::endl;
+            return state;
         }
+        state = std::move(loaded);
 
         std::cout << "✓ Estado del menú cargado (última misión: " << state.lastMissionId << ")" << std::endl;
         return state;
@@ -1,12 +1,33 @@
 #include "mission/MissionController.h"
 
+#include <filesystem>
 #include <iostream>
+#include <utility>
 
 namespace mission
 {
 
     bool MissionController::loadMissions(const std::string &path)
     {
+        // Preferir el paquete compilado junto al JSON (missions.pack) si está al día
+        namespace fs = std::filesystem;
+        std::string packPath = fs::path(path).replace_extension(".pack").string();
+        std::error_code error;
+        if (fs::exists(packPath, error))
+        {
+            bool stale = fs::exists(path, error) &&
+                         fs::last_write_time(path, error) > fs::last_write_time(packPath, error);
+            if (stale)
+            {
+                std::cerr << "[MissionController] " << packPath << " es más viejo que " << path
+                          << "; se usa el JSON (recompilar con --compile-missions)" << std::endl;
+            }
+            else if (registry_.loadPack(packPath))
+            {
+                return true;
+            }
+        }
+
         // Delegar el parseo del JSON al registro central
         bool loaded = registry_.loadFromFile(path);
         if (!loaded)
@@ -16,6 +37,12 @@ namespace mission
         return loaded;
     }
 
+    void MissionController::replaceRegistry(MissionRegistry &registry)
+    {
+        std::swap(registry_, registry);
+        std::cout << "[MissionController] Catálogo recargado: " << registry_.getMissionCount() << " misiones" << std::endl;
+    }
+
     void MissionController::setCurrentMission(const MissionDefinition &mission)
     {
         // Guardar la misión elegida y marcar el flag para habilitar startMission()
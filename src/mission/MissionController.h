@@ -29,9 +29,21 @@ namespace mission
          * @brief Carga todas las definiciones de misión desde un archivo JSON.
          * @param path Ruta al archivo missions.json.
          * @return true si el parseo y registro fueron exitosos.
+         *
+         * Si existe un paquete compilado con el mismo nombre (`missions.pack`) y
+         * no es más viejo que el JSON, se mapea ese paquete en su lugar.
          */
         bool loadMissions(const std::string &path);
 
+        /**
+         * @brief Reemplaza el catálogo por uno ya parseado (recarga en caliente).
+         * @param registry Catálogo nuevo; al volver contiene el anterior, para que
+         *                 quien llama decida en qué hilo liberarlo.
+         *
+         * La misión en curso no se ve afectada: `currentMission_` es una copia.
+         */
+        void replaceRegistry(MissionRegistry &registry);
+
         MissionRegistry &registry() { return registry_; }
         const MissionRegistry &registry() const { return registry_; }
 
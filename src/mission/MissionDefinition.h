@@ -25,6 +25,56 @@ namespace mission
         WaypointDef(glm::vec3 pos, std::string n) : position(pos), name(n) {}
     };
 
+    /**
+     * @brief Orden en que se pueden capturar los waypoints
+     */
+    enum class WaypointOrder
+    {
+        Sequential, // Uno tras otro, en el orden de la lista
+        Any         // Cualquiera al alcance (relevamientos); la guía apunta al más cercano
+    };
+
+    /**
+     * @brief Zona para disparadores: círculo en XZ con banda de altitud opcional
+     */
+    struct ZoneDef
+    {
+        std::string id;
+        glm::vec3 center = glm::vec3(0.0f); // m; "y" no se usa (ver min/maxAltitude)
+        float radius = 500.0f;              // m
+        float minAltitude = -1.0e6f;        // m (Y del mundo)
+        float maxAltitude = 1.0e6f;         // m
+    };
+
+    /**
+     * @brief Efecto de un disparador sobre la misión
+     */
+    enum class TriggerAction
+    {
+        Message,   // Solo muestra el mensaje
+        Objective, // Objetivo obligatorio: la misión no termina sin él
+        Penalty,   // Marca la corrida como no perfecta
+        Complete   // Termina la misión
+    };
+
+    /**
+     * @brief Disparador declarativo (ver `TriggerEngine`)
+     *
+     * La condición es una expresión sobre los datos de vuelo y las zonas, por
+     * ejemplo `in(valle) && altitude < 1000 && airspeed >= 250`.
+     */
+    struct TriggerDef
+    {
+        std::string id;
+        std::string condition;
+        TriggerAction action = TriggerAction::Message;
+        std::string message;
+        std::string after;   // Id de otro disparador: se arma cuando ese se dispara
+        float within = 0.0f; // s desde que se arma; vencido el plazo expira (0 = sin plazo)
+        float hold = 0.0f;   // s que la condición debe sostenerse antes de disparar
+        bool repeat = false; // Vuelve a dispararse cada vez que la condición pasa a verdadera
+    };
+
     /**
      * @brief Condiciones ambientales de una misión
      */
@@ -48,6 +98,9 @@ namespace mission
         std::string description; // Descripción corta
         std::string briefing;    // Briefing detallado
         std::vector<WaypointDef> waypoints;
+        WaypointOrder waypointOrder = WaypointOrder::Sequential; // "sequential" | "any"
+        std::vector<ZoneDef> zones;
+        std::vector<TriggerDef> triggers;
         glm::vec3 startPosition;    // Posición inicial del avión
         glm::quat startOrientation; // Orientación inicial
         EnvironmentSettings environment;
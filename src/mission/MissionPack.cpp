@@ -0,0 +1,475 @@
+/**
+ * @file MissionPack.cpp
+ * @brief Implementación del paquete binario de misiones
+ */
+
+#include "MissionPack.h"
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <unordered_map>
+#include <utility>
+
+namespace mission
+{
+
+    namespace
+    {
+        const char PACK_MAGIC[8] = {'F', 'S', 'M', 'P', 'A', 'C', 'K', '\0'};
+
+        uint64_t alignTo8(uint64_t value)
+        {
+            return (value + 7) & ~uint64_t(7);
+        }
+
+        /// Tabla de strings con deduplicación (categorías, clima, etc. se repiten mucho)
+        class StringTableBuilder
+        {
+        public:
+            PackString add(const std::string &value)
+            {
+                auto it = lookup_.find(value);
+                if (it != lookup_.end())
+                    return it->second;
+
+                PackString ref{static_cast<uint32_t>(data_.size()), static_cast<uint32_t>(value.size())};
+                data_ += value;
+                lookup_.emplace(value, ref);
+                return ref;
+            }
+
+            const std::string &data() const { return data_; }
+
+        private:
+            std::string data_;
+            std::unordered_map<std::string, PackString> lookup_;
+        };
+
+        bool sectionFits(uint64_t offset, uint64_t count, uint64_t elementSize, uint64_t fileSize)
+        {
+            // count < 2^32 y elementSize <= 144: el producto no desborda
+            return offset % 4 == 0 && offset <= fileSize && count * elementSize <= fileSize - offset;
+        }
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  Compilación
+    ////////////////////////////////////////////////////////////////////////////
+
+    bool MissionPack::compile(const std::vector<MissionDefinition> &missions, const std::string &path)
+    {
+        size_t totalWaypoints = 0;
+        size_t totalTriggers = 0;
+        size_t totalZones = 0;
+        for (const MissionDefinition &mission : missions)
+        {
+            totalWaypoints += mission.waypoints.size();
+            totalTriggers += mission.triggers.size();
+            totalZones += mission.zones.size();
+        }
+        if (missions.size() > std::numeric_limits<uint32_t>::max() ||
+            totalWaypoints > std::numeric_limits<uint32_t>::max() ||
+            totalTriggers > std::numeric_limits<uint32_t>::max() ||
+            totalZones > std::numeric_limits<uint32_t>::max())
+        {
+            std::cerr << "Error: Demasiadas misiones/waypoints/disparadores para un paquete" << std::endl;
+            return false;
+        }
+
+        StringTableBuilder strings;
+        std::vector<PackMissionRecord> records;
+        std::vector<float> xs, ys, zs;
+        std::vector<PackString> names;
+        std::vector<PackTriggerRecord> triggers;
+        std::vector<PackZoneRecord> zones;
+        records.reserve(missions.size());
+        triggers.reserve(totalTriggers);
+        zones.reserve(totalZones);
+        xs.reserve(totalWaypoints);
+        ys.reserve(totalWaypoints);
+        zs.reserve(totalWaypoints);
+        names.reserve(totalWaypoints);
+
+        for (const MissionDefinition &mission : missions)
+        {
+            PackMissionRecord record{};
+            record.id = strings.add(mission.id);
+            record.name = strings.add(mission.name);
+            record.description = strings.add(mission.description);
+            record.briefing = strings.add(mission.briefing);
+            record.category = strings.add(mission.category);
+            record.thumbnailPath = strings.add(mission.thumbnailPath);
+            record.timeOfDay = strings.add(mission.environment.timeOfDay);
+            record.weather = strings.add(mission.environment.weather);
+            record.startPosition[0] = mission.startPosition.x;
+            record.startPosition[1] = mission.startPosition.y;
+            record.startPosition[2] = mission.startPosition.z;
+            record.startOrientation[0] = mission.startOrientation.w;
+            record.startOrientation[1] = mission.startOrientation.x;
+            record.startOrientation[2] = mission.startOrientation.y;
+            record.startOrientation[3] = mission.startOrientation.z;
+            record.windSpeed = mission.environment.windSpeed;
+            record.windDirection = mission.environment.windDirection;
+            record.recommendedSpeed = mission.recommendedSpeed;
+            record.recommendedAltitude = mission.recommendedAltitude;
+            record.difficulty = mission.difficulty;
+            record.firstWaypoint = static_cast<uint32_t>(xs.size());
+            record.waypointCount = static_cast<uint32_t>(mission.waypoints.size());
+            record.waypointOrder = static_cast<uint32_t>(mission.waypointOrder);
+            record.firstTrigger = static_cast<uint32_t>(triggers.size());
+            record.triggerCount = static_cast<uint32_t>(mission.triggers.size());
+            record.firstZone = static_cast<uint32_t>(zones.size());
+            record.zoneCount = static_cast<uint32_t>(mission.zones.size());
+            records.push_back(record);
+
+            for (const TriggerDef &trigger : mission.triggers)
+            {
+                PackTriggerRecord packed{};
+                packed.id = strings.add(trigger.id);
+                packed.condition = strings.add(trigger.condition);
+                packed.message = strings.add(trigger.message);
+                packed.after = strings.add(trigger.after);
+                packed.action = static_cast<uint32_t>(trigger.action);
+                packed.flags = trigger.repeat ? PackTriggerRecord::REPEAT : 0;
+                packed.within = trigger.within;
+                packed.hold = trigger.hold;
+                triggers.push_back(packed);
+            }
+            for (const ZoneDef &zone : mission.zones)
+            {
+                PackZoneRecord packed{};
+                packed.id = strings.add(zone.id);
+                packed.center[0] = zone.center.x;
+                packed.center[1] = zone.center.y;
+                packed.center[2] = zone.center.z;
+                packed.radius = zone.radius;
+                packed.minAltitude = zone.minAltitude;
+                packed.maxAltitude = zone.maxAltitude;
+                zones.push_back(packed);
+            }
+
+            for (const WaypointDef &waypoint : mission.waypoints)
+            {
+                xs.push_back(waypoint.position.x);
+                ys.push_back(waypoint.position.y);
+                zs.push_back(waypoint.position.z);
+                names.push_back(strings.add(waypoint.name));
+            }
+        }
+
+        if (strings.data().size() > std::numeric_limits<uint32_t>::max())
+        {
+            std::cerr << "Error: Tabla de strings demasiado grande para un paquete" << std::endl;
+            return false;
+        }
+
+        PackHeader header{};
+        std::memcpy(header.magic, PACK_MAGIC, sizeof(PACK_MAGIC));
+        header.version = VERSION;
+        header.byteOrder = BYTE_ORDER_TAG;
+        header.missionCount = static_cast<uint32_t>(records.size());
+        header.waypointCount = static_cast<uint32_t>(totalWaypoints);
+        header.missionsOffset = alignTo8(sizeof(PackHeader));
+        header.waypointXOffset = alignTo8(header.missionsOffset + records.size() * sizeof(PackMissionRecord));
+        header.waypointYOffset = alignTo8(header.waypointXOffset + totalWaypoints * sizeof(float));
+        header.waypointZOffset = alignTo8(header.waypointYOffset + totalWaypoints * sizeof(float));
+        header.waypointNameOffset = alignTo8(header.waypointZOffset + totalWaypoints * sizeof(float));
+        header.triggerCount = static_cast<uint32_t>(totalTriggers);
+        header.zoneCount = static_cast<uint32_t>(totalZones);
+        header.triggersOffset = alignTo8(header.waypointNameOffset + totalWaypoints * sizeof(PackString));
+        header.zonesOffset = alignTo8(header.triggersOffset + totalTriggers * sizeof(PackTriggerRecord));
+        header.stringsOffset = alignTo8(header.zonesOffset + totalZones * sizeof(PackZoneRecord));
+        header.stringsSize = strings.data().size();
+
+        // Se escribe a un temporal y se renombra: un lector nunca ve un paquete a medias
+        std::string tempPath = path + ".tmp";
+        {
+            std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+            if (!out.is_open())
+            {
+                std::cerr << "Error: No se pudo crear el paquete de misiones: " << path << std::endl;
+                return false;
+            }
+
+            auto writeSection = [&out](uint64_t offset, const void *data, size_t bytes)
+            {
+                static const char padding[8] = {};
+                uint64_t position = static_cast<uint64_t>(out.tellp());
+                out.write(padding, static_cast<std::streamsize>(offset - position));
+                out.write(static_cast<const char *>(data), static_cast<std::streamsize>(bytes));
+            };
+
+            out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+            writeSection(header.missionsOffset, records.data(), records.size() * sizeof(PackMissionRecord));
+            writeSection(header.waypointXOffset, xs.data(), xs.size() * sizeof(float));
+            writeSection(header.waypointYOffset, ys.data(), ys.size() * sizeof(float));
+            writeSection(header.waypointZOffset, zs.data(), zs.size() * sizeof(float));
+            writeSection(header.waypointNameOffset, names.data(), names.size() * sizeof(PackString));
+            writeSection(header.triggersOffset, triggers.data(), triggers.size() * sizeof(PackTriggerRecord));
+            writeSection(header.zonesOffset, zones.data(), zones.size() * sizeof(PackZoneRecord));
+            writeSection(header.stringsOffset, strings.data().data(), strings.data().size());
+
+            if (!out)
+            {
+                std::cerr << "Error: Escritura incompleta del paquete de misiones: " << path << std::endl;
+                return false;
+            }
+        }
+
+        std::error_code error;
+        std::filesystem::rename(tempPath, path, error);
+        if (error)
+        {
+            std::cerr << "Error: No se pudo reemplazar " << path << ": " << error.message() << std::endl;
+            std::filesystem::remove(tempPath, error);
+            return false;
+        }
+        return true;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  Lectura
+    ////////////////////////////////////////////////////////////////////////////
+
+    MissionPack::MissionPack(MissionPack &&other) noexcept
+    {
+        *this = std::move(other);
+    }
+
+    MissionPack &MissionPack::operator=(MissionPack &&other) noexcept
+    {
+        // Las vistas apuntan al mapeo, que no cambia de dirección al moverlo
+        if (this != &other)
+        {
+            file_ = std::move(other.file_);
+            header_ = std::exchange(other.header_, nullptr);
+            records_ = std::exchange(other.records_, nullptr);
+            waypointX_ = std::exchange(other.waypointX_, nullptr);
+            waypointY_ = std::exchange(other.waypointY_, nullptr);
+            waypointZ_ = std::exchange(other.waypointZ_, nullptr);
+            waypointNames_ = std::exchange(other.waypointNames_, nullptr);
+            triggers_ = std::exchange(other.triggers_, nullptr);
+            zones_ = std::exchange(other.zones_, nullptr);
+            strings_ = std::exchange(other.strings_, nullptr);
+            error_ = std::exchange(other.error_, nullptr);
+        }
+        return *this;
+    }
+
+    bool MissionPack::open(const std::string &path)
+    {
+        close();
+
+        // Acceso indexado: solo se leen las páginas de las misiones consultadas
+        if (!file_.open(path, util::MappedFile::Access::Random))
+        {
+            error_ = "no se pudo abrir el archivo";
+            return false;
+        }
+
+        auto reject = [this](const char *reason)
+        {
+            close();
+            error_ = reason;
+            return false;
+        };
+
+        std::string_view data = file_.view();
+        uint64_t size = data.size();
+        if (size < sizeof(PackHeader))
+            return reject("archivo truncado");
+
+        const PackHeader *header = reinterpret_cast<const PackHeader *>(data.data());
+        if (std::memcmp(header->magic, PACK_MAGIC, sizeof(PACK_MAGIC)) != 0)
+            return reject("firma desconocida");
+        if (header->byteOrder != BYTE_ORDER_TAG)
+            return reject("orden de bytes distinto al del host");
+        if (header->version != VERSION)
+            return reject("versión no soportada (recompilar con --compile-missions)");
+
+        if (!sectionFits(header->missionsOffset, header->missionCount, sizeof(PackMissionRecord), size) ||
+            !sectionFits(header->waypointXOffset, header->waypointCount, sizeof(float), size) ||
+            !sectionFits(header->waypointYOffset, header->waypointCount, sizeof(float), size) ||
+            !sectionFits(header->waypointZOffset, header->waypointCount, sizeof(float), size) ||
+            !sectionFits(header->waypointNameOffset, header->waypointCount, sizeof(PackString), size) ||
+            !sectionFits(header->triggersOffset, header->triggerCount, sizeof(PackTriggerRecord), size) ||
+            !sectionFits(header->zonesOffset, header->zoneCount, sizeof(PackZoneRecord), size) ||
+            header->stringsOffset > size || header->stringsSize > size - header->stringsOffset)
+        {
+            return reject("sección fuera del archivo");
+        }
+
+        header_ = header;
+        records_ = reinterpret_cast<const PackMissionRecord *>(data.data() + header->missionsOffset);
+        waypointX_ = reinterpret_cast<const float *>(data.data() + header->waypointXOffset);
+        waypointY_ = reinterpret_cast<const float *>(data.data() + header->waypointYOffset);
+        waypointZ_ = reinterpret_cast<const float *>(data.data() + header->waypointZOffset);
+        waypointNames_ = reinterpret_cast<const PackString *>(data.data() + header->waypointNameOffset);
+        triggers_ = reinterpret_cast<const PackTriggerRecord *>(data.data() + header->triggersOffset);
+        zones_ = reinterpret_cast<const PackZoneRecord *>(data.data() + header->zonesOffset);
+        strings_ = data.data() + header->stringsOffset;
+        return true;
+    }
+
+    void MissionPack::close()
+    {
+        file_.close();
+        header_ = nullptr;
+        records_ = nullptr;
+        waypointX_ = waypointY_ = waypointZ_ = nullptr;
+        waypointNames_ = nullptr;
+        triggers_ = nullptr;
+        zones_ = nullptr;
+        strings_ = nullptr;
+        error_ = nullptr;
+    }
+
+    std::string_view MissionPack::string(const PackString &ref) const
+    {
+        // Referencias corruptas se leen como vacías en lugar de salir del mapeo
+        if (uint64_t(ref.offset) + ref.length > header_->stringsSize)
+            return std::string_view();
+        return std::string_view(strings_ + ref.offset, ref.length);
+    }
+
+    const PackMissionRecord *MissionPack::record(size_t index) const
+    {
+        return (header_ && index < header_->missionCount) ? &records_[index] : nullptr;
+    }
+
+    std::string_view MissionPack::id(size_t index) const
+    {
+        const PackMissionRecord *r = record(index);
+        return r ? string(r->id) : std::string_view();
+    }
+
+    std::string_view MissionPack::name(size_t index) const
+    {
+        const PackMissionRecord *r = record(index);
+        return r ? string(r->name) : std::string_view();
+    }
+
+    std::string_view MissionPack::category(size_t index) const
+    {
+        const PackMissionRecord *r = record(index);
+        return r ? string(r->category) : std::string_view();
+    }
+
+    int MissionPack::difficulty(size_t index) const
+    {
+        const PackMissionRecord *r = record(index);
+        return r ? r->difficulty : 0;
+    }
+
+    size_t MissionPack::waypointCount(size_t index) const
+    {
+        const PackMissionRecord *r = record(index);
+        return r ? r->waypointCount : 0;
+    }
+
+    float MissionPack::routeLength(size_t index) const
+    {
+        const PackMissionRecord *r = record(index);
+        if (!r || uint64_t(r->firstWaypoint) + r->waypointCount > header_->waypointCount)
+            return 0.0f;
+
+        // Solo X y Z: el array Y no se toca
+        float length = 0.0f;
+        float x = r->startPosition[0];
+        float z = r->startPosition[2];
+        for (uint32_t w = r->firstWaypoint; w < r->firstWaypoint + r->waypointCount; ++w)
+        {
+            float dx = waypointX_[w] - x;
+            float dz = waypointZ_[w] - z;
+            length += std::sqrt(dx * dx + dz * dz);
+            x = waypointX_[w];
+            z = waypointZ_[w];
+        }
+        return length;
+    }
+
+    long MissionPack::findById(std::string_view id) const
+    {
+        for (size_t i = 0; i < missionCount(); ++i)
+        {
+            if (string(records_[i].id) == id)
+                return static_cast<long>(i);
+        }
+        return -1;
+    }
+
+    bool MissionPack::materialize(size_t index, MissionDefinition &out) const
+    {
+        const PackMissionRecord *r = record(index);
+        if (!r || uint64_t(r->firstWaypoint) + r->waypointCount > header_->waypointCount ||
+            uint64_t(r->firstTrigger) + r->triggerCount > header_->triggerCount ||
+            uint64_t(r->firstZone) + r->zoneCount > header_->zoneCount)
+            return false;
+
+        MissionDefinition mission;
+        mission.id = string(r->id);
+        mission.name = string(r->name);
+        mission.description = string(r->description);
+        mission.briefing = string(r->briefing);
+        mission.category = string(r->category);
+        mission.thumbnailPath = string(r->thumbnailPath);
+        mission.environment.timeOfDay = string(r->timeOfDay);
+        mission.environment.weather = string(r->weather);
+        mission.environment.windSpeed = r->windSpeed;
+        mission.environment.windDirection = r->windDirection;
+        mission.startPosition = glm::vec3(r->startPosition[0], r->startPosition[1], r->startPosition[2]);
+        mission.startOrientation = glm::quat(r->startOrientation[0], r->startOrientation[1],
+                                             r->startOrientation[2], r->startOrientation[3]);
+        mission.recommendedSpeed = r->recommendedSpeed;
+        mission.recommendedAltitude = r->recommendedAltitude;
+        mission.difficulty = r->difficulty;
+        mission.waypointOrder = r->waypointOrder == static_cast<uint32_t>(WaypointOrder::Any)
+                                    ? WaypointOrder::Any
+                                    : WaypointOrder::Sequential;
+
+        mission.waypoints.reserve(r->waypointCount);
+        for (uint32_t i = r->firstWaypoint; i < r->firstWaypoint + r->waypointCount; ++i)
+        {
+            mission.waypoints.emplace_back(glm::vec3(waypointX_[i], waypointY_[i], waypointZ_[i]),
+                                           std::string(string(waypointNames_[i])));
+        }
+
+        mission.triggers.reserve(r->triggerCount);
+        for (uint32_t i = r->firstTrigger; i < r->firstTrigger + r->triggerCount; ++i)
+        {
+            const PackTriggerRecord &packed = triggers_[i];
+            TriggerDef trigger;
+            trigger.id = string(packed.id);
+            trigger.condition = string(packed.condition);
+            trigger.message = string(packed.message);
+            trigger.after = string(packed.after);
+            trigger.action = packed.action <= static_cast<uint32_t>(TriggerAction::Complete)
+                                 ? static_cast<TriggerAction>(packed.action)
+                                 : TriggerAction::Message;
+            trigger.within = packed.within;
+            trigger.hold = packed.hold;
+            trigger.repeat = (packed.flags & PackTriggerRecord::REPEAT) != 0;
+            mission.triggers.push_back(std::move(trigger));
+        }
+
+        mission.zones.reserve(r->zoneCount);
+        for (uint32_t i = r->firstZone; i < r->firstZone + r->zoneCount; ++i)
+        {
+            const PackZoneRecord &packed = zones_[i];
+            ZoneDef zone;
+            zone.id = string(packed.id);
+            zone.center = glm::vec3(packed.center[0], packed.center[1], packed.center[2]);
+            zone.radius = packed.radius;
+            zone.minAltitude = packed.minAltitude;
+            zone.maxAltitude = packed.maxAltitude;
+            mission.zones.push_back(std::move(zone));
+        }
+
+        out = std::move(mission);
+        return true;
+    }
+
+} // namespace mission
@@ -0,0 +1,185 @@
+/**
+ * @file MissionPack.h
+ * @brief Paquete binario de misiones mapeado en memoria
+ *
+ * `missions.json` se compila a un archivo `.pack` versionado que se puede
+ * mapear y consultar sin parsear ni reservar memoria por misión:
+ *
+ * | Sección            | Contenido                                                 |
+ * |--------------------|-----------------------------------------------------------|
+ * | `PackHeader`       | magic, versión, conteos y offsets de cada sección         |
+ * | Registros          | `PackMissionRecord[missionCount]` de tamaño fijo          |
+ * | Waypoints (SoA)    | `float x[]`, `float y[]`, `float z[]`, `PackString name[]` |
+ * | Disparadores       | `PackTriggerRecord[triggerCount]`                         |
+ * | Zonas              | `PackZoneRecord[zoneCount]`                               |
+ * | Tabla de strings   | UTF-8 concatenado, referenciado por offset + longitud     |
+ *
+ * Todas las secciones están alineadas a 8 bytes y en orden de bytes little-endian.
+ */
+
+#pragma once
+
+#include "MissionDefinition.h"
+#include "util/MappedFile.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace mission
+{
+
+    /// Referencia a la tabla de strings
+    struct PackString
+    {
+        uint32_t offset;
+        uint32_t length;
+    };
+
+    /// Cabecera del archivo (siempre al inicio)
+    struct PackHeader
+    {
+        char magic[8];         ///< "FSMPACK\0"
+        uint32_t version;      ///< MissionPack::VERSION
+        uint32_t byteOrder;    ///< MissionPack::BYTE_ORDER_TAG tal como lo escribió el host
+        uint32_t missionCount;
+        uint32_t waypointCount;
+        uint64_t missionsOffset;
+        uint64_t waypointXOffset;
+        uint64_t waypointYOffset;
+        uint64_t waypointZOffset;
+        uint64_t waypointNameOffset;
+        uint64_t stringsOffset;
+        uint64_t stringsSize;
+        uint32_t triggerCount;
+        uint32_t zoneCount;
+        uint64_t triggersOffset;
+        uint64_t zonesOffset;
+    };
+
+    /// Registro de tamaño fijo por misión
+    struct PackMissionRecord
+    {
+        PackString id;
+        PackString name;
+        PackString description;
+        PackString briefing;
+        PackString category;
+        PackString thumbnailPath;
+        PackString timeOfDay;
+        PackString weather;
+        float startPosition[3];
+        float startOrientation[4]; ///< w, x, y, z
+        float windSpeed;
+        float windDirection;
+        float recommendedSpeed;
+        float recommendedAltitude;
+        int32_t difficulty;
+        uint32_t firstWaypoint; ///< Índice en los arrays SoA de waypoints
+        uint32_t waypointCount;
+        uint32_t waypointOrder; ///< WaypointOrder; 0 (Sequential) en packs anteriores al campo
+        uint32_t firstTrigger;  ///< Índice en la sección de disparadores
+        uint32_t triggerCount;
+        uint32_t firstZone; ///< Índice en la sección de zonas
+        uint32_t zoneCount;
+        uint32_t reserved[1]; ///< En cero; espacio para campos de versiones futuras
+    };
+
+    /// Disparador declarativo (`TriggerDef`)
+    struct PackTriggerRecord
+    {
+        PackString id;
+        PackString condition;
+        PackString message;
+        PackString after;
+        uint32_t action; ///< TriggerAction
+        uint32_t flags;  ///< PackTriggerRecord::REPEAT
+        float within;
+        float hold;
+
+        static constexpr uint32_t REPEAT = 1u << 0;
+    };
+
+    /// Zona de disparadores (`ZoneDef`)
+    struct PackZoneRecord
+    {
+        PackString id;
+        float center[3];
+        float radius;
+        float minAltitude;
+        float maxAltitude;
+    };
+
+    static_assert(sizeof(PackHeader) == 104, "PackHeader forma parte del formato en disco");
+    static_assert(sizeof(PackMissionRecord) == 144, "PackMissionRecord forma parte del formato en disco");
+    static_assert(sizeof(PackTriggerRecord) == 48, "PackTriggerRecord forma parte del formato en disco");
+    static_assert(sizeof(PackZoneRecord) == 32, "PackZoneRecord forma parte del formato en disco");
+
+    /**
+     * @brief Lector (y compilador) de paquetes de misiones
+     *
+     * `open` solo valida la cabecera y los límites de las secciones; las
+     * páginas de cada misión se tocan recién cuando se consultan. Los
+     * accesores de resumen (`id`, `name`, ...) devuelven vistas sobre el
+     * archivo mapeado, válidas mientras el paquete siga abierto.
+     */
+    class MissionPack
+    {
+    public:
+        static constexpr uint32_t VERSION = 2;
+        static constexpr uint32_t BYTE_ORDER_TAG = 0x01020304;
+
+        /**
+         * @brief Escribir un paquete con las misiones dadas
+         * @return true si el archivo se escribió completo
+         */
+        static bool compile(const std::vector<MissionDefinition> &missions, const std::string &path);
+
+        MissionPack() = default;
+        MissionPack(MissionPack &&other) noexcept;
+        MissionPack &operator=(MissionPack &&other) noexcept;
+
+        /// Mapear y validar un paquete. Si falla, `error()` describe el motivo.
+        bool open(const std::string &path);
+        void close();
+        bool isOpen() const { return header_ != nullptr; }
+        const char *error() const { return error_; }
+
+        size_t missionCount() const { return header_ ? header_->missionCount : 0; }
+        size_t fileSize() const { return file_.size(); }
+
+        // Resumen sin materializar (para listados)
+        std::string_view id(size_t index) const;
+        std::string_view name(size_t index) const;
+        std::string_view category(size_t index) const;
+        int difficulty(size_t index) const;
+        size_t waypointCount(size_t index) const;
+
+        /// Longitud de la ruta en el plano XZ (inicio → waypoints), leída de los arrays SoA
+        float routeLength(size_t index) const;
+
+        /// Índice de la misión con ese id, o -1
+        long findById(std::string_view id) const;
+
+        /// Construir la `MissionDefinition` completa de una misión
+        bool materialize(size_t index, MissionDefinition &out) const;
+
+    private:
+        std::string_view string(const PackString &ref) const;
+        const PackMissionRecord *record(size_t index) const;
+
+        util::MappedFile file_;
+        const PackHeader *header_ = nullptr;
+        const PackMissionRecord *records_ = nullptr;
+        const float *waypointX_ = nullptr;
+        const float *waypointY_ = nullptr;
+        const float *waypointZ_ = nullptr;
+        const PackString *waypointNames_ = nullptr;
+        const PackTriggerRecord *triggers_ = nullptr;
+        const PackZoneRecord *zones_ = nullptr;
+        const char *strings_ = nullptr;
+        const char *error_ = nullptr;
+    };
+
+} // namespace mission
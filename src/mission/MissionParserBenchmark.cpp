@@ -0,0 +1,597 @@
+/**
+ * @file MissionParserBenchmark.cpp
+ * @brief Implementación del benchmark y fuzzing del parser de misiones
+ */
+
+#include "MissionParserBenchmark.h"
+#include "MissionRegistry.h"
+#include "util/JsonReader.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <unistd.h>
+#include <vector>
+
+namespace mission
+{
+
+    namespace
+    {
+        using Clock = std::chrono::steady_clock;
+
+        double elapsedMs(Clock::time_point start)
+        {
+            return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        }
+
+        /// Caso del corpus semilla con el resultado esperado del parser
+        struct FuzzSeed
+        {
+            const char *json;
+            bool valid; ///< Debe aceptarse como JSON completo
+        };
+
+        // Corpus semilla: casos límite de la gramática y del esquema de misiones
+        const FuzzSeed SEED_CORPUS[] = {
+            {"{}", true},
+            {"[]", true},
+            {"  0  ", true},
+            {"\xEF\xBB\xBF{\"missions\":[]}", true},
+            {"{\"missions\":[{\"id\":\"a\",\"waypoints\":[{\"name\":\"x\",\"position\":{\"x\":1,\"y\":2,\"z\":3}}]}]}", true},
+            {"{\"missions\":[{\"metadata\":{\"id\":\"decoy\"},\"id\":\"real\"}]}", true},
+            {"{\"missions\":[{\"id\":5,\"name\":null,\"waypoints\":{}}]}", true},
+            {"{\"a\":\"\\u00e9\\ud83d\\ude00\\ud800\",\"b\":[1,-0.5e+3,true,false,null]}", true},
+            {"\"\\\\\\\"\\/\\b\\f\\n\\r\\t\"", true},
+            {"", false},
+            {"{", false},
+            {"{\"a\":1,}", false},
+            {"[1,]", false},
+            {"[1 2]", false},
+            {"{\"a\" 1}", false},
+            {"{1:2}", false},
+            {"{\"a\":01}", false},
+            {"{\"a\":1.}", false},
+            {"{\"a\":-}", false},
+            {"{\"a\":tru}", false},
+            {"{\"a\":\"\\x\"}", false},
+            {"{\"a\":\"\\u12\"}", false},
+            {"\"unterminated", false},
+            {"{\"a\":\"line\nbreak\"}", false},
+            {"{\"a\":1}}", false},
+            {"{\"a\":1e999}", true}, // sintaxis válida; el registro lo rechaza al convertir
+            {"NaN", false},
+            {"// comentario\n{}", false},
+        };
+
+        /// true si el documento es JSON válido para util::JsonReader
+        bool isValidJson(std::string_view text)
+        {
+            util::JsonReader json(text);
+            json.skipValue();
+            return json.finish();
+        }
+
+        std::string nested(size_t depth)
+        {
+            return std::string(depth, '[') + std::string(depth, ']');
+        }
+
+        void mutate(std::string &doc, std::mt19937 &rng)
+        {
+            static const char STRUCTURAL[] = "{}[]:,\"\\-.0eEu ";
+
+            if (doc.empty())
+            {
+                doc.push_back(STRUCTURAL[rng() % (sizeof(STRUCTURAL) - 1)]);
+                return;
+            }
+
+            size_t at = rng() % doc.size();
+            switch (rng() % 6)
+            {
+            case 0: // truncar
+                doc.resize(at);
+                break;
+            case 1: // bit flip
+                doc[at] = static_cast<char>(doc[at] ^ (1u << (rng() % 8)));
+                break;
+            case 2: // byte aleatorio
+                doc[at] = static_cast<char>(rng() & 0xFF);
+                break;
+            case 3: // carácter estructural
+                doc.insert(doc.begin() + at, STRUCTURAL[rng() % (sizeof(STRUCTURAL) - 1)]);
+                break;
+            case 4: // borrar un tramo
+                doc.erase(at, std::min<size_t>(rng() % 16 + 1, doc.size() - at));
+                break;
+            default: // duplicar un tramo
+            {
+                size_t length = std::min<size_t>(rng() % 32 + 1, doc.size() - at);
+                std::string slice = doc.substr(at, length);
+                doc.insert(rng() % (doc.size() + 1), slice);
+                break;
+            }
+            }
+        }
+
+        /// Memoria residente del proceso separada en heap (anónima) y páginas de archivos mapeados
+        struct Resident
+        {
+            size_t anonymous = 0;
+            size_t file = 0;
+        };
+
+        Resident residentBytes()
+        {
+            // /proc/self/statm: size resident shared ... (en páginas); 0 si no está disponible
+            std::ifstream statm("/proc/self/statm");
+            size_t pages = 0, resident = 0, shared = 0;
+            Resident result;
+            if (statm >> pages >> resident >> shared)
+            {
+                size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+                result.anonymous = (resident - std::min(resident, shared)) * pageSize;
+                result.file = shared * pageSize;
+            }
+            return result;
+        }
+
+        size_t grownBy(size_t before, size_t after)
+        {
+            return after > before ? after - before : 0;
+        }
+
+        /// Resultado de cargar el mismo catálogo por una de las dos rutas
+        struct LoadResult
+        {
+            double bestMs = 0.0;
+            double averageMs = 0.0;
+            double selectMs = 0.0;  ///< Primer getMissionByIndex (materialización en modo paquete)
+            size_t heapDelta = 0;   ///< RSS anónimo agregado con el registro cargado
+            size_t mappedDelta = 0; ///< Páginas del archivo mapeadas (page cache, recuperables)
+            bool ok = true;
+        };
+
+        /// Verifica conteos y que las claves anidadas (metadata.id) no pisen a las del padre
+        bool verifyCatalog(const MissionRegistry &registry, const ParserBenchmarkOptions &options)
+        {
+            char expectedId[32];
+            std::snprintf(expectedId, sizeof(expectedId), "m%06zu", options.missions - 1);
+
+            size_t waypointCount = 0;
+            for (size_t i = 0; i < registry.getMissionCount(); ++i)
+            {
+                waypointCount += registry.getMissionSummary(i).waypointCount;
+            }
+
+            const MissionDefinition *last = registry.getMissionByIndex(options.missions - 1);
+            bool ok = registry.getMissionCount() == options.missions && waypointCount == options.waypoints &&
+                      last && last->id == expectedId && last->name.find("\"QUOTED\"") != std::string::npos &&
+                      last->waypoints.size() == registry.getMissionSummary(options.missions - 1).waypointCount;
+            if (!ok)
+            {
+                std::cerr << "  ✗ Contenido inesperado: " << registry.getMissionCount() << " misiones, "
+                          << waypointCount << " waypoints" << std::endl;
+            }
+            return ok;
+        }
+
+        template <typename LoadFn>
+        LoadResult measureLoad(const ParserBenchmarkOptions &options, LoadFn load)
+        {
+            LoadResult result;
+            double total = 0.0;
+            for (int i = 0; i < options.iterations; ++i)
+            {
+                MissionRegistry registry;
+                registry.setVerbose(false);
+
+                // Solo la primera vuelta mide RSS: después el heap reutiliza memoria liberada
+                Resident before = (i == 0) ? residentBytes() : Resident{};
+                Clock::time_point start = Clock::now();
+                bool loaded = load(registry);
+                double ms = elapsedMs(start);
+
+                start = Clock::now();
+                const MissionDefinition *selected = registry.getMissionByIndex(options.missions / 2);
+                double selectMs = elapsedMs(start);
+
+                if (i == 0)
+                {
+                    Resident after = residentBytes();
+                    result.heapDelta = grownBy(before.anonymous, after.anonymous);
+                    result.mappedDelta = grownBy(before.file, after.file);
+                    result.selectMs = selectMs;
+                }
+                result.bestMs = (i == 0) ? ms : std::min(result.bestMs, ms);
+                total += ms;
+
+                if (!loaded || !selected || !verifyCatalog(registry, options))
+                {
+                    result.ok = false;
+                    break;
+                }
+            }
+            result.averageMs = options.iterations > 0 ? total / options.iterations : 0.0;
+            return result;
+        }
+
+        void printLoadResult(const char *label, const LoadResult &result)
+        {
+            std::cout << "  " << label << ": inicio mejor " << result.bestMs << " ms / promedio " << result.averageMs
+                      << " ms, primera selección " << result.selectMs << " ms, heap +"
+                      << result.heapDelta / 1024 << " KiB, mapeado +" << result.mappedDelta / 1024 << " KiB" << std::endl;
+        }
+
+        bool runLoadBenchmark(const ParserBenchmarkOptions &options)
+        {
+            std::cout << "== Carga de misiones: " << options.missions << " misiones, "
+                      << options.waypoints << " waypoints ==" << std::endl;
+
+            Clock::time_point start = Clock::now();
+            std::string document = generateMissionDocument(options.missions, options.waypoints, options.seed);
+            double mib = document.size() / (1024.0 * 1024.0);
+            std::cout << "  Documento generado: " << mib << " MiB en " << elapsedMs(start) << " ms" << std::endl;
+
+            std::filesystem::path directory = std::filesystem::temp_directory_path();
+            std::string jsonPath = (directory / "flightsim_mission_bench.json").string();
+            std::string packPath = (directory / "flightsim_mission_bench.pack").string();
+            {
+                std::ofstream out(jsonPath, std::ios::binary);
+                out.write(document.data(), static_cast<std::streamsize>(document.size()));
+                if (!out)
+                {
+                    std::cerr << "Error: No se pudo escribir " << jsonPath << std::endl;
+                    return false;
+                }
+            }
+            document.clear();
+            document.shrink_to_fit();
+
+            // 1) Ruta JSON: parseo completo al inicio
+            LoadResult json = measureLoad(options, [&](MissionRegistry &registry)
+                                          { return registry.loadFromFile(jsonPath); });
+
+            // 2) Ruta paquete: compilar una vez, luego mapear y materializar a demanda
+            start = Clock::now();
+            bool compiled = MissionRegistry::compilePack(jsonPath, packPath);
+            double compileMs = elapsedMs(start);
+            LoadResult pack;
+            pack.ok = compiled;
+            if (compiled)
+            {
+                pack = measureLoad(options, [&](MissionRegistry &registry)
+                                   { return registry.loadPack(packPath); });
+            }
+
+            std::error_code error;
+            double packMiB = std::filesystem::file_size(packPath, error) / (1024.0 * 1024.0);
+            std::filesystem::remove(jsonPath, error);
+            std::filesystem::remove(packPath, error);
+
+            if (json.ok)
+            {
+                printLoadResult("JSON   ", json);
+                std::cout << "           " << mib / (json.bestMs / 1000.0) << " MiB/s, "
+                          << options.missions / (json.bestMs / 1000.0) << " misiones/s" << std::endl;
+            }
+            if (pack.ok)
+            {
+                std::cout << "  Paquete compilado en " << compileMs << " ms (" << packMiB << " MiB)" << std::endl;
+                printLoadResult("Paquete", pack);
+                if (json.ok && pack.bestMs > 0.0)
+                    std::cout << "  Inicio " << json.bestMs / pack.bestMs << "x más rápido con el paquete" << std::endl;
+            }
+            return json.ok && pack.ok;
+        }
+
+        /// Resultados de los índices contra recorridos lineales del catálogo
+        bool runQueryBenchmark(const ParserBenchmarkOptions &options)
+        {
+            std::cout << "== Consultas: " << options.missions << " misiones ==" << std::endl;
+
+            MissionRegistry registry;
+            registry.setVerbose(false);
+            if (!registry.loadFromMemory(generateMissionDocument(options.missions, options.waypoints, options.seed)))
+            {
+                std::cerr << "  ✗ No se pudo cargar el catálogo sintético" << std::endl;
+                return false;
+            }
+            const size_t count = registry.getMissionCount();
+            const std::vector<MissionDefinition> &missions = registry.getMissions();
+
+            Clock::time_point start = Clock::now();
+            const std::vector<std::string_view> &categories = registry.getCategories();
+            double indexMs = elapsedMs(start);
+            start = Clock::now();
+            registry.getMissionLength(0);
+            double sortedMs = elapsedMs(start);
+
+            // Búsqueda por id: hash contra recorrido lineal (ids en orden pseudoaleatorio)
+            std::vector<std::string> ids;
+            std::mt19937 rng(options.seed);
+            for (size_t i = 0; i < 1000; ++i)
+            {
+                ids.push_back(missions[rng() % count].id);
+            }
+            bool ok = true;
+            start = Clock::now();
+            for (const std::string &id : ids)
+            {
+                const MissionDefinition *found = registry.getMissionById(id);
+                ok = ok && found && found->id == id;
+            }
+            double hashedUs = elapsedMs(start) * 1000.0 / ids.size();
+            start = Clock::now();
+            for (const std::string &id : ids)
+            {
+                auto it = std::find_if(missions.begin(), missions.end(), [&id](const MissionDefinition &m)
+                                       { return m.id == id; });
+                ok = ok && it != missions.end();
+            }
+            double linearUs = elapsedMs(start) * 1000.0 / ids.size();
+            std::cout << "  Índices construidos en " << indexMs << " ms, órdenes en " << sortedMs << " ms" << std::endl;
+            std::cout << "  Por id: " << hashedUs << " us (hash) vs " << linearUs << " us (lineal)" << std::endl;
+
+            // Filtros: cada combinación categoría × dificultad, comparada con un filtrado lineal
+            std::vector<uint32_t> indexed;
+            std::vector<uint32_t> linear;
+            double indexedMs = 0.0;
+            double linearMs = 0.0;
+            for (std::string_view category : categories)
+            {
+                for (int difficulty = 1; difficulty <= 5; ++difficulty)
+                {
+                    MissionQuery query{category, difficulty, MissionSort::Name};
+                    start = Clock::now();
+                    registry.query(query, indexed);
+                    indexedMs += elapsedMs(start);
+
+                    start = Clock::now();
+                    linear.clear();
+                    for (size_t i = 0; i < count; ++i)
+                    {
+                        if (missions[i].category == category && missions[i].difficulty == difficulty)
+                            linear.push_back(static_cast<uint32_t>(i));
+                    }
+                    std::stable_sort(linear.begin(), linear.end(), [&missions](uint32_t a, uint32_t b)
+                                     { return missions[a].name < missions[b].name; });
+                    linearMs += elapsedMs(start);
+
+                    ok = ok && indexed == linear;
+                }
+            }
+            std::cout << "  Filtro + orden por nombre (" << categories.size() * 5 << " combinaciones): "
+                      << indexedMs << " ms (índices) vs " << linearMs << " ms (lineal)" << std::endl;
+
+            start = Clock::now();
+            registry.query(MissionQuery{{}, 0, MissionSort::Length}, indexed);
+            double lengthMs = elapsedMs(start);
+            for (size_t k = 1; k < indexed.size(); ++k)
+            {
+                ok = ok && registry.getMissionLength(indexed[k - 1]) <= registry.getMissionLength(indexed[k]);
+            }
+            std::cout << "  Catálogo completo por longitud: " << lengthMs << " ms" << std::endl;
+
+            // El paquete debe dar los mismos resultados que el JSON
+            std::error_code error;
+            std::string packPath = (std::filesystem::temp_directory_path() / "flightsim_query_bench.pack").string();
+            MissionRegistry packed;
+            packed.setVerbose(false);
+            if (MissionPack::compile(missions, packPath) && packed.loadPack(packPath))
+            {
+                std::vector<uint32_t> fromPack;
+                for (MissionSort sort : {MissionSort::Catalog, MissionSort::Name, MissionSort::Length})
+                {
+                    MissionQuery query{categories.empty() ? std::string_view() : categories.front(), 3, sort};
+                    registry.query(query, indexed);
+                    packed.query(query, fromPack);
+                    ok = ok && indexed == fromPack;
+                }
+                ok = ok && packed.findIndexById(missions.back().id) == static_cast<long>(count - 1);
+            }
+            else
+            {
+                ok = false;
+            }
+            packed.clear();
+            std::filesystem::remove(packPath, error);
+
+            if (!ok)
+                std::cerr << "  ✗ Los índices no coinciden con el recorrido lineal" << std::endl;
+            return ok;
+        }
+
+        bool runFuzz(const ParserBenchmarkOptions &options)
+        {
+            std::cout << "== Fuzzing: " << std::size(SEED_CORPUS) << " semillas + " << options.fuzzCases
+                      << " mutaciones ==" << std::endl;
+
+            bool ok = true;
+
+            // 1) El corpus semilla tiene resultado conocido
+            for (const FuzzSeed &seed : SEED_CORPUS)
+            {
+                if (isValidJson(seed.json) != seed.valid)
+                {
+                    std::cerr << "  ✗ Semilla mal clasificada: " << seed.json << std::endl;
+                    ok = false;
+                }
+            }
+            if (!isValidJson(nested(util::JsonReader::MAX_DEPTH)) ||
+                isValidJson(nested(util::JsonReader::MAX_DEPTH + 1)) ||
+                isValidJson(nested(100000)))
+            {
+                std::cerr << "  ✗ Límite de anidamiento incorrecto" << std::endl;
+                ok = false;
+            }
+
+            // 2) Mutaciones deterministas de las semillas y de un documento real
+            std::vector<std::string> corpus;
+            for (const FuzzSeed &seed : SEED_CORPUS)
+            {
+                corpus.emplace_back(seed.json);
+            }
+            corpus.push_back(generateMissionDocument(8, 40, options.seed));
+
+            std::mt19937 rng(options.seed);
+            size_t accepted = 0;
+            Clock::time_point start = Clock::now();
+            for (size_t i = 0; i < options.fuzzCases; ++i)
+            {
+                std::string doc = corpus[rng() % corpus.size()];
+                int mutations = 1 + static_cast<int>(rng() % 4);
+                for (int m = 0; m < mutations; ++m)
+                {
+                    mutate(doc, rng);
+                }
+
+                MissionRegistry registry;
+                registry.setVerbose(false);
+                bool loaded = registry.loadFromMemory(doc, "fuzz");
+                bool valid = isValidJson(doc);
+
+                // El registro nunca acepta lo que el tokenizer rechaza
+                if (loaded && !valid)
+                {
+                    std::cerr << "  ✗ Caso " << i << " aceptado por el registro pero JSON inválido" << std::endl;
+                    ok = false;
+                }
+                accepted += valid ? 1 : 0;
+            }
+
+            std::cout << "  " << options.fuzzCases << " casos en " << elapsedMs(start) << " ms ("
+                      << accepted << " válidos, " << options.fuzzCases - accepted << " rechazados)" << std::endl;
+
+            // 3) Paquetes binarios corruptos: abrir y materializar todo nunca debe salir del mapeo
+            std::string packPath = (std::filesystem::temp_directory_path() / "flightsim_mission_fuzz.pack").string();
+            {
+                MissionRegistry source;
+                source.setVerbose(false);
+                source.loadFromMemory(corpus.back(), "fuzz");
+                if (!MissionPack::compile(source.getMissions(), packPath))
+                    return false;
+            }
+            std::string pristine;
+            {
+                std::ifstream in(packPath, std::ios::binary);
+                pristine.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+            }
+
+            size_t packCases = options.fuzzCases / 20;
+            size_t opened = 0;
+            start = Clock::now();
+            for (size_t i = 0; i < packCases; ++i)
+            {
+                std::string bytes = pristine;
+                size_t flips = 1 + rng() % 8;
+                for (size_t f = 0; f < flips && !bytes.empty(); ++f)
+                {
+                    bytes[rng() % bytes.size()] ^= static_cast<char>(1u << (rng() % 8));
+                }
+                if (rng() % 4 == 0)
+                    bytes.resize(rng() % (bytes.size() + 1));
+                {
+                    std::ofstream out(packPath, std::ios::binary | std::ios::trunc);
+                    out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+                }
+
+                MissionRegistry registry;
+                registry.setVerbose(false);
+                if (registry.loadPack(packPath))
+                {
+                    opened++;
+                    for (size_t m = 0; m < registry.getMissionCount(); ++m)
+                    {
+                        registry.getMissionSummary(m);
+                        registry.getMissionByIndex(m);
+                    }
+                }
+            }
+            std::error_code error;
+            std::filesystem::remove(packPath, error);
+
+            std::cout << "  " << packCases << " paquetes corruptos en " << elapsedMs(start) << " ms ("
+                      << opened << " abiertos, " << packCases - opened << " rechazados)" << std::endl;
+            return ok;
+        }
+
+        void appendFormat(std::string &out, const char *format, double a, double b, double c)
+        {
+            char buffer[128];
+            int length = std::snprintf(buffer, sizeof(buffer), format, a, b, c);
+            out.append(buffer, static_cast<size_t>(std::max(0, length)));
+        }
+    }
+
+    std::string generateMissionDocument(size_t missions, size_t waypoints, uint32_t seed)
+    {
+        static const char *CATEGORIES[] = {"training", "navigation", "recon", "combat"};
+        static const char *WEATHER[] = {"clear", "cloudy", "rain", "storm"};
+
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<float> coordinate(-20000.0f, 20000.0f);
+        std::uniform_real_distribution<float> altitude(800.0f, 3000.0f);
+
+        std::string out;
+        out.reserve(missions * 420 + waypoints * 100);
+        out += "{\n  \"version\": 1,\n  \"missions\": [\n";
+
+        char buffer[256];
+        for (size_t i = 0; i < missions; ++i)
+        {
+            size_t count = waypoints / std::max<size_t>(missions, 1) + (i < waypoints % std::max<size_t>(missions, 1) ? 1 : 0);
+
+            std::snprintf(buffer, sizeof(buffer),
+                          "    {\n      \"metadata\": { \"id\": \"decoy-%zu\", \"name\": \"decoy\", \"waypoints\": [] },\n"
+                          "      \"id\": \"m%06zu\",\n"
+                          "      \"name\": \"MISSION %06zu \\\"QUOTED\\\"\",\n",
+                          i, i, i);
+            out += buffer;
+            std::snprintf(buffer, sizeof(buffer),
+                          "      \"description\": \"Ruta sint\\u00e9tica con %zu waypoints\",\n"
+                          "      \"category\": \"%s\",\n      \"difficulty\": %zu,\n",
+                          count, CATEGORIES[i % 4], i % 5 + 1);
+            out += buffer;
+            appendFormat(out, "      \"startPosition\": { \"x\": %.1f, \"y\": %.1f, \"z\": %.1f },\n",
+                         coordinate(rng), altitude(rng), coordinate(rng));
+            std::snprintf(buffer, sizeof(buffer),
+                          "      \"environment\": { \"timeOfDay\": \"day\", \"weather\": \"%s\", \"windSpeed\": %zu, \"windDirection\": %zu },\n"
+                          "      \"waypoints\": [\n",
+                          WEATHER[i % 4], i % 20, (i * 37) % 360);
+            out += buffer;
+
+            for (size_t w = 0; w < count; ++w)
+            {
+                std::snprintf(buffer, sizeof(buffer), "        { \"name\": \"WP-%zu\", ", w + 1);
+                out += buffer;
+                appendFormat(out, "\"position\": { \"x\": %.1f, \"y\": %.1f, \"z\": %.1f } }",
+                             coordinate(rng), altitude(rng), coordinate(rng));
+                out += (w + 1 < count) ? ",\n" : "\n";
+            }
+            out += (i + 1 < missions) ? "      ]\n    },\n" : "      ]\n    }\n";
+        }
+
+        out += "  ]\n}\n";
+        return out;
+    }
+
+    int runMissionParserBenchmark(const ParserBenchmarkOptions &options)
+    {
+        std::cout << std::fixed << std::setprecision(2);
+
+        bool ok = runLoadBenchmark(options);
+        ok = runQueryBenchmark(options) && ok;
+        ok = runFuzz(options) && ok;
+
+        std::cout << (ok ? "✓ Parser de misiones OK" : "✗ Parser de misiones con fallas") << std::endl;
+        return ok ? 0 : 1;
+    }
+
+} // namespace mission
@@ -0,0 +1,45 @@
+/**
+ * @file MissionParserBenchmark.h
+ * @brief Benchmark y fuzzing del parser de misiones (modo `--bench-missions`)
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace mission
+{
+
+    /**
+     * @brief Parámetros del benchmark del parser
+     */
+    struct ParserBenchmarkOptions
+    {
+        size_t missions = 10000;   ///< Misiones del documento sintético
+        size_t waypoints = 100000; ///< Waypoints totales repartidos entre las misiones
+        int iterations = 5;        ///< Cargas cronometradas del archivo generado
+        size_t fuzzCases = 20000;  ///< Documentos mutados a parsear
+        uint32_t seed = 1337;      ///< Semilla del generador (resultados reproducibles)
+    };
+
+    /**
+     * @brief Generar un `missions.json` sintético y determinista
+     *
+     * Incluye claves anidadas con el mismo nombre que las del padre
+     * (`metadata.id`, `metadata.name`), strings con escapes y `\u` para
+     * verificar que el parser solo lee las claves de su nivel.
+     */
+    std::string generateMissionDocument(size_t missions, size_t waypoints, uint32_t seed);
+
+    /**
+     * @brief Ejecutar benchmark de carga, consultas indexadas y fuzzing sobre el corpus semilla
+     * @return 0 si todas las verificaciones pasaron, 1 en caso contrario
+     *
+     * Sin ventana ni contexto OpenGL: pensado para correr desde la terminal
+     * (y bajo sanitizers) con `FlightSim --bench-missions [misiones] [waypoints]`.
+     */
+    int runMissionParserBenchmark(const ParserBenchmarkOptions &options);
+
+} // namespace mission
@@ -4,257 +4,474 @@
  */
 
 #include "MissionRegistry.h"
-#include <fstream>
-#include <sstream>
-#include <iostream>
+#include "util/JsonReader.h"
+#include "util/MappedFile.h"
 #include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <iterator>
+#include <numeric>
+#include <utility>
 
 namespace mission
 {
 
-    MissionRegistry::MissionRegistry()
+    namespace
     {
-    }
+        const size_t MAX_LOGGED_MISSIONS = 16; ///< Con archivos grandes se resume el resto
 
-    bool MissionRegistry::loadFromFile(const std::string &filepath)
-    {
-        std::ifstream file(filepath);
-        if (!file.is_open())
+        /// Estado compartido mientras se recorre un documento
+        struct ParseContext
         {
-            std::cerr << "Error: No se pudo abrir el archivo de misiones: " << filepath << std::endl;
-            return false;
-        }
+            util::JsonReader &json;
+            size_t ignoredFields = 0; ///< Campos con tipo inesperado (se conserva el valor por defecto)
+        };
 
-        // Leer todo el contenido del archivo
-        std::stringstream buffer;
-        buffer << file.rdbuf();
-        std::string content = buffer.str();
-        file.close();
+        // Lectores de campos: si el tipo no coincide se salta el valor y se cuenta
 
-        // Parser JSON simple
-        // Esperamos formato: { "missions": [ {...}, {...}, ... ] }
+        void readStringField(ParseContext &ctx, std::string &out)
+        {
+            if (ctx.json.peekType() == util::JsonType::String)
+            {
+                ctx.json.readString(out);
+                return;
+            }
+            ctx.ignoredFields++;
+            ctx.json.skipValue();
+        }
 
-        // Encontrar el array de misiones
-        size_t missionsStart = content.find("\"missions\"");
-        if (missionsStart == std::string::npos)
+        void readFloatField(ParseContext &ctx, float &out)
         {
-            std::cerr << "Error: No se encontró el campo 'missions' en el JSON" << std::endl;
-            return false;
+            if (ctx.json.peekType() == util::JsonType::Number)
+            {
+                ctx.json.readFloat(out);
+                return;
+            }
+            ctx.ignoredFields++;
+            ctx.json.skipValue();
         }
 
-        // Encontrar el inicio del array
-        size_t arrayStart = content.find('[', missionsStart);
-        size_t arrayEnd = content.rfind(']');
+        void readIntField(ParseContext &ctx, int &out)
+        {
+            if (ctx.json.peekType() == util::JsonType::Number)
+            {
+                ctx.json.readInt(out);
+                return;
+            }
+            ctx.ignoredFields++;
+            ctx.json.skipValue();
+        }
 
-        if (arrayStart == std::string::npos || arrayEnd == std::string::npos)
+        void readBoolField(ParseContext &ctx, bool &out)
         {
-            std::cerr << "Error: Formato JSON inválido" << std::endl;
-            return false;
+            if (ctx.json.peekType() == util::JsonType::Bool)
+            {
+                ctx.json.readBool(out);
+                return;
+            }
+            ctx.ignoredFields++;
+            ctx.json.skipValue();
         }
 
-        // Extraer cada objeto de misión
-        std::string arrayContent = content.substr(arrayStart + 1, arrayEnd - arrayStart - 1);
+        void readWaypointOrder(ParseContext &ctx, WaypointOrder &out)
+        {
+            std::string value;
+            readStringField(ctx, value);
+            if (value == "any")
+                out = WaypointOrder::Any;
+            else if (value == "sequential")
+                out = WaypointOrder::Sequential;
+            else if (!value.empty())
+                ctx.ignoredFields++;
+        }
 
-        // Parsear misiones individuales (buscar objetos {...}) manteniendo el conteo de llaves anidadas
-        size_t pos = 0;
-        while (pos < arrayContent.length())
+        bool expectObject(ParseContext &ctx)
         {
-            size_t objStart = arrayContent.find('{', pos);
-            if (objStart == std::string::npos)
-                break;
+            if (ctx.json.peekType() == util::JsonType::Object)
+                return ctx.json.beginObject();
+            ctx.ignoredFields++;
+            ctx.json.skipValue();
+            return false;
+        }
 
-            // Encontrar el cierre del objeto (contando llaves)
-            int braceCount = 1;
-            size_t objEnd = objStart + 1;
-            while (objEnd < arrayContent.length() && braceCount > 0)
+        void readVec3(ParseContext &ctx, glm::vec3 &out)
+        {
+            if (!expectObject(ctx))
+                return;
+            std::string_view key;
+            while (ctx.json.nextMember(key))
             {
-                if (arrayContent[objEnd] == '{')
-                    braceCount++;
-                else if (arrayContent[objEnd] == '}')
-                    braceCount--;
-                objEnd++;
+                if (key == "x")
+                    readFloatField(ctx, out.x);
+                else if (key == "y")
+                    readFloatField(ctx, out.y);
+                else if (key == "z")
+                    readFloatField(ctx, out.z);
+                else
+                    ctx.json.skipValue();
             }
+        }
 
-            std::string missionJson = arrayContent.substr(objStart, objEnd - objStart);
-            MissionDefinition mission = parseMissionFromJson(missionJson);
+        void readWaypoint(ParseContext &ctx, WaypointDef &waypoint)
+        {
+            if (!expectObject(ctx))
+                return;
+            std::string_view key;
+            while (ctx.json.nextMember(key))
+            {
+                if (key == "name")
+                {
+                    readStringField(ctx, waypoint.name);
+                }
+                else if (key == "position")
+                {
+                    // Altitud por defecto de crucero si el objeto omite "y"
+                    waypoint.position = glm::vec3(0.0f, 1500.0f, 0.0f);
+                    readVec3(ctx, waypoint.position);
+                }
+                else
+                {
+                    ctx.json.skipValue();
+                }
+            }
+        }
 
-            if (!mission.id.empty())
+        void readWaypoints(ParseContext &ctx, std::vector<WaypointDef> &waypoints)
+        {
+            if (ctx.json.peekType() != util::JsonType::Array)
+            {
+                ctx.ignoredFields++;
+                ctx.json.skipValue();
+                return;
+            }
+            ctx.json.beginArray();
+            while (ctx.json.nextElement())
             {
-                missions_.push_back(mission);
-                std::cout << "✓ Misión cargada: " << mission.name << " [" << mission.id << "]" << std::endl;
+                waypoints.emplace_back();
+                readWaypoint(ctx, waypoints.back());
             }
+        }
 
-            pos = objEnd;
+        void readZone(ParseContext &ctx, ZoneDef &zone)
+        {
+            if (!expectObject(ctx))
+                return;
+            std::string_view key;
+            while (ctx.json.nextMember(key))
+            {
+                if (key == "id")
+                    readStringField(ctx, zone.id);
+                else if (key == "center")
+                    readVec3(ctx, zone.center);
+                else if (key == "radius")
+                    readFloatField(ctx, zone.radius);
+                else if (key == "minAltitude")
+                    readFloatField(ctx, zone.minAltitude);
+                else if (key == "maxAltitude")
+                    readFloatField(ctx, zone.maxAltitude);
+                else
+                    ctx.json.skipValue();
+            }
         }
 
-        std::cout << "Total de misiones cargadas: " << missions_.size() << std::endl;
-        return !missions_.empty();
-    }
+        void readTriggerAction(ParseContext &ctx, TriggerAction &out)
+        {
+            std::string value;
+            readStringField(ctx, value);
+            if (value == "message")
+                out = TriggerAction::Message;
+            else if (value == "objective")
+                out = TriggerAction::Objective;
+            else if (value == "penalty")
+                out = TriggerAction::Penalty;
+            else if (value == "complete")
+                out = TriggerAction::Complete;
+            else if (!value.empty())
+                ctx.ignoredFields++;
+        }
 
-    // Helper simple para extraer valores de campos JSON tipo string (sin dependencias externas)
-    static std::string extractJsonString(const std::string &json, const std::string &key)
-    {
-        std::string searchKey = "\"" + key + "\"";
-        size_t keyPos = json.find(searchKey);
-        if (keyPos == std::string::npos)
-            return "";
+        void readTrigger(ParseContext &ctx, TriggerDef &trigger)
+        {
+            if (!expectObject(ctx))
+                return;
+            std::string_view key;
+            while (ctx.json.nextMember(key))
+            {
+                if (key == "id")
+                    readStringField(ctx, trigger.id);
+                else if (key == "when")
+                    readStringField(ctx, trigger.condition);
+                else if (key == "action")
+                    readTriggerAction(ctx, trigger.action);
+                else if (key == "message")
+                    readStringField(ctx, trigger.message);
+                else if (key == "after")
+                    readStringField(ctx, trigger.after);
+                else if (key == "within")
+                    readFloatField(ctx, trigger.within);
+                else if (key == "hold")
+                    readFloatField(ctx, trigger.hold);
+                else if (key == "repeat")
+                    readBoolField(ctx, trigger.repeat);
+                else
+                    ctx.json.skipValue();
+            }
+        }
 
-        size_t colonPos = json.find(':', keyPos);
-        if (colonPos == std::string::npos)
-            return "";
+        /// Arreglo de objetos leídos con `readElement`
+        template <typename T, typename ReadElement>
+        void readArray(ParseContext &ctx, std::vector<T> &out, ReadElement readElement)
+        {
+            if (ctx.json.peekType() != util::JsonType::Array)
+            {
+                ctx.ignoredFields++;
+                ctx.json.skipValue();
+                return;
+            }
+            ctx.json.beginArray();
+            while (ctx.json.nextElement())
+            {
+                out.emplace_back();
+                readElement(ctx, out.back());
+            }
+        }
 
-        size_t valueStart = json.find('"', colonPos);
-        if (valueStart == std::string::npos)
-            return "";
+        void readEnvironment(ParseContext &ctx, EnvironmentSettings &environment)
+        {
+            if (!expectObject(ctx))
+                return;
+            std::string_view key;
+            while (ctx.json.nextMember(key))
+            {
+                if (key == "timeOfDay")
+                    readStringField(ctx, environment.timeOfDay);
+                else if (key == "weather")
+                    readStringField(ctx, environment.weather);
+                else if (key == "windSpeed")
+                    readFloatField(ctx, environment.windSpeed);
+                else if (key == "windDirection")
+                    readFloatField(ctx, environment.windDirection);
+                else
+                    ctx.json.skipValue();
+            }
+        }
 
-        size_t valueEnd = json.find('"', valueStart + 1);
-        if (valueEnd == std::string::npos)
-            return "";
+        /// Construye la misión directamente desde el stream; las claves se comparan solo en este nivel
+        void readMission(ParseContext &ctx, MissionDefinition &mission)
+        {
+            if (!expectObject(ctx))
+                return;
+            std::string_view key;
+            while (ctx.json.nextMember(key))
+            {
+                if (key == "id")
+                    readStringField(ctx, mission.id);
+                else if (key == "name")
+                    readStringField(ctx, mission.name);
+                else if (key == "description")
+                    readStringField(ctx, mission.description);
+                else if (key == "briefing")
+                    readStringField(ctx, mission.briefing);
+                else if (key == "category")
+                    readStringField(ctx, mission.category);
+                else if (key == "difficulty")
+                    readIntField(ctx, mission.difficulty);
+                else if (key == "thumbnailPath")
+                    readStringField(ctx, mission.thumbnailPath);
+                else if (key == "recommendedSpeed")
+                    readFloatField(ctx, mission.recommendedSpeed);
+                else if (key == "recommendedAltitude")
+                    readFloatField(ctx, mission.recommendedAltitude);
+                else if (key == "startPosition")
+                    readVec3(ctx, mission.startPosition);
+                else if (key == "waypoints")
+                    readWaypoints(ctx, mission.waypoints);
+                else if (key == "waypointOrder")
+                    readWaypointOrder(ctx, mission.waypointOrder);
+                else if (key == "zones")
+                    readArray(ctx, mission.zones, readZone);
+                else if (key == "triggers")
+                    readArray(ctx, mission.triggers, readTrigger);
+                else if (key == "environment")
+                    readEnvironment(ctx, mission.environment);
+                else
+                    ctx.json.skipValue();
+            }
+        }
 
-        return json.substr(valueStart + 1, valueEnd - valueStart - 1);
+        void reportSyntaxError(const util::JsonReader &json, const std::string &sourceName)
+        {
+            size_t line = 0;
+            size_t column = 0;
+            json.errorLocation(line, column);
+            std::cerr << "Error: JSON inválido en " << sourceName << ":" << line << ":" << column
+                      << ": " << json.error() << std::endl;
+        }
     }
 
-    static float extractJsonFloat(const std::string &json, const std::string &key, float defaultValue = 0.0f)
+    MissionRegistry::MissionRegistry()
     {
-        std::string searchKey = "\"" + key + "\"";
-        size_t keyPos = json.find(searchKey);
-        if (keyPos == std::string::npos)
-            return defaultValue;
+    }
 
-        size_t colonPos = json.find(':', keyPos);
-        if (colonPos == std::string::npos)
-            return defaultValue;
+    bool MissionRegistry::loadFromFile(const std::string &filepath)
+    {
+        // El archivo se mapea en memoria y se parsea sin copiarlo
+        util::MappedFile file;
+        if (!file.open(filepath))
+        {
+            std::cerr << "Error: No se pudo abrir el archivo de misiones: " << filepath << std::endl;
+            return false;
+        }
+        return loadFromMemory(file.view(), filepath);
+    }
 
-        // Saltar espacios
-        size_t valueStart = colonPos + 1;
-        while (valueStart < json.length() && (json[valueStart] == ' ' || json[valueStart] == '\n' || json[valueStart] == '\t'))
-            valueStart++;
+    bool MissionRegistry::loadFromMemory(std::string_view json, const std::string &sourceName)
+    {
+        // Formato esperado: { "missions": [ {...}, {...}, ... ] }
+        if (pack_.isOpen())
+        {
+            clear(); // JSON y paquete no se mezclan
+        }
 
-        // Leer hasta coma o cierre
-        size_t valueEnd = valueStart;
-        while (valueEnd < json.length() && json[valueEnd] != ',' && json[valueEnd] != '}' && json[valueEnd] != ']')
-            valueEnd++;
+        util::JsonReader reader(json);
+        ParseContext ctx{reader};
+        std::vector<MissionDefinition> loaded;
+        bool foundMissions = false;
 
-        std::string valueStr = json.substr(valueStart, valueEnd - valueStart);
+        if (reader.beginObject())
+        {
+            std::string_view key;
+            while (reader.nextMember(key))
+            {
+                if (key != "missions" || reader.peekType() != util::JsonType::Array)
+                {
+                    reader.skipValue();
+                    continue;
+                }
 
-        // Remover espacios finales
-        while (!valueStr.empty() && (valueStr.back() == ' ' || valueStr.back() == '\n' || valueStr.back() == '\t'))
-            valueStr.pop_back();
+                foundMissions = true;
+                reader.beginArray();
+                while (reader.nextElement())
+                {
+                    MissionDefinition mission;
+                    readMission(ctx, mission);
+                    if (!mission.id.empty())
+                    {
+                        loaded.push_back(std::move(mission));
+                    }
+                }
+            }
+        }
+        reader.finish();
 
-        try
+        if (!reader.ok())
         {
-            return std::stof(valueStr);
+            if (verbose_)
+                reportSyntaxError(reader, sourceName);
+            return false;
         }
-        catch (...)
+        if (!foundMissions)
         {
-            return defaultValue;
+            if (verbose_)
+                std::cerr << "Error: No se encontró el campo 'missions' en el JSON" << std::endl;
+            return false;
         }
-    }
 
-    static int extractJsonInt(const std::string &json, const std::string &key, int defaultValue = 0)
-    {
-        return static_cast<int>(extractJsonFloat(json, key, static_cast<float>(defaultValue)));
-    }
-
-    MissionDefinition MissionRegistry::parseMissionFromJson(const std::string &jsonContent)
-    {
-        MissionDefinition mission;
-
-        mission.id = extractJsonString(jsonContent, "id");
-        mission.name = extractJsonString(jsonContent, "name");
-        mission.description = extractJsonString(jsonContent, "description");
-        mission.briefing = extractJsonString(jsonContent, "briefing");
-        mission.category = extractJsonString(jsonContent, "category");
-        mission.difficulty = extractJsonInt(jsonContent, "difficulty", 1);
-        mission.thumbnailPath = extractJsonString(jsonContent, "thumbnailPath");
-
-        // Parsear startPosition (vector 3D opcional)
-        size_t startPosKey = jsonContent.find("\"startPosition\"");
-        if (startPosKey != std::string::npos)
-        {
-            size_t objStart = jsonContent.find('{', startPosKey);
-            size_t objEnd = jsonContent.find('}', objStart);
-            if (objStart != std::string::npos && objEnd != std::string::npos)
+        if (verbose_)
+        {
+            for (size_t i = 0; i < loaded.size() && i < MAX_LOGGED_MISSIONS; ++i)
+            {
+                std::cout << "✓ Misión cargada: " << loaded[i].name << " [" << loaded[i].id << "]" << std::endl;
+            }
+            if (loaded.size() > MAX_LOGGED_MISSIONS)
+            {
+                std::cout << "  ... y " << loaded.size() - MAX_LOGGED_MISSIONS << " misiones más" << std::endl;
+            }
+            if (ctx.ignoredFields > 0)
             {
-                std::string posObj = jsonContent.substr(objStart, objEnd - objStart + 1);
-                mission.startPosition.x = extractJsonFloat(posObj, "x", 0.0f);
-                mission.startPosition.y = extractJsonFloat(posObj, "y", 1500.0f);
-                mission.startPosition.z = extractJsonFloat(posObj, "z", 0.0f);
+                std::cerr << "Warning: " << ctx.ignoredFields << " campos con tipo inesperado en "
+                          << sourceName << " (se usaron valores por defecto)" << std::endl;
             }
         }
 
-        // Parsear waypoints: lista de objetos con nombre y posición
-        size_t waypointsKey = jsonContent.find("\"waypoints\"");
-        if (waypointsKey != std::string::npos)
+        if (missions_.empty())
         {
-            size_t arrayStart = jsonContent.find('[', waypointsKey);
-            size_t arrayEnd = jsonContent.find(']', arrayStart);
-            if (arrayStart != std::string::npos && arrayEnd != std::string::npos)
-            {
-                std::string waypointsArray = jsonContent.substr(arrayStart + 1, arrayEnd - arrayStart - 1);
+            missions_ = std::move(loaded);
+        }
+        else
+        {
+            missions_.insert(missions_.end(), std::make_move_iterator(loaded.begin()),
+                             std::make_move_iterator(loaded.end()));
+        }
+        invalidateIndices();
 
-                // Parsear cada waypoint
-                size_t pos = 0;
-                while (pos < waypointsArray.length())
-                {
-                    size_t wpStart = waypointsArray.find('{', pos);
-                    if (wpStart == std::string::npos)
-                        break;
+        if (verbose_)
+            std::cout << "Total de misiones cargadas: " << missions_.size() << std::endl;
+        return !missions_.empty();
+    }
 
-                    int braceCount = 1;
-                    size_t wpEnd = wpStart + 1;
-                    while (wpEnd < waypointsArray.length() && braceCount > 0)
-                    {
-                        if (waypointsArray[wpEnd] == '{')
-                            braceCount++;
-                        else if (waypointsArray[wpEnd] == '}')
-                            braceCount--;
-                        wpEnd++;
-                    }
+    bool MissionRegistry::parseMissionFile(const std::string &filepath, MissionDefinition &mission)
+    {
+        util::MappedFile file;
+        if (!file.open(filepath))
+        {
+            std::cerr << "Error: No se pudo abrir el archivo de misión: " << filepath << std::endl;
+            return false;
+        }
 
-                    std::string wpJson = waypointsArray.substr(wpStart, wpEnd - wpStart);
+        util::JsonReader reader(file.view());
+        ParseContext ctx{reader};
+        MissionDefinition parsed;
+        if (reader.peekType() == util::JsonType::Object)
+            readMission(ctx, parsed);
+        else
+            reader.beginObject(); // falla y registra el error con su posición
 
-                    WaypointDef wp;
-                    wp.name = extractJsonString(wpJson, "name");
+        if (!reader.finish())
+        {
+            reportSyntaxError(reader, filepath);
+            return false;
+        }
 
-                    // Parsear position
-                    size_t posKey = wpJson.find("\"position\"");
-                    if (posKey != std::string::npos)
-                    {
-                        size_t pObjStart = wpJson.find('{', posKey);
-                        size_t pObjEnd = wpJson.find('}', pObjStart);
-                        if (pObjStart != std::string::npos && pObjEnd != std::string::npos)
-                        {
-                            std::string posObj = wpJson.substr(pObjStart, pObjEnd - pObjStart + 1);
-                            wp.position.x = extractJsonFloat(posObj, "x", 0.0f);
-                            wp.position.y = extractJsonFloat(posObj, "y", 1500.0f);
-                            wp.position.z = extractJsonFloat(posObj, "z", 0.0f);
-                        }
-                    }
+        mission = std::move(parsed);
+        return true;
+    }
 
-                    mission.waypoints.push_back(wp);
-                    pos = wpEnd;
-                }
-            }
+    bool MissionRegistry::loadPack(const std::string &packPath)
+    {
+        clear();
+        if (!pack_.open(packPath))
+        {
+            if (verbose_)
+                std::cerr << "Error: Paquete de misiones inválido (" << packPath << "): " << pack_.error() << std::endl;
+            return false;
         }
 
-        // Parsear environment (opcional)
-        size_t envKey = jsonContent.find("\"environment\"");
-        if (envKey != std::string::npos)
+        materialized_.resize(pack_.missionCount());
+        invalidateIndices();
+        if (verbose_)
         {
-            size_t objStart = jsonContent.find('{', envKey);
-            size_t objEnd = jsonContent.find('}', objStart);
-            if (objStart != std::string::npos && objEnd != std::string::npos)
-            {
-                std::string envObj = jsonContent.substr(objStart, objEnd - objStart + 1);
-                mission.environment.timeOfDay = extractJsonString(envObj, "timeOfDay");
-                mission.environment.weather = extractJsonString(envObj, "weather");
-                mission.environment.windSpeed = extractJsonFloat(envObj, "windSpeed", 0.0f);
-                mission.environment.windDirection = extractJsonFloat(envObj, "windDirection", 0.0f);
-            }
+            std::cout << "✓ Paquete de misiones mapeado: " << pack_.missionCount() << " misiones ("
+                      << pack_.fileSize() / 1024 << " KiB) [" << packPath << "]" << std::endl;
         }
+        return pack_.missionCount() > 0;
+    }
 
-        return mission;
+    bool MissionRegistry::compilePack(const std::string &jsonPath, const std::string &packPath)
+    {
+        MissionRegistry registry;
+        registry.setVerbose(false);
+        if (!registry.loadFromFile(jsonPath))
+        {
+            std::cerr << "Error: No se pudo compilar " << jsonPath << " (JSON inválido o sin misiones)" << std::endl;
+            return false;
+        }
+        if (!MissionPack::compile(registry.missions_, packPath))
+        {
+            return false;
+        }
+        std::cout << "✓ Paquete compilado: " << registry.missions_.size() << " misiones → " << packPath << std::endl;
+        return true;
     }
 
     const std::vector<MissionDefinition> &MissionRegistry::getMissions() const
@@ -264,18 +481,39 @@ namespace mission
 
     const MissionDefinition *MissionRegistry::getMissionById(const std::string &id) const
     {
-        for (const auto &mission : missions_)
+        long index = findIndexById(id);
+        return index >= 0 ? getMissionByIndex(static_cast<size_t>(index)) : nullptr;
+    }
+
+    long MissionRegistry::findIndexById(std::string_view id) const
+    {
+        buildIndices();
+        auto it = idIndex_.find(id);
+        return it != idIndex_.end() ? static_cast<long>(it->second) : -1;
+    }
+
+    const MissionDefinition *MissionRegistry::getMissionByIndex(size_t index) const
+    {
+        if (pack_.isOpen())
         {
-            if (mission.id == id)
+            if (index >= materialized_.size())
+                return nullptr;
+
+            // Primera consulta de esta misión: construirla desde el paquete
+            if (!materialized_[index])
             {
-                return &mission;
+                auto mission = std::make_unique<MissionDefinition>();
+                if (!pack_.materialize(index, *mission))
+                {
+                    if (verbose_)
+                        std::cerr << "Error: Registro de misión corrupto en el paquete (índice " << index << ")" << std::endl;
+                    return nullptr;
+                }
+                materialized_[index] = std::move(mission);
             }
+            return materialized_[index].get();
         }
-        return nullptr;
-    }
 
-    const MissionDefinition *MissionRegistry::getMissionByIndex(size_t index) const
-    {
         if (index < missions_.size())
         {
             return &missions_[index];
@@ -283,14 +521,216 @@ namespace mission
         return nullptr;
     }
 
+    MissionSummary MissionRegistry::getMissionSummary(size_t index) const
+    {
+        MissionSummary summary;
+        if (pack_.isOpen())
+        {
+            summary.id = pack_.id(index);
+            summary.name = pack_.name(index);
+            summary.difficulty = pack_.difficulty(index);
+            summary.waypointCount = pack_.waypointCount(index);
+        }
+        else if (index < missions_.size())
+        {
+            const MissionDefinition &mission = missions_[index];
+            summary.id = mission.id;
+            summary.name = mission.name;
+            summary.difficulty = mission.difficulty;
+            summary.waypointCount = mission.waypoints.size();
+        }
+        return summary;
+    }
+
     size_t MissionRegistry::getMissionCount() const
     {
-        return missions_.size();
+        return pack_.isOpen() ? pack_.missionCount() : missions_.size();
+    }
+
+    void MissionRegistry::query(const MissionQuery &query, std::vector<uint32_t> &out) const
+    {
+        out.clear();
+        const size_t count = getMissionCount();
+
+        // Listado completo en orden de archivo: no hace falta ningún índice
+        // (en modo paquete así no se tocan las páginas de todos los registros)
+        if (query.category.empty() && query.difficulty <= 0 && query.sort == MissionSort::Catalog)
+        {
+            out.resize(count);
+            std::iota(out.begin(), out.end(), 0u);
+            return;
+        }
+
+        buildIndices();
+        const std::vector<uint32_t> *byCategory = nullptr;
+        const std::vector<uint32_t> *byDifficulty = nullptr;
+        if (!query.category.empty())
+        {
+            auto it = categoryIndex_.find(query.category);
+            if (it == categoryIndex_.end())
+                return;
+            byCategory = &it->second;
+        }
+        if (query.difficulty > 0)
+        {
+            auto it = difficultyIndex_.find(query.difficulty);
+            if (it == difficultyIndex_.end())
+                return;
+            byDifficulty = &it->second;
+        }
+
+        if (!byCategory && !byDifficulty)
+        {
+            // Solo orden: copiar el orden precalculado
+            buildSortedViews();
+            out = query.sort == MissionSort::Name ? nameOrder_ : lengthOrder_;
+            return;
+        }
+
+        // Las listas están en orden de índice, así que se pueden intersectar en O(n + m)
+        if (byCategory && byDifficulty)
+        {
+            std::set_intersection(byCategory->begin(), byCategory->end(),
+                                  byDifficulty->begin(), byDifficulty->end(), std::back_inserter(out));
+        }
+        else
+        {
+            const std::vector<uint32_t> &list = byCategory ? *byCategory : *byDifficulty;
+            out.assign(list.begin(), list.end());
+        }
+
+        if (query.sort != MissionSort::Catalog)
+        {
+            buildSortedViews();
+            const std::vector<uint32_t> &rank = query.sort == MissionSort::Name ? nameRank_ : lengthRank_;
+            std::sort(out.begin(), out.end(), [&rank](uint32_t a, uint32_t b)
+                      { return rank[a] < rank[b]; });
+        }
+    }
+
+    const std::vector<std::string_view> &MissionRegistry::getCategories() const
+    {
+        buildIndices();
+        return categories_;
+    }
+
+    float MissionRegistry::getMissionLength(size_t index) const
+    {
+        buildSortedViews();
+        return index < lengths_.size() ? lengths_[index] : 0.0f;
+    }
+
+    std::string_view MissionRegistry::categoryOf(size_t index) const
+    {
+        if (pack_.isOpen())
+            return pack_.category(index);
+        return index < missions_.size() ? std::string_view(missions_[index].category) : std::string_view();
+    }
+
+    void MissionRegistry::invalidateIndices()
+    {
+        indicesBuilt_ = false;
+        sortedViewsBuilt_ = false;
+        idIndex_.clear();
+        categoryIndex_.clear();
+        difficultyIndex_.clear();
+        categories_.clear();
+        lengths_.clear();
+        nameOrder_.clear();
+        lengthOrder_.clear();
+        nameRank_.clear();
+        lengthRank_.clear();
+    }
+
+    void MissionRegistry::buildIndices() const
+    {
+        if (indicesBuilt_)
+            return;
+        indicesBuilt_ = true;
+
+        const size_t count = getMissionCount();
+        idIndex_.reserve(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            const uint32_t index = static_cast<uint32_t>(i);
+            MissionSummary summary = getMissionSummary(i);
+            idIndex_.emplace(summary.id, index); // con ids repetidos gana la primera, como la búsqueda lineal
+            categoryIndex_[categoryOf(i)].push_back(index);
+            difficultyIndex_[summary.difficulty].push_back(index);
+        }
+
+        categories_.reserve(categoryIndex_.size());
+        for (const auto &entry : categoryIndex_)
+        {
+            categories_.push_back(entry.first);
+        }
+        std::sort(categories_.begin(), categories_.end());
+    }
+
+    void MissionRegistry::buildSortedViews() const
+    {
+        if (sortedViewsBuilt_)
+            return;
+        sortedViewsBuilt_ = true;
+
+        const size_t count = getMissionCount();
+        lengths_.resize(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            if (pack_.isOpen())
+            {
+                lengths_[i] = pack_.routeLength(i);
+                continue;
+            }
+
+            // Misma medida que MissionPlanner::computeMissionLength
+            const MissionDefinition &mission = missions_[i];
+            float length = 0.0f;
+            float x = mission.startPosition.x;
+            float z = mission.startPosition.z;
+            for (const auto &wp : mission.waypoints)
+            {
+                float dx = wp.position.x - x;
+                float dz = wp.position.z - z;
+                length += std::sqrt(dx * dx + dz * dz);
+                x = wp.position.x;
+                z = wp.position.z;
+            }
+            lengths_[i] = length;
+        }
+
+        std::vector<std::string_view> names(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            names[i] = getMissionSummary(i).name;
+        }
+
+        // Órdenes estables: a igual clave se respeta el orden del archivo
+        nameOrder_.resize(count);
+        std::iota(nameOrder_.begin(), nameOrder_.end(), 0u);
+        std::stable_sort(nameOrder_.begin(), nameOrder_.end(), [&names](uint32_t a, uint32_t b)
+                         { return names[a] < names[b]; });
+
+        lengthOrder_.resize(count);
+        std::iota(lengthOrder_.begin(), lengthOrder_.end(), 0u);
+        std::stable_sort(lengthOrder_.begin(), lengthOrder_.end(), [this](uint32_t a, uint32_t b)
+                         { return lengths_[a] < lengths_[b]; });
+
+        nameRank_.resize(count);
+        lengthRank_.resize(count);
+        for (size_t k = 0; k < count; ++k)
+        {
+            nameRank_[nameOrder_[k]] = static_cast<uint32_t>(k);
+            lengthRank_[lengthOrder_[k]] = static_cast<uint32_t>(k);
+        }
     }
 
     void MissionRegistry::clear()
     {
         missions_.clear();
+        materialized_.clear();
+        pack_.close();
+        invalidateIndices();
     }
 
 } // namespace mission
@@ -6,20 +6,68 @@
 #pragma once
 
 #include "MissionDefinition.h"
+#include "MissionPack.h"
+#include <cstdint>
+#include <map>
 #include <vector>
 #include <string>
+#include <string_view>
 #include <memory>
+#include <unordered_map>
 
 namespace mission
 {
 
+    /**
+     * @brief Datos de una misión para listados, sin materializar la definición completa
+     *
+     * Las vistas apuntan al registro (o al paquete mapeado) y son válidas hasta
+     * la próxima carga o `clear()`.
+     */
+    struct MissionSummary
+    {
+        std::string_view id;
+        std::string_view name;
+        int difficulty = 0;
+        size_t waypointCount = 0;
+    };
+
+    /// Orden de los resultados de `MissionRegistry::query`
+    enum class MissionSort
+    {
+        Catalog, ///< Orden del archivo
+        Name,    ///< Alfabético por nombre (bytes UTF-8)
+        Length   ///< Longitud de la ruta, de menor a mayor
+    };
+
+    /**
+     * @brief Filtro de misiones para listados
+     *
+     * Un campo vacío (categoría) o en cero (dificultad) no filtra.
+     */
+    struct MissionQuery
+    {
+        std::string_view category;
+        int difficulty = 0;
+        MissionSort sort = MissionSort::Catalog;
+    };
+
     /**
      * @brief Registro centralizado de misiones disponibles
      *
      * Responsabilidades principales:
      * - Parsear archivos `missions.json` en estructuras `MissionDefinition`
+     *   (una sola pasada con `util::JsonReader` sobre el archivo mapeado en memoria)
      * - Exponer búsquedas rápidas por índice o id (string)
      * - Mantener una copia inmutable para que UI y runtime la consulten sin side-effects
+     *
+     * Con un paquete binario (`loadPack`) las misiones no se parsean al inicio:
+     * el listado usa `getMissionSummary` sobre el archivo mapeado y cada
+     * `MissionDefinition` se materializa la primera vez que se pide por índice o id.
+     *
+     * Para catálogos grandes las búsquedas usan índices que se construyen en la
+     * primera consulta y se descartan en cada carga: tabla hash por id, listas
+     * por categoría y dificultad, y órdenes precalculados por nombre y longitud.
      */
     class MissionRegistry
     {
@@ -27,6 +75,10 @@ namespace mission
         MissionRegistry();
         ~MissionRegistry() = default;
 
+        /// Movible: la recarga en caliente parsea en otro hilo y mueve el resultado
+        MissionRegistry(MissionRegistry &&) = default;
+        MissionRegistry &operator=(MissionRegistry &&) = default;
+
         /**
          * @brief Cargar misiones desde un archivo JSON
          * @param filepath Ruta al archivo JSON con definiciones de misiones
@@ -35,7 +87,47 @@ namespace mission
         bool loadFromFile(const std::string &filepath);
 
         /**
-         * @brief Obtener todas las misiones cargadas
+         * @brief Cargar misiones desde texto JSON ya en memoria
+         * @param json Documento `{ "missions": [ ... ] }`
+         * @param sourceName Nombre usado en los mensajes de error
+         * @return true si el documento es válido y hay misiones cargadas
+         *
+         * La carga es atómica: si el documento tiene un error de sintaxis no se
+         * agrega ninguna de sus misiones.
+         */
+        bool loadFromMemory(std::string_view json, const std::string &sourceName = "<memoria>");
+
+        /**
+         * @brief Parsear un archivo con un único objeto de misión (formato del planificador)
+         * @return true si se pudo leer y parsear
+         */
+        static bool parseMissionFile(const std::string &filepath, MissionDefinition &mission);
+
+        /**
+         * @brief Activar/desactivar el log por misión (benchmarks y archivos enormes)
+         */
+        void setVerbose(bool verbose) { verbose_ = verbose; }
+
+        /**
+         * @brief Mapear un paquete compilado (`.pack`) en lugar de parsear JSON
+         * @return true si el paquete es válido y contiene misiones
+         *
+         * Reemplaza las misiones cargadas hasta el momento.
+         */
+        bool loadPack(const std::string &packPath);
+
+        /**
+         * @brief Compilar un `missions.json` a paquete binario
+         */
+        static bool compilePack(const std::string &jsonPath, const std::string &packPath);
+
+        /// true si las misiones vienen de un paquete mapeado
+        bool isPacked() const { return pack_.isOpen(); }
+
+        /**
+         * @brief Obtener las misiones cargadas desde JSON
+         *
+         * En modo paquete está vacío: usar `getMissionByIndex`/`getMissionSummary`.
          */
         const std::vector<MissionDefinition> &getMissions() const;
 
@@ -46,11 +138,35 @@ namespace mission
          */
         const MissionDefinition *getMissionById(const std::string &id) const;
 
+        /// Índice de la misión con ese id, o -1 (O(1) con el índice hash)
+        long findIndexById(std::string_view id) const;
+
         /**
          * @brief Obtener una misión por índice
          */
         const MissionDefinition *getMissionByIndex(size_t index) const;
 
+        /**
+         * @brief Resumen de una misión (id, nombre, dificultad, waypoints) sin materializarla
+         */
+        MissionSummary getMissionSummary(size_t index) const;
+
+        /**
+         * @brief Índices de las misiones que cumplen el filtro, en el orden pedido
+         * @param query Categoría/dificultad a filtrar y orden de salida
+         * @param out Se reemplaza su contenido (se reutiliza su capacidad)
+         *
+         * Sin filtros y con orden por nombre/longitud copia el orden precalculado;
+         * con filtros intersecta las listas de los índices secundarios.
+         */
+        void query(const MissionQuery &query, std::vector<uint32_t> &out) const;
+
+        /// Categorías presentes en el catálogo, ordenadas alfabéticamente
+        const std::vector<std::string_view> &getCategories() const;
+
+        /// Longitud de la ruta de una misión en metros (plano XZ)
+        float getMissionLength(size_t index) const;
+
         /**
          * @brief Obtener número de misiones cargadas
          */
@@ -62,10 +178,31 @@ namespace mission
         void clear();
 
     private:
+        std::string_view categoryOf(size_t index) const;
+        void invalidateIndices();
+        void buildIndices() const;
+        void buildSortedViews() const;
+
         std::vector<MissionDefinition> missions_;
+        bool verbose_ = true;
+
+        // Índices de consulta (perezosos, solo hilo principal). Las claves
+        // apuntan a strings de missions_ o del paquete mapeado.
+        mutable bool indicesBuilt_ = false;
+        mutable bool sortedViewsBuilt_ = false;
+        mutable std::unordered_map<std::string_view, uint32_t> idIndex_;
+        mutable std::unordered_map<std::string_view, std::vector<uint32_t>> categoryIndex_;
+        mutable std::map<int, std::vector<uint32_t>> difficultyIndex_;
+        mutable std::vector<std::string_view> categories_;
+        mutable std::vector<float> lengths_;
+        mutable std::vector<uint32_t> nameOrder_;   ///< Índices ordenados por nombre
+        mutable std::vector<uint32_t> lengthOrder_; ///< Índices ordenados por longitud
+        mutable std::vector<uint32_t> nameRank_;    ///< Posición de cada misión en nameOrder_
+        mutable std::vector<uint32_t> lengthRank_;  ///< Posición de cada misión en lengthOrder_
 
-        // Helper para parsear JSON manualmente cuando no se usa un parser completo
-        MissionDefinition parseMissionFromJson(const std::string &jsonContent);
+        // Modo paquete: definiciones materializadas a demanda (solo hilo principal)
+        MissionPack pack_;
+        mutable std::vector<std::unique_ptr<MissionDefinition>> materialized_;
     };
 
 } // namespace mission
@@ -5,6 +5,9 @@
 
 #include "MissionRuntime.h"
 #include "../flight/data/FlightData.h"
+#include <algorithm>
+#include <cctype>
+#include <ctime>
 #include <iostream>
 #include <glm/glm.hpp>
 
@@ -12,7 +15,8 @@ namespace mission
 {
 
     MissionRuntime::MissionRuntime()
-        : phase_(MissionPhase::Briefing), hasMission_(false), menuExitRequested_(false), activeWaypointIndex_(0), speedAccumulator_(0.0f)
+        : phase_(MissionPhase::Briefing), hasMission_(false), menuExitRequested_(false), activeWaypointIndex_(0),
+          missionTime_(0.0f)
     {
     }
 
@@ -35,7 +39,30 @@ namespace mission
         metrics_ = MissionMetrics();
         metrics_.totalWaypoints = static_cast<int>(mission.waypoints.size());
         missionStartTime_ = std::chrono::steady_clock::now();
-        speedAccumulator_ = 0.0f;
+        recorder_ = FlightRecorder();
+
+        // Compilar disparadores (los que fallan quedan deshabilitados)
+        size_t failed = triggers_.load(mission);
+        triggerInputs_ = TriggerInputs();
+        missionTime_ = 0.0f;
+        objectivesResolved_.assign(mission.triggers.size(), false);
+        for (const TriggerDef &trigger : mission.triggers)
+        {
+            if (trigger.action == TriggerAction::Objective)
+            {
+                metrics_.totalObjectives++;
+            }
+        }
+        if (!mission.triggers.empty())
+        {
+            std::cout << "[MissionRuntime] " << mission.triggers.size() << " disparadores, "
+                      << mission.zones.size() << " zonas";
+            if (failed > 0)
+            {
+                std::cout << " (" << failed << " con errores)";
+            }
+            std::cout << std::endl;
+        }
 
         // Crear contexto de inicio que el FlightSimulationController usará para posicionar avión
         MissionStartContext context;
@@ -58,6 +85,8 @@ namespace mission
             // Transición hacia InProgress cuando el piloto cierra el briefing
             phase_ = MissionPhase::InProgress;
             missionStartTime_ = std::chrono::steady_clock::now(); // Resetear cronómetro
+            // Un tramo por waypoint y el final abierto: capturar no reserva memoria en pleno vuelo
+            recorder_.start(1.0f, currentMission_.waypoints.size() + 1);
             std::cout << "[MissionRuntime] Misión iniciada - Buena suerte, piloto!" << std::endl;
         }
     }
@@ -73,21 +102,31 @@ namespace mission
         {
             waypointsCaptured_[waypointIndex] = true;
             metrics_.waypointsCaptured++;
+            recorder_.endLeg(waypointIndex);
 
             std::cout << "[MissionRuntime] Waypoint " << (waypointIndex + 1) << " capturado ("
                       << metrics_.waypointsCaptured << "/" << metrics_.totalWaypoints << ")" << std::endl;
 
-            // Avanzar al siguiente waypoint secuencial
+            // Avanzar al siguiente waypoint no capturado (en modo Any puede haber saltos)
             if (waypointIndex == activeWaypointIndex_)
             {
-                activeWaypointIndex_++;
+                while (activeWaypointIndex_ < static_cast<int>(waypointsCaptured_.size()) &&
+                       waypointsCaptured_[activeWaypointIndex_])
+                {
+                    activeWaypointIndex_++;
+                }
             }
 
             // Verificar si se completó la misión
-            if (metrics_.waypointsCaptured >= metrics_.totalWaypoints)
-            {
-                markCompletion();
-            }
+            tryComplete();
+        }
+    }
+
+    void MissionRuntime::setActiveWaypointIndex(int waypointIndex)
+    {
+        if (waypointIndex >= 0 && waypointIndex < static_cast<int>(waypointsCaptured_.size()))
+        {
+            activeWaypointIndex_ = waypointIndex;
         }
     }
 
@@ -102,11 +141,28 @@ namespace mission
             auto duration = std::chrono::duration_cast<std::chrono::seconds>(now - missionStartTime_);
             metrics_.totalTimeSeconds = static_cast<float>(duration.count());
 
+            recorder_.finish();
+            saveRecording();
+
             // El mensaje de completación lo muestra MissionOverlay::showCompletionPrompt()
             std::cout << "[MissionRuntime] Misión completada - Esperando decisión del piloto" << std::endl;
         }
     }
 
+    void MissionRuntime::tryComplete()
+    {
+        // Una misión sin waypoints ni objetivos solo termina con un disparador "complete"
+        if (metrics_.totalWaypoints == 0 && metrics_.totalObjectives == 0)
+        {
+            return;
+        }
+        if (metrics_.waypointsCaptured >= metrics_.totalWaypoints &&
+            metrics_.objectivesCompleted + metrics_.objectivesFailed >= metrics_.totalObjectives)
+        {
+            markCompletion();
+        }
+    }
+
     void MissionRuntime::continueFreeFlight()
     {
         if (phase_ == MissionPhase::Completed)
@@ -133,8 +189,13 @@ namespace mission
         activeWaypointIndex_ = 0;
         waypointsCaptured_.clear();
 
+        triggers_.clear();
+        triggerEvents_.clear();
+        objectivesResolved_.clear();
+        missionTime_ = 0.0f;
+
         metrics_ = MissionMetrics();
-        speedAccumulator_ = 0.0f;
+        recorder_ = FlightRecorder();
     }
 
     void MissionRuntime::updateProgress(const flight::FlightData &flightData, float dt)
@@ -153,30 +214,132 @@ namespace mission
                 markWaypointCaptured(activeWaypointIndex_);
             }
         }
+
+        missionTime_ += dt;
+        updateTriggers(flightData);
+    }
+
+    void MissionRuntime::updateTriggers(const flight::FlightData &flightData)
+    {
+        if (triggers_.size() == 0 || phase_ != MissionPhase::InProgress)
+        {
+            return;
+        }
+
+        TriggerInputs &in = triggerInputs_;
+        in[TriggerField::Altitude] = flightData.altitude;
+        in[TriggerField::Airspeed] = flightData.airspeed;
+        in[TriggerField::VerticalSpeed] = flightData.verticalSpeed;
+        in[TriggerField::Heading] = flightData.heading;
+        in[TriggerField::Pitch] = flightData.pitch;
+        in[TriggerField::Roll] = flightData.roll;
+        in[TriggerField::GForce] = flightData.gForce;
+        in[TriggerField::Time] = missionTime_;
+        in[TriggerField::Captured] = static_cast<float>(metrics_.waypointsCaptured);
+        in.position = flightData.position;
+
+        // Solo se reevalúan las condiciones cuyas entradas cambiaron
+        triggers_.update(in, triggerEvents_);
+
+        bool completeRequested = false;
+        for (const TriggerEvent &event : triggerEvents_)
+        {
+            const TriggerDef &def = currentMission_.triggers[event.trigger];
+            if (event.type == TriggerEvent::Type::Expired)
+            {
+                std::cout << "[MissionRuntime] Plazo vencido: " << def.id << std::endl;
+                metrics_.perfectRun = false;
+                if (def.action == TriggerAction::Objective && !objectivesResolved_[event.trigger])
+                {
+                    objectivesResolved_[event.trigger] = true;
+                    metrics_.objectivesFailed++;
+                }
+                continue;
+            }
+
+            if (!def.message.empty())
+            {
+                std::cout << "[MissionRuntime] " << def.message << std::endl;
+            }
+            switch (def.action)
+            {
+            case TriggerAction::Message:
+                break;
+            case TriggerAction::Objective:
+                if (!objectivesResolved_[event.trigger])
+                {
+                    objectivesResolved_[event.trigger] = true;
+                    metrics_.objectivesCompleted++;
+                    std::cout << "[MissionRuntime] Objetivo cumplido: " << def.id << " ("
+                              << metrics_.objectivesCompleted << "/" << metrics_.totalObjectives << ")" << std::endl;
+                }
+                break;
+            case TriggerAction::Penalty:
+                metrics_.perfectRun = false;
+                break;
+            case TriggerAction::Complete:
+                completeRequested = true;
+                break;
+            }
+        }
+
+        if (completeRequested)
+        {
+            markCompletion();
+        }
+        else if (!triggerEvents_.empty())
+        {
+            tryComplete();
+        }
     }
 
     void MissionRuntime::updateMetrics(const flight::FlightData &flightData, float dt)
     {
-        if (!hasMission_ || (phase_ != MissionPhase::InProgress && phase_ != MissionPhase::FreeFlight))
+        // Solo se graba la misión en sí; en vuelo libre las métricas quedan como al completarla
+        if (!hasMission_ || phase_ != MissionPhase::InProgress)
         {
             return;
         }
 
-        // Actualizar velocidad promedio usando integración simple
-        speedAccumulator_ += flightData.airspeed * dt;
-        auto now = std::chrono::steady_clock::now();
-        auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(now - missionStartTime_);
-        float totalTime = duration.count() / 1000.0f;
+        recorder_.record(flightData, dt);
+
+        // Agregados en O(1) que mantiene el grabador
+        const ChannelStats &speed = recorder_.channel(FlightChannel::Airspeed);
+        const ChannelStats &altitude = recorder_.channel(FlightChannel::Altitude);
+        const ChannelStats &gForce = recorder_.channel(FlightChannel::GForce);
+        metrics_.averageSpeed = speed.mean();
+        metrics_.maxAltitude = std::max(metrics_.maxAltitude, altitude.max);
+        metrics_.minGForce = gForce.min;
+        metrics_.maxGForce = gForce.max;
+        metrics_.distance = recorder_.distance();
+        metrics_.fuelUsed = recorder_.fuel();
+    }
+
+    void MissionRuntime::saveRecording() const
+    {
+        if (recorder_.sampleCount() == 0)
+        {
+            return;
+        }
 
-        if (totalTime > 0.0f)
+        // recordings/<misión>_<AAAAMMDD-HHMMSS>.fsrec
+        std::string name;
+        for (char c : currentMission_.id)
+        {
+            name += (std::isalnum(static_cast<unsigned char>(c)) || c == '-' || c == '_') ? c : '_';
+        }
+        char stamp[32] = "";
+        std::time_t now = std::time(nullptr);
+        if (const std::tm *local = std::localtime(&now))
         {
-            metrics_.averageSpeed = speedAccumulator_ / totalTime;
+            std::strftime(stamp, sizeof(stamp), "%Y%m%d-%H%M%S", local);
         }
+        std::string path = "recordings/" + (name.empty() ? std::string("mission") : name) + "_" + stamp + ".fsrec";
 
-        // Actualizar altitud máxima alcanzada
-        if (flightData.altitude > metrics_.maxAltitude)
+        if (recorder_.save(path))
         {
-            metrics_.maxAltitude = flightData.altitude;
+            std::cout << "[MissionRuntime] Vuelo grabado: " << path << " (" << recorder_.sampleCount() << " muestras, "
+                      << recorder_.encodedBytes() << " bytes, " << recorder_.legs().size() << " tramos)" << std::endl;
         }
     }
 
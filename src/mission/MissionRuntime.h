@@ -5,12 +5,15 @@
  * Este módulo centraliza toda la lógica de estado de una sesión de misión:
  * - Fases: Briefing, InProgress, Completed, FreeFlight
  * - Control de waypoints y progreso
- * - Métricas de rendimiento
+ * - Disparadores declarativos de la misión (`TriggerEngine`)
+ * - Métricas de rendimiento y grabación del vuelo (`FlightRecorder`)
  */
 
 #pragma once
 
+#include "FlightRecorder.h"
 #include "MissionDefinition.h"
+#include "TriggerEngine.h"
 #include <chrono>
 #include <string>
 
@@ -56,6 +59,13 @@ namespace mission
         int totalWaypoints = 0;
         float averageSpeed = 0.0f; // kt
         float maxAltitude = 0.0f;  // ft
+        float distance = 0.0f;     // m recorridos
+        float fuelUsed = 0.0f;     // Integral de la potencia (throttle · s)
+        float minGForce = 0.0f;
+        float maxGForce = 0.0f;
+        int objectivesCompleted = 0;
+        int objectivesFailed = 0;  // Vencidos (`within`)
+        int totalObjectives = 0;   // Disparadores con acción "objective"
         bool perfectRun = true;    // Sin errores graves
     };
 
@@ -95,6 +105,13 @@ namespace mission
          */
         void markCompletion();
 
+        /**
+         * @brief Completa la misión si no queda nada pendiente
+         *
+         * Pendiente: waypoints sin capturar u objetivos sin resolver (cumplidos o vencidos).
+         */
+        void tryComplete();
+
         /**
          * @brief Continúa en modo vuelo libre después de completar la misión
          */
@@ -181,6 +198,11 @@ namespace mission
          */
         int getActiveWaypointIndex() const { return activeWaypointIndex_; }
 
+        /**
+         * @brief Fija el waypoint activo (modo `WaypointOrder::Any`: el más cercano)
+         */
+        void setActiveWaypointIndex(int waypointIndex);
+
         /**
          * @brief Obtiene la misión actual
          */
@@ -191,6 +213,11 @@ namespace mission
          */
         const MissionMetrics &getMetrics() const { return metrics_; }
 
+        /**
+         * @brief Grabación del vuelo en curso (tramos y traza para el debriefing)
+         */
+        const FlightRecorder &getRecorder() const { return recorder_; }
+
         /**
          * @brief Confirma que el piloto está listo para volar (sale del briefing)
          */
@@ -207,16 +234,33 @@ namespace mission
         int activeWaypointIndex_;
         std::vector<bool> waypointsCaptured_;
 
+        // Disparadores
+        TriggerEngine triggers_;
+        TriggerInputs triggerInputs_;
+        std::vector<TriggerEvent> triggerEvents_;
+        std::vector<bool> objectivesResolved_;
+        float missionTime_; // s en InProgress (entrada `time` de los disparadores)
+
         // Métricas acumuladas
         MissionMetrics metrics_;
         std::chrono::steady_clock::time_point missionStartTime_;
-        float speedAccumulator_; // Para calcular velocidad promedio
+        FlightRecorder recorder_; // Agregados en streaming y traza a 1 Hz
 
         // Helpers
         /**
          * @brief Evalúa si el avión está dentro del radio de captura del waypoint.
          */
         bool checkWaypointCapture(const glm::vec3 &planePos, const glm::vec3 &waypointPos, float captureRadius = 100.0f);
+
+        /**
+         * @brief Alimenta el motor de disparadores y aplica sus acciones
+         */
+        void updateTriggers(const flight::FlightData &flightData);
+
+        /**
+         * @brief Guarda la traza en `recordings/` al completar la misión
+         */
+        void saveRecording() const;
     };
 
 } // namespace mission
@@ -0,0 +1,299 @@
+/**
+ * @file MissionValidator.cpp
+ * @brief Implementación del validador de misiones con piloto automático
+ */
+
+#include "MissionValidator.h"
+#include "MissionRegistry.h"
+#include "WaypointTracker.h"
+#include "core/JobPool.h"
+#include "flight/autopilot/Autopilot.h"
+#include "flight/dlfdm/FdmSimulation.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+
+namespace mission
+{
+
+    namespace
+    {
+        using Clock = std::chrono::steady_clock;
+
+        constexpr float TRIM_THROTTLE = 0.32f; ///< Potencia del estado de trimado (como `resetForMission`)
+        constexpr float KT_TO_MPS = 0.514444f;
+        constexpr float RAD_TO_DEG = 57.2957795f;
+
+        double elapsedMs(Clock::time_point start)
+        {
+            return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        }
+
+        /// Rumbo de la orientación inicial (0 = Norte = -Z)
+        float startHeading(const glm::quat &orientation)
+        {
+            const glm::vec3 front = orientation * glm::vec3(0.0f, 0.0f, -1.0f);
+            const float heading = std::atan2(front.x, -front.z) * RAD_TO_DEG;
+            return heading < 0.0f ? heading + 360.0f : heading;
+        }
+
+        /**
+         * @brief Agrupa en un hallazgo por tramo los frames en que se cumple una condición
+         */
+        class EpisodeTracker
+        {
+        public:
+            EpisodeTracker(ValidationIssue issue, std::vector<ValidationFinding> &findings)
+                : issue_(issue), findings_(findings) {}
+
+            void update(bool active, float value, int waypoint, float time, float dt)
+            {
+                if (!active)
+                    return;
+                if (last_ == SIZE_MAX || findings_[last_].waypoint != waypoint)
+                {
+                    ValidationFinding finding;
+                    finding.issue = issue_;
+                    finding.waypoint = waypoint;
+                    finding.time = time;
+                    finding.peak = value;
+                    last_ = findings_.size();
+                    findings_.push_back(finding);
+                }
+                ValidationFinding &finding = findings_[last_];
+                finding.duration += dt;
+                finding.peak = std::max(finding.peak, value);
+            }
+
+        private:
+            ValidationIssue issue_;
+            std::vector<ValidationFinding> &findings_;
+            size_t last_ = SIZE_MAX;
+        };
+    } // namespace
+
+    bool MissionValidation::passed() const
+    {
+        if (!completed)
+            return false;
+        for (const ValidationFinding &finding : findings)
+        {
+            if (finding.issue != ValidationIssue::UnreachableTurn)
+                return false;
+        }
+        return true;
+    }
+
+    const char *issueName(ValidationIssue issue)
+    {
+        switch (issue)
+        {
+        case ValidationIssue::UnreachableTurn:
+            return "giro inalcanzable";
+        case ValidationIssue::Stall:
+            return "pérdida";
+        case ValidationIssue::OverG:
+            return "exceso de G";
+        case ValidationIssue::Spin:
+            return "barrena";
+        case ValidationIssue::MissedWaypoint:
+            return "waypoint no alcanzado";
+        }
+        return "?";
+    }
+
+    MissionValidation validateMission(const MissionDefinition &mission, const MissionValidationOptions &options)
+    {
+        const Clock::time_point start = Clock::now();
+        MissionValidation result;
+        result.missionId = mission.id;
+        result.waypoints = mission.waypoints.size();
+
+        const float dt = 1.0f / std::max(options.frameRate, 1.0f);
+        const float airspeed = options.airspeed > 0.0f ? options.airspeed : mission.recommendedSpeed;
+
+        flight::FdmSimulation simulation;
+        simulation.initialize(mission.startPosition, startHeading(mission.startOrientation));
+
+        flight::Autopilot autopilot;
+        flight::AutopilotLimits limits;
+        limits.maxBank = options.maxBank;
+        autopilot.setLimits(limits);
+        autopilot.reset(TRIM_THROTTLE);
+
+        WaypointTracker tracker;
+        tracker.load(mission.waypoints, mission.waypointOrder);
+
+        EpisodeTracker turns(ValidationIssue::UnreachableTurn, result.findings);
+        EpisodeTracker stalls(ValidationIssue::Stall, result.findings);
+        EpisodeTracker overG(ValidationIssue::OverG, result.findings);
+        EpisodeTracker spins(ValidationIssue::Spin, result.findings);
+
+        // Plazo del tramo: tiempo en línea recta a la velocidad pedida, con holgura
+        const float speed = std::max(airspeed * KT_TO_MPS, 1.0f);
+        auto legDeadline = [&](const glm::vec3 &from, int target, float now)
+        {
+            return now + glm::distance(from, tracker.position(target)) / speed * options.legTimeFactor +
+                   options.legTimeMargin;
+        };
+
+        float time = 0.0f;
+        glm::vec3 position = simulation.getWorldPosition();
+        result.minAirspeed = simulation.getFlightData().airspeed;
+        int target = tracker.target();
+        float deadline = target >= 0 ? legDeadline(position, target, time) : 0.0f;
+        std::vector<uint32_t> captured;
+
+        while (tracker.remaining() > 0 && target >= 0)
+        {
+            const flight::AutopilotCommand command =
+                autopilot.flyTo(simulation.getFlightData(), tracker.position(target), airspeed, dt);
+            simulation.setNormalizedInputs(command.elevator, command.aileron, command.rudder, command.throttle);
+            simulation.update(dt);
+            time += dt;
+
+            const flight::FlightData &data = simulation.getFlightData();
+            const glm::vec3 next = simulation.getWorldPosition();
+            result.distance += glm::distance(position, next);
+            position = next;
+
+            const float loadFactor = simulation.getLoadFactor();
+            const float angleOfAttack = data.angleOfAttack * RAD_TO_DEG;
+            const flight::FdmSimulation::StateValidation state = simulation.getStateValidation();
+            result.minAirspeed = std::min(result.minAirspeed, data.airspeed);
+            result.maxLoadFactor = std::max(result.maxLoadFactor, loadFactor);
+            result.maxAngleOfAttack = std::max(result.maxAngleOfAttack, angleOfAttack);
+
+            turns.update(autopilot.isExtending(), autopilot.turnRadius(data.airspeed), target, time, dt);
+            stalls.update(state.isStalled || angleOfAttack > options.stallAngleOfAttack, angleOfAttack, target, time, dt);
+            overG.update(loadFactor > options.maxLoadFactor, loadFactor, target, time, dt);
+            spins.update(state.isSpinning, loadFactor, target, time, dt);
+
+            tracker.update(position, captured);
+            if (tracker.target() != target)
+            {
+                target = tracker.target();
+                if (target >= 0)
+                    deadline = legDeadline(position, target, time);
+            }
+            else if (time > deadline)
+            {
+                ValidationFinding missed;
+                missed.issue = ValidationIssue::MissedWaypoint;
+                missed.waypoint = target;
+                missed.time = time;
+                result.findings.push_back(missed);
+                break;
+            }
+        }
+
+        result.captured = tracker.size() - tracker.remaining();
+        result.completed = tracker.remaining() == 0;
+        result.completionTime = time;
+        result.wallMs = elapsedMs(start);
+        return result;
+    }
+
+    std::vector<MissionValidation> validateMissions(const std::vector<MissionDefinition> &missions,
+                                                    const MissionValidationOptions &options, core::JobPool *pool)
+    {
+        std::vector<MissionValidation> results(missions.size());
+        auto validate = [&](size_t index)
+        {
+            results[index] = validateMission(missions[index], options);
+        };
+        if (pool)
+        {
+            pool->parallelFor(missions.size(), validate, options.maxThreads);
+        }
+        else
+        {
+            for (size_t i = 0; i < missions.size(); ++i)
+                validate(i);
+        }
+        return results;
+    }
+
+    int runMissionValidation(const std::string &path, const MissionValidationOptions &options, core::JobPool *pool)
+    {
+        std::cout << std::fixed << std::setprecision(2);
+
+        MissionRegistry registry;
+        registry.setVerbose(false);
+        const bool packed = path.size() > 5 && path.compare(path.size() - 5, 5, ".pack") == 0;
+        if (!(packed ? registry.loadPack(path) : registry.loadFromFile(path)))
+        {
+            std::cout << "✗ No se pudo cargar " << path << std::endl;
+            return 1;
+        }
+
+        // Copias propias: en modo paquete las misiones se materializan en el hilo principal
+        std::vector<MissionDefinition> missions;
+        missions.reserve(registry.getMissionCount());
+        for (size_t i = 0; i < registry.getMissionCount(); ++i)
+        {
+            if (const MissionDefinition *mission = registry.getMissionByIndex(i))
+                missions.push_back(*mission);
+        }
+
+        const unsigned threads = pool ? (options.maxThreads ? options.maxThreads : pool->workerCount() + 1) : 1;
+        std::cout << "Validando " << missions.size() << " misiones de " << path << " con " << threads
+                  << " hilos (alabeo máx. " << options.maxBank << "°, límite " << options.maxLoadFactor << " G)"
+                  << std::endl;
+
+        const Clock::time_point start = Clock::now();
+        std::vector<MissionValidation> results = validateMissions(missions, options, pool);
+        const double wallMs = elapsedMs(start);
+
+        size_t failed = 0;
+        double flightMs = 0.0;
+        double simulated = 0.0;
+        for (const MissionValidation &result : results)
+        {
+            const bool passed = result.passed();
+            failed += passed ? 0 : 1;
+            flightMs += result.wallMs;
+            simulated += result.completionTime;
+
+            std::cout << (passed ? "  ✓ " : "  ✗ ") << std::left << std::setw(24) << result.missionId << std::right
+                      << std::setw(9) << result.completionTime << " s  " << result.captured << "/" << result.waypoints
+                      << " WP  " << std::setw(8) << result.distance / 1000.0f << " km  vmin " << result.minAirspeed
+                      << " kt  nmax " << result.maxLoadFactor << " G  AoA " << result.maxAngleOfAttack << "°  ("
+                      << result.wallMs << " ms)" << std::endl;
+            for (const ValidationFinding &finding : result.findings)
+            {
+                std::cout << "      " << (finding.issue == ValidationIssue::UnreachableTurn ? "! " : "✗ ")
+                          << issueName(finding.issue) << " hacia WP" << finding.waypoint + 1 << " en t=" << finding.time
+                          << " s";
+                switch (finding.issue)
+                {
+                case ValidationIssue::UnreachableTurn:
+                    std::cout << ": dentro del radio de giro (" << finding.peak << " m), " << finding.duration
+                              << " s alejándose";
+                    break;
+                case ValidationIssue::Stall:
+                    std::cout << ": " << finding.duration << " s, AoA máx. " << finding.peak << "°";
+                    break;
+                case ValidationIssue::OverG:
+                case ValidationIssue::Spin:
+                    std::cout << ": " << finding.duration << " s, pico " << finding.peak << " G";
+                    break;
+                case ValidationIssue::MissedWaypoint:
+                    break;
+                }
+                std::cout << std::endl;
+            }
+        }
+
+        std::cout << "Vuelo simulado: " << simulated / 60.0 << " min en " << wallMs << " ms de pared ("
+                  << (wallMs > 0.0 ? simulated * 1000.0 / wallMs : 0.0) << "x tiempo real); suma por misión "
+                  << flightMs << " ms (" << (wallMs > 0.0 ? flightMs / wallMs : 0.0) << "x en paralelo)" << std::endl;
+        std::cout << (failed == 0 ? "✓ Catálogo de misiones factible"
+                                  : "✗ " + std::to_string(failed) + " misiones con fallas")
+                  << std::endl;
+        return failed == 0 ? 0 : 1;
+    }
+
+} // namespace mission
@@ -0,0 +1,110 @@
+/**
+ * @file MissionValidator.h
+ * @brief Validación de factibilidad de misiones volándolas sin ventana
+ *
+ * Cada misión se vuela con el FDM real (`flight::FdmSimulation`) y el piloto
+ * automático de `flight::Autopilot` siguiendo los waypoints, a paso fijo y
+ * sin render. Las misiones del catálogo se reparten entre los hilos de
+ * `core::JobPool`: cada vuelo es independiente y no comparte estado.
+ */
+
+#pragma once
+
+#include "MissionDefinition.h"
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace core
+{
+    class JobPool;
+}
+
+namespace mission
+{
+
+    /**
+     * @brief Parámetros del vuelo de validación
+     */
+    struct MissionValidationOptions
+    {
+        float frameRate = 60.0f;          ///< Pasos por segundo del piloto automático
+        float maxBank = 45.0f;            ///< ° de alabeo del piloto automático (define el radio de giro)
+        float airspeed = 0.0f;            ///< kt; 0 = `recommendedSpeed` de cada misión
+        float maxLoadFactor = 6.0f;       ///< G; por encima es exceso de G
+        float stallAngleOfAttack = 15.0f; ///< °; el modelo es lineal y no entra en pérdida solo
+        float legTimeFactor = 3.0f;       ///< Plazo por tramo: este factor × tiempo en línea recta...
+        float legTimeMargin = 120.0f;     ///< ...más este margen (s)
+        unsigned maxThreads = 0;          ///< Hilos del pool incluido el que llama (0 = todos)
+    };
+
+    /**
+     * @brief Tipo de hallazgo
+     */
+    enum class ValidationIssue
+    {
+        UnreachableTurn, ///< El waypoint cayó dentro del círculo de giro: hubo que alejarse y volver
+        Stall,           ///< Ángulo de ataque o velocidad fuera de la envolvente
+        OverG,           ///< Factor de carga por encima del límite
+        Spin,            ///< Barrena detectada por el FDM
+        MissedWaypoint   ///< Plazo del tramo vencido sin capturar
+    };
+
+    /**
+     * @brief Condición detectada durante un tramo (los frames del mismo tramo se agrupan)
+     */
+    struct ValidationFinding
+    {
+        ValidationIssue issue = ValidationIssue::Stall;
+        int waypoint = -1;     ///< Waypoint al que se volaba
+        float time = 0.0f;     ///< s de misión en que apareció por primera vez
+        float duration = 0.0f; ///< s acumulados en la condición
+        float peak = 0.0f;     ///< G, ° de AoA o m de radio de giro según el tipo
+    };
+
+    /**
+     * @brief Resultado de una misión
+     */
+    struct MissionValidation
+    {
+        std::string missionId;
+        bool completed = false;        ///< Todos los waypoints capturados
+        float completionTime = 0.0f;   ///< s de vuelo simulado (hasta el fallo si no completó)
+        size_t captured = 0;
+        size_t waypoints = 0;
+        float distance = 0.0f;         ///< m recorridos
+        float minAirspeed = 0.0f;      ///< kt
+        float maxLoadFactor = 0.0f;    ///< G
+        float maxAngleOfAttack = 0.0f; ///< °
+        std::vector<ValidationFinding> findings;
+        double wallMs = 0.0; ///< Tiempo real del vuelo
+
+        /// Completó sin pérdida, exceso de G ni barrena (los giros inalcanzables solo advierten)
+        bool passed() const;
+    };
+
+    /**
+     * @brief Volar una misión con el piloto automático
+     */
+    MissionValidation validateMission(const MissionDefinition &mission, const MissionValidationOptions &options);
+
+    /**
+     * @brief Volar todas las misiones, repartidas entre los hilos del pool
+     * @param pool nullptr vuela en el hilo que llama
+     */
+    std::vector<MissionValidation> validateMissions(const std::vector<MissionDefinition> &missions,
+                                                    const MissionValidationOptions &options, core::JobPool *pool);
+
+    /// Nombre corto del tipo de hallazgo (para reportes)
+    const char *issueName(ValidationIssue issue);
+
+    /**
+     * @brief Validar un catálogo y reportarlo por consola
+     * @param path `missions.json` o `missions.pack`
+     * @return 0 si todas las misiones pasan, 1 si alguna falla o no se pudo cargar
+     *
+     * Sin ventana: `FlightSim --validate-missions [catálogo]`.
+     */
+    int runMissionValidation(const std::string &path, const MissionValidationOptions &options, core::JobPool *pool);
+
+} // namespace mission
@@ -0,0 +1,209 @@
+/**
+ * @file RecorderBenchmark.cpp
+ * @brief Implementación del benchmark del grabador de vuelo
+ */
+
+#include "RecorderBenchmark.h"
+#include "FlightRecorder.h"
+#include "../flight/data/FlightData.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <vector>
+
+namespace mission
+{
+
+    namespace
+    {
+        using Clock = std::chrono::steady_clock;
+
+        /// Vuelo sintético: circuito con altitud, velocidad y potencia variables, G con ruido
+        flight::FlightData sampleFlight(float t, std::mt19937 &rng)
+        {
+            std::normal_distribution<float> noise(0.0f, 0.05f);
+            const float angle = t * 0.02f;
+            const float altitudeMeters = 1500.0f + 600.0f * std::sin(t * 0.01f);
+
+            flight::FlightData data;
+            data.position = glm::vec3(12000.0f * std::cos(angle), altitudeMeters, 8000.0f * std::sin(angle * 1.3f));
+            data.altitude = altitudeMeters * 3.28084f;
+            data.airspeed = 260.0f + 40.0f * std::sin(t * 0.05f);
+            data.verticalSpeed = 6.0f * std::cos(t * 0.01f) * 3.28084f * 60.0f;
+            data.heading = std::fmod(t * 1.2f, 360.0f);
+            data.pitch = 5.0f * std::cos(t * 0.01f);
+            data.roll = 25.0f * std::sin(t * 0.03f);
+            data.gForce = 1.2f + 0.3f * std::sin(t * 0.2f) + noise(rng);
+            data.throttle = 0.6f + 0.3f * std::sin(t * 0.004f);
+            return data;
+        }
+    } // namespace
+
+    int runRecorderBenchmark(const RecorderBenchmarkOptions &options)
+    {
+        std::cout << std::fixed << std::setprecision(2);
+        const float dt = 1.0f / std::max(options.frameRate, 1.0f);
+        const size_t frames = static_cast<size_t>(std::max(options.hours, 0.0f) * 3600.0f / dt);
+        if (frames == 0)
+        {
+            std::cout << "✗ Sin frames" << std::endl;
+            return 1;
+        }
+
+        // Datos generados antes de medir: solo se cronometra `record`
+        std::mt19937 rng(options.seed);
+        std::vector<flight::FlightData> flight(frames);
+        for (size_t i = 0; i < frames; ++i)
+        {
+            flight[i] = sampleFlight(static_cast<float>(i) * dt, rng);
+        }
+        const size_t legEvery = frames / static_cast<size_t>(std::max(options.legs, 1)) + 1;
+
+        FlightRecorder recorder;
+        recorder.start(1.0f);
+        Clock::time_point start = Clock::now();
+        for (size_t i = 0; i < frames; ++i)
+        {
+            recorder.record(flight[i], dt);
+            if (i > 0 && i % legEvery == 0)
+            {
+                recorder.endLeg(static_cast<int>(i / legEvery) - 1);
+            }
+        }
+        recorder.finish();
+        const double totalNs = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+
+        // Frames que tomaron muestra (segunda pasada, fuera de la medición)
+        std::vector<size_t> sampledFrames;
+        {
+            FlightRecorder replay;
+            replay.start(1.0f);
+            for (size_t i = 0; i < frames; ++i)
+            {
+                replay.record(flight[i], dt);
+                if (replay.sampleCount() > sampledFrames.size())
+                {
+                    sampledFrames.push_back(i);
+                }
+            }
+        }
+
+        const double hours = static_cast<double>(frames) * dt / 3600.0;
+        const size_t rawBytes = recorder.sampleCount() * FLIGHT_CHANNEL_COUNT * sizeof(float);
+        std::cout << "Grabador de vuelo: " << hours << " h a " << options.frameRate << " Hz, "
+                  << FLIGHT_CHANNEL_COUNT << " canales a 1 Hz" << std::endl;
+        std::cout << "  costo por frame         " << std::setw(10) << totalNs / frames << " ns" << std::endl;
+        std::cout << "  muestras                " << std::setw(10) << recorder.sampleCount() << std::endl;
+        std::cout << "  bytes por hora          " << std::setw(10) << recorder.encodedBytes() / hours
+                  << "  (float crudo: " << rawBytes / hours << ", "
+                  << (recorder.encodedBytes() > 0 ? static_cast<double>(rawBytes) / recorder.encodedBytes() : 0.0)
+                  << "x)" << std::endl;
+        std::cout << "  bytes por muestra       " << std::setw(10)
+                  << static_cast<double>(recorder.encodedBytes()) / std::max<size_t>(recorder.sampleCount(), 1) << std::endl;
+
+        bool ok = true;
+
+        // Ida y vuelta por archivo: error máximo por canal frente a la entrada muestreada
+        std::filesystem::path path = std::filesystem::temp_directory_path() / "flightsim_recorder_bench.fsrec";
+        FlightTrace trace;
+        if (!recorder.save(path.string()) || !FlightRecorder::load(path.string(), trace) ||
+            trace.sampleCount != sampledFrames.size() || trace.legs.size() != recorder.legs().size())
+        {
+            std::cout << "  ✗ no se pudo guardar/leer la traza" << std::endl;
+            ok = false;
+        }
+        else
+        {
+            static const float TOLERANCE[FLIGHT_CHANNEL_COUNT] = {
+                0.0006f, 0.06f, 0.06f, 0.06f, 0.6f, 0.06f, 6.0f, 0.06f, 0.06f, 0.06f, 0.006f, 0.0006f};
+            float worst[FLIGHT_CHANNEL_COUNT] = {};
+            for (size_t s = 0; s < trace.sampleCount; ++s)
+            {
+                const size_t frame = sampledFrames[s];
+                const flight::FlightData &d = flight[frame];
+                const float expected[FLIGHT_CHANNEL_COUNT] = {
+                    static_cast<float>(static_cast<double>(frame) * dt), d.position.x, d.position.y, d.position.z, d.altitude,
+                    d.airspeed, d.verticalSpeed, d.heading, d.pitch, d.roll, d.gForce, d.throttle};
+                for (size_t c = 0; c < FLIGHT_CHANNEL_COUNT; ++c)
+                {
+                    float error = std::fabs(trace.values[s * FLIGHT_CHANNEL_COUNT + c] - expected[c]);
+                    if (c == static_cast<size_t>(FlightChannel::Heading))
+                    {
+                        error = std::min(error, 360.0f - error);
+                    }
+                    worst[c] = std::max(worst[c], error);
+                }
+            }
+            for (size_t c = 0; c < FLIGHT_CHANNEL_COUNT; ++c)
+            {
+                if (worst[c] > TOLERANCE[c])
+                {
+                    std::cout << "  ✗ canal " << c << ": error " << worst[c] << " > " << TOLERANCE[c] << std::endl;
+                    ok = false;
+                }
+            }
+        }
+        // Cabecera dañada: un `sampleCount` imposible se rechaza sin reservar memoria para él
+        if (ok)
+        {
+            std::vector<char> bytes;
+            {
+                std::ifstream in(path, std::ios::binary);
+                bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+            }
+            RecordingHeader header;
+            std::memcpy(&header, bytes.data(), sizeof(header));
+            header.sampleCount = UINT32_MAX;
+            std::memcpy(bytes.data(), &header, sizeof(header));
+            {
+                std::ofstream out(path, std::ios::binary | std::ios::trunc);
+                out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+            }
+            FlightTrace corrupt;
+            if (FlightRecorder::load(path.string(), corrupt))
+            {
+                std::cout << "  ✗ se aceptó una traza con sampleCount dañado" << std::endl;
+                ok = false;
+            }
+        }
+        std::error_code error;
+        std::filesystem::remove(path, error);
+
+        // Agregados en streaming contra el cálculo directo
+        double speedSum = 0.0;
+        float maxG = flight[0].gForce;
+        for (const flight::FlightData &d : flight)
+        {
+            speedSum += d.airspeed;
+            maxG = std::max(maxG, d.gForce);
+        }
+        const float meanSpeed = static_cast<float>(speedSum / frames);
+        const ChannelStats &speed = recorder.channel(FlightChannel::Airspeed);
+        float legTime = 0.0f;
+        for (const LegStats &leg : recorder.legs())
+        {
+            legTime += leg.duration;
+        }
+        std::cout << "  velocidad media         " << std::setw(10) << speed.mean() << " kt (directa " << meanSpeed << ")"
+                  << std::endl;
+        std::cout << "  tramos                  " << std::setw(10) << recorder.legs().size() << " (" << legTime << " s)" << std::endl;
+        if (std::fabs(speed.mean() - meanSpeed) > 0.01f || recorder.channel(FlightChannel::GForce).max != maxG ||
+            std::fabs(legTime - recorder.elapsed()) > 0.01f * recorder.elapsed())
+        {
+            std::cout << "  ✗ agregados distintos del cálculo directo" << std::endl;
+            ok = false;
+        }
+
+        std::cout << (ok ? "✓ Grabador de vuelo OK" : "✗ Grabador de vuelo con fallas") << std::endl;
+        return ok ? 0 : 1;
+    }
+
+} // namespace mission
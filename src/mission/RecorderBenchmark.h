@@ -0,0 +1,33 @@
+/**
+ * @file RecorderBenchmark.h
+ * @brief Benchmark del grabador de vuelo (modo `--bench-recorder`)
+ */
+
+#pragma once
+
+#include <cstdint>
+
+namespace mission
+{
+
+    /**
+     * @brief Parámetros del benchmark del grabador
+     */
+    struct RecorderBenchmarkOptions
+    {
+        float hours = 1.0f;    ///< Tiempo de vuelo simulado
+        float frameRate = 60.0f;
+        int legs = 20;         ///< Capturas repartidas en el vuelo
+        uint32_t seed = 1337;  ///< Semilla del ruido de G
+    };
+
+    /**
+     * @brief Medir el costo por frame de `FlightRecorder` y los bytes por hora de vuelo
+     * @return 0 si la traza guardada se decodifica dentro del error de cuantización
+     *         y los agregados coinciden con el cálculo directo
+     *
+     * Sin ventana: `FlightSim --bench-recorder [horas]`.
+     */
+    int runRecorderBenchmark(const RecorderBenchmarkOptions &options);
+
+} // namespace mission
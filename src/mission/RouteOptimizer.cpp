@@ -0,0 +1,670 @@
+/**
+ * @file RouteOptimizer.cpp
+ * @brief Implementación del optimizador de rutas (vecino más cercano + 2-opt/Or-opt)
+ */
+
+#include "RouteOptimizer.h"
+#include "core/JobPool.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <deque>
+#include <initializer_list>
+#include <limits>
+#include <random>
+#include <utility>
+
+namespace mission
+{
+
+    namespace
+    {
+        using Clock = std::chrono::steady_clock;
+
+        constexpr uint32_t NONE = ~0u;
+        constexpr size_t NEIGHBOURS = 10; ///< Candidatos por nodo en la búsqueda local
+        constexpr double EPSILON = 1e-3;  ///< Mejora mínima (m) para aceptar un movimiento
+
+        /// Nodos 0..n-1 son los waypoints; el nodo n es la posición inicial
+        struct Problem
+        {
+            std::vector<glm::vec2> ground;
+            std::vector<float> altitude;
+            float altitudeWeight = 0.0f;
+            size_t k = 0;
+            std::vector<uint32_t> neighbours; ///< k por nodo, del más barato al más caro
+
+            size_t nodeCount() const { return ground.size(); }
+            uint32_t startNode() const { return static_cast<uint32_t>(ground.size() - 1); }
+            const uint32_t *neighboursOf(uint32_t node) const { return neighbours.data() + node * k; }
+
+            double cost(uint32_t a, uint32_t b) const
+            {
+                return glm::length(ground[a] - ground[b]) + altitudeWeight * std::abs(altitude[a] - altitude[b]);
+            }
+        };
+
+        void buildNeighbours(Problem &problem, core::JobPool *pool, unsigned maxThreads)
+        {
+            const size_t nodes = problem.nodeCount();
+            problem.k = std::min(NEIGHBOURS, nodes - 1);
+            problem.neighbours.assign(nodes * problem.k, 0);
+            if (problem.k == 0)
+            {
+                return;
+            }
+
+            // O(n²) por fuerza bruta: para los tamaños del planificador (≤ 5000) tarda milisegundos
+            const size_t chunk = 64;
+            auto buildChunk = [&](size_t c)
+            {
+                std::vector<std::pair<float, uint32_t>> candidates;
+                candidates.reserve(nodes);
+                for (size_t a = c * chunk; a < std::min(nodes, (c + 1) * chunk); ++a)
+                {
+                    candidates.clear();
+                    for (uint32_t b = 0; b < nodes; ++b)
+                    {
+                        if (b != a)
+                        {
+                            candidates.emplace_back(static_cast<float>(problem.cost(static_cast<uint32_t>(a), b)), b);
+                        }
+                    }
+                    std::partial_sort(candidates.begin(), candidates.begin() + problem.k, candidates.end());
+                    for (size_t t = 0; t < problem.k; ++t)
+                    {
+                        problem.neighbours[a * problem.k + t] = candidates[t].second;
+                    }
+                }
+            };
+
+            size_t chunks = (nodes + chunk - 1) / chunk;
+            if (pool)
+            {
+                pool->parallelFor(chunks, buildChunk, maxThreads);
+            }
+            else
+            {
+                for (size_t c = 0; c < chunks; ++c)
+                {
+                    buildChunk(c);
+                }
+            }
+        }
+
+        /// Vecino más cercano desde la posición inicial
+        std::vector<uint32_t> nearestNeighbourPath(const Problem &problem)
+        {
+            const size_t nodes = problem.nodeCount();
+            std::vector<uint8_t> used(nodes, 0);
+            std::vector<uint32_t> path;
+            path.reserve(nodes);
+
+            uint32_t current = problem.startNode();
+            used[current] = 1;
+            path.push_back(current);
+            while (path.size() < nodes)
+            {
+                // La lista está ordenada: el primer libre es el más cercano de todos
+                uint32_t next = NONE;
+                const uint32_t *candidates = problem.neighboursOf(current);
+                for (size_t t = 0; t < problem.k && next == NONE; ++t)
+                {
+                    if (!used[candidates[t]])
+                    {
+                        next = candidates[t];
+                    }
+                }
+                if (next == NONE)
+                {
+                    double best = std::numeric_limits<double>::max();
+                    for (uint32_t b = 0; b < nodes; ++b)
+                    {
+                        double cost = used[b] ? best : problem.cost(current, b);
+                        if (cost < best)
+                        {
+                            best = cost;
+                            next = b;
+                        }
+                    }
+                }
+                used[next] = 1;
+                path.push_back(next);
+                current = next;
+            }
+            return path;
+        }
+
+        /**
+         * @brief 2-opt + Or-opt sobre un recorrido abierto con el nodo inicial fijo en path[0]
+         *
+         * Solo se revisan los nodos de la cola ("don't look bits"): al principio
+         * todos, después de un movimiento o una perturbación solo los extremos
+         * de los arcos que cambiaron. Así la búsqueda local iterada no recorre
+         * la ruta entera tras cada perturbación.
+         */
+        class LocalSearch
+        {
+        public:
+            LocalSearch(const Problem &problem, const std::atomic<bool> *cancel)
+                : problem_(problem), cancel_(cancel), position_(problem.nodeCount()), queued_(problem.nodeCount(), 0)
+            {
+            }
+
+            /// Carga un recorrido y pone todos sus nodos en la cola
+            void setPath(const std::vector<uint32_t> &path)
+            {
+                path_ = path;
+                reindex(0, path_.size() - 1);
+                for (uint32_t node : path_)
+                {
+                    activate(node);
+                }
+            }
+
+            /// Vuelve a un óptimo local ya conocido: no hay nada que revisar
+            void restore(const std::vector<uint32_t> &path)
+            {
+                path_ = path;
+                reindex(0, path_.size() - 1);
+                for (uint32_t node : queue_)
+                {
+                    queued_[node] = 0;
+                }
+                queue_.clear();
+            }
+
+            const std::vector<uint32_t> &path() const { return path_; }
+
+            double cost() const
+            {
+                double total = 0.0;
+                for (size_t i = 0; i + 1 < path_.size(); ++i)
+                {
+                    total += problem_.cost(path_[i], path_[i + 1]);
+                }
+                return total;
+            }
+
+            bool cancelled() const { return cancel_ && cancel_->load(std::memory_order_relaxed); }
+
+            /// Hasta el óptimo local (o la cancelación)
+            double optimize()
+            {
+                size_t steps = 0;
+                while (!queue_.empty())
+                {
+                    if ((++steps & 255) == 0 && cancelled())
+                    {
+                        break;
+                    }
+                    uint32_t node = queue_.front();
+                    queue_.pop_front();
+                    queued_[node] = 0;
+                    while (twoOpt(node) || orOpt(node))
+                    {
+                    }
+                }
+                return cost();
+            }
+
+            /// Perturbación double-bridge (intercambia dos tramos consecutivos); en rutas cortas, dos waypoints
+            bool perturb(std::mt19937 &rng)
+            {
+                const size_t m = path_.size();
+                if (m < 3)
+                {
+                    return false;
+                }
+                std::uniform_int_distribution<size_t> cut(1, m - 1);
+                if (m < 9)
+                {
+                    size_t a = cut(rng), b = cut(rng);
+                    while (a == b)
+                    {
+                        b = cut(rng);
+                    }
+                    std::swap(path_[a], path_[b]);
+                    reindex(std::min(a, b), std::max(a, b));
+                    activateAround(a);
+                    activateAround(b);
+                    return true;
+                }
+
+                size_t cuts[3];
+                do
+                {
+                    cuts[0] = cut(rng);
+                    cuts[1] = cut(rng);
+                    cuts[2] = cut(rng);
+                    std::sort(cuts, cuts + 3);
+                } while (cuts[0] == cuts[1] || cuts[1] == cuts[2]);
+
+                std::rotate(path_.begin() + cuts[0], path_.begin() + cuts[1], path_.begin() + cuts[2]);
+                reindex(cuts[0], cuts[2] - 1);
+                activateAround(cuts[0]);
+                activateAround(cuts[0] + (cuts[2] - cuts[1]));
+                activateAround(cuts[2]);
+                return true;
+            }
+
+        private:
+            void activate(uint32_t node)
+            {
+                if (node != NONE && !queued_[node])
+                {
+                    queued_[node] = 1;
+                    queue_.push_back(node);
+                }
+            }
+
+            /// Los dos extremos del arco que entra en path[at]
+            void activateAround(size_t at)
+            {
+                activate(path_[at - 1]);
+                activate(nodeAt(at));
+            }
+
+            void activate(std::initializer_list<uint32_t> nodes)
+            {
+                for (uint32_t node : nodes)
+                {
+                    activate(node);
+                }
+            }
+
+            void reindex(size_t lo, size_t hi)
+            {
+                for (size_t i = lo; i <= hi; ++i)
+                {
+                    position_[path_[i]] = static_cast<uint32_t>(i);
+                }
+            }
+
+            void reverse(size_t lo, size_t hi)
+            {
+                std::reverse(path_.begin() + lo, path_.begin() + hi + 1);
+                reindex(lo, hi);
+            }
+
+            uint32_t nodeAt(size_t i) const { return i < path_.size() ? path_[i] : NONE; }
+
+            double cost(uint32_t a, uint32_t b) const
+            {
+                return a == NONE || b == NONE ? 0.0 : problem_.cost(a, b);
+            }
+
+            /// Mejor 2-opt que crea un arco entre `a` y uno de sus vecinos
+            bool twoOpt(uint32_t a)
+            {
+                const size_t i = position_[a];
+                const uint32_t *candidates = problem_.neighboursOf(a);
+
+                // Reemplazando el arco a → sucesor
+                if (i + 1 < path_.size())
+                {
+                    const uint32_t b = path_[i + 1];
+                    const double ab = problem_.cost(a, b);
+                    for (size_t t = 0; t < problem_.k; ++t)
+                    {
+                        const uint32_t c = candidates[t];
+                        const double ac = problem_.cost(a, c);
+                        if (ac >= ab)
+                        {
+                            break; // el nuevo arco ya no es más corto que el que reemplaza
+                        }
+                        const size_t j = position_[c];
+                        if (j > i + 1)
+                        {
+                            // a-b ... c-e  →  a-c ... b-e
+                            const uint32_t e = nodeAt(j + 1);
+                            if (ac + cost(b, e) - ab - cost(c, e) < -EPSILON)
+                            {
+                                reverse(i + 1, j);
+                                activate({a, b, c, e});
+                                return true;
+                            }
+                        }
+                        else if (j < i)
+                        {
+                            // c-f ... a-b  →  c-a ... f-b
+                            const uint32_t f = path_[j + 1];
+                            if (ac + problem_.cost(f, b) - problem_.cost(c, f) - ab < -EPSILON)
+                            {
+                                reverse(j + 1, i);
+                                activate({c, f, a, b});
+                                return true;
+                            }
+                        }
+                    }
+                }
+
+                // Reemplazando el arco predecesor → a (path[0] es fijo: nunca se invierte)
+                if (i >= 1)
+                {
+                    const uint32_t p = path_[i - 1];
+                    const double pa = problem_.cost(p, a);
+                    for (size_t t = 0; t < problem_.k; ++t)
+                    {
+                        const uint32_t c = candidates[t];
+                        const double ac = problem_.cost(a, c);
+                        if (ac >= pa)
+                        {
+                            break;
+                        }
+                        const size_t j = position_[c];
+                        if (j >= 1 && j + 1 < i)
+                        {
+                            // g-c ... p-a  →  g-p ... c-a
+                            const uint32_t g = path_[j - 1];
+                            if (ac + problem_.cost(g, p) - problem_.cost(g, c) - pa < -EPSILON)
+                            {
+                                reverse(j, i - 1);
+                                activate({g, c, p, a});
+                                return true;
+                            }
+                        }
+                        else if (j > i + 1)
+                        {
+                            // p-a ... g-c  →  p-g ... a-c
+                            const uint32_t g = path_[j - 1];
+                            if (ac + problem_.cost(p, g) - pa - problem_.cost(g, c) < -EPSILON)
+                            {
+                                reverse(i, j - 1);
+                                activate({p, g, a, c});
+                                return true;
+                            }
+                        }
+                    }
+                }
+                return false;
+            }
+
+            /// Or-opt: tramos de 1 a 3 waypoints que empiezan o terminan en `a`
+            bool orOpt(uint32_t a)
+            {
+                const size_t i = position_[a];
+                for (size_t length = 1; length <= 3; ++length)
+                {
+                    if (i >= 1 && i + length <= path_.size() && moveSegment(i, length))
+                    {
+                        return true;
+                    }
+                    if (length > 1 && i + 1 >= length && i + 1 - length >= 1 && moveSegment(i + 1 - length, length))
+                    {
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            /// Reubica path[i, i + length) junto a un vecino de sus extremos, si acorta la ruta
+            bool moveSegment(size_t i, size_t length)
+            {
+                const uint32_t previous = path_[i - 1];
+                const uint32_t first = path_[i];
+                const uint32_t last = path_[i + length - 1];
+                const uint32_t next = nodeAt(i + length);
+                const double removeGain = problem_.cost(previous, first) + cost(last, next) - cost(previous, next);
+                if (removeGain <= EPSILON)
+                {
+                    return false;
+                }
+
+                double bestDelta = -EPSILON;
+                uint32_t bestAfter = NONE;
+                uint32_t bestBefore = NONE;
+                bool bestReversed = false;
+                auto consider = [&](uint32_t x, uint32_t y)
+                {
+                    const double forward = problem_.cost(x, first) + cost(last, y);
+                    const double backward = problem_.cost(x, last) + cost(first, y);
+                    const double delta = std::min(forward, backward) - cost(x, y) - removeGain;
+                    if (delta < bestDelta)
+                    {
+                        bestDelta = delta;
+                        bestAfter = x;
+                        bestBefore = y;
+                        bestReversed = backward < forward;
+                    }
+                };
+
+                for (uint32_t end : {first, last})
+                {
+                    const uint32_t *candidates = problem_.neighboursOf(end);
+                    for (size_t t = 0; t < problem_.k; ++t)
+                    {
+                        const uint32_t c = candidates[t];
+                        const size_t j = position_[c];
+                        if (j >= i && j < i + length)
+                        {
+                            continue;
+                        }
+                        if (j + 1 != i) // entre c y su sucesor
+                        {
+                            consider(c, nodeAt(j + 1));
+                        }
+                        if (j >= 1 && j != i + length) // entre su predecesor y c
+                        {
+                            consider(path_[j - 1], c);
+                        }
+                    }
+                }
+                if (bestAfter == NONE)
+                {
+                    return false;
+                }
+
+                uint32_t segment[3];
+                std::copy(path_.begin() + i, path_.begin() + i + length, segment);
+                if (bestReversed)
+                {
+                    std::reverse(segment, segment + length);
+                }
+                size_t anchor = position_[bestAfter];
+                path_.erase(path_.begin() + i, path_.begin() + i + length);
+                if (anchor > i)
+                {
+                    anchor -= length;
+                }
+                path_.insert(path_.begin() + anchor + 1, segment, segment + length);
+                reindex(std::min(i, anchor + 1), std::max(i + length - 1, anchor + length));
+
+                activate({previous, next, first, last, bestAfter, bestBefore});
+                return true;
+            }
+
+            const Problem &problem_;
+            const std::atomic<bool> *cancel_;
+            std::vector<uint32_t> path_;
+            std::vector<uint32_t> position_; ///< Por nodo: índice en path_
+            std::vector<uint8_t> queued_;    ///< Por nodo: está en queue_
+            std::deque<uint32_t> queue_;     ///< Nodos a revisar
+        };
+    } // namespace
+
+    double routeCost(const glm::vec3 &start, const std::vector<glm::vec3> &waypoints,
+                     const std::vector<uint32_t> &order, float altitudeWeight)
+    {
+        double total = 0.0;
+        glm::vec3 previous = start;
+        for (uint32_t index : order)
+        {
+            const glm::vec3 &current = waypoints[index];
+            total += glm::length(glm::vec2(current.x - previous.x, current.z - previous.z)) +
+                     altitudeWeight * std::abs(current.y - previous.y);
+            previous = current;
+        }
+        return total;
+    }
+
+    RouteResult optimizeRoute(const glm::vec3 &start, const std::vector<glm::vec3> &waypoints,
+                              const RouteOptions &options, core::JobPool *pool,
+                              const std::atomic<bool> *cancel, std::atomic<int> *progress)
+    {
+        Clock::time_point begin = Clock::now();
+        const size_t count = waypoints.size();
+
+        RouteResult result;
+        result.order.resize(count);
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            result.order[i] = i;
+        }
+        result.initialCost = routeCost(start, waypoints, result.order, options.altitudeWeight);
+        result.seedCost = result.cost = result.initialCost;
+        if (count < 2)
+        {
+            return result;
+        }
+
+        Problem problem;
+        problem.altitudeWeight = std::max(0.0f, options.altitudeWeight);
+        problem.ground.reserve(count + 1);
+        problem.altitude.reserve(count + 1);
+        for (const glm::vec3 &waypoint : waypoints)
+        {
+            problem.ground.emplace_back(waypoint.x, waypoint.z);
+            problem.altitude.push_back(waypoint.y);
+        }
+        problem.ground.emplace_back(start.x, start.z);
+        problem.altitude.push_back(start.y);
+        buildNeighbours(problem, pool, options.maxThreads);
+
+        const std::vector<uint32_t> seed = nearestNeighbourPath(problem);
+        const int restarts = std::max(1, options.restarts);
+        std::vector<std::vector<uint32_t>> bestPaths(restarts);
+        std::vector<double> bestCosts(restarts, std::numeric_limits<double>::max());
+
+        // Cada reinicio es independiente: su propia copia del recorrido y su propio generador
+        auto runRestart = [&](size_t restart)
+        {
+            LocalSearch search(problem, cancel);
+            std::mt19937 rng(options.seed + static_cast<uint32_t>(restart) * 7919u);
+            search.setPath(seed);
+            for (int kick = 0; restart > 0 && kick < 3; ++kick)
+            {
+                search.perturb(rng);
+            }
+
+            double bestCost = search.optimize();
+            std::vector<uint32_t> bestPath = search.path();
+            for (int kick = 0; kick < options.kicksPerRestart && !search.cancelled(); ++kick)
+            {
+                if (!search.perturb(rng))
+                {
+                    break;
+                }
+                double cost = search.optimize();
+                if (cost < bestCost - EPSILON)
+                {
+                    bestCost = cost;
+                    bestPath = search.path();
+                }
+                else
+                {
+                    search.restore(bestPath);
+                }
+            }
+
+            bestCosts[restart] = bestCost;
+            bestPaths[restart] = std::move(bestPath);
+            if (progress)
+            {
+                progress->fetch_add(1, std::memory_order_relaxed);
+            }
+        };
+
+        if (pool)
+        {
+            pool->parallelFor(static_cast<size_t>(restarts), runRestart, options.maxThreads);
+        }
+        else
+        {
+            for (int restart = 0; restart < restarts; ++restart)
+            {
+                runRestart(static_cast<size_t>(restart));
+            }
+        }
+
+        // La ruta original se conserva si ninguna búsqueda la mejora
+        LocalSearch seedRoute(problem, nullptr);
+        seedRoute.setPath(seed);
+        result.seedCost = seedRoute.cost();
+        size_t winner = static_cast<size_t>(std::min_element(bestCosts.begin(), bestCosts.end()) - bestCosts.begin());
+        if (bestCosts[winner] < result.initialCost)
+        {
+            result.cost = bestCosts[winner];
+            result.order.assign(bestPaths[winner].begin() + 1, bestPaths[winner].end());
+        }
+        result.restartsCompleted = static_cast<int>(restarts);
+        result.cancelled = cancel && cancel->load();
+        result.elapsedMs = std::chrono::duration<double, std::milli>(Clock::now() - begin).count();
+        return result;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  Ejecución en segundo plano
+    ////////////////////////////////////////////////////////////////////////////
+
+    RouteOptimizer::~RouteOptimizer()
+    {
+        cancel();
+        join();
+    }
+
+    void RouteOptimizer::join()
+    {
+        if (worker_.joinable())
+        {
+            worker_.join();
+        }
+    }
+
+    bool RouteOptimizer::start(const glm::vec3 &start, std::vector<glm::vec3> waypoints, const RouteOptions &options)
+    {
+        if (running_)
+        {
+            return false;
+        }
+        join();
+
+        options_ = options;
+        cancel_ = false;
+        progress_ = 0;
+        {
+            std::lock_guard<std::mutex> lock(resultMutex_);
+            hasResult_ = false;
+        }
+
+        running_ = true;
+        worker_ = std::thread(
+            [this, start, waypoints = std::move(waypoints)]()
+            {
+                RouteResult result = optimizeRoute(start, waypoints, options_, pool_, &cancel_, &progress_);
+                {
+                    std::lock_guard<std::mutex> lock(resultMutex_);
+                    result_ = std::move(result);
+                    hasResult_ = true;
+                }
+                running_ = false;
+            });
+        return true;
+    }
+
+    bool RouteOptimizer::poll(RouteResult &out)
+    {
+        {
+            std::lock_guard<std::mutex> lock(resultMutex_);
+            if (!hasResult_)
+            {
+                return false;
+            }
+            out = std::move(result_);
+            hasResult_ = false;
+        }
+        join();
+        return true;
+    }
+
+} // namespace mission
@@ -0,0 +1,127 @@
+/**
+ * @file RouteOptimizer.h
+ * @brief Reordenamiento de waypoints en una ruta corta (planificador)
+ *
+ * Heurística clásica para el recorrido abierto que sale de la posición
+ * inicial: semilla por vecino más cercano y búsqueda local 2-opt + Or-opt
+ * sobre listas de vecinos, con varios reinicios (perturbación double-bridge)
+ * repartidos entre los hilos de `core::JobPool`.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <glm/glm.hpp>
+
+namespace core
+{
+    class JobPool;
+}
+
+namespace mission
+{
+
+    /**
+     * @brief Parámetros de la optimización
+     */
+    struct RouteOptions
+    {
+        int restarts = 8;            ///< Búsquedas independientes (la 0 parte del vecino más cercano sin perturbar)
+        int kicksPerRestart = 100;   ///< Perturbaciones double-bridge por reinicio (búsqueda local iterada)
+        float altitudeWeight = 0.0f; ///< Costo extra por metro de cambio de altitud (0 = solo distancia XZ)
+        unsigned maxThreads = 0;     ///< Hilos del pool incluido el que llama (0 = todos)
+        uint32_t seed = 1;           ///< Semilla de las perturbaciones (resultados reproducibles)
+    };
+
+    /**
+     * @brief Resultado de una optimización
+     */
+    struct RouteResult
+    {
+        std::vector<uint32_t> order; ///< Índices de los waypoints originales en el nuevo orden
+        double initialCost = 0.0;    ///< Ruta tal como estaba
+        double seedCost = 0.0;       ///< Vecino más cercano
+        double cost = 0.0;           ///< Mejor ruta encontrada
+        double elapsedMs = 0.0;      ///< Tiempo hasta la solución
+        int restartsCompleted = 0;
+        bool cancelled = false;
+    };
+
+    /**
+     * @brief Costo de recorrer `waypoints` en `order` partiendo de `start`
+     *
+     * Distancia horizontal (XZ, como `MissionPlanner::computeMissionLength`)
+     * más `altitudeWeight` por metro de cambio de altitud.
+     */
+    double routeCost(const glm::vec3 &start, const std::vector<glm::vec3> &waypoints,
+                     const std::vector<uint32_t> &order, float altitudeWeight);
+
+    /**
+     * @brief Optimiza la ruta de forma síncrona
+     * @param pool Pool para repartir los reinicios (nullptr = en este hilo)
+     * @param cancel Si se activa, devuelve la mejor ruta hasta el momento
+     * @param progress Se incrementa al terminar cada reinicio
+     *
+     * La ruta es abierta: empieza en `start`, que no se mueve, y no regresa.
+     */
+    RouteResult optimizeRoute(const glm::vec3 &start, const std::vector<glm::vec3> &waypoints,
+                              const RouteOptions &options, core::JobPool *pool,
+                              const std::atomic<bool> *cancel = nullptr, std::atomic<int> *progress = nullptr);
+
+    /**
+     * @brief Ejecuta `optimizeRoute` en segundo plano
+     *
+     * El planificador lanza la optimización y consulta `poll()` cada frame;
+     * la interfaz no se bloquea mientras tanto.
+     */
+    class RouteOptimizer
+    {
+    public:
+        explicit RouteOptimizer(core::JobPool *pool = nullptr) : pool_(pool) {}
+        ~RouteOptimizer();
+
+        RouteOptimizer(const RouteOptimizer &) = delete;
+        RouteOptimizer &operator=(const RouteOptimizer &) = delete;
+
+        void setJobPool(core::JobPool *pool) { pool_ = pool; }
+
+        /**
+         * @brief Lanza una optimización; espera a que termine una anterior ya cancelada
+         * @return false si hay otra en curso
+         */
+        bool start(const glm::vec3 &start, std::vector<glm::vec3> waypoints, const RouteOptions &options);
+
+        /**
+         * @brief Pide detener la optimización en curso (no bloquea)
+         */
+        void cancel() { cancel_ = true; }
+
+        bool isRunning() const { return running_; }
+        int restartsCompleted() const { return progress_; }
+        int restartsRequested() const { return options_.restarts; }
+
+        /**
+         * @brief Entrega el resultado una sola vez, cuando está listo
+         */
+        bool poll(RouteResult &out);
+
+    private:
+        void join();
+
+        core::JobPool *pool_ = nullptr;
+        RouteOptions options_;
+        std::thread worker_;
+        std::atomic<bool> running_{false};
+        std::atomic<bool> cancel_{false};
+        std::atomic<int> progress_{0};
+
+        std::mutex resultMutex_;
+        RouteResult result_; ///< Protegido por resultMutex_
+        bool hasResult_ = false;
+    };
+
+} // namespace mission
@@ -0,0 +1,275 @@
+/**
+ * @file TriggerBenchmark.cpp
+ * @brief Implementación del benchmark del motor de disparadores
+ */
+
+#include "TriggerBenchmark.h"
+#include "TriggerEngine.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace mission
+{
+
+    namespace
+    {
+        using Clock = std::chrono::steady_clock;
+
+        constexpr float FRAME_DT = 1.0f / 60.0f;
+        constexpr float PATH_RADIUS = 4000.0f;     ///< m: una vuelta ≈ 25 km
+        constexpr float PATH_SPEED = 250.0f;       ///< m/s
+        constexpr float METERS_TO_FEET = 3.28084f;
+
+        double elapsedMs(Clock::time_point start)
+        {
+            return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        }
+
+        /// Vuelo sintético: círculo con altitud, velocidad y actitud oscilantes
+        TriggerInputs sampleFlight(int frame)
+        {
+            const float t = static_cast<float>(frame) * FRAME_DT;
+            const float angle = t * PATH_SPEED / PATH_RADIUS;
+            const float altitudeMeters = 900.0f + 450.0f * std::sin(t * 0.3f);
+
+            TriggerInputs in;
+            in.position = glm::vec3(PATH_RADIUS * std::cos(angle), altitudeMeters, PATH_RADIUS * std::sin(angle));
+            in[TriggerField::Altitude] = altitudeMeters * METERS_TO_FEET;
+            in[TriggerField::Airspeed] = 420.0f + 80.0f * std::sin(t * 0.7f);
+            in[TriggerField::VerticalSpeed] = 450.0f * 0.3f * std::cos(t * 0.3f) * METERS_TO_FEET * 60.0f;
+            in[TriggerField::Heading] = std::fmod(angle * 57.2958f + 180.0f, 360.0f);
+            in[TriggerField::Pitch] = 8.0f * std::cos(t * 0.3f);
+            in[TriggerField::Roll] = 30.0f + 10.0f * std::sin(t * 0.5f);
+            in[TriggerField::GForce] = 1.15f + 0.4f * std::sin(t * 1.1f);
+            in[TriggerField::Time] = t;
+            in[TriggerField::Captured] = std::floor(t / 10.0f);
+            return in;
+        }
+
+        /// Mezcla de condiciones de misiones reales, en proporción fija por cada 20
+        MissionDefinition buildMission(const TriggerBenchmarkOptions &options)
+        {
+            std::mt19937 rng(options.seed);
+            std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+            MissionDefinition mission;
+            mission.id = "bench_triggers";
+            const size_t zoneCount = std::max<size_t>(1, options.zones ? options.zones : options.triggers / 2);
+            mission.zones.reserve(zoneCount);
+            for (size_t i = 0; i < zoneCount; ++i)
+            {
+                // Centros a ±2 km de la trayectoria: una parte se cruza, el resto no
+                const float angle = unit(rng) * 6.2831853f;
+                const float distance = PATH_RADIUS + (unit(rng) - 0.5f) * 4000.0f;
+                ZoneDef zone;
+                zone.id = "z" + std::to_string(i);
+                zone.center = glm::vec3(distance * std::cos(angle), 0.0f, distance * std::sin(angle));
+                zone.radius = 200.0f + 600.0f * unit(rng);
+                if (i % 3 == 0)
+                {
+                    zone.minAltitude = 600.0f + 400.0f * unit(rng);
+                    zone.maxAltitude = zone.minAltitude + 500.0f;
+                }
+                mission.zones.push_back(std::move(zone));
+            }
+
+            auto zoneId = [&]()
+            {
+                return "z" + std::to_string(static_cast<size_t>(unit(rng) * zoneCount) % zoneCount);
+            };
+            auto number = [](float value)
+            {
+                return std::to_string(static_cast<int>(value));
+            };
+
+            mission.triggers.reserve(options.triggers);
+            size_t lastGate = SIZE_MAX;
+            for (size_t i = 0; i < options.triggers; ++i)
+            {
+                TriggerDef trigger;
+                trigger.id = "t" + std::to_string(i);
+                const size_t kind = i % 20;
+                if (kind < 6 || lastGate == SIZE_MAX)
+                {
+                    // Compuerta de altitud dentro de una zona
+                    trigger.condition = "in(" + zoneId() + ") && altitude < " + number(2500.0f + 2500.0f * unit(rng));
+                    trigger.action = TriggerAction::Objective;
+                    lastGate = i;
+                }
+                else if (kind < 10)
+                {
+                    // Ventana de velocidad sostenida
+                    const float low = 360.0f + 100.0f * unit(rng);
+                    trigger.condition = "airspeed >= " + number(low) + " && airspeed <= " + number(low + 30.0f);
+                    trigger.hold = 1.0f + 2.0f * unit(rng);
+                    trigger.repeat = kind % 2 == 0;
+                    trigger.action = TriggerAction::Message;
+                }
+                else if (kind < 13)
+                {
+                    // Tramo cronometrado: desde la compuerta anterior hasta otra zona
+                    trigger.condition = "in(" + zoneId() + ")";
+                    trigger.after = "t" + std::to_string(lastGate);
+                    trigger.within = 20.0f + 40.0f * unit(rng);
+                    trigger.action = TriggerAction::Objective;
+                }
+                else if (kind < 16)
+                {
+                    // Salida de zona tras la compuerta
+                    trigger.condition = "fired(t" + std::to_string(lastGate) + ") && !in(" + zoneId() + ")";
+                    trigger.action = TriggerAction::Penalty;
+                }
+                else if (kind < 19)
+                {
+                    trigger.condition = "time >= " + number(100.0f * unit(rng)) + " && captured >= " +
+                                        number(10.0f * unit(rng)) + " && (roll > 35 || gForce > 1.4)";
+                    trigger.action = TriggerAction::Message;
+                }
+                else
+                {
+                    // Aritmética: altitud prevista en 5 s (depende de cualquier cambio)
+                    trigger.condition = "altitude + verticalSpeed / 60 * 5 < " + number(2000.0f + 3000.0f * unit(rng));
+                    trigger.action = TriggerAction::Penalty;
+                }
+                mission.triggers.push_back(std::move(trigger));
+            }
+            return mission;
+        }
+
+        struct RunResult
+        {
+            double loadMs = 0.0;
+            double totalMs = 0.0;
+            size_t evaluations = 0;
+            size_t zoneCandidates = 0;
+            size_t fired = 0;
+            size_t expired = 0;
+            std::vector<std::vector<TriggerEvent>> events; ///< Por frame, ordenados
+        };
+
+        RunResult run(const MissionDefinition &mission, const TriggerBenchmarkOptions &options, bool bruteForce)
+        {
+            RunResult result;
+            Clock::time_point start = Clock::now();
+            TriggerEngine engine;
+            engine.load(mission);
+            engine.setBruteForce(bruteForce);
+            result.loadMs = elapsedMs(start);
+
+            std::vector<TriggerInputs> inputs(options.frames);
+            for (int frame = 0; frame < options.frames; ++frame)
+            {
+                inputs[frame] = sampleFlight(frame);
+            }
+
+            result.events.resize(options.frames);
+            std::vector<TriggerEvent> events;
+            for (int frame = 0; frame < options.frames; ++frame)
+            {
+                start = Clock::now();
+                engine.update(inputs[frame], events);
+                result.totalMs += elapsedMs(start);
+
+                result.evaluations += engine.stats().evaluations;
+                result.zoneCandidates += engine.stats().zoneCandidates;
+                for (const TriggerEvent &event : events)
+                {
+                    (event.type == TriggerEvent::Type::Fired ? result.fired : result.expired)++;
+                }
+                std::vector<TriggerEvent> &sorted = result.events[frame];
+                sorted = events;
+                std::sort(sorted.begin(), sorted.end(),
+                          [](const TriggerEvent &a, const TriggerEvent &b)
+                          {
+                              return a.trigger != b.trigger ? a.trigger < b.trigger : a.type < b.type;
+                          });
+            }
+            return result;
+        }
+    } // namespace
+
+    int runTriggerBenchmark(const TriggerBenchmarkOptions &options)
+    {
+        std::cout << std::fixed << std::setprecision(2);
+        if (options.triggers == 0 || options.frames <= 0)
+        {
+            std::cout << "✗ Sin disparadores ni frames" << std::endl;
+            return 1;
+        }
+
+        MissionDefinition mission = buildMission(options);
+        std::cout << "Disparadores: " << mission.triggers.size() << ", zonas: " << mission.zones.size()
+                  << ", frames: " << options.frames << std::endl;
+
+        RunResult events = run(mission, options, false);
+        RunResult brute = run(mission, options, true);
+
+        const double frames = static_cast<double>(options.frames);
+        std::cout << "                              por eventos    fuerza bruta" << std::endl;
+        std::cout << "  compilación (ms)      " << std::setw(16) << events.loadMs << std::setw(16) << brute.loadMs << std::endl;
+        std::cout << "  µs/frame              " << std::setw(16) << events.totalMs * 1000.0 / frames << std::setw(16)
+                  << brute.totalMs * 1000.0 / frames << "  (" << (events.totalMs > 0.0 ? brute.totalMs / events.totalMs : 0.0)
+                  << "x)" << std::endl;
+        std::cout << "  evaluaciones/frame    " << std::setw(16) << events.evaluations / frames << std::setw(16)
+                  << brute.evaluations / frames << std::endl;
+        std::cout << "  zonas probadas/frame  " << std::setw(16) << events.zoneCandidates / frames << std::setw(16)
+                  << brute.zoneCandidates / frames << std::endl;
+        std::cout << "  eventos: " << events.fired << " disparos, " << events.expired << " vencidos" << std::endl;
+
+        bool ok = events.fired == brute.fired && events.expired == brute.expired;
+        for (int frame = 0; ok && frame < options.frames; ++frame)
+        {
+            const std::vector<TriggerEvent> &a = events.events[frame];
+            const std::vector<TriggerEvent> &b = brute.events[frame];
+            bool same = a.size() == b.size();
+            for (size_t i = 0; same && i < a.size(); ++i)
+            {
+                same = a[i].trigger == b[i].trigger && a[i].type == b[i].type;
+            }
+            if (!same)
+            {
+                std::cout << "  ✗ frame " << frame << ": " << a.size() << " eventos vs " << b.size() << std::endl;
+                ok = false;
+            }
+        }
+
+        // Anidamiento patológico: se rechaza en la compilación en lugar de agotar la pila del parser
+        {
+            MissionDefinition deep;
+            deep.id = "bench_nesting";
+            for (const char *prefix : {"(", "!", "-"})
+            {
+                TriggerDef trigger;
+                trigger.id = std::string("deep") + prefix;
+                for (int i = 0; i < 100000; ++i)
+                {
+                    trigger.condition += prefix;
+                }
+                trigger.condition += "1";
+                deep.triggers.push_back(std::move(trigger));
+            }
+            TriggerDef nested;
+            nested.id = "nested";
+            nested.condition = std::string(40, '(') + "altitude > 1" + std::string(40, ')');
+            deep.triggers.push_back(std::move(nested));
+
+            TriggerEngine engine;
+            const size_t rejected = engine.load(deep);
+            if (rejected != 3)
+            {
+                std::cout << "  ✗ anidamiento: " << rejected << " condiciones rechazadas (se esperaban 3)" << std::endl;
+                ok = false;
+            }
+        }
+
+        std::cout << (ok ? "✓ Motor de disparadores OK" : "✗ Motor de disparadores con fallas") << std::endl;
+        return ok ? 0 : 1;
+    }
+
+} // namespace mission
@@ -0,0 +1,37 @@
+/**
+ * @file TriggerBenchmark.h
+ * @brief Benchmark del motor de disparadores (modo `--bench-triggers`)
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace mission
+{
+
+    /**
+     * @brief Parámetros del benchmark de disparadores
+     */
+    struct TriggerBenchmarkOptions
+    {
+        size_t triggers = 10000; ///< Disparadores activos
+        size_t zones = 0;        ///< Zonas (0 = la mitad de los disparadores)
+        int frames = 6000;       ///< Frames a 60 Hz (100 s de vuelo)
+        uint32_t seed = 1337;    ///< Semilla del generador
+    };
+
+    /**
+     * @brief Comparar `TriggerEngine` por eventos con la reevaluación completa por frame
+     * @return 0 si ambos modos producen los mismos eventos en cada frame y las condiciones
+     *         anidadas sin límite se rechazan al compilar, 1 en caso contrario
+     *
+     * Misión sintética con compuertas de altitud por zona, ventanas de
+     * velocidad sostenidas, tramos cronometrados, salidas de zona, condiciones
+     * de tiempo y aritméticas, sobre un vuelo circular con altitud y velocidad
+     * variables. Sin ventana: `FlightSim --bench-triggers [disparadores] [frames]`.
+     */
+    int runTriggerBenchmark(const TriggerBenchmarkOptions &options);
+
+} // namespace mission
@@ -0,0 +1,1022 @@
+/**
+ * @file TriggerEngine.cpp
+ * @brief Compilador de condiciones y evaluación por eventos de los disparadores
+ */
+
+#include "TriggerEngine.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace mission
+{
+
+    namespace
+    {
+        constexpr size_t MAX_STACK = 32;   ///< Profundidad máxima de la pila de evaluación
+        constexpr size_t MAX_NESTING = 64; ///< `(`, `!` y `-` anidados: cada uno es una llamada recursiva del parser
+
+        struct FieldName
+        {
+            const char *name;
+            TriggerField field;
+        };
+
+        constexpr FieldName FIELD_NAMES[] = {
+            {"altitude", TriggerField::Altitude},
+            {"airspeed", TriggerField::Airspeed},
+            {"verticalSpeed", TriggerField::VerticalSpeed},
+            {"heading", TriggerField::Heading},
+            {"pitch", TriggerField::Pitch},
+            {"roll", TriggerField::Roll},
+            {"gForce", TriggerField::GForce},
+            {"time", TriggerField::Time},
+            {"captured", TriggerField::Captured},
+        };
+
+        using NameIndex = std::unordered_map<std::string, uint32_t>;
+    } // namespace
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Compilador
+    ////////////////////////////////////////////////////////////////////////////
+
+    /**
+     * @brief Descenso recursivo que emite bytecode postfijo
+     *
+     * Precedencia, de menor a mayor: `||`, `&&`, comparaciones, `+ -`,
+     * `* /`, unarios (`!`, `-`). Anota de qué depende la condición para que
+     * `load` arme los índices.
+     */
+    class TriggerEngine::Compiler
+    {
+    public:
+        /// Lo que devuelve cada regla: si es un campo o una constante sueltos
+        struct Operand
+        {
+            enum class Kind
+            {
+                Field,
+                Const,
+                Other
+            } kind = Kind::Other;
+            uint32_t field = 0;
+            float value = 0.0f;
+            size_t depth = 1; ///< Pila que necesita
+        };
+
+        Compiler(std::string_view source, const NameIndex &zones, const NameIndex &triggers,
+                 std::vector<Instruction> &code, std::vector<float> &constants)
+            : source_(source), zones_(zones), triggers_(triggers), code_(code), constants_(constants)
+        {
+        }
+
+        bool compile(std::string &error)
+        {
+            Operand result = parseOr();
+            consume(result);
+            skipSpace();
+            if (error_.empty() && pos_ < source_.size())
+            {
+                fail("se esperaba un operador");
+            }
+            if (error_.empty() && result.depth > MAX_STACK)
+            {
+                fail("expresión demasiado compleja");
+            }
+            if (!error_.empty())
+            {
+                error = error_;
+                return false;
+            }
+            return true;
+        }
+
+        std::vector<Threshold> thresholds[TRIGGER_FIELD_COUNT]; ///< `trigger` sin completar
+        bool looseFields[TRIGGER_FIELD_COUNT] = {};
+        std::vector<uint32_t> zones;
+        std::vector<uint32_t> fired;
+
+    private:
+        // --- Léxico ---
+
+        void skipSpace()
+        {
+            while (pos_ < source_.size() && std::isspace(static_cast<unsigned char>(source_[pos_])))
+            {
+                ++pos_;
+            }
+        }
+
+        bool accept(std::string_view token)
+        {
+            skipSpace();
+            if (source_.substr(pos_, token.size()) == token)
+            {
+                pos_ += token.size();
+                return true;
+            }
+            return false;
+        }
+
+        /// Acepta `token` solo si no es el prefijo de otro operador (`<` frente a `<=`)
+        bool acceptExact(std::string_view token, char notFollowedBy)
+        {
+            skipSpace();
+            if (source_.substr(pos_, token.size()) == token &&
+                (pos_ + token.size() >= source_.size() || source_[pos_ + token.size()] != notFollowedBy))
+            {
+                pos_ += token.size();
+                return true;
+            }
+            return false;
+        }
+
+        void fail(const std::string &message)
+        {
+            if (error_.empty())
+            {
+                error_ = message + " (columna " + std::to_string(pos_ + 1) + ")";
+            }
+        }
+
+        // --- Emisión ---
+
+        void emit(Op op, uint32_t operand = 0)
+        {
+            code_.push_back({op, operand});
+        }
+
+        /// Un campo usado fuera de `campo OP constante` depende de cualquier cambio
+        void consume(const Operand &operand)
+        {
+            if (operand.kind == Operand::Kind::Field)
+            {
+                looseFields[operand.field] = true;
+            }
+        }
+
+        Operand binary(Op op, Operand lhs, Operand rhs)
+        {
+            consume(lhs);
+            consume(rhs);
+            emit(op);
+            Operand result;
+            result.depth = std::max(lhs.depth, rhs.depth + 1);
+            return result;
+        }
+
+        // --- Gramática ---
+
+        Operand parseOr()
+        {
+            Operand lhs = parseAnd();
+            while (error_.empty() && accept("||"))
+            {
+                lhs = binary(Op::Or, lhs, parseAnd());
+            }
+            return lhs;
+        }
+
+        Operand parseAnd()
+        {
+            Operand lhs = parseComparison();
+            while (error_.empty() && accept("&&"))
+            {
+                lhs = binary(Op::And, lhs, parseComparison());
+            }
+            return lhs;
+        }
+
+        Operand parseComparison()
+        {
+            Operand lhs = parseAdditive();
+            Op op;
+            if (accept("<="))
+            {
+                op = Op::Le;
+            }
+            else if (accept(">="))
+            {
+                op = Op::Ge;
+            }
+            else if (accept("=="))
+            {
+                op = Op::Eq;
+            }
+            else if (accept("!="))
+            {
+                op = Op::Ne;
+            }
+            else if (acceptExact("<", '='))
+            {
+                op = Op::Lt;
+            }
+            else if (acceptExact(">", '='))
+            {
+                op = Op::Gt;
+            }
+            else
+            {
+                return lhs;
+            }
+
+            Operand rhs = parseAdditive();
+            const Operand *field = nullptr;
+            const Operand *constant = nullptr;
+            if (lhs.kind == Operand::Kind::Field && rhs.kind == Operand::Kind::Const)
+            {
+                field = &lhs;
+                constant = &rhs;
+            }
+            else if (lhs.kind == Operand::Kind::Const && rhs.kind == Operand::Kind::Field)
+            {
+                field = &rhs;
+                constant = &lhs;
+            }
+
+            if (field)
+            {
+                // El resultado solo cambia cuando el campo cruza la constante
+                thresholds[field->field].push_back({constant->value, 0});
+                emit(op);
+                Operand result;
+                result.depth = 2;
+                return result;
+            }
+            return binary(op, lhs, rhs);
+        }
+
+        Operand parseAdditive()
+        {
+            Operand lhs = parseMultiplicative();
+            while (error_.empty())
+            {
+                if (accept("+"))
+                {
+                    lhs = binary(Op::Add, lhs, parseMultiplicative());
+                }
+                else if (accept("-"))
+                {
+                    lhs = binary(Op::Sub, lhs, parseMultiplicative());
+                }
+                else
+                {
+                    break;
+                }
+            }
+            return lhs;
+        }
+
+        Operand parseMultiplicative()
+        {
+            Operand lhs = parseUnary();
+            while (error_.empty())
+            {
+                if (accept("*"))
+                {
+                    lhs = binary(Op::Mul, lhs, parseUnary());
+                }
+                else if (accept("/"))
+                {
+                    lhs = binary(Op::Div, lhs, parseUnary());
+                }
+                else
+                {
+                    break;
+                }
+            }
+            return lhs;
+        }
+
+        /// Cuenta un nivel de recursión; falla antes de agotar la pila del hilo (recarga en caliente incluida)
+        bool enterNested()
+        {
+            if (nesting_ >= MAX_NESTING)
+            {
+                fail("expresión demasiado anidada");
+                return false;
+            }
+            ++nesting_;
+            return true;
+        }
+
+        Operand parseUnary()
+        {
+            if (!error_.empty())
+            {
+                return Operand{};
+            }
+            if (acceptExact("!", '='))
+            {
+                if (!enterNested())
+                {
+                    return Operand{};
+                }
+                Operand operand = parseUnary();
+                --nesting_;
+                consume(operand);
+                emit(Op::Not);
+                Operand result;
+                result.depth = operand.depth;
+                return result;
+            }
+            if (accept("-"))
+            {
+                if (!enterNested())
+                {
+                    return Operand{};
+                }
+                Operand operand = parseUnary();
+                --nesting_;
+                if (operand.kind == Operand::Kind::Const)
+                {
+                    // `-500` sigue siendo una constante (y un umbral indexable)
+                    operand.value = -operand.value;
+                    constants_[code_.back().operand] = operand.value;
+                    return operand;
+                }
+                consume(operand);
+                emit(Op::Neg);
+                Operand result;
+                result.depth = operand.depth;
+                return result;
+            }
+            return parsePrimary();
+        }
+
+        /// Nombre crudo entre paréntesis: `in(zona norte)` admite espacios internos
+        std::string parseName()
+        {
+            if (!accept("("))
+            {
+                fail("se esperaba '('");
+                return {};
+            }
+            size_t close = source_.find(')', pos_);
+            if (close == std::string_view::npos)
+            {
+                fail("falta ')'");
+                return {};
+            }
+            std::string_view name = source_.substr(pos_, close - pos_);
+            while (!name.empty() && std::isspace(static_cast<unsigned char>(name.front())))
+            {
+                name.remove_prefix(1);
+            }
+            while (!name.empty() && std::isspace(static_cast<unsigned char>(name.back())))
+            {
+                name.remove_suffix(1);
+            }
+            pos_ = close + 1;
+            return std::string(name);
+        }
+
+        Operand parsePrimary()
+        {
+            Operand result;
+            if (!error_.empty())
+            {
+                return result;
+            }
+            skipSpace();
+            if (pos_ >= source_.size())
+            {
+                fail("expresión incompleta");
+                return result;
+            }
+
+            char c = source_[pos_];
+            if (c == '(')
+            {
+                if (!enterNested())
+                {
+                    return result;
+                }
+                ++pos_;
+                result = parseOr();
+                --nesting_;
+                if (!accept(")"))
+                {
+                    fail("se esperaba ')'");
+                }
+                return result;
+            }
+
+            if (std::isdigit(static_cast<unsigned char>(c)) || c == '.')
+            {
+                std::string literal(source_.substr(pos_, 32));
+                char *end = nullptr;
+                float value = std::strtof(literal.c_str(), &end);
+                if (end == literal.c_str())
+                {
+                    fail("número inválido");
+                    return result;
+                }
+                pos_ += static_cast<size_t>(end - literal.c_str());
+                return constant(value);
+            }
+
+            if (std::isalpha(static_cast<unsigned char>(c)) || c == '_')
+            {
+                size_t start = pos_;
+                while (pos_ < source_.size() &&
+                       (std::isalnum(static_cast<unsigned char>(source_[pos_])) || source_[pos_] == '_'))
+                {
+                    ++pos_;
+                }
+                std::string_view word = source_.substr(start, pos_ - start);
+
+                if (word == "true" || word == "false")
+                {
+                    return constant(word == "true" ? 1.0f : 0.0f);
+                }
+                if (word == "in" || word == "fired")
+                {
+                    const bool isZone = word == "in";
+                    std::string name = parseName();
+                    if (!error_.empty())
+                    {
+                        return result;
+                    }
+                    const NameIndex &index = isZone ? zones_ : triggers_;
+                    auto it = index.find(name);
+                    if (it == index.end())
+                    {
+                        pos_ = start;
+                        fail(std::string(isZone ? "zona desconocida '" : "disparador desconocido '") + name + "'");
+                        return result;
+                    }
+                    emit(isZone ? Op::InZone : Op::Fired, it->second);
+                    (isZone ? zones : fired).push_back(it->second);
+                    return result;
+                }
+                for (const FieldName &entry : FIELD_NAMES)
+                {
+                    if (word == entry.name)
+                    {
+                        result.kind = Operand::Kind::Field;
+                        result.field = static_cast<uint32_t>(entry.field);
+                        emit(Op::Field, result.field);
+                        return result;
+                    }
+                }
+                pos_ = start;
+                fail("campo desconocido '" + std::string(word) + "'");
+                return result;
+            }
+
+            fail(std::string("carácter inesperado '") + c + "'");
+            return result;
+        }
+
+        Operand constant(float value)
+        {
+            emit(Op::Const, static_cast<uint32_t>(constants_.size()));
+            constants_.push_back(value);
+            Operand result;
+            result.kind = Operand::Kind::Const;
+            result.value = value;
+            return result;
+        }
+
+        std::string_view source_;
+        size_t pos_ = 0;
+        size_t nesting_ = 0;
+        std::string error_;
+        const NameIndex &zones_;
+        const NameIndex &triggers_;
+        std::vector<Instruction> &code_;
+        std::vector<float> &constants_;
+    };
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Carga
+    ////////////////////////////////////////////////////////////////////////////
+
+    void TriggerEngine::clear()
+    {
+        code_.clear();
+        constants_.clear();
+        triggers_.clear();
+        for (size_t f = 0; f < TRIGGER_FIELD_COUNT; ++f)
+        {
+            thresholds_[f].clear();
+            fieldDependents_[f].clear();
+        }
+        zoneDependents_.clear();
+        firedDependents_.clear();
+        armDependents_.clear();
+
+        zones_.clear();
+        zoneGrid_.reset(1.0f);
+        maxZoneRadius_ = 0.0f;
+        zoneInside_.clear();
+        insideZones_.clear();
+        nextInside_.clear();
+
+        last_ = TriggerInputs();
+        hasLast_ = false;
+        time_ = 0.0f;
+        dirty_.clear();
+        wave_.clear();
+        queued_.clear();
+        firedThisWave_.clear();
+        holding_.clear();
+        deadlines_.clear();
+        stats_ = TriggerStats();
+    }
+
+    size_t TriggerEngine::load(const MissionDefinition &mission)
+    {
+        clear();
+
+        NameIndex zoneIndex;
+        NameIndex triggerIndex;
+        zones_ = mission.zones;
+        for (size_t i = 0; i < zones_.size(); ++i)
+        {
+            zoneIndex.emplace(zones_[i].id, static_cast<uint32_t>(i));
+        }
+        for (size_t i = 0; i < mission.triggers.size(); ++i)
+        {
+            if (!triggerIndex.emplace(mission.triggers[i].id, static_cast<uint32_t>(i)).second)
+            {
+                std::cerr << "[TriggerEngine] Id de disparador repetido '" << mission.triggers[i].id
+                          << "': fired()/after usan el primero" << std::endl;
+            }
+        }
+
+        const size_t count = mission.triggers.size();
+        triggers_.resize(count);
+        zoneDependents_.resize(zones_.size());
+        firedDependents_.resize(count);
+        armDependents_.resize(count);
+        queued_.assign(count, 0);
+
+        size_t failures = 0;
+        for (size_t i = 0; i < count; ++i)
+        {
+            const TriggerDef &def = mission.triggers[i];
+            Trigger &trigger = triggers_[i];
+            const uint32_t index = static_cast<uint32_t>(i);
+            trigger.within = def.within;
+            trigger.hold = def.hold;
+            trigger.repeat = def.repeat;
+
+            const size_t codeStart = code_.size();
+            const size_t constantStart = constants_.size();
+            Compiler compiler(def.condition, zoneIndex, triggerIndex, code_, constants_);
+            std::string error;
+            bool ok = compiler.compile(error);
+            if (ok && !def.after.empty())
+            {
+                auto it = triggerIndex.find(def.after);
+                if (it == triggerIndex.end() || it->second == index)
+                {
+                    error = "after: disparador desconocido '" + def.after + "'";
+                    ok = false;
+                }
+                else
+                {
+                    trigger.after = it->second;
+                }
+            }
+            if (!ok)
+            {
+                std::cerr << "[TriggerEngine] Disparador '" << def.id << "': " << error << std::endl;
+                code_.resize(codeStart);
+                constants_.resize(constantStart);
+                trigger.state = State::Disabled;
+                ++failures;
+                continue;
+            }
+
+            trigger.codeOffset = static_cast<uint32_t>(codeStart);
+            trigger.codeLength = static_cast<uint32_t>(code_.size() - codeStart);
+
+            for (size_t f = 0; f < TRIGGER_FIELD_COUNT; ++f)
+            {
+                if (compiler.looseFields[f])
+                {
+                    fieldDependents_[f].push_back(index);
+                }
+                for (Threshold threshold : compiler.thresholds[f])
+                {
+                    threshold.trigger = index;
+                    thresholds_[f].push_back(threshold);
+                }
+            }
+            std::sort(compiler.zones.begin(), compiler.zones.end());
+            compiler.zones.erase(std::unique(compiler.zones.begin(), compiler.zones.end()), compiler.zones.end());
+            for (uint32_t zone : compiler.zones)
+            {
+                zoneDependents_[zone].push_back(index);
+            }
+            std::sort(compiler.fired.begin(), compiler.fired.end());
+            compiler.fired.erase(std::unique(compiler.fired.begin(), compiler.fired.end()), compiler.fired.end());
+            for (uint32_t source : compiler.fired)
+            {
+                firedDependents_[source].push_back(index);
+            }
+
+            if (trigger.after != util::SpatialGrid::NONE)
+            {
+                trigger.state = State::Waiting;
+                armDependents_[trigger.after].push_back(index);
+            }
+        }
+
+        for (size_t f = 0; f < TRIGGER_FIELD_COUNT; ++f)
+        {
+            std::sort(thresholds_[f].begin(), thresholds_[f].end(),
+                      [](const Threshold &a, const Threshold &b)
+                      {
+                          return a.value < b.value;
+                      });
+        }
+
+        // Broadphase: una celda del tamaño de la zona más grande, así una
+        // consulta de ese radio toca 3x3 celdas
+        std::vector<glm::vec2> centers;
+        centers.reserve(zones_.size());
+        for (const ZoneDef &zone : zones_)
+        {
+            centers.emplace_back(zone.center.x, zone.center.z);
+            maxZoneRadius_ = std::max(maxZoneRadius_, zone.radius);
+        }
+        zoneGrid_.build(centers, std::max(maxZoneRadius_, 1.0f));
+        zoneInside_.assign(zones_.size(), 0);
+
+        // Los que no esperan a nadie se arman en t = 0
+        for (size_t i = 0; i < count; ++i)
+        {
+            if (triggers_[i].state == State::Armed)
+            {
+                triggers_[i].state = State::Waiting;
+                arm(static_cast<uint32_t>(i), 0.0f);
+            }
+        }
+        return failures;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Evaluación
+    ////////////////////////////////////////////////////////////////////////////
+
+    bool TriggerEngine::evaluate(const Trigger &trigger) const
+    {
+        float stack[MAX_STACK];
+        size_t top = 0;
+        const Instruction *it = code_.data() + trigger.codeOffset;
+        const Instruction *end = it + trigger.codeLength;
+        for (; it != end; ++it)
+        {
+            switch (it->op)
+            {
+            case Op::Const:
+                stack[top++] = constants_[it->operand];
+                break;
+            case Op::Field:
+                stack[top++] = last_.fields[it->operand];
+                break;
+            case Op::InZone:
+                stack[top++] = zoneInside_[it->operand] ? 1.0f : 0.0f;
+                break;
+            case Op::Fired:
+                stack[top++] = triggers_[it->operand].firedOnce ? 1.0f : 0.0f;
+                break;
+            case Op::Not:
+                stack[top - 1] = stack[top - 1] == 0.0f ? 1.0f : 0.0f;
+                break;
+            case Op::Neg:
+                stack[top - 1] = -stack[top - 1];
+                break;
+            default:
+            {
+                const float b = stack[--top];
+                float &a = stack[top - 1];
+                switch (it->op)
+                {
+                case Op::Add:
+                    a = a + b;
+                    break;
+                case Op::Sub:
+                    a = a - b;
+                    break;
+                case Op::Mul:
+                    a = a * b;
+                    break;
+                case Op::Div:
+                    a = b != 0.0f ? a / b : 0.0f;
+                    break;
+                case Op::Lt:
+                    a = a < b ? 1.0f : 0.0f;
+                    break;
+                case Op::Le:
+                    a = a <= b ? 1.0f : 0.0f;
+                    break;
+                case Op::Gt:
+                    a = a > b ? 1.0f : 0.0f;
+                    break;
+                case Op::Ge:
+                    a = a >= b ? 1.0f : 0.0f;
+                    break;
+                case Op::Eq:
+                    a = a == b ? 1.0f : 0.0f;
+                    break;
+                case Op::Ne:
+                    a = a != b ? 1.0f : 0.0f;
+                    break;
+                case Op::And:
+                    a = (a != 0.0f && b != 0.0f) ? 1.0f : 0.0f;
+                    break;
+                case Op::Or:
+                    a = (a != 0.0f || b != 0.0f) ? 1.0f : 0.0f;
+                    break;
+                default:
+                    break;
+                }
+                break;
+            }
+            }
+        }
+        return top > 0 && stack[top - 1] != 0.0f;
+    }
+
+    void TriggerEngine::markDirty(uint32_t trigger)
+    {
+        if (!queued_[trigger] && triggers_[trigger].state == State::Armed)
+        {
+            queued_[trigger] = 1;
+            dirty_.push_back(trigger);
+        }
+    }
+
+    void TriggerEngine::arm(uint32_t trigger, float time)
+    {
+        Trigger &t = triggers_[trigger];
+        if (t.state != State::Waiting)
+        {
+            return;
+        }
+        t.state = State::Armed;
+        t.value = false;
+        t.holdStart = -1.0f;
+        if (t.within > 0.0f)
+        {
+            deadlines_.push_back({time + t.within, trigger});
+            std::push_heap(deadlines_.begin(), deadlines_.end(), std::greater<Deadline>());
+        }
+        markDirty(trigger);
+    }
+
+    void TriggerEngine::fire(uint32_t trigger, std::vector<TriggerEvent> &events)
+    {
+        Trigger &t = triggers_[trigger];
+        events.push_back({trigger, TriggerEvent::Type::Fired});
+        if (!t.repeat)
+        {
+            t.state = State::Fired;
+        }
+        firedThisWave_.push_back(trigger);
+    }
+
+    void TriggerEngine::runWaves(std::vector<TriggerEvent> &events)
+    {
+        for (;;)
+        {
+            // Frontera de oleada: lo disparado recién ahora es visible para
+            // `fired()` y arma a los que lo esperaban
+            for (uint32_t source : firedThisWave_)
+            {
+                triggers_[source].firedOnce = true;
+                for (uint32_t dependent : firedDependents_[source])
+                {
+                    markDirty(dependent);
+                }
+                for (uint32_t dependent : armDependents_[source])
+                {
+                    arm(dependent, time_);
+                }
+            }
+            firedThisWave_.clear();
+
+            if (dirty_.empty())
+            {
+                break;
+            }
+            wave_.swap(dirty_);
+            dirty_.clear();
+            std::sort(wave_.begin(), wave_.end());
+            for (uint32_t index : wave_)
+            {
+                queued_[index] = 0;
+            }
+
+            for (uint32_t index : wave_)
+            {
+                Trigger &t = triggers_[index];
+                if (t.state != State::Armed)
+                {
+                    continue;
+                }
+                ++stats_.evaluations;
+                const bool value = evaluate(t);
+                if (value && !t.value)
+                {
+                    if (t.hold > 0.0f)
+                    {
+                        t.holdStart = time_;
+                        holding_.push_back(index);
+                    }
+                    else
+                    {
+                        fire(index, events);
+                    }
+                }
+                else if (!value && t.value)
+                {
+                    t.holdStart = -1.0f;
+                }
+                t.value = value;
+            }
+        }
+    }
+
+    void TriggerEngine::update(const TriggerInputs &inputs, std::vector<TriggerEvent> &events)
+    {
+        events.clear();
+        stats_ = TriggerStats();
+        time_ = inputs[TriggerField::Time];
+
+        // 1. Plazos vencidos
+        while (!deadlines_.empty() && deadlines_.front().time <= time_)
+        {
+            const uint32_t index = deadlines_.front().trigger;
+            std::pop_heap(deadlines_.begin(), deadlines_.end(), std::greater<Deadline>());
+            deadlines_.pop_back();
+            Trigger &t = triggers_[index];
+            if (t.state == State::Armed)
+            {
+                t.state = State::Expired;
+                t.holdStart = -1.0f;
+                events.push_back({index, TriggerEvent::Type::Expired});
+            }
+        }
+
+        // 2. Entradas: umbrales cruzados y campos cambiados
+        if (bruteForce_)
+        {
+            for (size_t i = 0; i < triggers_.size(); ++i)
+            {
+                markDirty(static_cast<uint32_t>(i));
+            }
+        }
+        else if (hasLast_)
+        {
+            for (size_t f = 0; f < TRIGGER_FIELD_COUNT; ++f)
+            {
+                const float before = last_.fields[f];
+                const float after = inputs.fields[f];
+                if (before == after)
+                {
+                    continue;
+                }
+                for (uint32_t dependent : fieldDependents_[f])
+                {
+                    markDirty(dependent);
+                }
+                // `campo OP c` puede cambiar solo si c está entre los dos valores
+                const float low = std::min(before, after);
+                const float high = std::max(before, after);
+                const std::vector<Threshold> &thresholds = thresholds_[f];
+                auto it = std::lower_bound(thresholds.begin(), thresholds.end(), low,
+                                           [](const Threshold &threshold, float value)
+                                           {
+                                               return threshold.value < value;
+                                           });
+                for (; it != thresholds.end() && it->value <= high; ++it)
+                {
+                    markDirty(it->trigger);
+                }
+            }
+        }
+        last_ = inputs;
+        hasLast_ = true;
+
+        // 3. Zonas
+        updateZones(inputs.position);
+
+        // 4. Oleadas y condiciones sostenidas
+        runWaves(events);
+
+        size_t kept = 0;
+        bool heldFired = false;
+        for (uint32_t index : holding_)
+        {
+            Trigger &t = triggers_[index];
+            if (t.state != State::Armed || t.holdStart < 0.0f)
+            {
+                continue;
+            }
+            if (time_ - t.holdStart >= t.hold)
+            {
+                t.holdStart = -1.0f;
+                fire(index, events);
+                heldFired = true;
+            }
+            else
+            {
+                holding_[kept++] = index;
+            }
+        }
+        holding_.resize(kept);
+        if (heldFired)
+        {
+            runWaves(events);
+        }
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Zonas
+    ////////////////////////////////////////////////////////////////////////////
+
+    bool TriggerEngine::zoneContains(size_t zone, const glm::vec3 &position) const
+    {
+        const ZoneDef &z = zones_[zone];
+        const float dx = position.x - z.center.x;
+        const float dz = position.z - z.center.z;
+        return dx * dx + dz * dz <= z.radius * z.radius &&
+               position.y >= z.minAltitude && position.y <= z.maxAltitude;
+    }
+
+    void TriggerEngine::updateZones(const glm::vec3 &position)
+    {
+        if (zones_.empty())
+        {
+            return;
+        }
+
+        nextInside_.clear();
+        if (bruteForce_)
+        {
+            for (size_t i = 0; i < zones_.size(); ++i)
+            {
+                ++stats_.zoneCandidates;
+                if (zoneContains(i, position))
+                {
+                    nextInside_.push_back(static_cast<uint32_t>(i));
+                }
+            }
+        }
+        else
+        {
+            // Ningún centro a más del radio máximo puede contener la posición
+            zoneGrid_.forEachInRadius(glm::vec2(position.x, position.z), maxZoneRadius_,
+                                      [&](uint32_t id, float)
+                                      {
+                                          ++stats_.zoneCandidates;
+                                          if (zoneContains(id, position))
+                                          {
+                                              nextInside_.push_back(id);
+                                          }
+                                      });
+        }
+
+        // 0 = fuera, 1 = dentro en el frame anterior, 2 = dentro en este
+        for (uint32_t zone : nextInside_)
+        {
+            if (zoneInside_[zone] == 0)
+            {
+                for (uint32_t dependent : zoneDependents_[zone])
+                {
+                    markDirty(dependent);
+                }
+            }
+            zoneInside_[zone] = 2;
+        }
+        for (uint32_t zone : insideZones_)
+        {
+            if (zoneInside_[zone] == 1)
+            {
+                zoneInside_[zone] = 0;
+                for (uint32_t dependent : zoneDependents_[zone])
+                {
+                    markDirty(dependent);
+                }
+            }
+        }
+        for (uint32_t zone : nextInside_)
+        {
+            zoneInside_[zone] = 1;
+        }
+        insideZones_.swap(nextInside_);
+    }
+
+} // namespace mission
@@ -0,0 +1,228 @@
+/**
+ * @file TriggerEngine.h
+ * @brief Evaluación por eventos de los disparadores declarativos de una misión
+ *
+ * Cada condición (`TriggerDef::condition`) se compila al cargar la misión a
+ * un bytecode de pila compacto. Durante el vuelo no se evalúan todas en cada
+ * frame: solo las que dependen de algo que cambió.
+ *
+ * - Comparaciones `campo OP constante`: el umbral se indexa por campo y la
+ *   condición se reevalúa solo cuando el campo lo cruza.
+ * - Otros usos de un campo (aritmética, valor booleano): al cambiar el campo.
+ * - `in(zona)`: al entrar o salir de la zona (grilla espacial como broadphase).
+ * - `fired(id)` y `after`: cuando ese disparador se dispara.
+ */
+
+#pragma once
+
+#include "MissionDefinition.h"
+#include "util/SpatialGrid.h"
+#include <cstdint>
+#include <vector>
+
+namespace mission
+{
+
+    /**
+     * @brief Datos de entrada que pueden leer las condiciones
+     */
+    enum class TriggerField : uint8_t
+    {
+        Altitude,      ///< `altitude` (ft)
+        Airspeed,      ///< `airspeed` (kt)
+        VerticalSpeed, ///< `verticalSpeed` (ft/min)
+        Heading,       ///< `heading` (grados)
+        Pitch,         ///< `pitch` (grados)
+        Roll,          ///< `roll` (grados)
+        GForce,        ///< `gForce`
+        Time,          ///< `time`: segundos desde que empezó la misión
+        Captured,      ///< `captured`: waypoints capturados
+        Count
+    };
+
+    constexpr size_t TRIGGER_FIELD_COUNT = static_cast<size_t>(TriggerField::Count);
+
+    /**
+     * @brief Muestra de entrada de un frame
+     */
+    struct TriggerInputs
+    {
+        float fields[TRIGGER_FIELD_COUNT] = {};
+        glm::vec3 position = glm::vec3(0.0f); ///< m, para las zonas
+
+        float &operator[](TriggerField field) { return fields[static_cast<size_t>(field)]; }
+        float operator[](TriggerField field) const { return fields[static_cast<size_t>(field)]; }
+    };
+
+    /**
+     * @brief Algo que pasó con un disparador en `TriggerEngine::update`
+     */
+    struct TriggerEvent
+    {
+        enum class Type : uint8_t
+        {
+            Fired,  ///< La condición se cumplió (y se sostuvo `hold` segundos)
+            Expired ///< Venció `within` sin que se cumpliera
+        };
+
+        uint32_t trigger; ///< Índice en `MissionDefinition::triggers`
+        Type type;
+    };
+
+    /**
+     * @brief Contadores del último `update` (benchmark)
+     */
+    struct TriggerStats
+    {
+        size_t evaluations = 0;    ///< Condiciones ejecutadas
+        size_t zoneCandidates = 0; ///< Zonas probadas con precisión tras la broadphase
+    };
+
+    /**
+     * @brief Compilador y evaluador de disparadores
+     *
+     * Cada `update` procesa por oleadas: primero se reevalúan las condiciones
+     * marcadas por los cambios de entrada, en orden de índice; los disparos de
+     * una oleada (y los disparadores que arman) se aplican antes de la
+     * siguiente. Así el resultado no depende del orden en que se marcaron, y
+     * coincide con reevaluar todo (`setBruteForce(true)`).
+     */
+    class TriggerEngine
+    {
+    public:
+        /**
+         * @brief Compila los disparadores y zonas de la misión
+         * @return Cantidad de disparadores con errores (quedan deshabilitados y se informan por consola)
+         */
+        size_t load(const MissionDefinition &mission);
+
+        void clear();
+
+        /**
+         * @brief Avanza un frame
+         * @param events Recibe lo ocurrido en esta llamada (se vacía antes)
+         */
+        void update(const TriggerInputs &inputs, std::vector<TriggerEvent> &events);
+
+        /**
+         * @brief Reevaluar todo en cada frame y probar todas las zonas (referencia del benchmark)
+         */
+        void setBruteForce(bool bruteForce) { bruteForce_ = bruteForce; }
+
+        size_t size() const { return triggers_.size(); }
+        size_t zoneCount() const { return zones_.size(); }
+        bool hasFired(size_t trigger) const { return trigger < triggers_.size() && triggers_[trigger].firedOnce; }
+        bool isInside(size_t zone) const { return zone < zoneInside_.size() && zoneInside_[zone] != 0; }
+        const TriggerStats &stats() const { return stats_; }
+
+    private:
+        enum class Op : uint8_t
+        {
+            Const,
+            Field,
+            InZone,
+            Fired,
+            Not,
+            Neg,
+            Add,
+            Sub,
+            Mul,
+            Div,
+            Lt,
+            Le,
+            Gt,
+            Ge,
+            Eq,
+            Ne,
+            And,
+            Or
+        };
+
+        /// 8 bytes: código de operación y operando (constante, campo, zona o disparador)
+        struct Instruction
+        {
+            Op op;
+            uint32_t operand;
+        };
+
+        enum class State : uint8_t
+        {
+            Waiting,  ///< Espera a su `after`
+            Armed,    ///< Se evalúa
+            Fired,    ///< Disparado (sin `repeat`)
+            Expired,  ///< Venció su plazo
+            Disabled  ///< No compiló
+        };
+
+        struct Trigger
+        {
+            uint32_t codeOffset = 0;
+            uint32_t codeLength = 0;
+            uint32_t after = util::SpatialGrid::NONE; ///< Índice del disparador que lo arma
+            float within = 0.0f;
+            float hold = 0.0f;
+            float holdStart = -1.0f; ///< Tiempo en que la condición pasó a verdadera (< 0 si no se sostiene)
+            State state = State::Armed;
+            bool repeat = false;
+            bool value = false;     ///< Resultado de la última evaluación
+            bool firedOnce = false; ///< Lo que lee `fired(id)`
+        };
+
+        struct Threshold
+        {
+            float value;
+            uint32_t trigger;
+        };
+
+        struct Deadline
+        {
+            float time;
+            uint32_t trigger;
+            bool operator>(const Deadline &other) const { return time > other.time; }
+        };
+
+        class Compiler;
+
+        bool evaluate(const Trigger &trigger) const;
+        void runWaves(std::vector<TriggerEvent> &events);
+        void markDirty(uint32_t trigger);
+        void arm(uint32_t trigger, float time);
+        void fire(uint32_t trigger, std::vector<TriggerEvent> &events);
+        void updateZones(const glm::vec3 &position);
+        bool zoneContains(size_t zone, const glm::vec3 &position) const;
+
+        // Programas
+        std::vector<Instruction> code_;
+        std::vector<float> constants_;
+        std::vector<Trigger> triggers_;
+
+        // Dependencias (índices de disparadores)
+        std::vector<Threshold> thresholds_[TRIGGER_FIELD_COUNT]; ///< Ordenados por valor
+        std::vector<uint32_t> fieldDependents_[TRIGGER_FIELD_COUNT];
+        std::vector<std::vector<uint32_t>> zoneDependents_;
+        std::vector<std::vector<uint32_t>> firedDependents_;
+        std::vector<std::vector<uint32_t>> armDependents_;
+
+        // Zonas
+        std::vector<ZoneDef> zones_;
+        util::SpatialGrid zoneGrid_;
+        float maxZoneRadius_ = 0.0f;
+        std::vector<uint8_t> zoneInside_;
+        std::vector<uint32_t> insideZones_;
+        std::vector<uint32_t> nextInside_;
+
+        // Estado por frame
+        TriggerInputs last_;
+        bool hasLast_ = false;
+        float time_ = 0.0f;
+        std::vector<uint32_t> dirty_;
+        std::vector<uint32_t> wave_;
+        std::vector<uint8_t> queued_;
+        std::vector<uint32_t> firedThisWave_;
+        std::vector<uint32_t> holding_;
+        std::vector<Deadline> deadlines_; ///< Heap mínimo por tiempo
+        bool bruteForce_ = false;
+        TriggerStats stats_;
+    };
+
+} // namespace mission
@@ -0,0 +1,375 @@
+/**
+ * @file WaypointBenchmark.cpp
+ * @brief Implementación del benchmark de captura y búsqueda de waypoints
+ */
+
+#include "WaypointBenchmark.h"
+#include "RouteOptimizer.h"
+#include "WaypointTracker.h"
+#include "core/JobPool.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+
+namespace mission
+{
+
+    namespace
+    {
+        using Clock = std::chrono::steady_clock;
+
+        double elapsedMs(Clock::time_point start)
+        {
+            return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        }
+
+        /// Misma disposición que la entrada que usaba WaypointSystem antes de la grilla
+        struct LinearEntry
+        {
+            glm::vec3 position;
+            std::string name;
+            bool captured = false;
+        };
+
+        /// Recorrido previo: primer pendiente por barrido y recuento tras cada captura
+        size_t linearSequentialFrame(std::vector<LinearEntry> &waypoints, const glm::vec3 &plane, size_t &remaining)
+        {
+            int next = -1;
+            for (size_t i = 0; i < waypoints.size(); ++i)
+            {
+                if (!waypoints[i].captured)
+                {
+                    next = static_cast<int>(i);
+                    break;
+                }
+            }
+            if (next == -1 || glm::distance(plane, waypoints[next].position) >= WaypointTracker::CAPTURE_RADIUS)
+            {
+                return 0;
+            }
+
+            waypoints[next].captured = true;
+            remaining = 0;
+            for (const LinearEntry &wp : waypoints)
+            {
+                if (!wp.captured)
+                {
+                    remaining++;
+                }
+            }
+            return 1;
+        }
+
+        /// Captura en cualquier orden sin índice: distancia a todos los pendientes
+        size_t linearAnyFrame(std::vector<LinearEntry> &waypoints, const glm::vec3 &plane, size_t &remaining)
+        {
+            size_t captured = 0;
+            for (LinearEntry &wp : waypoints)
+            {
+                if (!wp.captured && glm::distance(plane, wp.position) < WaypointTracker::CAPTURE_RADIUS)
+                {
+                    wp.captured = true;
+                    captured++;
+                }
+            }
+            if (captured > 0)
+            {
+                remaining = 0;
+                for (const LinearEntry &wp : waypoints)
+                {
+                    if (!wp.captured)
+                    {
+                        remaining++;
+                    }
+                }
+            }
+            return captured;
+        }
+
+        /// Trayectoria del avión: cada 4 frames pasa sobre un waypoint, el resto vuela lejos
+        std::vector<glm::vec3> flightPath(const std::vector<WaypointDef> &waypoints, size_t firstTarget,
+                                          bool sequential, int frames, std::mt19937 &rng)
+        {
+            std::uniform_int_distribution<size_t> pick(0, waypoints.size() - 1);
+            std::vector<glm::vec3> path;
+            path.reserve(frames);
+            size_t target = firstTarget;
+            for (int f = 0; f < frames; ++f)
+            {
+                if (f % 4 == 3 && target < waypoints.size())
+                {
+                    path.push_back(waypoints[target].position + glm::vec3(20.0f, -10.0f, 15.0f));
+                    target = sequential ? target + 1 : pick(rng);
+                }
+                else
+                {
+                    size_t anchor = std::min(target, waypoints.size() - 1);
+                    path.push_back(waypoints[anchor].position + glm::vec3(0.0f, 2000.0f, 0.0f));
+                }
+            }
+            return path;
+        }
+
+        void printRow(const char *label, double linearMs, double gridMs, int frames)
+        {
+            double linearUs = linearMs * 1000.0 / frames;
+            double gridUs = gridMs * 1000.0 / frames;
+            std::cout << "  " << std::left << std::setw(22) << label << std::right
+                      << std::setw(12) << linearUs << " µs  →" << std::setw(10) << gridUs << " µs  ("
+                      << (gridUs > 0.0 ? linearUs / gridUs : 0.0) << "x)" << std::endl;
+        }
+
+        bool runSize(size_t count, const WaypointBenchmarkOptions &options)
+        {
+            std::mt19937 rng(options.seed + static_cast<uint32_t>(count));
+
+            // Densidad de relevamiento: ~1 waypoint cada 300 m de lado
+            float halfSide = std::max(2000.0f, std::sqrt(static_cast<float>(count)) * 150.0f);
+            std::uniform_real_distribution<float> coordinate(-halfSide, halfSide);
+            std::uniform_real_distribution<float> altitude(800.0f, 3000.0f);
+
+            std::vector<WaypointDef> waypoints;
+            waypoints.reserve(count);
+            for (size_t i = 0; i < count; ++i)
+            {
+                waypoints.emplace_back(glm::vec3(coordinate(rng), altitude(rng), coordinate(rng)),
+                                       "WP-" + std::to_string(i + 1));
+            }
+
+            std::cout << "Waypoints: " << count << std::endl;
+            bool ok = true;
+
+            // ---- Carga ----
+            Clock::time_point start = Clock::now();
+            WaypointTracker tracker;
+            tracker.load(waypoints, WaypointOrder::Sequential);
+            double loadMs = elapsedMs(start);
+            std::cout << "  carga + grilla          " << std::setw(12) << loadMs << " ms" << std::endl;
+            std::cout << "  (por frame)                   lineal          grilla" << std::endl;
+
+            // ---- Secuencial, a mitad de misión ----
+            {
+                std::vector<LinearEntry> linear;
+                linear.reserve(count);
+                for (const WaypointDef &wp : waypoints)
+                {
+                    linear.push_back({wp.position, wp.name, false});
+                }
+                size_t half = count / 2;
+                for (size_t i = 0; i < half; ++i)
+                {
+                    linear[i].captured = true;
+                    tracker.capture(i);
+                }
+
+                std::vector<glm::vec3> path = flightPath(waypoints, half, true, options.frames, rng);
+                size_t linearRemaining = count - half;
+                size_t linearCaptured = 0;
+                start = Clock::now();
+                for (const glm::vec3 &plane : path)
+                {
+                    linearCaptured += linearSequentialFrame(linear, plane, linearRemaining);
+                }
+                double linearMs = elapsedMs(start);
+
+                std::vector<uint32_t> captured;
+                size_t gridCaptured = 0;
+                start = Clock::now();
+                for (const glm::vec3 &plane : path)
+                {
+                    gridCaptured += tracker.update(plane, captured);
+                }
+                double gridMs = elapsedMs(start);
+
+                printRow("secuencial", linearMs, gridMs, options.frames);
+                if (linearCaptured != gridCaptured || linearRemaining != tracker.remaining())
+                {
+                    std::cout << "  ✗ secuencial: " << linearCaptured << " vs " << gridCaptured << " capturas" << std::endl;
+                    ok = false;
+                }
+            }
+
+            // ---- Cualquier orden ----
+            {
+                std::vector<LinearEntry> linear;
+                linear.reserve(count);
+                for (const WaypointDef &wp : waypoints)
+                {
+                    linear.push_back({wp.position, wp.name, false});
+                }
+                tracker.load(waypoints, WaypointOrder::Any);
+
+                std::vector<glm::vec3> path = flightPath(waypoints, 0, false, options.frames, rng);
+                size_t linearRemaining = count;
+                size_t linearCaptured = 0;
+                start = Clock::now();
+                for (const glm::vec3 &plane : path)
+                {
+                    linearCaptured += linearAnyFrame(linear, plane, linearRemaining);
+                }
+                double linearMs = elapsedMs(start);
+
+                std::vector<uint32_t> captured;
+                size_t gridCaptured = 0;
+                start = Clock::now();
+                for (const glm::vec3 &plane : path)
+                {
+                    gridCaptured += tracker.update(plane, captured);
+                }
+                double gridMs = elapsedMs(start);
+
+                printRow("cualquier orden", linearMs, gridMs, options.frames);
+                if (linearCaptured != gridCaptured || linearRemaining != tracker.remaining())
+                {
+                    std::cout << "  ✗ cualquier orden: " << linearCaptured << " vs " << gridCaptured << " capturas" << std::endl;
+                    ok = false;
+                }
+            }
+
+            // ---- Waypoint más cercano al cursor (planificador) ----
+            {
+                std::vector<glm::vec2> ground;
+                ground.reserve(count);
+                for (const WaypointDef &wp : waypoints)
+                {
+                    ground.emplace_back(wp.position.x, wp.position.z);
+                }
+                util::SpatialGrid grid;
+                grid.build(ground, 500.0f);
+
+                const float radius = 400.0f; // ~14 px con el mapa a 10 km de semiextensión
+                std::vector<glm::vec2> cursors(options.queries);
+                for (glm::vec2 &cursor : cursors)
+                {
+                    cursor = glm::vec2(coordinate(rng), coordinate(rng));
+                }
+
+                std::vector<float> linearBest(cursors.size());
+                start = Clock::now();
+                for (size_t q = 0; q < cursors.size(); ++q)
+                {
+                    float best = radius;
+                    for (const glm::vec2 &p : ground)
+                    {
+                        best = std::min(best, glm::length(p - cursors[q]));
+                    }
+                    linearBest[q] = best;
+                }
+                double linearMs = elapsedMs(start);
+
+                std::vector<float> gridBest(cursors.size());
+                start = Clock::now();
+                for (size_t q = 0; q < cursors.size(); ++q)
+                {
+                    uint32_t id = grid.nearest(cursors[q], radius);
+                    gridBest[q] = id == util::SpatialGrid::NONE ? radius : glm::length(ground[id] - cursors[q]);
+                }
+                double gridMs = elapsedMs(start);
+
+                printRow("más cercano (consulta)", linearMs, gridMs, options.queries);
+                if (linearBest != gridBest)
+                {
+                    std::cout << "  ✗ más cercano: resultados distintos" << std::endl;
+                    ok = false;
+                }
+            }
+            return ok;
+        }
+
+        /// true si `order` contiene cada índice de [0, count) exactamente una vez
+        bool isPermutation(const std::vector<uint32_t> &order, size_t count)
+        {
+            std::vector<uint8_t> seen(count, 0);
+            for (uint32_t index : order)
+            {
+                if (index >= count || seen[index])
+                {
+                    return false;
+                }
+                seen[index] = 1;
+            }
+            return order.size() == count;
+        }
+    } // namespace
+
+    int runWaypointBenchmark(const WaypointBenchmarkOptions &options)
+    {
+        std::cout << std::fixed << std::setprecision(2);
+
+        bool ok = true;
+        for (size_t count : options.sizes)
+        {
+            if (count > 0)
+            {
+                ok = runSize(count, options) && ok;
+            }
+        }
+
+        std::cout << (ok ? "✓ Índice de waypoints OK" : "✗ Índice de waypoints con fallas") << std::endl;
+        return ok ? 0 : 1;
+    }
+
+    int runRouteBenchmark(const RouteBenchmarkOptions &options, core::JobPool *pool)
+    {
+        std::cout << std::fixed << std::setprecision(2);
+        unsigned threads = pool ? pool->workerCount() + 1 : 1;
+        std::cout << "Optimizador de rutas: " << options.restarts << " reinicios, " << threads << " hilos" << std::endl;
+        std::cout << "  waypoints   original      vecino      óptimo   vs orig.  vs vecino   1 hilo (ms)   " << threads
+                  << " hilos (ms)" << std::endl;
+
+        bool ok = true;
+        for (size_t count : options.sizes)
+        {
+            // Orden de carga aleatorio, como una lista de relevamiento sin ordenar
+            std::mt19937 rng(options.seed + static_cast<uint32_t>(count));
+            float halfSide = std::max(2000.0f, std::sqrt(static_cast<float>(count)) * 300.0f);
+            std::uniform_real_distribution<float> coordinate(-halfSide, halfSide);
+            std::uniform_real_distribution<float> altitude(800.0f, 3000.0f);
+            std::vector<glm::vec3> waypoints(count);
+            for (glm::vec3 &waypoint : waypoints)
+            {
+                waypoint = glm::vec3(coordinate(rng), altitude(rng), coordinate(rng));
+            }
+            glm::vec3 start(0.0f, 1500.0f, 0.0f);
+
+            RouteOptions routeOptions;
+            routeOptions.restarts = options.restarts;
+            routeOptions.altitudeWeight = options.altitudeWeight;
+            routeOptions.seed = options.seed;
+
+            routeOptions.maxThreads = 1;
+            RouteResult single = optimizeRoute(start, waypoints, routeOptions, pool);
+            routeOptions.maxThreads = 0;
+            RouteResult parallel = optimizeRoute(start, waypoints, routeOptions, pool);
+
+            double km = 1.0 / 1000.0;
+            std::cout << "  " << std::setw(9) << count
+                      << std::setw(10) << parallel.initialCost * km << " km"
+                      << std::setw(9) << parallel.seedCost * km << " km"
+                      << std::setw(9) << parallel.cost * km << " km"
+                      << std::setw(9) << 100.0 * (1.0 - parallel.cost / std::max(parallel.initialCost, 1e-9)) << "%"
+                      << std::setw(10) << 100.0 * (1.0 - parallel.cost / std::max(parallel.seedCost, 1e-9)) << "%"
+                      << std::setw(14) << single.elapsedMs
+                      << std::setw(16) << parallel.elapsedMs << std::endl;
+
+            for (const RouteResult *result : {&single, &parallel})
+            {
+                double recomputed = routeCost(start, waypoints, result->order, options.altitudeWeight);
+                if (!isPermutation(result->order, count) || result->cost > result->initialCost + 1e-3 ||
+                    std::abs(recomputed - result->cost) > 1e-3 * std::max(1.0, recomputed))
+                {
+                    std::cout << "  ✗ ruta inválida con " << count << " waypoints" << std::endl;
+                    ok = false;
+                }
+            }
+        }
+
+        std::cout << (ok ? "✓ Optimizador de rutas OK" : "✗ Optimizador de rutas con fallas") << std::endl;
+        return ok ? 0 : 1;
+    }
+
+} // namespace mission
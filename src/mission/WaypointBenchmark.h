@@ -0,0 +1,61 @@
+/**
+ * @file WaypointBenchmark.h
+ * @brief Benchmark de captura y búsqueda de waypoints (modo `--bench-waypoints`)
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace core
+{
+    class JobPool;
+}
+
+namespace mission
+{
+
+    /**
+     * @brief Parámetros del benchmark de waypoints
+     */
+    struct WaypointBenchmarkOptions
+    {
+        std::vector<size_t> sizes = {100, 10000, 1000000}; ///< Waypoints por misión sintética
+        int frames = 500;                                  ///< Frames simulados por escenario
+        int queries = 2000;                                ///< Búsquedas del planificador
+        uint32_t seed = 1337;                              ///< Semilla del generador
+    };
+
+    /**
+     * @brief Comparar el recorrido lineal previo con `WaypointTracker` y `util::SpatialGrid`
+     * @return 0 si ambos caminos coinciden en todos los escenarios, 1 en caso contrario
+     *
+     * Escenarios: captura secuencial a mitad de misión, captura en cualquier
+     * orden y búsqueda del waypoint más cercano al cursor del planificador.
+     * Sin ventana ni contexto OpenGL: `FlightSim --bench-waypoints [tamaños...]`.
+     */
+    int runWaypointBenchmark(const WaypointBenchmarkOptions &options);
+
+    /**
+     * @brief Parámetros del benchmark del optimizador de rutas
+     */
+    struct RouteBenchmarkOptions
+    {
+        std::vector<size_t> sizes = {100, 500, 1000, 2000, 5000}; ///< Waypoints por ruta sintética
+        int restarts = 8;                                         ///< Reinicios por optimización
+        float altitudeWeight = 0.0f;                              ///< Ver RouteOptions::altitudeWeight
+        uint32_t seed = 1337;                                     ///< Semilla del generador
+    };
+
+    /**
+     * @brief Medir `optimizeRoute` con un hilo y con todo el pool
+     * @return 0 si todas las rutas son permutaciones válidas y no empeoran la original
+     *
+     * Reporta la mejora sobre el orden original y sobre el vecino más cercano,
+     * y el tiempo hasta la solución: `FlightSim --bench-routes [tamaños...]`.
+     */
+    int runRouteBenchmark(const RouteBenchmarkOptions &options, core::JobPool *pool);
+
+} // namespace mission
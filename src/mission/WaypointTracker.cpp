@@ -0,0 +1,130 @@
+/**
+ * @file WaypointTracker.cpp
+ * @brief Implementación del seguimiento de capturas de waypoints
+ */
+
+#include "WaypointTracker.h"
+
+namespace mission
+{
+
+    namespace
+    {
+        glm::vec2 groundPosition(const glm::vec3 &position)
+        {
+            return glm::vec2(position.x, position.z);
+        }
+    } // namespace
+
+    void WaypointTracker::load(const std::vector<WaypointDef> &waypoints, WaypointOrder order)
+    {
+        order_ = order;
+        positions_.clear();
+        positions_.reserve(waypoints.size());
+        std::vector<glm::vec2> ground;
+        ground.reserve(waypoints.size());
+        for (const WaypointDef &waypoint : waypoints)
+        {
+            positions_.push_back(waypoint.position);
+            ground.push_back(groundPosition(waypoint.position));
+        }
+
+        captured_.assign(positions_.size(), 0);
+        remaining_ = positions_.size();
+        cursor_ = 0;
+
+        // Celdas del tamaño del radio: una captura revisa como mucho 3x3 celdas
+        grid_.build(ground, CAPTURE_RADIUS);
+        target_ = positions_.empty() ? -1 : 0;
+    }
+
+    void WaypointTracker::clear()
+    {
+        positions_.clear();
+        captured_.clear();
+        grid_.reset(CAPTURE_RADIUS);
+        remaining_ = 0;
+        cursor_ = 0;
+        target_ = -1;
+    }
+
+    size_t WaypointTracker::update(const glm::vec3 &position, std::vector<uint32_t> &captured)
+    {
+        captured.clear();
+        if (remaining_ == 0)
+        {
+            return 0;
+        }
+
+        if (order_ == WaypointOrder::Sequential)
+        {
+            // Solo cuenta el waypoint guía: una distancia por frame
+            if (target_ >= 0 && glm::distance(position, positions_[target_]) < CAPTURE_RADIUS)
+            {
+                captured.push_back(static_cast<uint32_t>(target_));
+            }
+        }
+        else
+        {
+            // La grilla es 2D (XZ): se filtra por distancia 3D como el modo secuencial
+            grid_.forEachInRadius(groundPosition(position), CAPTURE_RADIUS,
+                                  [&](uint32_t id, float)
+                                  {
+                                      if (glm::distance(position, positions_[id]) < CAPTURE_RADIUS)
+                                      {
+                                          captured.push_back(id);
+                                      }
+                                  });
+        }
+
+        for (uint32_t index : captured)
+        {
+            capture(index);
+        }
+        return captured.size();
+    }
+
+    bool WaypointTracker::capture(size_t index)
+    {
+        if (index >= captured_.size() || captured_[index])
+        {
+            return false;
+        }
+
+        captured_[index] = 1;
+        remaining_--;
+        grid_.remove(static_cast<uint32_t>(index));
+        while (cursor_ < captured_.size() && captured_[cursor_])
+        {
+            cursor_++;
+        }
+
+        if (static_cast<int>(index) == target_)
+        {
+            retarget(positions_[index]);
+        }
+        return true;
+    }
+
+    void WaypointTracker::retarget(const glm::vec3 &from)
+    {
+        if (remaining_ == 0)
+        {
+            target_ = -1;
+            return;
+        }
+
+        if (order_ == WaypointOrder::Any)
+        {
+            // El pendiente más cercano; si no hay ninguno cerca, se sigue el orden de la lista
+            uint32_t nearest = grid_.nearest(groundPosition(from), GUIDE_RADIUS);
+            if (nearest != util::SpatialGrid::NONE)
+            {
+                target_ = static_cast<int>(nearest);
+                return;
+            }
+        }
+        target_ = static_cast<int>(cursor_);
+    }
+
+} // namespace mission
@@ -0,0 +1,82 @@
+/**
+ * @file WaypointTracker.h
+ * @brief Estado de captura de los waypoints de una misión en curso
+ *
+ * Separa la lógica de captura (sin OpenGL) del dibujo que hace
+ * `systems::WaypointSystem`, para poder medirla en modo headless.
+ */
+
+#pragma once
+
+#include "MissionDefinition.h"
+#include "util/SpatialGrid.h"
+#include <cstdint>
+#include <vector>
+
+namespace mission
+{
+
+    /**
+     * @brief Seguimiento incremental de capturas sobre una grilla espacial
+     *
+     * - Los pendientes se cuentan al capturar, sin recorrer la lista.
+     * - El cursor al primer pendiente solo avanza (costo amortizado O(1)).
+     * - En modo `WaypointOrder::Any` la captura consulta la grilla: se
+     *   revisan las celdas que tocan el radio de captura, no toda la misión.
+     */
+    class WaypointTracker
+    {
+    public:
+        static constexpr float CAPTURE_RADIUS = 100.0f; ///< m; también es el tamaño de celda
+        static constexpr float GUIDE_RADIUS = 5000.0f;  ///< m; alcance de la búsqueda del más cercano (modo Any)
+
+        /**
+         * @brief Carga los waypoints y construye la grilla
+         */
+        void load(const std::vector<WaypointDef> &waypoints, WaypointOrder order);
+
+        void clear();
+
+        /**
+         * @brief Captura lo que esté dentro del radio de `position`
+         * @param captured Recibe los índices capturados en esta llamada
+         * @return Cantidad capturada
+         */
+        size_t update(const glm::vec3 &position, std::vector<uint32_t> &captured);
+
+        /**
+         * @brief Marca un waypoint como capturado (captura o salto manual)
+         * @return false si ya estaba capturado o el índice no existe
+         */
+        bool capture(size_t index);
+
+        /**
+         * @brief Waypoint guía (el que muestran HUD e indicadores), -1 si no quedan
+         */
+        int target() const { return target_; }
+
+        bool isCaptured(size_t index) const { return index < captured_.size() && captured_[index] != 0; }
+        const glm::vec3 &position(size_t index) const { return positions_[index]; }
+
+        size_t size() const { return positions_.size(); }
+        size_t remaining() const { return remaining_; }
+        WaypointOrder order() const { return order_; }
+
+        /**
+         * @brief Grilla con los waypoints pendientes (los capturados se quitan)
+         */
+        const util::SpatialGrid &grid() const { return grid_; }
+
+    private:
+        void retarget(const glm::vec3 &from);
+
+        std::vector<glm::vec3> positions_;
+        std::vector<uint8_t> captured_;
+        util::SpatialGrid grid_;
+        WaypointOrder order_ = WaypointOrder::Sequential;
+        size_t remaining_ = 0;
+        size_t cursor_ = 0; ///< Primer índice no capturado (o size())
+        int target_ = -1;
+    };
+
+} // namespace mission
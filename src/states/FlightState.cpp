@@ -12,6 +12,8 @@ extern "C"
 #include <glm/gtx/quaternion.hpp>
 
 #include "core/AppContext.h"
+#include "core/FrameProfiler.h"
+#include "core/InputSystem.h"
 #include "mission/MissionController.h"
 #include "mission/MissionRuntime.h"
 #include "systems/FlightSimulationController.h"
@@ -20,7 +22,7 @@ extern "C"
 #include "ui/UIManager.h"
 #include "gfx/skybox/SkyboxRenderer.h"
 #include "gfx/terrain/TerrainPlane.h"
-#include "gfx/core/Shader.h"
+#include "gfx/core/ShaderVariants.h"
 #include "gfx/geometry/Model.h"
 
 namespace states
@@ -34,15 +36,17 @@ namespace states
 
     void FlightState::handleInput(core::AppContext &context)
     {
-        if (!context.missionController || !context.uiManager)
+        core::ProfileScope profile("FlightState::handleInput");
+        if (!context.missionController || !context.uiManager || !context.input)
         {
             return;
         }
 
+        const core::InputSystem &input = *context.input;
         mission::MissionRuntime &runtime = context.missionController->runtime();
 
         // Let the overlay consume input first (briefing/completion screens).
-        if (context.uiManager->handleOverlayInput(context.window))
+        if (context.uiManager->handleOverlayInput(input))
         {
             if (context.uiManager->overlayReadyToFly())
             {
@@ -68,93 +72,77 @@ namespace states
         // If overlay is visible, only allow ESC to exit to menu after completion.
         if (context.uiManager->isOverlayVisible())
         {
-            if (glfwGetKey(context.window, GLFW_KEY_ESCAPE) == GLFW_PRESS)
+            if (input.pressed(core::InputAction::Back) && runtime.isCompleted())
             {
-                if (!overlayEscPressed_ && runtime.isCompleted())
-                {
-                    runtime.requestMenuExit();
-                    overlayEscPressed_ = true;
-                }
-            }
-            else
-            {
-                overlayEscPressed_ = false;
+                runtime.requestMenuExit();
             }
             return;
         }
 
         // ESC closes the app.
-        if (glfwGetKey(context.window, GLFW_KEY_ESCAPE) == GLFW_PRESS)
-        {
-            if (!escPressed_)
-            {
-                glfwSetWindowShouldClose(context.window, true);
-                escPressed_ = true;
-                return;
-            }
-        }
-        else
+        if (input.pressed(core::InputAction::Back))
         {
-            escPressed_ = false;
+            glfwSetWindowShouldClose(context.window, true);
+            return;
         }
 
         // TAB: request return to mission menu.
-        if (glfwGetKey(context.window, GLFW_KEY_TAB) == GLFW_PRESS)
+        if (input.pressed(core::InputAction::ReturnToMenu))
         {
-            if (!tabPressed_)
-            {
-                runtime.requestMenuExit();
-                std::cout << "\n>>> TAB pressed - Returning to mission menu...\n"
-                          << std::endl;
-                tabPressed_ = true;
-            }
+            runtime.requestMenuExit();
+            std::cout << "\n>>> TAB pressed - Returning to mission menu...\n"
+                      << std::endl;
         }
-        else
+
+        // M: skip active waypoint.
+        if (input.pressed(core::InputAction::SkipWaypoint) && context.waypointSystem)
         {
-            tabPressed_ = false;
+            context.waypointSystem->skipActiveWaypoint(runtime);
         }
 
-        // M: skip active waypoint.
-        if (glfwGetKey(context.window, GLFW_KEY_M) == GLFW_PRESS)
+        // R: restart current mission.
+        if (input.pressed(core::InputAction::RestartMission))
         {
-            if (!mPressed_ && context.waypointSystem)
-            {
-                context.waypointSystem->skipActiveWaypoint(runtime);
-                mPressed_ = true;
-            }
+            restartMission(context);
         }
-        else
+
+        // H: switch HUD backend (Renderer2D geometry <-> analytic SDF quads).
+        if (input.pressed(core::InputAction::ToggleHudBackend))
         {
-            mPressed_ = false;
+            context.uiManager->hud().toggleBackend();
         }
 
-        // R: restart current mission.
-        if (glfwGetKey(context.window, GLFW_KEY_R) == GLFW_PRESS)
+        // J: toggle the HUD stress layout (duplicated instruments) and log recording scaling.
+        if (input.pressed(core::InputAction::ToggleHudStress))
         {
-            if (!rPressed_)
+            hud::FlightHUD &hud = context.uiManager->hud();
+            hud.setLayout(hud.isStressLayout() ? "classic" : "stress");
+            if (hud.isStressLayout())
             {
-                restartMission(context);
-                rPressed_ = true;
+                hud.benchmarkRecording();
             }
         }
-        else
+
+        // K: time the scene with the sky drawn first (old order) and last, on the next frame.
+        if (input.pressed(core::InputAction::SkyBenchmark))
         {
-            rPressed_ = false;
+            skyBenchmarkRequested_ = true;
         }
 
         // Forward flight and camera controls to their systems.
         if (context.flightController)
         {
-            context.flightController->handleControls(context.window, context.deltaTime);
+            context.flightController->handleControls(input);
         }
         if (context.cameraRig)
         {
-            context.cameraRig->handleInput(context.window, context.deltaTime);
+            context.cameraRig->handleInput(input, context.deltaTime);
         }
     }
 
     void FlightState::update(core::AppContext &context)
     {
+        core::ProfileScope profile("FlightState::update");
         if (!context.missionController || !context.flightController || !context.uiManager)
         {
             return;
@@ -219,91 +207,134 @@ namespace states
 
     void FlightState::render(core::AppContext &context)
     {
+        core::ProfileScope profile("FlightState::render", core::ProfileTiming::CpuGpu);
         if (!context.cameraRig || !context.flightController)
         {
             return;
         }
 
-        glEnable(GL_DEPTH_TEST);
-
-        const glm::mat4 &view = context.cameraRig->viewMatrix();
-        glm::mat4 projection = context.cameraRig->projectionMatrix(context.screenWidth, context.screenHeight);
-
-        // Background: skybox.
-        if (context.skybox)
-        {
-            context.skybox->draw(view, projection);
-        }
+        gfx::RenderView frameView;
+        frameView.view = context.cameraRig->viewMatrix();
+        frameView.projection = context.cameraRig->projectionMatrix(context.screenWidth, context.screenHeight);
+        frameView.eye = context.cameraRig->position();
+        queue_.begin(frameView);
 
         // Flat terrain with fog tuned to camera altitude.
         if (context.terrainConfig && context.terrain)
         {
             context.terrainConfig->fogMinDist = context.cameraRig->position().y * 0.5f;
             context.terrainConfig->fogMaxDist = context.cameraRig->dynamicFarPlane() * 0.8f;
-            context.terrain->draw(view, projection, context.cameraRig->position(), glm::vec3(0.5f, 0.7f, 1.0f));
+            context.terrain->submit(queue_, glm::vec3(0.5f, 0.7f, 1.0f));
         }
 
         // Aircraft model rendering with simple lighting.
-        if (context.modelShader && context.aircraftModel)
-        {
-            context.modelShader->use();
-            context.modelShader->setMat4("projection", projection);
-            context.modelShader->setMat4("view", view);
-            context.modelShader->setVec3("viewPos", context.cameraRig->position());
-
-            glm::vec3 sunDirection = glm::normalize(glm::vec3(1.0f, 2.0f, 1.0f));
-            glm::vec3 lightPosition = context.flightController->planePosition() + sunDirection * 500.0f;
-            context.modelShader->setVec3("lightPos", lightPosition);
-            context.modelShader->setVec3("lightColor", glm::vec3(1.5f, 1.5f, 1.4f));
-
-            glm::vec3 modelForward = glm::vec3(+1, 0, 0);
-            glm::vec3 modelUp = glm::vec3(0, 0, -1);
-            glm::vec3 worldForward = glm::vec3(0, 0, -1);
-            glm::vec3 worldUp = glm::vec3(0, +1, 0);
-
-            glm::quat q1 = glm::rotation(glm::normalize(modelForward), glm::normalize(worldForward));
-            glm::vec3 upAfter = glm::normalize(q1 * modelUp);
-            glm::vec3 axis = glm::normalize(worldForward);
-            glm::vec3 upProjected = glm::normalize(upAfter - glm::dot(upAfter, axis) * axis);
-            float cosang = glm::clamp(glm::dot(upProjected, worldUp), -1.0f, 1.0f);
-            float angle = acosf(cosang);
-            glm::vec3 crossv = glm::cross(upProjected, worldUp);
-            float sign = (glm::dot(crossv, axis) < 0.f) ? -1.f : +1.f;
-            glm::quat q2 = glm::angleAxis(sign * angle, axis);
-            glm::mat4 Rcorr = glm::mat4_cast(q2 * q1);
-
-            glm::mat4 model = glm::mat4(1.0f);
-            model = glm::translate(model, context.flightController->planePosition());
-            model = model * glm::mat4_cast(context.flightController->planeOrientation());
-            model = model * Rcorr;
-            model = glm::scale(model, glm::vec3(0.05f));
-            context.modelShader->setMat4("model", model);
-
-            context.aircraftModel->Draw(*context.modelShader);
-        }
-
-        // 3D waypoints.
+        if (context.modelShaders && context.aircraftModel)
+        {
+            // One packet for the whole model: it switches between its material variants itself
+            float depth = glm::length(context.flightController->planePosition() - frameView.eye);
+            queue_.submit(gfx::RenderPass::Opaque, 0, 0, depth, &FlightState::drawAircraft, &context);
+        }
+
+        // Skybox: its own pass after the opaque one, so it only shades uncovered pixels.
+        if (context.skybox)
+        {
+            context.skybox->submit(queue_);
+        }
+
+        // 3D waypoints, back to front.
         if (context.waypointSystem)
         {
-            context.waypointSystem->render(view, projection, context.missionController->runtime());
+            context.waypointSystem->submit(queue_, context.missionController->runtime());
         }
 
         // HUD only in first-person camera.
-        if (context.cameraRig->isFirstPerson() && context.uiManager)
+        const bool hudVisible = context.cameraRig->isFirstPerson() && context.uiManager;
+        if (hudVisible)
         {
-            glDisable(GL_DEPTH_TEST);
             context.uiManager->updateHUD(context.flightController->getFlightData());
-            context.uiManager->renderHUD();
-            glEnable(GL_DEPTH_TEST);
+            queue_.submit(gfx::RenderPass::Overlay, 0, 0, 0.0f, &FlightState::drawHud, &context);
         }
 
         // Briefing/completion overlay when needed.
         if (context.missionController->runtime().shouldShowOverlay() && context.uiManager)
         {
-            glDisable(GL_DEPTH_TEST);
-            context.uiManager->renderOverlay();
-            glEnable(GL_DEPTH_TEST);
+            queue_.submit(gfx::RenderPass::Overlay, 0, 0, 0.0f, &FlightState::drawMissionOverlay, &context);
+        }
+
+        if (skyBenchmarkRequested_)
+        {
+            queue_.benchmarkSkyOrder();
+            skyBenchmarkRequested_ = false;
         }
+        queue_.execute();
+
+        if (hudVisible)
+        {
+            const hud::HudRenderStats &hudStats = context.uiManager->hud().stats();
+            core::FrameStats &stats = context.frameStats;
+            stats.hudSdfBackend = hudStats.backend == hud::HudBackend::Sdf;
+            stats.hudCpuMs = hudStats.cpuMs;
+            stats.hudUploadBytes = hudStats.uploadBytes;
+            stats.hudDrawCalls = hudStats.drawCalls;
+            stats.hudGpuMs = hudStats.gpuMs;
+            stats.hudRecordMs = hudStats.recordMs;
+            stats.hudRecordThreads = hudStats.recordThreads;
+            stats.hudLayerCached = hudStats.layerCached;
+            stats.hudLayerRebuilt = hudStats.layerRebuilt;
+            stats.hudDirtyCheckHit = hudStats.dirtyCheckHit;
+            stats.hudSkippedRebuild = hudStats.skippedRebuild;
+            stats.hudDirtyCheckHits = hudStats.totalDirtyCheckHits;
+            stats.hudSkippedRebuilds = hudStats.totalSkippedRebuilds;
+        }
+    }
+
+    void FlightState::drawAircraft(const gfx::DrawPacket &packet, const gfx::RenderView &view)
+    {
+        const auto &context = *static_cast<const core::AppContext *>(packet.object);
+
+        ModelDrawParams params;
+        params.projection = view.projection;
+        params.view = view.view;
+        params.viewPos = view.eye;
+
+        glm::vec3 sunDirection = glm::normalize(glm::vec3(1.0f, 2.0f, 1.0f));
+        params.lightPos = context.flightController->planePosition() + sunDirection * 500.0f;
+        params.lightColor = glm::vec3(1.5f, 1.5f, 1.4f);
+
+        glm::vec3 modelForward = glm::vec3(+1, 0, 0);
+        glm::vec3 modelUp = glm::vec3(0, 0, -1);
+        glm::vec3 worldForward = glm::vec3(0, 0, -1);
+        glm::vec3 worldUp = glm::vec3(0, +1, 0);
+
+        glm::quat q1 = glm::rotation(glm::normalize(modelForward), glm::normalize(worldForward));
+        glm::vec3 upAfter = glm::normalize(q1 * modelUp);
+        glm::vec3 axis = glm::normalize(worldForward);
+        glm::vec3 upProjected = glm::normalize(upAfter - glm::dot(upAfter, axis) * axis);
+        float cosang = glm::clamp(glm::dot(upProjected, worldUp), -1.0f, 1.0f);
+        float angle = acosf(cosang);
+        glm::vec3 crossv = glm::cross(upProjected, worldUp);
+        float sign = (glm::dot(crossv, axis) < 0.f) ? -1.f : +1.f;
+        glm::quat q2 = glm::angleAxis(sign * angle, axis);
+        glm::mat4 Rcorr = glm::mat4_cast(q2 * q1);
+
+        glm::mat4 model = glm::mat4(1.0f);
+        model = glm::translate(model, context.flightController->planePosition());
+        model = model * glm::mat4_cast(context.flightController->planeOrientation());
+        model = model * Rcorr;
+        model = glm::scale(model, glm::vec3(0.05f));
+        params.model = model;
+
+        context.aircraftModel->Draw(*context.modelShaders, params);
+    }
+
+    void FlightState::drawHud(const gfx::DrawPacket &packet, const gfx::RenderView &)
+    {
+        static_cast<const core::AppContext *>(packet.object)->uiManager->renderHUD();
+    }
+
+    void FlightState::drawMissionOverlay(const gfx::DrawPacket &packet, const gfx::RenderView &)
+    {
+        static_cast<const core::AppContext *>(packet.object)->uiManager->renderOverlay();
     }
 
     void FlightState::restartMission(core::AppContext &context)
@@ -6,6 +6,7 @@
 #pragma once
 
 #include "states/IModeState.h"
+#include "gfx/rendering/RenderQueue.h"
 
 namespace states
 {
@@ -28,11 +29,14 @@ namespace states
     private:
         void restartMission(core::AppContext &context);
 
-        bool escPressed_ = false;
-        bool tabPressed_ = false;
-        bool mPressed_ = false;
-        bool rPressed_ = false;
-        bool overlayEscPressed_ = false;
+        // Queue packets; `object` is the AppContext
+        static void drawAircraft(const gfx::DrawPacket &packet, const gfx::RenderView &view);
+        static void drawHud(const gfx::DrawPacket &packet, const gfx::RenderView &view);
+        static void drawMissionOverlay(const gfx::DrawPacket &packet, const gfx::RenderView &view);
+
+        gfx::RenderQueue queue_; ///< Rebuilt every frame; keeps its capacity
+
+        bool skyBenchmarkRequested_ = false;
         bool completionPromptShown_ = false;
     };
 
@@ -9,6 +9,8 @@ extern "C"
 }
 
 #include "core/AppContext.h"
+#include "core/FrameProfiler.h"
+#include "gfx/core/RenderState.h"
 #include "mission/MissionController.h"
 #include "mission/MissionRegistry.h"
 #include "ui/UIManager.h"
@@ -34,16 +36,18 @@ namespace states
 
     void MenuState::handleInput(core::AppContext &context)
     {
+        core::ProfileScope profile("MenuState::handleInput");
         // Pure 2D UI: depth not needed while navigating menu.
-        glDisable(GL_DEPTH_TEST);
-        if (context.uiManager)
+        gfx::RenderState::setDepthTest(false);
+        if (context.uiManager && context.input)
         {
-            context.uiManager->updateMenu(context.window, context.deltaTime);
+            context.uiManager->updateMenu(*context.input, context.deltaTime);
         }
     }
 
     void MenuState::update(core::AppContext &context)
     {
+        core::ProfileScope profile("MenuState::update");
         if (!context.uiManager || !context.missionController)
         {
             return;
@@ -81,9 +85,19 @@ namespace states
 
     void MenuState::render(core::AppContext &context)
     {
+        core::ProfileScope profile("MenuState::render", core::ProfileTiming::CpuGpu);
         if (context.uiManager)
         {
             context.uiManager->renderMenu();
+
+            if (const ui::MenuRenderStats *menuStats = context.uiManager->menuStats())
+            {
+                core::FrameStats &stats = context.frameStats;
+                stats.menuCpuMs = menuStats->cpuMs;
+                stats.menuDrawCalls = menuStats->drawCalls;
+                stats.menuRowsDrawn = menuStats->rowsDrawn;
+                stats.menuRowsTotal = menuStats->rowsTotal;
+            }
         }
     }
 
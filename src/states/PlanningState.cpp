@@ -9,6 +9,8 @@ extern "C"
 }
 
 #include "core/AppContext.h"
+#include "core/FrameProfiler.h"
+#include "gfx/core/RenderState.h"
 #include "mission/MissionController.h"
 #include "systems/FlightSimulationController.h"
 #include "systems/CameraRig.h"
@@ -30,16 +32,18 @@ namespace states
 
     void PlanningState::handleInput(core::AppContext &context)
     {
+        core::ProfileScope profile("PlanningState::handleInput");
         // Planner is 2D: disable depth and forward input/time to UI.
-        glDisable(GL_DEPTH_TEST);
-        if (context.uiManager)
+        gfx::RenderState::setDepthTest(false);
+        if (context.uiManager && context.input)
         {
-            context.uiManager->updatePlanner(context.window, context.deltaTime);
+            context.uiManager->updatePlanner(*context.input, context.deltaTime);
         }
     }
 
     void PlanningState::update(core::AppContext &context)
     {
+        core::ProfileScope profile("PlanningState::update");
         if (!context.uiManager || !context.missionController)
         {
             return;
@@ -92,6 +96,7 @@ namespace states
 
     void PlanningState::render(core::AppContext &context)
     {
+        core::ProfileScope profile("PlanningState::render", core::ProfileTiming::CpuGpu);
         if (context.uiManager)
         {
             context.uiManager->renderPlanner();
@@ -1,9 +1,5 @@
 #include "systems/CameraRig.h"
-
-extern "C"
-{
-#include <GLFW/glfw3.h>
-}
+#include "core/InputSystem.h"
 
 #include <algorithm>
 
@@ -39,44 +35,31 @@ namespace systems
         update(0.0f, planePos, planeOrientation, 0.0f);
     }
 
-    void CameraRig::handleInput(GLFWwindow *window, float dt)
+    void CameraRig::handleInput(const core::InputSystem &input, float dt)
     {
-        if (!window)
-        {
-            return;
-        }
-
-        if (glfwGetKey(window, GLFW_KEY_V) == GLFW_PRESS)
+        if (input.pressed(core::InputAction::CycleCamera))
         {
-            if (!toggleViewPressed_)
+            // Cycle modes: Third -> First -> Cinematic -> Third
+            if (currentMode_ == CameraMode::ThirdPerson)
             {
-                // Cycle modes: Third -> First -> Cinematic -> Third
-                if (currentMode_ == CameraMode::ThirdPerson)
-                {
-                    currentMode_ = CameraMode::FirstPerson;
-                }
-                else if (currentMode_ == CameraMode::FirstPerson)
-                {
-                    currentMode_ = CameraMode::Cinematic;
-                }
-                else
-                {
-                    currentMode_ = CameraMode::ThirdPerson;
-                }
-                toggleViewPressed_ = true;
+                currentMode_ = CameraMode::FirstPerson;
+            }
+            else if (currentMode_ == CameraMode::FirstPerson)
+            {
+                currentMode_ = CameraMode::Cinematic;
+            }
+            else
+            {
+                currentMode_ = CameraMode::ThirdPerson;
             }
-        }
-        else
-        {
-            toggleViewPressed_ = false;
         }
 
         const float kZoomSpeed = 10.0f;
-        if (glfwGetKey(window, GLFW_KEY_Z) == GLFW_PRESS)
+        if (input.down(core::InputAction::ZoomIn))
         {
             cameraDistance_ = glm::clamp(cameraDistance_ - kZoomSpeed * dt, 10.0f, 50.0f);
         }
-        if (glfwGetKey(window, GLFW_KEY_X) == GLFW_PRESS)
+        if (input.down(core::InputAction::ZoomOut))
         {
             cameraDistance_ = glm::clamp(cameraDistance_ + kZoomSpeed * dt, 10.0f, 50.0f);
         }
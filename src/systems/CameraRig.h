@@ -10,7 +10,10 @@
 #include <glm/gtc/quaternion.hpp>
 #include <vector>
 
-struct GLFWwindow;
+namespace core
+{
+    class InputSystem;
+}
 
 namespace systems
 {
@@ -39,7 +42,7 @@ namespace systems
         /**
          * @brief Procesa eventos de teclado (cambio de vista, zoom).
          */
-        void handleInput(GLFWwindow *window, float dt);
+        void handleInput(const core::InputSystem &input, float dt);
         /**
          * @brief Recalcula la posición/orientación de la cámara para este frame.
          */
@@ -78,8 +81,6 @@ namespace systems
         glm::mat4 viewMatrix_ = glm::mat4(1.0f);
         float dynamicFarPlane_ = 5000.0f;
 
-        bool toggleViewPressed_ = false;
-
         // Cinematic mode state
         std::vector<glm::vec3> cinematicPoints_;
         int currentCinematicIndex_ = 0;
@@ -1,17 +1,17 @@
 #include "systems/FlightSimulationController.h"
+#include "core/FrameProfiler.h"
 
 #include <algorithm>
-
-extern "C"
-{
-#include <GLFW/glfw3.h>
-}
-
 #include <cmath>
 
 namespace systems
 {
 
+    namespace
+    {
+        constexpr float kLeverEpsilon = 0.005f; ///< Movimiento mínimo de la palanca para tomar el throttle.
+    }
+
     FlightSimulationController::FlightSimulationController() = default;
 
     void FlightSimulationController::initialize()
@@ -19,6 +19,7 @@ namespace systems
         // Inicializa el solver y obtiene el estado base de la aeronave.
         simulation_.initialize();
         flightData_ = simulation_.getFlightData();
+        flightData_.throttle = filteredThrottle_;
         planePos_ = simulation_.getWorldPosition();
         planeOrientation_ = simulation_.getWorldOrientation();
         planeSpeed_ = simulation_.getTrueAirspeed();
@@ -40,22 +41,135 @@ namespace systems
         planeOrientation_ = simulation_.getWorldOrientation();
         planeSpeed_ = simulation_.getTrueAirspeed();
         flightData_ = simulation_.getFlightData();
+        flightData_.throttle = filteredThrottle_;
+    }
+
+    void FlightSimulationController::handleControls(const core::InputSystem &input)
+    {
+        // Estado al inicio del frame; los cambios se aplican en `step` en su instante.
+        heldControls_ = 0;
+        pendingControls_.clear();
+        for (uint32_t i = 0; i <= static_cast<uint32_t>(core::InputAction::ThrottleDown); ++i)
+        {
+            if (input.downAtStart(static_cast<core::InputAction>(i)))
+            {
+                heldControls_ |= 1u << i;
+            }
+        }
+        for (const core::ActionEvent &event : input.actionEvents())
+        {
+            if (event.action <= core::InputAction::ThrottleDown)
+            {
+                pendingControls_.push_back(event);
+            }
+        }
+        applyStick(input.axesAtStart());
+        pendingAxes_.assign(input.axisEvents().begin(), input.axisEvents().end());
+        pendingWindow_ = input.frameDeltaTime();
+    }
+
+    void FlightSimulationController::step(float dt)
+    {
+        core::ProfileScope profile("FlightSimulationController::step");
+        if (dt <= 0.0f)
+        {
+            return;
+        }
+
+        // Un tramo por cada cambio de mando (tecla o muestra del joystick, mezclados por instante):
+        // dentro de cada tramo los mandos son constantes. Los offsets se miden sobre el frame crudo
+        // y `dt` llega suavizado y recortado por FramePacer, así que se llevan a la misma escala.
+        const float scale = pendingWindow_ > 0.0f ? dt / pendingWindow_ : 1.0f;
+        float elapsed = 0.0f;
+        size_t key = 0;
+        size_t axis = 0;
+        while (key < pendingControls_.size() || axis < pendingAxes_.size())
+        {
+            const bool takeAxis = key == pendingControls_.size() ||
+                                  (axis < pendingAxes_.size() && pendingAxes_[axis].offset < pendingControls_[key].offset);
+            const float offset = takeAxis ? pendingAxes_[axis].offset : pendingControls_[key].offset;
+            const float at = glm::clamp(offset * scale, elapsed, dt);
+            advance(at - elapsed);
+            elapsed = at;
+
+            if (takeAxis)
+            {
+                applyStick(pendingAxes_[axis++].axes);
+            }
+            else
+            {
+                const core::ActionEvent &event = pendingControls_[key++];
+                const uint32_t bit = 1u << static_cast<uint32_t>(event.action);
+                heldControls_ = event.down ? (heldControls_ | bit) : (heldControls_ & ~bit);
+            }
+        }
+        advance(dt - elapsed);
+        pendingControls_.clear();
+        pendingAxes_.clear();
+
+        // Tras avanzar la física, se cachean los valores resultantes.
+        planePos_ = simulation_.getWorldPosition();
+        planeOrientation_ = simulation_.getWorldOrientation();
+        planeSpeed_ = simulation_.getTrueAirspeed();
+        flightData_ = simulation_.getFlightData();
+        flightData_.throttle = filteredThrottle_;
     }
 
-    void FlightSimulationController::handleControls(GLFWwindow *window, float dt)
+    void FlightSimulationController::advance(float dt)
     {
-        // Si no hay ventana o el frame es muy corto, ignorar entrada.
-        if (!window || dt <= 0.0f)
+        if (dt <= 0.0f)
         {
             return;
         }
+        updateJoystick(dt);
+
+        // Suavizado exponencial para evitar saltos en los actuadores.
+        filteredJoystick_.aileron = smoothControlTowards(filteredJoystick_.aileron, joystick_.aileron, responseRates_.roll, dt);
+        filteredJoystick_.elevator = smoothControlTowards(filteredJoystick_.elevator, joystick_.elevator, responseRates_.pitch, dt);
+        filteredJoystick_.rudder = smoothControlTowards(filteredJoystick_.rudder, joystick_.rudder, responseRates_.yaw, dt);
+        filteredThrottle_ = smoothControlTowards(filteredThrottle_, throttleInput_, responseRates_.throttle, dt);
+
+        // Se envían las entradas normalizadas al solver FDM.
+        simulation_.setNormalizedInputs(filteredJoystick_.elevator,
+                                        filteredJoystick_.aileron,
+                                        filteredJoystick_.rudder,
+                                        filteredThrottle_);
+
+        // El acumulador del FDM conserva el resto: cortar el paso no cambia cuántos pasos fijos se dan.
+        simulation_.update(dt);
+    }
+
+    bool FlightSimulationController::held(core::InputAction action) const
+    {
+        return (heldControls_ & (1u << static_cast<uint32_t>(action))) != 0;
+    }
+
+    void FlightSimulationController::applyStick(const core::JoystickAxes &axes)
+    {
+        stick_ = axes;
+        if (axes.throttle >= 0.0f && (lever_ < 0.0f || std::fabs(axes.throttle - lever_) > kLeverEpsilon))
+        {
+            throttleInput_ = glm::clamp(axes.throttle, 0.0f, 1.0f);
+            lever_ = axes.throttle;
+        }
+    }
+
+    void FlightSimulationController::updateJoystick(float dt)
+    {
+        using core::InputAction;
+
+        // El stick físico fuera de su zona muerta fija el eje directamente (ya viene con su curva).
 
         // --- Canal de alabeo (roll) controlado con A/D ---
-        if (glfwGetKey(window, GLFW_KEY_A) == GLFW_PRESS)
+        if (stick_.roll != 0.0f)
+        {
+            joystick_.aileron = stick_.roll;
+        }
+        else if (held(InputAction::RollLeft))
         {
             joystick_.aileron = moveControl(joystick_.aileron, -1.0f, controlFactor_.x, dt);
         }
-        else if (glfwGetKey(window, GLFW_KEY_D) == GLFW_PRESS)
+        else if (held(InputAction::RollRight))
         {
             joystick_.aileron = moveControl(joystick_.aileron, +1.0f, controlFactor_.x, dt);
         }
@@ -65,11 +179,15 @@ namespace systems
         }
 
         // --- Canal de cabeceo (pitch) controlado con W/S ---
-        if (glfwGetKey(window, GLFW_KEY_W) == GLFW_PRESS)
+        if (stick_.pitch != 0.0f)
+        {
+            joystick_.elevator = stick_.pitch;
+        }
+        else if (held(InputAction::PitchUp))
         {
             joystick_.elevator = moveControl(joystick_.elevator, +1.0f, controlFactor_.z, dt);
         }
-        else if (glfwGetKey(window, GLFW_KEY_S) == GLFW_PRESS)
+        else if (held(InputAction::PitchDown))
         {
             joystick_.elevator = moveControl(joystick_.elevator, -1.0f, controlFactor_.z, dt);
         }
@@ -79,11 +197,15 @@ namespace systems
         }
 
         // --- Canal de guiñada (yaw) controlado con Q/E ---
-        if (glfwGetKey(window, GLFW_KEY_Q) == GLFW_PRESS)
+        if (stick_.yaw != 0.0f)
+        {
+            joystick_.rudder = stick_.yaw;
+        }
+        else if (held(InputAction::YawLeft))
         {
             joystick_.rudder = moveControl(joystick_.rudder, +1.0f, controlFactor_.y, dt);
         }
-        else if (glfwGetKey(window, GLFW_KEY_E) == GLFW_PRESS)
+        else if (held(InputAction::YawRight))
         {
             joystick_.rudder = moveControl(joystick_.rudder, -1.0f, controlFactor_.y, dt);
         }
@@ -94,44 +216,16 @@ namespace systems
 
         // --- Throttle, limitado al rango [0,1] y con velocidad fija ---
         const float kThrottleRate = 2.0f;
-        if (glfwGetKey(window, GLFW_KEY_UP) == GLFW_PRESS)
+        if (held(InputAction::ThrottleUp))
         {
             throttleInput_ = glm::clamp(throttleInput_ + kThrottleRate * dt, 0.0f, 1.0f);
         }
-        if (glfwGetKey(window, GLFW_KEY_DOWN) == GLFW_PRESS)
+        if (held(InputAction::ThrottleDown))
         {
             throttleInput_ = glm::clamp(throttleInput_ - kThrottleRate * dt, 0.0f, 1.0f);
         }
     }
 
-    void FlightSimulationController::step(float dt)
-    {
-        if (dt <= 0.0f)
-        {
-            return;
-        }
-
-        // Suavizado exponencial para evitar saltos en los actuadores.
-        filteredJoystick_.aileron = smoothControlTowards(filteredJoystick_.aileron, joystick_.aileron, responseRates_.roll, dt);
-        filteredJoystick_.elevator = smoothControlTowards(filteredJoystick_.elevator, joystick_.elevator, responseRates_.pitch, dt);
-        filteredJoystick_.rudder = smoothControlTowards(filteredJoystick_.rudder, joystick_.rudder, responseRates_.yaw, dt);
-        filteredThrottle_ = smoothControlTowards(filteredThrottle_, throttleInput_, responseRates_.throttle, dt);
-
-        // Se envían las entradas normalizadas al solver FDM.
-        simulation_.setNormalizedInputs(filteredJoystick_.elevator,
-                                        filteredJoystick_.aileron,
-                                        filteredJoystick_.rudder,
-                                        filteredThrottle_);
-
-        simulation_.update(dt);
-
-        // Tras avanzar la física, se cachean los valores resultantes.
-        planePos_ = simulation_.getWorldPosition();
-        planeOrientation_ = simulation_.getWorldOrientation();
-        planeSpeed_ = simulation_.getTrueAirspeed();
-        flightData_ = simulation_.getFlightData();
-    }
-
     void FlightSimulationController::setThrottle(float value)
     {
         // El clamp garantiza que otros sistemas no envíen comandos fuera de rango.
@@ -5,14 +5,16 @@
 
 #pragma once
 
+#include <cstdint>
+#include <vector>
+
 #include <glm/glm.hpp>
 #include <glm/gtc/quaternion.hpp>
 
+#include "core/InputSystem.h"
 #include "flight/data/FlightData.h"
 #include "flight/dlfdm/FdmSimulation.h"
 
-struct GLFWwindow;
-
 namespace systems
 {
 
@@ -21,6 +23,10 @@ namespace systems
      *
      * Lee input de teclado, lo filtra para evitar movimientos bruscos y alimenta
      * al `flight::FdmSimulation`. Expone posición/orientación/telemetría para el HUD.
+     *
+     * Los cambios de mando llegan con su instante dentro del frame: `step` corta
+     * el paso en cada uno, así los pasos de 120 Hz del FDM que caen después de
+     * apretar una tecla ya ven el mando nuevo aunque el frame dure 16 ms o más.
      */
     class FlightSimulationController
     {
@@ -31,9 +37,10 @@ namespace systems
         void initialize();
         /// Reinicia la aeronave para una misión recién cargada.
         void resetForMission();
-        /// Lee teclas por frame y actualiza el joystick virtual.
-        void handleControls(GLFWwindow *window, float dt);
-        /// Avanza el solver un paso y actualiza FlightData.
+        /// Toma el estado de los mandos al inicio del frame y sus cambios durante el frame.
+        void handleControls(const core::InputSystem &input);
+        /// Avanza el solver `dt`, aplicando cada cambio de mando en su instante, y actualiza FlightData.
+        /// `dt` puede diferir del frame crudo (suavizado/recorte): los offsets se escalan a `dt`.
         void step(float dt);
 
         /// Acceso de solo lectura a la telemetría calculada.
@@ -61,6 +68,14 @@ namespace systems
             float rudder = 0.0f;   ///< Entrada de guiñada (yaw).
         };
 
+        /// Rampas del joystick virtual, filtro y solver durante `dt` con los mandos actuales.
+        void advance(float dt);
+        /// Rampas de los ejes según las teclas sostenidas (o la posición del stick).
+        void updateJoystick(float dt);
+        bool held(core::InputAction action) const;
+        /// Nueva posición del stick físico; la palanca solo cuenta si se movió.
+        void applyStick(const core::JoystickAxes &axes);
+
         /// Lleva gradualmente un control hacia el centro (0) con una velocidad dada.
         float centerControl(float value, float factor, float dt);
         /// Aplica un desplazamiento hacia una dirección (-1/+1) respetando límites.
@@ -75,7 +90,7 @@ namespace systems
         glm::quat planeOrientation_ = glm::quat(1.0f, 0.0f, 0.0f, 0.0f); ///< Orientación neutra.
         float planeSpeed_ = 0.0f;                                        ///< Magnitud de velocidad en m/s convertida a kt en HUD.
 
-        VirtualJoystick joystick_{};         ///< Lectura directa del teclado.
+        VirtualJoystick joystick_{};         ///< Lectura directa del teclado o del stick.
         VirtualJoystick filteredJoystick_{}; ///< Señal suavizada que llega al FDM.
 
         glm::vec3 controlFactor_ = glm::vec3(3.0f, 1.0f, 3.0f); ///< Sensibilidad por eje.
@@ -91,6 +106,13 @@ namespace systems
 
         float throttleInput_ = 0.32f;             ///< Potencia normalizada comandada.
         float filteredThrottle_ = throttleInput_; ///< Potencia filtrada que recibe el FDM.
+
+        uint32_t heldControls_ = 0;                      ///< Bit por acción de vuelo (RollLeft..ThrottleDown) sostenida.
+        std::vector<core::ActionEvent> pendingControls_; ///< Cambios de mando del frame, en orden de tiempo.
+        std::vector<core::AxisEvent> pendingAxes_;       ///< Muestras del joystick del frame, en orden de tiempo.
+        float pendingWindow_ = 0.0f;                     ///< Duración cruda del frame a la que se refieren los offsets.
+        core::JoystickAxes stick_{};                     ///< Última posición del stick físico.
+        float lever_ = -1.0f;                            ///< Última posición aplicada de la palanca (<0: ninguna).
     };
 
 } // namespace systems
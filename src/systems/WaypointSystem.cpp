@@ -1,4 +1,5 @@
 #include "systems/WaypointSystem.h"
+#include "core/FrameProfiler.h"
 
 #include <iostream>
 #include <memory>
@@ -11,10 +12,18 @@ extern "C"
 #include <glm/gtc/constants.hpp>
 
 #include "gfx/WaypointRenderer.h"
+#include "gfx/rendering/RenderQueue.h"
 
 namespace systems
 {
 
+    namespace
+    {
+        // Con más pendientes que esto solo se dibujan los cercanos a la cámara
+        constexpr size_t kDrawAllLimit = 256;
+        constexpr float kDrawRadius = 8000.0f; // m
+    } // namespace
+
     WaypointSystem::WaypointSystem() = default;
     WaypointSystem::~WaypointSystem() = default;
 
@@ -28,24 +37,30 @@ namespace systems
     void WaypointSystem::reset()
     {
         // Se limpia el buffer para permitir cargar otra misión
-        waypoints_.clear();
+        names_.clear();
+        tracker_.clear();
     }
 
     void WaypointSystem::loadFromMission(const mission::MissionDefinition &mission)
     {
         reset();
-        waypoints_.reserve(mission.waypoints.size());
+        names_.reserve(mission.waypoints.size());
         for (const auto &wp : mission.waypoints)
         {
-            waypoints_.push_back({wp.position, wp.name, false});
+            names_.push_back(wp.name);
         }
+        tracker_.load(mission.waypoints, mission.waypointOrder);
+        // Una captura por waypoint como mucho: update() no reserva memoria al capturar
+        capturedScratch_.reserve(mission.waypoints.size());
 
         // Mostrar briefing corto en consola para debug/manual
         std::cout << "\n========================================" << std::endl;
         std::cout << "      🎯 " << mission.name << " 🎯" << std::endl;
         std::cout << "========================================" << std::endl;
         std::cout << "Descripción: " << mission.description << std::endl;
-        std::cout << "Waypoints: " << waypoints_.size() << " cargados" << std::endl;
+        std::cout << "Waypoints: " << names_.size() << " cargados"
+                  << (mission.waypointOrder == mission::WaypointOrder::Any ? " (captura en cualquier orden)" : "")
+                  << std::endl;
         std::cout << "Categoría: " << mission.category << std::endl;
         std::cout << "Dificultad: " << mission.difficulty << "/5" << std::endl;
 
@@ -81,40 +96,51 @@ namespace systems
                                 flight::FlightData &flightData,
                                 mission::MissionRuntime &runtime)
     {
-        if (!runtime.areWaypointsEnabled() || waypoints_.empty())
+        if (!runtime.areWaypointsEnabled() || names_.empty())
         {
             flightData.hasActiveWaypoint = false;
             return;
         }
 
-        // Buscar siguiente waypoint no capturado
-        int nextWaypointIndex = -1;
-        for (size_t i = 0; i < waypoints_.size(); ++i)
+        // Captura: el guía en modo secuencial, la grilla (3x3 celdas) en modo Any
+        if (tracker_.update(planePos, capturedScratch_) > 0)
         {
-            if (!waypoints_[i].captured)
+            for (uint32_t index : capturedScratch_)
             {
-                nextWaypointIndex = static_cast<int>(i);
-                break;
+                // Notificar al runtime para métricas
+                runtime.markWaypointCaptured(static_cast<int>(index));
+
+                std::cout << "✓ Waypoint " << names_[index] << " alcanzado! ";
+                if (tracker_.remaining() > 0)
+                {
+                    std::cout << "Waypoints restantes: " << tracker_.remaining() << std::endl;
+                }
+                else
+                {
+                    std::cout << "¡Último waypoint!" << std::endl;
+                }
             }
         }
 
+        int nextWaypointIndex = tracker_.target();
         if (nextWaypointIndex == -1)
         {
-            // Si todos fueron capturados, asegurarse de marcar completion
+            // Si todos fueron capturados, completar (salvo objetivos de disparadores pendientes)
             if (!runtime.isCompleted())
             {
-                runtime.markCompletion();
+                runtime.tryComplete();
             }
             flightData.hasActiveWaypoint = false;
             return;
         }
+        runtime.setActiveWaypointIndex(nextWaypointIndex);
 
-        const auto &currentWaypoint = waypoints_[nextWaypointIndex];
-        flightData.targetWaypoint = currentWaypoint.position;
+        const glm::vec3 &targetPosition = tracker_.position(nextWaypointIndex);
+        flightData.targetWaypoint = targetPosition;
         flightData.hasActiveWaypoint = true;
 
         // Vector hacia el próximo waypoint (se usa en HUD e indicadores)
-        glm::vec3 toWaypoint = currentWaypoint.position - planePos;
+        glm::vec3 toWaypoint = targetPosition - planePos;
         flightData.waypointDistance = glm::length(toWaypoint);
 
         // Calcular bearing proyectando en el plano XZ
@@ -128,80 +154,78 @@ namespace systems
             }
             flightData.waypointBearing = bearing;
         }
-
-        const float kCaptureRadius = 100.0f;
-        if (flightData.waypointDistance < kCaptureRadius)
-        {
-            // Marcar captura local y notificar al runtime para métricas
-            waypoints_[nextWaypointIndex].captured = true;
-            runtime.markWaypointCaptured(nextWaypointIndex);
-
-            // Contar cuántos faltan sólo para log amigable
-            int remaining = 0;
-            for (const auto &wp : waypoints_)
-            {
-                if (!wp.captured)
-                {
-                    remaining++;
-                }
-            }
-
-            std::cout << "✓ Waypoint " << currentWaypoint.name << " alcanzado! ";
-            if (remaining > 0)
-            {
-                std::cout << "Waypoints restantes: " << remaining << std::endl;
-            }
-            else
-            {
-                std::cout << "¡Último waypoint!" << std::endl;
-            }
-        }
     }
 
-    void WaypointSystem::render(const glm::mat4 &view,
-                                const glm::mat4 &projection,
-                                const mission::MissionRuntime &runtime) const
+    void WaypointSystem::submit(gfx::RenderQueue &queue, const mission::MissionRuntime &runtime) const
     {
-        if (!renderer_ || waypoints_.empty() || !runtime.areWaypointsEnabled())
+        core::ProfileScope profile("WaypointSystem::submit");
+        if (!renderer_ || names_.empty() || !runtime.areWaypointsEnabled())
         {
             return;
         }
 
-        glEnable(GL_BLEND);
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        const glm::vec3 eye = queue.view().eye;
+        const GLuint program = renderer_->program();
+        int activeIdx = runtime.getActiveWaypointIndex();
+        auto submitMarker = [&](size_t i)
+        {
+            const uint32_t isActive = static_cast<int>(i) == activeIdx ? 1u : 0u;
+            const float depth = glm::length(tracker_.position(i) - eye);
+            queue.submit(gfx::RenderPass::Transparent, program, 0, depth, &WaypointSystem::drawPacket, this,
+                         static_cast<uint32_t>(i), isActive);
+        };
 
-        for (size_t i = 0; i < waypoints_.size(); ++i)
+        if (tracker_.remaining() <= kDrawAllLimit)
+        {
+            for (size_t i = 0; i < tracker_.size(); ++i)
+            {
+                if (!tracker_.isCaptured(i))
+                {
+                    submitMarker(i);
+                }
+            }
+        }
+        else
         {
-            if (waypoints_[i].captured)
+            // Misiones de relevamiento: solo los pendientes alrededor de la cámara, más el activo
+            tracker_.grid().forEachInRadius(glm::vec2(eye.x, eye.z), kDrawRadius,
+                                            [&](uint32_t i, float)
+                                            {
+                                                if (static_cast<int>(i) != activeIdx)
+                                                {
+                                                    submitMarker(i);
+                                                }
+                                            });
+            if (activeIdx >= 0 && !tracker_.isCaptured(static_cast<size_t>(activeIdx)))
             {
-                continue;
+                submitMarker(static_cast<size_t>(activeIdx));
             }
-
-            int activeIdx = runtime.getActiveWaypointIndex();
-            bool isActive = static_cast<int>(i) == activeIdx;
-            glm::vec4 color = isActive
-                                  ? glm::vec4(0.0f, 1.0f, 0.4f, 0.8f)
-                                  : glm::vec4(0.2f, 0.5f, 1.0f, 0.6f);
-
-            renderer_->drawWaypoint(view, projection, waypoints_[i].position, color, isActive);
         }
+    }
 
-        glDisable(GL_BLEND);
+    void WaypointSystem::drawPacket(const gfx::DrawPacket &packet, const gfx::RenderView &view)
+    {
+        const auto *system = static_cast<const WaypointSystem *>(packet.object);
+        const bool isActive = packet.flags != 0;
+        const glm::vec4 color = isActive
+                                    ? glm::vec4(0.0f, 1.0f, 0.4f, 0.8f)
+                                    : glm::vec4(0.2f, 0.5f, 1.0f, 0.6f);
+        system->renderer_->drawWaypoint(view.view, view.projection, system->tracker_.position(packet.index),
+                                        color, isActive);
     }
 
     void WaypointSystem::skipActiveWaypoint(mission::MissionRuntime &runtime)
     {
         int activeIdx = runtime.getActiveWaypointIndex();
-        if (activeIdx < 0 || activeIdx >= static_cast<int>(waypoints_.size()))
+        if (activeIdx < 0 || activeIdx >= static_cast<int>(names_.size()))
         {
             return;
         }
 
-        if (!waypoints_[activeIdx].captured)
+        if (tracker_.capture(static_cast<size_t>(activeIdx)))
         {
-            waypoints_[activeIdx].captured = true;
             runtime.markWaypointCaptured(activeIdx);
-            std::cout << "Waypoint " << waypoints_[activeIdx].name << " saltado manualmente" << std::endl;
+            std::cout << "Waypoint " << names_[activeIdx] << " saltado manualmente" << std::endl;
         }
     }
 
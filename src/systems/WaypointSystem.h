@@ -14,10 +14,14 @@
 #include "flight/data/FlightData.h"
 #include "mission/MissionDefinition.h"
 #include "mission/MissionRuntime.h"
+#include "mission/WaypointTracker.h"
 
 namespace gfx
 {
     class WaypointRenderer;
+    class RenderQueue;
+    struct DrawPacket;
+    struct RenderView;
 }
 
 namespace systems
@@ -59,29 +63,27 @@ namespace systems
                     mission::MissionRuntime &runtime);
 
         /**
-         * @brief Dibuja los marcadores 3D del waypoint activo (y próximos).
+         * @brief Encola los marcadores 3D del waypoint activo (y próximos).
+         *
+         * Un paquete transparente por marcador: la cola los ordena de atrás hacia
+         * adelante con la cámara de `queue.view()`.
          */
-        void render(const glm::mat4 &view,
-                    const glm::mat4 &projection,
-                    const mission::MissionRuntime &runtime) const;
+        void submit(gfx::RenderQueue &queue, const mission::MissionRuntime &runtime) const;
 
         /**
          * @brief Marca manualmente el waypoint activo como completado.
          */
         void skipActiveWaypoint(mission::MissionRuntime &runtime);
 
-        bool empty() const { return waypoints_.empty(); }
+        bool empty() const { return names_.empty(); }
 
     private:
-        struct WaypointEntry
-        {
-            glm::vec3 position;
-            std::string name;
-            bool captured = false;
-        };
+        static void drawPacket(const gfx::DrawPacket &packet, const gfx::RenderView &view);
 
         std::unique_ptr<gfx::WaypointRenderer> renderer_;
-        std::vector<WaypointEntry> waypoints_;
+        std::vector<std::string> names_;
+        mission::WaypointTracker tracker_; ///< Posiciones, capturas y grilla espacial
+        std::vector<uint32_t> capturedScratch_;
     };
 
 } // namespace systems
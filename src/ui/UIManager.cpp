@@ -1,4 +1,5 @@
 #include "ui/UIManager.h"
+#include "core/FrameProfiler.h"
 
 #include <stdexcept>
 
@@ -31,6 +32,10 @@ namespace ui
         overlay_ = std::make_unique<ui::MissionOverlay>();
         overlay_->init(width, height);
 
+        // Profiler table stays hidden until toggled (F3)
+        profiler_ = std::make_unique<ui::ProfilerOverlay>();
+        profiler_->init(width, height);
+
         return true;
     }
 
@@ -57,19 +62,48 @@ namespace ui
         {
             overlay_->setScreenSize(width, height);
         }
+        if (profiler_)
+        {
+            profiler_->setScreenSize(width, height);
+        }
+    }
+
+    void UIManager::setFrameArena(core::FrameArena *arena)
+    {
+        if (planner_)
+        {
+            planner_->setFrameArena(arena);
+        }
+        if (overlay_)
+        {
+            overlay_->setFrameArena(arena);
+        }
+    }
+
+    void UIManager::setJobPool(core::JobPool *jobPool)
+    {
+        if (hud_)
+        {
+            hud_->setJobPool(jobPool);
+        }
+        if (planner_)
+        {
+            planner_->setJobPool(jobPool);
+        }
     }
 
-    void UIManager::updateMenu(GLFWwindow *window, float dt)
+    void UIManager::updateMenu(const core::InputSystem &input, float dt)
     {
         // Forward input and time delta to selection menu
         if (menu_)
         {
-            menu_->update(window, dt);
+            menu_->update(input, dt);
         }
     }
 
     void UIManager::renderMenu()
     {
+        core::ProfileScope profile("UIManager::renderMenu", core::ProfileTiming::CpuGpu);
         // Menu uses its own Renderer2D, just need to trigger draw call
         if (menu_)
         {
@@ -96,6 +130,15 @@ namespace ui
         }
     }
 
+    void UIManager::refreshMenu()
+    {
+        // Mission catalog was replaced (hot reload): rebuild the visible list
+        if (menu_)
+        {
+            menu_->refresh();
+        }
+    }
+
     void UIManager::preselectMission(int index)
     {
         // Allows marking a mission when coming from planner or other flow
@@ -105,17 +148,18 @@ namespace ui
         }
     }
 
-    void UIManager::updatePlanner(GLFWwindow *window, float dt)
+    void UIManager::updatePlanner(const core::InputSystem &input, float dt)
     {
         // Planner responds to input for waypoint manipulation
         if (planner_)
         {
-            planner_->update(window, dt);
+            planner_->update(input, dt);
         }
     }
 
     void UIManager::renderPlanner()
     {
+        core::ProfileScope profile("UIManager::renderPlanner", core::ProfileTiming::CpuGpu);
         // Draws map, waypoints, and additional UI
         if (planner_)
         {
@@ -170,12 +214,12 @@ namespace ui
         }
     }
 
-    bool UIManager::handleOverlayInput(GLFWwindow *window)
+    bool UIManager::handleOverlayInput(const core::InputSystem &input)
     {
         // Handles clicks/keys when overlay is visible
         if (overlay_)
         {
-            return overlay_->handleInput(window);
+            return overlay_->handleInput(input);
         }
         return false;
     }
@@ -237,6 +281,7 @@ namespace ui
 
     void UIManager::renderOverlay()
     {
+        core::ProfileScope profile("UIManager::renderOverlay", core::ProfileTiming::CpuGpu);
         // Draws semi-transparent panels over 3D scene
         if (overlay_)
         {
@@ -262,4 +307,26 @@ namespace ui
         }
     }
 
+    void UIManager::toggleProfiler()
+    {
+        if (profiler_)
+        {
+            profiler_->setVisible(!profiler_->isVisible());
+        }
+    }
+
+    bool UIManager::isProfilerVisible() const
+    {
+        return profiler_ && profiler_->isVisible();
+    }
+
+    void UIManager::renderProfiler(const core::FrameStats &stats)
+    {
+        // Debug table over everything the state drew
+        if (profiler_)
+        {
+            profiler_->render(stats);
+        }
+    }
+
 } // namespace ui
@@ -11,9 +11,13 @@
 #include "ui/menu/MissionMenu.h"
 #include "ui/menu/MissionPlanner.h"
 #include "ui/overlay/MissionOverlay.h"
+#include "ui/overlay/ProfilerOverlay.h"
 #include "flight/data/FlightData.h"
 
-struct GLFWwindow;
+namespace core
+{
+    class InputSystem;
+}
 
 namespace mission
 {
@@ -34,6 +38,7 @@ namespace ui
      * - Mission selection menu
      * - Route planner (MissionPlanner)
      * - In-game overlay (briefing/completion)
+ * - Frame profiler table (debug)
      *
      * Exposes separate update/render methods per subsystem so each game state
      * invokes only what it needs.
@@ -54,15 +59,27 @@ namespace ui
          */
         void resize(int width, int height);
 
+        /**
+         * @brief Shares the per-frame scratch arena with the panels that build transient text.
+         */
+        void setFrameArena(core::FrameArena *arena);
+
+        /**
+         * @brief Shares the application job pool with the HUD recorder and the route optimizer.
+         */
+        void setJobPool(core::JobPool *jobPool);
+
         // ============================ MAIN MENU ============================
-        void updateMenu(GLFWwindow *window, float dt);
+        void updateMenu(const core::InputSystem &input, float dt);
         void renderMenu();
         ui::MenuResult getMenuResult() const;
         void resetMenu();
+        void refreshMenu();
+        const ui::MenuRenderStats *menuStats() const { return menu_ ? &menu_->stats() : nullptr; }
         void preselectMission(int index);
 
         // ============================ PLANNER ==============================
-        void updatePlanner(GLFWwindow *window, float dt);
+        void updatePlanner(const core::InputSystem &input, float dt);
         void renderPlanner();
         ui::PlannerResult getPlannerResult() const;
         void resetPlanner();
@@ -71,7 +88,7 @@ namespace ui
 
         // ============================== OVERLAY =================================
         void updateOverlay(float dt);
-        bool handleOverlayInput(GLFWwindow *window);
+        bool handleOverlayInput(const core::InputSystem &input);
         bool isOverlayVisible() const;
         bool overlayReadyToFly() const;
         ui::CompletionChoice overlayChoice() const;
@@ -86,12 +103,18 @@ namespace ui
         void updateHUD(const flight::FlightData &data);
         void renderHUD();
 
+        // ============================== PROFILER ================================
+        void toggleProfiler();
+        bool isProfilerVisible() const;
+        void renderProfiler(const core::FrameStats &stats);
+
     private:
         // Owners of each interface layer
         std::unique_ptr<hud::FlightHUD> hud_;
         std::unique_ptr<ui::MissionMenu> menu_;
         std::unique_ptr<ui::MissionPlanner> planner_;
         std::unique_ptr<ui::MissionOverlay> overlay_;
+        std::unique_ptr<ui::ProfilerOverlay> profiler_;
 
         // External dependencies and layout parameters
         mission::MissionRegistry *registry_ = nullptr;
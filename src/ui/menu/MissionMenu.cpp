@@ -4,8 +4,14 @@
  */
 
 #include "MissionMenu.h"
+#include "../../gfx/core/GLStats.h"
+#include "../../gfx/core/RenderState.h"
+#include "../../core/InputSystem.h"
 #include <iostream>
 #include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <iomanip>
 
 extern "C"
 {
@@ -15,15 +21,30 @@ extern "C"
 namespace ui
 {
 
+    namespace
+    {
+        const float LIST_ITEM_HEIGHT = 90.0f;
+        const float LIST_PADDING = 15.0f;
+
+        const char *sortLabel(mission::MissionSort sort)
+        {
+            switch (sort)
+            {
+            case mission::MissionSort::Name:
+                return "NAME";
+            case mission::MissionSort::Length:
+                return "LENGTH";
+            default:
+                return "CATALOG";
+            }
+        }
+    } // namespace
+
     MissionMenu::MissionMenu()
         : registry_(nullptr),
           screenWidth_(1280),
           screenHeight_(720),
-          selectedIndex_(0),
-          enterKeyPressed_(false),
-          escKeyPressed_(false),
-          upKeyPressed_(false),
-          downKeyPressed_(false)
+          selectedIndex_(0)
     {
     }
 
@@ -33,6 +54,7 @@ namespace ui
         screenWidth_ = screenWidth;
         screenHeight_ = screenHeight;
         selectedIndex_ = 0;
+        rowsDirty_ = true;
 
         renderer2D_.init(screenWidth, screenHeight);
 
@@ -47,100 +69,231 @@ namespace ui
         std::cout << "✓ MissionMenu initialized" << std::endl;
     }
 
-    void MissionMenu::update(GLFWwindow *window, float deltaTime)
+    void MissionMenu::update(const core::InputSystem &input, float deltaTime)
     {
-        handleInput(window);
+        handleInput(input);
     }
 
-    void MissionMenu::handleInput(GLFWwindow *window)
+    void MissionMenu::handleInput(const core::InputSystem &input)
     {
+        using core::InputAction;
+
         if (!registry_ || registry_->getMissionCount() == 0)
         {
             return;
         }
+        if (rowsDirty_ || registry_->getMissionCount() != rowsSourceCount_)
+        {
+            rebuildRows();
+        }
 
-        // Navigation up/down
-        bool upKeyCurrentlyPressed = (glfwGetKey(window, GLFW_KEY_UP) == GLFW_PRESS ||
-                                      glfwGetKey(window, GLFW_KEY_W) == GLFW_PRESS);
-        bool downKeyCurrentlyPressed = (glfwGetKey(window, GLFW_KEY_DOWN) == GLFW_PRESS ||
-                                        glfwGetKey(window, GLFW_KEY_S) == GLFW_PRESS);
+        const int rowCount = static_cast<int>(rows_.size());
+        const int pageRows = listLayout().rowsPerPage;
 
-        if (upKeyCurrentlyPressed && !upKeyPressed_)
+        // Navigation up/down
+        if (input.pressed(InputAction::MenuUp) && rowCount > 0)
         {
-            selectedIndex_--;
-            if (selectedIndex_ < 0)
-            {
-                selectedIndex_ = static_cast<int>(registry_->getMissionCount()) - 1;
-            }
-            upKeyPressed_ = true;
+            moveCursor(cursor_ > 0 ? cursor_ - 1 : rowCount - 1);
         }
-        else if (!upKeyCurrentlyPressed)
+        if (input.pressed(InputAction::MenuDown) && rowCount > 0)
         {
-            upKeyPressed_ = false;
+            moveCursor(cursor_ + 1 < rowCount ? cursor_ + 1 : 0);
         }
 
-        if (downKeyCurrentlyPressed && !downKeyPressed_)
+        // Pages and ends of the list
+        if (input.pressed(InputAction::PageUp))
+            moveCursor(cursor_ - pageRows);
+        if (input.pressed(InputAction::PageDown))
+            moveCursor(cursor_ + pageRows);
+        if (input.pressed(InputAction::ListHome))
+            moveCursor(0);
+        if (input.pressed(InputAction::ListEnd))
+            moveCursor(rowCount - 1);
+
+        // Filters: C cycles category, D cycles difficulty, O cycles sort order
+        if (input.pressed(InputAction::FilterCategory))
         {
-            selectedIndex_++;
-            if (selectedIndex_ >= static_cast<int>(registry_->getMissionCount()))
-            {
-                selectedIndex_ = 0;
-            }
-            downKeyPressed_ = true;
+            const auto &categories = registry_->getCategories();
+            categoryFilter_ = (categoryFilter_ + 1 < static_cast<int>(categories.size())) ? categoryFilter_ + 1 : -1;
+            categoryName_ = categoryFilter_ >= 0 ? std::string(categories[categoryFilter_]) : std::string();
+            query_.category = categoryName_;
+            rebuildRows();
         }
-        else if (!downKeyCurrentlyPressed)
+        if (input.pressed(InputAction::FilterDifficulty))
         {
-            downKeyPressed_ = false;
+            query_.difficulty = (query_.difficulty + 1) % 6; // 0 = any, 1..5
+            rebuildRows();
+        }
+        if (input.pressed(InputAction::CycleSort))
+        {
+            query_.sort = query_.sort == mission::MissionSort::Catalog ? mission::MissionSort::Name
+                          : query_.sort == mission::MissionSort::Name  ? mission::MissionSort::Length
+                                                                       : mission::MissionSort::Catalog;
+            rebuildRows();
         }
 
-        // Selection (Enter or Space)
-        bool enterCurrentlyPressed = (glfwGetKey(window, GLFW_KEY_ENTER) == GLFW_PRESS ||
-                                      glfwGetKey(window, GLFW_KEY_SPACE) == GLFW_PRESS);
+        // Benchmark runs from render(), where the GL context is drawing the menu
+        if (input.pressed(InputAction::Benchmark))
+        {
+            benchmarkRequested_ = true;
+        }
 
-        if (enterCurrentlyPressed && !enterKeyPressed_)
+        // Selection (Enter or Space)
+        if (input.pressed(InputAction::MenuSelect) && selectedIndex_ >= 0)
         {
             result_.missionSelected = true;
             result_.selectedMissionIndex = selectedIndex_;
-            enterKeyPressed_ = true;
             std::cout << "Mission selected: " << selectedIndex_ << std::endl;
         }
-        else if (!enterCurrentlyPressed)
+
+        // Exit (ESC)
+        if (input.pressed(InputAction::Back))
         {
-            enterKeyPressed_ = false;
+            result_.exitRequested = true;
         }
+    }
 
-        // Exit (ESC)
-        bool escCurrentlyPressed = (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS);
+    MissionMenu::ListLayout MissionMenu::listLayout() const
+    {
+        // Mission list panel - larger and centered
+        ListLayout layout;
+        layout.x = screenWidth_ * 0.15f;
+        layout.y = screenHeight_ * 0.18f;
+        layout.width = screenWidth_ * 0.70f;
+        layout.height = screenHeight_ * 0.65f;
+        layout.itemHeight = LIST_ITEM_HEIGHT;
+        layout.rowsPerPage = std::max(1, static_cast<int>((layout.height - LIST_PADDING) / LIST_ITEM_HEIGHT));
+        return layout;
+    }
 
-        if (escCurrentlyPressed && !escKeyPressed_)
+    void MissionMenu::rebuildRows()
+    {
+        rowsDirty_ = false;
+        if (!registry_)
         {
-            result_.exitRequested = true;
-            escKeyPressed_ = true;
+            rows_.clear();
+            return;
         }
-        else if (!escCurrentlyPressed)
+
+        rowsSourceCount_ = registry_->getMissionCount();
+        registry_->query(query_, rows_);
+
+        // Keep the highlighted mission if it still matches the filter
+        auto it = std::find(rows_.begin(), rows_.end(), static_cast<uint32_t>(std::max(selectedIndex_, 0)));
+        firstRow_ = 0;
+        moveCursor(it != rows_.end() ? static_cast<int>(it - rows_.begin()) : 0);
+    }
+
+    void MissionMenu::moveCursor(int position)
+    {
+        const int rowCount = static_cast<int>(rows_.size());
+        if (rowCount == 0)
         {
-            escKeyPressed_ = false;
+            cursor_ = 0;
+            firstRow_ = 0;
+            selectedIndex_ = -1;
+            return;
         }
+
+        cursor_ = std::clamp(position, 0, rowCount - 1);
+        selectedIndex_ = static_cast<int>(rows_[cursor_]);
+
+        // Scroll just enough to keep the cursor on the visible page
+        const int pageRows = listLayout().rowsPerPage;
+        if (cursor_ < firstRow_)
+            firstRow_ = cursor_;
+        else if (cursor_ >= firstRow_ + pageRows)
+            firstRow_ = cursor_ - pageRows + 1;
+        firstRow_ = std::clamp(firstRow_, 0, std::max(0, rowCount - pageRows));
     }
 
     void MissionMenu::render()
     {
-        glEnable(GL_BLEND);
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        auto start = std::chrono::steady_clock::now();
+
+        renderFrame(false);
+
+        stats_.cpuMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+        stats_.drawCalls = renderer2D_.drawCalls();
+        stats_.uploadBytes = renderer2D_.uploadedBytes();
+
+        if (benchmarkRequested_)
+        {
+            benchmarkRequested_ = false;
+            benchmarkRender();
+        }
+    }
+
+    void MissionMenu::renderFrame(bool layoutAllRows)
+    {
+        if (registry_ && (rowsDirty_ || registry_->getMissionCount() != rowsSourceCount_))
+        {
+            rebuildRows();
+        }
+
+        gfx::RenderState::setBlend(true);
+        gfx::RenderState::setBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
         renderer2D_.begin();
 
         renderBackground();
         renderTitle();
-        renderMissionList();
+        renderMissionList(layoutAllRows);
         renderMissionDetails();
         renderInstructions();
 
         renderer2D_.end();
-        glDisable(GL_BLEND);
+        gfx::RenderState::setBlend(false);
         // flush() is already called by end() internally
     }
 
+    void MissionMenu::benchmarkRender(int frames)
+    {
+        if (frames <= 0 || !registry_)
+            return;
+
+        std::cout << std::fixed << std::setprecision(3)
+                  << "[MissionMenu] Frame time, " << registry_->getMissionCount() << " missions ("
+                  << rows_.size() << " listed):" << std::endl;
+
+        for (bool layoutAllRows : {false, true})
+        {
+            // Laying out every row costs ~4 text draws per mission; keep that pass short
+            int count = layoutAllRows ? std::max(1, frames / 20) : frames;
+            renderFrame(layoutAllRows); // warm-up
+            glFinish();
+
+            double cpuMs = 0.0;
+            const gfx::GLCallCounters glStart = gfx::GLStats::snapshot();
+            auto start = std::chrono::steady_clock::now();
+            for (int frame = 0; frame < count; ++frame)
+            {
+                auto cpuStart = std::chrono::steady_clock::now();
+                renderFrame(layoutAllRows);
+                cpuMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - cpuStart).count();
+                glFinish();
+            }
+            double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / count;
+
+            std::cout << "  " << (layoutAllRows ? "full list:   " : "virtualized: ") << ms << " ms/frame ("
+                      << cpuMs / count << " ms CPU), " << stats_.rowsDrawn << " rows, "
+                      << renderer2D_.drawCalls() << " draw calls" << std::endl;
+            if (gfx::GLStats::enabled())
+            {
+                const gfx::GLCallCounters gl = gfx::GLStats::snapshot() - glStart;
+                std::cout << "    GL per frame: " << gl.drawCalls / count << " draws, " << gl.vertices / count
+                          << " vertices, " << gl.bufferBytes / count << " bytes, "
+                          << (gl.textureBinds + gl.programBinds + gl.vaoBinds) / count << " binds ("
+                          << gl.redundantBinds / count << " redundant), " << gl.uniformUploads / count
+                          << " uniforms" << std::endl;
+            }
+        }
+        std::cout << std::defaultfloat;
+
+        // Leave the regular frame in the back buffer and its stats in stats_
+        renderFrame(false);
+    }
+
     void MissionMenu::renderBackground()
     {
         // Dark gradient background
@@ -176,130 +329,172 @@ namespace ui
                      glm::vec4(0.3f, 0.8f, 1.0f, 1.0f), glm::vec2(0.5f, 0.5f));
     }
 
-    void MissionMenu::renderMissionList()
+    void MissionMenu::renderMissionList(bool layoutAllRows)
     {
+        stats_.rowsDrawn = 0;
+        stats_.rowsTotal = rows_.size();
         if (!registry_ || registry_->getMissionCount() == 0)
         {
             return;
         }
 
-        // Mission list panel - larger and centered
-        float listX = screenWidth_ * 0.15f;
-        float listY = screenHeight_ * 0.18f;
-        float listWidth = screenWidth_ * 0.70f;
-        float itemHeight = 90.0f;
-        float panelHeight = screenHeight_ * 0.65f;
+        const ListLayout layout = listLayout();
 
         // Panel background with border
-        renderer2D_.drawRect(glm::vec2(listX, listY),
-                             glm::vec2(listWidth, panelHeight),
+        renderer2D_.drawRect(glm::vec2(layout.x, layout.y),
+                             glm::vec2(layout.width, layout.height),
                              glm::vec4(0.06f, 0.09f, 0.14f, 0.95f), true);
-        renderer2D_.drawRect(glm::vec2(listX, listY),
-                             glm::vec2(listWidth, panelHeight),
+        renderer2D_.drawRect(glm::vec2(layout.x, layout.y),
+                             glm::vec2(layout.width, layout.height),
                              glm::vec4(0.15f, 0.4f, 0.7f, 0.5f), false);
 
-        // Render each mission
-        float itemY = listY + 15.0f;
-        size_t missionCount = registry_->getMissionCount();
+        if (rows_.empty())
+        {
+            drawMenuText("NO MISSIONS MATCH THE FILTER",
+                         glm::vec2(layout.x + layout.width * 0.5f, layout.y + layout.height * 0.5f),
+                         20.0f, glm::vec4(0.6f, 0.7f, 0.85f, 1.0f), glm::vec2(0.5f, 0.5f));
+            return;
+        }
 
-        for (size_t i = 0; i < missionCount; ++i)
+        // Only the visible page is laid out. The benchmark can lay out every
+        // row instead (clipped to the panel) to show what virtualization saves.
+        size_t first = static_cast<size_t>(firstRow_);
+        size_t last = std::min(rows_.size(), first + static_cast<size_t>(layout.rowsPerPage));
+        if (layoutAllRows)
         {
-            const mission::MissionDefinition *mission = registry_->getMissionByIndex(i);
-            if (!mission)
-                continue;
+            renderer2D_.flush();
+            glEnable(GL_SCISSOR_TEST);
+            glScissor(static_cast<GLint>(layout.x), static_cast<GLint>(screenHeight_ - layout.y - layout.height),
+                      static_cast<GLsizei>(layout.width), static_cast<GLsizei>(layout.height));
+            first = 0;
+            last = rows_.size();
+        }
 
-            bool isSelected = (static_cast<int>(i) == selectedIndex_);
+        for (size_t row = first; row < last; ++row)
+        {
+            float itemY = layout.y + LIST_PADDING + (static_cast<float>(row) - firstRow_) * layout.itemHeight;
+            renderMissionRow(rows_[row], itemY, layout);
+        }
+        stats_.rowsDrawn = last - first;
 
-            // Item container
-            float itemX = listX + 15.0f;
-            float itemW = listWidth - 30.0f;
+        if (layoutAllRows)
+        {
+            renderer2D_.flush();
+            glDisable(GL_SCISSOR_TEST);
+        }
 
-            // Item background with visual gradient
-            if (isSelected)
-            {
-                // Selected item - highlighted
-                renderer2D_.drawRect(glm::vec2(itemX, itemY),
-                                     glm::vec2(itemW, itemHeight - 5),
-                                     glm::vec4(0.15f, 0.45f, 0.75f, 0.9f), true);
-                // Bright border
-                renderer2D_.drawRect(glm::vec2(itemX, itemY),
-                                     glm::vec2(itemW, itemHeight - 5),
-                                     glm::vec4(0.3f, 0.8f, 1.0f, 1.0f), false);
-                // Selection sidebar
-                renderer2D_.drawRect(glm::vec2(itemX, itemY),
-                                     glm::vec2(6, itemHeight - 5),
-                                     glm::vec4(0.2f, 0.9f, 0.4f, 1.0f), true);
-            }
-            else
-            {
-                renderer2D_.drawRect(glm::vec2(itemX, itemY),
-                                     glm::vec2(itemW, itemHeight - 5),
-                                     glm::vec4(0.08f, 0.12f, 0.18f, 0.7f), true);
-            }
+        renderScrollbar(layout);
+    }
 
-            // Mission number (large and visible)
-            std::string numStr = std::to_string(i + 1);
-            glm::vec4 numColor = isSelected ? glm::vec4(1.0f, 1.0f, 0.3f, 1.0f) : glm::vec4(0.4f, 0.6f, 0.8f, 1.0f);
-            drawMenuText(numStr,
-                         glm::vec2(itemX + 32.0f, itemY + (itemHeight - 5) * 0.45f),
-                         30.0f, numColor, glm::vec2(0.0f, 0.5f));
+    void MissionMenu::renderMissionRow(uint32_t missionIndex, float itemY, const ListLayout &layout)
+    {
+        const float itemHeight = layout.itemHeight;
 
-            // Mission name (more readable)
-            glm::vec4 textColor = isSelected ? glm::vec4(1.0f, 1.0f, 1.0f, 1.0f) : glm::vec4(0.75f, 0.8f, 0.9f, 1.0f);
+        // Summary only: with a mission pack, definitions are built when selected
+        mission::MissionSummary mission = registry_->getMissionSummary(missionIndex);
 
-            // Truncate name if too long
-            std::string displayName = mission->name;
-            if (displayName.length() > 25)
-            {
-                displayName = displayName.substr(0, 22) + "...";
-            }
+        bool isSelected = (static_cast<int>(missionIndex) == selectedIndex_);
 
-            drawMenuText(displayName,
-                         glm::vec2(itemX + 80.0f, itemY + 24.0f),
-                         20.0f, textColor, glm::vec2(0.0f, 0.5f));
+        // Item container
+        float itemX = layout.x + LIST_PADDING;
+        float itemW = layout.width - 2.0f * LIST_PADDING;
 
-            // Visual difficulty indicators (stars as bars)
-            float starX = itemX + 80;
-            float starY = itemY + 48;
-            for (int d = 0; d < 5; ++d)
-            {
-                glm::vec4 starColor = (d < mission->difficulty) ? glm::vec4(1.0f, 0.7f, 0.0f, 1.0f) : glm::vec4(0.2f, 0.2f, 0.3f, 0.5f);
-                renderer2D_.drawRect(glm::vec2(starX + d * 18, starY),
-                                     glm::vec2(14, 8),
-                                     starColor, true);
-            }
+        // Item background with visual gradient
+        if (isSelected)
+        {
+            // Selected item - highlighted
+            renderer2D_.drawRect(glm::vec2(itemX, itemY),
+                                 glm::vec2(itemW, itemHeight - 5),
+                                 glm::vec4(0.15f, 0.45f, 0.75f, 0.9f), true);
+            // Bright border
+            renderer2D_.drawRect(glm::vec2(itemX, itemY),
+                                 glm::vec2(itemW, itemHeight - 5),
+                                 glm::vec4(0.3f, 0.8f, 1.0f, 1.0f), false);
+            // Selection sidebar
+            renderer2D_.drawRect(glm::vec2(itemX, itemY),
+                                 glm::vec2(6, itemHeight - 5),
+                                 glm::vec4(0.2f, 0.9f, 0.4f, 1.0f), true);
+        }
+        else
+        {
+            renderer2D_.drawRect(glm::vec2(itemX, itemY),
+                                 glm::vec2(itemW, itemHeight - 5),
+                                 glm::vec4(0.08f, 0.12f, 0.18f, 0.7f), true);
+        }
+
+        // Mission number (large and visible)
+        std::string numStr = std::to_string(missionIndex + 1);
+        glm::vec4 numColor = isSelected ? glm::vec4(1.0f, 1.0f, 0.3f, 1.0f) : glm::vec4(0.4f, 0.6f, 0.8f, 1.0f);
+        drawMenuText(numStr,
+                     glm::vec2(itemX + 32.0f, itemY + (itemHeight - 5) * 0.45f),
+                     30.0f, numColor, glm::vec2(0.0f, 0.5f));
 
-            // Waypoints count (visual)
-            float wpX = itemX + itemW - 100;
-            drawMenuText(std::to_string(mission->waypoints.size()),
-                         glm::vec2(wpX, itemY + 32.0f),
-                         22.0f, glm::vec4(0.3f, 0.9f, 0.5f, 1.0f), glm::vec2(0.0f, 0.5f));
+        // Mission name (more readable)
+        glm::vec4 textColor = isSelected ? glm::vec4(1.0f, 1.0f, 1.0f, 1.0f) : glm::vec4(0.75f, 0.8f, 0.9f, 1.0f);
 
-            // Label "WP"
-            drawMenuText("WP",
-                         glm::vec2(wpX + 38.0f, itemY + 32.0f),
-                         16.0f, glm::vec4(0.5f, 0.7f, 0.5f, 0.85f), glm::vec2(0.0f, 0.5f));
+        // Truncate name if too long
+        std::string displayName(mission.name);
+        if (displayName.length() > 25)
+        {
+            displayName = displayName.substr(0, 22) + "...";
+        }
 
-            itemY += itemHeight;
+        drawMenuText(displayName,
+                     glm::vec2(itemX + 80.0f, itemY + 24.0f),
+                     20.0f, textColor, glm::vec2(0.0f, 0.5f));
 
-            // Limit visible amount
-            if (itemY > listY + panelHeight - 20)
-                break;
+        // Visual difficulty indicators (stars as bars)
+        float starX = itemX + 80;
+        float starY = itemY + 48;
+        for (int d = 0; d < 5; ++d)
+        {
+            glm::vec4 starColor = (d < mission.difficulty) ? glm::vec4(1.0f, 0.7f, 0.0f, 1.0f) : glm::vec4(0.2f, 0.2f, 0.3f, 0.5f);
+            renderer2D_.drawRect(glm::vec2(starX + d * 18, starY),
+                                 glm::vec2(14, 8),
+                                 starColor, true);
         }
+
+        // Waypoints count (visual)
+        float wpX = itemX + itemW - 100;
+        drawMenuText(std::to_string(mission.waypointCount),
+                     glm::vec2(wpX, itemY + 32.0f),
+                     22.0f, glm::vec4(0.3f, 0.9f, 0.5f, 1.0f), glm::vec2(0.0f, 0.5f));
+
+        // Label "WP"
+        drawMenuText("WP",
+                     glm::vec2(wpX + 38.0f, itemY + 32.0f),
+                     16.0f, glm::vec4(0.5f, 0.7f, 0.5f, 0.85f), glm::vec2(0.0f, 0.5f));
     }
 
-    void MissionMenu::renderMissionDetails()
+    void MissionMenu::renderScrollbar(const ListLayout &layout)
     {
-        // Details panel moved down as banner
-        if (!registry_ || selectedIndex_ < 0 ||
-            selectedIndex_ >= static_cast<int>(registry_->getMissionCount()))
+        const size_t rowCount = rows_.size();
+        if (rowCount <= static_cast<size_t>(layout.rowsPerPage))
         {
             return;
         }
 
-        const mission::MissionDefinition *mission = registry_->getMissionByIndex(selectedIndex_);
-        if (!mission)
+        // Thin track in the right margin; the thumb covers the visible page
+        float trackX = layout.x + layout.width - LIST_PADDING * 0.5f - 2.0f;
+        float trackY = layout.y + LIST_PADDING;
+        float trackH = layout.height - 2.0f * LIST_PADDING;
+        float visible = static_cast<float>(layout.rowsPerPage) / rowCount;
+        float thumbH = std::max(16.0f, trackH * visible);
+        float scroll = static_cast<float>(firstRow_) / (rowCount - layout.rowsPerPage);
+
+        renderer2D_.drawRect(glm::vec2(trackX, trackY), glm::vec2(4.0f, trackH),
+                             glm::vec4(0.1f, 0.15f, 0.22f, 0.8f), true);
+        renderer2D_.drawRect(glm::vec2(trackX, trackY + (trackH - thumbH) * scroll), glm::vec2(4.0f, thumbH),
+                             glm::vec4(0.3f, 0.7f, 1.0f, 0.9f), true);
+    }
+
+    void MissionMenu::renderMissionDetails()
+    {
+        // Details panel moved down as banner
+        if (!registry_ || registry_->getMissionCount() == 0)
+        {
             return;
+        }
 
         // Bottom banner with selected mission info
         float bannerHeight = 50.0f;
@@ -314,6 +509,26 @@ namespace ui
                              glm::vec2(screenWidth_, 2),
                              glm::vec4(0.2f, 0.6f, 1.0f, 0.8f), true);
 
+        // Filter, sort order and page of the virtualized list
+        const int pageRows = listLayout().rowsPerPage;
+        const int pageCount = std::max(1, (static_cast<int>(rows_.size()) + pageRows - 1) / pageRows);
+        std::string category = query_.category.empty() ? std::string("ALL") : std::string(query_.category);
+        std::transform(category.begin(), category.end(), category.begin(),
+                       [](unsigned char c)
+                       { return static_cast<char>(std::toupper(c)); });
+        std::string status = "CAT " + category +
+                             "   DIFF " + (query_.difficulty > 0 ? std::to_string(query_.difficulty) : std::string("ANY")) +
+                             "   SORT " + sortLabel(query_.sort) +
+                             "   PAGE " + std::to_string(cursor_ / pageRows + 1) + "/" + std::to_string(pageCount) +
+                             "   " + std::to_string(rows_.size()) + " MISSIONS";
+        drawMenuText(status, glm::vec2(30.0f, bannerY + bannerHeight * 0.5f),
+                     16.0f, glm::vec4(0.7f, 0.8f, 0.95f, 1.0f), glm::vec2(0.0f, 0.5f));
+
+        if (selectedIndex_ < 0 || !registry_->getMissionByIndex(selectedIndex_))
+        {
+            return;
+        }
+
         // ENTER button - highlighted
         float btnW = 180.0f;
         float btnH = 35.0f;
@@ -344,7 +559,7 @@ namespace ui
 
         // Simplified instructions with visual indicators
         float xPos = screenWidth_ * 0.5f;
-        drawMenuText("W/S NAVIGATE    ENTER START    ESC EXIT",
+        drawMenuText("W/S NAVIGATE   PGUP/PGDN PAGE   C/D/O FILTER   ENTER START   ESC EXIT",
                      glm::vec2(xPos, instrY + 12.0f),
                      18.0f, glm::vec4(0.7f, 0.8f, 0.95f, 1.0f), glm::vec2(0.5f, 0.5f));
     }
@@ -407,8 +622,6 @@ namespace ui
         result_.missionSelected = false;
         result_.exitRequested = false;
         result_.selectedMissionIndex = -1;
-        enterKeyPressed_ = false;
-        escKeyPressed_ = false;
     }
 
     void MissionMenu::setScreenSize(int width, int height)
@@ -416,6 +629,10 @@ namespace ui
         screenWidth_ = width;
         screenHeight_ = height;
         renderer2D_.setScreenSize(width, height);
+        if (!rowsDirty_)
+        {
+            moveCursor(cursor_); // rows per page depend on the height
+        }
     }
 
     void MissionMenu::preselectMission(int index)
@@ -423,7 +640,28 @@ namespace ui
         if (registry_ && index >= 0 && index < static_cast<int>(registry_->getMissionCount()))
         {
             selectedIndex_ = index;
+            rowsDirty_ = true; // rebuildRows() moves the cursor (and page) to it
+        }
+    }
+
+    void MissionMenu::refresh()
+    {
+        if (registry_ && selectedIndex_ >= static_cast<int>(registry_->getMissionCount()))
+        {
+            selectedIndex_ = 0;
+        }
+        // Category positions belong to the old catalog: look the filtered name up again
+        categoryFilter_ = -1;
+        if (registry_ && !categoryName_.empty())
+        {
+            const auto &categories = registry_->getCategories();
+            auto it = std::find(categories.begin(), categories.end(), std::string_view(categoryName_));
+            if (it != categories.end())
+            {
+                categoryFilter_ = static_cast<int>(it - categories.begin());
+            }
         }
+        rowsDirty_ = true;
     }
 
 } // namespace ui
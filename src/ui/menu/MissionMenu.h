@@ -10,13 +10,21 @@
 #include "../../gfx/rendering/Renderer2D.h"
 #include "../../gfx/rendering/TextRenderer.h"
 #include "../../gfx/rendering/TrueTypeFont.h"
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <vector>
 
 extern "C"
 {
 #include <GLFW/glfw3.h>
 }
 
+namespace core
+{
+    class InputSystem;
+}
+
 namespace ui
 {
 
@@ -30,11 +38,25 @@ namespace ui
         int selectedMissionIndex = -1;
     };
 
+    /// Cost of the last MissionMenu::render() call.
+    struct MenuRenderStats
+    {
+        float cpuMs = 0.0f;          ///< Wall time spent inside render() on the CPU.
+        std::size_t drawCalls = 0;   ///< Renderer2D flushes that issued a draw.
+        std::size_t uploadBytes = 0; ///< Vertex/index bytes sent to the GPU.
+        std::size_t rowsDrawn = 0;   ///< List rows laid out this frame.
+        std::size_t rowsTotal = 0;   ///< Rows matching the current filter.
+    };
+
     /**
      * @brief Welcome menu and mission selection.
      *
      * Displays a list of available missions and allows the user to
      * select one to start or exit the simulator.
+     *
+     * The list is virtualized: it holds the registry indices that match the
+     * current filter (MissionRegistry::query) and only lays out the rows of
+     * the visible page, so its cost does not grow with the catalog size.
      */
     class MissionMenu
     {
@@ -52,10 +74,10 @@ namespace ui
 
         /**
          * @brief Update menu state (input handling).
-         * @param window GLFW window for capturing input.
+         * @param input Actions of this frame.
          * @param deltaTime Time elapsed since last frame.
          */
-        void update(GLFWwindow *window, float deltaTime);
+        void update(const core::InputSystem &input, float deltaTime);
 
         /**
          * @brief Render the menu.
@@ -82,6 +104,25 @@ namespace ui
          */
         void preselectMission(int index);
 
+        /**
+         * @brief Rebuild the list after the registry was replaced (hot reload).
+         *
+         * Keeps the filter and, if it still exists, the highlighted position.
+         */
+        void refresh();
+
+        /// Cost of the last render() call.
+        const MenuRenderStats &stats() const { return stats_; }
+
+        /**
+         * @brief Time the menu with the virtualized list and with every row laid out.
+         * @param frames Frames rendered per mode (the full list runs fewer).
+         *
+         * Each frame is followed by glFinish() so the result includes GPU time.
+         * Results are logged to stdout. Bound to B while the menu is open.
+         */
+        void benchmarkRender(int frames = 60);
+
         /**
          * @brief Access to 2D renderer for reuse in other views.
          */
@@ -93,20 +134,40 @@ namespace ui
 
         int screenWidth_;
         int screenHeight_;
-        int selectedIndex_;
+        int selectedIndex_; ///< Registry index of the highlighted mission (-1 if none).
         MenuResult result_;
 
-        // Key state to avoid repetition
-        bool enterKeyPressed_;
-        bool escKeyPressed_;
-        bool upKeyPressed_;
-        bool downKeyPressed_;
+        // Virtualized list
+        std::vector<uint32_t> rows_;  ///< Registry indices matching query_, in display order.
+        mission::MissionQuery query_; ///< Current filter and sort order.
+        int categoryFilter_ = -1;     ///< Index into MissionRegistry::getCategories(), -1 = all.
+        std::string categoryName_;    ///< Owned copy of the filtered category (query_.category views it).
+        size_t rowsSourceCount_ = 0;  ///< Registry size when rows_ was built (reload detection).
+        bool rowsDirty_ = true;
+        int cursor_ = 0;   ///< Position of the selection within rows_.
+        int firstRow_ = 0; ///< First visible row (scroll offset).
+        MenuRenderStats stats_;
+        bool benchmarkRequested_ = false;
+
+        /// Geometry of the list panel for the current screen size.
+        struct ListLayout
+        {
+            float x, y, width, height;
+            float itemHeight;
+            int rowsPerPage;
+        };
 
         // Helpers
-        void handleInput(GLFWwindow *window);
+        void handleInput(const core::InputSystem &input);
+        ListLayout listLayout() const;
+        void rebuildRows();
+        void moveCursor(int position);
+        void renderFrame(bool layoutAllRows);
         void renderBackground();
         void renderTitle();
-        void renderMissionList();
+        void renderMissionList(bool layoutAllRows);
+        void renderMissionRow(uint32_t missionIndex, float itemY, const ListLayout &layout);
+        void renderScrollbar(const ListLayout &layout);
         void renderMissionDetails();
         void renderInstructions();
         void drawMenuText(const std::string &text, const glm::vec2 &anchorPoint, float size,
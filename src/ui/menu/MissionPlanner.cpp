@@ -4,14 +4,13 @@
  */
 
 #include "MissionPlanner.h"
-
-// Include GLFW only in the source to avoid polluting the header
-extern "C"
-{
-#include <GLFW/glfw3.h>
-}
+#include "../../mission/MissionRegistry.h"
+#include "../../util/JsonReader.h"
+#include "../../gfx/core/RenderState.h"
+#include "../../core/InputSystem.h"
 
 #include <algorithm>
+#include <chrono>
 #include <cmath>
 #include <iomanip>
 #include <sstream>
@@ -26,6 +25,20 @@ extern "C"
 namespace ui
 {
 
+    namespace
+    {
+        // Shift+O: each meter climbed or descended counts like two meters flown
+        constexpr float ROUTE_ALTITUDE_WEIGHT = 2.0f;
+
+        // Map level of detail
+        constexpr float MAP_CULL_MARGIN_PX = 24.0f;     // markers straddling the border still show
+        constexpr float ROUTE_MIN_STEP_PX = 1.5f;       // shorter polyline steps are merged
+        constexpr size_t CLUSTER_MIN_VISIBLE = 64;      // up to this many, every visible waypoint gets a marker
+        constexpr float CLUSTER_CELL_PX = 28.0f;        // waypoints sharing a cell this size form a cluster
+        constexpr size_t MAP_LABEL_BUDGET = 256;        // more markers than this are drawn without labels
+        constexpr float PROFILE_NODE_SPACING_PX = 8.0f; // denser profiles only mark the start and selection
+    }
+
     // -----------------------------------------------------------------------------
     // Constructor
     // -----------------------------------------------------------------------------
@@ -35,11 +48,6 @@ namespace ui
           draggingXY_(false),
           draggingIndex_(-1),
           leftMouseHeld_(false),
-          rightMouseHeld_(false),
-          enterHeld_(false),
-          escHeld_(false),
-          rHeld_(false),
-          fHeld_(false),
           startButtonHovered_(false),
           hoveredCardIndex_(-1),
           cachedMissionLength_(0.0f),
@@ -83,17 +91,19 @@ namespace ui
     // -----------------------------------------------------------------------------
     void MissionPlanner::loadMission(const mission::MissionDefinition &mission)
     {
+        // A run still in flight belongs to the previous mission; its result is dropped
+        routeOptimizer_.cancel();
+        routeResultValid_ = false;
         workingMission_ = mission;
+        waypointGridDirty_ = true;
+        markMissionChanged();
+        firstCard_ = 0;
+        scrollFollowIndex_ = -1;
         result_ = PlannerResult{};
         selectedIndex_ = -1;
         draggingXY_ = false;
         draggingIndex_ = -1;
         leftMouseHeld_ = false;
-        rightMouseHeld_ = false;
-        enterHeld_ = false;
-        escHeld_ = false;
-        rHeld_ = false;
-        fHeld_ = false;
         startButtonHovered_ = false;
         hoveredCardIndex_ = -1;
         // Default altitude is that of the start point
@@ -115,7 +125,7 @@ namespace ui
         // Define a minimum so the map doesn't get too small
         mapHalfExtent_ = std::max(2000.0f, maxRadius * 1.5f + 500.0f);
         // Precalculate length
-        cachedMissionLength_ = computeMissionLength();
+        refreshRouteCache();
     }
 
     // -----------------------------------------------------------------------------
@@ -123,15 +133,11 @@ namespace ui
     // -----------------------------------------------------------------------------
     void MissionPlanner::reset()
     {
+        routeOptimizer_.cancel();
         result_ = PlannerResult{};
         draggingXY_ = false;
         draggingIndex_ = -1;
         leftMouseHeld_ = false;
-        rightMouseHeld_ = false;
-        enterHeld_ = false;
-        escHeld_ = false;
-        rHeld_ = false;
-        fHeld_ = false;
         startButtonHovered_ = false;
         hoveredCardIndex_ = -1;
     }
@@ -139,30 +145,47 @@ namespace ui
     // -----------------------------------------------------------------------------
     // Update per frame
     // -----------------------------------------------------------------------------
-    void MissionPlanner::update(GLFWwindow *window, float deltaTime)
+    void MissionPlanner::update(const core::InputSystem &input, float deltaTime)
     {
         if (!renderer_)
         {
             return;
         }
         // Update cursor position
-        double mx = 0.0;
-        double my = 0.0;
-        glfwGetCursorPos(window, &mx, &my);
-        cursorPos_ = glm::vec2(static_cast<float>(mx), static_cast<float>(my));
+        cursorPos_ = glm::vec2(static_cast<float>(input.cursorX()), static_cast<float>(input.cursorY()));
         // Process keyboard and mouse
-        handleKeyboardInput(window, deltaTime);
-        handleMouseInput(window);
+        handleKeyboardInput(input, deltaTime);
+        handleMouseInput(input);
+        pollRouteOptimization();
         // If dragging a waypoint in XZ, update its position
         if (draggingXY_ && leftMouseHeld_ && draggingIndex_ >= 0 && draggingIndex_ < static_cast<int>(workingMission_.waypoints.size()))
         {
             glm::vec3 world = mapScreenToWorld(cursorPos_);
             world.y = workingMission_.waypoints[draggingIndex_].position.y;
             workingMission_.waypoints[draggingIndex_].position = world;
+            if (!waypointGridDirty_)
+            {
+                waypointGrid_.move(static_cast<uint32_t>(draggingIndex_), glm::vec2(world.x, world.z));
+            }
+            markMissionChanged();
+        }
+        // Keep the selection on the visible storyboard page when it changes
+        if (selectedIndex_ != scrollFollowIndex_)
+        {
+            scrollFollowIndex_ = selectedIndex_;
+            size_t page = maxVisibleCards();
+            if (selectedIndex_ >= 0 && page > 0)
+            {
+                if (selectedIndex_ < firstCard_)
+                    scrollStoryboard(selectedIndex_);
+                else if (selectedIndex_ >= firstCard_ + static_cast<int>(page))
+                    scrollStoryboard(selectedIndex_ - static_cast<int>(page) + 1);
+            }
         }
+        scrollStoryboard(firstCard_); // clamp after deletions
         updateStoryboardHover();
-        // Recalculate length to show updated value
-        cachedMissionLength_ = computeMissionLength();
+        // Length and profile follow edits only
+        refreshRouteCache();
     }
 
     // -----------------------------------------------------------------------------
@@ -174,9 +197,26 @@ namespace ui
         {
             return;
         }
+        auto start = std::chrono::steady_clock::now();
+
+        renderFrame();
+
+        stats_.cpuMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+        stats_.drawCalls = renderer_->drawCalls();
+
+        if (benchmarkRequested_)
+        {
+            benchmarkRequested_ = false;
+            benchmarkRender();
+        }
+    }
+
+    void MissionPlanner::renderFrame()
+    {
+        refreshRouteCache();
         // Draw all elements
-        glEnable(GL_BLEND);
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        gfx::RenderState::setBlend(true);
+        gfx::RenderState::setBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
         renderer_->begin();
         renderBackground();
@@ -187,7 +227,7 @@ namespace ui
         renderInstructions();
         renderStartButton();
         renderer_->end();
-        glDisable(GL_BLEND);
+        gfx::RenderState::setBlend(false);
         // flush() is already called by end() internally
     }
 
@@ -221,92 +261,96 @@ namespace ui
     // -----------------------------------------------------------------------------
     // Keyboard Processing
     // -----------------------------------------------------------------------------
-    void MissionPlanner::handleKeyboardInput(GLFWwindow *window, float deltaTime)
+    void MissionPlanner::handleKeyboardInput(const core::InputSystem &input, float deltaTime)
     {
+        using core::InputAction;
+
         // Map panning proportional to visible extent
         float move = panSpeed_ * deltaTime;
         float factor = mapHalfExtent_ / 5000.0f; // adjust sensitivity based on scale
         float delta = move * factor;
-        if (glfwGetKey(window, GLFW_KEY_A) == GLFW_PRESS || glfwGetKey(window, GLFW_KEY_LEFT) == GLFW_PRESS)
+        if (input.down(InputAction::PanLeft))
         {
             mapCenter_.x -= delta;
         }
-        if (glfwGetKey(window, GLFW_KEY_D) == GLFW_PRESS || glfwGetKey(window, GLFW_KEY_RIGHT) == GLFW_PRESS)
+        if (input.down(InputAction::PanRight))
         {
             mapCenter_.x += delta;
         }
-        if (glfwGetKey(window, GLFW_KEY_W) == GLFW_PRESS || glfwGetKey(window, GLFW_KEY_UP) == GLFW_PRESS)
+        if (input.down(InputAction::PanUp))
         {
             mapCenter_.y -= delta;
         }
-        if (glfwGetKey(window, GLFW_KEY_S) == GLFW_PRESS || glfwGetKey(window, GLFW_KEY_DOWN) == GLFW_PRESS)
+        if (input.down(InputAction::PanDown))
         {
             mapCenter_.y += delta;
         }
         // Confirm start with ENTER
-        bool enterDown = (glfwGetKey(window, GLFW_KEY_ENTER) == GLFW_PRESS ||
-                          glfwGetKey(window, GLFW_KEY_KP_ENTER) == GLFW_PRESS);
-        if (enterDown && !enterHeld_)
+        if (input.pressed(InputAction::Confirm) && validateMission())
         {
-            if (validateMission())
-            {
-                result_.startRequested = true;
-            }
-            enterHeld_ = true;
-        }
-        else if (!enterDown)
-        {
-            enterHeld_ = false;
+            result_.startRequested = true;
         }
         // Cancel with ESC
-        bool escDown = (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS);
-        if (escDown && !escHeld_)
+        if (input.pressed(InputAction::Back))
         {
             result_.cancelRequested = true;
-            escHeld_ = true;
-        }
-        else if (!escDown)
-        {
-            escHeld_ = false;
         }
+        const bool hasSelection = selectedIndex_ >= 0 && selectedIndex_ < static_cast<int>(workingMission_.waypoints.size());
         // Increase altitude of selected waypoint with R
-        bool rDown = (glfwGetKey(window, GLFW_KEY_R) == GLFW_PRESS);
-        if (rDown && !rHeld_ && selectedIndex_ >= 0 && selectedIndex_ < static_cast<int>(workingMission_.waypoints.size()))
+        if (input.pressed(InputAction::AltitudeUp) && hasSelection)
         {
             workingMission_.waypoints[selectedIndex_].position.y += 100.0f;
-            rHeld_ = true;
-        }
-        else if (!rDown)
-        {
-            rHeld_ = false;
+            markMissionChanged();
         }
         // Decrease altitude with F
-        bool fDown = (glfwGetKey(window, GLFW_KEY_F) == GLFW_PRESS);
-        if (fDown && !fHeld_ && selectedIndex_ >= 0 && selectedIndex_ < static_cast<int>(workingMission_.waypoints.size()))
+        if (input.pressed(InputAction::AltitudeDown) && hasSelection)
         {
             float &alt = workingMission_.waypoints[selectedIndex_].position.y;
             alt = std::max(0.0f, alt - 100.0f);
-            fHeld_ = true;
+            markMissionChanged();
         }
-        else if (!fDown)
+
+        // O: optimize the visiting order (Shift also penalizes altitude changes); again to cancel
+        if (input.pressed(InputAction::OptimizeRoute))
         {
-            fHeld_ = false;
+            if (routeOptimizer_.isRunning())
+            {
+                routeOptimizer_.cancel();
+            }
+            else
+            {
+                startRouteOptimization(input.down(InputAction::Shift));
+            }
+        }
+
+        // PAGE UP / PAGE DOWN scroll the storyboard a page at a time
+        int page = std::max(1, static_cast<int>(maxVisibleCards()));
+        if (input.pressed(InputAction::PageUp))
+        {
+            scrollStoryboard(firstCard_ - page);
+        }
+        if (input.pressed(InputAction::PageDown))
+        {
+            scrollStoryboard(firstCard_ + page);
+        }
+
+        // B: log frame times for the current mission (see benchmarkRender)
+        if (input.pressed(InputAction::Benchmark))
+        {
+            benchmarkRequested_ = true;
         }
     }
 
     // -----------------------------------------------------------------------------
     // Mouse Processing
     // -----------------------------------------------------------------------------
-    void MissionPlanner::handleMouseInput(GLFWwindow *window)
+    void MissionPlanner::handleMouseInput(const core::InputSystem &input)
     {
-        // Detect button state
-        bool leftDown = (glfwGetMouseButton(window, GLFW_MOUSE_BUTTON_LEFT) == GLFW_PRESS);
-        bool rightDown = (glfwGetMouseButton(window, GLFW_MOUSE_BUTTON_RIGHT) == GLFW_PRESS);
         // Update hover flag on start button
         startButtonHovered_ = (cursorPos_.x >= buttonPos_.x && cursorPos_.x <= (buttonPos_.x + buttonSize_.x) &&
                                cursorPos_.y >= buttonPos_.y && cursorPos_.y <= (buttonPos_.y + buttonSize_.y));
         // Left click just pressed
-        if (leftDown && !leftMouseHeld_)
+        if (input.pressed(core::InputAction::PointerPrimary))
         {
             // If cursor is over button and mission is valid -> start
             if (startButtonHovered_ && validateMission())
@@ -330,39 +374,33 @@ namespace ui
                     wp.position = mapScreenToWorld(cursorPos_);
                     wp.name = "WP" + std::to_string(static_cast<int>(workingMission_.waypoints.size() + 1));
                     workingMission_.waypoints.push_back(wp);
+                    markMissionChanged();
+                    if (!waypointGridDirty_)
+                    {
+                        waypointGrid_.insert(static_cast<uint32_t>(workingMission_.waypoints.size() - 1),
+                                             glm::vec2(wp.position.x, wp.position.z));
+                    }
                     selectedIndex_ = static_cast<int>(workingMission_.waypoints.size()) - 1;
                 }
             }
             else if (cursorInsideStoryboard())
             {
-                // Select waypoint card
-                size_t visible = std::min(maxVisibleCards(), workingMission_.waypoints.size());
-                for (size_t i = 0; i < visible; ++i)
+                // Select the hovered card (updated last frame, already offset by the scroll)
+                if (hoveredCardIndex_ >= 0)
                 {
-                    glm::vec2 pos;
-                    glm::vec2 size;
-                    if (!cardRect(i, pos, size))
-                    {
-                        continue;
-                    }
-                    if (cursorPos_.x >= pos.x && cursorPos_.x <= pos.x + size.x &&
-                        cursorPos_.y >= pos.y && cursorPos_.y <= pos.y + size.y)
-                    {
-                        selectedIndex_ = static_cast<int>(i);
-                        break;
-                    }
+                    selectedIndex_ = hoveredCardIndex_;
                 }
             }
         }
-        // Releasing left button ends drag
-        else if (!leftDown && leftMouseHeld_)
+        // Releasing left button ends drag (a click shorter than a frame presses and releases at once)
+        if (!input.down(core::InputAction::PointerPrimary) && (leftMouseHeld_ || input.released(core::InputAction::PointerPrimary)))
         {
             draggingXY_ = false;
             draggingIndex_ = -1;
         }
-        leftMouseHeld_ = leftDown;
+        leftMouseHeld_ = input.down(core::InputAction::PointerPrimary);
         // Right click just pressed to delete
-        if (rightDown && !rightMouseHeld_)
+        if (input.pressed(core::InputAction::PointerSecondary))
         {
             if (cursorInsideMap())
             {
@@ -370,6 +408,8 @@ namespace ui
                 if (index >= 0 && index < static_cast<int>(workingMission_.waypoints.size()))
                 {
                     workingMission_.waypoints.erase(workingMission_.waypoints.begin() + index);
+                    waypointGridDirty_ = true; // later indices shift down
+                    markMissionChanged();
                     if (selectedIndex_ == index)
                     {
                         selectedIndex_ = -1;
@@ -382,7 +422,6 @@ namespace ui
                 }
             }
         }
-        rightMouseHeld_ = rightDown;
     }
 
     // -----------------------------------------------------------------------------
@@ -395,7 +434,10 @@ namespace ui
         {
             return;
         }
-        size_t visible = std::min(maxVisibleCards(), workingMission_.waypoints.size());
+        // Only the visible page has cards; slot i shows waypoint firstCard_ + i
+        size_t total = workingMission_.waypoints.size();
+        size_t first = static_cast<size_t>(firstCard_);
+        size_t visible = first < total ? std::min(maxVisibleCards(), total - first) : 0;
         for (size_t i = 0; i < visible; ++i)
         {
             glm::vec2 pos;
@@ -407,7 +449,7 @@ namespace ui
             if (cursorPos_.x >= pos.x && cursorPos_.x <= pos.x + size.x &&
                 cursorPos_.y >= pos.y && cursorPos_.y <= pos.y + size.y)
             {
-                hoveredCardIndex_ = static_cast<int>(i);
+                hoveredCardIndex_ = static_cast<int>(first + i);
                 break;
             }
         }
@@ -455,18 +497,20 @@ namespace ui
         glm::vec4 barBorder(0.15f, 0.35f, 0.55f, 0.9f);
         renderer_->drawRect(pos, size, barBg, true);
         renderer_->drawRect(pos, size, barBorder, false);
-        // Build texts
-        auto formatFloat = [](float value, int decimals)
-        {
-            std::ostringstream oss;
-            oss << std::fixed << std::setprecision(decimals) << value;
-            return oss.str();
-        };
-        std::string left = "Waypoints: " + std::to_string(workingMission_.waypoints.size());
+        // Build texts (frame arena: released at the start of next frame)
+        core::FrameString left = core::formatFrameString(frameArena_, "Waypoints: %zu", workingMission_.waypoints.size());
         float totalKm = cachedMissionLength_ > 0.0f ? cachedMissionLength_ / 1000.0f : 0.0f;
-        std::string center = "Length: " + formatFloat(totalKm, 1) + " km";
-        std::string right = "Wind " + formatFloat(workingMission_.environment.windSpeed, 1) + " m/s  @" +
-                            formatFloat(workingMission_.environment.windDirection, 0) + "°";
+        core::FrameString center =
+            routeOptimizer_.isRunning()
+                ? core::formatFrameString(frameArena_, "Length: %.1f km  |  Optimizing route %d/%d  (O cancels)", totalKm,
+                                          routeOptimizer_.restartsCompleted(), routeOptimizer_.restartsRequested())
+            : routeResultValid_
+                ? core::formatFrameString(frameArena_, "Length: %.1f km  |  Optimized -%.1f%% in %.0f ms", totalKm,
+                                          routeImprovement_ * 100.0f, routeElapsedMs_)
+                : core::formatFrameString(frameArena_, "Length: %.1f km", totalKm);
+        core::FrameString right = core::formatFrameString(frameArena_, "Wind %.1f m/s  @%.0f°",
+                                                          workingMission_.environment.windSpeed,
+                                                          workingMission_.environment.windDirection);
         // Draw texts with alignment
         drawPlannerText(left, pos + glm::vec2(18.0f, size.y * 0.5f), 16.0f,
                         glm::vec4(0.75f, 0.85f, 1.0f, 1.0f), glm::vec2(0.0f, 0.5f));
@@ -496,15 +540,18 @@ namespace ui
             float y = mapOrigin_.y + mapSize_.y * 0.5f + t * (mapSize_.y * 0.5f);
             renderer_->drawLine(glm::vec2(mapOrigin_.x, y), glm::vec2(mapOrigin_.x + mapSize_.x, y), gridColor, 1.0f);
         }
-        // Draw connections between nodes
-        glm::vec3 prevWorld = workingMission_.startPosition;
-        glm::vec2 prevScreen = mapWorldToScreen(prevWorld);
-        for (const auto &wp : workingMission_.waypoints)
+        // Route and markers come from the map cache (culled, decimated and clustered)
+        glm::vec3 view(mapCenter_, mapHalfExtent_);
+        glm::vec4 rect(mapOrigin_, mapSize_);
+        if (mapCacheRevision_ != routeCacheRevision_ || mapCacheView_ != view || mapCacheRect_ != rect)
         {
-            glm::vec2 curScreen = mapWorldToScreen(wp.position);
-            renderer_->drawLine(prevScreen, curScreen, glm::vec4(0.25f, 0.6f, 0.9f, 0.8f), 2.5f);
-            prevScreen = curScreen;
-            prevWorld = wp.position;
+            rebuildMapCache();
+        }
+        glm::vec4 routeColor(0.25f, 0.6f, 0.9f, 0.8f);
+        for (size_t run = 0; run + 1 < mapRouteRuns_.size(); ++run)
+        {
+            uint32_t first = mapRouteRuns_[run];
+            renderer_->drawPolyline(mapRoutePoints_.data() + first, mapRouteRuns_[run + 1] - first, routeColor, 2.5f);
         }
         // Origin marker (start point)
         glm::vec2 startScreen = mapWorldToScreen(workingMission_.startPosition);
@@ -520,8 +567,9 @@ namespace ui
             drawPlannerText("Click on map to insert first waypoint", hintPos,
                             18.0f, glm::vec4(0.85f, 0.9f, 1.0f, 0.9f), glm::vec2(0.5f, 0.5f));
         }
-        // Draw each waypoint
-        for (size_t i = 0; i < workingMission_.waypoints.size(); ++i)
+        // Draw one waypoint marker with its labels
+        bool labels = mapMarkers_.size() <= MAP_LABEL_BUDGET;
+        auto drawWaypoint = [&](size_t i, bool withLabels)
         {
             const auto &wp = workingMission_.waypoints[i];
             glm::vec2 p = mapWorldToScreen(wp.position);
@@ -534,14 +582,57 @@ namespace ui
             float outerRadius = innerRadius + 2.0f;
             renderer_->drawCircle(p, outerRadius, glm::vec4(baseColor.r, baseColor.g, baseColor.b, 0.3f), 32, false);
             renderer_->drawCircle(p, innerRadius, baseColor, 32, true);
+            if (!withLabels)
+            {
+                return;
+            }
             // Labels
-            std::string label = "WP" + std::to_string(static_cast<int>(i + 1));
+            core::FrameString label = core::formatFrameString(frameArena_, "WP%d", static_cast<int>(i + 1));
             drawPlannerText(label, p + glm::vec2(0.0f, -12.0f), 16.0f,
                             glm::vec4(1.0f, 1.0f, 1.0f, 1.0f), glm::vec2(0.5f, 1.0f));
             // Altitude below
-            std::string altStr = std::to_string(static_cast<int>(std::round(wp.position.y))) + " m";
+            core::FrameString altStr = core::formatFrameString(frameArena_, "%d m", static_cast<int>(std::round(wp.position.y)));
             drawPlannerText(altStr, p + glm::vec2(0.0f, 12.0f), 13.0f,
                             glm::vec4(0.96f, 0.95f, 0.85f, 1.0f), glm::vec2(0.5f, 0.0f));
+        };
+        stats_.waypointsDrawn = 0;
+        stats_.clustersDrawn = 0;
+        stats_.routePoints = mapRoutePoints_.size();
+        for (const MapMarker &marker : mapMarkers_)
+        {
+            if (marker.count == 1)
+            {
+                // Selection and hover are drawn last, on top
+                if (static_cast<int>(marker.index) != selectedIndex_ && static_cast<int>(marker.index) != hoveredCardIndex_)
+                {
+                    drawWaypoint(marker.index, labels);
+                }
+                ++stats_.waypointsDrawn;
+                continue;
+            }
+            // Cluster: grows with the number of waypoints it stands for
+            float radius = 8.0f + std::min(10.0f, 2.0f * std::log2(static_cast<float>(marker.count)));
+            glm::vec4 clusterColor(0.25f, 0.6f, 0.9f, 1.0f);
+            renderer_->drawCircle(marker.screen, radius, glm::vec4(0.08f, 0.2f, 0.32f, 0.9f), 24, true);
+            renderer_->drawCircle(marker.screen, radius, clusterColor, 24, false);
+            if (labels)
+            {
+                core::FrameString count = core::formatFrameString(frameArena_, "%u", marker.count);
+                drawPlannerText(count, marker.screen, 12.0f, glm::vec4(0.9f, 0.95f, 1.0f, 1.0f), glm::vec2(0.5f, 0.5f));
+            }
+            ++stats_.clustersDrawn;
+        }
+        for (int highlighted : {hoveredCardIndex_ != selectedIndex_ ? hoveredCardIndex_ : -1, selectedIndex_})
+        {
+            if (highlighted >= 0 && highlighted < static_cast<int>(workingMission_.waypoints.size()))
+            {
+                glm::vec2 p = mapWorldToScreen(workingMission_.waypoints[highlighted].position);
+                if (p.x >= mapOrigin_.x && p.x <= mapOrigin_.x + mapSize_.x &&
+                    p.y >= mapOrigin_.y && p.y <= mapOrigin_.y + mapSize_.y)
+                {
+                    drawWaypoint(static_cast<size_t>(highlighted), true);
+                }
+            }
         }
     }
 
@@ -563,58 +654,41 @@ namespace ui
         renderer_->drawLine(profileOrigin_ + glm::vec2(40.0f, 20.0f),
                             profileOrigin_ + glm::vec2(40.0f, profileSize_.y - 20.0f),
                             axisColor, 1.0f);
-        // Collect points (cumulative distance, altitude)
-        std::vector<glm::vec2> nodes;
-        float totalDist = 0.0f;
-        float maxAlt = 3000.0f; // minimum scale
-        nodes.push_back(glm::vec2(0.0f, workingMission_.startPosition.y));
-        maxAlt = std::max(maxAlt, workingMission_.startPosition.y);
-        glm::vec3 prev = workingMission_.startPosition;
-        for (const auto &wp : workingMission_.waypoints)
+        // Altitude curve from the profile cache (rebuilt when the route or the panel changes)
+        glm::vec4 rect(profileOrigin_, profileSize_);
+        if (profileCacheRevision_ != routeCacheRevision_ || profileCacheRect_ != rect)
         {
-            float d = glm::length(glm::vec2(wp.position.x - prev.x, wp.position.z - prev.z));
-            totalDist += d;
-            nodes.push_back(glm::vec2(totalDist, wp.position.y));
-            maxAlt = std::max(maxAlt, wp.position.y);
-            prev = wp.position;
+            rebuildProfileCache();
         }
-        if (totalDist < 100.0f)
-            totalDist = 100.0f;
-        maxAlt *= 1.2f; // margin
-        // Determine scales
-        float scaleX = (profileSize_.x - 80.0f) / totalDist;
-        float scaleY = (profileSize_.y - 60.0f) / maxAlt;
-        float originX = profileOrigin_.x + 40.0f;
-        float originY = profileOrigin_.y + profileSize_.y - 20.0f;
-        // Draw area chart
-        if (nodes.size() >= 2)
-        {
-            for (size_t i = 0; i < nodes.size() - 1; ++i)
+        if (profileLine_.size() >= 2)
+        {
+            renderer_->drawPolyline(profileLine_, glm::vec4(0.4f, 0.9f, 0.6f, 0.9f), 2.0f);
+        }
+        // Draw nodes: every one while they are a few pixels apart, otherwise start and selection only
+        auto nodeScreen = [&](size_t node)
+        {
+            float altitude = node == 0 ? workingMission_.startPosition.y : workingMission_.waypoints[node - 1].position.y;
+            return profileBase_ + glm::vec2(routeCumulative_[node] * profileScale_.x, -altitude * profileScale_.y);
+        };
+        glm::vec4 nodeColor(0.4f, 0.9f, 0.6f, 1.0f);
+        glm::vec4 activeColor(1.0f, 0.8f, 0.2f, 1.0f);
+        size_t nodeCount = routeCumulative_.size();
+        float plotWidth = profileSize_.x - 80.0f;
+        if (static_cast<float>(nodeCount) * PROFILE_NODE_SPACING_PX <= plotWidth)
+        {
+            for (size_t i = 0; i < nodeCount; ++i)
             {
-                glm::vec2 p1 = nodes[i];
-                glm::vec2 p2 = nodes[i + 1];
-                float x1 = originX + p1.x * scaleX;
-                float y1 = originY - p1.y * scaleY;
-                float x2 = originX + p2.x * scaleX;
-                float y2 = originY - p2.y * scaleY;
-                // Fill under curve (simplified as quads)
-                glm::vec4 fillColor(0.2f, 0.5f, 0.4f, 0.3f);
-                // ... (implementation of fill omitted for brevity, using lines for now)
-                renderer_->drawLine(glm::vec2(x1, y1), glm::vec2(x2, y2), glm::vec4(0.4f, 0.9f, 0.6f, 0.9f), 2.0f);
+                bool active = (static_cast<int>(i) - 1 == selectedIndex_); // i=0 is start
+                renderer_->drawCircle(nodeScreen(i), 5.0f, active ? activeColor : nodeColor, 32, true);
             }
         }
-        // Draw top line
-        // (Already done in loop above)
-        // Draw nodes and labels
-        for (size_t i = 0; i < nodes.size(); ++i)
+        else
         {
-            // Calculate current point
-            float x = originX + nodes[i].x * scaleX;
-            float y = originY - nodes[i].y * scaleY;
-            glm::vec2 currentPt(x, y);
-            bool active = (static_cast<int>(i - 1) == selectedIndex_); // i=0 is start
-            glm::vec4 color = active ? glm::vec4(1.0f, 0.8f, 0.2f, 1.0f) : glm::vec4(0.4f, 0.9f, 0.6f, 1.0f);
-            renderer_->drawCircle(currentPt, 5.0f, color, 32, true);
+            renderer_->drawCircle(nodeScreen(0), 5.0f, nodeColor, 32, true);
+            if (selectedIndex_ >= 0 && static_cast<size_t>(selectedIndex_) + 1 < nodeCount)
+            {
+                renderer_->drawCircle(nodeScreen(static_cast<size_t>(selectedIndex_) + 1), 5.0f, activeColor, 32, true);
+            }
         }
     }
 
@@ -632,50 +706,41 @@ namespace ui
         drawPlannerText("STORYBOARD", headerPos, 22.0f,
                         glm::vec4(0.55f, 0.95f, 1.0f, 1.0f), glm::vec2(0.5f, 0.5f));
         // Subtítulo con información general
-        std::string missionName = workingMission_.name.empty() ? "Misión sin nombre" : workingMission_.name;
-        std::string overview = missionName + "  |  " + workingMission_.category + "  |  " +
-                               workingMission_.environment.weather + "  @ " + workingMission_.environment.timeOfDay;
+        const char *missionName = workingMission_.name.empty() ? "Misión sin nombre" : workingMission_.name.c_str();
+        core::FrameString overview = core::formatFrameString(frameArena_, "%s  |  %s  |  %s  @ %s",
+                                                             missionName,
+                                                             workingMission_.category.c_str(),
+                                                             workingMission_.environment.weather.c_str(),
+                                                             workingMission_.environment.timeOfDay.c_str());
         drawPlannerText(overview,
                         storyboardOrigin_ + glm::vec2(storyboardSize_.x * 0.5f, 58.0f),
                         17.0f, glm::vec4(0.9f, 0.92f, 0.96f, 1.0f), glm::vec2(0.5f, 0.5f));
-        // Calcular tarjetas visibles
-        size_t visible = std::min(maxVisibleCards(), workingMission_.waypoints.size());
+        // Lista virtualizada: solo se arman las tarjetas de la página visible
+        size_t total = workingMission_.waypoints.size();
+        size_t page = maxVisibleCards();
+        size_t first = static_cast<size_t>(firstCard_);
+        size_t visible = first < total ? std::min(page, total - first) : 0;
+        stats_.cardsDrawn = visible;
         if (visible == 0)
         {
             // Si no hay waypoints, no renderizar tarjetas
             return;
         }
-        // Distancias acumuladas para métricas por tramo
-        std::vector<float> cumulative;
-        cumulative.reserve(workingMission_.waypoints.size() + 1);
-        cumulative.push_back(0.0f);
-        glm::vec2 prevXZ(workingMission_.startPosition.x, workingMission_.startPosition.z);
-        for (const auto &wp : workingMission_.waypoints)
-        {
-            glm::vec2 curXZ(wp.position.x, wp.position.z);
-            float d = glm::length(curXZ - prevXZ);
-            cumulative.push_back(cumulative.back() + d);
-            prevXZ = curXZ;
-        }
+        // Distancias acumuladas (caché de la ruta) para métricas por tramo
+        const std::vector<float> &cumulative = routeCumulative_;
         float totalDistance = cumulative.back();
         if (totalDistance <= 0.0f)
             totalDistance = 1.0f;
-        auto formatFloat = [](float v, int dec)
-        {
-            std::ostringstream oss;
-            oss << std::fixed << std::setprecision(dec) << v;
-            return oss.str();
-        };
-
         // Renderizar cada tarjeta visible
-        for (size_t i = 0; i < visible; ++i)
+        for (size_t slot = 0; slot < visible; ++slot)
         {
             glm::vec2 pos;
             glm::vec2 size;
-            if (!cardRect(i, pos, size))
+            if (!cardRect(slot, pos, size))
             {
                 continue;
             }
+            size_t i = first + slot;
             bool isSel = (static_cast<int>(i) == selectedIndex_);
             bool isHover = (static_cast<int>(i) == hoveredCardIndex_);
             glm::vec4 bg = isSel     ? glm::vec4(0.08f, 0.12f, 0.18f, 1.0f)
@@ -690,8 +755,9 @@ namespace ui
             // Franja lateral de color
             renderer_->drawRect(pos, glm::vec2(6.0f, size.y), accent, true);
             // Texto principal: número y nombre
-            std::string label = "WP" + std::to_string(static_cast<int>(i + 1)) + "  " +
-                                (workingMission_.waypoints[i].name.empty() ? "VECTOR" : workingMission_.waypoints[i].name);
+            const std::string &wpName = workingMission_.waypoints[i].name;
+            core::FrameString label = core::formatFrameString(frameArena_, "WP%d  %s", static_cast<int>(i + 1),
+                                                              wpName.empty() ? "VECTOR" : wpName.c_str());
             glm::vec2 labelPos = pos + glm::vec2(size.x * 0.5f, 20.0f);
             glm::vec4 nameColor = isSel ? glm::vec4(1.0f) : glm::vec4(0.92f, 0.96f, 1.0f, 0.96f);
             drawPlannerText(label, labelPos + glm::vec2(1.0f, 1.0f), 20.0f,
@@ -715,7 +781,10 @@ namespace ui
             float headingDeg = glm::degrees(headingRad);
             if (headingDeg < 0.0f)
                 headingDeg += 360.0f;
-            std::string metrics = "ALT " + std::to_string(static_cast<int>(std::round(workingMission_.waypoints[i].position.y))) + " m" + "   |   DIST " + formatFloat(legKm, 1) + " km" + "   |   HDG " + std::to_string(static_cast<int>(std::round(headingDeg))) + "°";
+            core::FrameString metrics = core::formatFrameString(frameArena_, "ALT %d m   |   DIST %.1f km   |   HDG %d°",
+                                                                static_cast<int>(std::round(workingMission_.waypoints[i].position.y)),
+                                                                legKm,
+                                                                static_cast<int>(std::round(headingDeg)));
             glm::vec2 metricsPos = pos + glm::vec2(size.x * 0.5f, 44.0f);
             drawPlannerText(metrics, metricsPos + glm::vec2(0.8f, 0.8f), 16.5f,
                             glm::vec4(0.0f, 0.0f, 0.0f, 0.35f), glm::vec2(0.5f, 0.0f));
@@ -728,15 +797,24 @@ namespace ui
             renderer_->drawRect(barPos, barSize, glm::vec4(0.08f, 0.15f, 0.2f, 1.0f), true);
             renderer_->drawRect(barPos, glm::vec2(barSize.x * progression, barSize.y), accent, true);
         }
-        // Aviso de tarjetas ocultas
-        size_t total = workingMission_.waypoints.size();
+        // Posición en la lista y barra de desplazamiento
         if (total > visible)
         {
-            size_t remaining = total - visible;
-            std::string overflow = "+" + std::to_string(remaining) + " waypoints ocultos";
-            drawPlannerText(overflow,
+            core::FrameString range = core::formatFrameString(frameArena_, "%zu-%zu de %zu  (PgUp/PgDn)",
+                                                              first + 1, first + visible, total);
+            drawPlannerText(range,
                             storyboardOrigin_ + glm::vec2(storyboardSize_.x * 0.5f, storyboardSize_.y - buttonSize_.y - 24.0f),
                             14.0f, glm::vec4(0.9f, 0.6f, 0.2f, 1.0f), glm::vec2(0.5f, 0.5f));
+
+            float trackX = storyboardOrigin_.x + storyboardSize_.x - 8.0f;
+            float trackY = storyboardOrigin_.y + 90.0f;
+            float trackH = std::max(0.0f, buttonPos_.y - 24.0f - trackY);
+            float thumbH = std::max(16.0f, trackH * static_cast<float>(page) / total);
+            float scroll = total > page ? static_cast<float>(first) / (total - page) : 0.0f;
+            renderer_->drawRect(glm::vec2(trackX, trackY), glm::vec2(4.0f, trackH),
+                                glm::vec4(0.1f, 0.15f, 0.22f, 0.8f), true);
+            renderer_->drawRect(glm::vec2(trackX, trackY + (trackH - thumbH) * scroll), glm::vec2(4.0f, thumbH),
+                                glm::vec4(0.3f, 0.7f, 1.0f, 0.9f), true);
         }
     }
 
@@ -745,8 +823,8 @@ namespace ui
     // -----------------------------------------------------------------------------
     void MissionPlanner::renderInstructions()
     {
-        std::string instr1 = "MAP: Left click inserts/moves | Right deletes | WASD pans";
-        std::string instr2 = "ALTITUDE: R raises | F lowers | ENTER starts mission | ESC returns";
+        const char *instr1 = "MAP: Left click inserts/moves | Right deletes | WASD pans | O optimizes order (Shift: altitude)";
+        const char *instr2 = "ALTITUDE: R raises | F lowers | ENTER starts mission | ESC returns";
         glm::vec4 instrColor(0.78f, 0.82f, 0.9f, 1.0f);
         drawPlannerText(instr1, glm::vec2(screenWidth_ * 0.5f, screenHeight_ * 0.925f), 18.0f,
                         instrColor, glm::vec2(0.5f, 0.5f));
@@ -771,19 +849,19 @@ namespace ui
         renderer_->drawRect(buttonPos_, buttonSize_, color, true);
         renderer_->drawRect(buttonPos_, buttonSize_, glm::vec4(0.05f, 0.12f, 0.08f, 1.0f), false);
         // Main text
-        std::string label = validateMission() ? "START MISSION" : "ADD WAYPOINTS";
+        const char *label = validateMission() ? "START MISSION" : "ADD WAYPOINTS";
         drawPlannerText(label,
                         buttonPos_ + glm::vec2(buttonSize_.x * 0.5f, buttonSize_.y * 0.38f),
                         22.0f, glm::vec4(1.0f), glm::vec2(0.5f, 0.5f));
         // Secondary text
-        std::string sub = validateMission() ? "Validation OK - ready to fly"
+        const char *sub = validateMission() ? "Validation OK - ready to fly"
                                             : "At least one waypoint needed";
         drawPlannerText(sub,
                         buttonPos_ + glm::vec2(buttonSize_.x * 0.5f, buttonSize_.y * 0.72f),
                         15.0f, glm::vec4(0.85f, 0.95f, 1.0f, 0.9f), glm::vec2(0.5f, 0.5f));
     }
 
-    glm::vec2 MissionPlanner::plannerTextSize(const std::string &text, float size, float lineSpacing) const
+    glm::vec2 MissionPlanner::plannerTextSize(std::string_view text, float size, float lineSpacing) const
     {
         if (plannerFontReady_)
         {
@@ -802,7 +880,7 @@ namespace ui
         return glm::vec2(approxWidth, approxHeight);
     }
 
-    void MissionPlanner::drawPlannerText(const std::string &text, const glm::vec2 &anchorPoint, float size,
+    void MissionPlanner::drawPlannerText(std::string_view text, const glm::vec2 &anchorPoint, float size,
                                          const glm::vec4 &color, const glm::vec2 &anchor, float lineSpacing)
     {
         if (!renderer_ || text.empty())
@@ -859,19 +937,42 @@ namespace ui
     // -----------------------------------------------------------------------------
     int MissionPlanner::findWaypointNear(const glm::vec2 &screen, float threshold) const
     {
+        const auto &waypoints = workingMission_.waypoints;
+        ensureWaypointGrid();
+
+        // Pixel threshold -> world radius on the coarser map axis, then exact test in screen space
+        float metersPerPixel = 2.0f * mapHalfExtent_ / std::max(1.0f, std::min(mapSize_.x, mapSize_.y));
+        glm::vec3 center = mapScreenToWorld(screen);
+
         float best = threshold;
         int index = -1;
-        for (size_t i = 0; i < workingMission_.waypoints.size(); ++i)
+        waypointGrid_.forEachInRadius(glm::vec2(center.x, center.z), threshold * metersPerPixel,
+                                      [&](uint32_t i, float)
+                                      {
+                                          float d = glm::length(mapWorldToScreen(waypoints[i].position) - screen);
+                                          if (d < best || (d == best && static_cast<int>(i) < index))
+                                          {
+                                              best = d;
+                                              index = static_cast<int>(i);
+                                          }
+                                      });
+        return index;
+    }
+
+    void MissionPlanner::ensureWaypointGrid() const
+    {
+        if (!waypointGridDirty_)
         {
-            glm::vec2 pos = mapWorldToScreen(workingMission_.waypoints[i].position);
-            float d = glm::length(pos - screen);
-            if (d < best)
-            {
-                best = d;
-                index = static_cast<int>(i);
-            }
+            return;
         }
-        return index;
+        std::vector<glm::vec2> positions;
+        positions.reserve(workingMission_.waypoints.size());
+        for (const auto &wp : workingMission_.waypoints)
+        {
+            positions.emplace_back(wp.position.x, wp.position.z);
+        }
+        waypointGrid_.build(positions, 500.0f);
+        waypointGridDirty_ = false;
     }
 
     // -----------------------------------------------------------------------------
@@ -972,6 +1073,7 @@ namespace ui
     void MissionPlanner::autoGenerateWaypoints(int pattern)
     {
         workingMission_.waypoints.clear();
+        waypointGridDirty_ = true;
         float radius = mapHalfExtent_ * 0.6f;
         switch (pattern)
         {
@@ -1015,7 +1117,344 @@ namespace ui
         }
         selectedIndex_ = -1;
         hoveredCardIndex_ = -1;
-        cachedMissionLength_ = computeMissionLength();
+        markMissionChanged();
+        refreshRouteCache();
+    }
+
+    // -----------------------------------------------------------------------------
+    // Route caches
+    // -----------------------------------------------------------------------------
+    void MissionPlanner::refreshRouteCache()
+    {
+        if (routeCacheRevision_ == missionRevision_)
+        {
+            return;
+        }
+        routeCacheRevision_ = missionRevision_;
+        routeCumulative_.clear();
+        routeCumulative_.reserve(workingMission_.waypoints.size() + 1);
+        routeCumulative_.push_back(0.0f);
+        routeMaxAltitude_ = workingMission_.startPosition.y;
+        glm::vec2 prev(workingMission_.startPosition.x, workingMission_.startPosition.z);
+        for (const auto &wp : workingMission_.waypoints)
+        {
+            glm::vec2 cur(wp.position.x, wp.position.z);
+            routeCumulative_.push_back(routeCumulative_.back() + glm::length(cur - prev));
+            routeMaxAltitude_ = std::max(routeMaxAltitude_, wp.position.y);
+            prev = cur;
+        }
+        cachedMissionLength_ = routeCumulative_.back();
+    }
+
+    void MissionPlanner::rebuildMapCache()
+    {
+        mapCacheRevision_ = routeCacheRevision_;
+        mapCacheView_ = glm::vec3(mapCenter_, mapHalfExtent_);
+        mapCacheRect_ = glm::vec4(mapOrigin_, mapSize_);
+        mapRoutePoints_.clear();
+        mapRouteRuns_.clear();
+        mapMarkers_.clear();
+
+        const auto &waypoints = workingMission_.waypoints;
+        const glm::vec2 lo = mapOrigin_ - glm::vec2(MAP_CULL_MARGIN_PX);
+        const glm::vec2 hi = mapOrigin_ + mapSize_ + glm::vec2(MAP_CULL_MARGIN_PX);
+
+        // Route: segments whose bounds miss the map split the polyline into runs,
+        // and steps shorter than ROUTE_MIN_STEP_PX are merged into the next one
+        glm::vec2 prev = mapWorldToScreen(workingMission_.startPosition);
+        bool inRun = false;
+        auto closeRun = [&]()
+        {
+            if (mapRoutePoints_.back() != prev)
+            {
+                mapRoutePoints_.push_back(prev); // last step may have been merged away
+            }
+            inRun = false;
+        };
+        for (const auto &wp : waypoints)
+        {
+            glm::vec2 cur = mapWorldToScreen(wp.position);
+            bool visible = std::max(prev.x, cur.x) >= lo.x && std::min(prev.x, cur.x) <= hi.x &&
+                           std::max(prev.y, cur.y) >= lo.y && std::min(prev.y, cur.y) <= hi.y;
+            if (!visible)
+            {
+                if (inRun)
+                {
+                    closeRun();
+                }
+                prev = cur;
+                continue;
+            }
+            if (!inRun)
+            {
+                mapRouteRuns_.push_back(static_cast<uint32_t>(mapRoutePoints_.size()));
+                mapRoutePoints_.push_back(prev);
+                inRun = true;
+            }
+            glm::vec2 step = cur - mapRoutePoints_.back();
+            if (glm::dot(step, step) >= ROUTE_MIN_STEP_PX * ROUTE_MIN_STEP_PX)
+            {
+                mapRoutePoints_.push_back(cur);
+            }
+            prev = cur;
+        }
+        if (inRun)
+        {
+            closeRun();
+        }
+        mapRouteRuns_.push_back(static_cast<uint32_t>(mapRoutePoints_.size()));
+
+        // Markers: visible waypoints from the grid, in index order
+        ensureWaypointGrid();
+        glm::vec3 worldLo = mapScreenToWorld(glm::vec2(lo.x, hi.y)); // screen Y grows as world Z shrinks
+        glm::vec3 worldHi = mapScreenToWorld(glm::vec2(hi.x, lo.y));
+        visibleScratch_.clear();
+        waypointGrid_.forEachInRect(glm::vec2(worldLo.x, worldLo.z), glm::vec2(worldHi.x, worldHi.z),
+                                    [&](uint32_t id)
+                                    { visibleScratch_.push_back(id); });
+        std::sort(visibleScratch_.begin(), visibleScratch_.end());
+
+        if (visibleScratch_.size() <= CLUSTER_MIN_VISIBLE)
+        {
+            for (uint32_t id : visibleScratch_)
+            {
+                mapMarkers_.push_back({mapWorldToScreen(waypoints[id].position), 1, id});
+            }
+            return;
+        }
+
+        // Zoomed out over a dense route: waypoints sharing a screen cell become one marker
+        const int cols = static_cast<int>(std::ceil((hi.x - lo.x) / CLUSTER_CELL_PX));
+        const int rows = static_cast<int>(std::ceil((hi.y - lo.y) / CLUSTER_CELL_PX));
+        clusterBins_.assign(static_cast<size_t>(cols) * rows, util::SpatialGrid::NONE);
+        for (uint32_t id : visibleScratch_)
+        {
+            glm::vec2 p = mapWorldToScreen(waypoints[id].position);
+            int cx = std::clamp(static_cast<int>((p.x - lo.x) / CLUSTER_CELL_PX), 0, cols - 1);
+            int cy = std::clamp(static_cast<int>((p.y - lo.y) / CLUSTER_CELL_PX), 0, rows - 1);
+            uint32_t &bin = clusterBins_[static_cast<size_t>(cy) * cols + cx];
+            if (bin == util::SpatialGrid::NONE)
+            {
+                bin = static_cast<uint32_t>(mapMarkers_.size());
+                mapMarkers_.push_back({p, 1, id});
+            }
+            else
+            {
+                MapMarker &marker = mapMarkers_[bin];
+                marker.screen += p; // summed now, averaged below
+                ++marker.count;
+            }
+        }
+        for (MapMarker &marker : mapMarkers_)
+        {
+            if (marker.count > 1)
+            {
+                marker.screen /= static_cast<float>(marker.count);
+            }
+        }
+    }
+
+    void MissionPlanner::rebuildProfileCache()
+    {
+        profileCacheRevision_ = routeCacheRevision_;
+        profileCacheRect_ = glm::vec4(profileOrigin_, profileSize_);
+        profileLine_.clear();
+
+        // Determine scales
+        float totalDist = std::max(100.0f, routeCumulative_.back());
+        float maxAlt = std::max(3000.0f, routeMaxAltitude_) * 1.2f; // minimum scale plus margin
+        profileScale_ = glm::vec2((profileSize_.x - 80.0f) / totalDist, (profileSize_.y - 60.0f) / maxAlt);
+        profileBase_ = glm::vec2(profileOrigin_.x + 40.0f, profileOrigin_.y + profileSize_.y - 20.0f);
+
+        // Per pixel column keep the entry, lowest, highest and exit points, so peaks survive
+        const size_t nodeCount = routeCumulative_.size();
+        profileLine_.reserve(std::min(nodeCount, static_cast<size_t>(std::max(0.0f, profileSize_.x)) * 4 + 4));
+        auto nodeScreen = [&](size_t node)
+        {
+            float altitude = node == 0 ? workingMission_.startPosition.y : workingMission_.waypoints[node - 1].position.y;
+            return profileBase_ + glm::vec2(routeCumulative_[node] * profileScale_.x, -altitude * profileScale_.y);
+        };
+        auto emit = [&](const glm::vec2 &p)
+        {
+            if (profileLine_.empty() || profileLine_.back() != p)
+            {
+                profileLine_.push_back(p);
+            }
+        };
+        size_t node = 0;
+        while (node < nodeCount)
+        {
+            glm::vec2 entry = nodeScreen(node);
+            float column = std::floor(entry.x);
+            glm::vec2 low = entry, high = entry, exit = entry;
+            size_t lowNode = node, highNode = node;
+            size_t next = node + 1;
+            for (; next < nodeCount; ++next)
+            {
+                glm::vec2 p = nodeScreen(next);
+                if (std::floor(p.x) != column)
+                {
+                    break;
+                }
+                if (p.y > low.y) // screen Y: larger is lower
+                {
+                    low = p;
+                    lowNode = next;
+                }
+                if (p.y < high.y)
+                {
+                    high = p;
+                    highNode = next;
+                }
+                exit = p;
+            }
+            emit(entry);
+            if (lowNode < highNode)
+            {
+                emit(low);
+                emit(high);
+            }
+            else
+            {
+                emit(high);
+                emit(low);
+            }
+            emit(exit);
+            node = next;
+        }
+    }
+
+    // -----------------------------------------------------------------------------
+    // Storyboard scrolling
+    // -----------------------------------------------------------------------------
+    void MissionPlanner::scrollStoryboard(int firstCard)
+    {
+        int page = static_cast<int>(maxVisibleCards());
+        int total = static_cast<int>(workingMission_.waypoints.size());
+        firstCard_ = std::clamp(firstCard, 0, std::max(0, total - page));
+    }
+
+    // -----------------------------------------------------------------------------
+    // Frame timing
+    // -----------------------------------------------------------------------------
+    void MissionPlanner::benchmarkRender(int frames)
+    {
+        if (frames <= 0 || !renderer_)
+            return;
+
+        // Frame the whole route so every waypoint is in view (worst case for the map)
+        glm::vec2 savedCenter = mapCenter_;
+        float savedExtent = mapHalfExtent_;
+        glm::vec2 lo(workingMission_.startPosition.x, workingMission_.startPosition.z);
+        glm::vec2 hi = lo;
+        for (const auto &wp : workingMission_.waypoints)
+        {
+            lo = glm::min(lo, glm::vec2(wp.position.x, wp.position.z));
+            hi = glm::max(hi, glm::vec2(wp.position.x, wp.position.z));
+        }
+        mapCenter_ = (lo + hi) * 0.5f;
+        mapHalfExtent_ = std::max(2000.0f, std::max(hi.x - lo.x, hi.y - lo.y) * 0.55f);
+
+        std::cout << std::fixed << std::setprecision(3)
+                  << "[MissionPlanner] Frame time, " << workingMission_.waypoints.size() << " waypoints:" << std::endl;
+
+        for (bool panning : {false, true})
+        {
+            renderFrame(); // warm-up
+            glFinish();
+
+            double cpuMs = 0.0;
+            auto start = std::chrono::steady_clock::now();
+            for (int frame = 0; frame < frames; ++frame)
+            {
+                if (panning)
+                {
+                    mapCenter_.x += 1.0f;
+                }
+                auto cpuStart = std::chrono::steady_clock::now();
+                renderFrame();
+                cpuMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - cpuStart).count();
+                glFinish();
+            }
+            double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / frames;
+
+            std::cout << "  " << (panning ? "panning: " : "cached:  ") << ms << " ms/frame ("
+                      << cpuMs / frames << " ms CPU), " << stats_.waypointsDrawn << " markers + "
+                      << stats_.clustersDrawn << " clusters, " << stats_.routePoints << " route points, "
+                      << stats_.cardsDrawn << " cards, " << renderer_->drawCalls() << " draw calls" << std::endl;
+        }
+        std::cout << std::defaultfloat;
+
+        mapCenter_ = savedCenter;
+        mapHalfExtent_ = savedExtent;
+    }
+
+    // -----------------------------------------------------------------------------
+    // Route optimization
+    // -----------------------------------------------------------------------------
+    void MissionPlanner::startRouteOptimization(bool weighAltitude)
+    {
+        if (workingMission_.waypoints.size() < 2)
+        {
+            return;
+        }
+        routeSnapshot_.clear();
+        routeSnapshot_.reserve(workingMission_.waypoints.size());
+        for (const auto &wp : workingMission_.waypoints)
+        {
+            routeSnapshot_.push_back(wp.position);
+        }
+        mission::RouteOptions options;
+        options.altitudeWeight = weighAltitude ? ROUTE_ALTITUDE_WEIGHT : 0.0f;
+        routeResultValid_ = false;
+        routeOptimizer_.start(workingMission_.startPosition, routeSnapshot_, options);
+    }
+
+    void MissionPlanner::pollRouteOptimization()
+    {
+        mission::RouteResult route;
+        if (!routeOptimizer_.poll(route) || route.cancelled)
+        {
+            return;
+        }
+        // Waypoints edited while the optimizer ran: the order no longer applies
+        const auto &waypoints = workingMission_.waypoints;
+        bool unchanged = waypoints.size() == routeSnapshot_.size() && route.order.size() == waypoints.size();
+        for (size_t i = 0; unchanged && i < waypoints.size(); ++i)
+        {
+            unchanged = waypoints[i].position == routeSnapshot_[i];
+        }
+        if (!unchanged)
+        {
+            std::cout << "[MissionPlanner] Route optimization discarded: waypoints changed meanwhile" << std::endl;
+            return;
+        }
+
+        if (route.cost < route.initialCost)
+        {
+            // Names travel with their positions, so a renamed route stays readable
+            std::vector<mission::WaypointDef> reordered;
+            reordered.reserve(waypoints.size());
+            for (uint32_t index : route.order)
+            {
+                reordered.push_back(waypoints[index]);
+            }
+            workingMission_.waypoints = std::move(reordered);
+            waypointGridDirty_ = true;
+            markMissionChanged();
+            selectedIndex_ = -1;
+            draggingXY_ = false;
+            draggingIndex_ = -1;
+            hoveredCardIndex_ = -1;
+        }
+
+        routeResultValid_ = true;
+        routeImprovement_ = route.initialCost > 0.0 ? static_cast<float>(1.0 - route.cost / route.initialCost) : 0.0f;
+        routeElapsedMs_ = static_cast<float>(route.elapsedMs);
+        std::cout << "[MissionPlanner] Route optimized: " << std::fixed << std::setprecision(1)
+                  << route.initialCost / 1000.0 << " km -> " << route.cost / 1000.0 << " km (-"
+                  << routeImprovement_ * 100.0f << "%) in " << std::setprecision(0) << route.elapsedMs << " ms"
+                  << std::defaultfloat << std::endl;
     }
 
     bool MissionPlanner::validateMission() const
@@ -1032,14 +1471,18 @@ namespace ui
             return;
         }
         out << "{\n";
-        out << "  \"id\": \"" << workingMission_.id << "\",\n";
-        out << "  \"name\": \"" << workingMission_.name << "\",\n";
-        out << "  \"description\": \"" << workingMission_.description << "\",\n";
-        out << "  \"category\": \"" << workingMission_.category << "\",\n";
+        out << "  \"id\": " << util::quoteJsonString(workingMission_.id) << ",\n";
+        out << "  \"name\": " << util::quoteJsonString(workingMission_.name) << ",\n";
+        out << "  \"description\": " << util::quoteJsonString(workingMission_.description) << ",\n";
+        out << "  \"category\": " << util::quoteJsonString(workingMission_.category) << ",\n";
         out << "  \"difficulty\": " << workingMission_.difficulty << ",\n";
+        if (workingMission_.waypointOrder == mission::WaypointOrder::Any)
+        {
+            out << "  \"waypointOrder\": \"any\",\n";
+        }
         out << "  \"environment\": {\n";
-        out << "    \"timeOfDay\": \"" << workingMission_.environment.timeOfDay << "\",\n";
-        out << "    \"weather\": \"" << workingMission_.environment.weather << "\",\n";
+        out << "    \"timeOfDay\": " << util::quoteJsonString(workingMission_.environment.timeOfDay) << ",\n";
+        out << "    \"weather\": " << util::quoteJsonString(workingMission_.environment.weather) << ",\n";
         out << "    \"windSpeed\": " << workingMission_.environment.windSpeed << ",\n";
         out << "    \"windDirection\": " << workingMission_.environment.windDirection << "\n";
         out << "  },\n";
@@ -1048,82 +1491,64 @@ namespace ui
         for (size_t i = 0; i < workingMission_.waypoints.size(); ++i)
         {
             const auto &wp = workingMission_.waypoints[i];
-            out << "    { \"name\": \"" << wp.name << "\", \"position\": { \"x\": " << wp.position.x << ", \"y\": " << wp.position.y << ", \"z\": " << wp.position.z << " } }";
+            out << "    { \"name\": " << util::quoteJsonString(wp.name) << ", \"position\": { \"x\": " << wp.position.x << ", \"y\": " << wp.position.y << ", \"z\": " << wp.position.z << " } }";
             if (i + 1 < workingMission_.waypoints.size())
             {
                 out << ",";
             }
             out << "\n";
         }
-        out << "  ]\n";
-        out << "}\n";
+        out << "  ]";
+
+        // Zones and triggers aren't edited here, but they round-trip
+        if (!workingMission_.zones.empty())
+        {
+            out << ",\n  \"zones\": [\n";
+            for (size_t i = 0; i < workingMission_.zones.size(); ++i)
+            {
+                const auto &zone = workingMission_.zones[i];
+                out << "    { \"id\": " << util::quoteJsonString(zone.id) << ", \"center\": { \"x\": " << zone.center.x << ", \"y\": " << zone.center.y << ", \"z\": " << zone.center.z
+                    << " }, \"radius\": " << zone.radius << ", \"minAltitude\": " << zone.minAltitude << ", \"maxAltitude\": " << zone.maxAltitude << " }";
+                out << (i + 1 < workingMission_.zones.size() ? ",\n" : "\n");
+            }
+            out << "  ]";
+        }
+        if (!workingMission_.triggers.empty())
+        {
+            static const char *const ACTIONS[] = {"message", "objective", "penalty", "complete"};
+            out << ",\n  \"triggers\": [\n";
+            for (size_t i = 0; i < workingMission_.triggers.size(); ++i)
+            {
+                const auto &trigger = workingMission_.triggers[i];
+                out << "    { \"id\": " << util::quoteJsonString(trigger.id) << ", \"when\": " << util::quoteJsonString(trigger.condition)
+                    << ", \"action\": \"" << ACTIONS[static_cast<int>(trigger.action)] << "\"";
+                if (!trigger.message.empty())
+                {
+                    out << ", \"message\": " << util::quoteJsonString(trigger.message);
+                }
+                if (!trigger.after.empty())
+                {
+                    out << ", \"after\": " << util::quoteJsonString(trigger.after);
+                }
+                out << ", \"within\": " << trigger.within << ", \"hold\": " << trigger.hold
+                    << ", \"repeat\": " << (trigger.repeat ? "true" : "false") << " }";
+                out << (i + 1 < workingMission_.triggers.size() ? ",\n" : "\n");
+            }
+            out << "  ]";
+        }
+        out << "\n}\n";
         out.close();
     }
 
     void MissionPlanner::loadMissionFromFile(const std::string &path)
     {
-        // Simple load: reading entire file and delegating to MissionRegistry is not available here
-        std::ifstream in(path);
-        if (!in.is_open())
+        // Same streaming parser as the mission registry, waypoints included
+        mission::MissionDefinition m;
+        if (!mission::MissionRegistry::parseMissionFile(path, m))
         {
-            std::cerr << "Could not open file for reading: " << path << std::endl;
+            std::cerr << "Could not load mission from: " << path << std::endl;
             return;
         }
-        std::stringstream buffer;
-        buffer << in.rdbuf();
-        in.close();
-        // Delegating to registry would be better, but rudimentary parsing for basic fields
-        std::string content = buffer.str();
-        auto extractString = [&](const std::string &key)
-        {
-            std::string search = "\"" + key + "\"";
-            size_t kpos = content.find(search);
-            if (kpos == std::string::npos)
-                return std::string();
-            size_t colon = content.find(':', kpos);
-            size_t firstQuote = content.find('"', colon);
-            size_t secondQuote = content.find('"', firstQuote + 1);
-            if (firstQuote == std::string::npos || secondQuote == std::string::npos)
-                return std::string();
-            return content.substr(firstQuote + 1, secondQuote - firstQuote - 1);
-        };
-        auto extractFloat = [&](const std::string &key, float def)
-        {
-            std::string search = "\"" + key + "\"";
-            size_t kpos = content.find(search);
-            if (kpos == std::string::npos)
-                return def;
-            size_t colon = content.find(':', kpos);
-            size_t valStart = colon + 1;
-            while (valStart < content.size() && (content[valStart] == ' ' || content[valStart] == '\n' || content[valStart] == '\t'))
-                ++valStart;
-            size_t valEnd = valStart;
-            while (valEnd < content.size() && content[valEnd] != ',' && content[valEnd] != '}' && content[valEnd] != ']')
-                ++valEnd;
-            std::string v = content.substr(valStart, valEnd - valStart);
-            try
-            {
-                return std::stof(v);
-            }
-            catch (...)
-            {
-                return def;
-            }
-        };
-        mission::MissionDefinition m;
-        m.id = extractString("id");
-        m.name = extractString("name");
-        m.description = extractString("description");
-        m.category = extractString("category");
-        m.environment.timeOfDay = extractString("timeOfDay");
-        m.environment.weather = extractString("weather");
-        m.environment.windSpeed = extractFloat("windSpeed", 0.0f);
-        m.environment.windDirection = extractFloat("windDirection", 0.0f);
-        // Read startPosition
-        m.startPosition.x = extractFloat("x", 0.0f);
-        m.startPosition.y = extractFloat("y", 1500.0f);
-        m.startPosition.z = extractFloat("z", 0.0f);
-        // Waypoints are not parsed in this method
         loadMission(m);
     }
 
@@ -17,17 +17,25 @@
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <vector>
 #include <string>
+#include <string_view>
 #include <glm/glm.hpp>
 
+#include "../../core/FrameArena.h"
 #include "../../mission/MissionDefinition.h"
+#include "../../mission/RouteOptimizer.h"
 #include "../../gfx/rendering/Renderer2D.h"
 #include "../../gfx/rendering/TextRenderer.h"
 #include "../../gfx/rendering/TrueTypeFont.h"
+#include "../../util/SpatialGrid.h"
 
-// Forward declaration of GLFWwindow struct to avoid including GLFW in header
-struct GLFWwindow;
+namespace core
+{
+    class InputSystem;
+}
 
 namespace ui
 {
@@ -45,6 +53,19 @@ namespace ui
         bool cancelRequested = false;
     };
 
+    /**
+     * @brief Cost of the last planner frame and what it drew.
+     */
+    struct PlannerRenderStats
+    {
+        float cpuMs = 0.0f;             ///< Wall time spent inside render() on the CPU.
+        std::size_t drawCalls = 0;      ///< Renderer2D flushes that issued a draw.
+        std::size_t waypointsDrawn = 0; ///< Map markers standing for a single waypoint.
+        std::size_t clustersDrawn = 0;  ///< Map markers standing for several waypoints.
+        std::size_t routePoints = 0;    ///< Map polyline vertices left after culling and decimation.
+        std::size_t cardsDrawn = 0;     ///< Storyboard cards laid out.
+    };
+
     /**
      * @brief Mission planner with graphical waypoint editing.
      *
@@ -74,6 +95,22 @@ namespace ui
          */
         void setScreenSize(int width, int height);
 
+        /**
+         * @brief Attaches the per-frame scratch arena used for labels and polylines.
+         *
+         * The arena is owned by core::Application and reset at the start of every
+         * frame, so nothing built from it may outlive render().
+         */
+        void setFrameArena(core::FrameArena *arena) { frameArena_ = arena; }
+
+        /**
+         * @brief Shares the application job pool with the route optimizer.
+         *
+         * Restarts of the optimization are spread across the pool's threads; the
+         * optimizer itself runs on a background thread so the planner never blocks.
+         */
+        void setJobPool(core::JobPool *jobPool) { routeOptimizer_.setJobPool(jobPool); }
+
         /**
          * @brief Loads an existing mission for editing.
          * @param mission Mission definition to edit.
@@ -86,16 +123,28 @@ namespace ui
 
         /**
          * @brief Updates planner state.
-         * @param window Pointer to GLFW window for reading inputs.
+         * @param input Actions and cursor position of this frame.
          * @param deltaTime Time in seconds elapsed since last frame.
          */
-        void update(GLFWwindow *window, float deltaTime);
+        void update(const core::InputSystem &input, float deltaTime);
 
         /**
          * @brief Draws the planner interface.
          */
         void render();
 
+        const PlannerRenderStats &stats() const { return stats_; }
+
+        /**
+         * @brief Time the planner framed on the whole route, with warm caches and while panning.
+         * @param frames Frames rendered per mode.
+         *
+         * Panning moves the view one meter per frame so the map caches are
+         * rebuilt every time. Each frame is followed by glFinish() so the
+         * result includes GPU time. Results are logged to stdout. Bound to B.
+         */
+        void benchmarkRender(int frames = 60);
+
         /**
          * @brief Returns the planner interaction state.
          */
@@ -145,9 +194,10 @@ namespace ui
     private:
         // === Internal Methods ===
         void updateLayout();
-        void handleKeyboardInput(GLFWwindow *window, float deltaTime);
-        void handleMouseInput(GLFWwindow *window);
+        void handleKeyboardInput(const core::InputSystem &input, float deltaTime);
+        void handleMouseInput(const core::InputSystem &input);
         void updateStoryboardHover();
+        void renderFrame();
         void renderBackground();
         void renderToolbar();
         void renderMap();
@@ -155,10 +205,10 @@ namespace ui
         void renderStoryboard();
         void renderInstructions();
         void renderStartButton();
-        void drawPlannerText(const std::string &text, const glm::vec2 &anchorPoint, float size,
+        void drawPlannerText(std::string_view text, const glm::vec2 &anchorPoint, float size,
                              const glm::vec4 &color, const glm::vec2 &anchor = glm::vec2(0.5f),
                              float lineSpacing = 1.0f);
-        glm::vec2 plannerTextSize(const std::string &text, float size, float lineSpacing = 1.0f) const;
+        glm::vec2 plannerTextSize(std::string_view text, float size, float lineSpacing = 1.0f) const;
 
         glm::vec2 mapWorldToScreen(const glm::vec3 &world) const;
         glm::vec3 mapScreenToWorld(const glm::vec2 &screen) const;
@@ -169,9 +219,18 @@ namespace ui
         bool cursorInsideProfile() const;
         bool cursorInsideStoryboard() const;
         float computeMissionLength() const;
+        void markMissionChanged() { ++missionRevision_; }
+        void refreshRouteCache();
+        void rebuildMapCache();
+        void rebuildProfileCache();
+        void ensureWaypointGrid() const;
+        void scrollStoryboard(int firstCard);
+        void startRouteOptimization(bool weighAltitude);
+        void pollRouteOptimization();
 
         // === Members ===
         gfx::Renderer2D *renderer_ = nullptr;       ///< Shared 2D renderer
+        core::FrameArena *frameArena_ = nullptr;    ///< Per-frame scratch memory (owned by Application)
         mission::MissionDefinition workingMission_; ///< Mission under construction
         PlannerResult result_;                      ///< Result of the last interaction
 
@@ -198,13 +257,52 @@ namespace ui
         bool draggingXY_ = false; ///< Waypoint is being dragged in XZ plane
         int draggingIndex_ = -1;  ///< Index of waypoint being dragged
 
-        // Button/key state flags
-        bool leftMouseHeld_ = false;
-        bool rightMouseHeld_ = false;
-        bool enterHeld_ = false;
-        bool escHeld_ = false;
-        bool rHeld_ = false;
-        bool fHeld_ = false;
+        // Hit-testing index over waypoint XZ positions; rebuilt lazily after inserts/erases
+        mutable util::SpatialGrid waypointGrid_;
+        mutable bool waypointGridDirty_ = true;
+
+        // Route caches: rebuilt only when the mission (or, for the map and profile, the view) changes
+        uint64_t missionRevision_ = 1;       ///< Bumped on every edit of workingMission_
+        uint64_t routeCacheRevision_ = 0;    ///< missionRevision_ the caches below were built from
+        std::vector<float> routeCumulative_; ///< XZ distance from the start to node i (0 = start)
+        float routeMaxAltitude_ = 0.0f;
+
+        /// Map marker: one waypoint, or a cluster of those sharing a screen cell when zoomed out.
+        struct MapMarker
+        {
+            glm::vec2 screen;
+            uint32_t count; ///< Waypoints represented
+            uint32_t index; ///< Lowest waypoint index among them
+        };
+        uint64_t mapCacheRevision_ = 0;
+        glm::vec3 mapCacheView_ = glm::vec3(0.0f); ///< Center and half extent the map cache was built for
+        glm::vec4 mapCacheRect_ = glm::vec4(0.0f); ///< Map origin and size the map cache was built for
+        std::vector<glm::vec2> mapRoutePoints_;    ///< Visible route runs in screen space
+        std::vector<uint32_t> mapRouteRuns_;       ///< Run start offsets into mapRoutePoints_, plus the end
+        std::vector<MapMarker> mapMarkers_;
+        std::vector<uint32_t> visibleScratch_;
+        std::vector<uint32_t> clusterBins_;
+
+        uint64_t profileCacheRevision_ = 0;
+        glm::vec4 profileCacheRect_ = glm::vec4(0.0f);
+        std::vector<glm::vec2> profileLine_; ///< Altitude curve, at most a few vertices per pixel column
+        glm::vec2 profileScale_ = glm::vec2(1.0f);
+        glm::vec2 profileBase_ = glm::vec2(0.0f);
+
+        // Virtualized storyboard
+        int firstCard_ = 0;          ///< First waypoint shown in the storyboard (scroll offset)
+        int scrollFollowIndex_ = -1; ///< Selection the scroll last followed
+        PlannerRenderStats stats_;
+        bool benchmarkRequested_ = false;
+
+        bool leftMouseHeld_ = false; ///< Left button down at the end of the last update (waypoint drag)
+
+        // Asynchronous route optimization (O key)
+        mission::RouteOptimizer routeOptimizer_;
+        std::vector<glm::vec3> routeSnapshot_; ///< Waypoint positions handed to the optimizer
+        bool routeResultValid_ = false;        ///< A finished run is shown in the toolbar
+        float routeImprovement_ = 0.0f;        ///< Fraction of length saved by the last run
+        float routeElapsedMs_ = 0.0f;
 
         // Hover and selection states
         bool startButtonHovered_ = false;
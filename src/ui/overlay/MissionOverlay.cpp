@@ -6,7 +6,9 @@
 #include "MissionOverlay.h"
 #include "../../mission/MissionDefinition.h"
 #include "../../mission/MissionRuntime.h"
-#include <GLFW/glfw3.h>
+#include "../../gfx/core/RenderState.h"
+#include "../../core/InputSystem.h"
+#include <algorithm>
 #include <sstream>
 #include <iomanip>
 #include <iostream>
@@ -21,7 +23,7 @@ namespace ui
 {
 
     MissionOverlay::MissionOverlay()
-        : screenWidth_(1280), screenHeight_(720), visible_(false), showingBriefing_(false), showingCompletion_(false), readyToFly_(false), completionChoice_(CompletionChoice::None), selectedOption_(0), fadeAlpha_(0.0f), blinkTimer_(0.0f), enterKeyWasPressed_(false), spaceKeyWasPressed_(false), tabKeyWasPressed_(false), upKeyWasPressed_(false), downKeyWasPressed_(false)
+        : screenWidth_(1280), screenHeight_(720), visible_(false), showingBriefing_(false), showingCompletion_(false), readyToFly_(false), completionChoice_(CompletionChoice::None), selectedOption_(0), fadeAlpha_(0.0f), blinkTimer_(0.0f)
     {
     }
 
@@ -135,8 +137,8 @@ namespace ui
             return;
         }
 
-        glEnable(GL_BLEND);
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        gfx::RenderState::setBlend(true);
+        gfx::RenderState::setBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
         renderer_.begin();
         drawBackground(fadeAlpha_);
@@ -151,7 +153,7 @@ namespace ui
         }
 
         renderer_.end();
-        glDisable(GL_BLEND);
+        gfx::RenderState::setBlend(false);
     }
 
     void MissionOverlay::update(float dt)
@@ -175,7 +177,7 @@ namespace ui
             blinkTimer_ = 0.0f; // 2*PI for full cycle
     }
 
-    bool MissionOverlay::handleInput(GLFWwindow *window)
+    bool MissionOverlay::handleInput(const core::InputSystem &input)
     {
         if (!visible_)
         {
@@ -184,12 +186,10 @@ namespace ui
 
         bool actionTaken = false;
 
-        // Detect keys with debounce
-        bool enterPressed = glfwGetKey(window, GLFW_KEY_ENTER) == GLFW_PRESS;
-        bool spacePressed = glfwGetKey(window, GLFW_KEY_SPACE) == GLFW_PRESS;
-        bool tabPressed = glfwGetKey(window, GLFW_KEY_TAB) == GLFW_PRESS;
-        bool upPressed = glfwGetKey(window, GLFW_KEY_UP) == GLFW_PRESS;
-        bool downPressed = glfwGetKey(window, GLFW_KEY_DOWN) == GLFW_PRESS;
+        // Presses of this frame (edges come from the input queue)
+        bool enterPressed = input.pressed(core::InputAction::Confirm);
+        bool spacePressed = input.pressed(core::InputAction::FreeFlight);
+        bool tabPressed = input.pressed(core::InputAction::ReturnToMenu);
 
         // DEBUG: Show key state
         static int debugCounter = 0;
@@ -207,7 +207,7 @@ namespace ui
         // ========================================================================
         if (showingBriefing_)
         {
-            if (enterPressed && !enterKeyWasPressed_)
+            if (enterPressed)
             {
                 readyToFly_ = true;
                 actionTaken = true;
@@ -223,7 +223,7 @@ namespace ui
             std::cout << "[MissionOverlay DEBUG] In completion mode, detecting keys..." << std::endl;
 
             // SPACE to continue in free flight
-            if (spacePressed && !spaceKeyWasPressed_)
+            if (spacePressed)
             {
                 completionChoice_ = CompletionChoice::FreeFlight;
                 selectedOption_ = 1;
@@ -232,7 +232,7 @@ namespace ui
             }
 
             // TAB to return to menu
-            if (tabPressed && !tabKeyWasPressed_)
+            if (tabPressed)
             {
                 completionChoice_ = CompletionChoice::ReturnToMenu;
                 selectedOption_ = 0;
@@ -241,13 +241,6 @@ namespace ui
             }
         }
 
-        // Update key state
-        enterKeyWasPressed_ = enterPressed;
-        spaceKeyWasPressed_ = spacePressed;
-        tabKeyWasPressed_ = tabPressed;
-        upKeyWasPressed_ = upPressed;
-        downKeyWasPressed_ = downPressed;
-
         return actionTaken;
     }
 
@@ -261,11 +254,6 @@ namespace ui
         selectedOption_ = 0;
         fadeAlpha_ = 0.0f;
         blinkTimer_ = 0.0f;
-        enterKeyWasPressed_ = false;
-        spaceKeyWasPressed_ = false;
-        tabKeyWasPressed_ = false;
-        upKeyWasPressed_ = false;
-        downKeyWasPressed_ = false;
     }
 
     void MissionOverlay::renderBriefing()
@@ -281,7 +269,7 @@ namespace ui
         // Larger and prominent title
         const glm::vec2 titlePos(panelX + panelW * 0.5f, panelY + 55.0f);
         const glm::vec4 titleColor(0.35f, 0.90f, 1.0f, 1.0f);
-        drawOverlayText(missionName_.empty() ? "MISSION BRIEFING" : missionName_,
+        drawOverlayText(missionName_.empty() ? std::string_view("MISSION BRIEFING") : std::string_view(missionName_),
                         titlePos, 34.0f, titleColor, glm::vec2(0.5f, 0.5f));
 
         auto lines = splitLines(briefingText_);
@@ -295,7 +283,7 @@ namespace ui
         const glm::vec4 bodyColor(0.85f, 0.92f, 1.0f, 0.95f);
         for (const auto &line : lines)
         {
-            drawOverlayText(line.empty() ? " " : line,
+            drawOverlayText(line.empty() ? std::string_view(" ") : line,
                             glm::vec2(panelX + panelW * 0.5f, textY),
                             22.0f, bodyColor, glm::vec2(0.5f, 0.0f));
             textY += 28.0f;
@@ -316,7 +304,7 @@ namespace ui
     void MissionOverlay::renderCompletion()
     {
         const float panelW = screenWidth_ * 0.50f;
-        const float panelH = screenHeight_ * 0.50f;
+        const float panelH = screenHeight_ * 0.72f; // Room for the recorder's aggregates
         const float panelX = (screenWidth_ - panelW) * 0.5f;
         const float panelY = (screenHeight_ - panelH) * 0.5f;
 
@@ -324,7 +312,7 @@ namespace ui
 
         // Larger title
         const glm::vec4 titleColor(1.0f, 0.9f, 0.5f, 1.0f);
-        drawOverlayText(missionName_.empty() ? "MISSION COMPLETED" : missionName_,
+        drawOverlayText(missionName_.empty() ? std::string_view("MISSION COMPLETED") : std::string_view(missionName_),
                         glm::vec2(panelX + panelW * 0.5f, panelY + 55.0f),
                         32.0f, titleColor, glm::vec2(0.5f, 0.5f));
 
@@ -334,7 +322,7 @@ namespace ui
         const glm::vec4 metricsColor(0.85f, 0.95f, 1.0f, 0.95f);
         for (const auto &line : metricsLines)
         {
-            drawOverlayText(line.empty() ? " " : line,
+            drawOverlayText(line.empty() ? std::string_view(" ") : line,
                             glm::vec2(panelX + panelW * 0.5f, textY),
                             22.0f, metricsColor, glm::vec2(0.5f, 0.0f));
             textY += 28.0f;
@@ -345,7 +333,7 @@ namespace ui
         const float optionSpacing = 45.0f;
         const float blinkAlpha = 0.6f + 0.4f * std::sin(blinkTimer_ * 4.0f);
 
-        auto drawOption = [&](const std::string &label, float x, float y, bool highlighted)
+        auto drawOption = [&](std::string_view label, float x, float y, bool highlighted)
         {
             glm::vec4 color = highlighted
                                   ? glm::vec4(0.4f, 0.9f, 1.0f, blinkAlpha)
@@ -393,24 +381,53 @@ namespace ui
         std::stringstream ss;
         ss << std::fixed << std::setprecision(0);
         ss << "WAYPOINTS   " << metrics.waypointsCaptured << "/" << metrics.totalWaypoints << "\n";
+        if (metrics.totalObjectives > 0)
+        {
+            ss << "OBJECTIVES  " << metrics.objectivesCompleted << "/" << metrics.totalObjectives << "\n";
+        }
         ss << "TIME        " << metrics.totalTimeSeconds << " s\n";
         ss << "SPEED       " << metrics.averageSpeed << " kt\n";
-        ss << "MAX ALTITUDE " << metrics.maxAltitude << " ft";
+        ss << "MAX ALTITUDE " << metrics.maxAltitude << " ft\n";
+        ss << std::setprecision(1);
+        ss << "DISTANCE    " << metrics.distance / 1000.0f << " km\n";
+        ss << "G RANGE     " << metrics.minGForce << " / " << metrics.maxGForce << " G\n";
+        ss << std::setprecision(0);
+        ss << "FUEL        " << metrics.fuelUsed << " thr-s";
+
+        // Slowest leg: where the debrief should look first
+        const auto &legs = runtime.getRecorder().legs();
+        if (!legs.empty())
+        {
+            auto slowest = std::max_element(legs.begin(), legs.end(),
+                                            [](const mission::LegStats &a, const mission::LegStats &b)
+                                            {
+                                                return a.duration < b.duration;
+                                            });
+            ss << "\nLEGS " << legs.size() << "  SLOWEST #" << (slowest - legs.begin()) + 1 << "  "
+               << slowest->duration << " s " << slowest->averageSpeed << " kt";
+        }
         return ss.str();
     }
 
-    std::vector<std::string> MissionOverlay::splitLines(const std::string &text) const
+    core::FrameVector<std::string_view> MissionOverlay::splitLines(std::string_view text) const
     {
-        std::vector<std::string> lines;
-        std::stringstream ss(text);
-        std::string line;
-        while (std::getline(ss, line))
+        // Lines are views into `text`; only the view array lives in the frame arena.
+        auto lines = core::makeFrameVector<std::string_view>(frameArena_, 16);
+        size_t start = 0;
+        while (start < text.size())
         {
+            size_t end = text.find('\n', start);
+            if (end == std::string_view::npos)
+            {
+                end = text.size();
+            }
+            std::string_view line = text.substr(start, end - start);
             if (!line.empty() && line.back() == '\r')
             {
-                line.pop_back();
+                line.remove_suffix(1);
             }
             lines.push_back(line);
+            start = end + 1;
         }
         if (lines.empty())
         {
@@ -419,7 +436,7 @@ namespace ui
         return lines;
     }
 
-    glm::vec2 MissionOverlay::overlayTextSize(const std::string &text, float size, float lineSpacing) const
+    glm::vec2 MissionOverlay::overlayTextSize(std::string_view text, float size, float lineSpacing) const
     {
         if (overlayFontReady_)
         {
@@ -443,7 +460,7 @@ namespace ui
         return glm::vec2(approxWidth, approxHeight);
     }
 
-    void MissionOverlay::drawOverlayText(const std::string &text, const glm::vec2 &anchorPoint, float size,
+    void MissionOverlay::drawOverlayText(std::string_view text, const glm::vec2 &anchorPoint, float size,
                                          const glm::vec4 &color, const glm::vec2 &anchor, float lineSpacing)
     {
         if (text.empty())
@@ -10,7 +10,9 @@
 #pragma once
 
 #include <string>
-#include <vector>
+#include <string_view>
+
+#include "../../core/FrameArena.h"
 
 #include <glm/glm.hpp>
 
@@ -19,7 +21,10 @@
 #include "../../gfx/rendering/TrueTypeFont.h"
 
 // Forward declarations to avoid includes
-struct GLFWwindow;
+namespace core
+{
+    class InputSystem;
+}
 
 namespace mission
 {
@@ -55,6 +60,11 @@ namespace ui
         void init(int screenWidth, int screenHeight);
         void setScreenSize(int screenWidth, int screenHeight);
 
+        /**
+         * @brief Attaches the per-frame scratch arena used for transient line splits.
+         */
+        void setFrameArena(core::FrameArena *arena) { frameArena_ = arena; }
+
         /**
          * @brief Shows the briefing of a mission
          */
@@ -84,7 +94,7 @@ namespace ui
          * @brief Processes user input
          * @return true if any action was processed
          */
-        bool handleInput(GLFWwindow *window);
+        bool handleInput(const core::InputSystem &input);
 
         /**
          * @brief Checks if the pilot is ready to fly (briefing)
@@ -112,6 +122,7 @@ namespace ui
         int screenHeight_;
         bool rendererInitialized_ = false;
         gfx::Renderer2D renderer_;
+        core::FrameArena *frameArena_ = nullptr; ///< Scratch memory reset every frame (owned by Application).
 
         // State
         bool visible_;
@@ -130,22 +141,15 @@ namespace ui
         float fadeAlpha_;
         float blinkTimer_;
 
-        // Input control
-        bool enterKeyWasPressed_;
-        bool spaceKeyWasPressed_;
-        bool tabKeyWasPressed_;
-        bool upKeyWasPressed_;
-        bool downKeyWasPressed_;
-
         // Helpers
         void renderBriefing();
         void renderCompletion();
         void drawBackground(float alpha);
         void drawBox(float x, float y, float w, float h);
         std::string formatMetrics(const mission::MissionRuntime &runtime);
-        std::vector<std::string> splitLines(const std::string &text) const;
-        glm::vec2 overlayTextSize(const std::string &text, float size, float lineSpacing = 1.0f) const;
-        void drawOverlayText(const std::string &text, const glm::vec2 &anchorPoint, float size,
+        core::FrameVector<std::string_view> splitLines(std::string_view text) const;
+        glm::vec2 overlayTextSize(std::string_view text, float size, float lineSpacing = 1.0f) const;
+        void drawOverlayText(std::string_view text, const glm::vec2 &anchorPoint, float size,
                              const glm::vec4 &color, const glm::vec2 &anchor = glm::vec2(0.5f),
                              float lineSpacing = 1.0f);
 
@@ -0,0 +1,130 @@
+/**
+ * @file ProfilerOverlay.cpp
+ * @brief Implementation of the frame profiler overlay
+ */
+
+#include "ProfilerOverlay.h"
+#include "../../core/FrameProfiler.h"
+#include "../../gfx/core/GLStats.h"
+#include "../../gfx/core/RenderState.h"
+#include "../../util/FixedString.h"
+#include <algorithm>
+#include <iostream>
+
+extern "C"
+{
+#include <glad/glad.h>
+}
+
+namespace ui
+{
+
+    namespace
+    {
+        constexpr float kMargin = 16.0f;
+        constexpr float kPadding = 10.0f;
+        constexpr float kTextSize = 15.0f;
+        constexpr int kNameColumn = 30; ///< Characters reserved for the indented phase name.
+    }
+
+    void ProfilerOverlay::init(int screenWidth, int screenHeight)
+    {
+        screenWidth_ = screenWidth;
+        screenHeight_ = screenHeight;
+        renderer_.init(screenWidth_, screenHeight_);
+        rendererInitialized_ = true;
+
+        // Small text: a 32 px bake is plenty and keeps the atlas small
+        const std::string fontPath = "assets/fonts/RobotoMono-Regular.ttf";
+        fontReady_ = font_.loadFromFile(fontPath, 32.0f, 512);
+        if (!fontReady_)
+        {
+            std::cerr << "[ProfilerOverlay] Could not load RobotoMono font at " << fontPath << std::endl;
+        }
+    }
+
+    void ProfilerOverlay::setScreenSize(int screenWidth, int screenHeight)
+    {
+        screenWidth_ = screenWidth;
+        screenHeight_ = screenHeight;
+        if (rendererInitialized_)
+        {
+            renderer_.setScreenSize(screenWidth_, screenHeight_);
+        }
+    }
+
+    void ProfilerOverlay::render(const core::FrameStats &stats)
+    {
+        if (!visible_ || !rendererInitialized_ || !fontReady_)
+        {
+            return;
+        }
+        core::ProfileScope profile("ProfilerOverlay::render", core::ProfileTiming::CpuGpu);
+
+        util::FixedString<4096> table;
+        table.format("%-*s%8s%8s%8s%8s\n", kNameColumn, "ms", "last", "min", "avg", "p99");
+
+        bool gpuSection = false;
+        for (const core::ProfilePhaseStats &phase : core::FrameProfiler::phaseStats())
+        {
+            if (phase.gpu && !gpuSection)
+            {
+                table.append("GPU\n");
+                gpuSection = true;
+            }
+            const int indent = static_cast<int>(phase.depth) * 2 + (phase.gpu ? 2 : 0);
+            table.appendFormat("%*s%-*.*s%8.2f%8.2f%8.2f%8.2f\n", indent, "", kNameColumn - indent,
+                               kNameColumn - indent - 1, phase.name, phase.lastMs, phase.minMs, phase.avgMs,
+                               phase.p99Ms);
+        }
+
+        util::FixedString<320> footer;
+        footer.format("frame %.2f ms  dt %.2f ms  wait %.2f ms  %llu spikes  %llu clamped\n", stats.frameMs,
+                      stats.smoothedFrameMs, stats.limiterWaitMs, static_cast<unsigned long long>(stats.frameSpikes),
+                      static_cast<unsigned long long>(stats.clampedFrames));
+        footer.appendFormat("state %llu set  %llu skipped\n", static_cast<unsigned long long>(stats.stateRequests),
+                            static_cast<unsigned long long>(stats.stateSkipped));
+        if (gfx::GLStats::enabled())
+        {
+            footer.appendFormat("GL %llu draws  %llu verts  %.1f KB up\n"
+                                "binds tex %llu  prog %llu  vao %llu  (%llu redundant)  %llu uniforms\n",
+                                static_cast<unsigned long long>(stats.glDrawCalls),
+                                static_cast<unsigned long long>(stats.glVertices),
+                                static_cast<double>(stats.glBufferBytes) / 1024.0,
+                                static_cast<unsigned long long>(stats.glTextureBinds),
+                                static_cast<unsigned long long>(stats.glProgramBinds),
+                                static_cast<unsigned long long>(stats.glVaoBinds),
+                                static_cast<unsigned long long>(stats.glRedundantBinds),
+                                static_cast<unsigned long long>(stats.glUniformUploads));
+        }
+        footer.appendFormat("F3 hide  F4 trace%s  dropped %llu ev / %llu gpu",
+                            core::FrameProfiler::capturing() ? " (capturing)" : "",
+                            static_cast<unsigned long long>(core::FrameProfiler::droppedEvents()),
+                            static_cast<unsigned long long>(core::FrameProfiler::droppedGpuFrames()));
+
+        const glm::vec2 tableSize = font_.measureText(table.view(), kTextSize);
+        const glm::vec2 footerSize = font_.measureText(footer.view(), kTextSize);
+        const glm::vec2 origin(kMargin, kMargin);
+        const glm::vec2 panel(std::max(tableSize.x, footerSize.x) + kPadding * 2.0f,
+                              tableSize.y + footerSize.y + kPadding * 3.0f);
+
+        // Drawn over whatever the state left bound: restore its depth test afterwards
+        const bool depthTest = gfx::RenderState::depthTest();
+        gfx::RenderState::setBlend(true);
+        gfx::RenderState::setBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        gfx::RenderState::setDepthTest(false);
+
+        renderer_.begin();
+        renderer_.drawRect(origin, panel, glm::vec4(0.02f, 0.03f, 0.05f, 0.8f), true);
+        renderer_.drawRect(origin, panel, glm::vec4(0.3f, 0.8f, 1.0f, 0.6f), false);
+        font_.drawText(renderer_, table.view(), origin + glm::vec2(kPadding), kTextSize,
+                       glm::vec4(0.9f, 0.95f, 1.0f, 1.0f));
+        font_.drawText(renderer_, footer.view(), origin + glm::vec2(kPadding, kPadding * 2.0f + tableSize.y),
+                       kTextSize, glm::vec4(0.5f, 0.7f, 0.8f, 1.0f));
+        renderer_.end();
+
+        gfx::RenderState::setDepthTest(depthTest);
+        gfx::RenderState::setBlend(false);
+    }
+
+} // namespace ui
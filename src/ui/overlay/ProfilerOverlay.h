@@ -0,0 +1,44 @@
+/**
+ * @file ProfilerOverlay.h
+ * @brief On-screen table of the frame profiler's rolling phase timings.
+ */
+
+#pragma once
+
+#include "../../gfx/rendering/Renderer2D.h"
+#include "../../gfx/rendering/TrueTypeFont.h"
+#include "../../core/FrameStats.h"
+
+namespace ui
+{
+
+    /**
+     * @brief Debug panel listing last/min/avg/p99 ms per profiled phase.
+     *
+     * Reads `core::FrameProfiler::phaseStats()`; CPU phases are indented by
+     * nesting depth and GPU passes follow in their own section. Drawn on top
+     * of every state, after the state's own rendering. GL call counts of the
+     * previous frame are added when built with `FLIGHTSIM_GL_STATS`.
+     */
+    class ProfilerOverlay
+    {
+    public:
+        void init(int screenWidth, int screenHeight);
+        void setScreenSize(int screenWidth, int screenHeight);
+
+        void setVisible(bool visible) { visible_ = visible; }
+        bool isVisible() const { return visible_; }
+
+        void render(const core::FrameStats &stats);
+
+    private:
+        gfx::Renderer2D renderer_;
+        gfx::TrueTypeFont font_;
+        bool rendererInitialized_ = false;
+        bool fontReady_ = false;
+        bool visible_ = false;
+        int screenWidth_ = 1280;
+        int screenHeight_ = 720;
+    };
+
+} // namespace ui
@@ -0,0 +1,120 @@
+/**
+ * @file FixedString.h
+ * @brief Fixed-capacity, stack-allocated string buffer for per-frame formatting.
+ *
+ * HUD labels and numeric readouts are rebuilt every frame. Formatting them with
+ * `std::to_string` or `std::ostringstream` hits the heap on each call; this
+ * buffer formats in place with `snprintf` and never allocates.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdio>
+#include <string_view>
+
+namespace util
+{
+
+    /**
+     * @brief Null-terminated character buffer with compile-time capacity.
+     *
+     * Output that does not fit is truncated (never overflows) and flagged via
+     * `truncated()`, so callers can size buffers generously without risk.
+     *
+     * @tparam Capacity Maximum number of characters, excluding the terminator.
+     */
+    template <std::size_t Capacity>
+    class FixedString
+    {
+    public:
+        FixedString() { clear(); }
+
+        /// Builds the buffer directly from a printf-style format.
+        template <typename... Args>
+        explicit FixedString(const char *fmt, Args... args) { format(fmt, args...); }
+
+        /// Replaces the content with a printf-style formatted string.
+        template <typename... Args>
+        FixedString &format(const char *fmt, Args... args)
+        {
+            size_ = 0;
+            buffer_[0] = '\0';
+            truncated_ = false;
+            return appendFormat(fmt, args...);
+        }
+
+        /// Appends printf-style formatted output to the current content.
+        template <typename... Args>
+        FixedString &appendFormat(const char *fmt, Args... args)
+        {
+            const std::size_t room = Capacity + 1 - size_;
+            int written;
+            if constexpr (sizeof...(Args) == 0)
+            {
+                written = std::snprintf(buffer_ + size_, room, "%s", fmt);
+            }
+            else
+            {
+                written = std::snprintf(buffer_ + size_, room, fmt, args...);
+            }
+
+            if (written < 0)
+            {
+                buffer_[size_] = '\0';
+                return *this;
+            }
+            if (static_cast<std::size_t>(written) >= room)
+            {
+                truncated_ = true;
+                size_ = Capacity;
+            }
+            else
+            {
+                size_ += static_cast<std::size_t>(written);
+            }
+            return *this;
+        }
+
+        /// Appends raw text, truncating if it does not fit.
+        FixedString &append(std::string_view text)
+        {
+            for (char c : text)
+            {
+                if (size_ >= Capacity)
+                {
+                    truncated_ = true;
+                    break;
+                }
+                buffer_[size_++] = c;
+            }
+            buffer_[size_] = '\0';
+            return *this;
+        }
+
+        void clear()
+        {
+            size_ = 0;
+            truncated_ = false;
+            buffer_[0] = '\0';
+        }
+
+        const char *c_str() const { return buffer_; }
+        std::string_view view() const { return std::string_view(buffer_, size_); }
+        operator std::string_view() const { return view(); }
+
+        std::size_t size() const { return size_; }
+        bool empty() const { return size_ == 0; }
+        bool truncated() const { return truncated_; }
+        static constexpr std::size_t capacity() { return Capacity; }
+
+    private:
+        char buffer_[Capacity + 1];
+        std::size_t size_ = 0;
+        bool truncated_ = false;
+    };
+
+    /// Default size for short HUD labels (numbers, headings, units).
+    using LabelString = FixedString<31>;
+
+} // namespace util
@@ -0,0 +1,715 @@
+#include "JsonReader.h"
+
+#include <charconv>
+#include <climits>
+#include <cstdio>
+
+namespace util
+{
+
+    namespace
+    {
+        bool isDigit(char c) { return c >= '0' && c <= '9'; }
+
+        int hexValue(char c)
+        {
+            if (c >= '0' && c <= '9')
+                return c - '0';
+            if (c >= 'a' && c <= 'f')
+                return c - 'a' + 10;
+            if (c >= 'A' && c <= 'F')
+                return c - 'A' + 10;
+            return -1;
+        }
+
+        unsigned readHex4(std::string_view raw, size_t at)
+        {
+            unsigned value = 0;
+            for (size_t i = 0; i < 4; ++i)
+            {
+                value = (value << 4) | static_cast<unsigned>(hexValue(raw[at + i]));
+            }
+            return value;
+        }
+
+        void appendUtf8(std::string &out, unsigned codepoint)
+        {
+            if (codepoint < 0x80)
+            {
+                out.push_back(static_cast<char>(codepoint));
+            }
+            else if (codepoint < 0x800)
+            {
+                out.push_back(static_cast<char>(0xC0 | (codepoint >> 6)));
+                out.push_back(static_cast<char>(0x80 | (codepoint & 0x3F)));
+            }
+            else if (codepoint < 0x10000)
+            {
+                out.push_back(static_cast<char>(0xE0 | (codepoint >> 12)));
+                out.push_back(static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F)));
+                out.push_back(static_cast<char>(0x80 | (codepoint & 0x3F)));
+            }
+            else
+            {
+                out.push_back(static_cast<char>(0xF0 | (codepoint >> 18)));
+                out.push_back(static_cast<char>(0x80 | ((codepoint >> 12) & 0x3F)));
+                out.push_back(static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F)));
+                out.push_back(static_cast<char>(0x80 | (codepoint & 0x3F)));
+            }
+        }
+
+        const unsigned REPLACEMENT_CHARACTER = 0xFFFD; ///< Emitted for unpaired surrogates.
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  Tokenizer
+    ////////////////////////////////////////////////////////////////////////////
+
+    JsonTokenizer::JsonTokenizer(std::string_view text) : text_(text)
+    {
+        if (text_.size() >= 3 && text_.compare(0, 3, "\xEF\xBB\xBF") == 0)
+        {
+            pos_ = 3;
+        }
+    }
+
+    JsonToken JsonTokenizer::next()
+    {
+        if (peeked_)
+        {
+            peeked_ = false;
+            lexeme_ = peekLexeme_;
+            tokenStart_ = peekStart_;
+            hasEscapes_ = peekEscapes_;
+            return peekToken_;
+        }
+        return scan();
+    }
+
+    JsonToken JsonTokenizer::peek()
+    {
+        if (!peeked_)
+        {
+            // scan() overwrites the current token; park the lookahead separately
+            std::string_view lexeme = lexeme_;
+            size_t start = tokenStart_;
+            bool escapes = hasEscapes_;
+
+            peekToken_ = scan();
+            peekLexeme_ = lexeme_;
+            peekStart_ = tokenStart_;
+            peekEscapes_ = hasEscapes_;
+            peeked_ = true;
+
+            lexeme_ = lexeme;
+            tokenStart_ = start;
+            hasEscapes_ = escapes;
+        }
+        return peekToken_;
+    }
+
+    JsonToken JsonTokenizer::scan()
+    {
+        if (error_)
+            return JsonToken::Error;
+
+        while (pos_ < text_.size())
+        {
+            char c = text_[pos_];
+            if (c != ' ' && c != '\n' && c != '\r' && c != '\t')
+                break;
+            ++pos_;
+        }
+
+        tokenStart_ = pos_;
+        lexeme_ = std::string_view();
+        hasEscapes_ = false;
+
+        if (pos_ >= text_.size())
+            return JsonToken::End;
+
+        switch (text_[pos_])
+        {
+        case '{':
+            ++pos_;
+            return JsonToken::ObjectBegin;
+        case '}':
+            ++pos_;
+            return JsonToken::ObjectEnd;
+        case '[':
+            ++pos_;
+            return JsonToken::ArrayBegin;
+        case ']':
+            ++pos_;
+            return JsonToken::ArrayEnd;
+        case ':':
+            ++pos_;
+            return JsonToken::Colon;
+        case ',':
+            ++pos_;
+            return JsonToken::Comma;
+        case '"':
+            return scanString();
+        case 't':
+            return scanLiteral("true", JsonToken::True);
+        case 'f':
+            return scanLiteral("false", JsonToken::False);
+        case 'n':
+            return scanLiteral("null", JsonToken::Null);
+        default:
+            if (text_[pos_] == '-' || isDigit(text_[pos_]))
+                return scanNumber();
+            return fail("unexpected character", pos_);
+        }
+    }
+
+    JsonToken JsonTokenizer::scanString()
+    {
+        size_t begin = ++pos_;
+        while (pos_ < text_.size())
+        {
+            unsigned char c = static_cast<unsigned char>(text_[pos_]);
+            if (c == '"')
+            {
+                lexeme_ = text_.substr(begin, pos_ - begin);
+                ++pos_;
+                return JsonToken::String;
+            }
+            if (c < 0x20)
+                return fail("control character in string", pos_);
+            if (c == '\\')
+            {
+                hasEscapes_ = true;
+                if (pos_ + 1 >= text_.size())
+                    break;
+                switch (text_[pos_ + 1])
+                {
+                case '"':
+                case '\\':
+                case '/':
+                case 'b':
+                case 'f':
+                case 'n':
+                case 'r':
+                case 't':
+                    pos_ += 2;
+                    continue;
+                case 'u':
+                    if (pos_ + 6 > text_.size())
+                        break;
+                    for (size_t i = 2; i < 6; ++i)
+                    {
+                        if (hexValue(text_[pos_ + i]) < 0)
+                            return fail("invalid \\u escape", pos_);
+                    }
+                    pos_ += 6;
+                    continue;
+                default:
+                    return fail("invalid escape sequence", pos_);
+                }
+                break;
+            }
+            ++pos_;
+        }
+        return fail("unterminated string", begin - 1);
+    }
+
+    JsonToken JsonTokenizer::scanNumber()
+    {
+        // -?(0|[1-9][0-9]*)(\.[0-9]+)?([eE][+-]?[0-9]+)?
+        size_t begin = pos_;
+        if (text_[pos_] == '-')
+            ++pos_;
+
+        if (pos_ >= text_.size() || !isDigit(text_[pos_]))
+            return fail("invalid number", begin);
+        if (text_[pos_] == '0')
+        {
+            ++pos_;
+        }
+        else
+        {
+            while (pos_ < text_.size() && isDigit(text_[pos_]))
+                ++pos_;
+        }
+
+        if (pos_ < text_.size() && text_[pos_] == '.')
+        {
+            ++pos_;
+            if (pos_ >= text_.size() || !isDigit(text_[pos_]))
+                return fail("invalid number", begin);
+            while (pos_ < text_.size() && isDigit(text_[pos_]))
+                ++pos_;
+        }
+
+        if (pos_ < text_.size() && (text_[pos_] == 'e' || text_[pos_] == 'E'))
+        {
+            ++pos_;
+            if (pos_ < text_.size() && (text_[pos_] == '+' || text_[pos_] == '-'))
+                ++pos_;
+            if (pos_ >= text_.size() || !isDigit(text_[pos_]))
+                return fail("invalid number", begin);
+            while (pos_ < text_.size() && isDigit(text_[pos_]))
+                ++pos_;
+        }
+
+        lexeme_ = text_.substr(begin, pos_ - begin);
+        return JsonToken::Number;
+    }
+
+    JsonToken JsonTokenizer::scanLiteral(std::string_view word, JsonToken token)
+    {
+        if (text_.compare(pos_, word.size(), word) != 0)
+            return fail("invalid literal", pos_);
+        lexeme_ = text_.substr(pos_, word.size());
+        pos_ += word.size();
+        return token;
+    }
+
+    JsonToken JsonTokenizer::fail(const char *message, size_t at)
+    {
+        error_ = message;
+        errorOffset_ = at;
+        return JsonToken::Error;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  Reader: structure
+    ////////////////////////////////////////////////////////////////////////////
+
+    JsonReader::JsonReader(std::string_view text) : text_(text), tokens_(text)
+    {
+    }
+
+    bool JsonReader::fail(const char *message)
+    {
+        if (!error_)
+        {
+            // Lexical errors carry their own message and position
+            error_ = tokens_.error() ? tokens_.error() : message;
+            errorOffset_ = tokens_.offset();
+        }
+        return false;
+    }
+
+    bool JsonReader::push(bool object)
+    {
+        if (depth_ >= MAX_DEPTH)
+            return fail("nesting too deep");
+        frames_[depth_++] = {object, true};
+        return true;
+    }
+
+    bool JsonReader::beginObject()
+    {
+        if (error_)
+            return false;
+        if (tokens_.next() != JsonToken::ObjectBegin)
+            return fail("expected '{'");
+        return push(true);
+    }
+
+    bool JsonReader::nextMember(std::string_view &key)
+    {
+        if (error_)
+            return false;
+        if (depth_ == 0 || !frames_[depth_ - 1].object)
+            return fail("nextMember outside of an object");
+
+        Frame &frame = frames_[depth_ - 1];
+        JsonToken token = tokens_.next();
+        if (token == JsonToken::ObjectEnd)
+        {
+            --depth_;
+            return false;
+        }
+        if (!frame.first)
+        {
+            if (token != JsonToken::Comma)
+                return fail("expected ',' or '}'");
+            token = tokens_.next();
+        }
+        frame.first = false;
+
+        if (token != JsonToken::String)
+            return fail("expected member name");
+        key = tokens_.lexeme();
+        if (tokens_.hasEscapes())
+        {
+            scratch_.clear();
+            decodeJsonString(key, scratch_);
+            key = scratch_;
+        }
+        if (tokens_.next() != JsonToken::Colon)
+            return fail("expected ':'");
+        return expectValueStart();
+    }
+
+    bool JsonReader::beginArray()
+    {
+        if (error_)
+            return false;
+        if (tokens_.next() != JsonToken::ArrayBegin)
+            return fail("expected '['");
+        return push(false);
+    }
+
+    bool JsonReader::nextElement()
+    {
+        if (error_)
+            return false;
+        if (depth_ == 0 || frames_[depth_ - 1].object)
+            return fail("nextElement outside of an array");
+
+        Frame &frame = frames_[depth_ - 1];
+        JsonToken token = tokens_.peek();
+        if (token == JsonToken::ArrayEnd)
+        {
+            // After a comma expectValueStart() already rejected ']', so this is a real end
+            tokens_.next();
+            --depth_;
+            return false;
+        }
+        if (!frame.first)
+        {
+            if (token != JsonToken::Comma)
+            {
+                tokens_.next();
+                return fail("expected ',' or ']'");
+            }
+            tokens_.next();
+        }
+        frame.first = false;
+        return expectValueStart();
+    }
+
+    bool JsonReader::expectValueStart()
+    {
+        // Rejects "[1,]", "{"a":}" and friends before the caller reads the value
+        switch (tokens_.peek())
+        {
+        case JsonToken::ObjectBegin:
+        case JsonToken::ArrayBegin:
+        case JsonToken::String:
+        case JsonToken::Number:
+        case JsonToken::True:
+        case JsonToken::False:
+        case JsonToken::Null:
+            return true;
+        default:
+            tokens_.next();
+            return fail("expected a value");
+        }
+    }
+
+    bool JsonReader::finish()
+    {
+        if (error_)
+            return false;
+        if (depth_ != 0)
+            return fail("unclosed container");
+        if (tokens_.next() != JsonToken::End)
+            return fail("unexpected data after the document");
+        return true;
+    }
+
+    void JsonReader::errorLocation(size_t &line, size_t &column) const
+    {
+        line = 1;
+        column = 1;
+        size_t end = errorOffset_ < text_.size() ? errorOffset_ : text_.size();
+        for (size_t i = 0; i < end; ++i)
+        {
+            if (text_[i] == '\n')
+            {
+                ++line;
+                column = 1;
+            }
+            else
+            {
+                ++column;
+            }
+        }
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  Reader: values
+    ////////////////////////////////////////////////////////////////////////////
+
+    JsonType JsonReader::peekType()
+    {
+        if (error_)
+            return JsonType::Invalid;
+        switch (tokens_.peek())
+        {
+        case JsonToken::ObjectBegin:
+            return JsonType::Object;
+        case JsonToken::ArrayBegin:
+            return JsonType::Array;
+        case JsonToken::String:
+            return JsonType::String;
+        case JsonToken::Number:
+            return JsonType::Number;
+        case JsonToken::True:
+        case JsonToken::False:
+            return JsonType::Bool;
+        case JsonToken::Null:
+            return JsonType::Null;
+        default:
+            return JsonType::Invalid;
+        }
+    }
+
+    bool JsonReader::readStringView(std::string_view &out)
+    {
+        if (error_)
+            return false;
+        if (tokens_.next() != JsonToken::String)
+            return fail("expected a string");
+        out = tokens_.lexeme();
+        if (tokens_.hasEscapes())
+        {
+            scratch_.clear();
+            decodeJsonString(out, scratch_);
+            out = scratch_;
+        }
+        return true;
+    }
+
+    bool JsonReader::readString(std::string &out)
+    {
+        if (error_)
+            return false;
+        if (tokens_.next() != JsonToken::String)
+            return fail("expected a string");
+        out.clear();
+        if (tokens_.hasEscapes())
+            decodeJsonString(tokens_.lexeme(), out);
+        else
+            out.assign(tokens_.lexeme());
+        return true;
+    }
+
+    bool JsonReader::readNumber(double &out)
+    {
+        if (error_)
+            return false;
+        if (tokens_.next() != JsonToken::Number)
+            return fail("expected a number");
+
+        std::string_view lexeme = tokens_.lexeme();
+        double value = 0.0;
+        auto result = std::from_chars(lexeme.data(), lexeme.data() + lexeme.size(), value);
+        if (result.ec != std::errc() || result.ptr != lexeme.data() + lexeme.size())
+            return fail("number out of range");
+        out = value;
+        return true;
+    }
+
+    bool JsonReader::readFloat(float &out)
+    {
+        double value = 0.0;
+        if (!readNumber(value))
+            return false;
+        out = static_cast<float>(value);
+        return true;
+    }
+
+    bool JsonReader::readInt(int &out)
+    {
+        double value = 0.0;
+        if (!readNumber(value))
+            return false;
+        if (value < static_cast<double>(INT_MIN) || value > static_cast<double>(INT_MAX))
+            return fail("integer out of range");
+        out = static_cast<int>(value);
+        return true;
+    }
+
+    bool JsonReader::readBool(bool &out)
+    {
+        if (error_)
+            return false;
+        JsonToken token = tokens_.next();
+        if (token != JsonToken::True && token != JsonToken::False)
+            return fail("expected a boolean");
+        out = token == JsonToken::True;
+        return true;
+    }
+
+    bool JsonReader::readNull()
+    {
+        if (error_)
+            return false;
+        if (tokens_.next() != JsonToken::Null)
+            return fail("expected null");
+        return true;
+    }
+
+    bool JsonReader::skipValue()
+    {
+        if (error_)
+            return false;
+
+        // Iterative walk over the frame stack: deep documents cannot overflow the C++ stack
+        size_t base = depth_;
+        for (;;)
+        {
+            switch (tokens_.peek())
+            {
+            case JsonToken::ObjectBegin:
+                if (!beginObject())
+                    return false;
+                break;
+            case JsonToken::ArrayBegin:
+                if (!beginArray())
+                    return false;
+                break;
+            case JsonToken::String:
+            case JsonToken::Number:
+            case JsonToken::True:
+            case JsonToken::False:
+            case JsonToken::Null:
+                tokens_.next();
+                break;
+            default:
+                tokens_.next();
+                return fail("expected a value");
+            }
+
+            // Advance to the next value inside the skipped subtree, closing finished containers
+            for (;;)
+            {
+                if (depth_ == base)
+                    return true;
+
+                bool more;
+                if (frames_[depth_ - 1].object)
+                {
+                    std::string_view key;
+                    more = nextMember(key);
+                }
+                else
+                {
+                    more = nextElement();
+                }
+                if (more)
+                    break;
+                if (error_)
+                    return false;
+            }
+        }
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  String helpers
+    ////////////////////////////////////////////////////////////////////////////
+
+    void decodeJsonString(std::string_view raw, std::string &out)
+    {
+        // `raw` was validated by the tokenizer, so escapes are well-formed
+        out.reserve(out.size() + raw.size());
+        for (size_t i = 0; i < raw.size(); ++i)
+        {
+            char c = raw[i];
+            if (c != '\\' || i + 1 >= raw.size())
+            {
+                out.push_back(c);
+                continue;
+            }
+
+            char escape = raw[++i];
+            switch (escape)
+            {
+            case 'b':
+                out.push_back('\b');
+                break;
+            case 'f':
+                out.push_back('\f');
+                break;
+            case 'n':
+                out.push_back('\n');
+                break;
+            case 'r':
+                out.push_back('\r');
+                break;
+            case 't':
+                out.push_back('\t');
+                break;
+            case 'u':
+            {
+                unsigned codepoint = readHex4(raw, i + 1);
+                i += 4;
+                if (codepoint >= 0xD800 && codepoint <= 0xDBFF)
+                {
+                    // High surrogate: combine with a following \uDC00-\uDFFF
+                    unsigned low = 0;
+                    if (i + 6 < raw.size() && raw[i + 1] == '\\' && raw[i + 2] == 'u')
+                        low = readHex4(raw, i + 3);
+                    if (low >= 0xDC00 && low <= 0xDFFF)
+                    {
+                        codepoint = 0x10000 + ((codepoint - 0xD800) << 10) + (low - 0xDC00);
+                        i += 6;
+                    }
+                    else
+                    {
+                        codepoint = REPLACEMENT_CHARACTER;
+                    }
+                }
+                else if (codepoint >= 0xDC00 && codepoint <= 0xDFFF)
+                {
+                    codepoint = REPLACEMENT_CHARACTER;
+                }
+                appendUtf8(out, codepoint);
+                break;
+            }
+            default: // '"', '\\', '/'
+                out.push_back(escape);
+                break;
+            }
+        }
+    }
+
+    std::string quoteJsonString(std::string_view value)
+    {
+        std::string out;
+        out.reserve(value.size() + 2);
+        out.push_back('"');
+        for (char c : value)
+        {
+            switch (c)
+            {
+            case '"':
+                out += "\\\"";
+                break;
+            case '\\':
+                out += "\\\\";
+                break;
+            case '\n':
+                out += "\\n";
+                break;
+            case '\r':
+                out += "\\r";
+                break;
+            case '\t':
+                out += "\\t";
+                break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20)
+                {
+                    char buffer[8];
+                    std::snprintf(buffer, sizeof(buffer), "\\u%04x", static_cast<unsigned>(c));
+                    out += buffer;
+                }
+                else
+                {
+                    out.push_back(c);
+                }
+                break;
+            }
+        }
+        out.push_back('"');
+        return out;
+    }
+
+} // namespace util
@@ -0,0 +1,175 @@
+/**
+ * @file JsonReader.h
+ * @brief Single-pass, zero-copy JSON tokenizer and pull reader.
+ *
+ * Mission files can hold thousands of missions. Instead of building a DOM or
+ * re-scanning substrings per field, the reader walks the document once and
+ * hands out `std::string_view`s into the source text; only strings that
+ * contain escape sequences are decoded into owned storage.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace util
+{
+
+    /// Lexical tokens produced by JsonTokenizer.
+    enum class JsonToken : uint8_t
+    {
+        ObjectBegin, ///< `{`
+        ObjectEnd,   ///< `}`
+        ArrayBegin,  ///< `[`
+        ArrayEnd,    ///< `]`
+        Colon,
+        Comma,
+        String, ///< lexeme() is the raw content between the quotes.
+        Number, ///< lexeme() is the validated number text.
+        True,
+        False,
+        Null,
+        End,  ///< Only whitespace left.
+        Error ///< See error(); the tokenizer stays in this state.
+    };
+
+    /**
+     * @brief Splits JSON text (RFC 8259) into tokens without copying.
+     *
+     * Strings are validated (control characters, escape syntax, `\u` digits)
+     * but not decoded: `hasEscapes()` tells whether `decodeJsonString` is needed.
+     * A leading UTF-8 BOM is skipped.
+     */
+    class JsonTokenizer
+    {
+    public:
+        explicit JsonTokenizer(std::string_view text);
+
+        /// Consumes and returns the next token.
+        JsonToken next();
+        /// Returns the next token without consuming it.
+        JsonToken peek();
+
+        std::string_view lexeme() const { return lexeme_; }
+        bool hasEscapes() const { return hasEscapes_; }
+        /// Byte offset of the last token returned by next(), or of the error once failed.
+        size_t offset() const { return error_ ? errorOffset_ : tokenStart_; }
+        const char *error() const { return error_; }
+
+    private:
+        JsonToken scan();
+        JsonToken scanString();
+        JsonToken scanNumber();
+        JsonToken scanLiteral(std::string_view word, JsonToken token);
+        JsonToken fail(const char *message, size_t at);
+
+        std::string_view text_;
+        size_t pos_ = 0;
+
+        std::string_view lexeme_;
+        size_t tokenStart_ = 0;
+        bool hasEscapes_ = false;
+        const char *error_ = nullptr;
+        size_t errorOffset_ = 0;
+
+        bool peeked_ = false; ///< The fields below hold a token scanned by peek().
+        JsonToken peekToken_ = JsonToken::End;
+        std::string_view peekLexeme_;
+        size_t peekStart_ = 0;
+        bool peekEscapes_ = false;
+    };
+
+    /// Value categories as seen by JsonReader::peekType().
+    enum class JsonType : uint8_t
+    {
+        Object,
+        Array,
+        String,
+        Number,
+        Bool,
+        Null,
+        Invalid ///< Not a value at this position, or the reader failed.
+    };
+
+    /**
+     * @brief Streaming pull parser on top of JsonTokenizer.
+     *
+     * Callers walk the document in order and build their structures directly:
+     * @code
+     *   if (json.beginObject())
+     *       while (json.nextMember(key))
+     *           if (key == "name") json.readString(name);
+     *           else json.skipValue();
+     * @endcode
+     * The first error is sticky: every later call returns false, so parsing
+     * code can check `ok()` once at the end. Keys and string views stay valid
+     * until the next call (escaped strings are decoded into an internal
+     * buffer); views of unescaped strings point into the source text.
+     */
+    class JsonReader
+    {
+    public:
+        /// Containers nested deeper than this are rejected (protects the frame stack).
+        static constexpr size_t MAX_DEPTH = 128;
+
+        explicit JsonReader(std::string_view text);
+
+        // Structure
+        bool beginObject();
+        /// Moves to the next member of the current object; false at its end (consumed) or on error.
+        bool nextMember(std::string_view &key);
+        bool beginArray();
+        /// Moves to the next element of the current array; false at its end (consumed) or on error.
+        bool nextElement();
+
+        // Values
+        JsonType peekType();
+        bool readString(std::string &out);
+        bool readStringView(std::string_view &out);
+        bool readNumber(double &out);
+        bool readFloat(float &out);
+        bool readInt(int &out);
+        bool readBool(bool &out);
+        bool readNull();
+        /// Skips one complete value (validating it), whatever its type.
+        bool skipValue();
+
+        /// Verifies that nothing but whitespace follows the top-level value.
+        bool finish();
+
+        bool ok() const { return error_ == nullptr; }
+        const char *error() const { return error_; }
+        size_t errorOffset() const { return errorOffset_; }
+        /// 1-based line/column of the error, computed from the source text.
+        void errorLocation(size_t &line, size_t &column) const;
+
+    private:
+        struct Frame
+        {
+            bool object; ///< Object (members) or array (elements).
+            bool first;  ///< No member/element consumed yet.
+        };
+
+        bool push(bool object);
+        bool fail(const char *message);
+        bool expectValueStart();
+
+        std::string_view text_;
+        JsonTokenizer tokens_;
+        Frame frames_[MAX_DEPTH];
+        size_t depth_ = 0;
+
+        std::string scratch_; ///< Decoded escaped strings (reused).
+        const char *error_ = nullptr;
+        size_t errorOffset_ = 0;
+    };
+
+    /// Appends the decoded form of a raw string lexeme (escapes resolved, `\u` as UTF-8).
+    void decodeJsonString(std::string_view raw, std::string &out);
+    /// Returns `value` quoted and escaped for use in JSON output.
+    std::string quoteJsonString(std::string_view value);
+
+} // namespace util
@@ -0,0 +1,111 @@
+#include "MappedFile.h"
+
+#include <fstream>
+#include <sstream>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define UTIL_HAS_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#define UTIL_HAS_MMAP 0
+#endif
+
+namespace util
+{
+
+    MappedFile::~MappedFile()
+    {
+        close();
+    }
+
+    MappedFile::MappedFile(MappedFile &&other) noexcept
+        : mapping_(std::exchange(other.mapping_, nullptr)),
+          size_(std::exchange(other.size_, 0)),
+          fallback_(std::move(other.fallback_)),
+          open_(std::exchange(other.open_, false))
+    {
+    }
+
+    MappedFile &MappedFile::operator=(MappedFile &&other) noexcept
+    {
+        if (this != &other)
+        {
+            close();
+            mapping_ = std::exchange(other.mapping_, nullptr);
+            size_ = std::exchange(other.size_, 0);
+            fallback_ = std::move(other.fallback_);
+            open_ = std::exchange(other.open_, false);
+        }
+        return *this;
+    }
+
+    bool MappedFile::open(const std::string &path, Access access)
+    {
+        close();
+
+#if UTIL_HAS_MMAP
+        int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+            return false;
+
+        struct stat info;
+        if (::fstat(fd, &info) == 0 && S_ISREG(info.st_mode))
+        {
+            size_ = static_cast<size_t>(info.st_size);
+            if (size_ == 0)
+            {
+                ::close(fd);
+                open_ = true;
+                return true;
+            }
+
+            void *mapping = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapping != MAP_FAILED)
+            {
+                ::madvise(mapping, size_, access == Access::Sequential ? MADV_SEQUENTIAL : MADV_RANDOM);
+                ::close(fd);
+                mapping_ = mapping;
+                open_ = true;
+                return true;
+            }
+        }
+        ::close(fd);
+#endif
+
+        // Fallback: plain read into an owned buffer
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open())
+            return false;
+        std::stringstream buffer;
+        buffer << file.rdbuf();
+        fallback_ = buffer.str();
+        size_ = fallback_.size();
+        open_ = true;
+        return true;
+    }
+
+    void MappedFile::close()
+    {
+#if UTIL_HAS_MMAP
+        if (mapping_)
+            ::munmap(mapping_, size_);
+#endif
+        mapping_ = nullptr;
+        size_ = 0;
+        fallback_.clear();
+        fallback_.shrink_to_fit();
+        open_ = false;
+    }
+
+    std::string_view MappedFile::view() const
+    {
+        if (mapping_)
+            return std::string_view(static_cast<const char *>(mapping_), size_);
+        return std::string_view(fallback_.data(), fallback_.size());
+    }
+
+} // namespace util
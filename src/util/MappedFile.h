@@ -0,0 +1,58 @@
+/**
+ * @file MappedFile.h
+ * @brief Read-only memory mapping of a whole file.
+ *
+ * Parsers that work on `std::string_view` (see JsonReader.h) can read data
+ * files straight from the page cache instead of copying them into a string.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace util
+{
+
+    /**
+     * @brief RAII wrapper around a read-only, private file mapping.
+     *
+     * Uses `mmap` on POSIX systems. Where mapping is not available (or fails,
+     * e.g. on special files) the content is read into an owned buffer instead,
+     * so callers always get a contiguous view. Empty files map to an empty view.
+     */
+    class MappedFile
+    {
+    public:
+        /// Access pattern hint passed to the kernel (read-ahead policy).
+        enum class Access
+        {
+            Sequential, ///< Parsed front to back once (text formats).
+            Random      ///< Indexed lookups; only touched pages are read.
+        };
+
+        MappedFile() = default;
+        ~MappedFile();
+
+        MappedFile(const MappedFile &) = delete;
+        MappedFile &operator=(const MappedFile &) = delete;
+        MappedFile(MappedFile &&other) noexcept;
+        MappedFile &operator=(MappedFile &&other) noexcept;
+
+        /// Maps `path`, releasing any previous mapping. Returns false if the file cannot be read.
+        bool open(const std::string &path, Access access = Access::Sequential);
+        void close();
+
+        bool isOpen() const { return open_; }
+        std::string_view view() const;
+        size_t size() const { return size_; }
+
+    private:
+        void *mapping_ = nullptr; ///< mmap'ed region, or nullptr when using fallback_.
+        size_t size_ = 0;
+        std::string fallback_; ///< Owned copy when the file could not be mapped.
+        bool open_ = false;
+    };
+
+} // namespace util
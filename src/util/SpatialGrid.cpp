@@ -0,0 +1,163 @@
+#include "SpatialGrid.h"
+
+#include <algorithm>
+
+namespace util
+{
+
+    void SpatialGrid::reset(float cellSize)
+    {
+        cellSize_ = cellSize > 0.0f ? cellSize : 1.0f;
+        inverseCellSize_ = 1.0f / cellSize_;
+        cells_.clear();
+        positions_.clear();
+        slots_.clear();
+        count_ = 0;
+    }
+
+    void SpatialGrid::build(const std::vector<glm::vec2> &positions, float cellSize)
+    {
+        reset(cellSize);
+        positions_ = positions;
+        slots_.resize(positions.size());
+        cells_.reserve(positions.size());
+        for (uint32_t id = 0; id < positions.size(); ++id)
+        {
+            std::vector<uint32_t> &cell = cells_[keyOf(positions[id])];
+            slots_[id] = static_cast<uint32_t>(cell.size());
+            cell.push_back(id);
+        }
+        count_ = positions.size();
+    }
+
+    void SpatialGrid::insert(uint32_t id, const glm::vec2 &position)
+    {
+        if (contains(id))
+        {
+            move(id, position);
+            return;
+        }
+        if (id >= positions_.size())
+        {
+            positions_.resize(id + 1, glm::vec2(0.0f));
+            slots_.resize(id + 1, NONE);
+        }
+
+        positions_[id] = position;
+        std::vector<uint32_t> &cell = cells_[keyOf(position)];
+        slots_[id] = static_cast<uint32_t>(cell.size());
+        cell.push_back(id);
+        ++count_;
+    }
+
+    bool SpatialGrid::remove(uint32_t id)
+    {
+        if (!contains(id))
+        {
+            return false;
+        }
+
+        auto it = cells_.find(keyOf(positions_[id]));
+        std::vector<uint32_t> &cell = it->second;
+
+        // Swap-and-pop; the id moved into the hole gets its slot patched
+        uint32_t slot = slots_[id];
+        uint32_t last = cell.back();
+        cell[slot] = last;
+        slots_[last] = slot;
+        cell.pop_back();
+        slots_[id] = NONE;
+        if (cell.empty())
+        {
+            cells_.erase(it);
+        }
+        --count_;
+        return true;
+    }
+
+    void SpatialGrid::move(uint32_t id, const glm::vec2 &position)
+    {
+        if (contains(id) && keyOf(positions_[id]) == keyOf(position))
+        {
+            positions_[id] = position; // same cell: nothing to relink
+            return;
+        }
+        remove(id);
+        insert(id, position);
+    }
+
+    void SpatialGrid::scanCell(int32_t cx, int32_t cz, const glm::vec2 &center, float &bestSq, uint32_t &best) const
+    {
+        auto it = cells_.find(cellKey(cx, cz));
+        if (it == cells_.end())
+        {
+            return;
+        }
+        for (uint32_t id : it->second)
+        {
+            glm::vec2 delta = positions_[id] - center;
+            float distanceSq = glm::dot(delta, delta);
+            if (distanceSq <= bestSq)
+            {
+                bestSq = distanceSq;
+                best = id;
+            }
+        }
+    }
+
+    uint32_t SpatialGrid::nearest(const glm::vec2 &center, float maxRadius) const
+    {
+        float bestSq = maxRadius * maxRadius;
+        uint32_t best = NONE;
+        if (count_ == 0 || !(maxRadius >= 0.0f))
+        {
+            return best;
+        }
+
+        // A search square with more cells than points: a plain scan is cheaper
+        int64_t rings = static_cast<int64_t>(std::ceil(maxRadius * inverseCellSize_)) + 1;
+        int64_t side = 2 * rings + 1;
+        if (side * side > static_cast<int64_t>(count_))
+        {
+            for (const auto &cell : cells_)
+            {
+                for (uint32_t id : cell.second)
+                {
+                    glm::vec2 delta = positions_[id] - center;
+                    float distanceSq = glm::dot(delta, delta);
+                    if (distanceSq <= bestSq)
+                    {
+                        bestSq = distanceSq;
+                        best = id;
+                    }
+                }
+            }
+            return best;
+        }
+
+        const int32_t ox = cellCoord(center.x);
+        const int32_t oz = cellCoord(center.y);
+        scanCell(ox, oz, center, bestSq, best);
+        for (int32_t r = 1; r <= rings; ++r)
+        {
+            // Every point in ring r is at least (r - 1) cells away from the center
+            float reach = static_cast<float>(r - 1) * cellSize_;
+            if (reach * reach > bestSq)
+            {
+                break;
+            }
+            for (int32_t d = -r; d <= r; ++d)
+            {
+                scanCell(ox + d, oz - r, center, bestSq, best);
+                scanCell(ox + d, oz + r, center, bestSq, best);
+            }
+            for (int32_t d = -r + 1; d <= r - 1; ++d)
+            {
+                scanCell(ox - r, oz + d, center, bestSq, best);
+                scanCell(ox + r, oz + d, center, bestSq, best);
+            }
+        }
+        return best;
+    }
+
+} // namespace util
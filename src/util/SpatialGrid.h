@@ -0,0 +1,173 @@
+/**
+ * @file SpatialGrid.h
+ * @brief Uniform hashed grid over ground-plane (XZ) positions.
+ *
+ * Used for radius and nearest-point queries over waypoints (capture checks in
+ * flight, hit-testing in the mission planner) without scanning every point.
+ */
+
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+namespace util
+{
+
+    /**
+     * @brief Sparse uniform grid of point ids keyed by cell coordinate.
+     *
+     * Points are identified by a dense id (typically their index in the
+     * caller's array). Only occupied cells are stored, so the bounds of the
+     * data don't matter. Insert, remove and move are O(1); a radius query
+     * visits the cells overlapping its bounding square, so with the cell size
+     * close to the typical query radius it touches 3x3 cells.
+     */
+    class SpatialGrid
+    {
+    public:
+        static constexpr uint32_t NONE = ~0u;
+
+        /// Drops every point and sets the cell size (world units, > 0).
+        void reset(float cellSize);
+
+        /// Replaces the contents with points [0, positions.size()).
+        void build(const std::vector<glm::vec2> &positions, float cellSize);
+
+        void insert(uint32_t id, const glm::vec2 &position);
+        bool remove(uint32_t id);
+        void move(uint32_t id, const glm::vec2 &position);
+
+        bool contains(uint32_t id) const { return id < slots_.size() && slots_[id] != NONE; }
+        const glm::vec2 &position(uint32_t id) const { return positions_[id]; }
+
+        /**
+         * @brief Calls `fn(id, distanceSquared)` for every point within `radius` of `center`.
+         *
+         * The grid must not be modified from inside `fn`.
+         */
+        template <typename Fn>
+        void forEachInRadius(const glm::vec2 &center, float radius, Fn &&fn) const
+        {
+            const float radiusSq = radius * radius;
+            const int32_t minX = cellCoord(center.x - radius), maxX = cellCoord(center.x + radius);
+            const int32_t minZ = cellCoord(center.y - radius), maxZ = cellCoord(center.y + radius);
+            for (int32_t cz = minZ; cz <= maxZ; ++cz)
+            {
+                for (int32_t cx = minX; cx <= maxX; ++cx)
+                {
+                    auto it = cells_.find(cellKey(cx, cz));
+                    if (it == cells_.end())
+                    {
+                        continue;
+                    }
+                    for (uint32_t id : it->second)
+                    {
+                        glm::vec2 delta = positions_[id] - center;
+                        float distanceSq = glm::dot(delta, delta);
+                        if (distanceSq <= radiusSq)
+                        {
+                            fn(id, distanceSq);
+                        }
+                    }
+                }
+            }
+        }
+
+        /**
+         * @brief Calls `fn(id)` for every point inside the rectangle [minCorner, maxCorner].
+         *
+         * When the rectangle spans more cells than are occupied (a zoomed-out
+         * view), the occupied cells are walked instead. The grid must not be
+         * modified from inside `fn`.
+         */
+        template <typename Fn>
+        void forEachInRect(const glm::vec2 &minCorner, const glm::vec2 &maxCorner, Fn &&fn) const
+        {
+            auto inside = [&](const glm::vec2 &p)
+            {
+                return p.x >= minCorner.x && p.x <= maxCorner.x && p.y >= minCorner.y && p.y <= maxCorner.y;
+            };
+            const double spanX = std::floor(maxCorner.x * inverseCellSize_) - std::floor(minCorner.x * inverseCellSize_) + 1.0;
+            const double spanZ = std::floor(maxCorner.y * inverseCellSize_) - std::floor(minCorner.y * inverseCellSize_) + 1.0;
+            if (!(spanX > 0.0 && spanZ > 0.0))
+            {
+                return;
+            }
+            if (spanX * spanZ > static_cast<double>(cells_.size()))
+            {
+                for (const auto &cell : cells_)
+                {
+                    for (uint32_t id : cell.second)
+                    {
+                        if (inside(positions_[id]))
+                        {
+                            fn(id);
+                        }
+                    }
+                }
+                return;
+            }
+            const int32_t minX = cellCoord(minCorner.x), maxX = cellCoord(maxCorner.x);
+            const int32_t minZ = cellCoord(minCorner.y), maxZ = cellCoord(maxCorner.y);
+            for (int32_t cz = minZ; cz <= maxZ; ++cz)
+            {
+                for (int32_t cx = minX; cx <= maxX; ++cx)
+                {
+                    auto it = cells_.find(cellKey(cx, cz));
+                    if (it == cells_.end())
+                    {
+                        continue;
+                    }
+                    for (uint32_t id : it->second)
+                    {
+                        if (inside(positions_[id]))
+                        {
+                            fn(id);
+                        }
+                    }
+                }
+            }
+        }
+
+        /**
+         * @brief Closest point to `center` no farther than `maxRadius`.
+         * @return Its id, or NONE if there is none within range.
+         *
+         * Searches outward ring by ring and stops as soon as no closer point
+         * can exist, so the cost depends on the local density, not on size().
+         */
+        uint32_t nearest(const glm::vec2 &center, float maxRadius) const;
+
+        size_t size() const { return count_; }
+        bool empty() const { return count_ == 0; }
+        float cellSize() const { return cellSize_; }
+
+    private:
+        using CellKey = uint64_t;
+
+        int32_t cellCoord(float value) const { return static_cast<int32_t>(std::floor(value * inverseCellSize_)); }
+
+        static CellKey cellKey(int32_t cx, int32_t cz)
+        {
+            return (static_cast<CellKey>(static_cast<uint32_t>(cx)) << 32) | static_cast<uint32_t>(cz);
+        }
+
+        CellKey keyOf(const glm::vec2 &position) const { return cellKey(cellCoord(position.x), cellCoord(position.y)); }
+
+        void scanCell(int32_t cx, int32_t cz, const glm::vec2 &center, float &bestSq, uint32_t &best) const;
+
+        float cellSize_ = 1.0f;
+        float inverseCellSize_ = 1.0f;
+        std::unordered_map<CellKey, std::vector<uint32_t>> cells_;
+        std::vector<glm::vec2> positions_; ///< By id.
+        std::vector<uint32_t> slots_;      ///< By id: index inside its cell, NONE if absent.
+        size_t count_ = 0;
+    };
+
+} // namespace util